@@ -47,7 +47,12 @@ static enum
     OBJECT_CHANGE_BY,
     OBJECT_TRANSFORM,
     OBJECT_BUFFER_SIZE,
+    OBJECT_BUFFER_MAX_AGE,
+    OBJECT_BUFFER_MAX_BYTES,
+    OBJECT_BUFFER_PRIORITY,
+    OBJECT_BUFFER_COMPRESSION,
     OBJECT_BACKUP_PERIOD,
+    OBJECT_BACKUP_LOG,
     OBJECT_JSON_EXTRACTION,
     OBJECT_OBSERVATION,
     OBJECT_MIN,
@@ -97,13 +102,18 @@ static void HandleHelpRequest
         "    dhub set highLimit PATH\n"
         "    dhub set changeBy PATH\n"
         "    dhub set bufferSize PATH\n"
+        "    dhub set bufferMaxAge PATH\n"
+        "    dhub set bufferMaxBytes PATH\n"
+        "    dhub set bufferPriority PATH\n"
+        "    dhub set bufferCompression PATH\n"
         "    dhub set backupPeriod PATH\n"
+        "    dhub set backupLog PATH\n"
         "    dhub set jsonExtraction PATH\n"
         "    dhub remove OBJECT PATH\n"
         "    dhub push PATH [[--json] VALUE]\n"
         "    dhub push PATH --file [--json] FILE_PATH\n"
         "    dhub watch [--json] PATH\n"
-        "    dhub get OBJECT PATH [START]\n"
+        "    dhub get OBJECT PATH [START [END]]\n"
         "    dhub read PATH [START]\n"
         "    dhub help\n"
         "    dhub -h\n"
@@ -167,6 +177,37 @@ static void HandleHelpRequest
         "            an Observation resource at PATH if one does not already exist\n"
         "            there.\n"
         "\n"
+        "    dhub set bufferMaxAge PATH VALUE\n"
+        "            Sets the maximum age (seconds) of the samples that an Observation\n"
+        "            will keep in its buffer.  Older samples are dropped.\n"
+        "            PATH is expected to be under /obs/.  Setting this will create\n"
+        "            an Observation resource at PATH if one does not already exist\n"
+        "            there.\n"
+        "\n"
+        "    dhub set bufferMaxBytes PATH VALUE\n"
+        "            Sets the maximum number of bytes of memory that the samples in\n"
+        "            an Observation's buffer can use.  The oldest samples are dropped\n"
+        "            to stay within it. 0 = no limit.\n"
+        "            PATH is expected to be under /obs/.  Setting this will create\n"
+        "            an Observation resource at PATH if one does not already exist\n"
+        "            there.\n"
+        "\n"
+        "    dhub set bufferPriority PATH VALUE\n"
+        "            Sets the priority of an Observation's buffer.  When the samples\n"
+        "            buffered in all Observations use more memory than the Data Hub's\n"
+        "            buffer memory budget, samples are evicted from the buffers with\n"
+        "            the lowest priority first. Default = 0.\n"
+        "            PATH is expected to be under /obs/.  Setting this will create\n"
+        "            an Observation resource at PATH if one does not already exist\n"
+        "            there.\n"
+        "\n"
+        "    dhub set bufferCompression PATH VALUE\n"
+        "            Sets whether the numeric and Boolean samples in an Observation's\n"
+        "            buffer are stored compressed (true or false). Default = false.\n"
+        "            PATH is expected to be under /obs/.  Setting this will create\n"
+        "            an Observation resource at PATH if one does not already exist\n"
+        "            there.\n"
+        "\n"
         "    dhub set backupPeriod PATH VALUE\n"
         "            Sets the minimum time (seconds) that an Observation will wait\n"
         "            after performing a non-volatile backup of its buffer before it\n"
@@ -178,6 +219,15 @@ static void HandleHelpRequest
         "            an Observation resource at PATH if one does not already exist\n"
         "            there.\n"
         "\n"
+        "    dhub set backupLog PATH VALUE\n"
+        "            Sets whether an Observation's buffer is backed up by appending\n"
+        "            only the samples pushed since the previous backup to a log\n"
+        "            (true), rather than rewriting the whole buffer (false).\n"
+        "            Default = false.\n"
+        "            PATH is expected to be under /obs/.  Setting this will create\n"
+        "            an Observation resource at PATH if one does not already exist\n"
+        "            there.\n"
+        "\n"
         "    dhub set jsonExtraction PATH VALUE\n"
         "            Specifies what an Observation should should extract from JSON\n"
         "            values it receives.  PATH is expected to be under /obs/.\n"
@@ -216,7 +266,7 @@ static void HandleHelpRequest
         "           Print each update to stdout.  If --json specified, print as\n"
         "           a JSON object.\n"
         "\n"
-        "    dhub get OBJECT PATH [START]\n"
+        "    dhub get OBJECT PATH [START [END]]\n"
         "            Prints the state of an OBJECT associated with the resource at PATH.\n"
         "            Valid values for OBJECT are:\n"
         "              source\n"
@@ -246,6 +296,8 @@ static void HandleHelpRequest
         "            the current time to compute the start time.  E.g., 120 = compute\n"
         "            the statistic using only data received within the last 2 minutes.\n"
         "            If START is not specified, the entire buffer will be used.\n"
+        "            An end time (END) can also be specified, in the same way as START,\n"
+        "            to leave out data received after that time.\n"
         "\n"
         "    dhub read PATH [START]\n"
         "            Reads the contents of the data sample buffer of the Observation\n"
@@ -308,6 +360,14 @@ static const char* ValueArg = NULL;
 static double StartArg = NAN;  // Not-a-number by default
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * End timestamp argument for 'get min/max/mean/stddev' commands.
+ */
+//--------------------------------------------------------------------------------------------------
+static double EndArg = NAN;  // Not-a-number by default
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Handles a failure to connect an IPC session with the Data Hub by reporting an error to stderr
@@ -925,11 +985,30 @@ static void PrintEntry
         Indent(depth);
         printf("bufferSize: %u entries\n", admin_GetBufferMaxCount(path));
         Indent(depth);
+        PrintDoubleSetting("bufferMaxAge", admin_GetBufferMaxAge(path));
+        Indent(depth);
+        printf("bufferMaxBytes: %u bytes\n", admin_GetBufferMaxBytes(path));
+        Indent(depth);
+        printf("bufferPriority: %d\n", admin_GetBufferPriority(path));
+        Indent(depth);
+        printf("bufferCompression: %s\n", admin_GetBufferCompression(path) ? "true" : "false");
+        uint64_t bufferBytes;
+        uint64_t evictionCount;
+        if (query_GetObsBufferMemoryUsage(path, &bufferBytes, &evictionCount) == LE_OK)
+        {
+            Indent(depth);
+            printf("bufferMemory: %" PRIu64 " bytes (%" PRIu64 " samples evicted)\n",
+                   bufferBytes,
+                   evictionCount);
+        }
+        Indent(depth);
         uint32_t backupPeriod = admin_GetBufferBackupPeriod(path);
         printf("backupPeriod: %u seconds (= %lf minutes) (= %lf hours)\n",
                backupPeriod,
                ((double)backupPeriod) / 60,
                ((double)backupPeriod) / 3600);
+        Indent(depth);
+        printf("backupLog: %s\n", admin_GetBufferBackupLog(path) ? "true" : "false");
     }
 }
 
@@ -1265,6 +1344,77 @@ static void SetTransformSetting
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set a buffer priority setting.
+ *
+ * @note Has the side-effect of creating the Observation if it does not yet exist.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SetPrioritySetting
+(
+    const char* path,
+    const char* valueStr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    int value;
+    if (le_utf8_ParseInt(&value, valueStr) != LE_OK)
+    {
+        fprintf(stderr, "Integer value required.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if (admin_CreateObs(path) != LE_OK)
+    {
+        fprintf(stderr, "Invalid resource path for Observation.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    admin_SetBufferPriority(path, (int32_t)value);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set a Boolean setting.
+ *
+ * @note Has the side-effect of creating the Observation if it does not yet exist.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SetBooleanSetting
+(
+    const char* path,
+    const char* valueStr,
+    le_result_t (*setterFunc)(const char*, bool)
+)
+//--------------------------------------------------------------------------------------------------
+{
+    bool value;
+    if (strcmp("true", valueStr) == 0)
+    {
+        value = true;
+    }
+    else if (strcmp("false", valueStr) == 0)
+    {
+        value = false;
+    }
+    else
+    {
+        fprintf(stderr, "Boolean value (true or false) required.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if (admin_CreateObs(path) != LE_OK)
+    {
+        fprintf(stderr, "Invalid resource path for Observation.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    setterFunc(path, value);
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Get an integer setting.
@@ -1289,7 +1439,7 @@ static void GetIntegerSetting
 //--------------------------------------------------------------------------------------------------
 static void GetBufferStat
 (
-    double (*getterFunc)(const char*, double)
+    double (*getterFunc)(const char*, double, double)
 )
 //--------------------------------------------------------------------------------------------------
 {
@@ -1299,7 +1449,7 @@ static void GetBufferStat
         exit(EXIT_FAILURE);
     }
 
-    double value = getterFunc(PathArg, StartArg);
+    double value = getterFunc(PathArg, StartArg, EndArg);
 
     if (isnan(value))
     {
@@ -1693,7 +1843,12 @@ static void PathArgHandler
         case OBJECT_CHANGE_BY:
         case OBJECT_TRANSFORM:
         case OBJECT_BUFFER_SIZE:
+        case OBJECT_BUFFER_MAX_AGE:
+        case OBJECT_BUFFER_MAX_BYTES:
+        case OBJECT_BUFFER_PRIORITY:
+        case OBJECT_BUFFER_COMPRESSION:
         case OBJECT_BACKUP_PERIOD:
+        case OBJECT_BACKUP_LOG:
         case OBJECT_JSON_EXTRACTION:
         case OBJECT_OBSERVATION:
         case OBJECT_MIN:
@@ -1738,6 +1893,34 @@ static void StartArgHandler
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Command-line argument handler call-back for the END argument.
+ */
+//--------------------------------------------------------------------------------------------------
+static void EndArgHandler
+(
+    const char* arg
+)
+//--------------------------------------------------------------------------------------------------
+{
+    EndArg = ParseDouble(arg);
+
+    if (EndArg < 0)
+    {
+        fprintf(stderr, "End time must be a positive number.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if (errno != 0)
+    {
+        fprintf(stderr, "Error parsing END argument '%s'.\n"
+                        "Must be a positive number of seconds.\n", arg);
+        exit(EXIT_FAILURE);
+    }
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Command-line argument handler callback for the object type argument (e.g., "source", "default").
@@ -1785,10 +1968,30 @@ static void ObjectTypeArgHandler
     {
         Object = OBJECT_BUFFER_SIZE;
     }
+    else if (strcmp(arg, "bufferMaxAge") == 0)
+    {
+        Object = OBJECT_BUFFER_MAX_AGE;
+    }
+    else if (strcmp(arg, "bufferMaxBytes") == 0)
+    {
+        Object = OBJECT_BUFFER_MAX_BYTES;
+    }
+    else if (strcmp(arg, "bufferPriority") == 0)
+    {
+        Object = OBJECT_BUFFER_PRIORITY;
+    }
+    else if (strcmp(arg, "bufferCompression") == 0)
+    {
+        Object = OBJECT_BUFFER_COMPRESSION;
+    }
     else if (strcmp(arg, "backupPeriod") == 0)
     {
         Object = OBJECT_BACKUP_PERIOD;
     }
+    else if (strcmp(arg, "backupLog") == 0)
+    {
+        Object = OBJECT_BACKUP_LOG;
+    }
     else if (strcmp(arg, "jsonExtraction") == 0)
     {
         Object = OBJECT_JSON_EXTRACTION;
@@ -1857,8 +2060,9 @@ static void ObjectTypeArgHandler
             || (Object == OBJECT_MEAN)
             || (Object == OBJECT_STD_DEVIATION)  )
         {
-            // Accept an optional START argument.
+            // Accept optional START and END arguments.
             le_arg_AddPositionalCallback(StartArgHandler);
+            le_arg_AddPositionalCallback(EndArgHandler);
             le_arg_AllowLessPositionalArgsThanCallbacks();
         }
     }
@@ -2047,11 +2251,36 @@ COMPONENT_INIT
                     GetIntegerSetting(admin_GetBufferMaxCount);
                     break;
 
+                case OBJECT_BUFFER_MAX_AGE:
+
+                    GetDoubleSetting(admin_GetBufferMaxAge);
+                    break;
+
+                case OBJECT_BUFFER_MAX_BYTES:
+
+                    GetIntegerSetting(admin_GetBufferMaxBytes);
+                    break;
+
+                case OBJECT_BUFFER_PRIORITY:
+
+                    printf("%d\n", admin_GetBufferPriority(PathArg));
+                    break;
+
+                case OBJECT_BUFFER_COMPRESSION:
+
+                    printf("%s\n", admin_GetBufferCompression(PathArg) ? "true" : "false");
+                    break;
+
                 case OBJECT_BACKUP_PERIOD:
 
                     GetIntegerSetting(admin_GetBufferBackupPeriod);
                     break;
 
+                case OBJECT_BACKUP_LOG:
+
+                    printf("%s\n", admin_GetBufferBackupLog(PathArg) ? "true" : "false");
+                    break;
+
                 case OBJECT_JSON_EXTRACTION:
                 {
                     char spec[ADMIN_MAX_JSON_EXTRACTOR_LEN];
@@ -2075,22 +2304,22 @@ COMPONENT_INIT
 
                 case OBJECT_MIN:
 
-                    GetBufferStat(query_GetMin);
+                    GetBufferStat(query_GetMinInRange);
                     break;
 
                 case OBJECT_MAX:
 
-                    GetBufferStat(query_GetMax);
+                    GetBufferStat(query_GetMaxInRange);
                     break;
 
                 case OBJECT_MEAN:
 
-                    GetBufferStat(query_GetMean);
+                    GetBufferStat(query_GetMeanInRange);
                     break;
 
                 case OBJECT_STD_DEVIATION:
 
-                    GetBufferStat(query_GetStdDev);
+                    GetBufferStat(query_GetStdDevInRange);
                     break;
             }
             break;
@@ -2146,11 +2375,36 @@ COMPONENT_INIT
                     SetIntegerSetting(PathArg, ValueArg, admin_SetBufferMaxCount);
                     break;
 
+                case OBJECT_BUFFER_MAX_AGE:
+
+                    SetDoubleSetting(PathArg, ValueArg, admin_SetBufferMaxAge);
+                    break;
+
+                case OBJECT_BUFFER_MAX_BYTES:
+
+                    SetIntegerSetting(PathArg, ValueArg, admin_SetBufferMaxBytes);
+                    break;
+
+                case OBJECT_BUFFER_PRIORITY:
+
+                    SetPrioritySetting(PathArg, ValueArg);
+                    break;
+
+                case OBJECT_BUFFER_COMPRESSION:
+
+                    SetBooleanSetting(PathArg, ValueArg, admin_SetBufferCompression);
+                    break;
+
                 case OBJECT_BACKUP_PERIOD:
 
                     SetIntegerSetting(PathArg, ValueArg, admin_SetBufferBackupPeriod);
                     break;
 
+                case OBJECT_BACKUP_LOG:
+
+                    SetBooleanSetting(PathArg, ValueArg, admin_SetBufferBackupLog);
+                    break;
+
                 case OBJECT_JSON_EXTRACTION:
 
                     admin_SetJsonExtraction(PathArg, ValueArg);
@@ -2224,7 +2478,28 @@ COMPONENT_INIT
                     admin_SetTransform(PathArg, ADMIN_OBS_TRANSFORM_TYPE_NONE, NULL, 0);
                     break;
 
+                case OBJECT_BUFFER_MAX_AGE:
+
+                    admin_SetBufferMaxAge(PathArg, NAN);
+                    break;
+
+                case OBJECT_BUFFER_PRIORITY:
+
+                    admin_SetBufferPriority(PathArg, 0);
+                    break;
+
+                case OBJECT_BUFFER_COMPRESSION:
+
+                    admin_SetBufferCompression(PathArg, false);
+                    break;
+
+                case OBJECT_BACKUP_LOG:
+
+                    admin_SetBufferBackupLog(PathArg, false);
+                    break;
+
                 case OBJECT_BUFFER_SIZE:
+                case OBJECT_BUFFER_MAX_BYTES:
                 case OBJECT_BACKUP_PERIOD:
 
                     fprintf(stderr, "This cannot be removed. Do you mean to set it to zero?\n");
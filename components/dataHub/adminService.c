@@ -9,6 +9,8 @@
 #include "dataHub.h"
 #include "ioService.h"
 #include "resource.h"
+#include "obs.h"
+#include "checkpoint.h"
 #include "handler.h"
 #include "json.h"
 
@@ -1304,6 +1306,294 @@ uint32_t admin_GetBufferMaxCount
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the maximum age of the data samples buffered in a given Observation.  Samples timestamped
+ * longer ago than this are dropped from the buffer, as well as any dropped to respect its maximum
+ * count.
+ *
+ * @return
+ *      - LE_OK If max buffer age was set successfully.
+ *      - LE_FAULT If an error happened during set.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t admin_SetBufferMaxAge
+(
+    const char* path,
+        ///< [IN] Path within the /obs/ namespace.
+    double seconds
+        ///< [IN] The maximum age, in seconds (NAN or 0 = remove setting).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    resTree_EntryRef_t obsEntry = GetObservation(path);
+
+    if (obsEntry == NULL)
+    {
+        LE_ERROR("Failed to get observation on path '%s'.", path);
+        return LE_FAULT;
+    }
+    else
+    {
+        resTree_SetBufferMaxAge(obsEntry, seconds);
+        return LE_OK;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the maximum age of the data samples buffered in a given Observation.
+ *
+ * @return The maximum age (in seconds), or NAN (not a number) if not set or the Observation does
+ *         not exist.
+ */
+//--------------------------------------------------------------------------------------------------
+double admin_GetBufferMaxAge
+(
+    const char* path
+        ///< [IN] Path within the /obs/ namespace.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    resTree_EntryRef_t resEntry = FindObservation(path);
+
+    if (resEntry == NULL)
+    {
+        return NAN;
+    }
+    else
+    {
+        return resTree_GetBufferMaxAge(resEntry);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the maximum number of bytes of memory that the data samples buffered in a given Observation
+ * can use.  This counts all the memory allocated for the buffer: the ring of samples (including
+ * any slots not yet filled), its statistics index, the compressed blocks, and the contents of
+ * strings.  When the limit is exceeded, the oldest samples are dropped (shrinking the ring) until
+ * it isn't, as well as any dropped to respect the maximum count.
+ *
+ * @return
+ *      - LE_OK If max buffer bytes was set successfully.
+ *      - LE_FAULT If an error happened during set.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t admin_SetBufferMaxBytes
+(
+    const char* path,
+        ///< [IN] Path within the /obs/ namespace.
+    uint32_t bytes
+        ///< [IN] The maximum number of bytes (0 = remove setting).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    resTree_EntryRef_t obsEntry = GetObservation(path);
+
+    if (obsEntry == NULL)
+    {
+        LE_ERROR("Failed to get observation on path '%s'.", path);
+        return LE_FAULT;
+    }
+    else
+    {
+        resTree_SetBufferMaxBytes(obsEntry, bytes);
+        return LE_OK;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the maximum number of bytes of memory that the data samples buffered in a given Observation
+ * can use.
+ *
+ * @return The maximum number of bytes, or 0 if not set or the Observation does not exist.
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t admin_GetBufferMaxBytes
+(
+    const char* path
+        ///< [IN] Path within the /obs/ namespace.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    resTree_EntryRef_t resEntry = FindObservation(path);
+
+    if (resEntry == NULL)
+    {
+        return 0;
+    }
+    else
+    {
+        return resTree_GetBufferMaxBytes(resEntry);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the priority of the data samples buffered in a given Observation.  When the samples buffered
+ * in all Observations use more memory than the buffer memory budget, the oldest samples are
+ * evicted from the buffers of the lowest priority Observations first.
+ *
+ * @return
+ *      - LE_OK If the priority was set successfully.
+ *      - LE_FAULT If an error happened during set.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t admin_SetBufferPriority
+(
+    const char* path,
+        ///< [IN] Path within the /obs/ namespace.
+    int32_t priority
+        ///< [IN] Higher = samples kept longer (default 0).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    resTree_EntryRef_t obsEntry = GetObservation(path);
+
+    if (obsEntry == NULL)
+    {
+        LE_ERROR("Failed to get observation on path '%s'.", path);
+        return LE_FAULT;
+    }
+    else
+    {
+        resTree_SetBufferPriority(obsEntry, priority);
+        return LE_OK;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the priority of the data samples buffered in a given Observation.
+ *
+ * @return The priority, or 0 if not set or the Observation does not exist.
+ */
+//--------------------------------------------------------------------------------------------------
+int32_t admin_GetBufferPriority
+(
+    const char* path
+        ///< [IN] Path within the /obs/ namespace.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    resTree_EntryRef_t resEntry = FindObservation(path);
+
+    if (resEntry == NULL)
+    {
+        return 0;
+    }
+    else
+    {
+        return resTree_GetBufferPriority(resEntry);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Enable or disable compression of the numeric and Boolean data samples buffered in a given
+ * Observation.  Samples already in the buffer are compressed (or decompressed) right away.
+ *
+ * @return
+ *      - LE_OK If the setting was changed successfully.
+ *      - LE_FAULT If an error happened during set.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t admin_SetBufferCompression
+(
+    const char* path,
+        ///< [IN] Path within the /obs/ namespace.
+    bool compress
+        ///< [IN] true = compress numerical samples (default false).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    resTree_EntryRef_t obsEntry = GetObservation(path);
+
+    if (obsEntry == NULL)
+    {
+        LE_ERROR("Failed to get observation on path '%s'.", path);
+        return LE_FAULT;
+    }
+    else
+    {
+        resTree_SetBufferCompression(obsEntry, compress);
+        return LE_OK;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether compression of the numerical data samples buffered in a given Observation is
+ * enabled.
+ *
+ * @return true if enabled, false if not or the Observation does not exist.
+ */
+//--------------------------------------------------------------------------------------------------
+bool admin_GetBufferCompression
+(
+    const char* path
+        ///< [IN] Path within the /obs/ namespace.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    resTree_EntryRef_t resEntry = FindObservation(path);
+
+    if (resEntry == NULL)
+    {
+        return false;
+    }
+    else
+    {
+        return resTree_GetBufferCompression(resEntry);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the maximum number of bytes of memory that the data samples buffered in all Observations can
+ * use.  When the budget is exceeded, the oldest samples are evicted from the buffers of the lowest
+ * priority Observations, rather than new samples being rejected.
+ */
+//--------------------------------------------------------------------------------------------------
+void admin_SetBufferBudget
+(
+    uint32_t bytes
+        ///< [IN] The maximum number of bytes (0 = no budget).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    obs_SetBufferBudget(bytes);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the maximum number of bytes of memory that the data samples buffered in all Observations can
+ * use.
+ *
+ * @return The maximum number of bytes, or 0 if not set.
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t admin_GetBufferBudget
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return obs_GetBufferBudget();
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Set the minimum time between backups of an Observation's buffer to non-volatile storage.
@@ -1369,6 +1659,240 @@ uint32_t admin_GetBufferBackupPeriod
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set whether an Observation's buffer is backed up by appending the samples added since the
+ * previous backup to a log, rather than by rewriting the whole buffer to its backup file.
+ *
+ * @return
+ *      - LE_OK If the setting was changed successfully.
+ *      - LE_FAULT If an error happened during set.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t admin_SetBufferBackupLog
+(
+    const char* path,
+        ///< [IN] Path within the /obs/ namespace.
+    bool useLog
+        ///< [IN] true = append to a log, false = rewrite the backup file (default).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    resTree_EntryRef_t obsEntry = GetObservation(path);
+
+    if (obsEntry == NULL)
+    {
+        LE_ERROR("Failed to get observation on path '%s'.", path);
+        return LE_FAULT;
+    }
+    else
+    {
+        resTree_SetBufferBackupLog(obsEntry, useLog);
+        return LE_OK;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether an Observation's buffer is backed up by appending to a log.
+ *
+ * @return true if backed up to a log, false if not or the Observation does not exist.
+ */
+//--------------------------------------------------------------------------------------------------
+bool admin_GetBufferBackupLog
+(
+    const char* path
+        ///< [IN] Path within the /obs/ namespace.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    resTree_EntryRef_t resEntry = FindObservation(path);
+
+    if (resEntry == NULL)
+    {
+        return false;
+    }
+    else
+    {
+        return resTree_GetBufferBackupLog(resEntry);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the maximum number of bytes that backups of all Observations' buffers can write to
+ * non-volatile storage per hour.  Backups that would exceed it are put off until later.
+ */
+//--------------------------------------------------------------------------------------------------
+void admin_SetBackupWriteBudget
+(
+    uint32_t bytesPerHour
+        ///< [IN] The maximum number of bytes per hour (0 = no limit).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    obs_SetBackupWriteBudget(bytesPerHour);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the maximum number of bytes that backups of all Observations' buffers can write to
+ * non-volatile storage per hour.
+ *
+ * @return The maximum number of bytes per hour, or 0 if not set.
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t admin_GetBackupWriteBudget
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return obs_GetBackupWriteBudget();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set whether the buffers of all Observations (other than those backed up to a log) are backed up
+ * together into a single pack file, instead of each into its own backup file.
+ */
+//--------------------------------------------------------------------------------------------------
+void admin_SetBackupPacked
+(
+    bool isPacked
+        ///< [IN] true = back up into the pack file, false = one backup file each (default).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    obs_SetBackupPacked(isPacked);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether the buffers of all Observations (other than those backed up to a log) are backed
+ * up together into a single pack file.
+ *
+ * @return true if backed up into the pack file.
+ */
+//--------------------------------------------------------------------------------------------------
+bool admin_GetBackupPacked
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return obs_GetBackupPacked();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set whether Observations' buffers are restored lazily from their backups, loading only the
+ * newest sample when an Observation is created and the rest when the buffer is first needed.
+ */
+//--------------------------------------------------------------------------------------------------
+void admin_SetBackupLazyRestore
+(
+    bool isLazy
+        ///< [IN] true = restore lazily, false = restore the whole buffer at once (default).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    obs_SetBackupLazyRestore(isLazy);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether Observations' buffers are restored lazily from their backups.
+ *
+ * @return true if restored lazily.
+ */
+//--------------------------------------------------------------------------------------------------
+bool admin_GetBackupLazyRestore
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return obs_GetBackupLazyRestore();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the number of seconds between checkpoints of the whole resource tree, from which it is
+ * rebuilt when the Data Hub restarts.  A checkpoint is only written if something has changed.
+ */
+//--------------------------------------------------------------------------------------------------
+void admin_SetCheckpointPeriod
+(
+    uint32_t seconds
+        ///< [IN] Seconds between checkpoints (0 = don't save checkpoints).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    checkpoint_SetPeriod(seconds);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of seconds between checkpoints of the whole resource tree.
+ *
+ * @return The number of seconds, or 0 if checkpoints are not saved.
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t admin_GetCheckpointPeriod
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return checkpoint_GetPeriod();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the number of milliseconds between updates of the state of the whole resource tree, along
+ * with copies of the Observations' buffers, kept in shared memory so that the Data Hub can pick up
+ * where it left off if it is restarted.
+ */
+//--------------------------------------------------------------------------------------------------
+void admin_SetStateSegmentPeriod
+(
+    uint32_t ms
+        ///< [IN] Milliseconds between updates (0 = don't keep the state in memory).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    checkpoint_SetStatePeriod(ms);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of milliseconds between updates of the state kept in shared memory.
+ *
+ * @return The number of milliseconds, or 0 if the state isn't kept in shared memory.
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t admin_GetStateSegmentPeriod
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return checkpoint_GetStatePeriod();
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Check if a given resource is a mandatory output.  If so, it means that this is an output resource
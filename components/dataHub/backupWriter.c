@@ -0,0 +1,700 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * Implementation of the Backup Writer module, which writes backup files from a dedicated thread so
+ * that the Data Hub's event loop isn't held up waiting for flash.
+ *
+ * Images are kept as lists of fixed-size chunks, so they can be built up without knowing their
+ * size in advance and without ever moving bytes that have already been appended.
+ *
+ * Submitted work is queued to the writer thread's event loop, which runs it in order.  When a work
+ * function returns, the work's completion function is queued back to the submitting thread.
+ * Work is numbered in the order it is submitted, and the writer thread keeps track of the number
+ * of the last work it has done, so that the submitter can wait for particular work to be done.
+ * The writer thread is only started when the first work is submitted, so it isn't created at all
+ * if backups are never enabled.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#include "interfaces.h"
+#include "dataHub.h"
+#include "backupWriter.h"
+
+
+/// Number of bytes of data in each chunk of an image.
+#define CHUNK_DATA_BYTES 4096
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * A chunk of an image.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_dls_Link_t link;                 ///< Used to link into the image's list of chunks.
+    size_t used;                        ///< Number of bytes of data in use.
+    uint8_t data[CHUNK_DATA_BYTES];     ///< The data.
+}
+Chunk_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * An image of a file's contents.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct backupWriter_Image
+{
+    le_dls_List_t chunkList;    ///< List of chunks, in order.
+    size_t size;                ///< Total number of bytes in the image.
+}
+Image_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * A piece of submitted work.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    backupWriter_WorkFunc_t workFunc;               ///< Function to run on the writer thread.
+    backupWriter_CompletionFunc_t completionFunc;   ///< Function to run when the work is done.
+    void* contextPtr;                               ///< Context pointer passed to both.
+    le_thread_Ref_t submitter;                      ///< Thread that submitted the work.
+    uint64_t seq;                                   ///< Sequence number of the work.
+}
+Work_t;
+
+
+/// Pool of images.
+static le_mem_PoolRef_t ImagePool = NULL;
+
+/// Pool of image chunks.
+static le_mem_PoolRef_t ChunkPool = NULL;
+
+/// Pool of work records.
+static le_mem_PoolRef_t WorkPool = NULL;
+
+/// The writer thread, or NULL if not started yet.
+static le_thread_Ref_t WriterThread = NULL;
+
+/// Semaphore posted by the writer thread when it's ready to run work.
+static le_sem_Ref_t ReadySem = NULL;
+
+/// Semaphore posted by the writer thread when it has done the work being waited for.
+static le_sem_Ref_t DoneSem = NULL;
+
+/// Mutex protecting DoneSeq and AwaitedSeq, which are shared with the writer thread.
+static le_mutex_Ref_t DoneMutex = NULL;
+
+/// Sequence number of the last work submitted (0 = none yet).
+static uint64_t SubmittedSeq = 0;
+
+/// Sequence number of the last work done by the writer thread (0 = none yet).
+static uint64_t DoneSeq = 0;
+
+/// Sequence number of the work being waited for (0 = none).
+static uint64_t AwaitedSeq = 0;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Main function of the writer thread.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* WriterThreadMain
+(
+    void* contextPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LE_UNUSED(contextPtr);
+
+    le_sem_Post(ReadySem);
+
+    le_event_RunLoop();
+
+    return NULL;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Runs on the submitting thread when some work is done.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CompleteWork
+(
+    void* param1Ptr,    ///< Work record.
+    void* param2Ptr     ///< Not used.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LE_UNUSED(param2Ptr);
+
+    Work_t* workPtr = param1Ptr;
+
+    if (workPtr->completionFunc != NULL)
+    {
+        workPtr->completionFunc(workPtr->contextPtr);
+    }
+
+    le_mem_Release(workPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Runs on the writer thread to do some work.
+ */
+//--------------------------------------------------------------------------------------------------
+static void DoWork
+(
+    void* param1Ptr,    ///< Work record.
+    void* param2Ptr     ///< Not used.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LE_UNUSED(param2Ptr);
+
+    Work_t* workPtr = param1Ptr;
+
+    workPtr->workFunc(workPtr->contextPtr);
+
+    le_mutex_Lock(DoneMutex);
+    DoneSeq = workPtr->seq;
+    if ((AwaitedSeq != 0) && (DoneSeq >= AwaitedSeq))
+    {
+        AwaitedSeq = 0;
+        le_sem_Post(DoneSem);
+    }
+    le_mutex_Unlock(DoneMutex);
+
+    le_event_QueueFunctionToThread(workPtr->submitter, CompleteWork, workPtr, NULL);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add a chunk to the end of an image.
+ *
+ * @return Ptr to the chunk, or NULL if out of memory.
+ */
+//--------------------------------------------------------------------------------------------------
+static Chunk_t* AddChunk
+(
+    Image_t* imagePtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Chunk_t* chunkPtr = hub_MemAlloc(ChunkPool);
+    if (chunkPtr == NULL)
+    {
+        LE_CRIT("Out of memory for backup image.");
+        return NULL;
+    }
+
+    chunkPtr->link = LE_DLS_LINK_INIT;
+    chunkPtr->used = 0;
+    le_dls_Queue(&imagePtr->chunkList, &chunkPtr->link);
+
+    return chunkPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the last chunk of an image.
+ *
+ * @return Ptr to the chunk, or NULL if the image is empty.
+ */
+//--------------------------------------------------------------------------------------------------
+static Chunk_t* GetLastChunk
+(
+    Image_t* imagePtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_dls_Link_t* linkPtr = le_dls_PeekTail(&imagePtr->chunkList);
+
+    return (linkPtr == NULL) ? NULL : CONTAINER_OF(linkPtr, Chunk_t, link);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize the Backup Writer module.  The writer thread is not started until work is first
+ * submitted.
+ */
+//--------------------------------------------------------------------------------------------------
+void backupWriter_Init
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    ImagePool = le_mem_CreatePool("BackupImage", sizeof(Image_t));
+    ChunkPool = le_mem_CreatePool("BackupChunk", sizeof(Chunk_t));
+    WorkPool = le_mem_CreatePool("BackupWork", sizeof(Work_t));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create an empty image.
+ *
+ * @return Reference to the image, or NULL if out of memory.
+ */
+//--------------------------------------------------------------------------------------------------
+backupWriter_ImageRef_t backupWriter_CreateImage
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Image_t* imagePtr = hub_MemAlloc(ImagePool);
+    if (imagePtr == NULL)
+    {
+        LE_CRIT("Out of memory for backup image.");
+        return NULL;
+    }
+
+    imagePtr->chunkList = LE_DLS_LIST_INIT;
+    imagePtr->size = 0;
+
+    return imagePtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Delete an image.
+ */
+//--------------------------------------------------------------------------------------------------
+void backupWriter_DeleteImage
+(
+    backupWriter_ImageRef_t imageRef
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_dls_Link_t* linkPtr;
+
+    while ((linkPtr = le_dls_Pop(&imageRef->chunkList)) != NULL)
+    {
+        le_mem_Release(CONTAINER_OF(linkPtr, Chunk_t, link));
+    }
+
+    le_mem_Release(imageRef);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append some bytes to the end of an image.
+ *
+ * @return true if successful, false if out of memory (in which case the image is unchanged).
+ */
+//--------------------------------------------------------------------------------------------------
+bool backupWriter_Append
+(
+    backupWriter_ImageRef_t imageRef,
+    const void* buffPtr,
+    size_t buffSize
+)
+//--------------------------------------------------------------------------------------------------
+{
+    const uint8_t* srcPtr = buffPtr;
+    Chunk_t* chunkPtr = GetLastChunk(imageRef);
+
+    // Remember where the image ended, so it can be put back that way if we run out of memory.
+    Chunk_t* oldLastPtr = chunkPtr;
+    size_t oldLastUsed = (chunkPtr == NULL) ? 0 : chunkPtr->used;
+
+    while (buffSize > 0)
+    {
+        if ((chunkPtr == NULL) || (chunkPtr->used == CHUNK_DATA_BYTES))
+        {
+            chunkPtr = AddChunk(imageRef);
+            if (chunkPtr == NULL)
+            {
+                goto error;
+            }
+        }
+
+        size_t len = CHUNK_DATA_BYTES - chunkPtr->used;
+        if (len > buffSize)
+        {
+            len = buffSize;
+        }
+
+        memcpy(chunkPtr->data + chunkPtr->used, srcPtr, len);
+        chunkPtr->used += len;
+        imageRef->size += len;
+        srcPtr += len;
+        buffSize -= len;
+    }
+
+    return true;
+
+error:
+
+    while ((chunkPtr = GetLastChunk(imageRef)) != oldLastPtr)
+    {
+        imageRef->size -= chunkPtr->used;
+        le_dls_Remove(&imageRef->chunkList, &chunkPtr->link);
+        le_mem_Release(chunkPtr);
+    }
+    if (oldLastPtr != NULL)
+    {
+        imageRef->size -= oldLastPtr->used - oldLastUsed;
+        oldLastPtr->used = oldLastUsed;
+    }
+
+    return false;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append a given number of contiguous bytes to the end of an image, to be filled in by the caller.
+ * The bytes can be filled in at any time until the image is submitted for writing.
+ *
+ * @return Pointer to the bytes, or NULL if out of memory or more bytes than fit contiguously
+ *         (BACKUP_WRITER_MAX_RESERVE_BYTES) were asked for.
+ */
+//--------------------------------------------------------------------------------------------------
+void* backupWriter_Reserve
+(
+    backupWriter_ImageRef_t imageRef,
+    size_t byteCount
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (byteCount > BACKUP_WRITER_MAX_RESERVE_BYTES)
+    {
+        LE_CRIT("Can't reserve %zu bytes in a backup image.", byteCount);
+        return NULL;
+    }
+
+    // If the bytes don't fit in what's left of the last chunk, start a new one.  Chunks need not
+    // be full, so this leaves no gap in the image.
+    Chunk_t* chunkPtr = GetLastChunk(imageRef);
+    if ((chunkPtr == NULL) || (CHUNK_DATA_BYTES - chunkPtr->used < byteCount))
+    {
+        chunkPtr = AddChunk(imageRef);
+        if (chunkPtr == NULL)
+        {
+            return NULL;
+        }
+    }
+
+    void* bytesPtr = chunkPtr->data + chunkPtr->used;
+    chunkPtr->used += byteCount;
+    imageRef->size += byteCount;
+
+    return bytesPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of bytes in an image.
+ *
+ * @return The number of bytes.
+ */
+//--------------------------------------------------------------------------------------------------
+size_t backupWriter_GetSize
+(
+    backupWriter_ImageRef_t imageRef
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return imageRef->size;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compute the CRC-32 of an image's contents.  The image must be complete, with any reserved bytes
+ * filled in.
+ *
+ * @return The CRC.
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t backupWriter_ComputeCrc32
+(
+    backupWriter_ImageRef_t imageRef
+)
+//--------------------------------------------------------------------------------------------------
+{
+    uint32_t crc = LE_CRC_START_CRC32;
+
+    le_dls_Link_t* linkPtr = le_dls_Peek(&imageRef->chunkList);
+    while (linkPtr != NULL)
+    {
+        Chunk_t* chunkPtr = CONTAINER_OF(linkPtr, Chunk_t, link);
+
+        crc = le_crc_Crc32(chunkPtr->data, chunkPtr->used, crc);
+
+        linkPtr = le_dls_PeekNext(&imageRef->chunkList, linkPtr);
+    }
+
+    return crc;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Copy an image's contents to a buffer in memory.  The image must be complete, with any reserved
+ * bytes filled in.
+ */
+//--------------------------------------------------------------------------------------------------
+void backupWriter_CopyToBuffer
+(
+    backupWriter_ImageRef_t imageRef,
+    void* buffPtr   ///< Buffer big enough for the whole image (see backupWriter_GetSize()).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    uint8_t* destPtr = buffPtr;
+
+    le_dls_Link_t* linkPtr = le_dls_Peek(&imageRef->chunkList);
+    while (linkPtr != NULL)
+    {
+        Chunk_t* chunkPtr = CONTAINER_OF(linkPtr, Chunk_t, link);
+
+        memcpy(destPtr, chunkPtr->data, chunkPtr->used);
+        destPtr += chunkPtr->used;
+
+        linkPtr = le_dls_PeekNext(&imageRef->chunkList, linkPtr);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Submit some work to be done by the writer thread.
+ *
+ * @return The work's sequence number (see backupWriter_WaitFor()).
+ */
+//--------------------------------------------------------------------------------------------------
+uint64_t backupWriter_Submit
+(
+    backupWriter_WorkFunc_t workFunc,               ///< Function to run on the writer thread.
+    backupWriter_CompletionFunc_t completionFunc,   ///< Function to run when the work is done.
+    void* contextPtr                                ///< Context pointer passed to both.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (WriterThread == NULL)
+    {
+        DoneSem = le_sem_Create("BackupWriterDone", 0);
+        DoneMutex = le_mutex_CreateNonRecursive("BackupWriterDone");
+        ReadySem = le_sem_Create("BackupWriterReady", 0);
+        WriterThread = le_thread_Create("DataHubBackup", WriterThreadMain, NULL);
+        le_thread_Start(WriterThread);
+
+        // Wait for the thread's event loop to be ready before queueing anything to it.
+        le_sem_Wait(ReadySem);
+    }
+
+    Work_t* workPtr = le_mem_ForceAlloc(WorkPool);
+    workPtr->workFunc = workFunc;
+    workPtr->completionFunc = completionFunc;
+    workPtr->contextPtr = contextPtr;
+    workPtr->submitter = le_thread_GetCurrent();
+    workPtr->seq = ++SubmittedSeq;
+
+    le_event_QueueFunctionToThread(WriterThread, DoWork, workPtr, NULL);
+
+    return workPtr->seq;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Wait until the writer thread has done the work with a given sequence number, and so all the
+ * work submitted before it.  The completion functions of that work may not have run yet.
+ */
+//--------------------------------------------------------------------------------------------------
+void backupWriter_WaitFor
+(
+    uint64_t seq    ///< Sequence number returned by backupWriter_Submit().
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (WriterThread == NULL)
+    {
+        return;
+    }
+
+    le_mutex_Lock(DoneMutex);
+    if (DoneSeq >= seq)
+    {
+        le_mutex_Unlock(DoneMutex);
+        return;
+    }
+    AwaitedSeq = seq;
+    le_mutex_Unlock(DoneMutex);
+
+    le_sem_Wait(DoneSem);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Wait until the writer thread has done all the work submitted so far.  The completion functions
+ * of that work may not have run yet.
+ */
+//--------------------------------------------------------------------------------------------------
+void backupWriter_Flush
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    backupWriter_WaitFor(SubmittedSeq);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write an image's contents to a stream.  Only to be called by a work function.
+ *
+ * @return LE_OK if successful, LE_FAULT if failed.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t backupWriter_WriteToStream
+(
+    backupWriter_ImageRef_t imageRef,
+    FILE* file
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_dls_Link_t* linkPtr = le_dls_Peek(&imageRef->chunkList);
+    while (linkPtr != NULL)
+    {
+        Chunk_t* chunkPtr = CONTAINER_OF(linkPtr, Chunk_t, link);
+
+        if ((chunkPtr->used > 0) && (fwrite(chunkPtr->data, chunkPtr->used, 1, file) != 1))
+        {
+            return LE_FAULT;
+        }
+
+        linkPtr = le_dls_PeekNext(&imageRef->chunkList, linkPtr);
+    }
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Atomically replace (or create) a file with an image's contents, which are flushed to
+ * non-volatile storage.  Only to be called by a work function.
+ *
+ * @return LE_OK if successful, LE_FAULT if failed.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t backupWriter_ReplaceFile
+(
+    backupWriter_ImageRef_t imageRef,
+    const char* path
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_result_t result;
+    FILE* file = le_atomFile_CreateStream(path,
+                                          LE_FLOCK_WRITE,
+                                          LE_FLOCK_REPLACE_IF_EXIST,
+                                          0600,
+                                          &result);
+    if (result != LE_OK)
+    {
+        LE_CRIT("Unable to open file '%s' for writing (%s).", path, LE_RESULT_TXT(result));
+        return LE_FAULT;
+    }
+
+    if (backupWriter_WriteToStream(imageRef, file) != LE_OK)
+    {
+        LE_CRIT("Failed to write '%s' (%m).", path);
+        le_atomFile_CancelStream(file);
+        return LE_FAULT;
+    }
+
+    // Commit the file.
+    result = le_atomFile_CloseStream(file);
+    if (result != LE_OK)
+    {
+        LE_CRIT("Failed to save '%s' (%s).", path, LE_RESULT_TXT(result));
+        return LE_FAULT;
+    }
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append an image's contents to an existing file and flush them to non-volatile storage.  Only to
+ * be called by a work function.
+ *
+ * @return LE_OK if successful, LE_FAULT if failed (in which case part of the image may have been
+ *         appended).
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t backupWriter_AppendToFile
+(
+    backupWriter_ImageRef_t imageRef,
+    const char* path
+)
+//--------------------------------------------------------------------------------------------------
+{
+    int fd = open(path, O_WRONLY | O_APPEND);
+    if (fd == -1)
+    {
+        LE_CRIT("Unable to open file '%s' for appending (%m).", path);
+        return LE_FAULT;
+    }
+
+    le_result_t result = LE_OK;
+
+    le_dls_Link_t* linkPtr = le_dls_Peek(&imageRef->chunkList);
+    while ((linkPtr != NULL) && (result == LE_OK))
+    {
+        Chunk_t* chunkPtr = CONTAINER_OF(linkPtr, Chunk_t, link);
+        size_t offset = 0;
+
+        while (offset < chunkPtr->used)
+        {
+            ssize_t len = write(fd, chunkPtr->data + offset, chunkPtr->used - offset);
+            if (len < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+
+                LE_CRIT("Failed to write '%s' (%m).", path);
+                result = LE_FAULT;
+                break;
+            }
+            offset += len;
+        }
+
+        linkPtr = le_dls_PeekNext(&imageRef->chunkList, linkPtr);
+    }
+
+    if ((result == LE_OK) && (fsync(fd) != 0))
+    {
+        LE_CRIT("Failed to save '%s' (%m).", path);
+        result = LE_FAULT;
+    }
+
+    close(fd);
+
+    return result;
+}
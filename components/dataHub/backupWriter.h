@@ -0,0 +1,256 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * @file backupWriter.h
+ *
+ * Interface to the Backup Writer module.
+ *
+ * Writing a backup to flash (and waiting for it to be flushed) can take a long time, during which
+ * the Data Hub's event loop would not be serving its clients.  So, backups are serialized into an
+ * in-memory image on the main thread, and the image is written out by a dedicated writer thread.
+ *
+ * The work to do with an image is submitted as a work function, which the writer thread runs.
+ * Work is done in the order it was submitted.  When a work function is done, a completion function
+ * is run on the thread that submitted the work.
+ *
+ * Images are built and deleted by the thread that submits the work, but must be left untouched
+ * from the time the work is submitted until the work is complete.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#ifndef BACKUP_WRITER_H_INCLUDE_GUARD
+#define BACKUP_WRITER_H_INCLUDE_GUARD
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reference to an in-memory image of a file's contents.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct backupWriter_Image* backupWriter_ImageRef_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function run by the writer thread to do some submitted work.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef void (*backupWriter_WorkFunc_t)
+(
+    void* contextPtr    ///< Context pointer given when the work was submitted.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function run by the thread that submitted some work, once the work is done.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef void (*backupWriter_CompletionFunc_t)
+(
+    void* contextPtr    ///< Context pointer given when the work was submitted.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize the Backup Writer module.  The writer thread is not started until work is first
+ * submitted.
+ */
+//--------------------------------------------------------------------------------------------------
+void backupWriter_Init
+(
+    void
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create an empty image.
+ *
+ * @return Reference to the image, or NULL if out of memory.
+ */
+//--------------------------------------------------------------------------------------------------
+backupWriter_ImageRef_t backupWriter_CreateImage
+(
+    void
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Delete an image.
+ */
+//--------------------------------------------------------------------------------------------------
+void backupWriter_DeleteImage
+(
+    backupWriter_ImageRef_t imageRef
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append some bytes to the end of an image.
+ *
+ * @return true if successful, false if out of memory (in which case the image is unchanged).
+ */
+//--------------------------------------------------------------------------------------------------
+bool backupWriter_Append
+(
+    backupWriter_ImageRef_t imageRef,
+    const void* buffPtr,
+    size_t buffSize
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append a given number of contiguous bytes to the end of an image, to be filled in by the caller.
+ * The bytes can be filled in at any time until the image is submitted for writing.
+ *
+ * @return Pointer to the bytes, or NULL if out of memory or more bytes than fit contiguously
+ *         (BACKUP_WRITER_MAX_RESERVE_BYTES) were asked for.
+ */
+//--------------------------------------------------------------------------------------------------
+void* backupWriter_Reserve
+(
+    backupWriter_ImageRef_t imageRef,
+    size_t byteCount
+);
+
+/// Largest number of bytes that can be reserved at once with backupWriter_Reserve().
+#define BACKUP_WRITER_MAX_RESERVE_BYTES 64
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of bytes in an image.
+ *
+ * @return The number of bytes.
+ */
+//--------------------------------------------------------------------------------------------------
+size_t backupWriter_GetSize
+(
+    backupWriter_ImageRef_t imageRef
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compute the CRC-32 of an image's contents.  The image must be complete, with any reserved bytes
+ * filled in.
+ *
+ * @return The CRC.
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t backupWriter_ComputeCrc32
+(
+    backupWriter_ImageRef_t imageRef
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Copy an image's contents to a buffer in memory.  The image must be complete, with any reserved
+ * bytes filled in.
+ */
+//--------------------------------------------------------------------------------------------------
+void backupWriter_CopyToBuffer
+(
+    backupWriter_ImageRef_t imageRef,
+    void* buffPtr   ///< Buffer big enough for the whole image (see backupWriter_GetSize()).
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Submit some work to be done by the writer thread.
+ *
+ * @return The work's sequence number (see backupWriter_WaitFor()).
+ */
+//--------------------------------------------------------------------------------------------------
+uint64_t backupWriter_Submit
+(
+    backupWriter_WorkFunc_t workFunc,               ///< Function to run on the writer thread.
+    backupWriter_CompletionFunc_t completionFunc,   ///< Function to run when the work is done.
+    void* contextPtr                                ///< Context pointer passed to both.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Wait until the writer thread has done the work with a given sequence number, and so all the
+ * work submitted before it.  The completion functions of that work may not have run yet.
+ *
+ * @note This blocks the calling thread, so is only for when particular files must be up to date
+ *       before going on, such as before reading them back.
+ */
+//--------------------------------------------------------------------------------------------------
+void backupWriter_WaitFor
+(
+    uint64_t seq    ///< Sequence number returned by backupWriter_Submit().
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Wait until the writer thread has done all the work submitted so far.  The completion functions
+ * of that work may not have run yet.
+ *
+ * @note This blocks the calling thread, so is only for when files must be up to date before going
+ *       on, such as before reading them back.
+ */
+//--------------------------------------------------------------------------------------------------
+void backupWriter_Flush
+(
+    void
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write an image's contents to a stream.  Only to be called by a work function.
+ *
+ * @return LE_OK if successful, LE_FAULT if failed.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t backupWriter_WriteToStream
+(
+    backupWriter_ImageRef_t imageRef,
+    FILE* file
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Atomically replace (or create) a file with an image's contents, which are flushed to
+ * non-volatile storage.  Only to be called by a work function.
+ *
+ * @return LE_OK if successful, LE_FAULT if failed.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t backupWriter_ReplaceFile
+(
+    backupWriter_ImageRef_t imageRef,
+    const char* path
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append an image's contents to an existing file and flush them to non-volatile storage.  Only to
+ * be called by a work function.
+ *
+ * @return LE_OK if successful, LE_FAULT if failed (in which case part of the image may have been
+ *         appended).
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t backupWriter_AppendToFile
+(
+    backupWriter_ImageRef_t imageRef,
+    const char* path
+);
+
+
+#endif // BACKUP_WRITER_H_INCLUDE_GUARD
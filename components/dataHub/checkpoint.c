@@ -0,0 +1,1990 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * Implementation of the Checkpoint module, which saves the state of the whole resource tree to a
+ * checkpoint file at regular intervals and rebuilds the tree from it when the Data Hub starts.
+ *
+ * Each checkpoint is built in memory on the main thread, so it is a consistent picture of the
+ * tree, and is written by the Backup Writer's thread, atomically replacing the previous one.
+ * So, if the Data Hub (or the device) goes down at any point, the last complete checkpoint is
+ * still there.  A checkpoint that is the same as the last one written is not written again.
+ *
+ * Inputs and Outputs are restored as if their apps had created them again, so the apps find them
+ * already there when they reconnect.  Observations are restored along with their buffers (see
+ * obs_RestoreBackup()).  Values are put back without being pushed, so nothing is passed on along
+ * routes or to buffers, and the values keep their original timestamps.
+ *
+ * Checkpoint file format (numbers are in host byte order):
+ *  - header:
+ *      - magic number CHECKPOINT_MAGIC (4 bytes)
+ *      - format version = 2-byte unsigned integer (CHECKPOINT_VERSION)
+ *      - reserved = 2 bytes of zero
+ *      - number of entries = 4-byte unsigned integer
+ *  - Data Hub settings, as any number of fields (see SettingTag_t, and below), followed by an end
+ *    field (tag 0, with no value)
+ *  - one entry per resource:
+ *      - entry type (admin_EntryType_t) = 1-byte unsigned integer
+ *      - number of bytes in the path, including its null terminator = 2-byte unsigned integer
+ *      - absolute path of the resource (null-terminated)
+ *      - any number of fields (see FieldTag_t), each being:
+ *          - field tag = 1-byte unsigned integer
+ *          - number of bytes in the value = 2-byte unsigned integer
+ *          - value
+ *      - end field (FIELD_END, with no value)
+ *  - CRC-32 of everything before it = 4-byte unsigned integer
+ *
+ * Data sample values are stored as:
+ *  - data type (io_DataType_t) = 1-byte unsigned integer
+ *  - timestamp = 8-byte double
+ *  - value = nothing for a trigger, 1 byte (0 or 1) for a Boolean, 8-byte double for a number,
+ *    or a null-terminated string for a string or JSON value.
+ *
+ * Fields are only stored if they aren't at their default, and fields with unknown tags are
+ * skipped when loading, so fields can be added without changing the format version.
+ *
+ * The settings are restored before any of the resources, so they are in effect when the
+ * Observations' buffers are restored.
+ *
+ * Optionally, the state is also kept in the State Segment (see stateSegment.h), which is updated
+ * much more often, as it is only a copy in memory.  The image kept there also holds copies of the
+ * Observations' buffers, so that if the Data Hub is restarted after a failure, it can pick up where
+ * it left off without reading anything back from flash.  The image is loaded instead of the
+ * checkpoint file if it is newer.  Its format (numbers are in host byte order) is:
+ *  - number of bytes in the resource tree = 4-byte unsigned integer
+ *  - resource tree, as in a checkpoint file but without the CRC
+ *  - one record per Observation with a buffer, each being:
+ *      - number of bytes in the path, including its null terminator = 2-byte unsigned integer
+ *      - absolute path of the Observation (null-terminated)
+ *      - number of bytes in the copy of the buffer = 4-byte unsigned integer
+ *      - copy of the buffer, in the backup file format (see obs.c)
+ *  - end record = 2 bytes of zero
+ *
+ * The State Segment checks the whole image against a CRC of its own.  The copies of buffers that
+ * haven't changed since the last image stored there are copied from that image as they are,
+ * rather than being encoded again.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#include "interfaces.h"
+#include "dataHub.h"
+#include "dataSample.h"
+#include "resource.h"
+#include "resTree.h"
+#include "obs.h"
+#include "backupWriter.h"
+#include "stateSegment.h"
+#include "checkpoint.h"
+
+#ifdef LEGATO_EMBEDDED
+ #define CHECKPOINT_PATH "/home/root/dataHub.ckpt"
+#else
+ #define CHECKPOINT_PATH "dataHub.ckpt"
+#endif
+
+/// Magic number at the start of a checkpoint file.
+#define CHECKPOINT_MAGIC "DHCK"
+
+/// Version of the checkpoint file format written.
+#define CHECKPOINT_VERSION 1
+
+/// Number of bytes in a checkpoint file's header.
+#define CHECKPOINT_HEADER_BYTES 12
+
+/// Number of bytes in the CRC at the end of a checkpoint file.
+#define CHECKPOINT_CRC_BYTES 4
+
+/// Number of bytes in the header of a field (tag and value length).
+#define FIELD_HEADER_BYTES 3
+
+/// Number of bytes in a data sample value before the value itself (data type and timestamp).
+#define SAMPLE_HEADER_BYTES 9
+
+/// Default number of seconds between checkpoints (0 = not saved).
+#define DEFAULT_CHECKPOINT_PERIOD 0
+
+/// Default number of milliseconds between updates of the State Segment (0 = not kept).
+#define DEFAULT_STATE_PERIOD 0
+
+/// Shortest number of milliseconds between updates of the State Segment.  Each update copies the
+/// whole resource tree and every Observation's buffer, so it mustn't be allowed to hog the main
+/// thread.
+#define MIN_STATE_PERIOD 1000
+
+/// Number of bytes before the resource tree in a State Segment image.
+#define STATE_HEADER_BYTES 4
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Tags of the fields of a checkpoint entry.  These are stored in checkpoint files, so must never
+ * be renumbered.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef enum
+{
+    FIELD_END = 0,          ///< End of the entry (no value).
+    FIELD_DATA_TYPE = 1,    ///< Data type of an Input or Output (1 byte).
+    FIELD_UNITS = 2,        ///< Units (null-terminated string).
+    FIELD_OPTIONAL = 3,     ///< Output is optional (no value).
+    FIELD_CURRENT = 4,      ///< Current value (data sample).
+    FIELD_PUSHED = 5,       ///< Last value pushed (data sample, or none if the current value).
+    FIELD_DEFAULT = 6,      ///< Default value (data sample).
+    FIELD_OVERRIDE = 7,     ///< Override (data sample).
+    FIELD_JSON_EXAMPLE = 8, ///< JSON example value (data sample).
+    FIELD_SOURCE = 9,       ///< Absolute path of the data source (null-terminated string).
+    FIELD_MIN_PERIOD = 10,  ///< Observation's minimum period (8-byte double).
+    FIELD_HIGH_LIMIT = 11,  ///< Observation's high limit (8-byte double).
+    FIELD_LOW_LIMIT = 12,   ///< Observation's low limit (8-byte double).
+    FIELD_CHANGE_BY = 13,   ///< Observation's change-by (8-byte double).
+    FIELD_TRANSFORM = 14,   ///< Observation's transform (1 byte).
+    FIELD_MAX_COUNT = 15,   ///< Observation's buffer size (4-byte unsigned integer).
+    FIELD_MAX_AGE = 16,     ///< Observation's buffer maximum age (8-byte double).
+    FIELD_MAX_BYTES = 17,   ///< Observation's buffer maximum bytes (4-byte unsigned integer).
+    FIELD_PRIORITY = 18,    ///< Observation's buffer priority (4-byte signed integer).
+    FIELD_COMPRESSION = 19, ///< Observation's buffer is compressed (no value).
+    FIELD_BACKUP_PERIOD = 20,   ///< Observation's buffer backup period (4-byte unsigned integer).
+    FIELD_BACKUP_LOG = 21,  ///< Observation's buffer is backed up to a log (no value).
+    FIELD_JSON_EXTRACTION = 22, ///< Observation's JSON extraction (null-terminated string).
+    FIELD_DESTINATION = 23, ///< Observation's destination (null-terminated string).
+    FIELD_CONFIG = 24,      ///< Observation was created by a config file (no value).
+}
+FieldTag_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Tags of the Data Hub settings fields.  These are stored in checkpoint files, so must never be
+ * renumbered.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef enum
+{
+    SETTING_END = 0,            ///< End of the settings (no value).
+    SETTING_LAZY_RESTORE = 1,   ///< Observations' buffers are restored lazily (no value).
+    SETTING_PERIOD = 2,         ///< Seconds between checkpoints (4-byte unsigned integer).
+    SETTING_STATE_PERIOD = 3,   ///< Milliseconds between State Segment updates (4-byte unsigned).
+}
+SettingTag_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Everything saved about a resource.  When saving, the strings and data sample references point
+ * into the resource tree.  When loading, the strings point into the checkpoint file's contents,
+ * and the data sample references are owned by the entry.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    admin_EntryType_t entryType;    ///< Type of resource.
+    const char* path;               ///< Absolute path of the resource.
+    io_DataType_t dataType;         ///< Data type, if an Input or Output.
+    bool isOptional;                ///< true if an optional Output.
+    res_State_t state;              ///< Values held by the resource.
+    const char* sourcePath;         ///< Absolute path of the data source, or NULL if none.
+    double minPeriod;               ///< Observation's minimum period (NAN if not set).
+    double highLimit;               ///< Observation's high limit (NAN if not set).
+    double lowLimit;                ///< Observation's low limit (NAN if not set).
+    double changeBy;                ///< Observation's change-by (NAN if not set).
+    admin_TransformType_t transform;    ///< Observation's transform.
+    uint32_t maxCount;              ///< Observation's buffer size.
+    double maxAge;                  ///< Observation's buffer maximum age (NAN if not set).
+    uint32_t maxBytes;              ///< Observation's buffer maximum bytes (0 if not set).
+    int32_t priority;               ///< Observation's buffer priority.
+    bool compress;                  ///< true if the Observation's buffer is compressed.
+    uint32_t backupPeriod;          ///< Observation's buffer backup period (0 if not backed up).
+    bool backupLog;                 ///< true if the Observation's buffer is backed up to a log.
+    const char* jsonExtraction;     ///< Observation's JSON extraction, or NULL or "" if not set.
+    const char* destination;        ///< Observation's destination, or NULL or "" if not set.
+    bool isConfig;                  ///< true if the Observation was created by a config file.
+}
+Entry_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * A checkpoint being written.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    backupWriter_ImageRef_t imageRef;   ///< Contents of the checkpoint file.
+    uint32_t crc;                       ///< CRC-32 at the end of the contents.
+    bool isOk;                          ///< true if the checkpoint was written successfully.
+}
+Job_t;
+
+/// Pool of checkpoint write jobs.
+static le_mem_PoolRef_t JobPool = NULL;
+
+/// Number of seconds between checkpoints (0 = checkpoints are not saved).
+static uint32_t Period = DEFAULT_CHECKPOINT_PERIOD;
+
+/// Timer that expires when the next checkpoint is due.
+static le_timer_Ref_t CheckpointTimer = NULL;
+
+/// Checkpoint being written, or NULL if none.
+static Job_t* WritingJobPtr = NULL;
+
+/// CRC-32 of the last checkpoint written (or loaded), so an unchanged one isn't written again.
+static uint32_t LastCrc = 0;
+
+/// true if LastCrc is valid.
+static bool HasLastCrc = false;
+
+/// Number of milliseconds between updates of the State Segment (0 = the state isn't kept there).
+static uint32_t StatePeriod = DEFAULT_STATE_PERIOD;
+
+/// Timer that expires when the State Segment is next due to be updated.
+static le_timer_Ref_t StateTimer = NULL;
+
+/// true if the last State Segment image didn't fit, so that isn't reported every time.
+static bool IsStateTooBig = false;
+
+/// Number of the last State Segment image built (0 = none yet).
+static uint32_t StateImageNumber = 0;
+
+/// Number of the last image stored in the State Segment (0 = none), whose copies of buffers that
+/// haven't changed since are reused in the next image.
+static uint32_t StoredStateImageNumber = 0;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append a field to a checkpoint image.
+ *
+ * @return true if successful, false if out of memory.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool AppendField
+(
+    backupWriter_ImageRef_t imageRef,
+    uint8_t tag,            ///< FieldTag_t or SettingTag_t.
+    const void* valuePtr,
+    size_t valueBytes
+)
+//--------------------------------------------------------------------------------------------------
+{
+    uint8_t header[FIELD_HEADER_BYTES];
+    uint16_t len = valueBytes;
+    header[0] = tag;
+    memcpy(header + 1, &len, 2);
+
+    return (   backupWriter_Append(imageRef, header, sizeof(header))
+            && ((valueBytes == 0) || backupWriter_Append(imageRef, valuePtr, valueBytes))  );
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append a string field to a checkpoint image, if the string isn't empty.
+ *
+ * @return true if successful, false if out of memory.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool AppendStringField
+(
+    backupWriter_ImageRef_t imageRef,
+    FieldTag_t tag,
+    const char* string
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if ((string == NULL) || (string[0] == '\0'))
+    {
+        return true;
+    }
+
+    return AppendField(imageRef, tag, string, strlen(string) + 1);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append a field holding an 8-byte double to a checkpoint image, if it is set (not NAN).
+ *
+ * @return true if successful, false if out of memory.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool AppendDoubleField
+(
+    backupWriter_ImageRef_t imageRef,
+    FieldTag_t tag,
+    double value
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return isnan(value) || AppendField(imageRef, tag, &value, sizeof(value));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append a field holding a 4-byte integer to a checkpoint image, if it isn't zero.
+ *
+ * @return true if successful, false if out of memory.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool AppendUint32Field
+(
+    backupWriter_ImageRef_t imageRef,
+    uint8_t tag,            ///< FieldTag_t or SettingTag_t.
+    uint32_t value
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return (value == 0) || AppendField(imageRef, tag, &value, sizeof(value));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append a field with no value to a checkpoint image, if a flag is set.
+ *
+ * @return true if successful, false if out of memory.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool AppendFlagField
+(
+    backupWriter_ImageRef_t imageRef,
+    uint8_t tag,            ///< FieldTag_t or SettingTag_t.
+    bool isSet
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return !isSet || AppendField(imageRef, tag, NULL, 0);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append a field holding a data sample to a checkpoint image, if there is a data sample.
+ *
+ * @return true if successful, false if out of memory.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool AppendSampleField
+(
+    backupWriter_ImageRef_t imageRef,
+    FieldTag_t tag,
+    io_DataType_t dataType,
+    dataSample_Ref_t sampleRef  ///< The data sample, or NULL if none.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (sampleRef == NULL)
+    {
+        return true;
+    }
+
+    uint8_t value[SAMPLE_HEADER_BYTES + sizeof(double)];
+    size_t valueBytes = SAMPLE_HEADER_BYTES;
+    const char* string = NULL;
+    double timestamp = dataSample_GetTimestamp(sampleRef);
+    value[0] = dataType;
+    memcpy(value + 1, &timestamp, sizeof(timestamp));
+
+    switch (dataType)
+    {
+        case IO_DATA_TYPE_TRIGGER:
+            break;
+
+        case IO_DATA_TYPE_BOOLEAN:
+            value[valueBytes++] = dataSample_GetBoolean(sampleRef);
+            break;
+
+        case IO_DATA_TYPE_NUMERIC:
+        {
+            double number = dataSample_GetNumeric(sampleRef);
+            memcpy(value + valueBytes, &number, sizeof(number));
+            valueBytes += sizeof(number);
+            break;
+        }
+
+        case IO_DATA_TYPE_STRING:
+            string = dataSample_GetString(sampleRef);
+            break;
+
+        case IO_DATA_TYPE_JSON:
+            string = dataSample_GetJson(sampleRef);
+            break;
+    }
+
+    if (string == NULL)
+    {
+        return AppendField(imageRef, tag, value, valueBytes);
+    }
+
+    size_t stringBytes = strlen(string) + 1;
+    uint8_t header[FIELD_HEADER_BYTES];
+    uint16_t len = valueBytes + stringBytes;
+    header[0] = tag;
+    memcpy(header + 1, &len, 2);
+
+    return (   backupWriter_Append(imageRef, header, sizeof(header))
+            && backupWriter_Append(imageRef, value, valueBytes)
+            && backupWriter_Append(imageRef, string, stringBytes)  );
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get everything to be saved about a resource.
+ */
+//--------------------------------------------------------------------------------------------------
+static void GetEntry
+(
+    resTree_EntryRef_t entryRef,
+    const char* path,   ///< Absolute path of the resource.
+    char* sourcePath,   ///< Buffer for the path of the data source (HUB_MAX_RESOURCE_PATH_BYTES).
+    Entry_t* entryPtr   ///< [OUT] Everything to be saved.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    memset(entryPtr, 0, sizeof(*entryPtr));
+
+    entryPtr->entryType = resTree_GetEntryType(entryRef);
+    entryPtr->path = path;
+    entryPtr->dataType = resTree_GetDataType(entryRef);
+    entryPtr->isOptional = (   (entryPtr->entryType == ADMIN_ENTRY_TYPE_OUTPUT)
+                            && !resTree_IsMandatory(entryRef)  );
+    LE_ASSERT(resTree_GetState(entryRef, &entryPtr->state) == LE_OK);
+
+    resTree_EntryRef_t srcRef = resTree_GetSource(entryRef);
+    if (   (srcRef != NULL)
+        && (resTree_GetPath(sourcePath,
+                            HUB_MAX_RESOURCE_PATH_BYTES,
+                            resTree_GetRoot(),
+                            srcRef) > 0)  )
+    {
+        entryPtr->sourcePath = sourcePath;
+    }
+
+    if (entryPtr->entryType == ADMIN_ENTRY_TYPE_OBSERVATION)
+    {
+        entryPtr->minPeriod = resTree_GetMinPeriod(entryRef);
+        entryPtr->highLimit = resTree_GetHighLimit(entryRef);
+        entryPtr->lowLimit = resTree_GetLowLimit(entryRef);
+        entryPtr->changeBy = resTree_GetChangeBy(entryRef);
+        entryPtr->transform = resTree_GetTransform(entryRef);
+        entryPtr->maxCount = resTree_GetBufferMaxCount(entryRef);
+        entryPtr->maxAge = resTree_GetBufferMaxAge(entryRef);
+        entryPtr->maxBytes = resTree_GetBufferMaxBytes(entryRef);
+        entryPtr->priority = resTree_GetBufferPriority(entryRef);
+        entryPtr->compress = resTree_GetBufferCompression(entryRef);
+        entryPtr->backupPeriod = resTree_GetBufferBackupPeriod(entryRef);
+        entryPtr->backupLog = resTree_GetBufferBackupLog(entryRef);
+        entryPtr->jsonExtraction = resTree_GetJsonExtraction(entryRef);
+        entryPtr->destination = resTree_GetDestination(entryRef);
+        entryPtr->isConfig = resTree_IsObservationConfig(entryRef);
+    }
+    else
+    {
+        entryPtr->minPeriod = NAN;
+        entryPtr->highLimit = NAN;
+        entryPtr->lowLimit = NAN;
+        entryPtr->changeBy = NAN;
+        entryPtr->maxAge = NAN;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether a resource has anything worth saving.  Placeholders that hold nothing are left
+ * out, as they are only there as data sources, and are created again along with their routes.
+ *
+ * @return true if the resource is to be saved.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsWorthSaving
+(
+    const Entry_t* entryPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return (   (entryPtr->entryType != ADMIN_ENTRY_TYPE_PLACEHOLDER)
+            || (entryPtr->state.currentValue != NULL)
+            || (entryPtr->state.pushedValue != NULL)
+            || (entryPtr->state.defaultValue != NULL)
+            || (entryPtr->state.overrideValue != NULL)
+            || (entryPtr->sourcePath != NULL)  );
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append an entry to a checkpoint image.
+ *
+ * @return true if successful, false if out of memory.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool AppendEntry
+(
+    backupWriter_ImageRef_t imageRef,
+    const Entry_t* entryPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    uint8_t header[3];
+    uint16_t pathBytes = strlen(entryPtr->path) + 1;
+    header[0] = entryPtr->entryType;
+    memcpy(header + 1, &pathBytes, 2);
+
+    const res_State_t* statePtr = &entryPtr->state;
+    bool isIo = (   (entryPtr->entryType == ADMIN_ENTRY_TYPE_INPUT)
+                 || (entryPtr->entryType == ADMIN_ENTRY_TYPE_OUTPUT)  );
+    uint8_t dataType = entryPtr->dataType;
+    uint8_t transform = entryPtr->transform;
+
+    // The last value pushed is usually the current value, so that case is stored as an empty
+    // field, rather than storing the value twice.
+    bool isPushedCurrent = (   (statePtr->pushedValue != NULL)
+                            && (statePtr->pushedValue == statePtr->currentValue)
+                            && (statePtr->pushedType == statePtr->currentType)  );
+
+    return (   backupWriter_Append(imageRef, header, sizeof(header))
+            && backupWriter_Append(imageRef, entryPtr->path, pathBytes)
+            && (!isIo || AppendField(imageRef, FIELD_DATA_TYPE, &dataType, 1))
+            && AppendStringField(imageRef, FIELD_UNITS, statePtr->units)
+            && AppendFlagField(imageRef, FIELD_OPTIONAL, entryPtr->isOptional)
+            && AppendSampleField(imageRef,
+                                 FIELD_CURRENT,
+                                 statePtr->currentType,
+                                 statePtr->currentValue)
+            && (isPushedCurrent ?
+                    AppendField(imageRef, FIELD_PUSHED, NULL, 0) :
+                    AppendSampleField(imageRef,
+                                      FIELD_PUSHED,
+                                      statePtr->pushedType,
+                                      statePtr->pushedValue))
+            && AppendSampleField(imageRef,
+                                 FIELD_DEFAULT,
+                                 statePtr->defaultType,
+                                 statePtr->defaultValue)
+            && AppendSampleField(imageRef,
+                                 FIELD_OVERRIDE,
+                                 statePtr->overrideType,
+                                 statePtr->overrideValue)
+            && AppendSampleField(imageRef,
+                                 FIELD_JSON_EXAMPLE,
+                                 IO_DATA_TYPE_JSON,
+                                 statePtr->jsonExample)
+            && AppendStringField(imageRef, FIELD_SOURCE, entryPtr->sourcePath)
+            && AppendDoubleField(imageRef, FIELD_MIN_PERIOD, entryPtr->minPeriod)
+            && AppendDoubleField(imageRef, FIELD_HIGH_LIMIT, entryPtr->highLimit)
+            && AppendDoubleField(imageRef, FIELD_LOW_LIMIT, entryPtr->lowLimit)
+            && AppendDoubleField(imageRef, FIELD_CHANGE_BY, entryPtr->changeBy)
+            && (   (entryPtr->transform == ADMIN_OBS_TRANSFORM_TYPE_NONE)
+                || AppendField(imageRef, FIELD_TRANSFORM, &transform, 1)  )
+            && AppendUint32Field(imageRef, FIELD_MAX_COUNT, entryPtr->maxCount)
+            && AppendDoubleField(imageRef, FIELD_MAX_AGE, entryPtr->maxAge)
+            && AppendUint32Field(imageRef, FIELD_MAX_BYTES, entryPtr->maxBytes)
+            && AppendUint32Field(imageRef, FIELD_PRIORITY, (uint32_t)entryPtr->priority)
+            && AppendFlagField(imageRef, FIELD_COMPRESSION, entryPtr->compress)
+            && AppendUint32Field(imageRef, FIELD_BACKUP_PERIOD, entryPtr->backupPeriod)
+            && AppendFlagField(imageRef, FIELD_BACKUP_LOG, entryPtr->backupLog)
+            && AppendStringField(imageRef, FIELD_JSON_EXTRACTION, entryPtr->jsonExtraction)
+            && AppendStringField(imageRef, FIELD_DESTINATION, entryPtr->destination)
+            && AppendFlagField(imageRef, FIELD_CONFIG, entryPtr->isConfig)
+            && AppendField(imageRef, FIELD_END, NULL, 0)  );
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append the resources in the part of the resource tree under a given entry to a checkpoint image.
+ *
+ * @return true if successful, false if out of memory.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool AppendEntriesUnder
+(
+    backupWriter_ImageRef_t imageRef,
+    resTree_EntryRef_t parentRef,
+    uint32_t* countPtr  ///< [INOUT] Number of entries appended so far.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    // NOTE: This is a recursive function, but the recursion is bounded by the depth of the tree,
+    //       which is limited by the maximum length of a resource path.
+
+    for (resTree_EntryRef_t entryRef = resTree_GetFirstChild(parentRef);
+         entryRef != NULL;
+         entryRef = resTree_GetNextSibling(entryRef))
+    {
+        if (resTree_IsResource(entryRef))
+        {
+            char path[HUB_MAX_RESOURCE_PATH_BYTES];
+            char sourcePath[HUB_MAX_RESOURCE_PATH_BYTES];
+            Entry_t entry;
+
+            if (resTree_GetPath(path, sizeof(path), resTree_GetRoot(), entryRef) <= 0)
+            {
+                LE_ERROR("Resource path too long to checkpoint.");
+                continue;
+            }
+
+            GetEntry(entryRef, path, sourcePath, &entry);
+            if (IsWorthSaving(&entry))
+            {
+                if (!AppendEntry(imageRef, &entry))
+                {
+                    return false;
+                }
+                (*countPtr)++;
+            }
+        }
+
+        if (!AppendEntriesUnder(imageRef, entryRef, countPtr))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append the Data Hub settings to a checkpoint image.
+ *
+ * @return true if successful, false if out of memory.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool AppendSettings
+(
+    backupWriter_ImageRef_t imageRef
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return (   AppendFlagField(imageRef, SETTING_LAZY_RESTORE, obs_GetBackupLazyRestore())
+            && AppendUint32Field(imageRef, SETTING_PERIOD, Period)
+            && AppendUint32Field(imageRef, SETTING_STATE_PERIOD, StatePeriod)
+            && AppendField(imageRef, SETTING_END, NULL, 0)  );
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append the whole resource tree to an image, as in a checkpoint file but without the CRC at the
+ * end.
+ *
+ * @return true if successful, false if out of memory.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool AppendTree
+(
+    backupWriter_ImageRef_t imageRef
+)
+//--------------------------------------------------------------------------------------------------
+{
+    // The number of entries isn't known until they have all been appended.
+    uint8_t* headerPtr = backupWriter_Reserve(imageRef, CHECKPOINT_HEADER_BYTES);
+    uint32_t count = 0;
+    if (   (headerPtr == NULL)
+        || !AppendSettings(imageRef)
+        || !AppendEntriesUnder(imageRef, resTree_GetRoot(), &count)  )
+    {
+        return false;
+    }
+
+    uint16_t version = CHECKPOINT_VERSION;
+    memcpy(headerPtr, CHECKPOINT_MAGIC, 4);
+    memcpy(headerPtr + 4, &version, 2);
+    memset(headerPtr + 6, 0, 2);
+    memcpy(headerPtr + 8, &count, 4);
+
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Build a checkpoint image of the whole resource tree, without the CRC at the end.
+ *
+ * @return Reference to the image, or NULL if out of memory.
+ */
+//--------------------------------------------------------------------------------------------------
+static backupWriter_ImageRef_t BuildImage
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    backupWriter_ImageRef_t imageRef = backupWriter_CreateImage();
+    if ((imageRef != NULL) && !AppendTree(imageRef))
+    {
+        backupWriter_DeleteImage(imageRef);
+        return NULL;
+    }
+
+    return imageRef;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append copies of the buffers of the Observations under a given entry to a State Segment image.
+ * Copies of buffers that haven't changed are taken from the image before, if it is given.
+ *
+ * @return true if successful, false if out of memory.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool AppendBuffersUnder
+(
+    backupWriter_ImageRef_t imageRef,
+    resTree_EntryRef_t parentRef,
+    const uint8_t* lastImagePtr     ///< Image before this one (StateImageNumber - 1), or NULL.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    // NOTE: This is a recursive function, but the recursion is bounded by the depth of the tree,
+    //       which is limited by the maximum length of a resource path.
+
+    for (resTree_EntryRef_t entryRef = resTree_GetFirstChild(parentRef);
+         entryRef != NULL;
+         entryRef = resTree_GetNextSibling(entryRef))
+    {
+        char path[HUB_MAX_RESOURCE_PATH_BYTES];
+
+        if (   (resTree_GetEntryType(entryRef) == ADMIN_ENTRY_TYPE_OBSERVATION)
+            && (resTree_GetBufferMaxCount(entryRef) > 0)
+            && (resTree_GetPath(path, sizeof(path), resTree_GetRoot(), entryRef) > 0)  )
+        {
+            uint16_t pathBytes = strlen(path) + 1;
+
+            // The size of the copy isn't known until it has been appended.
+            uint8_t* sizePtr = NULL;
+            if (   !backupWriter_Append(imageRef, &pathBytes, sizeof(pathBytes))
+                || !backupWriter_Append(imageRef, path, pathBytes)
+                || ((sizePtr = backupWriter_Reserve(imageRef, sizeof(uint32_t))) == NULL)  )
+            {
+                return false;
+            }
+
+            size_t startSize = backupWriter_GetSize(imageRef);
+            if (!resTree_AppendBufferToImage(entryRef, imageRef, StateImageNumber, lastImagePtr))
+            {
+                return false;
+            }
+            uint32_t bufferBytes = backupWriter_GetSize(imageRef) - startSize;
+            memcpy(sizePtr, &bufferBytes, sizeof(bufferBytes));
+        }
+
+        if (!AppendBuffersUnder(imageRef, entryRef, lastImagePtr))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Build an image of the state of the whole resource tree, including the Observations' buffers,
+ * to be kept in the State Segment.
+ *
+ * @return Reference to the image, or NULL if out of memory.
+ */
+//--------------------------------------------------------------------------------------------------
+static backupWriter_ImageRef_t BuildStateImage
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    backupWriter_ImageRef_t imageRef = backupWriter_CreateImage();
+    if (imageRef == NULL)
+    {
+        return NULL;
+    }
+
+    uint8_t* headerPtr = backupWriter_Reserve(imageRef, STATE_HEADER_BYTES);
+    uint16_t endRecord = 0;
+    if ((headerPtr == NULL) || !AppendTree(imageRef))
+    {
+        goto failed;
+    }
+
+    uint32_t treeBytes = backupWriter_GetSize(imageRef) - STATE_HEADER_BYTES;
+    memcpy(headerPtr, &treeBytes, sizeof(treeBytes));
+
+    // Copies of buffers can only be reused from the image just before this one, as only that one
+    // says where they are (and the segment keeps only that one intact).
+    const uint8_t* lastImagePtr = NULL;
+    StateImageNumber++;
+    if (StoredStateImageNumber == StateImageNumber - 1)
+    {
+        lastImagePtr = stateSegment_GetStoredImage();
+    }
+
+    if (   !AppendBuffersUnder(imageRef, resTree_GetRoot(), lastImagePtr)
+        || !backupWriter_Append(imageRef, &endRecord, sizeof(endRecord))  )
+    {
+        goto failed;
+    }
+
+    return imageRef;
+
+failed:
+
+    backupWriter_DeleteImage(imageRef);
+    return NULL;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write a checkpoint.  Runs on the Backup Writer's thread.
+ */
+//--------------------------------------------------------------------------------------------------
+static void WriteCheckpoint
+(
+    void* contextPtr    ///< The job.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Job_t* jobPtr = contextPtr;
+
+    jobPtr->isOk = (backupWriter_ReplaceFile(jobPtr->imageRef, CHECKPOINT_PATH) == LE_OK);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Finish up after a checkpoint has been written (or failed to be).
+ */
+//--------------------------------------------------------------------------------------------------
+static void CheckpointWritten
+(
+    void* contextPtr    ///< The job.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Job_t* jobPtr = contextPtr;
+
+    if (jobPtr->isOk)
+    {
+        LastCrc = jobPtr->crc;
+        HasLastCrc = true;
+    }
+
+    backupWriter_DeleteImage(jobPtr->imageRef);
+    le_mem_Release(jobPtr);
+    WritingJobPtr = NULL;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Save a checkpoint of the whole resource tree, unless it is the same as the last one written or
+ * the last one is still being written.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SaveCheckpoint
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+#if LE_CONFIG_FILESYSTEM
+    if (WritingJobPtr != NULL)
+    {
+        return;
+    }
+
+    backupWriter_ImageRef_t imageRef = BuildImage();
+    if (imageRef == NULL)
+    {
+        LE_CRIT("Out of memory building checkpoint.");
+        return;
+    }
+
+    uint32_t crc = backupWriter_ComputeCrc32(imageRef);
+    if (HasLastCrc && (crc == LastCrc))
+    {
+        backupWriter_DeleteImage(imageRef);
+        return;
+    }
+
+    if (!backupWriter_Append(imageRef, &crc, sizeof(crc)))
+    {
+        LE_CRIT("Out of memory building checkpoint.");
+        backupWriter_DeleteImage(imageRef);
+        return;
+    }
+
+    Job_t* jobPtr = le_mem_ForceAlloc(JobPool);
+    jobPtr->imageRef = imageRef;
+    jobPtr->crc = crc;
+    jobPtr->isOk = false;
+    WritingJobPtr = jobPtr;
+
+    backupWriter_Submit(WriteCheckpoint, CheckpointWritten, jobPtr);
+#endif /* end LE_CONFIG_FILESYSTEM */
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Timer expiry handler for the checkpoint timer.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CheckpointTimerExpired
+(
+    le_timer_Ref_t timer
+)
+//--------------------------------------------------------------------------------------------------
+{
+    SaveCheckpoint();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Timer expiry handler for the State Segment timer.  Stores an image of the current state in the
+ * State Segment.
+ */
+//--------------------------------------------------------------------------------------------------
+static void StateTimerExpired
+(
+    le_timer_Ref_t timer
+)
+//--------------------------------------------------------------------------------------------------
+{
+    backupWriter_ImageRef_t imageRef = BuildStateImage();
+    if (imageRef == NULL)
+    {
+        LE_CRIT("Out of memory building state image.");
+        return;
+    }
+
+    le_result_t result = stateSegment_Store(imageRef);
+    if (result == LE_OK)
+    {
+        StoredStateImageNumber = StateImageNumber;
+    }
+    if ((result == LE_OVERFLOW) && !IsStateTooBig)
+    {
+        LE_WARN("State (%zu bytes) is too big for the shared memory segment. Not keeping it.",
+                backupWriter_GetSize(imageRef));
+    }
+    IsStateTooBig = (result == LE_OVERFLOW);
+
+    backupWriter_DeleteImage(imageRef);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decode a data sample field's value.
+ *
+ * @return Reference to a new data sample, or NULL if the value is malformed.
+ */
+//--------------------------------------------------------------------------------------------------
+static dataSample_Ref_t DecodeSample
+(
+    const uint8_t* valuePtr,
+    size_t valueBytes,
+    io_DataType_t* dataTypePtr  ///< [OUT] Data type of the sample.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (valueBytes < SAMPLE_HEADER_BYTES)
+    {
+        return NULL;
+    }
+
+    double timestamp;
+    memcpy(&timestamp, valuePtr + 1, sizeof(timestamp));
+    const uint8_t* dataPtr = valuePtr + SAMPLE_HEADER_BYTES;
+    size_t dataBytes = valueBytes - SAMPLE_HEADER_BYTES;
+    double number;
+
+    *dataTypePtr = valuePtr[0];
+    switch (valuePtr[0])
+    {
+        case IO_DATA_TYPE_TRIGGER:
+            return (dataBytes == 0) ? dataSample_CreateTrigger(timestamp) : NULL;
+
+        case IO_DATA_TYPE_BOOLEAN:
+            return (dataBytes == 1) ? dataSample_CreateBoolean(timestamp, dataPtr[0] != 0) : NULL;
+
+        case IO_DATA_TYPE_NUMERIC:
+            if (dataBytes != sizeof(number))
+            {
+                return NULL;
+            }
+            memcpy(&number, dataPtr, sizeof(number));
+            return dataSample_CreateNumeric(timestamp, number);
+
+        case IO_DATA_TYPE_STRING:
+        case IO_DATA_TYPE_JSON:
+            if ((dataBytes == 0) || (memchr(dataPtr, '\0', dataBytes) != dataPtr + dataBytes - 1))
+            {
+                return NULL;
+            }
+            return (valuePtr[0] == IO_DATA_TYPE_STRING) ?
+                        dataSample_CreateString(timestamp, (const char*)dataPtr) :
+                        dataSample_CreateJson(timestamp, (const char*)dataPtr);
+    }
+
+    return NULL;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check that a field's value is a null-terminated string.
+ *
+ * @return Pointer to the string, or NULL if malformed.
+ */
+//--------------------------------------------------------------------------------------------------
+static const char* DecodeString
+(
+    const uint8_t* valuePtr,
+    size_t valueBytes
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if ((valueBytes == 0) || (memchr(valuePtr, '\0', valueBytes) != valuePtr + valueBytes - 1))
+    {
+        return NULL;
+    }
+
+    return (const char*)valuePtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Release the data samples held by an entry that has been decoded.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReleaseEntry
+(
+    Entry_t* entryPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    res_State_t* statePtr = &entryPtr->state;
+    dataSample_Ref_t* samples[] = { &statePtr->currentValue,
+                                    &statePtr->pushedValue,
+                                    &statePtr->defaultValue,
+                                    &statePtr->overrideValue,
+                                    &statePtr->jsonExample };
+
+    for (size_t i = 0; i < NUM_ARRAY_MEMBERS(samples); i++)
+    {
+        if (*samples[i] != NULL)
+        {
+            le_mem_Release(*samples[i]);
+            *samples[i] = NULL;
+        }
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decode one field of an entry.
+ *
+ * @return true if successful, false if the field is malformed.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool DecodeField
+(
+    FieldTag_t tag,
+    const uint8_t* valuePtr,
+    size_t valueBytes,
+    Entry_t* entryPtr,      ///< [INOUT] The entry.
+    bool* isPushedCurrentPtr    ///< [OUT] Set if the last value pushed is the current value.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    res_State_t* statePtr = &entryPtr->state;
+    dataSample_Ref_t* samplePtr = NULL;
+    io_DataType_t* typePtr = NULL;
+    double* doublePtr = NULL;
+    uint32_t* uint32Ptr = NULL;
+    const char** stringPtr = NULL;
+    bool* flagPtr = NULL;
+    io_DataType_t exampleType;
+
+    switch (tag)
+    {
+        case FIELD_DATA_TYPE:
+            if (valueBytes != 1)
+            {
+                return false;
+            }
+            entryPtr->dataType = valuePtr[0];
+            return true;
+
+        case FIELD_TRANSFORM:
+            if (valueBytes != 1)
+            {
+                return false;
+            }
+            entryPtr->transform = valuePtr[0];
+            return true;
+
+        case FIELD_PUSHED:
+            if (valueBytes == 0)
+            {
+                *isPushedCurrentPtr = true;
+                return true;
+            }
+            samplePtr = &statePtr->pushedValue;
+            typePtr = &statePtr->pushedType;
+            break;
+
+        case FIELD_CURRENT:
+            samplePtr = &statePtr->currentValue;
+            typePtr = &statePtr->currentType;
+            break;
+
+        case FIELD_DEFAULT:
+            samplePtr = &statePtr->defaultValue;
+            typePtr = &statePtr->defaultType;
+            break;
+
+        case FIELD_OVERRIDE:
+            samplePtr = &statePtr->overrideValue;
+            typePtr = &statePtr->overrideType;
+            break;
+
+        case FIELD_JSON_EXAMPLE:
+            samplePtr = &statePtr->jsonExample;
+            typePtr = &exampleType;
+            break;
+
+        case FIELD_UNITS:           stringPtr = &statePtr->units;           break;
+        case FIELD_SOURCE:          stringPtr = &entryPtr->sourcePath;      break;
+        case FIELD_JSON_EXTRACTION: stringPtr = &entryPtr->jsonExtraction;  break;
+        case FIELD_DESTINATION:     stringPtr = &entryPtr->destination;     break;
+
+        case FIELD_MIN_PERIOD:      doublePtr = &entryPtr->minPeriod;       break;
+        case FIELD_HIGH_LIMIT:      doublePtr = &entryPtr->highLimit;       break;
+        case FIELD_LOW_LIMIT:       doublePtr = &entryPtr->lowLimit;        break;
+        case FIELD_CHANGE_BY:       doublePtr = &entryPtr->changeBy;        break;
+        case FIELD_MAX_AGE:         doublePtr = &entryPtr->maxAge;          break;
+
+        case FIELD_MAX_COUNT:       uint32Ptr = &entryPtr->maxCount;        break;
+        case FIELD_MAX_BYTES:       uint32Ptr = &entryPtr->maxBytes;        break;
+        case FIELD_PRIORITY:        uint32Ptr = (uint32_t*)&entryPtr->priority; break;
+        case FIELD_BACKUP_PERIOD:   uint32Ptr = &entryPtr->backupPeriod;    break;
+
+        case FIELD_OPTIONAL:        flagPtr = &entryPtr->isOptional;        break;
+        case FIELD_COMPRESSION:     flagPtr = &entryPtr->compress;          break;
+        case FIELD_BACKUP_LOG:      flagPtr = &entryPtr->backupLog;         break;
+        case FIELD_CONFIG:          flagPtr = &entryPtr->isConfig;          break;
+
+        default:
+            // Added by a later version of the Data Hub, so skip it.
+            return true;
+    }
+
+    if (samplePtr != NULL)
+    {
+        if (*samplePtr != NULL)
+        {
+            le_mem_Release(*samplePtr);
+        }
+        *samplePtr = DecodeSample(valuePtr, valueBytes, typePtr);
+        return (*samplePtr != NULL);
+    }
+    if (stringPtr != NULL)
+    {
+        *stringPtr = DecodeString(valuePtr, valueBytes);
+        return (*stringPtr != NULL);
+    }
+    if (doublePtr != NULL)
+    {
+        if (valueBytes != sizeof(double))
+        {
+            return false;
+        }
+        memcpy(doublePtr, valuePtr, sizeof(double));
+        return true;
+    }
+    if (uint32Ptr != NULL)
+    {
+        if (valueBytes != sizeof(uint32_t))
+        {
+            return false;
+        }
+        memcpy(uint32Ptr, valuePtr, sizeof(uint32_t));
+        return true;
+    }
+
+    *flagPtr = true;
+    return (valueBytes == 0);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decode an entry from a checkpoint file's contents.
+ *
+ * @return Pointer to the byte after the entry, or NULL if the entry is malformed (in which case
+ *         the entry holds no data samples).
+ */
+//--------------------------------------------------------------------------------------------------
+static const uint8_t* DecodeEntry
+(
+    const uint8_t* ptr,     ///< Start of the entry.
+    const uint8_t* endPtr,  ///< End of the entries.
+    Entry_t* entryPtr       ///< [OUT] The entry.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    memset(entryPtr, 0, sizeof(*entryPtr));
+    entryPtr->state.units = "";
+    entryPtr->minPeriod = NAN;
+    entryPtr->highLimit = NAN;
+    entryPtr->lowLimit = NAN;
+    entryPtr->changeBy = NAN;
+    entryPtr->maxAge = NAN;
+    entryPtr->transform = ADMIN_OBS_TRANSFORM_TYPE_NONE;
+
+    uint16_t pathBytes;
+    if ((endPtr - ptr) < 3)
+    {
+        return NULL;
+    }
+    entryPtr->entryType = ptr[0];
+    memcpy(&pathBytes, ptr + 1, 2);
+    ptr += 3;
+    if (   ((endPtr - ptr) < pathBytes)
+        || (pathBytes > HUB_MAX_RESOURCE_PATH_BYTES)
+        || ((entryPtr->path = DecodeString(ptr, pathBytes)) == NULL)  )
+    {
+        return NULL;
+    }
+    ptr += pathBytes;
+
+    bool isPushedCurrent = false;
+    for (;;)
+    {
+        uint16_t valueBytes;
+        if ((endPtr - ptr) < FIELD_HEADER_BYTES)
+        {
+            goto malformed;
+        }
+        FieldTag_t tag = ptr[0];
+        memcpy(&valueBytes, ptr + 1, 2);
+        ptr += FIELD_HEADER_BYTES;
+        if ((endPtr - ptr) < valueBytes)
+        {
+            goto malformed;
+        }
+
+        if (tag == FIELD_END)
+        {
+            break;
+        }
+
+        if (!DecodeField(tag, ptr, valueBytes, entryPtr, &isPushedCurrent))
+        {
+            goto malformed;
+        }
+        ptr += valueBytes;
+    }
+
+    if (isPushedCurrent && (entryPtr->state.currentValue != NULL))
+    {
+        if (entryPtr->state.pushedValue != NULL)
+        {
+            le_mem_Release(entryPtr->state.pushedValue);
+        }
+        le_mem_AddRef(entryPtr->state.currentValue);
+        entryPtr->state.pushedValue = entryPtr->state.currentValue;
+        entryPtr->state.pushedType = entryPtr->state.currentType;
+    }
+
+    return ptr;
+
+malformed:
+
+    ReleaseEntry(entryPtr);
+    return NULL;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Put an Observation's settings back.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RestoreObsSettings
+(
+    resTree_EntryRef_t obsRef,
+    const Entry_t* entryPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    // Setting a transform clears the buffer, so only do it if there is one.
+    if (entryPtr->transform != ADMIN_OBS_TRANSFORM_TYPE_NONE)
+    {
+        resTree_SetTransform(obsRef, entryPtr->transform, NULL, 0);
+    }
+
+    // The buffer settings don't make a lazily restored buffer load the rest of its samples.
+    if (resTree_GetBufferMaxCount(obsRef) != entryPtr->maxCount)
+    {
+        resTree_SetBufferMaxCount(obsRef, entryPtr->maxCount);
+    }
+    if (!isnan(entryPtr->maxAge))
+    {
+        resTree_SetBufferMaxAge(obsRef, entryPtr->maxAge);
+    }
+    if (entryPtr->maxBytes != 0)
+    {
+        resTree_SetBufferMaxBytes(obsRef, entryPtr->maxBytes);
+    }
+    if (entryPtr->priority != 0)
+    {
+        resTree_SetBufferPriority(obsRef, entryPtr->priority);
+    }
+    if (entryPtr->compress)
+    {
+        resTree_SetBufferCompression(obsRef, true);
+    }
+    if (entryPtr->backupPeriod != 0)
+    {
+        resTree_SetBufferBackupPeriod(obsRef, entryPtr->backupPeriod);
+    }
+    if (entryPtr->backupLog)
+    {
+        resTree_SetBufferBackupLog(obsRef, true);
+    }
+
+    if (!isnan(entryPtr->minPeriod))
+    {
+        resTree_SetMinPeriod(obsRef, entryPtr->minPeriod);
+    }
+    if (!isnan(entryPtr->highLimit))
+    {
+        resTree_SetHighLimit(obsRef, entryPtr->highLimit);
+    }
+    if (!isnan(entryPtr->lowLimit))
+    {
+        resTree_SetLowLimit(obsRef, entryPtr->lowLimit);
+    }
+    if (!isnan(entryPtr->changeBy))
+    {
+        resTree_SetChangeBy(obsRef, entryPtr->changeBy);
+    }
+
+    if (entryPtr->jsonExtraction != NULL)
+    {
+        resTree_SetJsonExtraction(obsRef, entryPtr->jsonExtraction);
+    }
+    if (entryPtr->destination != NULL)
+    {
+        resTree_SetDestination(obsRef, entryPtr->destination);
+    }
+    if (entryPtr->isConfig)
+    {
+        resTree_MarkObservationAsConfig(obsRef);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Put a resource back into the resource tree, as it was when the checkpoint was taken.
+ *
+ * @note Takes ownership of the data samples held by the entry.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RestoreEntry
+(
+    Entry_t* entryPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    resTree_EntryRef_t rootRef = resTree_GetRoot();
+    resTree_EntryRef_t entryRef = NULL;
+    le_result_t result = LE_BAD_PARAMETER;
+
+    // Data sources are created as Placeholders when their routes are, so an Input or Output may
+    // find a Placeholder already there.
+    resTree_EntryRef_t existingRef = resTree_FindEntry(rootRef, entryPtr->path);
+    admin_EntryType_t existingType = (   (existingRef == NULL) ?
+                                             ADMIN_ENTRY_TYPE_NONE :
+                                             resTree_GetEntryType(existingRef)  );
+
+    switch (entryPtr->entryType)
+    {
+        case ADMIN_ENTRY_TYPE_INPUT:
+        case ADMIN_ENTRY_TYPE_OUTPUT:
+
+            if (   (existingType != ADMIN_ENTRY_TYPE_NONE)
+                && (existingType != ADMIN_ENTRY_TYPE_NAMESPACE)
+                && (existingType != ADMIN_ENTRY_TYPE_PLACEHOLDER)  )
+            {
+                break;
+            }
+            if (entryPtr->entryType == ADMIN_ENTRY_TYPE_INPUT)
+            {
+                result = resTree_CreateInput(rootRef,
+                                             entryPtr->path,
+                                             entryPtr->dataType,
+                                             entryPtr->state.units);
+            }
+            else
+            {
+                result = resTree_CreateOutput(rootRef,
+                                              entryPtr->path,
+                                              entryPtr->dataType,
+                                              entryPtr->state.units);
+            }
+            if (result == LE_OK)
+            {
+                entryRef = resTree_FindEntry(rootRef, entryPtr->path);
+                if (entryPtr->isOptional)
+                {
+                    resTree_MarkOptional(entryRef);
+                }
+            }
+            break;
+
+        case ADMIN_ENTRY_TYPE_OBSERVATION:
+
+            result = resTree_GetObservation(rootRef, entryPtr->path, &entryRef);
+            if (result == LE_OK)
+            {
+                RestoreObsSettings(entryRef, entryPtr);
+            }
+            break;
+
+        case ADMIN_ENTRY_TYPE_PLACEHOLDER:
+
+            result = resTree_GetResource(rootRef, entryPtr->path, &entryRef);
+            break;
+
+        default:
+            break;
+    }
+
+    if ((result != LE_OK) || (resTree_GetEntryType(entryRef) != entryPtr->entryType))
+    {
+        LE_ERROR("Failed to restore %s '%s' from checkpoint.",
+                 hub_GetEntryTypeName(entryPtr->entryType),
+                 entryPtr->path);
+        ReleaseEntry(entryPtr);
+        return;
+    }
+
+    resTree_RestoreState(entryRef, &entryPtr->state);
+
+    if (entryPtr->sourcePath != NULL)
+    {
+        resTree_EntryRef_t srcRef;
+        if (   (resTree_GetResource(rootRef, entryPtr->sourcePath, &srcRef) != LE_OK)
+            || (resTree_SetSource(entryRef, srcRef) != LE_OK)  )
+        {
+            LE_ERROR("Failed to restore route from '%s' to '%s'.",
+                     entryPtr->sourcePath,
+                     entryPtr->path);
+        }
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Put the Data Hub settings back from a checkpoint's contents.  Nothing is changed if the
+ * settings are malformed.
+ *
+ * @return Pointer to the byte after the settings, or NULL if they are malformed.
+ */
+//--------------------------------------------------------------------------------------------------
+static const uint8_t* RestoreSettings
+(
+    const uint8_t* ptr,     ///< Start of the settings.
+    const uint8_t* endPtr   ///< End of the checkpoint's contents.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    bool isLazy = false;
+    uint32_t period = 0;
+    uint32_t statePeriod = 0;
+
+    for (;;)
+    {
+        uint16_t valueBytes;
+        if ((endPtr - ptr) < FIELD_HEADER_BYTES)
+        {
+            return NULL;
+        }
+        SettingTag_t tag = ptr[0];
+        memcpy(&valueBytes, ptr + 1, 2);
+        ptr += FIELD_HEADER_BYTES;
+        if ((endPtr - ptr) < valueBytes)
+        {
+            return NULL;
+        }
+
+        switch (tag)
+        {
+            case SETTING_END:
+                obs_SetBackupLazyRestore(isLazy);
+                Period = period;
+                StatePeriod = statePeriod;
+                return ptr;
+
+            case SETTING_LAZY_RESTORE:
+                isLazy = true;
+                break;
+
+            case SETTING_PERIOD:
+                if (valueBytes != sizeof(period))
+                {
+                    return NULL;
+                }
+                memcpy(&period, ptr, sizeof(period));
+                break;
+
+            case SETTING_STATE_PERIOD:
+                if (valueBytes != sizeof(statePeriod))
+                {
+                    return NULL;
+                }
+                memcpy(&statePeriod, ptr, sizeof(statePeriod));
+                break;
+
+            default:
+                // Added by a later version of the Data Hub, so skip it.
+                break;
+        }
+        ptr += valueBytes;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Rebuild the resource tree from its image in a checkpoint (without the CRC at the end).
+ *
+ * @return true if the tree was restored (even if only partly), false if the image was rejected.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool RestoreTree
+(
+    const uint8_t* buffPtr,
+    size_t size,
+    const char* name    ///< Name of the checkpoint, for log messages.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    uint16_t version;
+    uint32_t count;
+    if (   (size < CHECKPOINT_HEADER_BYTES)
+        || (memcmp(buffPtr, CHECKPOINT_MAGIC, 4) != 0)  )
+    {
+        LE_CRIT("Checkpoint '%s' is damaged. Ignoring it.", name);
+        return false;
+    }
+    memcpy(&version, buffPtr + 4, 2);
+    memcpy(&count, buffPtr + 8, 4);
+    if (version != CHECKPOINT_VERSION)
+    {
+        LE_ERROR("Ignoring checkpoint '%s' of unsupported version %u.", name, version);
+        return false;
+    }
+
+    const uint8_t* ptr = buffPtr + CHECKPOINT_HEADER_BYTES;
+    const uint8_t* endPtr = buffPtr + size;
+    if ((ptr = RestoreSettings(ptr, endPtr)) == NULL)
+    {
+        LE_CRIT("Checkpoint '%s' settings are malformed. Ignoring it.", name);
+        return false;
+    }
+    uint32_t i;
+    for (i = 0; i < count; i++)
+    {
+        Entry_t entry;
+        ptr = DecodeEntry(ptr, endPtr, &entry);
+        if (ptr == NULL)
+        {
+            LE_CRIT("Checkpoint '%s' entry %" PRIu32 " is malformed.", name, i);
+            break;
+        }
+        RestoreEntry(&entry);
+    }
+
+    LE_INFO("Restored %" PRIu32 " resources from checkpoint '%s'.", i, name);
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Replace the buffers of the Observations with the copies in a State Segment image.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RestoreBuffers
+(
+    const uint8_t* ptr,     ///< Start of the buffer records.
+    const uint8_t* endPtr   ///< End of the image.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    uint32_t count = 0;
+
+    for (;;)
+    {
+        uint16_t pathBytes;
+        uint32_t bufferBytes;
+        const char* path;
+
+        if ((endPtr - ptr) < (ptrdiff_t)sizeof(pathBytes))
+        {
+            goto malformed;
+        }
+        memcpy(&pathBytes, ptr, sizeof(pathBytes));
+        ptr += sizeof(pathBytes);
+        if (pathBytes == 0)
+        {
+            break;
+        }
+        if (   ((endPtr - ptr) < (ptrdiff_t)(pathBytes + sizeof(bufferBytes)))
+            || ((path = DecodeString(ptr, pathBytes)) == NULL)  )
+        {
+            goto malformed;
+        }
+        ptr += pathBytes;
+        memcpy(&bufferBytes, ptr, sizeof(bufferBytes));
+        ptr += sizeof(bufferBytes);
+        if ((size_t)(endPtr - ptr) < bufferBytes)
+        {
+            goto malformed;
+        }
+
+        resTree_EntryRef_t obsRef = resTree_FindEntryAtAbsolutePath(path);
+        if (   (obsRef != NULL)
+            && (resTree_GetEntryType(obsRef) == ADMIN_ENTRY_TYPE_OBSERVATION)  )
+        {
+            resTree_RestoreBufferFromImage(obsRef, ptr, bufferBytes, path);
+            count++;
+        }
+        ptr += bufferBytes;
+    }
+
+    LE_INFO("Restored %" PRIu32 " observation buffers from shared memory.", count);
+    return;
+
+malformed:
+
+    LE_CRIT("Observation buffers in shared memory are malformed.");
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Rebuild the resource tree, along with the Observations' buffers, from an image in the State
+ * Segment.
+ *
+ * @return true if the tree was restored (even if only partly), false if the image was rejected.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool LoadState
+(
+    const uint8_t* imagePtr,
+    size_t size
+)
+//--------------------------------------------------------------------------------------------------
+{
+    uint32_t treeBytes;
+    if (size < STATE_HEADER_BYTES)
+    {
+        LE_CRIT("State in shared memory is malformed. Ignoring it.");
+        return false;
+    }
+    memcpy(&treeBytes, imagePtr, sizeof(treeBytes));
+    if (treeBytes > size - STATE_HEADER_BYTES)
+    {
+        LE_CRIT("State in shared memory is malformed. Ignoring it.");
+        return false;
+    }
+
+    // The Observations' buffers are restored from the image, so they aren't read from their
+    // backups when the Observations are created.
+    obs_SkipBackupRestore(true);
+    bool isRestored = RestoreTree(imagePtr + STATE_HEADER_BYTES, treeBytes, "shared memory");
+    obs_SkipBackupRestore(false);
+
+    if (isRestored)
+    {
+        RestoreBuffers(imagePtr + STATE_HEADER_BYTES + treeBytes, imagePtr + size);
+    }
+
+    return isRestored;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Rebuild the resource tree from the checkpoint file, if there is one.
+ */
+//--------------------------------------------------------------------------------------------------
+static void LoadCheckpointFile
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+#if LE_CONFIG_FILESYSTEM
+    FILE* file = fopen(CHECKPOINT_PATH, "rb");
+    if (file == NULL)
+    {
+        if (errno != ENOENT)
+        {
+            LE_CRIT("Unable to open '" CHECKPOINT_PATH "' for reading (%m).");
+        }
+        return;
+    }
+
+    // The whole file is read at once, as it is read through from start to end anyway.
+    uint8_t* buffPtr = NULL;
+    long size = -1;
+    if ((fseek(file, 0, SEEK_END) == 0) && ((size = ftell(file)) >= 0))
+    {
+        rewind(file);
+        buffPtr = malloc(size > 0 ? size : 1);
+    }
+    if ((buffPtr == NULL) || (fread(buffPtr, 1, size, file) != (size_t)size))
+    {
+        LE_CRIT("Unable to read '" CHECKPOINT_PATH "'.");
+        free(buffPtr);
+        fclose(file);
+        return;
+    }
+    fclose(file);
+
+    uint32_t crc;
+    if (size < CHECKPOINT_CRC_BYTES)
+    {
+        goto damaged;
+    }
+    memcpy(&crc, buffPtr + size - CHECKPOINT_CRC_BYTES, 4);
+    if (crc != le_crc_Crc32(buffPtr, size - CHECKPOINT_CRC_BYTES, LE_CRC_START_CRC32))
+    {
+        goto damaged;
+    }
+
+    if (RestoreTree(buffPtr, size - CHECKPOINT_CRC_BYTES, CHECKPOINT_PATH))
+    {
+        // Nothing has changed since the checkpoint, so there's no need to write it again.
+        LastCrc = crc;
+        HasLastCrc = true;
+    }
+    free(buffPtr);
+    return;
+
+damaged:
+
+    LE_CRIT("Checkpoint '" CHECKPOINT_PATH "' is damaged. Ignoring it.");
+    free(buffPtr);
+#endif /* end LE_CONFIG_FILESYSTEM */
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Rebuild the resource tree from the State Segment or the checkpoint file, whichever is newer.
+ */
+//--------------------------------------------------------------------------------------------------
+static void LoadCheckpoint
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    size_t stateSize;
+    double storedTime;
+    const uint8_t* statePtr = stateSegment_GetImage(&stateSize, &storedTime);
+
+    if (statePtr != NULL)
+    {
+#if LE_CONFIG_FILESYSTEM
+        struct stat st;
+        bool isFileNewer = (   (stat(CHECKPOINT_PATH, &st) == 0)
+                            && ((double)st.st_mtime > storedTime)  );
+#else
+        bool isFileNewer = false;
+#endif
+        if (!isFileNewer && LoadState(statePtr, stateSize))
+        {
+            return;
+        }
+    }
+
+    LoadCheckpointFile();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize the Checkpoint module, rebuilding the resource tree from the last checkpoint (if any)
+ * and starting to save checkpoints.
+ *
+ * @warning Must be called after the Resource Tree and Observation modules have been initialized,
+ *          and before any clients are served.
+ */
+//--------------------------------------------------------------------------------------------------
+void checkpoint_Init
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    JobPool = le_mem_CreatePool("CheckpointJob", sizeof(Job_t));
+
+    CheckpointTimer = le_timer_Create("Checkpoint");
+    LE_ASSERT(le_timer_SetRepeat(CheckpointTimer, 0) == LE_OK);
+    LE_ASSERT(le_timer_SetHandler(CheckpointTimer, CheckpointTimerExpired) == LE_OK);
+
+    StateTimer = le_timer_Create("CheckpointState");
+    LE_ASSERT(le_timer_SetRepeat(StateTimer, 0) == LE_OK);
+    LE_ASSERT(le_timer_SetHandler(StateTimer, StateTimerExpired) == LE_OK);
+
+    stateSegment_Init();
+
+    LoadCheckpoint();
+
+    checkpoint_SetPeriod(Period);
+
+    // The period was restored along with the tree.  If the state isn't to be kept in the State
+    // Segment, this deletes any left from before, so that it isn't mistaken for the latest state
+    // the next time the Data Hub starts.
+    checkpoint_SetStatePeriod(StatePeriod);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the number of seconds between checkpoints.  A checkpoint is only written if the resource
+ * tree has changed since the last one.  The period is saved in the checkpoints, so it stays in
+ * effect when the Data Hub restarts.  Turning checkpoints off deletes the checkpoint file, so the
+ * tree isn't rebuilt from a stale one.
+ */
+//--------------------------------------------------------------------------------------------------
+void checkpoint_SetPeriod
+(
+    uint32_t seconds    ///< Seconds between checkpoints (0 = don't save checkpoints).
+)
+//--------------------------------------------------------------------------------------------------
+{
+#if LE_CONFIG_FILESYSTEM
+    if ((seconds == 0) && (Period != 0))
+    {
+        // Make sure a checkpoint being written doesn't put the file back.
+        backupWriter_Flush();
+
+        if ((unlink(CHECKPOINT_PATH) != 0) && (errno != ENOENT))
+        {
+            LE_CRIT("Failed to delete '" CHECKPOINT_PATH "' (%m).");
+        }
+        HasLastCrc = false;
+    }
+#endif /* end LE_CONFIG_FILESYSTEM */
+
+    Period = seconds;
+
+    if (le_timer_IsRunning(CheckpointTimer))
+    {
+        le_timer_Stop(CheckpointTimer);
+    }
+
+    if (seconds > 0)
+    {
+        le_clk_Time_t interval = { .sec = seconds, .usec = 0 };
+        LE_ASSERT(le_timer_SetInterval(CheckpointTimer, interval) == LE_OK);
+        LE_ASSERT(le_timer_Start(CheckpointTimer) == LE_OK);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of seconds between checkpoints.
+ *
+ * @return The number of seconds, or 0 if checkpoints are not saved.
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t checkpoint_GetPeriod
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return Period;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the number of milliseconds between updates of the state kept in the State Segment.  The
+ * period is saved in the checkpoints (and the State Segment itself), so it stays in effect when the
+ * Data Hub restarts.  Periods shorter than MIN_STATE_PERIOD are raised to it.
+ */
+//--------------------------------------------------------------------------------------------------
+void checkpoint_SetStatePeriod
+(
+    uint32_t ms     ///< Milliseconds between updates (0 = don't keep the state in shared memory).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if ((ms > 0) && (ms < MIN_STATE_PERIOD))
+    {
+        LE_WARN("State Segment period of %" PRIu32 " ms is too short. Using %d ms.",
+                ms,
+                MIN_STATE_PERIOD);
+        ms = MIN_STATE_PERIOD;
+    }
+
+    StatePeriod = ms;
+
+    if (le_timer_IsRunning(StateTimer))
+    {
+        le_timer_Stop(StateTimer);
+    }
+
+    if (ms > 0)
+    {
+        le_clk_Time_t interval = { .sec = ms / 1000, .usec = (ms % 1000) * 1000 };
+        LE_ASSERT(le_timer_SetInterval(StateTimer, interval) == LE_OK);
+        LE_ASSERT(le_timer_Start(StateTimer) == LE_OK);
+    }
+    else
+    {
+        stateSegment_Delete();
+        IsStateTooBig = false;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of milliseconds between updates of the state kept in the State Segment.
+ *
+ * @return The number of milliseconds, or 0 if the state isn't kept in shared memory.
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t checkpoint_GetStatePeriod
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return StatePeriod;
+}
@@ -0,0 +1,90 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * @file checkpoint.h
+ *
+ * Interface to the Checkpoint module.
+ *
+ * The Data Hub is restarted if it fails, but on its own it would then come back with an empty
+ * resource tree (apart from the Observations' buffer backups), and serve nothing until every app
+ * had pushed its values again.  So, the state of the whole resource tree (resources, their current
+ * values, defaults, overrides, routes, JSON examples and Observation settings) is saved to a
+ * checkpoint file at regular intervals, and loaded back when the Data Hub starts.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#ifndef CHECKPOINT_H_INCLUDE_GUARD
+#define CHECKPOINT_H_INCLUDE_GUARD
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize the Checkpoint module, rebuilding the resource tree from the last checkpoint (if any)
+ * and starting to save checkpoints.
+ *
+ * @warning Must be called after the Resource Tree and Observation modules have been initialized,
+ *          and before any clients are served.
+ */
+//--------------------------------------------------------------------------------------------------
+void checkpoint_Init
+(
+    void
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the number of seconds between checkpoints.  A checkpoint is only written if the resource
+ * tree has changed since the last one.  The period is saved in the checkpoints, so it stays in
+ * effect when the Data Hub restarts.  Turning checkpoints off deletes the checkpoint file.
+ */
+//--------------------------------------------------------------------------------------------------
+void checkpoint_SetPeriod
+(
+    uint32_t seconds    ///< Seconds between checkpoints (0 = don't save checkpoints).
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of seconds between checkpoints.
+ *
+ * @return The number of seconds, or 0 if checkpoints are not saved.
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t checkpoint_GetPeriod
+(
+    void
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the number of milliseconds between updates of the state kept in shared memory, along with
+ * copies of the Observations' buffers, so that the Data Hub can pick up where it left off if it
+ * fails and is restarted.  The period is saved in the checkpoints (and the State Segment itself),
+ * so it stays in effect when the Data Hub restarts.  Periods shorter than a second are raised to a
+ * second.
+ */
+//--------------------------------------------------------------------------------------------------
+void checkpoint_SetStatePeriod
+(
+    uint32_t ms     ///< Milliseconds between updates (0 = don't keep the state in shared memory).
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of milliseconds between updates of the state kept in shared memory.
+ *
+ * @return The number of milliseconds, or 0 if the state isn't kept in shared memory.
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t checkpoint_GetStatePeriod
+(
+    void
+);
+
+
+#endif // CHECKPOINT_H_INCLUDE_GUARD
@@ -461,6 +461,135 @@ static bool ObsMaxBufferHelper
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Helper function to set the Observation Maximum Buffer age.
+ *
+ * @return
+ *      - true            The function succeeded.
+ *      - false           The function failed.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool ObsBufferMaxAgeHelper
+(
+    parser_ObsData_t* obsDataPtr,     ///< [IN] Pointer to Observation Data structure
+    bool IsANewObs,                   ///< [IN] Is this a new observation?
+    void* context                     ///< [IN] Context pointer
+)
+{
+    ParseContext_t* parseContextPtr = (ParseContext_t*) context;
+
+    if (!parseContextPtr->validateOnly)
+    {
+        if ((obsDataPtr->bitmask & PARSER_OBS_BUFFER_MAX_AGE_MASK) || !IsANewObs)
+        {
+            // Set the Observation Maximum Buffer age
+            le_result_t result = admin_SetBufferMaxAge(obsDataPtr->obsName,
+                obsDataPtr->bufferMaxAge);
+            if (result != LE_OK)
+            {
+                char msg[CONFIG_MAX_ERROR_MSG_LEN] = {0};
+                snprintf(msg,
+                         CONFIG_MAX_ERROR_MSG_LEN,
+                         "Failed to set buffer maxAge for obs %s, error: %s",
+                         obsDataPtr->obsName,
+                         LE_RESULT_TXT(result));
+
+                HandleError(parseContextPtr, LE_FAULT, msg);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Helper function to set the Observation Maximum Buffer bytes.
+ *
+ * @return
+ *      - true            The function succeeded.
+ *      - false           The function failed.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool ObsBufferMaxBytesHelper
+(
+    parser_ObsData_t* obsDataPtr,     ///< [IN] Pointer to Observation Data structure
+    bool IsANewObs,                   ///< [IN] Is this a new observation?
+    void* context                     ///< [IN] Context pointer
+)
+{
+    ParseContext_t* parseContextPtr = (ParseContext_t*) context;
+
+    if (!parseContextPtr->validateOnly)
+    {
+        if ((obsDataPtr->bitmask & PARSER_OBS_BUFFER_MAX_BYTES_MASK) || !IsANewObs)
+        {
+            // Set the Observation Maximum Buffer bytes
+            le_result_t result = admin_SetBufferMaxBytes(obsDataPtr->obsName,
+                obsDataPtr->bufferMaxBytes);
+            if (result != LE_OK)
+            {
+                char msg[CONFIG_MAX_ERROR_MSG_LEN] = {0};
+                snprintf(msg,
+                         CONFIG_MAX_ERROR_MSG_LEN,
+                         "Failed to set buffer maxBytes for obs %s, error: %s",
+                         obsDataPtr->obsName,
+                         LE_RESULT_TXT(result));
+
+                HandleError(parseContextPtr, LE_FAULT, msg);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Helper function to set the Observation Buffer compression.
+ *
+ * @return
+ *      - true            The function succeeded.
+ *      - false           The function failed.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool ObsBufferCompressionHelper
+(
+    parser_ObsData_t* obsDataPtr,     ///< [IN] Pointer to Observation Data structure
+    bool IsANewObs,                   ///< [IN] Is this a new observation?
+    void* context                     ///< [IN] Context pointer
+)
+{
+    ParseContext_t* parseContextPtr = (ParseContext_t*) context;
+
+    if (!parseContextPtr->validateOnly)
+    {
+        if ((obsDataPtr->bitmask & PARSER_OBS_BUFFER_COMPRESSION_MASK) || !IsANewObs)
+        {
+            // Set the Observation Buffer compression
+            le_result_t result = admin_SetBufferCompression(obsDataPtr->obsName,
+                obsDataPtr->bufferCompression);
+            if (result != LE_OK)
+            {
+                char msg[CONFIG_MAX_ERROR_MSG_LEN] = {0};
+                snprintf(msg,
+                         CONFIG_MAX_ERROR_MSG_LEN,
+                         "Failed to set buffer compression for obs %s, error: %s",
+                         obsDataPtr->obsName,
+                         LE_RESULT_TXT(result));
+
+                HandleError(parseContextPtr, LE_FAULT, msg);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Helper function to set the Observation Transform.
@@ -606,6 +735,21 @@ static void OneObservationCb
         return;
     }
 
+    if (!ObsBufferMaxAgeHelper(obsDataPtr, newObs, context))
+    {
+        return;
+    }
+
+    if (!ObsBufferMaxBytesHelper(obsDataPtr, newObs, context))
+    {
+        return;
+    }
+
+    if (!ObsBufferCompressionHelper(obsDataPtr, newObs, context))
+    {
+        return;
+    }
+
     if (!ObsTransformFunctionHelper(obsDataPtr, newObs, context))
     {
         return;
@@ -15,6 +15,9 @@
  *
  * Data Samples are implemented by the dataSample module.
  *
+ * Checkpoints of the whole resource tree, for restoring it after a restart, are implemented by the
+ * checkpoint module.
+ *
  * Copyright (C) Sierra Wireless Inc.
  */
 //--------------------------------------------------------------------------------------------------
@@ -27,14 +30,29 @@
 #include "handler.h"
 #include "resource.h"
 #include "resTree.h"
+#include "resHandle.h"
+#include "strIntern.h"
 #include "ioPoint.h"
 #include "obs.h"
+#include "backupWriter.h"
+#include "checkpoint.h"
 #include "ioService.h"
 #include "adminService.h"
 #include "snapshot.h"
 #include "configService.h"
 
 
+#ifdef UNIT_TEST
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of allocations hub_MemAlloc() makes before the next one fails, so that unit tests can
+ * exercise the out-of-memory paths.  Negative = never fail.
+ */
+//--------------------------------------------------------------------------------------------------
+int hub_MemAllocFailCountdown = -1;
+#endif
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Component initializer.
@@ -46,12 +64,16 @@ COMPONENT_INIT
 void initDataHub(void)
 #endif
 {
+    strIntern_Init();
     dataSample_Init();
     handler_Init();
     res_Init();
     ioPoint_Init();
+    backupWriter_Init();
     obs_Init();
     resTree_Init();
+    resHandle_Init();
+    checkpoint_Init();
     ioService_Init();
     adminService_Init();
     snapshot_Init();
@@ -231,6 +253,13 @@ void* hub_MemAlloc
 )
 //--------------------------------------------------------------------------------------------------
 {
+#ifdef UNIT_TEST
+    if ((hub_MemAllocFailCountdown >= 0) && (hub_MemAllocFailCountdown-- == 0))
+    {
+        return NULL;
+    }
+#endif
+
 #if LE_CONFIG_LINUX
     return le_mem_Alloc(pool);
 #else
@@ -33,6 +33,25 @@ typedef struct hub_Handler* hub_HandlerRef_t;
 
 #include "interfaces.h"
 #include "dataSample.h"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Statistics computed over the data samples found within a time span of an Observation's buffer.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t count;         ///< Number of numerical values in the time span.
+    double min;             ///< Minimum value (NAN if count is 0).
+    double max;             ///< Maximum value (NAN if count is 0).
+    double mean;            ///< Mean value (NAN if count is 0).
+    double stdDev;          ///< Standard deviation (NAN if count is 0).
+    double firstTimestamp;  ///< Timestamp of the oldest sample in the time span (NAN if none).
+    double lastTimestamp;   ///< Timestamp of the newest sample in the time span (NAN if none).
+}
+hub_BufferStats_t;
+
+
 #include "resTree.h"
 
 //--------------------------------------------------------------------------------------------------
@@ -87,6 +106,11 @@ resTree_EntryRef_t hub_GetClientNamespace
     le_msg_SessionRef_t sessionRef  ///< [IN] IPC session reference.
 );
 
+#ifdef UNIT_TEST
+/// Number of allocations hub_MemAlloc() makes before the next one fails (negative = never).
+extern int hub_MemAllocFailCountdown;
+#endif
+
 //--------------------------------------------------------------------------------------------------
 /**
  *  Allocate memory from a datahub pool
@@ -8,6 +8,7 @@
 
 #include "dataHub.h"
 #include "handler.h"
+#include "resHandle.h"
 #include "json.h"
 
 
@@ -86,6 +87,22 @@ static resTree_EntryRef_t FindResource
     return entryRef;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the resource a client's resource reference (from io_OpenResource()) refers to.
+ *
+ * @return Reference to the entry, or NULL if the reference isn't valid.
+ */
+//--------------------------------------------------------------------------------------------------
+static resTree_EntryRef_t FindResourceByHandle
+(
+    io_ResourceRef_t resourceRef
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return resHandle_Lookup(io_GetClientSessionRef(), resourceRef);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Set the client application's namespace to be used for the following calls
@@ -348,6 +365,227 @@ le_result_t io_DeleteResource
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get a reference to an Input or Output resource, for use with the ByHandle functions.  The
+ * reference is only valid for this client, and only until the resource is deleted.
+ *
+ * If the client already has a reference to the resource, the same reference is returned.
+ *
+ * @return The reference, or NULL if the resource doesn't exist (or out of memory).
+ */
+//--------------------------------------------------------------------------------------------------
+io_ResourceRef_t io_OpenResource
+(
+    const char* path
+        ///< [IN] Resource path within the client app's namespace.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    resTree_EntryRef_t resRef = FindResource(path);
+    if (resRef == NULL)
+    {
+        LE_ERROR("Client tried to open a non-existent resource '%s'.", path);
+        return NULL;
+    }
+
+    return resHandle_Open(io_GetClientSessionRef(), resRef);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Release a reference obtained from io_OpenResource().  Does nothing if it isn't valid.
+ */
+//--------------------------------------------------------------------------------------------------
+void io_CloseResource
+(
+    io_ResourceRef_t resourceRef
+        ///< [IN] Reference to the resource.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    resHandle_Close(io_GetClientSessionRef(), resourceRef);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Push a trigger type data sample to a given Input or Output resource.
+ *
+ * @return The result of the push (see io_PushTrigger()).
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t PushTrigger
+(
+    resTree_EntryRef_t resRef,
+    double timestamp
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_result_t ret;
+
+    // Create a Data Sample object for this new sample.
+    dataSample_Ref_t sampleRef = dataSample_CreateTrigger(timestamp);
+
+    if (sampleRef)
+    {
+        // Push the sample to the Resource.
+        ret = resTree_Push(resRef, IO_DATA_TYPE_TRIGGER, sampleRef);
+    }
+    else
+    {
+        LE_ERROR("Failed to push trigger to resource '%s'.", resTree_GetEntryName(resRef));
+        ret = LE_NO_MEMORY;
+    }
+    return ret;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Push a Boolean type data sample to a given Input or Output resource.
+ *
+ * @return The result of the push (see io_PushBoolean()).
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t PushBoolean
+(
+    resTree_EntryRef_t resRef,
+    double timestamp,
+    bool value
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_result_t ret;
+
+    // Create a Data Sample object for this new sample.
+    dataSample_Ref_t sampleRef = dataSample_CreateBoolean(timestamp, value);
+
+    if (sampleRef)
+    {
+        // Push the sample to the Resource.
+        ret = resTree_Push(resRef, IO_DATA_TYPE_BOOLEAN, sampleRef);
+    }
+    else
+    {
+        LE_ERROR("Failed to push boolean to resource '%s'.", resTree_GetEntryName(resRef));
+        ret = LE_NO_MEMORY;
+    }
+    return ret;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Push a numeric type data sample to a given Input or Output resource.
+ *
+ * @return The result of the push (see io_PushNumeric()).
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t PushNumeric
+(
+    resTree_EntryRef_t resRef,
+    double timestamp,
+    double value
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_result_t ret;
+
+    // Create a Data Sample object for this new sample.
+    dataSample_Ref_t sampleRef = dataSample_CreateNumeric(timestamp, value);
+
+    if (sampleRef)
+    {
+        // Push the sample to the Resource.
+        ret = resTree_Push(resRef, IO_DATA_TYPE_NUMERIC, sampleRef);
+    }
+    else
+    {
+        LE_ERROR("Failed to push numeric to resource '%s'.", resTree_GetEntryName(resRef));
+        ret = LE_NO_MEMORY;
+    }
+    return ret;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Push a string type data sample to a given Input or Output resource.
+ *
+ * @return The result of the push (see io_PushString()).
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t PushString
+(
+    resTree_EntryRef_t resRef,
+    double timestamp,
+    const char* value
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_result_t ret;
+
+    // Create a Data Sample object for this new sample.
+    dataSample_Ref_t sampleRef = dataSample_CreateString(timestamp, value);
+
+    if (sampleRef)
+    {
+        // Push the sample to the Resource.
+        ret = resTree_Push(resRef, IO_DATA_TYPE_STRING, sampleRef);
+    }
+    else
+    {
+        LE_ERROR("Failed to push string to resource '%s'.", resTree_GetEntryName(resRef));
+        ret = LE_NO_MEMORY;
+    }
+    return ret;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Push a JSON data sample to a given Input or Output resource.
+ *
+ * @return The result of the push (see io_PushJson()).
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t PushJson
+(
+    resTree_EntryRef_t resRef,
+    double timestamp,
+    const char* value
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_result_t ret;
+
+    if (json_IsValid(value))
+    {
+        // Create a Data Sample object for this new sample.
+        dataSample_Ref_t sampleRef = dataSample_CreateJson(timestamp, value);
+
+        if (sampleRef)
+        {
+            // Push the sample to the Resource.
+            ret = resTree_Push(resRef, IO_DATA_TYPE_JSON, sampleRef);
+        }
+        else
+        {
+            LE_ERROR("Failed to push JSON to resource '%s'.", resTree_GetEntryName(resRef));
+            ret = LE_NO_MEMORY;
+        }
+    }
+    else
+    {
+        LE_WARN("Rejecting invalid JSON string '%s'.", value);
+        ret = LE_BAD_PARAMETER;
+    }
+    return ret;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Push a trigger type data sample.
@@ -376,29 +614,13 @@ le_result_t io_PushTrigger
 //--------------------------------------------------------------------------------------------------
 {
     resTree_EntryRef_t resRef = FindResource(path);
-    le_result_t ret;
     if (resRef == NULL)
     {
         LE_ERROR("Client tried to push data to a non-existent resource '%s'.", path);
-        ret = LE_NOT_FOUND;
+        return LE_NOT_FOUND;
     }
-    else
-    {
-        // Create a Data Sample object for this new sample.
-        dataSample_Ref_t sampleRef = dataSample_CreateTrigger(timestamp);
 
-        if (sampleRef)
-        {
-            // Push the sample to the Resource.
-            ret = resTree_Push(resRef, IO_DATA_TYPE_TRIGGER, sampleRef);
-        }
-        else
-        {
-            LE_ERROR("Failed to push trigger to path '%s'", path);
-            ret = LE_NO_MEMORY;
-        }
-    }
-    return ret;
+    return PushTrigger(resRef, timestamp);
 }
 
 
@@ -433,29 +655,13 @@ le_result_t io_PushBoolean
 //--------------------------------------------------------------------------------------------------
 {
     resTree_EntryRef_t resRef = FindResource(path);
-    le_result_t ret;
     if (resRef == NULL)
     {
         LE_ERROR("Client tried to push data to a non-existent resource '%s'.", path);
-        ret = LE_NOT_FOUND;
+        return LE_NOT_FOUND;
     }
-    else
-    {
-        // Create a Data Sample object for this new sample.
-        dataSample_Ref_t sampleRef = dataSample_CreateBoolean(timestamp, value);
 
-        if (sampleRef)
-        {
-            // Push the sample to the Resource.
-            ret = resTree_Push(resRef, IO_DATA_TYPE_BOOLEAN, sampleRef);
-        }
-        else
-        {
-            LE_ERROR("Failed to push boolean to path '%s'", path);
-            ret = LE_NO_MEMORY;
-        }
-    }
-    return ret;
+    return PushBoolean(resRef, timestamp, value);
 }
 
 
@@ -490,29 +696,13 @@ le_result_t io_PushNumeric
 //--------------------------------------------------------------------------------------------------
 {
     resTree_EntryRef_t resRef = FindResource(path);
-    le_result_t ret;
     if (resRef == NULL)
     {
         LE_ERROR("Client tried to push data to a non-existent resource '%s'.", path);
-        ret = LE_NOT_FOUND;
+        return LE_NOT_FOUND;
     }
-    else
-    {
-        // Create a Data Sample object for this new sample.
-        dataSample_Ref_t sampleRef = dataSample_CreateNumeric(timestamp, value);
 
-        if (sampleRef)
-        {
-            // Push the sample to the Resource.
-            ret = resTree_Push(resRef, IO_DATA_TYPE_NUMERIC, sampleRef);
-        }
-        else
-        {
-            LE_ERROR("Failed to push numeric to path '%s'", path);
-            ret = LE_NO_MEMORY;
-        }
-    }
-    return ret;
+    return PushNumeric(resRef, timestamp, value);
 }
 
 
@@ -547,29 +737,13 @@ le_result_t io_PushString
 //--------------------------------------------------------------------------------------------------
 {
     resTree_EntryRef_t resRef = FindResource(path);
-    le_result_t ret;
     if (resRef == NULL)
     {
         LE_ERROR("Client tried to push data to a non-existent resource '%s'.", path);
-        ret = LE_NOT_FOUND;
+        return LE_NOT_FOUND;
     }
-    else
-    {
-        // Create a Data Sample object for this new sample.
-        dataSample_Ref_t sampleRef = dataSample_CreateString(timestamp, value);
 
-        if (sampleRef)
-        {
-            // Push the sample to the Resource.
-            ret = resTree_Push(resRef, IO_DATA_TYPE_STRING, sampleRef);
-        }
-        else
-        {
-            LE_ERROR("Failed to push string to path '%s'", path);
-            ret = LE_NO_MEMORY;
-        }
-    }
-    return ret;
+    return PushString(resRef, timestamp, value);
 }
 
 
@@ -603,34 +777,211 @@ le_result_t io_PushJson
 //--------------------------------------------------------------------------------------------------
 {
     resTree_EntryRef_t resRef = FindResource(path);
-    le_result_t ret;
     if (resRef == NULL)
     {
         LE_ERROR("Client tried to push data to a non-existent resource '%s'.", path);
-        ret = LE_NOT_FOUND;
+        return LE_NOT_FOUND;
     }
-    else if (json_IsValid(value))
-    {
-        // Create a Data Sample object for this new sample.
-        dataSample_Ref_t sampleRef = dataSample_CreateJson(timestamp, value);
 
-        if (sampleRef)
-        {
-            // Push the sample to the Resource.
-            ret = resTree_Push(resRef, IO_DATA_TYPE_JSON, sampleRef);
-        }
-        else
-        {
-            LE_ERROR("Failed to push JSON to path '%s'", path);
-            ret = LE_NO_MEMORY;
-        }
-    }
-    else
+    return PushJson(resRef, timestamp, value);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Push a trigger type data sample to a resource referred to by a reference from io_OpenResource().
+ *
+ * @note The LE_OK return from this function means the sample has been successfully received by
+ * datahub. It does not guarantee that the sample will be successfully processed by observers
+ * of the path or that the sample will not be lost after power cycle.
+ *
+ * @return
+ *      - LE_OK If datasample was pushed successfully.
+ *      - LE_NO_MEMORY If failed to push the data sample because of failure in memory allocation.
+ *      - LE_IN_PROGRESS If Push is rejected because a configuration update is in progress.
+ *      - LE_BAD_PARAMETER If there is a mismatch of datasample unit.
+ *      - LE_NOT_FOUND If the resource reference is not valid.
+ *      - LE_FAULT If any other error happened during push.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t io_PushTriggerByHandle
+(
+    io_ResourceRef_t resourceRef,
+        ///< [IN] Reference to the resource.
+    double timestamp
+        ///< [IN] Timestamp in seconds since the Epoch 1970-01-01 00:00:00 +0000 (UTC).
+        ///< Zero = now.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    resTree_EntryRef_t resRef = FindResourceByHandle(resourceRef);
+    if (resRef == NULL)
     {
-        LE_WARN("Rejecting invalid JSON string '%s'.", value);
-        ret = LE_BAD_PARAMETER;
+        LE_ERROR("Client tried to push data to an invalid resource reference %p.", resourceRef);
+        return LE_NOT_FOUND;
     }
-    return ret;
+
+    return PushTrigger(resRef, timestamp);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Push a Boolean type data sample to a resource referred to by a reference from io_OpenResource().
+ *
+ * @note The LE_OK return from this function means the sample has been successfully received by
+ * datahub. It does not guarantee that the sample will be successfully processed by observers
+ * of the path or that the sample will not be lost after power cycle.
+ *
+ * @return
+ *      - LE_OK If datasample was pushed successfully.
+ *      - LE_NO_MEMORY If failed to push the data sample because of failure in memory allocation.
+ *      - LE_IN_PROGRESS If Push is rejected because a configuration update is in progress.
+ *      - LE_BAD_PARAMETER If there is a mismatch of datasample unit.
+ *      - LE_NOT_FOUND If the resource reference is not valid.
+ *      - LE_FAULT If any other error happened during push.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t io_PushBooleanByHandle
+(
+    io_ResourceRef_t resourceRef,
+        ///< [IN] Reference to the resource.
+    double timestamp,
+        ///< [IN] Timestamp in seconds since the Epoch 1970-01-01 00:00:00 +0000 (UTC).
+        ///< Zero = now.,
+    bool value
+        ///< [IN]
+)
+//--------------------------------------------------------------------------------------------------
+{
+    resTree_EntryRef_t resRef = FindResourceByHandle(resourceRef);
+    if (resRef == NULL)
+    {
+        LE_ERROR("Client tried to push data to an invalid resource reference %p.", resourceRef);
+        return LE_NOT_FOUND;
+    }
+
+    return PushBoolean(resRef, timestamp, value);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Push a numeric type data sample to a resource referred to by a reference from io_OpenResource().
+ *
+ * @note The LE_OK return from this function means the sample has been successfully received by
+ * datahub. It does not guarantee that the sample will be successfully processed by observers
+ * of the path or that the sample will not be lost after power cycle.
+ *
+ * @return
+ *      - LE_OK If datasample was pushed successfully.
+ *      - LE_NO_MEMORY If failed to push the data sample because of failure in memory allocation.
+ *      - LE_IN_PROGRESS If Push is rejected because a configuration update is in progress.
+ *      - LE_BAD_PARAMETER If there is a mismatch of datasample unit.
+ *      - LE_NOT_FOUND If the resource reference is not valid.
+ *      - LE_FAULT If any other error happened during push.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t io_PushNumericByHandle
+(
+    io_ResourceRef_t resourceRef,
+        ///< [IN] Reference to the resource.
+    double timestamp,
+        ///< [IN] Timestamp in seconds since the Epoch 1970-01-01 00:00:00 +0000 (UTC).
+        ///< Zero = now.,
+    double value
+        ///< [IN]
+)
+//--------------------------------------------------------------------------------------------------
+{
+    resTree_EntryRef_t resRef = FindResourceByHandle(resourceRef);
+    if (resRef == NULL)
+    {
+        LE_ERROR("Client tried to push data to an invalid resource reference %p.", resourceRef);
+        return LE_NOT_FOUND;
+    }
+
+    return PushNumeric(resRef, timestamp, value);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Push a string type data sample to a resource referred to by a reference from io_OpenResource().
+ *
+ * @note The LE_OK return from this function means the sample has been successfully received by
+ * datahub. It does not guarantee that the sample will be successfully processed by observers
+ * of the path or that the sample will not be lost after power cycle.
+ *
+ * @return
+ *      - LE_OK If datasample was pushed successfully.
+ *      - LE_NO_MEMORY If failed to push the data sample because of failure in memory allocation.
+ *      - LE_IN_PROGRESS If Push is rejected because a configuration update is in progress.
+ *      - LE_BAD_PARAMETER If there is a mismatch of datasample unit.
+ *      - LE_NOT_FOUND If the resource reference is not valid.
+ *      - LE_FAULT If any other error happened during push.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t io_PushStringByHandle
+(
+    io_ResourceRef_t resourceRef,
+        ///< [IN] Reference to the resource.
+    double timestamp,
+        ///< [IN] Timestamp in seconds since the Epoch 1970-01-01 00:00:00 +0000 (UTC).
+        ///< Zero = now.,
+    const char* value
+        ///< [IN]
+)
+//--------------------------------------------------------------------------------------------------
+{
+    resTree_EntryRef_t resRef = FindResourceByHandle(resourceRef);
+    if (resRef == NULL)
+    {
+        LE_ERROR("Client tried to push data to an invalid resource reference %p.", resourceRef);
+        return LE_NOT_FOUND;
+    }
+
+    return PushString(resRef, timestamp, value);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Push a JSON data sample to a resource referred to by a reference from io_OpenResource().
+ *
+ * @note The LE_OK return from this function means the sample has been successfully received by
+ * datahub. It does not guarantee that the sample will be successfully processed by observers
+ * of the path or that the sample will not be lost after power cycle.
+ *
+ * @return
+ *      - LE_OK If datasample was pushed successfully.
+ *      - LE_NO_MEMORY If failed to push the data sample because of failure in memory allocation.
+ *      - LE_IN_PROGRESS If Push is rejected because a configuration update is in progress.
+ *      - LE_BAD_PARAMETER If there is a mismatch of datasample unit or JSON is not valid.
+ *      - LE_NOT_FOUND If the resource reference is not valid.
+ *      - LE_FAULT If any other error happened during push.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t io_PushJsonByHandle
+(
+    io_ResourceRef_t resourceRef,
+        ///< [IN] Reference to the resource.
+    double timestamp,
+        ///< [IN] Timestamp in seconds since the Epoch 1970-01-01 00:00:00 +0000 (UTC).
+        ///< Zero = now.,
+    const char* value
+        ///< [IN]
+)
+//--------------------------------------------------------------------------------------------------
+{
+    resTree_EntryRef_t resRef = FindResourceByHandle(resourceRef);
+    if (resRef == NULL)
+    {
+        LE_ERROR("Client tried to push data to an invalid resource reference %p.", resourceRef);
+        return LE_NOT_FOUND;
+    }
+
+    return PushJson(resRef, timestamp, value);
 }
 
 
@@ -1219,7 +1570,7 @@ static dataSample_Ref_t GetCurrentValue
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Fetch the timestamp of the current value of an Input or Output resource with any data type.
+ * Fetch the timestamp of the current value of a given Input or Output resource.
  *
  * @return
  *  - LE_OK if successful.
@@ -1227,16 +1578,15 @@ static dataSample_Ref_t GetCurrentValue
  *  - LE_UNAVAILABLE if the resource does not currently have a value.
  */
 //--------------------------------------------------------------------------------------------------
-le_result_t io_GetTimestamp
+static le_result_t GetTimestamp
 (
-    const char* path,
-        ///< [IN] Resource path within the client app's namespace.
+    resTree_EntryRef_t resRef,
+        ///< [IN] The resource (NULL if not found).
     double* timestampPtr
         ///< [OUT] Timestamp in seconds since the Epoch 1970-01-01 00:00:00 +0000 (UTC).
 )
 //--------------------------------------------------------------------------------------------------
 {
-    resTree_EntryRef_t resRef = FindResource(path);
     if (resRef == NULL)
     {
         return LE_NOT_FOUND;
@@ -1256,7 +1606,7 @@ le_result_t io_GetTimestamp
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Fetch the current value of a Boolean type Input or Output resource.
+ * Fetch the current value of a given Boolean type Input or Output resource.
  *
  * @return
  *  - LE_OK if successful.
@@ -1264,10 +1614,10 @@ le_result_t io_GetTimestamp
  *  - LE_UNAVAILABLE if the resource does not currently have a value.
  */
 //--------------------------------------------------------------------------------------------------
-le_result_t io_GetBoolean
+static le_result_t GetBoolean
 (
-    const char* path,
-        ///< [IN] Resource path within the client app's namespace.
+    resTree_EntryRef_t resRef,
+        ///< [IN] The resource (NULL if not found).
     double* timestampPtr,
         ///< [OUT] Timestamp in seconds since the Epoch 1970-01-01 00:00:00 +0000 (UTC).
     bool* valuePtr
@@ -1275,9 +1625,6 @@ le_result_t io_GetBoolean
 )
 //--------------------------------------------------------------------------------------------------
 {
-    LE_UNUSED(timestampPtr);
-
-    resTree_EntryRef_t resRef = FindResource(path);
     if (resRef == NULL)
     {
         return LE_NOT_FOUND;
@@ -1298,7 +1645,7 @@ le_result_t io_GetBoolean
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Fetch the current value of a numeric type Input or Output resource.
+ * Fetch the current value of a given numeric type Input or Output resource.
  *
  * @return
  *  - LE_OK if successful.
@@ -1306,10 +1653,10 @@ le_result_t io_GetBoolean
  *  - LE_UNAVAILABLE if the resource does not currently have a value.
  */
 //--------------------------------------------------------------------------------------------------
-le_result_t io_GetNumeric
+static le_result_t GetNumeric
 (
-    const char* path,
-        ///< [IN] Resource path within the client app's namespace.
+    resTree_EntryRef_t resRef,
+        ///< [IN] The resource (NULL if not found).
     double* timestampPtr,
         ///< [OUT] Timestamp in seconds since the Epoch 1970-01-01 00:00:00 +0000 (UTC).
     double* valuePtr
@@ -1317,9 +1664,6 @@ le_result_t io_GetNumeric
 )
 //--------------------------------------------------------------------------------------------------
 {
-    LE_UNUSED(timestampPtr);
-
-    resTree_EntryRef_t resRef = FindResource(path);
     if (resRef == NULL)
     {
         return LE_NOT_FOUND;
@@ -1340,7 +1684,7 @@ le_result_t io_GetNumeric
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Fetch the current value of a string type Input or Output resource.
+ * Fetch the current value of a given string type Input or Output resource.
  *
  * @return
  *  - LE_OK if successful.
@@ -1349,10 +1693,10 @@ le_result_t io_GetNumeric
  *  - LE_UNAVAILABLE if the resource does not currently have a value.
  */
 //--------------------------------------------------------------------------------------------------
-le_result_t io_GetString
+static le_result_t GetString
 (
-    const char* path,
-        ///< [IN] Resource path within the client app's namespace.
+    resTree_EntryRef_t resRef,
+        ///< [IN] The resource (NULL if not found).
     double* timestampPtr,
         ///< [OUT] Timestamp in seconds since the Epoch 1970-01-01 00:00:00 +0000 (UTC).
     char* value,
@@ -1362,9 +1706,6 @@ le_result_t io_GetString
 )
 //--------------------------------------------------------------------------------------------------
 {
-    LE_UNUSED(timestampPtr);
-
-    resTree_EntryRef_t resRef = FindResource(path);
     if (resRef == NULL)
     {
         return LE_NOT_FOUND;
@@ -1383,7 +1724,7 @@ le_result_t io_GetString
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Fetch the current value of an Input or Output resource (of any data type) in JSON format.
+ * Fetch the current value of a given Input or Output resource (of any data type) in JSON format.
  *
  * @return
  *  - LE_OK if successful.
@@ -1392,10 +1733,10 @@ le_result_t io_GetString
  *  - LE_UNAVAILABLE if the resource does not currently have a value.
  */
 //--------------------------------------------------------------------------------------------------
-le_result_t io_GetJson
+static le_result_t GetJson
 (
-    const char* path,
-        ///< [IN] Resource path within the client app's namespace.
+    resTree_EntryRef_t resRef,
+        ///< [IN] The resource (NULL if not found).
     double* timestampPtr,
         ///< [OUT] Timestamp in seconds since the Epoch 1970-01-01 00:00:00 +0000 (UTC).
     char* value,
@@ -1405,9 +1746,6 @@ le_result_t io_GetJson
 )
 //--------------------------------------------------------------------------------------------------
 {
-    LE_UNUSED(timestampPtr);
-
-    resTree_EntryRef_t resRef = FindResource(path);
     if (resRef == NULL)
     {
         return LE_NOT_FOUND;
@@ -1424,6 +1762,269 @@ le_result_t io_GetJson
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Fetch the timestamp of the current value of an Input or Output resource with any data type.
+ *
+ * @return
+ *  - LE_OK if successful.
+ *  - LE_NOT_FOUND if the resource does not exist.
+ *  - LE_UNAVAILABLE if the resource does not currently have a value.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t io_GetTimestamp
+(
+    const char* path,
+        ///< [IN] Resource path within the client app's namespace.
+    double* timestampPtr
+        ///< [OUT] Timestamp in seconds since the Epoch 1970-01-01 00:00:00 +0000 (UTC).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return GetTimestamp(FindResource(path), timestampPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Fetch the current value of a Boolean type Input or Output resource.
+ *
+ * @return
+ *  - LE_OK if successful.
+ *  - LE_NOT_FOUND if the resource does not exist.
+ *  - LE_UNAVAILABLE if the resource does not currently have a value.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t io_GetBoolean
+(
+    const char* path,
+        ///< [IN] Resource path within the client app's namespace.
+    double* timestampPtr,
+        ///< [OUT] Timestamp in seconds since the Epoch 1970-01-01 00:00:00 +0000 (UTC).
+    bool* valuePtr
+        ///< [OUT]
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return GetBoolean(FindResource(path), timestampPtr, valuePtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Fetch the current value of a numeric type Input or Output resource.
+ *
+ * @return
+ *  - LE_OK if successful.
+ *  - LE_NOT_FOUND if the resource does not exist.
+ *  - LE_UNAVAILABLE if the resource does not currently have a value.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t io_GetNumeric
+(
+    const char* path,
+        ///< [IN] Resource path within the client app's namespace.
+    double* timestampPtr,
+        ///< [OUT] Timestamp in seconds since the Epoch 1970-01-01 00:00:00 +0000 (UTC).
+    double* valuePtr
+        ///< [OUT]
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return GetNumeric(FindResource(path), timestampPtr, valuePtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Fetch the current value of a string type Input or Output resource.
+ *
+ * @return
+ *  - LE_OK if successful.
+ *  - LE_OVERFLOW if the value buffer was too small to hold the value.
+ *  - LE_NOT_FOUND if the resource does not exist.
+ *  - LE_UNAVAILABLE if the resource does not currently have a value.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t io_GetString
+(
+    const char* path,
+        ///< [IN] Resource path within the client app's namespace.
+    double* timestampPtr,
+        ///< [OUT] Timestamp in seconds since the Epoch 1970-01-01 00:00:00 +0000 (UTC).
+    char* value,
+        ///< [OUT]
+    size_t valueSize
+        ///< [IN]
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return GetString(FindResource(path), timestampPtr, value, valueSize);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Fetch the current value of an Input or Output resource (of any data type) in JSON format.
+ *
+ * @return
+ *  - LE_OK if successful.
+ *  - LE_OVERFLOW if the value buffer was too small to hold the value.
+ *  - LE_NOT_FOUND if the resource does not exist.
+ *  - LE_UNAVAILABLE if the resource does not currently have a value.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t io_GetJson
+(
+    const char* path,
+        ///< [IN] Resource path within the client app's namespace.
+    double* timestampPtr,
+        ///< [OUT] Timestamp in seconds since the Epoch 1970-01-01 00:00:00 +0000 (UTC).
+    char* value,
+        ///< [OUT]
+    size_t valueSize
+        ///< [IN]
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return GetJson(FindResource(path), timestampPtr, value, valueSize);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Fetch the timestamp of the current value of an Input or Output resource with any data type,
+ * given a reference to it from io_OpenResource().
+ *
+ * @return
+ *  - LE_OK if successful.
+ *  - LE_NOT_FOUND if the resource reference is not valid.
+ *  - LE_UNAVAILABLE if the resource does not currently have a value.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t io_GetTimestampByHandle
+(
+    io_ResourceRef_t resourceRef,
+        ///< [IN] Reference to the resource.
+    double* timestampPtr
+        ///< [OUT] Timestamp in seconds since the Epoch 1970-01-01 00:00:00 +0000 (UTC).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return GetTimestamp(FindResourceByHandle(resourceRef), timestampPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Fetch the current value of a Boolean type Input or Output resource,
+ * given a reference to it from io_OpenResource().
+ *
+ * @return
+ *  - LE_OK if successful.
+ *  - LE_NOT_FOUND if the resource reference is not valid.
+ *  - LE_UNAVAILABLE if the resource does not currently have a value.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t io_GetBooleanByHandle
+(
+    io_ResourceRef_t resourceRef,
+        ///< [IN] Reference to the resource.
+    double* timestampPtr,
+        ///< [OUT] Timestamp in seconds since the Epoch 1970-01-01 00:00:00 +0000 (UTC).
+    bool* valuePtr
+        ///< [OUT]
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return GetBoolean(FindResourceByHandle(resourceRef), timestampPtr, valuePtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Fetch the current value of a numeric type Input or Output resource,
+ * given a reference to it from io_OpenResource().
+ *
+ * @return
+ *  - LE_OK if successful.
+ *  - LE_NOT_FOUND if the resource reference is not valid.
+ *  - LE_UNAVAILABLE if the resource does not currently have a value.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t io_GetNumericByHandle
+(
+    io_ResourceRef_t resourceRef,
+        ///< [IN] Reference to the resource.
+    double* timestampPtr,
+        ///< [OUT] Timestamp in seconds since the Epoch 1970-01-01 00:00:00 +0000 (UTC).
+    double* valuePtr
+        ///< [OUT]
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return GetNumeric(FindResourceByHandle(resourceRef), timestampPtr, valuePtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Fetch the current value of a string type Input or Output resource,
+ * given a reference to it from io_OpenResource().
+ *
+ * @return
+ *  - LE_OK if successful.
+ *  - LE_OVERFLOW if the value buffer was too small to hold the value.
+ *  - LE_NOT_FOUND if the resource reference is not valid.
+ *  - LE_UNAVAILABLE if the resource does not currently have a value.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t io_GetStringByHandle
+(
+    io_ResourceRef_t resourceRef,
+        ///< [IN] Reference to the resource.
+    double* timestampPtr,
+        ///< [OUT] Timestamp in seconds since the Epoch 1970-01-01 00:00:00 +0000 (UTC).
+    char* value,
+        ///< [OUT]
+    size_t valueSize
+        ///< [IN]
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return GetString(FindResourceByHandle(resourceRef), timestampPtr, value, valueSize);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Fetch the current value of an Input or Output resource (of any data type) in JSON format,
+ * given a reference to it from io_OpenResource().
+ *
+ * @return
+ *  - LE_OK if successful.
+ *  - LE_OVERFLOW if the value buffer was too small to hold the value.
+ *  - LE_NOT_FOUND if the resource reference is not valid.
+ *  - LE_UNAVAILABLE if the resource does not currently have a value.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t io_GetJsonByHandle
+(
+    io_ResourceRef_t resourceRef,
+        ///< [IN] Reference to the resource.
+    double* timestampPtr,
+        ///< [OUT] Timestamp in seconds since the Epoch 1970-01-01 00:00:00 +0000 (UTC).
+    char* value,
+        ///< [OUT]
+    size_t valueSize
+        ///< [IN]
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return GetJson(FindResourceByHandle(resourceRef), timestampPtr, value, valueSize);
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Add handler function for EVENT 'io_UpdateStartEnd'
@@ -10,22 +10,111 @@
  *
  * The data sample buffer backup file format looks like this (little-endian byte order):
  *
- * - file format version byte = 0
+ * - file format version byte = 1
  * - data type byte containing one of the following ASCII characters:
  *       t = trigger
  *       b = Boolean
  *       n = numeric
  *       s = string
  *       j = JSON
+ * - two zero bytes
  * - number of records = 4-byte unsigned integer
- * - array of records, sorted oldest-first, each containing:
- *       - timestamp (8-byte IEEE double-precision floating point value)
- *       - value, depending on data type, as follows:
- *             t -> no value
- *             b -> 1 byte, 0 = false, 1 = true
- *             n -> 8-byte IEEE double-precision floating point value
- *             s -> 4-byte unsigned integer length, followed by string content (no null-terminator)
- *             j -> 4-byte unsigned integer length, followed by JSON string content (no term char)
+ * - maximum number of records in a block = 4-byte unsigned integer
+ * - CRC-32 of the above 12 bytes = 4-byte unsigned integer
+ * - array of blocks, each holding the next (up to) maximum number of records, containing:
+ *       - number of bytes in the block's records = 4-byte unsigned integer
+ *       - CRC-32 of the block's records = 4-byte unsigned integer
+ *       - array of records, sorted oldest-first, each containing:
+ *             - timestamp (8-byte IEEE double-precision floating point value)
+ *             - value, depending on data type, as follows:
+ *                   t -> no value
+ *                   b -> 1 byte, 0 = false, 1 = true
+ *                   n -> 8-byte IEEE double-precision floating point value
+ *                   s -> 4-byte unsigned integer length, followed by string content
+ *                        (no null-terminator)
+ *                   j -> 4-byte unsigned integer length, followed by JSON string content
+ *                        (no term char)
+ *             - zero bytes padding the record to a multiple of 8 bytes
+ *
+ * Every record starts on an 8-byte boundary, so Boolean and numeric records are all 16 bytes long
+ * and the whole file can be memory-mapped and loaded into the buffer without copying it first.
+ * The header and each block are checked against their CRCs before any of their records are used.
+ *
+ * Version 0 backup files, written by older versions of the Data Hub, can still be restored.  They
+ * have no CRCs, blocks or padding: the version byte (0), the data type byte and the number of
+ * records are followed directly by the array of records.
+ *
+ * Instead of rewriting its whole backup file every time, an Observation can keep its backup as an
+ * append-only log (see obs_SetBufferBackupLog()).  The log is a series of segment files whose
+ * paths are that of the backup file with the ".bak" suffix replaced by ".log.<n>" (n = 0, 1, ...).
+ * Segment 0 is the log's base: a full copy of the buffer, written atomically.  Each backup after
+ * that appends only the samples added since the previous backup to the newest segment, starting
+ * a new segment when that one is full.  Once the appended samples outgrow the base, the log is
+ * compacted by writing a new base and deleting the other segments.
+ *
+ * The log segment file format looks like this (little-endian byte order):
+ *
+ * - magic number = the 4 ASCII characters "DHLG"
+ * - generation number of the base = 4-byte unsigned integer (incremented for each new base)
+ * - segment number (n) = 4-byte unsigned integer
+ * - CRC-32 of the above 12 bytes = 4-byte unsigned integer
+ * - array of frames, oldest-first, each containing:
+ *       - number of bytes in the frame's payload = 4-byte unsigned integer
+ *       - CRC-32 of the payload = 4-byte unsigned integer
+ *       - payload:
+ *             - sequence number of the oldest sample in the buffer = 8-byte unsigned integer
+ *             - sequence number of the first sample in the frame = 8-byte unsigned integer
+ *             - number of records = 4-byte unsigned integer
+ *             - data type byte (as in the backup file)
+ *             - array of records (as in version 0 of the backup file, without padding)
+ *
+ * Samples are numbered in the order they were added to the buffer, so a frame tells how many of
+ * the samples restored so far have since been dropped from the buffer (all those numbered before
+ * the oldest one still buffered).  The log is replayed until the first segment or frame that is
+ * incomplete, fails its CRC check or doesn't follow on from the previous one (such as a segment
+ * left over from a base that has since been replaced).
+ *
+ * Instead of each having its own backup file, the buffers of all Observations not backed up to a
+ * log can be backed up together into a single pack file, BACKUP_PACK_PATH (see
+ * obs_SetBackupPacked()), so that restoring them at start-up and cleaning up the unused ones is
+ * one sequential read rather than thousands of small file opens.  The pack is rewritten (as a
+ * whole, atomically) once for each batch of backups that changes it, copying the backups that
+ * haven't changed from the old pack.  An Observation's backup log or backup file, if it has one,
+ * is newer than its backup in the pack, so is restored in preference to it.
+ *
+ * The pack file format looks like this (little-endian byte order):
+ *
+ * - magic number = the 4 ASCII characters "DHPK"
+ * - number of backups = 4-byte unsigned integer
+ * - number of bytes in the index = 4-byte unsigned integer
+ * - CRC-32 of the index = 4-byte unsigned integer
+ * - CRC-32 of the above 16 bytes = 4-byte unsigned integer
+ * - index, with an entry for each backup containing:
+ *       - length of the backup file path relative to BACKUP_DIR = 2-byte unsigned integer
+ *       - backup file path relative to BACKUP_DIR (no null-terminator)
+ *       - offset of the backup from the start of the pack file = 4-byte unsigned integer
+ *       - number of bytes in the backup = 4-byte unsigned integer
+ *       - CRC-32 of the backup = 4-byte unsigned integer
+ * - backups, in index order, each the same as the contents of a backup file and starting on an
+ *   8-byte boundary (preceded by as many zero bytes as it takes)
+ *
+ * Restoring a large buffer means reading all its samples, which holds up start-up.  So, instead,
+ * buffers can be restored lazily (see obs_SetBackupLazyRestore()): only the header and last block
+ * of a backup are read when its Observation is created, to restore the newest sample as the
+ * current value, and the rest of the samples are loaded when the buffer is first needed (e.g.,
+ * when it is read, queried or pushed to).  Backup logs and version 0 backup files are always
+ * restored in full.
+ *
+ * Backups are serialized into an in-memory image on the main thread and written out by the Backup
+ * Writer's thread (see backupWriter.h), so the event loop isn't held up while the file system
+ * flushes them.  An Observation only has one backup being written at a time; a backup wanted
+ * while one is being written is done when that one is finished.  Deleting backup files is queued
+ * behind any backups still being written, so that they happen in order.
+ *
+ * Backups are scheduled on a timer wheel that ticks once a second while any backup is due, rather
+ * than each Observation having its own timer.  All the backups that are due at a tick are handed
+ * to the Backup Writer together.  If a flash write budget is set (see obs_SetBackupWriteBudget()),
+ * backups that would exceed it are held back until later ticks, oldest due first.
  *
  * Copyright (C) Sierra Wireless Inc.
  */
@@ -41,35 +130,181 @@
 #include "json.h"
 #include "obs.h"
 #include "configService.h"
+#include "sampleBlock.h"
+#include "backupWriter.h"
 
 #if LE_CONFIG_LINUX
 #   include <ftw.h>
+#   include <sys/mman.h>
 #endif
 
 #ifdef LEGATO_EMBEDDED
  #define BACKUP_DIR "/home/root/dataHubBackup/"
+ #define BACKUP_PACK_PATH "/home/root/dataHubBackup.pack"
 #else
  #define BACKUP_DIR "backup/"
+ #define BACKUP_PACK_PATH "backup.pack"
 #endif
 #define BACKUP_DIR_PATH_LEN (sizeof(BACKUP_DIR) - 1)
 #define BACKUP_SUFFIX ".bak"
 #define BACKUP_SUFFIX_LEN (sizeof(BACKUP_SUFFIX) - 1)
 
+/// Version of the backup file format written.
+#define BACKUP_FILE_VERSION 1
+
+/// Number of bytes in a backup file's header (version, data type code, padding, record count,
+/// records per block and CRC).
+#define BACKUP_FILE_HEADER_BYTES 16
+
+/// Number of bytes in a version 0 backup file's header (version, data type code and record count).
+#define BACKUP_FILE_V0_HEADER_BYTES 6
+
+/// Number of bytes before the records in a block of a backup file (records' size and CRC).
+#define BACKUP_BLOCK_HEADER_BYTES 8
+
+/// Maximum number of records in a block of a backup file.
+#define BACKUP_BLOCK_RECORDS 256
+
+/// Records in a backup file (and backups in the backup pack) start on multiples of this many
+/// bytes.
+#define BACKUP_RECORD_ALIGN 8
+
 #define MAX_BACKUP_FILE_PATH_BYTES (  BACKUP_DIR_PATH_LEN \
                                     + IO_MAX_RESOURCE_PATH_LEN \
                                     + BACKUP_SUFFIX_LEN \
                                     + 1 /* for null terminator */ )
 
+#define BACKUP_LOG_SUFFIX ".log."
+#define BACKUP_LOG_SUFFIX_LEN (sizeof(BACKUP_LOG_SUFFIX) - 1)
+
+/// Maximum number of segment files in a backup log (base included).  Segment numbers are at most
+/// 2 digits long.
+#define BACKUP_LOG_MAX_SEGMENTS 32
+
+/// Size beyond which a backup log segment is not appended to any more.
+#define BACKUP_LOG_SEGMENT_BYTES (32 * 1024)
+
+#define MAX_BACKUP_LOG_FILE_PATH_BYTES (  BACKUP_DIR_PATH_LEN \
+                                        + IO_MAX_RESOURCE_PATH_LEN \
+                                        + BACKUP_LOG_SUFFIX_LEN \
+                                        + 2 /* for segment number */ \
+                                        + 1 /* for null terminator */ )
+
+/// Magic number at the start of each backup log segment file.
+#define BACKUP_LOG_MAGIC "DHLG"
+
+/// Number of bytes in a backup log segment file's header (magic number, generation number,
+/// segment number and CRC).
+#define BACKUP_LOG_HEADER_BYTES 16
+
+/// Number of bytes before the payload of a backup log frame (payload length and CRC).
+#define BACKUP_LOG_FRAME_PREFIX_BYTES 8
+
+/// Number of bytes before the records in a backup log frame's payload (oldest sequence number,
+/// first sequence number, record count and data type code).
+#define BACKUP_LOG_FRAME_HEAD_BYTES 21
+
+/// Magic number at the start of the backup pack file.
+#define BACKUP_PACK_MAGIC "DHPK"
+
+/// Number of bytes in the backup pack file's header (magic number, backup count, index size,
+/// index CRC and header CRC).
+#define BACKUP_PACK_HEADER_BYTES 20
+
+/// Number of bytes in an entry of the backup pack file's index, not counting the path.
+#define BACKUP_PACK_ENTRY_FIXED_BYTES 14
+
+#define MAX_BACKUP_PACK_ENTRY_BYTES (BACKUP_PACK_ENTRY_FIXED_BYTES + MAX_BACKUP_FILE_PATH_BYTES)
+
 /// Number of seconds in 30 years.
 #define THIRTY_YEARS 946684800.0
 
+/// Number of slots in the backup timer wheel (one per second of the wheel's period).
+#define BACKUP_WHEEL_SLOTS 64
+
+/// Number of seconds in an hour, over which the backup flash write budget is spread.
+#define SECONDS_PER_HOUR 3600
+
 /// Default number of observations.  This can be overridden in the .cdef.
 #define DEFAULT_OBSERVATION_POOL_SIZE       5
-/// Default number of buffer entries.  This can be overridden in the .cdef.
-#define DEFAULT_BUFFER_ENTRY_POOL_SIZE      5
 /// Default number of read operations.  This can be overridden in the .cdef.
 #define DEFAULT_READ_OPERATION_POOL_SIZE    2
 
+/// Minimum interval (ms) between runs of the timer that drops samples older than an Observation's
+/// maximum age.  Samples may be kept up to this much longer than the maximum age between pushes.
+#define RETENTION_TIMER_MIN_MS 1000
+
+/// Smallest sample buffer ring capacity, as a power of 2.
+#define MIN_RING_CAPACITY_BITS  2
+/// Largest sample buffer ring capacity, as a power of 2.
+#define MAX_RING_CAPACITY_BITS  24
+/// Number of sample buffer ring size classes (one memory pool per power of 2).
+#define RING_POOL_COUNT (MAX_RING_CAPACITY_BITS - MIN_RING_CAPACITY_BITS + 1)
+
+/// Number of bytes of a ring buffer block per slot: a timestamp, a value and a slot number in each
+/// of the minimum and maximum deques.
+#define RING_SLOT_BYTES (sizeof(double) + sizeof(BufferValue_t) + (2 * sizeof(uint32_t)))
+
+/// Number of bytes of a ring of compressed blocks per slot: a block pointer and a slot number in
+/// each of the minimum and maximum block deques.
+#define BLOCK_RING_SLOT_BYTES (sizeof(CompressedBlock_t*) + (2 * sizeof(uint32_t)))
+
+/// Number of bytes of a range statistics index per ring buffer slot (a leaf and an inner node).
+#define INDEX_SLOT_BYTES (2 * sizeof(RangeStats_t))
+
+/// Time spans covering no more than this many buffered samples are scanned rather than looked up
+/// in the range statistics index, so that queries over short spans never force it to be built.
+#define INDEX_SCAN_THRESHOLD    32
+
+/// When the buffer memory budget is exceeded, samples are evicted until the buffers use no more
+/// than the budget less this fraction of it (1/N), so that it isn't exceeded again on every push.
+#define BUFFER_BUDGET_LOW_WATER_DIVISOR 16
+
+
+/// Value of a buffered data sample.  Trigger, Boolean and numeric values are stored inline
+/// (Booleans as 0 or 1, triggers have no value); string and JSON values are stored as a reference
+/// to the Data Sample object holding the string.
+typedef union
+{
+    double number;              ///< Numeric value, or 1.0/0.0 for Boolean true/false.
+    dataSample_Ref_t sampleRef; ///< String or JSON Data Sample (holds a reference).
+}
+BufferValue_t;
+
+/// Double-ended queue of ring buffer slot numbers, itself stored as a ring with the same capacity
+/// as the sample buffer.  Used to keep track of the minimum and maximum buffered values.
+typedef struct
+{
+    uint32_t* slots;    ///< Ring of sample buffer slot numbers.
+    size_t head;        ///< Position of the front of the queue in the slots ring.
+    size_t len;         ///< Number of slot numbers in the queue.
+}
+SlotDeque_t;
+
+/// Statistics summarizing the (non-NAN) numerical values in a span of an Observation's buffer.
+/// Also used as the node type of the range statistics index.
+typedef struct
+{
+    size_t count;   ///< Number of values (0 if none, in which case the other fields are unused).
+    double mean;    ///< Mean of the values.
+    double m2;      ///< Sum of squared differences from the mean.
+    double min;     ///< Smallest value.
+    double max;     ///< Largest value.
+}
+RangeStats_t;
+
+/// Block of compressed numerical samples in an Observation's buffer.  Allocated from the
+/// Compressed Block Pool.
+typedef struct
+{
+    uint64_t firstSeq;          ///< Sequence number of the first sample appended to the block.
+    double lastTimestamp;       ///< Timestamp of the newest sample in the block.
+    double lastValue;           ///< Value of the newest sample in the block.
+    RangeStats_t stats;         ///< Statistics over all the values appended to the block.
+    sampleBlock_Block_t data;   ///< The compressed samples.
+}
+CompressedBlock_t;
+
 /// Observation Resource.  Allocated from the Observation Pool.
 typedef struct
 {
@@ -87,13 +322,95 @@ typedef struct
     size_t maxCount;  ///< Maximum number of entries to buffer.
     size_t count;     ///< Current number of entries in the buffer.
 
+    double maxAge;    ///< Maximum age (seconds) of buffered samples; NAN = no limit.
+    size_t maxBytes;  ///< Maximum memory (bytes) used by buffered samples; 0 = no limit.
+    size_t bytes;     ///< Memory (bytes) allocated for the buffer (see ChargeBufferMemory()).
+    le_timer_Ref_t retentionTimer; ///< Timer used to drop samples when they get too old, or NULL.
+
+    int32_t priority;       ///< Higher = samples kept longer when over the hub's memory budget.
+    uint64_t evictionCount; ///< Number of samples dropped to stay within the hub's memory budget.
+    le_dls_Link_t link;     ///< Used to link into the list of all Observations.
+
+    size_t capacity;  ///< Number of slots in the ring buffer (power of 2, 0 if not allocated).
+    size_t head;      ///< Ring buffer slot holding the oldest buffered sample.
+    uint64_t headSeq; ///< Sequence number of the oldest buffered sample.
+    double* timestamps;     ///< Ring of sample timestamps (oldest at head), or NULL.
+    BufferValue_t* values;  ///< Ring of sample values, parallel to timestamps, or NULL.
+
+    // Running statistics over the (non-NAN) numerical values in the buffer, kept up to date as
+    // samples are added and dropped so that whole-buffer queries and transforms are O(1).
+    size_t statCount;       ///< Number of numerical values in the buffer.
+    double statMean;        ///< Mean of the numerical values in the buffer.
+    double statM2;          ///< Sum of squared differences from the mean (Welford's method).
+    size_t statRemovals;    ///< Values removed since statMean and statM2 were last recomputed.
+    SlotDeque_t minDeque;   ///< Slots of samples that may become the minimum (front = minimum).
+    SlotDeque_t maxDeque;   ///< Slots of samples that may become the maximum (front = maximum).
+
+    /// Range statistics index: a segment tree over the ring buffer slots (node 1 is the root and
+    /// slot N's leaf is node capacity + N), or NULL if not built.  Built by the first query over
+    /// part of the buffer, then kept up to date as samples are added and dropped.
+    RangeStats_t* index;
+
+    // Compressed storage, used instead of the ring buffer for numeric and Boolean samples if
+    // compression is enabled.  Samples are appended to the newest block and dropped from the
+    // oldest, which is released once all its samples have been dropped.
+    bool compress;          ///< true if numerical samples are to be stored compressed.
+    bool isCompressed;      ///< true if the buffered samples are stored compressed (not in ring).
+    CompressedBlock_t** blocks; ///< Ring of compressed blocks (oldest at blockHead), or NULL.
+    size_t blockCapacity;   ///< Number of slots in the ring of blocks (power of 2, or 0).
+    size_t blockHead;       ///< Slot holding the oldest block.
+    size_t blockCount;      ///< Number of blocks in the ring.
+    sampleBlock_Cursor_t headCursor;    ///< Position after the oldest sample in the oldest block.
+    double headTimestamp;   ///< Timestamp of the oldest buffered sample.
+    double headValue;       ///< Value of the oldest buffered sample.
+
+    // The running mean and variance of a compressed buffer are kept in statCount, statMean and
+    // statM2.  Its minimum and maximum come from deques of the blocks after the oldest (whose
+    // statistics are complete), along with those of the values left in the oldest block.
+    SlotDeque_t blockMinDeque;  ///< Block ring slots of blocks that may hold the minimum.
+    SlotDeque_t blockMaxDeque;  ///< Block ring slots of blocks that may hold the maximum.
+    double headBlockMin;    ///< Smallest value left in the oldest block (NAN if none).
+    double headBlockMax;    ///< Largest value left in the oldest block (NAN if none).
+    bool headBlockStale;    ///< true = headBlockMin and headBlockMax must be recomputed.
+    CompressedBlock_t* cacheBlockPtr;   ///< Block last decoded for random access, or NULL.
+    sampleBlock_Cursor_t cacheCursor;   ///< Position after the sample last decoded from it.
+    double cacheTimestamp;  ///< Timestamp of the sample last decoded from cacheBlockPtr.
+    double cacheValue;      ///< Value of the sample last decoded from cacheBlockPtr.
+
     io_DataType_t bufferedType; ///< Data type of samples currently in the buffer.
 
     uint32_t backupPeriod; ///< Min time (in seconds) between non-volatile backups of the buffer.
     uint32_t lastBackupTime; ///< Time at which last push was accepted (seconds, relative clock).
-    le_timer_Ref_t backupTimer; ///< Reference to the timer used to trigger the next backup.
-
-    le_sls_List_t sampleList; ///< Queue of buffered data samples (oldest first, newest last).
+    le_dls_Link_t backupLink;   ///< Link in the backup wheel slot or due list, if scheduled.
+    le_dls_List_t* backupListPtr;   ///< List holding backupLink, or NULL if not scheduled.
+    uint32_t backupDueTime; ///< Time at which the next backup is due (seconds, relative clock).
+
+    // Backup log (see the top of this file), used instead of rewriting the backup file each time
+    // if backupLog is true.
+    bool backupLog;         ///< true = back up by appending to a log.
+    bool hasLog;            ///< true if there may be backup log segment files.
+    bool logNeedsBase;      ///< true = the next backup to the log must start it with a new base.
+    uint32_t logGeneration; ///< Generation number of the log's base.
+    uint32_t logSegment;    ///< Number of the log's newest segment.
+    size_t logSegmentBytes; ///< Size (bytes) of the log's newest segment file.
+    size_t logBaseBytes;    ///< Size (bytes) of the log's base segment file.
+    size_t logAppendedBytes;///< Size (bytes) of the log's segment files, not counting the base.
+    uint64_t logNextSeq;    ///< Sequence number of the next sample to be appended to the log.
+
+    struct BackupJob* backupJobPtr; ///< Backup being written by the writer thread, or NULL.
+    bool backupPending;     ///< true = back up again when the backup being written is done.
+    bool isPacked;          ///< true if the backup pack may hold a backup of the buffer.
+    bool restorePending;    ///< true = only the newest sample has been restored from the backup.
+
+    // Where the copy of the buffer in the last State Segment image is, and what it holds, so that
+    // it can be reused if the buffer hasn't changed (see obs_AppendBufferToImage()).  Samples are
+    // never changed once buffered, so the sequence numbers of the oldest and newest say it all.
+    uint32_t stateImage;    ///< Number of the image holding the copy (0 = none).
+    size_t stateOffset;     ///< Offset of the copy in the image.
+    size_t stateBytes;      ///< Size of the copy, in bytes.
+    uint64_t stateHeadSeq;  ///< Sequence number of the oldest sample in the copy.
+    size_t stateSampleCount;///< Number of samples in the copy.
+    uint8_t stateTypeCode;  ///< Data type code of the copy (see GetDataTypeCode()).
 
     le_dls_List_t readOpList; ///< List of ongoing Read Operations on the buffered samples.
 
@@ -104,23 +421,31 @@ Observation_t;
 
 
 
-/// Object used to link a Data Sample into an Observation's buffer.
-/// Holds a reference on the Data Sample object.
-typedef struct
-{
-    le_sls_Link_t link;  ///< Used to link into a Observation's sampleList.
-    dataSample_Ref_t sampleRef; ///< Reference to the Data Sample object.
-}
-BufferEntry_t;
-
-
 /// Each data sample in a read operation looks like the following:
 /// {"t":1537483647.125371,"v":true}
 /// The largest value is IO_MAX_STRING_VALUE_LEN bytes long.
 /// The timestamp is a double-precision floating point number. Doubles can be
 /// hundreds of bytes long if the maximum precision is used in non-scientific notation,
 /// but in this case they typically won't be more than 6 decimal places.
-#define READ_OP_BUFF_BYTES (HUB_MAX_STRING_BYTES + 48)
+#define READ_OP_SAMPLE_MAX_BYTES (HUB_MAX_STRING_BYTES + 48)
+
+/// Minimum size of a read operation's write buffer.  As many samples as fit are staged in the
+/// buffer and written out with a single write(), so this must hold a good number of samples even
+/// on targets that have a small maximum string value length.
+#define READ_OP_MIN_BUFF_BYTES 4096
+
+/// Size of a read operation's write buffer.  Must be able to hold at least one sample.
+#define READ_OP_BUFF_BYTES ((READ_OP_SAMPLE_MAX_BYTES > READ_OP_MIN_BUFF_BYTES) ? \
+                                READ_OP_SAMPLE_MAX_BYTES : READ_OP_MIN_BUFF_BYTES)
+
+/// Number of bytes before the timestamps in a buffer exported to shared memory (version, data type
+/// code, two bytes of padding and the sample count).  Keeps the arrays of doubles aligned.
+#define EXPORT_HEADER_BYTES 8
+
+/// Largest fixed-size part of a sample record in a backup file or binary read operation
+/// (a timestamp followed by a numeric value).
+#define RECORD_HEAD_MAX_BYTES (sizeof(double) + sizeof(double))
+
 
 
 //--------------------------------------------------------------------------------------------------
@@ -134,10 +459,20 @@ typedef struct
     Observation_t* obsPtr;  ///< Ptr to Observation whose buffer is being read.
     le_fdMonitor_Ref_t fdMonitor; ///< Used to get notification when the FD is clear to write.
     int fd; ///< fd to write to.
-    BufferEntry_t* nextEntryPtr; ///< Buff entry to load into write buff next (ref counted).
-    enum { START, SAMPLE, COMMA, END } state; ///< What are we supposed to write next?
-    char writeBuffer[READ_OP_BUFF_BYTES];  ///< Buffer currently being written.
-    size_t writeLen; ///< Number of characters (excl. null terminator) in the writeBuffer.
+    uint64_t nextSeq; ///< Sequence number of the buffered sample to load into write buff next.
+    uint64_t endSeq;  ///< Sequence number after the last sample to read (UINT64_MAX = the newest,
+                      ///< even if it was added after the read started).
+    uint64_t* selectedSeqs; ///< Sequence numbers of the only samples to read (oldest first), or
+                            ///< NULL to read every sample from nextSeq on.
+    size_t selectedCount;   ///< Number of entries in selectedSeqs.
+    size_t nextSelected;    ///< Index into selectedSeqs of the sample to load next.
+    bool isBinary;  ///< true = packed binary records, false = JSON.
+    io_DataType_t dataType; ///< Type of the buffered samples when the read started.
+    enum { START, SAMPLE, END } state; ///< What are we supposed to stage next?
+    le_result_t result; ///< Result to report to the completion callback when the read ends.
+    bool isFirstSample; ///< true if no sample has been staged yet (no JSON separator needed).
+    char writeBuffer[READ_OP_BUFF_BYTES];  ///< Staging buffer currently being written.
+    size_t writeLen; ///< Number of bytes staged in the writeBuffer.
     size_t writeOffset;   ///< Offset into the writeBuffer to write from next.
     query_ReadCompletionFunc_t handlerPtr; ///< Completion callback.
     void* contextPtr;   ///< Value to be passed to completion callback.
@@ -145,13 +480,238 @@ typedef struct
 ReadOperation_t;
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Progress of the replay of an Observation's backup log into its buffer.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    bool started;       ///< true once the first frame has been replayed.
+    bool ownsMaxCount;  ///< true = raise the buffer's maximum count to fit the replayed samples.
+    uint64_t nextSeq;   ///< Sequence number (in the log) of the next sample expected.
+    dataSample_Ref_t newestRef; ///< Newest sample replayed (not yet added to the buffer), or NULL.
+}
+LogReplay_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Kinds of work done on backup files by the Backup Writer's thread.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef enum
+{
+    BACKUP_JOB_FILE,        ///< Replace the backup file (deleting the backup log first, if asked).
+    BACKUP_JOB_LOG_BASE,    ///< Write a new base for the backup log, then delete the rest.
+    BACKUP_JOB_LOG_SEGMENT, ///< Create a new segment of the backup log.
+    BACKUP_JOB_LOG_APPEND,  ///< Append to the newest segment of the backup log.
+    BACKUP_JOB_DELETE,      ///< Delete the backup file and backup log.
+    BACKUP_JOB_PACK,        ///< Put the backup into the backup pack (then delete the file/log).
+}
+BackupJobType_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Ways of restoring an Observation's buffer from a backup.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef enum
+{
+    RESTORE_EAGER,      ///< Load all the samples and push the newest to become the current value.
+    RESTORE_LAZY,       ///< Only push the newest sample, if the rest can be loaded later.
+    RESTORE_DEFERRED,   ///< Load all the samples, the newest of which is already current.
+}
+RestoreMode_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Record used for keeping track of work submitted to the Backup Writer.
+ *
+ * Only the isOk field is touched by the writer thread once the job has been submitted.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct BackupJob
+{
+    le_dls_Link_t link;     ///< Used to link into a batch of jobs.
+    le_dls_Link_t outstandingLink; ///< Used to link into the OutstandingBackupJobs list.
+    bool isOutstanding;     ///< true = in the OutstandingBackupJobs list.
+    BackupJobType_t type;
+    Observation_t* obsPtr;  ///< Observation backed up, or NULL if none (any more).
+    backupWriter_ImageRef_t imageRef;   ///< Contents to write, or NULL if deleting.
+    uint32_t segment;       ///< Number of the backup log segment to write.
+    uint32_t crc;           ///< CRC-32 of the image (BACKUP_JOB_PACK only).
+    uint64_t writerSeq;     ///< Backup Writer sequence number of the job's batch, once submitted.
+    bool deleteLog;         ///< true = delete the backup log before writing the backup file (or
+                            ///<        once the backup is in the backup pack).
+    bool deleteFile;        ///< true = delete the backup file once the backup is in the pack.
+    bool dropFromPack;      ///< true = take the backup out of the pack once written elsewhere.
+    bool isOk;              ///< Set by the writer thread: true if the job was successful.
+    char backupPath[MAX_BACKUP_FILE_PATH_BYTES]; ///< Path of the Observation's backup file.
+}
+BackupJob_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Batch of backup jobs submitted to the Backup Writer together.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_dls_List_t jobList;  ///< Jobs, in the order they are to be done.
+}
+BackupBatch_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Index entry for an Observation's backup in the backup pack.
+ *
+ * Pack entries are changed by the Backup Writer's thread and read by the main thread, both only
+ * while holding the PackMutex.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_dls_Link_t link;     ///< Used to link into the PackEntryList.
+    uint32_t offset;        ///< Offset of the backup in the pack file.
+    uint32_t length;        ///< Size (bytes) of the backup in the pack file (0 = not in it yet).
+    uint32_t crc;           ///< CRC-32 of the backup in the pack file.
+    uint32_t newOffset;     ///< Offset of the backup in the pack file being written.
+    BackupJob_t* jobPtr;    ///< Job holding the backup's new contents, or NULL if unchanged.
+    bool isRemoved;         ///< true = leave the backup out of the pack file being written.
+    char path[MAX_BACKUP_FILE_PATH_BYTES]; ///< Path of the Observation's backup file.
+}
+PackEntry_t;
+
+
+/// Observation whose buffer samples may be evicted from to stay within the buffer memory budget.
+typedef struct
+{
+    Observation_t* obsPtr;  ///< The Observation.
+    double oldest;          ///< Timestamp of the oldest sample in its buffer.
+}
+EvictionCandidate_t;
+
+
 /// Pool of Observation objects.
 static le_mem_PoolRef_t ObservationPool = NULL;
 LE_MEM_DEFINE_STATIC_POOL(ObservationPool, DEFAULT_OBSERVATION_POOL_SIZE, sizeof(Observation_t));
 
-/// Pool of Buffer Entry objects.
-static le_mem_PoolRef_t BufferEntryPool = NULL;
-LE_MEM_DEFINE_STATIC_POOL(BufferEntryPool, DEFAULT_BUFFER_ENTRY_POOL_SIZE, sizeof(BufferEntry_t));
+/// Pools of sample buffer rings, one per power-of-2 capacity.  Created when first needed.
+static le_mem_PoolRef_t RingPools[RING_POOL_COUNT];
+
+/// Pools of range statistics indexes, one per power-of-2 ring capacity.  Created when first needed.
+static le_mem_PoolRef_t IndexPools[RING_POOL_COUNT];
+
+/// Pools of sample selections for downsampled read operations, one per power-of-2 size.
+static le_mem_PoolRef_t SelectionPools[RING_POOL_COUNT];
+
+/// Pools of compressed block rings, one per power-of-2 capacity.  Created when first needed.
+static le_mem_PoolRef_t BlockRingPools[RING_POOL_COUNT];
+
+/// Pools of buffer eviction candidate heaps, one per power-of-2 number of Observations.  Created
+/// when first needed.
+static le_mem_PoolRef_t EvictionPools[RING_POOL_COUNT];
+
+/// Pool of compressed sample blocks.  Created when first needed.
+static le_mem_PoolRef_t CompressedBlockPool = NULL;
+
+/// List of all Observations, used to find the buffers to evict samples from when the hub is over
+/// its buffer memory budget.
+static le_dls_List_t ObservationList = LE_DLS_LIST_INIT;
+
+/// Number of Observations in the ObservationList.
+static size_t ObservationCount = 0;
+
+/// Maximum number of bytes of memory that the buffers of all Observations can use (counted the
+/// same way as an Observation's maximum number of bytes); 0 = no limit.
+static size_t BufferBudget = 0;
+
+/// Number of bytes of memory allocated for the buffers of all Observations.
+static size_t BufferedBytes = 0;
+
+/// Number of samples dropped from all Observations' buffers to stay within the memory budget.
+static uint64_t EvictionCount = 0;
+
+/// Pool of backup jobs.
+static le_mem_PoolRef_t BackupJobPool = NULL;
+
+/// Pool of backup job batches.
+static le_mem_PoolRef_t BackupBatchPool = NULL;
+
+/// Backup jobs waiting to be submitted to the Backup Writer as a batch.
+static le_dls_List_t PendingBackupJobs = LE_DLS_LIST_INIT;
+
+/// Backup jobs submitted to the Backup Writer that may not have been written yet.
+static le_dls_List_t OutstandingBackupJobs = LE_DLS_LIST_INIT;
+
+/// Backup timer wheel.  Each slot holds the Observations whose next backups are due at times
+/// (in seconds) equal to the slot's index, modulo the number of slots.
+static le_dls_List_t BackupWheel[BACKUP_WHEEL_SLOTS];
+
+/// Observations whose backups are due, but haven't been done yet (oldest due first).
+static le_dls_List_t DueBackupList = LE_DLS_LIST_INIT;
+
+/// Number of Observations with backups scheduled (in the wheel or the due list).
+static size_t ScheduledBackupCount = 0;
+
+/// Timer that ticks the backup wheel every second while any backups are scheduled.
+static le_timer_Ref_t BackupTickTimer = NULL;
+
+/// Time of the backup wheel's last tick (seconds, relative clock).
+static uint32_t LastBackupTick = 0;
+
+/// Maximum number of bytes that backups can write to flash per hour; 0 = no limit.
+static uint32_t BackupWriteBudget = 0;
+
+/// Number of bytes that backups can still write before exceeding the budget (negative if a backup
+/// bigger than what was left has overdrawn it).
+static double BackupWriteAllowance = 0;
+
+/// true = back up buffers (other than those backed up to a log) into the backup pack.
+static bool BackupPacked = false;
+
+/// true = restore only the newest sample of each buffer at first, leaving the rest until needed.
+static bool BackupLazyRestore = false;
+
+/// true = Observations being created don't restore their buffers from their backups, as newer
+/// copies of the buffers are about to be restored from memory (see obs_SkipBackupRestore()).
+static bool BackupRestoreSkipped = false;
+
+/// Pool of backup pack index entries.
+static le_mem_PoolRef_t PackEntryPool = NULL;
+
+/// Mutex held by whichever thread is using the backup pack's index or file (the variables below).
+/// The Backup Writer's thread holds it while it changes or writes the pack, so the main thread
+/// waits for that only when it needs the pack itself.  Recursive, as restoring a buffer from the
+/// pack pushes its newest sample, which may finish restoring another buffer.
+static le_mutex_Ref_t PackMutex = NULL;
+
+/// Index of the backup pack (list of PackEntry_t), in pack file order.
+static le_dls_List_t PackEntryList = LE_DLS_LIST_INIT;
+
+/// Index entry last found by FindPackEntry(), or NULL.  Backups are usually restored in the order
+/// they are in the pack, so searching on from there usually finds the next one straight away.
+static le_dls_Link_t* PackCursorPtr = NULL;
+
+/// true once the backup pack's index has been loaded from the pack file (if there is one).
+static bool PackIsLoaded = false;
+
+/// true = the backup pack's index has changed since the pack file was written.
+static bool PackIsDirty = false;
+
+/// Backup pack file, opened for reading, or NULL if not open.
+static FILE* PackFile = NULL;
+
+/// Backup pack file contents, mapped into memory for restoring from (NULL if not mapped).
+static const uint8_t* PackMapPtr = NULL;
+
+/// Number of bytes of the backup pack file mapped at PackMapPtr.
+static size_t PackMapSize = 0;
 
 /// Pool to allocate ReadOperation_t object from.
 static le_mem_PoolRef_t ReadOperationPool = NULL;
@@ -225,1663 +785,7354 @@ static le_result_t GetBackupFilePath
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Delete the observation's buffer backup file, if it exists.
+ * Get the file system path of a given segment of the backup log for an Observation's data sample
+ * buffer.
+ *
+ * @return LE_OK if successful, LE_OVERFLOW if the buffer is too small.
  */
 //--------------------------------------------------------------------------------------------------
-static void DeleteBackup
+static le_result_t GetBackupLogFilePath
 (
-    Observation_t* obsPtr
+    char* pathBuffPtr,      ///< [OUT] Ptr to where the path will be written.
+    size_t pathBuffSize,    ///< Size of the buffer in bytes.
+    const char* backupPath, ///< Path of the Observation's backup file (see GetBackupFilePath()).
+    uint32_t segment        ///< Segment number.
 )
 //--------------------------------------------------------------------------------------------------
 {
-    char path[HUB_MAX_RESOURCE_PATH_BYTES];
-    le_result_t result = GetBackupFilePath(path, sizeof(path), obsPtr);
-    if (result == LE_OK)
+    int stemLen = (int)(strlen(backupPath) - BACKUP_SUFFIX_LEN);
+
+    int len = snprintf(pathBuffPtr,
+                       pathBuffSize,
+                       "%.*s" BACKUP_LOG_SUFFIX "%" PRIu32,
+                       stemLen,
+                       backupPath,
+                       segment);
+    if ((len < 0) || ((size_t)len >= pathBuffSize))
     {
-        unlink(path);
+        LE_CRIT("Backup log path too long for '%s'.", backupPath);
+        return LE_OVERFLOW;
     }
+
+    return LE_OK;
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Buffer Entry destructor.
+ * Delete the segment files of an observation's buffer backup log, from a given segment onwards.
  */
 //--------------------------------------------------------------------------------------------------
-static void BufferEntryDestructor
+static void DeleteBackupLog
 (
-    void* objectPtr
+    const char* backupPath, ///< Path of the Observation's backup file (see GetBackupFilePath()).
+    uint32_t firstSegment   ///< Number of the first segment to delete.
 )
 //--------------------------------------------------------------------------------------------------
 {
-    BufferEntry_t* buffEntryPtr = objectPtr;
+    // Segments are normally numbered consecutively, but a clean-up that was interrupted part way
+    // through can leave gaps, so try every segment number.
+    for (uint32_t segment = firstSegment; segment < BACKUP_LOG_MAX_SEGMENTS; segment++)
+    {
+        char path[MAX_BACKUP_LOG_FILE_PATH_BYTES];
+        if (GetBackupLogFilePath(path, sizeof(path), backupPath, segment) != LE_OK)
+        {
+            return;
+        }
 
-    le_mem_Release(buffEntryPtr->sampleRef);
+        if ((unlink(path) != 0) && (errno != ENOENT))
+        {
+            LE_CRIT("Failed to delete '%s' (%m).", path);
+        }
+    }
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Terminate a read operation.
+ * Get the number of zero bytes needed after a given number of bytes of a backup file (or backup
+ * pack file) to reach the start of the next record (or backup).
+ *
+ * @return The number of bytes of padding.
  */
 //--------------------------------------------------------------------------------------------------
-static void EndRead
+static size_t GetBackupPadding
 (
-    ReadOperation_t* opPtr,
-    le_result_t result
+    size_t byteCount
 )
 //--------------------------------------------------------------------------------------------------
 {
-    if (opPtr->nextEntryPtr != NULL)
-    {
-        le_mem_Release(opPtr->nextEntryPtr);
-        opPtr->nextEntryPtr = NULL;
-    }
-
-    le_fdMonitor_Delete(opPtr->fdMonitor);
-
-    close(opPtr->fd);
-
-    opPtr->handlerPtr(result, opPtr->contextPtr);
-
-    le_dls_Remove(&opPtr->obsPtr->readOpList, &opPtr->link);
-
-    le_mem_Release(opPtr);
+    return (BACKUP_RECORD_ALIGN - (byteCount % BACKUP_RECORD_ALIGN)) % BACKUP_RECORD_ALIGN;
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Observation destructor.
+ * Map the whole of a file, opened for reading, into memory.  Where mmap() is not available, the
+ * file is read into an allocated buffer instead.
+ *
+ * @return Pointer to the file's contents, or NULL if failed (or the file is empty).
  */
 //--------------------------------------------------------------------------------------------------
-static void ObservationDestructor
+static const uint8_t* MapFile
 (
-    void* objectPtr
+    FILE* file,
+    size_t* sizePtr     ///< [OUT] Number of bytes mapped.
 )
 //--------------------------------------------------------------------------------------------------
 {
-    Observation_t* obsPtr = objectPtr;
+    *sizePtr = 0;
 
-    // Delete all the buffered data samples.
-    le_sls_Link_t* linkPtr;
-    while (NULL != (linkPtr = le_sls_Pop(&obsPtr->sampleList)))
+    struct stat st;
+    if (fstat(fileno(file), &st) != 0)
     {
-        BufferEntry_t* buffEntryPtr = CONTAINER_OF(linkPtr, BufferEntry_t, link);
-
-        le_mem_Release(buffEntryPtr);
+        LE_CRIT("Failed to get file size (%m).");
+        return NULL;
+    }
+    if (st.st_size <= 0)
+    {
+        return NULL;
     }
 
-    obsPtr->count = 0;
-    obsPtr->maxCount = 0;
-
-    // If the observation had backups enabled, delete the backup file.
-    if (obsPtr->backupPeriod > 0)
+#if LE_CONFIG_LINUX
+    void* mapPtr = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fileno(file), 0);
+    if (mapPtr == MAP_FAILED)
     {
-        DeleteBackup(obsPtr);
+        LE_CRIT("Failed to map file (%m).");
+        return NULL;
     }
 
-    // If there are read operations in progress, end them.
-    while (le_dls_IsEmpty(&obsPtr->readOpList) == false)
+    // The file is read through once, from start to end.
+    (void)madvise(mapPtr, st.st_size, MADV_SEQUENTIAL);
+#else
+    uint8_t* mapPtr = malloc(st.st_size);
+    if (mapPtr == NULL)
     {
-        EndRead(CONTAINER_OF(le_dls_Peek(&obsPtr->readOpList), ReadOperation_t, link),
-                LE_COMM_ERROR);
+        LE_CRIT("Out of memory for %zu byte file.", (size_t)st.st_size);
+        return NULL;
+    }
+    if (   (fseek(file, 0, SEEK_SET) != 0)
+        || (fread(mapPtr, 1, st.st_size, file) != (size_t)st.st_size)  )
+    {
+        LE_CRIT("Failed to read file (%m).");
+        free(mapPtr);
+        return NULL;
     }
+#endif
 
-    res_Destruct(&obsPtr->resource);
+    *sizePtr = st.st_size;
+
+    return mapPtr;
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Get the first (oldest) buffer entry in an Observation's data sample buffer.
- *
- * @return Pointer to the buffer entry or NULL if the buffer is empty.
+ * Unmap a file mapped by MapFile().
  */
 //--------------------------------------------------------------------------------------------------
-static BufferEntry_t* GetOldestBufferEntry
+static void UnmapFile
 (
-    Observation_t* obsPtr
+    const uint8_t* mapPtr,
+    size_t size
 )
 //--------------------------------------------------------------------------------------------------
 {
-    le_sls_Link_t* linkPtr = le_sls_Peek(&obsPtr->sampleList);
+#if LE_CONFIG_LINUX
+    munmap((void*)mapPtr, size);
+#else
+    free((void*)mapPtr);
+#endif
+}
 
-    if (linkPtr != NULL)
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Close the backup pack file, if it is open for reading, and unmap it, if it is mapped.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ClosePackFile
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (PackMapPtr != NULL)
     {
-        return CONTAINER_OF(linkPtr, BufferEntry_t, link);
+        UnmapFile(PackMapPtr, PackMapSize);
+        PackMapPtr = NULL;
+        PackMapSize = 0;
     }
-    else
+
+    if (PackFile != NULL)
     {
-        return NULL;
+        fclose(PackFile);
+        PackFile = NULL;
     }
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Get the next (newer) buffer entry in an Observation's data sample buffer.
+ * Get the backup pack file, opened for reading.
  *
- * @return A pointer to the buffer entry, or NULL if there are no newer samples in the buffer.
+ * @return The file, or NULL if there is none (or it couldn't be opened).
  */
 //--------------------------------------------------------------------------------------------------
-static BufferEntry_t* GetNextBufferEntry
+static FILE* OpenPackFile
 (
-    Observation_t* obsPtr,
-    BufferEntry_t* buffEntryPtr
+    void
 )
 //--------------------------------------------------------------------------------------------------
 {
-    le_sls_Link_t* linkPtr = le_sls_PeekNext(&obsPtr->sampleList, &buffEntryPtr->link);
-
-    if (linkPtr != NULL)
-    {
-        return CONTAINER_OF(linkPtr, BufferEntry_t, link);
-    }
-    else
+    if (PackFile == NULL)
     {
-        return NULL;
+        PackFile = fopen(BACKUP_PACK_PATH, "rb");
+        if ((PackFile == NULL) && (errno != ENOENT))
+        {
+            LE_CRIT("Unable to open '" BACKUP_PACK_PATH "' for reading (%m).");
+        }
     }
+
+    return PackFile;
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Load the write buffer with a JSON representation of the next sample to be read.
+ * Create a backup pack index entry and add it to the end of the index.
  *
- * @return true if successful, false if there are no more samples.
+ * @return Pointer to the entry.
  */
 //--------------------------------------------------------------------------------------------------
-static bool LoadReadOpBuffer
+static PackEntry_t* CreatePackEntry
 (
-    ReadOperation_t* opPtr
+    const char* backupPath  ///< Path of the Observation's backup file (see GetBackupFilePath()).
 )
 //--------------------------------------------------------------------------------------------------
 {
-    opPtr->writeLen = 0;
-    opPtr->writeOffset = 0;
-    opPtr->writeBuffer[0] = '\0';
+    PackEntry_t* entryPtr = le_mem_ForceAlloc(PackEntryPool);
 
-    do
-    {
-        if (opPtr->nextEntryPtr == NULL)
-        {
-            return false;
-        }
-
-        // If the buffer entry's ref count should be 2.  If it is only 1, then we know it has
-        // fallen off the end of the observation's buffer, which means that all entries in the
-        // observation's buffer are now newer than this one.
-        if (le_mem_GetRefCount(opPtr->nextEntryPtr) == 1)
-        {
-            le_mem_Release(opPtr->nextEntryPtr);
-            opPtr->nextEntryPtr = GetOldestBufferEntry(opPtr->obsPtr);
-            if (opPtr->nextEntryPtr != NULL)
-            {
-                le_mem_AddRef(opPtr->nextEntryPtr);
-            }
-            else
-            {
-                return false;
-            }
-        }
-
-        int len = snprintf(opPtr->writeBuffer,
-                           sizeof(opPtr->writeBuffer),
-                           "{\"t\":%lf,\"v\":",
-                           dataSample_GetTimestamp(opPtr->nextEntryPtr->sampleRef));
-        if (len >= (int) sizeof(opPtr->writeBuffer))
-        {
-            LE_CRIT("Buffer overflow. Skipping entry.");
-            // Leave the writeLen 0 so we'll loop around and try the next sample.
-        }
-        else
-        {
-            // Copy the JSON version of the contents of the current buffer entry's data into
-            // the write buffer, if there's space (leaving room for an additional '}' at the end).
-            le_result_t result = dataSample_ConvertToJson(opPtr->nextEntryPtr->sampleRef,
-                                                          res_GetDataType(&(opPtr->obsPtr->resource)),
-                                                          opPtr->writeBuffer + len,
-                                                          sizeof(opPtr->writeBuffer) - len - 1);
-            if (result != LE_OK)
-            {
-                LE_ERROR("JSON value doesn't fit in write buffer. Skipping.");
-                // Leave the writeLen 0 so we'll loop around and try the next sample.
-            }
-            else
-            {
-                len += strlen(opPtr->writeBuffer + len);
-
-                opPtr->writeBuffer[len] = '}';
-                opPtr->writeBuffer[len + 1] = '\0';
-
-                opPtr->writeLen = len + 1;
-            }
-        }
-
-        // Advance the nextEntryPtr to the next entry in the Observation's data sample list.
-        BufferEntry_t* nextEntryPtr = GetNextBufferEntry(opPtr->obsPtr, opPtr->nextEntryPtr);
-        le_mem_Release(opPtr->nextEntryPtr);
-
-        if (nextEntryPtr != NULL)
-        {
-            opPtr->nextEntryPtr = nextEntryPtr;
-            le_mem_AddRef(nextEntryPtr);
-        }
-        else
-        {
-            opPtr->nextEntryPtr = NULL;
-        }
+    entryPtr->link = LE_DLS_LINK_INIT;
+    entryPtr->offset = 0;
+    entryPtr->length = 0;
+    entryPtr->crc = 0;
+    entryPtr->newOffset = 0;
+    entryPtr->jobPtr = NULL;
+    entryPtr->isRemoved = false;
+    LE_ASSERT(le_utf8_Copy(entryPtr->path, backupPath, sizeof(entryPtr->path), NULL) == LE_OK);
 
-    } while (opPtr->writeLen == 0); // Loop if the write buffer is still empty.
+    le_dls_Queue(&PackEntryList, &entryPtr->link);
 
-    return true;
+    return entryPtr;
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Write to an unbuffered file descriptor.
- *
- * @return The number of bytes written.  -1 on error (errno is set).
+ * Delete a backup pack index entry.
  */
 //--------------------------------------------------------------------------------------------------
-static ssize_t WriteToFd
+static void DeletePackEntry
 (
-    int fd,
-    const void* buffPtr,
-    size_t byteCount
+    PackEntry_t* entryPtr
 )
 //--------------------------------------------------------------------------------------------------
 {
-    ssize_t result;
-
-    LE_ASSERT(buffPtr != NULL);
-
-    do
+    if (PackCursorPtr == &entryPtr->link)
     {
-        result = write(fd, buffPtr, byteCount);
-
-    } while ((result == -1) && (errno == EINTR));
+        PackCursorPtr = NULL;
+    }
 
-    return result;
+    le_dls_Remove(&PackEntryList, &entryPtr->link);
+    le_mem_Release(entryPtr);
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Continue a read operation.
+ * Load the backup pack's index from the pack file, if not loaded already.  A damaged pack file is
+ * deleted, as none of its backups can be found without the index.
  */
 //--------------------------------------------------------------------------------------------------
-static void ContinueReadOp
+static void LoadPackIndex
 (
-    ReadOperation_t* opPtr
+    void
 )
 //--------------------------------------------------------------------------------------------------
 {
-    ssize_t result;
-    for (;;)
+    if (PackIsLoaded)
     {
-        const char* writeBuffPtr = NULL;
-        size_t writeLen = 0;
-
-        // Figure out what to write based on the state.
-        switch (opPtr->state)
-        {
-            case START:
-
-                writeBuffPtr = "[";
-                writeLen = 1;
-
-                break;
-
-            case SAMPLE:
-
-                writeBuffPtr = opPtr->writeBuffer + opPtr->writeOffset;
-                writeLen = opPtr->writeLen - opPtr->writeOffset;
-
-                break;
-
-            case COMMA:
-
-                writeBuffPtr = ",";
-                writeLen = 1;
-
-                break;
-
-            case END:
+        return;
+    }
+    PackIsLoaded = true;
 
-                writeBuffPtr = "]";
-                writeLen = 1;
+    FILE* file = OpenPackFile();
+    if (file == NULL)
+    {
+        return;
+    }
 
-                break;
-        }
+    uint8_t header[BACKUP_PACK_HEADER_BYTES];
+    uint32_t entryCount;
+    uint32_t indexBytes;
+    uint32_t indexCrc;
+    uint32_t headerCrc;
+    if (fread(header, sizeof(header), 1, file) != 1)
+    {
+        goto damaged;
+    }
+    memcpy(&entryCount, header + 4, 4);
+    memcpy(&indexBytes, header + 8, 4);
+    memcpy(&indexCrc, header + 12, 4);
+    memcpy(&headerCrc, header + 16, 4);
+    if (   (memcmp(header, BACKUP_PACK_MAGIC, 4) != 0)
+        || (headerCrc != le_crc_Crc32(header, 16, LE_CRC_START_CRC32))  )
+    {
+        goto damaged;
+    }
 
-        // Write and check for errors.
-        result = WriteToFd(opPtr->fd, writeBuffPtr, writeLen);
-        if (result == -1)
+    // The index is read in one go, from the start of the file.
+    uint32_t crc = LE_CRC_START_CRC32;
+    size_t bytesRead = 0;
+    for (uint32_t i = 0; i < entryCount; i++)
+    {
+        uint8_t entry[MAX_BACKUP_PACK_ENTRY_BYTES];
+        uint16_t pathLen;
+        if (fread(entry, 2, 1, file) != 1)
         {
-            if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
-            {
-                // Return and wait for this function to be called again by the FD Monitor.
-                return;
-            }
-
-            LE_ERROR("Error writing (%m).");
-            EndRead(opPtr, LE_COMM_ERROR);
-
-            return;
+            goto damaged;
         }
-
-        // Advance to the next state.
-        switch (opPtr->state)
+        memcpy(&pathLen, entry, 2);
+        if (   ((BACKUP_DIR_PATH_LEN + pathLen) >= MAX_BACKUP_FILE_PATH_BYTES)
+            || (fread(entry + 2, BACKUP_PACK_ENTRY_FIXED_BYTES - 2 + pathLen, 1, file) != 1)  )
         {
-            case START:
+            goto damaged;
+        }
 
-                // If there's a sample in the write buffer,
-                if (opPtr->writeLen > 0)
-                {
-                    opPtr->state = SAMPLE;
-                }
-                else
-                {
-                    opPtr->state = END;
-                }
-                break;
+        size_t entryBytes = BACKUP_PACK_ENTRY_FIXED_BYTES + pathLen;
+        crc = le_crc_Crc32(entry, entryBytes, crc);
+        bytesRead += entryBytes;
 
-            case SAMPLE:
+        char path[MAX_BACKUP_FILE_PATH_BYTES] = BACKUP_DIR;
+        memcpy(path + BACKUP_DIR_PATH_LEN, entry + 2, pathLen);
+        path[BACKUP_DIR_PATH_LEN + pathLen] = '\0';
 
-                // Update the write offset.
-                opPtr->writeOffset += result;
+        PackEntry_t* entryPtr = CreatePackEntry(path);
+        memcpy(&entryPtr->offset, entry + 2 + pathLen, 4);
+        memcpy(&entryPtr->length, entry + 6 + pathLen, 4);
+        memcpy(&entryPtr->crc, entry + 10 + pathLen, 4);
+    }
 
-                // If the write buffer has been written entirely,
-                if (opPtr->writeOffset == opPtr->writeLen)
-                {
-                    // Try to load the next sample into the write buffer.
-                    if (LoadReadOpBuffer(opPtr))
-                    {
-                        opPtr->state = COMMA;
-                    }
-                    else
-                    {
-                        opPtr->state = END;
-                    }
-                }
-                // Note: If the write buffer has not been written entirely, stay in the SAMPLE
-                // state and loop back around to write more.
-                break;
+    if ((bytesRead == indexBytes) && (crc == indexCrc))
+    {
+        return;
+    }
 
-            case COMMA:
+damaged:
 
-                opPtr->state = SAMPLE;
-                break;
+    LE_CRIT("Backup pack '" BACKUP_PACK_PATH "' is damaged. Deleting it.");
 
-            case END:
+    le_dls_Link_t* linkPtr;
+    while ((linkPtr = le_dls_Peek(&PackEntryList)) != NULL)
+    {
+        DeletePackEntry(CONTAINER_OF(linkPtr, PackEntry_t, link));
+    }
 
-                EndRead(opPtr, LE_OK);
+    ClosePackFile();
 
-                return;
-        }
+    if (unlink(BACKUP_PACK_PATH) != 0)
+    {
+        LE_CRIT("Failed to delete '" BACKUP_PACK_PATH "' (%m).");
     }
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Event handler call-back for events on a read operation's write file descriptor.
+ * Find the backup pack index entry for an Observation's backup.
+ *
+ * @return Pointer to the entry, or NULL if the pack doesn't hold a backup of the Observation.
  */
 //--------------------------------------------------------------------------------------------------
-static void ReadOpFdEventHandler
+static PackEntry_t* FindPackEntry
 (
-    int fd,
-    short events
+    const char* backupPath  ///< Path of the Observation's backup file (see GetBackupFilePath()).
 )
 //--------------------------------------------------------------------------------------------------
 {
-    LE_UNUSED(fd);
-
-    ReadOperation_t* opPtr = le_fdMonitor_GetContextPtr();
+    LoadPackIndex();
 
-    // Check for error or hang-up.
-    if ((events & POLLERR) || (events & POLLHUP) || (events & POLLRDHUP))
+    // Search on from the entry last found, wrapping around to the start of the index.
+    le_dls_Link_t* startPtr = NULL;
+    if (PackCursorPtr != NULL)
     {
-        LE_ERROR("Error or hang-up on output stream.");
-        EndRead(opPtr, LE_COMM_ERROR);
+        startPtr = le_dls_PeekNext(&PackEntryList, PackCursorPtr);
     }
-    // Note: The only other reason for this function to be called is POLLOUT (writeable).
-    else
+    if (startPtr == NULL)
     {
-        ContinueReadOp(opPtr);
+        startPtr = le_dls_Peek(&PackEntryList);
+    }
+
+    le_dls_Link_t* linkPtr = startPtr;
+    while (linkPtr != NULL)
+    {
+        PackEntry_t* entryPtr = CONTAINER_OF(linkPtr, PackEntry_t, link);
+
+        if (strcmp(entryPtr->path, backupPath) == 0)
+        {
+            PackCursorPtr = linkPtr;
+            return entryPtr;
+        }
+
+        linkPtr = le_dls_PeekNext(&PackEntryList, linkPtr);
+        if (linkPtr == NULL)
+        {
+            linkPtr = le_dls_Peek(&PackEntryList);
+        }
+        if (linkPtr == startPtr)
+        {
+            break;
+        }
     }
+
+    return NULL;
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Start a read operation on a given Observation's buffer.
+ * Stage a backup job's backup to be put into the backup pack when the pack file is next written.
+ * Runs on the Backup Writer's thread.
  */
 //--------------------------------------------------------------------------------------------------
-static void StartRead
+static void PutIntoPack
 (
-    Observation_t* obsPtr,
-    BufferEntry_t* startPtr, ///< Ptr to buffer entry to start at, or NULL if read data set empty.
-    int outputFile, ///< File descriptor to write the data to.
-    query_ReadCompletionFunc_t handlerPtr, ///< Completion callback.
-    void* contextPtr    ///< Value to be passed to completion callback.
+    BackupJob_t* jobPtr
 )
 //--------------------------------------------------------------------------------------------------
 {
-    // Set the fd non-blocking
-    if (0 != fcntl(outputFile, F_SETFL, O_NONBLOCK))
-    {
-        LE_ERROR("Failed to activate non-blocking mode (%m).");
-        handlerPtr(LE_COMM_ERROR, contextPtr);
-        return;
-    }
-
-    ReadOperation_t* opPtr = hub_MemAlloc(ReadOperationPool);
-    if (opPtr == NULL)
-    {
-        LE_ERROR("Failed to allocate a read operation");
-        handlerPtr(LE_NO_MEMORY, contextPtr);
-        return;
-    }
-    opPtr->link = LE_DLS_LINK_INIT;
-    le_dls_Queue(&obsPtr->readOpList, &opPtr->link);
+    le_mutex_Lock(PackMutex);
 
-    opPtr->obsPtr = obsPtr;
-
-    opPtr->fdMonitor = le_fdMonitor_Create("Read", outputFile, ReadOpFdEventHandler, POLLOUT);
-    le_fdMonitor_SetContextPtr(opPtr->fdMonitor, opPtr);
-    opPtr->fd = outputFile;
-    opPtr->nextEntryPtr = startPtr;
-    // We hold a ref count on the buffer entry to prevent it from being released.
-    if (startPtr != NULL)
+    PackEntry_t* entryPtr = FindPackEntry(jobPtr->backupPath);
+    if (entryPtr == NULL)
     {
-        le_mem_AddRef(startPtr);
+        entryPtr = CreatePackEntry(jobPtr->backupPath);
     }
-    opPtr->handlerPtr = handlerPtr;
-    opPtr->contextPtr = contextPtr;
 
-    opPtr->state = START;
-    (void)LoadReadOpBuffer(opPtr);
+    entryPtr->jobPtr = jobPtr;
+    entryPtr->isRemoved = false;
+    PackIsDirty = true;
 
-    ContinueReadOp(opPtr);
+    le_mutex_Unlock(PackMutex);
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Adds a given data sample to the buffer of a given Observation.
- *
- * @return
- *      - LE_OK If datasample was added to observation buffer successfully.
- *      - LE_NO_MEMORY If failed to allocate memory for the new datasample in Buffer Pool.
- *      - LE_BAD_PARAMETER If dropped sample because its timestamp was older than the sample already
- *           in buffer.
+ * Stage an Observation's backup (if any) to be taken out of the backup pack when the pack file is
+ * next written.  Runs on the Backup Writer's thread.
  */
 //--------------------------------------------------------------------------------------------------
-static le_result_t AddToBuffer
+static void RemoveFromPack
 (
-    Observation_t* obsPtr,
-    dataSample_Ref_t sampleRef
+    const char* backupPath  ///< Path of the Observation's backup file (see GetBackupFilePath()).
 )
 //--------------------------------------------------------------------------------------------------
 {
-    BufferEntry_t* buffEntryPtr;
+    le_mutex_Lock(PackMutex);
 
-    // If the new sample is timestamped older than the newest sample already in the buffer,
-    // then we have a serious problem, because buffer traversal operations could get stuck in loops.
-    le_sls_Link_t* linkPtr = le_sls_PeekTail(&obsPtr->sampleList);
-    if (linkPtr != NULL)
+    PackEntry_t* entryPtr = FindPackEntry(backupPath);
+    if (entryPtr != NULL)
     {
-        buffEntryPtr = CONTAINER_OF(linkPtr, BufferEntry_t, link);
-
-        double oldEntryTimestamp = dataSample_GetTimestamp(buffEntryPtr->sampleRef);
-        double newEntryTimestamp = dataSample_GetTimestamp(sampleRef);
-
-        if (oldEntryTimestamp > newEntryTimestamp)
-        {
-            LE_ERROR("New sample has older timestamp than (older) sample already in the buffer!");
-            LE_ERROR("Dropping new sample timestamped %lf (< %lf in buffer)!",
-                     newEntryTimestamp,
-                     oldEntryTimestamp);
-            return LE_BAD_PARAMETER;
-        }
+        entryPtr->isRemoved = true;
+        PackIsDirty = true;
     }
 
-    buffEntryPtr = hub_MemAlloc(BufferEntryPool);
-    if (buffEntryPtr)
-    {
-        le_mem_AddRef(sampleRef);
-        buffEntryPtr->sampleRef = sampleRef;
-        buffEntryPtr->link = LE_SLS_LINK_INIT;
-        le_sls_Queue(&obsPtr->sampleList, &buffEntryPtr->link);
-
-        (obsPtr->count)++;
-        return LE_OK;
-    }
-    else
-    {
-        LE_ERROR("Failed to allocate a buffer entry");
-        return LE_NO_MEMORY;
-    }
+    le_mutex_Unlock(PackMutex);
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * If the number of entries in a given Observation's buffer is larger than the number given,
- * discard enough of the oldest entries to correct that condition.
+ * Get the number of bytes a backup pack index entry's backup is to have in the pack file being
+ * written.
+ *
+ * @return The number of bytes.
  */
 //--------------------------------------------------------------------------------------------------
-static void TruncateBuffer
+static size_t GetPackedBackupBytes
 (
-    Observation_t* obsPtr,
-    size_t count
+    const PackEntry_t* entryPtr
 )
 //--------------------------------------------------------------------------------------------------
 {
-    while (obsPtr->count > count)
-    {
-        le_sls_Link_t* linkPtr = le_sls_Pop(&obsPtr->sampleList);
-        LE_ASSERT(linkPtr != NULL);
+    return ((entryPtr->jobPtr != NULL) ? backupWriter_GetSize(entryPtr->jobPtr->imageRef)
+                                       : entryPtr->length);
+}
 
-        le_mem_Release(CONTAINER_OF(linkPtr, BufferEntry_t, link));
 
-        (obsPtr->count)--;
-    }
+//--------------------------------------------------------------------------------------------------
+/**
+ * Encode a backup pack index entry as it is to be in the pack file being written.
+ *
+ * @return The number of bytes encoded.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t EncodePackEntry
+(
+    uint8_t* buffPtr,   ///< [OUT] Buffer of MAX_BACKUP_PACK_ENTRY_BYTES bytes.
+    const PackEntry_t* entryPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    const char* relPath = entryPtr->path + BACKUP_DIR_PATH_LEN;
+    uint16_t pathLen = strlen(relPath);
+    uint32_t length = GetPackedBackupBytes(entryPtr);
+    uint32_t crc = ((entryPtr->jobPtr != NULL) ? entryPtr->jobPtr->crc : entryPtr->crc);
+
+    memcpy(buffPtr, &pathLen, 2);
+    memcpy(buffPtr + 2, relPath, pathLen);
+    memcpy(buffPtr + 2 + pathLen, &entryPtr->newOffset, 4);
+    memcpy(buffPtr + 6 + pathLen, &length, 4);
+    memcpy(buffPtr + 10 + pathLen, &crc, 4);
+
+    return BACKUP_PACK_ENTRY_FIXED_BYTES + pathLen;
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Update the value of a data sample by replacing it, if necessary
- *
- * Note: Even though this function uses dataSample_CreateBoolean and dataSample-CreateNumberic which
- * may return NULL if dataSample pool is exhusted, because the previous sample is always released
- * first before calling the createSample function, it is expected that creating sample is always
- * successful.
+ * Copy an unchanged backup from the old backup pack file to the one being written, checking its
+ * CRC on the way.
  *
  * @return
- *      Pointer to the updated sample.
+ *      - LE_OK if successful.
+ *      - LE_FORMAT_ERROR if the old backup is damaged.
+ *      - LE_FAULT if failed to write.
  */
 //--------------------------------------------------------------------------------------------------
-static dataSample_Ref_t UpdateSample
+static le_result_t CopyPackedBackup
 (
-    dataSample_Ref_t sampleRef,
-    io_DataType_t dataType,
-    void *valuePtr
+    const PackEntry_t* entryPtr,
+    FILE* fromFile,     ///< Old pack file, or NULL if it couldn't be opened.
+    FILE* toFile
 )
 //--------------------------------------------------------------------------------------------------
 {
-    dataSample_Ref_t sample = sampleRef;
-    double timestamp = dataSample_GetTimestamp(sampleRef);
-
+    if ((fromFile == NULL) || (fseek(fromFile, entryPtr->offset, SEEK_SET) != 0))
+    {
+        return LE_FORMAT_ERROR;
+    }
 
-    switch (dataType)
+    uint32_t crc = LE_CRC_START_CRC32;
+    size_t remaining = entryPtr->length;
+    while (remaining > 0)
     {
-        case IO_DATA_TYPE_BOOLEAN:
+        uint8_t chunk[512];
+        size_t chunkLen = ((remaining < sizeof(chunk)) ? remaining : sizeof(chunk));
+
+        if (fread(chunk, 1, chunkLen, fromFile) != chunkLen)
         {
-            bool value = *((double *)valuePtr) > 0.0 ? true : false;
-            if (dataSample_GetBoolean(sampleRef) != value)
-            {
-                le_mem_Release(sampleRef);
-                sample = dataSample_CreateBoolean(timestamp, value);
-            }
-            break;
+            return LE_FORMAT_ERROR;
         }
-
-        case IO_DATA_TYPE_NUMERIC:
+        if (fwrite(chunk, 1, chunkLen, toFile) != chunkLen)
         {
-            double value = *((double *)valuePtr);
-            if (dataSample_GetNumeric(sampleRef) != value)
-            {
-                le_mem_Release(sampleRef);
-                sample = dataSample_CreateNumeric(timestamp, value);
-            }
+            return LE_FAULT;
         }
-
-        default:
-            break;
+        crc = le_crc_Crc32(chunk, chunkLen, crc);
+        remaining -= chunkLen;
     }
 
-    if (!sample)
-    {
-        LE_FATAL("UpdateSample Failed to allocate a new sample");
-    }
-    return sample;
+    return ((crc == entryPtr->crc) ? LE_OK : LE_FORMAT_ERROR);
 }
 
 
-#if LE_CONFIG_FILESYSTEM
 //--------------------------------------------------------------------------------------------------
 /**
- * Writes a buffer load of data to a buffered file stream.
- *
- * On error, logs an error message and closes the file.
+ * Write the backup pack file with the backups staged so far.  Runs on the Backup Writer's thread.
  *
- * @return true if successful, false if failed.
+ * @return
+ *      - LE_OK if successful.
+ *      - LE_FORMAT_ERROR if backups in the old pack file were found to be damaged (in which case
+ *        their entries are marked for removal, and the pack file should be written again).
+ *      - LE_FAULT if failed (in which case the old pack file is left as it was).
  */
 //--------------------------------------------------------------------------------------------------
-static bool WriteToStream
+static le_result_t WritePack
 (
-    FILE* file,
-    const void* buffPtr,
-    size_t buffSize
+    void
 )
 //--------------------------------------------------------------------------------------------------
 {
-    size_t recordsWritten = fwrite(buffPtr, buffSize, 1, file);
-    if (recordsWritten != 1)
+    le_dls_Link_t* linkPtr;
+
+    // The index follows the header, and the backups follow the index, in index order.
+    uint32_t entryCount = 0;
+    size_t indexBytes = 0;
+    for (linkPtr = le_dls_Peek(&PackEntryList);
+         linkPtr != NULL;
+         linkPtr = le_dls_PeekNext(&PackEntryList, linkPtr))
     {
-        LE_CRIT("Failed to write (%m).");
-        le_atomFile_CancelStream(file);
-        return false;
+        PackEntry_t* entryPtr = CONTAINER_OF(linkPtr, PackEntry_t, link);
+        if (!entryPtr->isRemoved)
+        {
+            entryCount++;
+            indexBytes += BACKUP_PACK_ENTRY_FIXED_BYTES
+                        + strlen(entryPtr->path + BACKUP_DIR_PATH_LEN);
+        }
     }
-    return true;
-}
 
+    if (entryCount == 0)
+    {
+        ClosePackFile();
 
-//--------------------------------------------------------------------------------------------------
-/**
- * Reads a buffer load of data from a backup file.
- *
- * On error, logs an error message and closes the file.
- *
- * @return LE_OK if successful, LE_UNDERFLOW if the end of file was reached, LE_FAULT if failed.
- */
-//--------------------------------------------------------------------------------------------------
-static le_result_t ReadFromFile
-(
-    void* buffPtr,
-    size_t buffSize,
-    FILE* file
-)
-//--------------------------------------------------------------------------------------------------
-{
-    size_t bytesRead = fread(buffPtr, 1, buffSize, file);
-
-    le_result_t result = LE_OK;
+        if ((unlink(BACKUP_PACK_PATH) != 0) && (errno != ENOENT))
+        {
+            LE_CRIT("Failed to delete '" BACKUP_PACK_PATH "' (%m).");
+            return LE_FAULT;
+        }
+        return LE_OK;
+    }
 
-    if (bytesRead < buffSize)
+    size_t offset = BACKUP_PACK_HEADER_BYTES + indexBytes;
+    uint32_t indexCrc = LE_CRC_START_CRC32;
+    for (linkPtr = le_dls_Peek(&PackEntryList);
+         linkPtr != NULL;
+         linkPtr = le_dls_PeekNext(&PackEntryList, linkPtr))
     {
-        if (feof(file))
+        PackEntry_t* entryPtr = CONTAINER_OF(linkPtr, PackEntry_t, link);
+        if (entryPtr->isRemoved)
         {
-            result = LE_UNDERFLOW;
+            continue;
         }
-        else
+
+        // Each backup starts on a record boundary, so that its records are aligned when mapped.
+        offset += GetBackupPadding(offset);
+        entryPtr->newOffset = offset;
+        offset += GetPackedBackupBytes(entryPtr);
+        if (offset > UINT32_MAX)
         {
-            LE_CRIT("Failed to read (%m).");
-            result = LE_FAULT;
+            LE_CRIT("Backup pack is too big.");
+            return LE_FAULT;
         }
 
-        le_atomFile_CancelStream(file);
+        uint8_t entry[MAX_BACKUP_PACK_ENTRY_BYTES];
+        indexCrc = le_crc_Crc32(entry, EncodePackEntry(entry, entryPtr), indexCrc);
     }
 
-    return result;
-}
+    uint8_t header[BACKUP_PACK_HEADER_BYTES];
+    uint32_t indexLen = indexBytes;
+    memcpy(header, BACKUP_PACK_MAGIC, 4);
+    memcpy(header + 4, &entryCount, 4);
+    memcpy(header + 8, &indexLen, 4);
+    memcpy(header + 12, &indexCrc, 4);
+    uint32_t headerCrc = le_crc_Crc32(header, 16, LE_CRC_START_CRC32);
+    memcpy(header + 16, &headerCrc, 4);
 
+    le_result_t result;
+    FILE* file = le_atomFile_CreateStream(BACKUP_PACK_PATH,
+                                          LE_FLOCK_WRITE,
+                                          LE_FLOCK_REPLACE_IF_EXIST,
+                                          0600,
+                                          &result);
+    if (result != LE_OK)
+    {
+        LE_CRIT("Unable to open '" BACKUP_PACK_PATH "' for writing (%s).", LE_RESULT_TXT(result));
+        return LE_FAULT;
+    }
 
-//--------------------------------------------------------------------------------------------------
-/**
- * Gets the data type code byte to be written into a backup file.
- *
- * @return the data type code byte.
- */
-//--------------------------------------------------------------------------------------------------
-static uint8_t GetDataTypeCode
-(
-    Observation_t* obsPtr
-)
-//--------------------------------------------------------------------------------------------------
-{
-    switch (res_GetDataType(&obsPtr->resource))
+    if (fwrite(header, sizeof(header), 1, file) != 1)
     {
-        case IO_DATA_TYPE_TRIGGER:  return 't';
-        case IO_DATA_TYPE_BOOLEAN:  return 'b';
-        case IO_DATA_TYPE_NUMERIC:  return 'n';
-        case IO_DATA_TYPE_STRING:   return 's';
-        case IO_DATA_TYPE_JSON:     return 'j';
+        result = LE_FAULT;
     }
 
-    LE_FATAL("Invalid data type %d.", res_GetDataType(&obsPtr->resource));
-}
+    for (linkPtr = le_dls_Peek(&PackEntryList);
+         (linkPtr != NULL) && (result == LE_OK);
+         linkPtr = le_dls_PeekNext(&PackEntryList, linkPtr))
+    {
+        PackEntry_t* entryPtr = CONTAINER_OF(linkPtr, PackEntry_t, link);
+        if (!entryPtr->isRemoved)
+        {
+            uint8_t entry[MAX_BACKUP_PACK_ENTRY_BYTES];
+            size_t entryBytes = EncodePackEntry(entry, entryPtr);
+            if (fwrite(entry, entryBytes, 1, file) != 1)
+            {
+                result = LE_FAULT;
+            }
+        }
+    }
 
+    // Carry on past a damaged backup, so that all the damaged ones are found in one go.
+    static const uint8_t padding[BACKUP_RECORD_ALIGN] = { 0 };
+    size_t pos = BACKUP_PACK_HEADER_BYTES + indexBytes;
+    bool isDamaged = false;
+    for (linkPtr = le_dls_Peek(&PackEntryList);
+         (linkPtr != NULL) && (result == LE_OK);
+         linkPtr = le_dls_PeekNext(&PackEntryList, linkPtr))
+    {
+        PackEntry_t* entryPtr = CONTAINER_OF(linkPtr, PackEntry_t, link);
+        if (entryPtr->isRemoved)
+        {
+            continue;
+        }
 
-//--------------------------------------------------------------------------------------------------
-/**
- * Gets the data type represented by the code byte read from a backup file.
- *
- * @return true if successful, false on error.
- */
-//--------------------------------------------------------------------------------------------------
-static bool GetDataTypeFromCode
-(
-    io_DataType_t* dataTypePtr, ///< [OUT] Ptr to where the result will be put on success.
-    uint8_t code
-)
-//--------------------------------------------------------------------------------------------------
-{
-    switch (code)
+        size_t padLen = entryPtr->newOffset - pos;
+        if ((padLen > 0) && (fwrite(padding, padLen, 1, file) != 1))
+        {
+            result = LE_FAULT;
+            break;
+        }
+        pos = entryPtr->newOffset + GetPackedBackupBytes(entryPtr);
+
+        if (entryPtr->jobPtr != NULL)
+        {
+            result = backupWriter_WriteToStream(entryPtr->jobPtr->imageRef, file);
+        }
+        else
+        {
+            result = CopyPackedBackup(entryPtr, OpenPackFile(), file);
+            if (result == LE_FORMAT_ERROR)
+            {
+                LE_CRIT("Backup '%s' in pack is damaged. Dropping it.", entryPtr->path);
+                entryPtr->isRemoved = true;
+                isDamaged = true;
+                result = LE_OK;
+            }
+        }
+    }
+
+    if ((result == LE_OK) && isDamaged)
     {
-        case 't': *dataTypePtr = IO_DATA_TYPE_TRIGGER; return true;
-        case 'b': *dataTypePtr = IO_DATA_TYPE_BOOLEAN; return true;
-        case 'n': *dataTypePtr = IO_DATA_TYPE_NUMERIC; return true;
-        case 's': *dataTypePtr = IO_DATA_TYPE_STRING;  return true;
-        case 'j': *dataTypePtr = IO_DATA_TYPE_JSON;    return true;
+        result = LE_FORMAT_ERROR;
     }
 
-    LE_CRIT("Invalid data type code %d.", (int)code);
+    if (result != LE_OK)
+    {
+        if (result == LE_FAULT)
+        {
+            LE_CRIT("Failed to write '" BACKUP_PACK_PATH "' (%m).");
+        }
+        le_atomFile_CancelStream(file);
+        return result;
+    }
 
-    return false;
+    // The old pack file is about to be replaced.
+    ClosePackFile();
+
+    result = le_atomFile_CloseStream(file);
+    if (result != LE_OK)
+    {
+        LE_CRIT("Failed to save '" BACKUP_PACK_PATH "' (%s).", LE_RESULT_TXT(result));
+        return LE_FAULT;
+    }
+
+    return LE_OK;
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Writes all the data samples for a given Observation to a given backup file.
- *
- * On error, logs an error message and closes the file.
- *
- * @return true if successful, false if failed.
+ * Update the backup pack's index once the pack file has been written (or failed to be written).
+ * Runs on the Backup Writer's thread.
  */
 //--------------------------------------------------------------------------------------------------
-static bool WriteSamplesToFile
+static void FinishPack
 (
-    FILE* file,
-    Observation_t* obsPtr
+    bool isWritten  ///< true if the pack file was written, false if the old one is still there.
 )
 //--------------------------------------------------------------------------------------------------
 {
-    io_DataType_t dataType = obsPtr->bufferedType;
-
-    BufferEntry_t* buffEntryPtr = GetOldestBufferEntry(obsPtr);
-
-    while (buffEntryPtr != NULL)
+    le_dls_Link_t* linkPtr = le_dls_Peek(&PackEntryList);
+    while (linkPtr != NULL)
     {
-        // Write the timestamp.
-        double timestamp = dataSample_GetTimestamp(buffEntryPtr->sampleRef);
-        if (!WriteToStream(file, &timestamp, sizeof(timestamp)))
+        PackEntry_t* entryPtr = CONTAINER_OF(linkPtr, PackEntry_t, link);
+        linkPtr = le_dls_PeekNext(&PackEntryList, linkPtr);
+
+        if (isWritten ? entryPtr->isRemoved : (entryPtr->length == 0))
         {
-            return false;
+            DeletePackEntry(entryPtr);
+            continue;
         }
 
-        switch (dataType)
+        if (isWritten)
         {
-            case IO_DATA_TYPE_TRIGGER:
-
-                // No Value.
-                break;
-
-            case IO_DATA_TYPE_BOOLEAN:
-            {
-                bool value = dataSample_GetBoolean(buffEntryPtr->sampleRef);
-                if (!WriteToStream(file, &value, sizeof(value)))
-                {
-                    return false;
-                }
-                break;
-            }
-            case IO_DATA_TYPE_NUMERIC:
-            {
-                double value = dataSample_GetNumeric(buffEntryPtr->sampleRef);
-                if (!WriteToStream(file, &value, sizeof(value)))
-                {
-                    return false;
-                }
-                break;
-            }
-            case IO_DATA_TYPE_STRING:
-            {
-                const char* valuePtr = dataSample_GetString(buffEntryPtr->sampleRef);
-                uint32_t stringLen = strlen(valuePtr);
-                if (!WriteToStream(file, &stringLen, 4))
-                {
-                    return false;
-                }
-                if (!WriteToStream(file, valuePtr, stringLen))
-                {
-                    return false;
-                }
-                break;
-            }
-            case IO_DATA_TYPE_JSON:
+            if (entryPtr->jobPtr != NULL)
             {
-                const char* valuePtr = dataSample_GetJson(buffEntryPtr->sampleRef);
-                uint32_t stringLen = strlen(valuePtr);
-                if (!WriteToStream(file, &stringLen, 4))
-                {
-                    return false;
-                }
-                if (!WriteToStream(file, valuePtr, stringLen))
-                {
-                    return false;
-                }
-                break;
+                entryPtr->length = GetPackedBackupBytes(entryPtr);
+                entryPtr->crc = entryPtr->jobPtr->crc;
             }
+            entryPtr->offset = entryPtr->newOffset;
         }
 
-        buffEntryPtr = GetNextBufferEntry(obsPtr, buffEntryPtr);
+        entryPtr->jobPtr = NULL;
+        entryPtr->isRemoved = false;
     }
 
-    return true;
+    PackIsDirty = false;
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Reads all the data samples from a given backup file and adds them to a given Observation's
- * data sample buffer.  Closes the file when done.
+ * Do a backup job.  Runs on the Backup Writer's thread, so must not touch the Observation.
  */
 //--------------------------------------------------------------------------------------------------
-static void ReadSamplesFromFile
+static void WriteBackupJob
 (
-    Observation_t* obsPtr,
-    FILE* file,
-    size_t count    ///< The expected number of samples to read.
+    BackupJob_t* jobPtr
 )
 //--------------------------------------------------------------------------------------------------
 {
-    if (count == 0)
-    {
-        return;
-    }
-
-    io_DataType_t dataType = obsPtr->bufferedType;
+    const char* backupPath = jobPtr->backupPath;
+    char path[MAX_BACKUP_LOG_FILE_PATH_BYTES];
 
-    dataSample_Ref_t dataSample = NULL;
-
-    for (;;)
+    switch (jobPtr->type)
     {
-        // Read the timestamp.
-        double timestamp;
-        le_result_t result = ReadFromFile(&timestamp, sizeof(timestamp), file);
-        if (result != LE_OK)
-        {
-            if (result == LE_UNDERFLOW)
+        case BACKUP_JOB_FILE:
+
+            // The log would be restored in preference to the file, so delete it first.
+            if (jobPtr->deleteLog)
             {
-                // End of file reached, check that we've received all we should.
-                if (count == 0)
-                {
-                    // The file contained exactly the number of samples we expected.
-                    // The last data sample read from the file (which is the newest)
-                    // should be pushed to the Observation so it becomes the current value.
-                    res_Push(&obsPtr->resource, dataType, "", dataSample);
-                    return;
-                }
-                else
-                {
-                    LE_CRIT("Backup file was truncated. Expected %zu more samples.", count);
-                }
+                DeleteBackupLog(backupPath, 0);
             }
 
-            goto error;
-        }
-
-        // We succeeded in reading another timestamp, so we had better be expecting more samples.
-        if (count == 0)
-        {
-            LE_CRIT("Backup file contains extra samples.");
-            le_atomFile_CancelStream(file);
-            goto error;
-        }
+            jobPtr->isOk = (backupWriter_ReplaceFile(jobPtr->imageRef, backupPath) == LE_OK);
 
-        count--;
+            if (jobPtr->isOk && jobPtr->dropFromPack)
+            {
+                RemoveFromPack(backupPath);
+            }
+            break;
 
-        switch (dataType)
-        {
-            case IO_DATA_TYPE_TRIGGER:
+        case BACKUP_JOB_LOG_BASE:
+        case BACKUP_JOB_LOG_SEGMENT:
 
-                // No Value.
-                dataSample = dataSample_CreateTrigger(timestamp);
-                break;
+            jobPtr->isOk = (   (GetBackupLogFilePath(path,
+                                                     sizeof(path),
+                                                     backupPath,
+                                                     jobPtr->segment) == LE_OK)
+                            && (backupWriter_ReplaceFile(jobPtr->imageRef, path) == LE_OK)  );
 
-            case IO_DATA_TYPE_BOOLEAN:
-            {
-                bool value;
-                if (ReadFromFile(&value, sizeof(value), file) != LE_OK)
-                {
-                    LE_CRIT("Failed to read boolean value.");
-                    goto error;
-                }
-                dataSample = dataSample_CreateBoolean(timestamp, value);
-                break;
-            }
-            case IO_DATA_TYPE_NUMERIC:
-            {
-                double value;
-                if (ReadFromFile(&value, sizeof(value), file) != LE_OK)
-                {
-                    LE_CRIT("Failed to read numeric value.");
-                    goto error;
-                }
-                dataSample = dataSample_CreateNumeric(timestamp, value);
-                break;
-            }
-            case IO_DATA_TYPE_STRING:
+            // Once the new base is safely written, the rest of the old log and the backup file
+            // (if any) aren't needed any more.
+            if (jobPtr->isOk && (jobPtr->type == BACKUP_JOB_LOG_BASE))
             {
-                char value[HUB_MAX_STRING_BYTES];
+                DeleteBackupLog(backupPath, 1);
 
-                uint32_t stringLen;
-                if (ReadFromFile(&stringLen, 4, file) != LE_OK)
-                {
-                    LE_CRIT("Failed to read string length.");
-                    goto error;
-                }
-                if (stringLen > (sizeof(value) - 1))
-                {
-                    LE_CRIT("String length (%zu) is larger than permitted (%zu).",
-                            (size_t)stringLen,
-                            sizeof(value) - 1);
-                    le_atomFile_CancelStream(file);
-                    goto error;
-                }
-                if (ReadFromFile(value, stringLen, file) != LE_OK)
+                if ((unlink(backupPath) != 0) && (errno != ENOENT))
                 {
-                    LE_CRIT("Failed to read string value of length %zu.", (size_t)stringLen);
-                    goto error;
+                    LE_CRIT("Failed to delete '%s' (%m).", backupPath);
                 }
-                value[stringLen] = '\0';
-                dataSample = dataSample_CreateString(timestamp, value);
-                break;
-            }
-            case IO_DATA_TYPE_JSON:
-            {
-                char value[HUB_MAX_STRING_BYTES];
 
-                uint32_t stringLen;
-                if (ReadFromFile(&stringLen, 4, file) != LE_OK)
-                {
-                    LE_CRIT("Failed to read JSON object length.");
-                    goto error;
-                }
-                if (stringLen > (sizeof(value) - 1))
+                if (jobPtr->dropFromPack)
                 {
-                    LE_CRIT("JSON string length (%zu) is larger than permitted (%zu).",
-                            (size_t)stringLen,
-                            sizeof(value) - 1);
-                    le_atomFile_CancelStream(file);
-                    goto error;
-                }
-                if (ReadFromFile(value, stringLen, file) != LE_OK)
-                {
-                    LE_CRIT("Failed to read JSON value of length %zu.", (size_t)stringLen);
-                    goto error;
+                    RemoveFromPack(backupPath);
                 }
-                value[stringLen] = '\0';
-                dataSample = dataSample_CreateJson(timestamp, value);
-                break;
             }
-        }
+            break;
 
-        // Add the sample to the buffer, unless this is the last (newest) sample, in which case
-        // we will push it to the Observation later when we confirm that the file doesn't have
-        // more than expected in it (which would mean that all these samples are probably corrupt
-        // and need to be discarded).
-        if (count != 0 && dataSample)
-        {
-            if (AddToBuffer(obsPtr, dataSample) != LE_OK)
-            {
-                goto error;
-            }
-        }
-        else if (!dataSample)
-        {
-            // Failed to allocate a data sample and therefore cannot proceed with read.
-            LE_ERROR("Failed to allocate dataSample for value read from file");
-            goto error;
-        }
-    }
+        case BACKUP_JOB_LOG_APPEND:
 
-error:
+            jobPtr->isOk = (   (GetBackupLogFilePath(path,
+                                                     sizeof(path),
+                                                     backupPath,
+                                                     jobPtr->segment) == LE_OK)
+                            && (backupWriter_AppendToFile(jobPtr->imageRef, path) == LE_OK)  );
+            break;
 
-    // On error, dump the buffer contents in case we read some corrupted samples from the file.
-    TruncateBuffer(obsPtr, 0);
+        case BACKUP_JOB_DELETE:
+
+            unlink(backupPath);
+            DeleteBackupLog(backupPath, 0);
+            RemoveFromPack(backupPath);
+            jobPtr->isOk = true;
+            break;
+
+        case BACKUP_JOB_PACK:
+
+            // The pack file is written once the whole batch has been staged.
+            PutIntoPack(jobPtr);
+            break;
+    }
 }
-#endif /* end LE_CONFIG_FILESYSTEM */
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Perform a backup to non-volatile storage of an observation's data sample buffer.
+ * Do a batch of backup jobs, in order.  Runs on the Backup Writer's thread.
  */
 //--------------------------------------------------------------------------------------------------
-static void Backup
+static void WriteBackupBatch
 (
-    Observation_t* obsPtr
+    void* contextPtr    ///< The batch.
 )
 //--------------------------------------------------------------------------------------------------
 {
-    // If the backup timer exists, delete it.
-    if (obsPtr->backupTimer != NULL)
+    BackupBatch_t* batchPtr = contextPtr;
+
+    le_dls_Link_t* linkPtr = le_dls_Peek(&batchPtr->jobList);
+    while (linkPtr != NULL)
     {
-        le_timer_Delete(obsPtr->backupTimer);
-        obsPtr->backupTimer = NULL;
+        WriteBackupJob(CONTAINER_OF(linkPtr, BackupJob_t, link));
+
+        linkPtr = le_dls_PeekNext(&batchPtr->jobList, linkPtr);
     }
 
-    // Update the time of last backup.
-    le_clk_Time_t now = le_clk_GetRelativeTime();
-    obsPtr->lastBackupTime = now.sec;
+    le_mutex_Lock(PackMutex);
 
-#if LE_CONFIG_FILESYSTEM
-    // Get the backup file path.
-    char path[MAX_BACKUP_FILE_PATH_BYTES];
-    if (GetBackupFilePath(path, sizeof(path), obsPtr) != LE_OK)
+    if (!PackIsDirty)
     {
+        le_mutex_Unlock(PackMutex);
         return;
     }
 
-    LE_DEBUG("Backing up to '%s'...", path);
-
-    // Create the backup directory, if it doesn't exist already.
-    struct stat st = {0};
-    if (stat(BACKUP_DIR, &st) == -1)
-    {
-        LE_DEBUG("Creating directory '" BACKUP_DIR "'.");
-
-        if (mkdir(BACKUP_DIR, 0700) == -1)
-        {
-            LE_CRIT("Unable to create directory '" BACKUP_DIR "' (%m).");
-            return;
-        }
-    }
-
-    // Open the file for writing, truncating it to zero length to start.
+    // Write the backup pack once for the whole batch.  If an unchanged backup turns out to be
+    // damaged, it is dropped and the pack written again.
     le_result_t result;
-    FILE* file = le_atomFile_CreateStream(path,
-                                          LE_FLOCK_WRITE,
-                                          LE_FLOCK_REPLACE_IF_EXIST,
-                                          0600,
-                                          &result);
-    if (result != LE_OK)
+    do
     {
-        LE_CRIT("Unable to open file '%s' for writing (%s).", path, LE_RESULT_TXT(result));
-        return;
+        result = WritePack();
     }
+    while (result == LE_FORMAT_ERROR);
 
-    // Write in the version byte.
-    uint8_t byte = 0;
-    if (!WriteToStream(file, &byte, 1))
-    {
-        return;
-    }
+    bool isWritten = (result == LE_OK);
+    FinishPack(isWritten);
 
-    // Write the data type code.
-    byte = GetDataTypeCode(obsPtr);
-    if (byte == 0)
-    {
-        le_atomFile_CancelStream(file);
-        return;
-    }
-    if (!WriteToStream(file, &byte, 1))
-    {
-        return;
-    }
+    le_mutex_Unlock(PackMutex);
 
-    // Write in the number of samples.
-    uint32_t count = obsPtr->count;
-    if (!WriteToStream(file, &count, 4))
+    // The backup file and log would be restored in preference to the pack, so are deleted once
+    // the backup is safely in the pack.
+    for (linkPtr = le_dls_Peek(&batchPtr->jobList);
+         linkPtr != NULL;
+         linkPtr = le_dls_PeekNext(&batchPtr->jobList, linkPtr))
     {
-        return;
-    }
+        BackupJob_t* jobPtr = CONTAINER_OF(linkPtr, BackupJob_t, link);
 
-    // Write all the data samples to the file.
-    if (!WriteSamplesToFile(file, obsPtr))
-    {
-        return;
-    }
+        if (jobPtr->type == BACKUP_JOB_PACK)
+        {
+            jobPtr->isOk = isWritten;
 
-    // Commit the file.
-    result = le_atomFile_CloseStream(file);
-    if (result != LE_OK)
-    {
-        LE_CRIT("Failed to save '%s' (%s).", path, LE_RESULT_TXT(result));
+            if (isWritten && jobPtr->deleteFile)
+            {
+                if ((unlink(jobPtr->backupPath) != 0) && (errno != ENOENT))
+                {
+                    LE_CRIT("Failed to delete '%s' (%m).", jobPtr->backupPath);
+                }
+            }
+            if (isWritten && jobPtr->deleteLog)
+            {
+                DeleteBackupLog(jobPtr->backupPath, 0);
+            }
+        }
     }
-#else /* !LE_CONFIG_FILESYSTEM */
-    // TODO: implement non-volatile storage without a filesystem.
-#endif /* end !LE_CONFIG_FILESYSTEM */
-
-    LE_DEBUG("Backup complete.");
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Disable backups of a given Observation's data sample buffer.
+ * Take an Observation's next backup off the schedule, if it is scheduled.
  */
 //--------------------------------------------------------------------------------------------------
-static void DisableBackups
+static void UnscheduleBackup
 (
     Observation_t* obsPtr
 )
 //--------------------------------------------------------------------------------------------------
 {
-    if (obsPtr->backupTimer != NULL)
+    if (obsPtr->backupListPtr != NULL)
     {
-        le_timer_Stop(obsPtr->backupTimer);
-        le_timer_Delete(obsPtr->backupTimer);
-        obsPtr->backupTimer = NULL;
+        le_dls_Remove(obsPtr->backupListPtr, &obsPtr->backupLink);
+        obsPtr->backupListPtr = NULL;
+        ScheduledBackupCount--;
     }
-
-    obsPtr->lastBackupTime = 0;
-
-    DeleteBackup(obsPtr);
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Timer expiry handler function for Observation data sample buffer backup timers.
- *
- * Saves the contents of an Observation's data sample buffer to non-volatile storage.
- *
- * @note The timer should only be running if a data sample arrived in the buffer before the
- *       backup period had elapsed since the previous backup.
+ * Top up the backup flash write allowance for a given time passed.  At most an hour's budget can
+ * be saved up.
  */
 //--------------------------------------------------------------------------------------------------
-static void BackupTimerExpired
+static void TopUpBackupWriteAllowance
 (
-    le_timer_Ref_t timer
+    uint32_t elapsed    ///< Number of seconds passed since the allowance was last topped up.
 )
 //--------------------------------------------------------------------------------------------------
 {
-    Observation_t* obsPtr = le_timer_GetContextPtr(timer);
-
-    Backup(obsPtr);
+    if (BackupWriteBudget > 0)
+    {
+        BackupWriteAllowance += (double)BackupWriteBudget * elapsed / SECONDS_PER_HOUR;
+        if (BackupWriteAllowance > BackupWriteBudget)
+        {
+            BackupWriteAllowance = BackupWriteBudget;
+        }
+    }
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Initialize the Observation module.
- *
- * @warning This must be called before any other function in this module is called.
+ * Schedule an Observation's next backup for a given time (replacing any already scheduled).
+ * A backup is done at the first tick of the backup wheel at or after that time.
  */
 //--------------------------------------------------------------------------------------------------
-void obs_Init
+static void ScheduleBackup
 (
-    void
+    Observation_t* obsPtr,
+    uint32_t dueTime    ///< When the backup is due (seconds, relative clock).
 )
 //--------------------------------------------------------------------------------------------------
 {
-    ObservationPool = le_mem_InitStaticPool(ObservationPool, DEFAULT_OBSERVATION_POOL_SIZE,
-                        sizeof(Observation_t));
-    le_mem_SetDestructor(ObservationPool, ObservationDestructor);
+    UnscheduleBackup(obsPtr);
 
-    BufferEntryPool = le_mem_InitStaticPool(BufferEntryPool, DEFAULT_BUFFER_ENTRY_POOL_SIZE,
-                        sizeof(BufferEntry_t));
-    le_mem_SetDestructor(BufferEntryPool, BufferEntryDestructor);
+    le_clk_Time_t now = le_clk_GetRelativeTime();
 
-    ReadOperationPool = le_mem_InitStaticPool(ReadOperationPool,
-                                              DEFAULT_READ_OPERATION_POOL_SIZE,
-                                              sizeof(ReadOperation_t));
+    obsPtr->backupDueTime = dueTime;
+    if (dueTime <= now.sec)
+    {
+        obsPtr->backupListPtr = &DueBackupList;
+    }
+    else
+    {
+        obsPtr->backupListPtr = &BackupWheel[dueTime % BACKUP_WHEEL_SLOTS];
+    }
+    le_dls_Queue(obsPtr->backupListPtr, &obsPtr->backupLink);
+    ScheduledBackupCount++;
+
+    // The wheel only ticks while there are backups scheduled.  The time it was stopped for still
+    // counts towards the write allowance.
+    if (!le_timer_IsRunning(BackupTickTimer))
+    {
+        TopUpBackupWriteAllowance(now.sec - LastBackupTick);
+        LastBackupTick = now.sec;
+        LE_ASSERT(le_timer_Start(BackupTickTimer) == LE_OK);
+    }
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Create an Observation object.  This allocates the object and initializes the class members,
- * but not the parent class members.
- *
- * @return Pointer to the new object or NULL if failed to allocate an observation.
+ * Called on the main thread when the Backup Writer has finished a backup job.
  */
 //--------------------------------------------------------------------------------------------------
-res_Resource_t* obs_Create
+static void BackupJobDone
 (
-    resTree_EntryRef_t entryRef ///< The resource tree entry to attach this Resource to.
+    BackupJob_t* jobPtr
 )
 //--------------------------------------------------------------------------------------------------
 {
-    Observation_t* obsPtr = hub_MemAlloc(ObservationPool);
+    Observation_t* obsPtr = jobPtr->obsPtr;
 
-    if (obsPtr == NULL)
+    if (jobPtr->isOutstanding)
     {
-        LE_ERROR("Failed to allocate observation");
-        return NULL;
+        le_dls_Remove(&OutstandingBackupJobs, &jobPtr->outstandingLink);
     }
-    res_Construct(&obsPtr->resource, entryRef);
-
-    obsPtr->lowLimit = NAN;
-    obsPtr->highLimit = NAN;
-    obsPtr->changeBy = NAN;
-    obsPtr->minPeriod = NAN;
-
-    obsPtr->maxCount = 0;
-    obsPtr->count = 0;
 
-    obsPtr->transformType = OBS_TRANSFORM_TYPE_NONE;
-
-    obsPtr->bufferedType = IO_DATA_TYPE_TRIGGER;
-
-    obsPtr->backupPeriod = 0;
-    obsPtr->lastBackupTime = 0;
-    obsPtr->backupTimer = NULL;
-
-    obsPtr->sampleList = LE_SLS_LIST_INIT;
+    if (jobPtr->imageRef != NULL)
+    {
+        backupWriter_DeleteImage(jobPtr->imageRef);
+    }
 
-    obsPtr->readOpList = LE_DLS_LIST_INIT;
+    if (obsPtr != NULL)
+    {
+        obsPtr->backupJobPtr = NULL;
 
-    obsPtr->jsonExtraction[0] = '\0';
+        if (!jobPtr->isOk && (jobPtr->type == BACKUP_JOB_PACK))
+        {
+            // The backup file and log weren't deleted, and a backup new to the pack wasn't added.
+            obsPtr->hasLog = (obsPtr->hasLog || jobPtr->deleteLog);
+            obsPtr->isPacked = (obsPtr->isPacked && !jobPtr->deleteFile);
+        }
+        else if (!jobPtr->isOk && (jobPtr->type != BACKUP_JOB_FILE))
+        {
+            // The log may now end with part of a frame, or be missing a segment, which would
+            // stop its replay at that point, so start it over.  If it was the base that failed,
+            // wait for the next backup to try again rather than retrying over and over.
+            obsPtr->logNeedsBase = true;
+            if (jobPtr->type != BACKUP_JOB_LOG_BASE)
+            {
+                obsPtr->backupPending = true;
+            }
+        }
 
-    obsPtr->destination[0] = '\0';
+        // A backup that was wanted while this one was being written is done at the next tick.
+        if (obsPtr->backupPending)
+        {
+            obsPtr->backupPending = false;
+            ScheduleBackup(obsPtr, 0);
+        }
+    }
 
-    return &obsPtr->resource;
+    le_mem_Release(jobPtr);
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Restore an Observation's data buffer from non-volatile backup, if one exists.
+ * Called on the main thread when the Backup Writer has finished a batch of backup jobs.
  */
 //--------------------------------------------------------------------------------------------------
-void obs_RestoreBackup
+static void BackupBatchDone
 (
-    res_Resource_t* resPtr
+    void* contextPtr    ///< The batch.
 )
 //--------------------------------------------------------------------------------------------------
 {
-#if LE_CONFIG_FILESYSTEM
-    Observation_t* obsPtr = CONTAINER_OF(resPtr, Observation_t, resource);
+    BackupBatch_t* batchPtr = contextPtr;
+    le_dls_Link_t* linkPtr;
 
-    // If there's no backup directory yet, then we know there are no backups, so don't
-    // try opening one (which would result in an error message in the logs because the lock file
-    // can't be created).
-    struct stat st = {0};
-    if (stat(BACKUP_DIR, &st) == -1)
+    while ((linkPtr = le_dls_Pop(&batchPtr->jobList)) != NULL)
     {
-        LE_DEBUG("Backup directory '" BACKUP_DIR "' not found. (%m)");
-        return;
+        BackupJobDone(CONTAINER_OF(linkPtr, BackupJob_t, link));
     }
 
-    char path[MAX_BACKUP_FILE_PATH_BYTES];
-    if (GetBackupFilePath(path, sizeof(path), obsPtr) != LE_OK)
-    {
-        return;
-    }
+    le_mem_Release(batchPtr);
+}
 
-    LE_INFO("Loading observation buffer from file '%s'.", path);
 
-    // Open the file for reading.
-    le_result_t result;
-    FILE* file = le_atomFile_OpenStream(path, LE_FLOCK_READ, &result);
-    if (result != LE_OK)
+//--------------------------------------------------------------------------------------------------
+/**
+ * Submit the backup jobs waiting to be submitted (if any) to the Backup Writer, as one batch.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SubmitBackupBatch
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (le_dls_IsEmpty(&PendingBackupJobs))
     {
-        LE_DEBUG("Unable to open '%s' for reading (%s).", path, LE_RESULT_TXT(result));
         return;
     }
 
-    // Read the version byte.
-    uint8_t byte;
-    if (ReadFromFile(&byte, 1, file) != LE_OK)
-    {
-        LE_ERROR("Failed to read version byte.");
-        return;
-    }
-    if (byte != 0)
-    {
-        LE_CRIT("Backup file format version %d unrecognized.", (int)byte);
-        le_atomFile_CancelStream(file);
-        return;
-    }
+    BackupBatch_t* batchPtr = le_mem_ForceAlloc(BackupBatchPool);
+    batchPtr->jobList = LE_DLS_LIST_INIT;
 
-    // Read the data type code.
-    if (ReadFromFile(&byte, 1, file) != LE_OK)
-    {
-        LE_ERROR("Failed to read data type code.");
-        return;
-    }
-    io_DataType_t dataType;
-    if (!GetDataTypeFromCode(&dataType, byte))
+    le_dls_Link_t* linkPtr;
+    while ((linkPtr = le_dls_Pop(&PendingBackupJobs)) != NULL)
     {
-        le_atomFile_CancelStream(file);
-        return;
+        le_dls_Queue(&batchPtr->jobList, linkPtr);
     }
-    obsPtr->bufferedType = dataType;
 
-    // Read the number of samples.
-    uint32_t count;
-    if (ReadFromFile(&count, 4, file) != LE_OK)
-    {
-        LE_ERROR("Failed to read number of samples.");
-        return;
-    }
+    // The writer thread doesn't touch the jobs' outstanding links or sequence numbers.
+    uint64_t writerSeq = backupWriter_Submit(WriteBackupBatch, BackupBatchDone, batchPtr);
 
-    // The maximum count must be at least the number we read.
-    if (obsPtr->maxCount == 0)
+    for (linkPtr = le_dls_Peek(&batchPtr->jobList);
+         linkPtr != NULL;
+         linkPtr = le_dls_PeekNext(&batchPtr->jobList, linkPtr))
     {
-        obsPtr->maxCount = count;
+        BackupJob_t* jobPtr = CONTAINER_OF(linkPtr, BackupJob_t, link);
+        jobPtr->isOutstanding = true;
+        jobPtr->writerSeq = writerSeq;
+        le_dls_Queue(&OutstandingBackupJobs, &jobPtr->outstandingLink);
     }
-    // NOTE: Don't enable backups, though, because we don't know the frequency to choose
-    //       and flash wear can permanently damage a device.
-
-    // Read all the data samples from the file.
-    ReadSamplesFromFile(obsPtr, file, count);
-#else /* !LE_CONFIG_FILESYSTEM */
-    // TODO: read from non-volatile storage without a filesystem.
-    LE_UNUSED(resPtr);
-#endif /* end !LE_CONFIG_FILESYSTEM */
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Perform JSON extraction.  If the data type is not JSON, does nothing.
+ * Add a backup job to the next batch to be submitted to the Backup Writer (see
+ * SubmitBackupBatch()).  The job takes ownership of the image (if any).
  *
- * @return LE_OK if successful.
+ * @return Pointer to the job.
  */
 //--------------------------------------------------------------------------------------------------
-le_result_t obs_DoJsonExtraction
+static BackupJob_t* SubmitBackupJob
 (
-    res_Resource_t* resPtr,
-    io_DataType_t* dataTypePtr,     ///< [INOUT] the data type, may be changed by JSON extraction
-    dataSample_Ref_t* valueRefPtr   ///< [INOUT] the data sample, may be replaced by JSON extraction
+    Observation_t* obsPtr,  ///< Observation backed up, or NULL if not to be told when done.
+    BackupJobType_t type,
+    const char* backupPath, ///< Path of the Observation's backup file (see GetBackupFilePath()).
+    backupWriter_ImageRef_t imageRef,   ///< Contents to write, or NULL if deleting.
+    uint32_t segment        ///< Number of the backup log segment to write.
 )
 //--------------------------------------------------------------------------------------------------
 {
-    Observation_t* obsPtr = CONTAINER_OF(resPtr, Observation_t, resource);
-
-    // If JSON extraction is enabled,
-    if (obsPtr->jsonExtraction[0] != '\0')
+    BackupJob_t* jobPtr = le_mem_ForceAlloc(BackupJobPool);
+
+    jobPtr->link = LE_DLS_LINK_INIT;
+    jobPtr->outstandingLink = LE_DLS_LINK_INIT;
+    jobPtr->isOutstanding = false;
+    jobPtr->type = type;
+    jobPtr->obsPtr = obsPtr;
+    jobPtr->imageRef = imageRef;
+    jobPtr->segment = segment;
+    jobPtr->crc = 0;
+    jobPtr->writerSeq = 0;
+    jobPtr->deleteLog = false;
+    jobPtr->deleteFile = false;
+    jobPtr->dropFromPack = false;
+    jobPtr->isOk = false;
+    LE_ASSERT(le_utf8_Copy(jobPtr->backupPath, backupPath, sizeof(jobPtr->backupPath), NULL)
+              == LE_OK);
+
+    if (obsPtr != NULL)
     {
-        if (*dataTypePtr != IO_DATA_TYPE_JSON)
+        obsPtr->backupJobPtr = jobPtr;
+
+        if (((type == BACKUP_JOB_FILE) || (type == BACKUP_JOB_PACK)) && obsPtr->hasLog)
         {
-            LE_WARN("Ignoring non-JSON value pushed to observation configured to extract JSON.");
-            return LE_FAULT;
+            jobPtr->deleteLog = true;
+            obsPtr->hasLog = false;
+            obsPtr->logNeedsBase = true;
         }
 
-        // Extract the appropriate JSON data element from the value.
-        io_DataType_t extractedType;
-        dataSample_Ref_t extractedValue = dataSample_ExtractJson(*valueRefPtr,
-                                                                 obsPtr->jsonExtraction,
-                                                                 &extractedType);
-        if (extractedValue == NULL)
+        // A backup moving into the pack leaves a backup file behind, and a backup moving out of
+        // the pack leaves a stale copy in it.
+        if (type == BACKUP_JOB_PACK)
         {
-            // Extraction failed.
-            return LE_FAULT;
+            jobPtr->deleteFile = !obsPtr->isPacked;
+            obsPtr->isPacked = true;
+        }
+        else if ((type == BACKUP_JOB_FILE) || (type == BACKUP_JOB_LOG_BASE))
+        {
+            jobPtr->dropFromPack = obsPtr->isPacked;
+            obsPtr->isPacked = false;
         }
-
-        // Extraction succeeded, so replace value data sample with extracted one.
-        le_mem_Release(*valueRefPtr);
-        *valueRefPtr = extractedValue;
-        *dataTypePtr = extractedType;
     }
 
-    return LE_OK;
+    le_dls_Queue(&PendingBackupJobs, &jobPtr->link);
+
+    return jobPtr;
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Determine whether the value should be accepted by a given Observation.
- *
- * @warning JSON extraction should be performed first if the data type is JSON.
- *
- * @return true if the value should be accepted.
+ * Cancel a given Observation's scheduled backup, and stop waiting for its backup that is being
+ * written (if any).  The backup being written still gets written.
  */
 //--------------------------------------------------------------------------------------------------
-bool obs_ShouldAccept
+static void DetachBackupJob
 (
-    res_Resource_t* resPtr,
-    io_DataType_t dataType,     ///< [IN] the data type
-    dataSample_Ref_t valueRef   ///< [IN] the data sample
+    Observation_t* obsPtr
 )
 //--------------------------------------------------------------------------------------------------
 {
-    Observation_t* obsPtr = CONTAINER_OF(resPtr, Observation_t, resource);
+    UnscheduleBackup(obsPtr);
 
-    // Check the high limit and low limit before other limits.
-    if (dataType == IO_DATA_TYPE_NUMERIC)
+    if (obsPtr->backupJobPtr != NULL)
     {
-        double numericValue = dataSample_GetNumeric(valueRef);
+        obsPtr->backupJobPtr->obsPtr = NULL;
+        obsPtr->backupJobPtr = NULL;
+    }
 
-        // If both limits are enabled and the low limit is higher than the high limit, then
-        // this is the "deadband" case. ( - <------HxxxxxxxxxL------> + )
-        if (   (!isnan(obsPtr->highLimit))
-            && (!isnan(obsPtr->lowLimit))
-            && (obsPtr->lowLimit > obsPtr->highLimit)  )
-        {
-            if ((numericValue < obsPtr->lowLimit) && (numericValue > obsPtr->highLimit))
-            {
-                return false;
-            }
-        }
-        // In all other cases, reject if lower than non-NAN low limit or higher than non-NAN high.
-        else
-        {
-            if ((!isnan(obsPtr->lowLimit)) && (numericValue < obsPtr->lowLimit))
+    obsPtr->backupPending = false;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Wait for the Backup Writer to finish any backup jobs still being written that could change a
+ * given backup file, its backup log or its backup in the pack.  Other jobs are left to be written
+ * in the background (the backup pack is locked while they change it; see PackMutex).
+ */
+//--------------------------------------------------------------------------------------------------
+static void WaitForBackupWrites
+(
+    const char* backupPath  ///< Path of the Observation's backup file (see GetBackupFilePath()).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    // Outstanding jobs are in the order they were submitted, so the newest one for this backup
+    // is the last to wait for.
+    uint64_t writerSeq = 0;
+
+    le_dls_Link_t* linkPtr;
+    for (linkPtr = le_dls_Peek(&OutstandingBackupJobs);
+         linkPtr != NULL;
+         linkPtr = le_dls_PeekNext(&OutstandingBackupJobs, linkPtr))
+    {
+        BackupJob_t* jobPtr = CONTAINER_OF(linkPtr, BackupJob_t, outstandingLink);
+
+        if (strcmp(jobPtr->backupPath, backupPath) == 0)
+        {
+            writerSeq = jobPtr->writerSeq;
+        }
+    }
+
+    if (writerSeq == 0)
+    {
+        return;
+    }
+
+    backupWriter_WaitFor(writerSeq);
+
+    // Everything submitted up to then has now been written, although the jobs aren't done with
+    // until their batches' completion functions run.
+    while (   ((linkPtr = le_dls_Peek(&OutstandingBackupJobs)) != NULL)
+           && (CONTAINER_OF(linkPtr, BackupJob_t, outstandingLink)->writerSeq <= writerSeq)  )
+    {
+        le_dls_Remove(&OutstandingBackupJobs, linkPtr);
+        CONTAINER_OF(linkPtr, BackupJob_t, outstandingLink)->isOutstanding = false;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Delete the observation's buffer backup file, backup log and backup in the pack, if they exist.
+ * They are deleted by the Backup Writer's thread, after any backups still being written.
+ */
+//--------------------------------------------------------------------------------------------------
+static void DeleteBackup
+(
+    Observation_t* obsPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    DetachBackupJob(obsPtr);
+
+    char path[MAX_BACKUP_FILE_PATH_BYTES];
+    le_result_t result = GetBackupFilePath(path, sizeof(path), obsPtr);
+    if (result == LE_OK)
+    {
+        SubmitBackupJob(NULL, BACKUP_JOB_DELETE, path, NULL, 0);
+        SubmitBackupBatch();
+    }
+
+    obsPtr->hasLog = false;
+    obsPtr->logNeedsBase = true;
+    obsPtr->isPacked = false;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether buffered samples of a given data type are held by Data Sample reference
+ * (rather than being stored inline in the ring buffer).
+ *
+ * @return true if string or JSON.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline bool IsBufferedByRef
+(
+    io_DataType_t dataType
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return ((dataType == IO_DATA_TYPE_STRING) || (dataType == IO_DATA_TYPE_JSON));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether buffered samples of a given data type have a numerical value (numeric or Boolean).
+ *
+ * @return true if numerical.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline bool IsNumerical
+(
+    io_DataType_t dataType
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return ((dataType == IO_DATA_TYPE_NUMERIC) || (dataType == IO_DATA_TYPE_BOOLEAN));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the ring buffer slot that holds the sample at a given position in an Observation's buffer.
+ *
+ * @return The slot index.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline size_t BufferSlot
+(
+    const Observation_t* obsPtr,
+    size_t index    ///< Position in the buffer (0 = oldest, count - 1 = newest).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return (obsPtr->head + index) & (obsPtr->capacity - 1);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the compressed block at a given position in an Observation's ring of blocks.
+ *
+ * @return Ptr to the block.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline CompressedBlock_t* GetBlock
+(
+    const Observation_t* obsPtr,
+    size_t position ///< Position in the ring of blocks (0 = oldest, blockCount - 1 = newest).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return obsPtr->blocks[(obsPtr->blockHead + position) & (obsPtr->blockCapacity - 1)];
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Binary search an Observation's ring of compressed blocks for the one holding the sample with a
+ * given sequence number.  This is O(log N) in the number of blocks.
+ *
+ * @return The position of the block in the ring of blocks (0 = oldest).
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t FindBlock
+(
+    const Observation_t* obsPtr,
+    uint64_t seq    ///< Sequence number of a buffered sample.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    size_t first = 0;
+    size_t end = obsPtr->blockCount;
+
+    // Find the newest block whose first sample is no newer than the one wanted.
+    while ((end - first) > 1)
+    {
+        size_t middle = first + ((end - first) / 2);
+
+        if (GetBlock(obsPtr, middle)->firstSeq <= seq)
+        {
+            first = middle;
+        }
+        else
+        {
+            end = middle;
+        }
+    }
+
+    return first;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decode the sample at a given position in an Observation's compressed buffer.
+ *
+ * The oldest and newest samples are always at hand.  Others are decoded from the start of their
+ * block, unless they follow the sample last decoded from the same block, so reading samples in
+ * order costs O(1) each.
+ */
+//--------------------------------------------------------------------------------------------------
+static void DecodeBufferedSample
+(
+    Observation_t* obsPtr,
+    size_t index,           ///< Position in the buffer (0 = oldest, count - 1 = newest).
+    double* timestampPtr,   ///< [OUT] Timestamp of the sample.
+    double* valuePtr        ///< [OUT] Value of the sample.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (index == 0)
+    {
+        *timestampPtr = obsPtr->headTimestamp;
+        *valuePtr = obsPtr->headValue;
+        return;
+    }
+
+    if (index == (obsPtr->count - 1))
+    {
+        CompressedBlock_t* blockPtr = GetBlock(obsPtr, obsPtr->blockCount - 1);
+
+        *timestampPtr = blockPtr->lastTimestamp;
+        *valuePtr = blockPtr->lastValue;
+        return;
+    }
+
+    uint64_t seq = obsPtr->headSeq + index;
+    CompressedBlock_t* blockPtr = obsPtr->cacheBlockPtr;
+
+    if (   (blockPtr == NULL)
+        || (seq < blockPtr->firstSeq)
+        || (seq >= (blockPtr->firstSeq + sampleBlock_GetCount(&blockPtr->data)))  )
+    {
+        blockPtr = GetBlock(obsPtr, FindBlock(obsPtr, seq));
+    }
+
+    uint32_t position = seq - blockPtr->firstSeq;
+
+    if ((blockPtr != obsPtr->cacheBlockPtr) || (obsPtr->cacheCursor.count > (position + 1)))
+    {
+        obsPtr->cacheBlockPtr = blockPtr;
+        sampleBlock_StartRead(&obsPtr->cacheCursor);
+    }
+
+    while (obsPtr->cacheCursor.count <= position)
+    {
+        sampleBlock_ReadNext(&blockPtr->data,
+                             &obsPtr->cacheCursor,
+                             &obsPtr->cacheTimestamp,
+                             &obsPtr->cacheValue);
+    }
+
+    *timestampPtr = obsPtr->cacheTimestamp;
+    *valuePtr = obsPtr->cacheValue;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the timestamp of the sample at a given position in an Observation's buffer.
+ *
+ * @return The timestamp.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline double GetBufferedTimestamp
+(
+    Observation_t* obsPtr,
+    size_t index    ///< Position in the buffer (0 = oldest, count - 1 = newest).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (obsPtr->isCompressed)
+    {
+        double timestamp;
+        double value;
+
+        DecodeBufferedSample(obsPtr, index, &timestamp, &value);
+
+        return timestamp;
+    }
+
+    return obsPtr->timestamps[BufferSlot(obsPtr, index)];
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get a buffered sample's numerical value.  This works for numeric or Boolean types only.
+ *
+ * @return The value.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline double GetBufferedNumber
+(
+    Observation_t* obsPtr,
+    size_t index    ///< Position in the buffer (0 = oldest, count - 1 = newest).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (obsPtr->isCompressed)
+    {
+        double timestamp;
+        double value;
+
+        DecodeBufferedSample(obsPtr, index, &timestamp, &value);
+
+        return value;
+    }
+
+    // Booleans are buffered as 1.0 or 0.0, so they need no conversion.
+    return obsPtr->values[BufferSlot(obsPtr, index)].number;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Count memory allocated for a given Observation's buffer against its maximum number of bytes and
+ * the hub's buffer memory budget.  This is called with the size of each allocation as it is made:
+ * the ring buffer (including its unused slots and the minimum and maximum deques), the range
+ * statistics index, the ring of compressed blocks and the blocks themselves, and the strings held
+ * by string and JSON samples.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ChargeBufferMemory
+(
+    Observation_t* obsPtr,
+    size_t bytes
+)
+//--------------------------------------------------------------------------------------------------
+{
+    obsPtr->bytes += bytes;
+    BufferedBytes += bytes;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Stop counting memory released from a given Observation's buffer (see ChargeBufferMemory()).
+ */
+//--------------------------------------------------------------------------------------------------
+static void RefundBufferMemory
+(
+    Observation_t* obsPtr,
+    size_t bytes
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LE_ASSERT(obsPtr->bytes >= bytes);
+
+    obsPtr->bytes -= bytes;
+    BufferedBytes -= bytes;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compute the number of ring buffer slots to allocate to hold a given number of samples.
+ *
+ * @return The capacity (a power of 2).  Never more than 2^MAX_RING_CAPACITY_BITS.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t GetRingCapacity
+(
+    size_t maxCount
+)
+//--------------------------------------------------------------------------------------------------
+{
+    size_t bits = MIN_RING_CAPACITY_BITS;
+
+    while ((bits < MAX_RING_CAPACITY_BITS) && (((size_t)1 << bits) < maxCount))
+    {
+        bits++;
+    }
+
+    return ((size_t)1 << bits);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the pool that blocks sized for a given ring buffer capacity are allocated from, creating it
+ * if necessary.
+ *
+ * @return The pool.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t GetSizeClassPool
+(
+    le_mem_PoolRef_t* pools,    ///< Array of RING_POOL_COUNT pools, one per capacity.
+    const char* namePrefix,     ///< Pool name prefix (the capacity is appended).
+    size_t capacity,    ///< Number of slots (must be a power of 2 returned by GetRingCapacity()).
+    size_t bytesPerSlot ///< Size of a block divided by the capacity.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    size_t bits = MIN_RING_CAPACITY_BITS;
+
+    while (((size_t)1 << bits) < capacity)
+    {
+        bits++;
+    }
+    LE_ASSERT(bits <= MAX_RING_CAPACITY_BITS);
+
+    le_mem_PoolRef_t* poolRefPtr = &pools[bits - MIN_RING_CAPACITY_BITS];
+
+    if (*poolRefPtr == NULL)
+    {
+        char name[32];
+        (void)snprintf(name, sizeof(name), "%s%zu", namePrefix, capacity);
+
+        *poolRefPtr = le_mem_CreatePool(name, capacity * bytesPerSlot);
+    }
+
+    return *poolRefPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Allocate a block from one of the size class pools.
+ *
+ * @return Ptr to the block, or NULL if out of memory.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* AllocSizeClassBlock
+(
+    le_mem_PoolRef_t pool
+)
+//--------------------------------------------------------------------------------------------------
+{
+    void* blockPtr = hub_MemAlloc(pool);
+
+#if !LE_CONFIG_LINUX
+    // Size class pools are created empty, so grow them on demand.
+    if (blockPtr == NULL)
+    {
+        le_mem_ExpandPool(pool, 1);
+        blockPtr = le_mem_TryAlloc(pool);
+    }
+#endif
+
+    return blockPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the pool that ring buffers of a given capacity are allocated from, creating it if necessary.
+ *
+ * Each block holds the timestamp array, followed by the value array, followed by the slot arrays
+ * of the minimum and maximum deques.
+ *
+ * @return The pool.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t GetRingPool
+(
+    size_t capacity ///< Number of slots (must be a power of 2 returned by GetRingCapacity()).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return GetSizeClassPool(RingPools, "ObsRing", capacity, RING_SLOT_BYTES);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Move a slot deque into a new slot array, translating the slot numbers for a ring buffer that is
+ * being moved so that its oldest sample ends up in slot 0.
+ */
+//--------------------------------------------------------------------------------------------------
+static void MoveSlotDeque
+(
+    SlotDeque_t* dequePtr,
+    uint32_t* newSlots,     ///< Slot array of the new ring (NULL if the ring is being released).
+    size_t oldHead,         ///< Slot of the oldest sample in the old ring.
+    size_t oldCapacity      ///< Number of slots in the old ring.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    for (size_t i = 0; i < dequePtr->len; i++)
+    {
+        uint32_t oldSlot = dequePtr->slots[(dequePtr->head + i) & (oldCapacity - 1)];
+
+        newSlots[i] = (oldSlot - oldHead) & (oldCapacity - 1);
+    }
+
+    dequePtr->slots = newSlots;
+    dequePtr->head = 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add a buffered sample to the back of a minimum or maximum slot deque, first dropping from the
+ * back any samples that can no longer be the minimum (or maximum) because the new sample is
+ * smaller (or larger) and will stay in the buffer longer than they will.
+ */
+//--------------------------------------------------------------------------------------------------
+static void PushSlotDeque
+(
+    Observation_t* obsPtr,
+    SlotDeque_t* dequePtr,
+    size_t slot,        ///< Ring buffer slot of the new sample.
+    bool isMin          ///< true for the minimum deque, false for the maximum deque.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    size_t mask = obsPtr->capacity - 1;
+    double value = obsPtr->values[slot].number;
+
+    while (dequePtr->len > 0)
+    {
+        size_t backSlot = dequePtr->slots[(dequePtr->head + dequePtr->len - 1) & mask];
+        double backValue = obsPtr->values[backSlot].number;
+
+        if (isMin ? (backValue < value) : (backValue > value))
+        {
+            break;
+        }
+
+        dequePtr->len--;
+    }
+
+    dequePtr->slots[(dequePtr->head + dequePtr->len) & mask] = slot;
+    dequePtr->len++;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Remove a sample that is being dropped from the buffer from the front of a slot deque,
+ * if it is there.
+ */
+//--------------------------------------------------------------------------------------------------
+static void PopSlotDeque
+(
+    Observation_t* obsPtr,
+    SlotDeque_t* dequePtr,
+    size_t slot         ///< Ring buffer slot of the sample being dropped.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if ((dequePtr->len > 0) && (dequePtr->slots[dequePtr->head] == slot))
+    {
+        dequePtr->head = (dequePtr->head + 1) & (obsPtr->capacity - 1);
+        dequePtr->len--;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Recompute the running mean and sum of squared differences of an Observation's buffered values
+ * from scratch, to discard the rounding errors accumulated by removing values from them.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RecomputeStats
+(
+    Observation_t* obsPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    double sum = 0;
+    size_t count = 0;
+
+    for (size_t i = 0; i < obsPtr->count; i++)
+    {
+        double value = obsPtr->values[BufferSlot(obsPtr, i)].number;
+
+        if (!isnan(value))
+        {
+            sum += value;
+            count++;
+        }
+    }
+
+    double mean = (count > 0) ? (sum / count) : 0;
+    double m2 = 0;
+
+    for (size_t i = 0; i < obsPtr->count; i++)
+    {
+        double value = obsPtr->values[BufferSlot(obsPtr, i)].number;
+
+        if (!isnan(value))
+        {
+            m2 += (value - mean) * (value - mean);
+        }
+    }
+
+    obsPtr->statCount = count;
+    obsPtr->statMean = mean;
+    obsPtr->statM2 = m2;
+    obsPtr->statRemovals = 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add a (non-NAN) value to an Observation's running mean and variance.
+ */
+//--------------------------------------------------------------------------------------------------
+static void AddToRunningStats
+(
+    Observation_t* obsPtr,
+    double value
+)
+//--------------------------------------------------------------------------------------------------
+{
+    // Welford's method.
+    obsPtr->statCount++;
+    double delta = value - obsPtr->statMean;
+    obsPtr->statMean += delta / obsPtr->statCount;
+    obsPtr->statM2 += delta * (value - obsPtr->statMean);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Remove a (non-NAN) value from an Observation's running mean and variance.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RemoveFromRunningStats
+(
+    Observation_t* obsPtr,
+    double value
+)
+//--------------------------------------------------------------------------------------------------
+{
+    obsPtr->statCount--;
+
+    if (obsPtr->statCount == 0)
+    {
+        obsPtr->statMean = 0;
+        obsPtr->statM2 = 0;
+        obsPtr->statRemovals = 0;
+    }
+    else
+    {
+        // Welford's method, in reverse.
+        double delta = value - obsPtr->statMean;
+        obsPtr->statMean -= delta / obsPtr->statCount;
+        obsPtr->statM2 -= delta * (value - obsPtr->statMean);
+        if (obsPtr->statM2 < 0)
+        {
+            obsPtr->statM2 = 0;
+        }
+        obsPtr->statRemovals++;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Update an Observation's running statistics for a numerical sample just added to its buffer.
+ */
+//--------------------------------------------------------------------------------------------------
+static void AddToStats
+(
+    Observation_t* obsPtr,
+    size_t slot         ///< Ring buffer slot of the new sample.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    double value = obsPtr->values[slot].number;
+
+    if (isnan(value))
+    {
+        return;
+    }
+
+    AddToRunningStats(obsPtr, value);
+
+    PushSlotDeque(obsPtr, &obsPtr->minDeque, slot, true);
+    PushSlotDeque(obsPtr, &obsPtr->maxDeque, slot, false);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Update an Observation's running statistics for a numerical sample about to be dropped from the
+ * oldest end of its buffer.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RemoveFromStats
+(
+    Observation_t* obsPtr,
+    size_t slot         ///< Ring buffer slot of the sample being dropped.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    double value = obsPtr->values[slot].number;
+
+    if (isnan(value))
+    {
+        return;
+    }
+
+    RemoveFromRunningStats(obsPtr, value);
+
+    PopSlotDeque(obsPtr, &obsPtr->minDeque, slot);
+    PopSlotDeque(obsPtr, &obsPtr->maxDeque, slot);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Fold one set of range statistics into another, as if the values they summarize were combined
+ * (Chan et al.'s parallel variant of Welford's method).
+ */
+//--------------------------------------------------------------------------------------------------
+static void MergeRangeStats
+(
+    RangeStats_t* accPtr,           ///< [IN/OUT] Statistics to merge into.
+    const RangeStats_t* otherPtr    ///< [IN] Statistics to merge in.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (otherPtr->count == 0)
+    {
+        return;
+    }
+
+    if (accPtr->count == 0)
+    {
+        *accPtr = *otherPtr;
+        return;
+    }
+
+    size_t count = accPtr->count + otherPtr->count;
+    double delta = otherPtr->mean - accPtr->mean;
+    double otherWeight = (double)otherPtr->count / count;
+
+    accPtr->m2 += otherPtr->m2 + (delta * delta * accPtr->count * otherWeight);
+    accPtr->mean += delta * otherWeight;
+    accPtr->count = count;
+
+    if (otherPtr->min < accPtr->min)
+    {
+        accPtr->min = otherPtr->min;
+    }
+    if (otherPtr->max > accPtr->max)
+    {
+        accPtr->max = otherPtr->max;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the range statistics index leaf of a ring buffer slot, and update the nodes above it.
+ * This is O(log N) in the ring capacity.
+ */
+//--------------------------------------------------------------------------------------------------
+static void UpdateIndex
+(
+    Observation_t* obsPtr,
+    size_t slot,        ///< Ring buffer slot.
+    bool isOccupied     ///< true if the slot holds a numerical value, false if it is now vacant.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    RangeStats_t* index = obsPtr->index;
+    size_t node = obsPtr->capacity + slot;
+
+    index[node].count = 0;
+
+    if (isOccupied)
+    {
+        double value = obsPtr->values[slot].number;
+
+        if (!isnan(value))
+        {
+            index[node] = (RangeStats_t){ 1, value, 0, value, value };
+        }
+    }
+
+    for (node /= 2; node > 0; node /= 2)
+    {
+        index[node] = index[2 * node];
+        MergeRangeStats(&index[node], &index[(2 * node) + 1]);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Build an Observation's range statistics index from the numerical values in its buffer.
+ * This is O(N) in the ring capacity.
+ *
+ * The index only speeds up queries, so it isn't built if its memory would take the buffer over
+ * its maximum number of bytes or the hub over its buffer memory budget.
+ *
+ * @return
+ *      - LE_OK if successful.
+ *      - LE_OVERFLOW if the index would use more memory than the limits allow.
+ *      - LE_NO_MEMORY if the index couldn't be allocated.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t BuildIndex
+(
+    Observation_t* obsPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    size_t capacity = obsPtr->capacity;
+    size_t indexBytes = capacity * INDEX_SLOT_BYTES;
+
+    if (   ((obsPtr->maxBytes > 0) && ((obsPtr->bytes + indexBytes) > obsPtr->maxBytes))
+        || ((BufferBudget > 0) && ((BufferedBytes + indexBytes) > BufferBudget))  )
+    {
+        return LE_OVERFLOW;
+    }
+
+    RangeStats_t* index = AllocSizeClassBlock(GetSizeClassPool(IndexPools,
+                                                               "ObsIndex",
+                                                               capacity,
+                                                               INDEX_SLOT_BYTES));
+    if (index == NULL)
+    {
+        LE_ERROR("Failed to allocate an index of %zu samples", capacity);
+        return LE_NO_MEMORY;
+    }
+
+    for (size_t slot = 0; slot < capacity; slot++)
+    {
+        index[capacity + slot].count = 0;
+    }
+
+    for (size_t i = 0; i < obsPtr->count; i++)
+    {
+        size_t slot = BufferSlot(obsPtr, i);
+        double value = obsPtr->values[slot].number;
+
+        if (!isnan(value))
+        {
+            index[capacity + slot] = (RangeStats_t){ 1, value, 0, value, value };
+        }
+    }
+
+    for (size_t node = capacity - 1; node > 0; node--)
+    {
+        index[node] = index[2 * node];
+        MergeRangeStats(&index[node], &index[(2 * node) + 1]);
+    }
+
+    obsPtr->index = index;
+    ChargeBufferMemory(obsPtr, indexBytes);
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Release an Observation's range statistics index, if it has one.  It will be rebuilt when next
+ * needed.
+ */
+//--------------------------------------------------------------------------------------------------
+static void DiscardIndex
+(
+    Observation_t* obsPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (obsPtr->index != NULL)
+    {
+        le_mem_Release(obsPtr->index);
+        obsPtr->index = NULL;
+        RefundBufferMemory(obsPtr, obsPtr->capacity * INDEX_SLOT_BYTES);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Merge the statistics of a span of ring buffer slots from the range statistics index.
+ * This is O(log N) in the ring capacity.
+ */
+//--------------------------------------------------------------------------------------------------
+static void QueryIndex
+(
+    Observation_t* obsPtr,
+    size_t firstSlot,       ///< First slot in the span.
+    size_t endSlot,         ///< Slot after the last one in the span (at most the capacity).
+    RangeStats_t* statsPtr  ///< [IN/OUT] Statistics to merge into.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    const RangeStats_t* index = obsPtr->index;
+    size_t left = obsPtr->capacity + firstSlot;
+    size_t right = obsPtr->capacity + endSlot;
+
+    // Climb the tree from both ends of the span, merging in the nodes that cover its edges.
+    while (left < right)
+    {
+        if (left & 1)
+        {
+            MergeRangeStats(statsPtr, &index[left++]);
+        }
+        if (right & 1)
+        {
+            MergeRangeStats(statsPtr, &index[--right]);
+        }
+        left /= 2;
+        right /= 2;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Move an Observation's buffered samples into a new ring buffer with a given number of slots,
+ * releasing the old ring.  The oldest sample ends up in slot 0.
+ *
+ * If the new capacity is 0, the buffer must be empty and the ring is just released.
+ *
+ * @return
+ *      - LE_OK if successful.
+ *      - LE_NO_MEMORY if the new ring couldn't be allocated (the old one is left untouched).
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ResizeRing
+(
+    Observation_t* obsPtr,
+    size_t capacity ///< New number of slots (0 or a power of 2 returned by GetRingCapacity()).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    double* timestamps = NULL;
+    BufferValue_t* values = NULL;
+    uint32_t* minSlots = NULL;
+    uint32_t* maxSlots = NULL;
+
+    LE_ASSERT(obsPtr->count <= capacity);
+
+    if (capacity > 0)
+    {
+        le_mem_PoolRef_t pool = GetRingPool(capacity);
+
+        timestamps = AllocSizeClassBlock(pool);
+        if (timestamps == NULL)
+        {
+            LE_ERROR("Failed to allocate a buffer of %zu samples", capacity);
+            return LE_NO_MEMORY;
+        }
+        values = (BufferValue_t*)(timestamps + capacity);
+        minSlots = (uint32_t*)(values + capacity);
+        maxSlots = minSlots + capacity;
+
+        // Copy the samples across, oldest first.  They occupy at most two spans of the old ring.
+        if (obsPtr->count > 0)
+        {
+            size_t firstSpan = obsPtr->capacity - obsPtr->head;
+            if (firstSpan > obsPtr->count)
+            {
+                firstSpan = obsPtr->count;
+            }
+            size_t secondSpan = obsPtr->count - firstSpan;
+
+            memcpy(timestamps, obsPtr->timestamps + obsPtr->head, firstSpan * sizeof(double));
+            memcpy(values, obsPtr->values + obsPtr->head, firstSpan * sizeof(BufferValue_t));
+            memcpy(timestamps + firstSpan, obsPtr->timestamps, secondSpan * sizeof(double));
+            memcpy(values + firstSpan, obsPtr->values, secondSpan * sizeof(BufferValue_t));
+        }
+    }
+
+    MoveSlotDeque(&obsPtr->minDeque, minSlots, obsPtr->head, obsPtr->capacity);
+    MoveSlotDeque(&obsPtr->maxDeque, maxSlots, obsPtr->head, obsPtr->capacity);
+
+    // The samples have all changed slots, so the index is rebuilt when next needed.
+    DiscardIndex(obsPtr);
+
+    if (obsPtr->timestamps != NULL)
+    {
+        le_mem_Release(obsPtr->timestamps);
+        RefundBufferMemory(obsPtr, obsPtr->capacity * RING_SLOT_BYTES);
+    }
+    ChargeBufferMemory(obsPtr, capacity * RING_SLOT_BYTES);
+
+    obsPtr->timestamps = timestamps;
+    obsPtr->values = values;
+    obsPtr->capacity = capacity;
+    obsPtr->head = 0;
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Move an Observation's compressed blocks into a new ring of blocks with a given number of slots,
+ * releasing the old ring.  The oldest block ends up in slot 0.
+ *
+ * If the new capacity is 0, there must be no blocks and the ring is just released.
+ *
+ * @return
+ *      - LE_OK if successful.
+ *      - LE_NO_MEMORY if the new ring couldn't be allocated (the old one is left untouched).
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ResizeBlockRing
+(
+    Observation_t* obsPtr,
+    size_t capacity ///< New number of slots (0 or a power of 2 returned by GetRingCapacity()).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    CompressedBlock_t** blocks = NULL;
+    uint32_t* minSlots = NULL;
+    uint32_t* maxSlots = NULL;
+
+    LE_ASSERT(obsPtr->blockCount <= capacity);
+
+    if (capacity > 0)
+    {
+        blocks = AllocSizeClassBlock(GetSizeClassPool(BlockRingPools,
+                                                      "ObsBlocks",
+                                                      capacity,
+                                                      BLOCK_RING_SLOT_BYTES));
+        if (blocks == NULL)
+        {
+            LE_ERROR("Failed to allocate a ring of %zu compressed blocks", capacity);
+            return LE_NO_MEMORY;
+        }
+        minSlots = (uint32_t*)(blocks + capacity);
+        maxSlots = minSlots + capacity;
+
+        for (size_t i = 0; i < obsPtr->blockCount; i++)
+        {
+            blocks[i] = GetBlock(obsPtr, i);
+        }
+    }
+
+    MoveSlotDeque(&obsPtr->blockMinDeque, minSlots, obsPtr->blockHead, obsPtr->blockCapacity);
+    MoveSlotDeque(&obsPtr->blockMaxDeque, maxSlots, obsPtr->blockHead, obsPtr->blockCapacity);
+
+    if (obsPtr->blocks != NULL)
+    {
+        le_mem_Release(obsPtr->blocks);
+        RefundBufferMemory(obsPtr, obsPtr->blockCapacity * BLOCK_RING_SLOT_BYTES);
+    }
+    ChargeBufferMemory(obsPtr, capacity * BLOCK_RING_SLOT_BYTES);
+
+    obsPtr->blocks = blocks;
+    obsPtr->blockCapacity = capacity;
+    obsPtr->blockHead = 0;
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add the newest of an Observation's compressed blocks to the back of a minimum or maximum block
+ * deque, or move it there again after a value appended to it has become its new minimum (or
+ * maximum).  First drops from the back any blocks whose values can no longer be the minimum (or
+ * maximum) because they will be dropped before the newest block's.
+ */
+//--------------------------------------------------------------------------------------------------
+static void PushBlockDeque
+(
+    Observation_t* obsPtr,
+    SlotDeque_t* dequePtr,
+    bool isMin          ///< true for the minimum deque, false for the maximum deque.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    size_t mask = obsPtr->blockCapacity - 1;
+    size_t slot = (obsPtr->blockHead + obsPtr->blockCount - 1) & mask;
+    const RangeStats_t* statsPtr = &obsPtr->blocks[slot]->stats;
+    double value = (isMin ? statsPtr->min : statsPtr->max);
+
+    while (dequePtr->len > 0)
+    {
+        size_t backSlot = dequePtr->slots[(dequePtr->head + dequePtr->len - 1) & mask];
+        const RangeStats_t* backStatsPtr = &obsPtr->blocks[backSlot]->stats;
+
+        if (   (backSlot != slot)
+            && (isMin ? (backStatsPtr->min < value) : (backStatsPtr->max > value))  )
+        {
+            break;
+        }
+
+        dequePtr->len--;
+    }
+
+    dequePtr->slots[(dequePtr->head + dequePtr->len) & mask] = slot;
+    dequePtr->len++;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Remove a block that has become the oldest of an Observation's compressed blocks from the front
+ * of a block deque, if it is there.
+ */
+//--------------------------------------------------------------------------------------------------
+static void PopBlockDeque
+(
+    Observation_t* obsPtr,
+    SlotDeque_t* dequePtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if ((dequePtr->len > 0) && (dequePtr->slots[dequePtr->head] == obsPtr->blockHead))
+    {
+        dequePtr->head = (dequePtr->head + 1) & (obsPtr->blockCapacity - 1);
+        dequePtr->len--;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decode the oldest sample in the oldest of an Observation's compressed blocks, making it the
+ * oldest buffered sample.  None of the block's values have been dropped, so its statistics give
+ * the minimum and maximum of the values left in it.
+ */
+//--------------------------------------------------------------------------------------------------
+static void StartHeadBlock
+(
+    Observation_t* obsPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    CompressedBlock_t* blockPtr = GetBlock(obsPtr, 0);
+
+    sampleBlock_StartRead(&obsPtr->headCursor);
+    sampleBlock_ReadNext(&blockPtr->data,
+                         &obsPtr->headCursor,
+                         &obsPtr->headTimestamp,
+                         &obsPtr->headValue);
+
+    PopBlockDeque(obsPtr, &obsPtr->blockMinDeque);
+    PopBlockDeque(obsPtr, &obsPtr->blockMaxDeque);
+
+    obsPtr->headBlockMin = ((blockPtr->stats.count > 0) ? blockPtr->stats.min : NAN);
+    obsPtr->headBlockMax = ((blockPtr->stats.count > 0) ? blockPtr->stats.max : NAN);
+    obsPtr->headBlockStale = false;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Recompute the minimum and maximum of the values left in the oldest of an Observation's
+ * compressed blocks, by decoding them.  This is O(1) in the number of blocks.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RecomputeHeadBlockExtremes
+(
+    Observation_t* obsPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    CompressedBlock_t* blockPtr = GetBlock(obsPtr, 0);
+    sampleBlock_Cursor_t cursor = obsPtr->headCursor;
+    double value = obsPtr->headValue;
+
+    obsPtr->headBlockMin = NAN;
+    obsPtr->headBlockMax = NAN;
+
+    for (;;)
+    {
+        if (!isnan(value))
+        {
+            if (isnan(obsPtr->headBlockMin) || (value < obsPtr->headBlockMin))
+            {
+                obsPtr->headBlockMin = value;
+            }
+            if (isnan(obsPtr->headBlockMax) || (value > obsPtr->headBlockMax))
+            {
+                obsPtr->headBlockMax = value;
+            }
+        }
+
+        if (cursor.count >= sampleBlock_GetCount(&blockPtr->data))
+        {
+            break;
+        }
+
+        double timestamp;
+        sampleBlock_ReadNext(&blockPtr->data, &cursor, &timestamp, &value);
+    }
+
+    obsPtr->headBlockStale = false;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Recompute the running mean and sum of squared differences of an Observation's compressed
+ * buffer from the statistics of its blocks, to discard the rounding errors accumulated by
+ * removing values from them.  Must only be done when no values have been dropped from the oldest
+ * block.  This is O(N) in the number of blocks.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RecomputeBlockStats
+(
+    Observation_t* obsPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    RangeStats_t stats = { 0 };
+
+    for (size_t i = 0; i < obsPtr->blockCount; i++)
+    {
+        MergeRangeStats(&stats, &GetBlock(obsPtr, i)->stats);
+    }
+
+    obsPtr->statCount = stats.count;
+    obsPtr->statMean = ((stats.count > 0) ? stats.mean : 0);
+    obsPtr->statM2 = ((stats.count > 0) ? stats.m2 : 0);
+    obsPtr->statRemovals = 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the minimum and maximum values in an Observation's compressed buffer.  This is O(1) in the
+ * number of blocks.  The buffer must hold numerical values.
+ */
+//--------------------------------------------------------------------------------------------------
+static void GetBlockBufferExtremes
+(
+    Observation_t* obsPtr,
+    double* minPtr,     ///< [OUT] Smallest value.
+    double* maxPtr      ///< [OUT] Largest value.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (obsPtr->headBlockStale)
+    {
+        RecomputeHeadBlockExtremes(obsPtr);
+    }
+
+    *minPtr = obsPtr->headBlockMin;
+    *maxPtr = obsPtr->headBlockMax;
+
+    if (obsPtr->blockMinDeque.len > 0)
+    {
+        double min = obsPtr->blocks[obsPtr->blockMinDeque.slots[obsPtr->blockMinDeque.head]]
+                                                                                    ->stats.min;
+        if (isnan(*minPtr) || (min < *minPtr))
+        {
+            *minPtr = min;
+        }
+    }
+
+    if (obsPtr->blockMaxDeque.len > 0)
+    {
+        double max = obsPtr->blocks[obsPtr->blockMaxDeque.slots[obsPtr->blockMaxDeque.head]]
+                                                                                    ->stats.max;
+        if (isnan(*maxPtr) || (max > *maxPtr))
+        {
+            *maxPtr = max;
+        }
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Release the oldest of an Observation's compressed blocks, along with any samples left in it.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReleaseOldestBlock
+(
+    Observation_t* obsPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    CompressedBlock_t* blockPtr = GetBlock(obsPtr, 0);
+
+    if (obsPtr->cacheBlockPtr == blockPtr)
+    {
+        obsPtr->cacheBlockPtr = NULL;
+    }
+
+    le_mem_Release(blockPtr);
+
+    obsPtr->blockHead = (obsPtr->blockHead + 1) & (obsPtr->blockCapacity - 1);
+    obsPtr->blockCount--;
+
+    RefundBufferMemory(obsPtr, sizeof(CompressedBlock_t));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Release all of an Observation's compressed blocks, along with the ring of blocks.  Doesn't
+ * update the count or the running mean and variance.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReleaseAllBlocks
+(
+    Observation_t* obsPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    while (obsPtr->blockCount > 0)
+    {
+        ReleaseOldestBlock(obsPtr);
+    }
+
+    obsPtr->blockMinDeque.len = 0;
+    obsPtr->blockMaxDeque.len = 0;
+    (void)ResizeBlockRing(obsPtr, 0);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append a numerical sample to the newest of an Observation's compressed blocks, starting a new
+ * block if that one is full.  Memory is counted a whole block at a time, as it is allocated.
+ *
+ * @return
+ *      - LE_OK if successful.
+ *      - LE_NO_MEMORY if a new block was needed but couldn't be allocated.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t AppendToBlocks
+(
+    Observation_t* obsPtr,
+    uint64_t seq,       ///< Sequence number of the sample.
+    double timestamp,
+    double value
+)
+//--------------------------------------------------------------------------------------------------
+{
+    CompressedBlock_t* blockPtr = NULL;
+
+    if (obsPtr->blockCount > 0)
+    {
+        blockPtr = GetBlock(obsPtr, obsPtr->blockCount - 1);
+
+        if (!sampleBlock_Append(&blockPtr->data, timestamp, value))
+        {
+            blockPtr = NULL;
+        }
+    }
+
+    if (blockPtr == NULL)
+    {
+        if (obsPtr->blockCount == obsPtr->blockCapacity)
+        {
+            size_t capacity = (obsPtr->blockCapacity > 0) ? (obsPtr->blockCapacity * 2)
+                                                          : GetRingCapacity(0);
+
+            if (ResizeBlockRing(obsPtr, capacity) != LE_OK)
+            {
+                return LE_NO_MEMORY;
+            }
+        }
+
+        if (CompressedBlockPool == NULL)
+        {
+            CompressedBlockPool = le_mem_CreatePool("ObsBlock", sizeof(CompressedBlock_t));
+        }
+
+        blockPtr = AllocSizeClassBlock(CompressedBlockPool);
+        if (blockPtr == NULL)
+        {
+            LE_ERROR("Failed to allocate a compressed block");
+            return LE_NO_MEMORY;
+        }
+
+        blockPtr->firstSeq = seq;
+        blockPtr->stats.count = 0;
+        sampleBlock_Init(&blockPtr->data);
+        LE_ASSERT(sampleBlock_Append(&blockPtr->data, timestamp, value));
+
+        obsPtr->blocks[(obsPtr->blockHead + obsPtr->blockCount) & (obsPtr->blockCapacity - 1)] =
+                                                                                        blockPtr;
+        obsPtr->blockCount++;
+
+        ChargeBufferMemory(obsPtr, sizeof(CompressedBlock_t));
+
+        if (obsPtr->blockCount == 1)
+        {
+            StartHeadBlock(obsPtr);
+        }
+    }
+
+    blockPtr->lastTimestamp = timestamp;
+    blockPtr->lastValue = value;
+
+    if (!isnan(value))
+    {
+        RangeStats_t valueStats = { 1, value, 0, value, value };
+
+        MergeRangeStats(&blockPtr->stats, &valueStats);
+        AddToRunningStats(obsPtr, value);
+
+        if (obsPtr->blockCount > 1)
+        {
+            PushBlockDeque(obsPtr, &obsPtr->blockMinDeque, true);
+            PushBlockDeque(obsPtr, &obsPtr->blockMaxDeque, false);
+        }
+        else if (!obsPtr->headBlockStale)
+        {
+            if (isnan(obsPtr->headBlockMin) || (value < obsPtr->headBlockMin))
+            {
+                obsPtr->headBlockMin = value;
+            }
+            if (isnan(obsPtr->headBlockMax) || (value > obsPtr->headBlockMax))
+            {
+                obsPtr->headBlockMax = value;
+            }
+        }
+    }
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Discard the oldest sample from an Observation's compressed blocks, releasing its block if no
+ * samples are left in it.  The buffer must not be empty.  Doesn't update the count.
+ */
+//--------------------------------------------------------------------------------------------------
+static void DropOldestFromBlocks
+(
+    Observation_t* obsPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    CompressedBlock_t* blockPtr = GetBlock(obsPtr, 0);
+    double value = obsPtr->headValue;
+
+    if (!isnan(value))
+    {
+        RemoveFromRunningStats(obsPtr, value);
+
+        // Only dropping the oldest block's minimum (or maximum) can change it.
+        if ((value <= obsPtr->headBlockMin) || (value >= obsPtr->headBlockMax))
+        {
+            obsPtr->headBlockStale = true;
+        }
+    }
+
+    if (obsPtr->headCursor.count < sampleBlock_GetCount(&blockPtr->data))
+    {
+        sampleBlock_ReadNext(&blockPtr->data,
+                             &obsPtr->headCursor,
+                             &obsPtr->headTimestamp,
+                             &obsPtr->headValue);
+    }
+    else
+    {
+        ReleaseOldestBlock(obsPtr);
+
+        if (obsPtr->blockCount > 0)
+        {
+            StartHeadBlock(obsPtr);
+
+            // As with the ring, recompute the running mean and variance exactly once the
+            // buffer's worth of samples has been replaced.  Only the blocks' statistics are
+            // merged, so this is amortized O(1) per sample.
+            if (obsPtr->statRemovals >= obsPtr->count)
+            {
+                RecomputeBlockStats(obsPtr);
+            }
+        }
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Move the numerical samples in an Observation's ring buffer into compressed blocks, releasing
+ * the ring.
+ *
+ * @return
+ *      - LE_OK if successful.
+ *      - LE_NO_MEMORY if the blocks couldn't be allocated (the ring is left untouched).
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t MoveRingToBlocks
+(
+    Observation_t* obsPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    size_t count = obsPtr->count;
+
+    // The blocks keep their own running statistics as the samples are appended to them.
+    obsPtr->statCount = 0;
+    obsPtr->statMean = 0;
+    obsPtr->statM2 = 0;
+    obsPtr->statRemovals = 0;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        size_t slot = BufferSlot(obsPtr, i);
+
+        if (AppendToBlocks(obsPtr,
+                           obsPtr->headSeq + i,
+                           obsPtr->timestamps[slot],
+                           obsPtr->values[slot].number) != LE_OK)
+        {
+            ReleaseAllBlocks(obsPtr);
+            RecomputeStats(obsPtr);
+
+            return LE_NO_MEMORY;
+        }
+    }
+
+    // Empty the ring so that it can be released.  The samples are all in the blocks now.
+    obsPtr->count = 0;
+    obsPtr->minDeque.len = 0;
+    obsPtr->maxDeque.len = 0;
+    (void)ResizeRing(obsPtr, 0);
+
+    obsPtr->count = count;
+    obsPtr->isCompressed = true;
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Move the samples in an Observation's compressed blocks into a ring buffer, releasing the blocks.
+ * If the ring can't hold them all, the oldest are dropped.
+ *
+ * @return
+ *      - LE_OK if successful.
+ *      - LE_NO_MEMORY if the ring couldn't be allocated (the blocks are left untouched).
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t MoveBlocksToRing
+(
+    Observation_t* obsPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    size_t capacity = GetRingCapacity(obsPtr->count);
+
+    while (obsPtr->count > capacity)
+    {
+        DropOldestFromBlocks(obsPtr);
+        obsPtr->headSeq++;
+        obsPtr->count--;
+    }
+
+    size_t count = obsPtr->count;
+
+    // The ring is filled from empty, then the blocks are released.
+    obsPtr->count = 0;
+    if (ResizeRing(obsPtr, capacity) != LE_OK)
+    {
+        obsPtr->count = count;
+        return LE_NO_MEMORY;
+    }
+
+    obsPtr->statCount = 0;
+    obsPtr->statMean = 0;
+    obsPtr->statM2 = 0;
+    obsPtr->statRemovals = 0;
+
+    for (size_t i = 0; i < obsPtr->blockCount; i++)
+    {
+        CompressedBlock_t* blockPtr = GetBlock(obsPtr, i);
+        sampleBlock_Cursor_t cursor;
+        uint64_t seq = blockPtr->firstSeq;
+
+        sampleBlock_StartRead(&cursor);
+
+        for (; cursor.count < sampleBlock_GetCount(&blockPtr->data); seq++)
+        {
+            double timestamp;
+            double value;
+
+            sampleBlock_ReadNext(&blockPtr->data, &cursor, &timestamp, &value);
+
+            if (seq >= obsPtr->headSeq)
+            {
+                obsPtr->timestamps[obsPtr->count] = timestamp;
+                obsPtr->values[obsPtr->count].number = value;
+                AddToStats(obsPtr, obsPtr->count);
+                obsPtr->count++;
+            }
+        }
+    }
+
+    ReleaseAllBlocks(obsPtr);
+
+    obsPtr->isCompressed = false;
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Does a given Observation limit its buffer by the age or memory use of its samples, in addition
+ * to their number?
+ *
+ * @return true if a maximum age or maximum number of bytes is set.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline bool HasRetentionLimit
+(
+    Observation_t* obsPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return (!isnan(obsPtr->maxAge) || (obsPtr->maxBytes > 0));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of bytes of memory counted against an Observation's maximum number of bytes for
+ * the string held by the sample in a given ring buffer slot, over and above the slot itself.
+ *
+ * @return The number of bytes (0 unless the sample is a string or JSON value).
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t GetStringBytes
+(
+    Observation_t* obsPtr,
+    size_t slot
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (IsBufferedByRef(obsPtr->bufferedType))
+    {
+        return strlen(dataSample_GetString(obsPtr->values[slot].sampleRef)) + 1;
+    }
+
+    return 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Discard the oldest sample from an Observation's buffer.  The buffer must not be empty.
+ */
+//--------------------------------------------------------------------------------------------------
+static void DropOldestFromBuffer
+(
+    Observation_t* obsPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LE_ASSERT(obsPtr->count > 0);
+
+    if (obsPtr->isCompressed)
+    {
+        DropOldestFromBlocks(obsPtr);
+
+        obsPtr->headSeq++;
+        obsPtr->count--;
+        return;
+    }
+
+    if (IsBufferedByRef(obsPtr->bufferedType))
+    {
+        RefundBufferMemory(obsPtr, GetStringBytes(obsPtr, obsPtr->head));
+        le_mem_Release(obsPtr->values[obsPtr->head].sampleRef);
+    }
+    else if (IsNumerical(obsPtr->bufferedType))
+    {
+        RemoveFromStats(obsPtr, obsPtr->head);
+    }
+
+    if (obsPtr->index != NULL)
+    {
+        UpdateIndex(obsPtr, obsPtr->head, false);
+    }
+
+    obsPtr->head = (obsPtr->head + 1) & (obsPtr->capacity - 1);
+    obsPtr->headSeq++;
+    obsPtr->count--;
+
+    // Removing values from the running mean and variance accumulates rounding errors, so once
+    // the buffer's worth of samples has been replaced, recompute them exactly.  This keeps the
+    // cost amortized O(1) per sample.
+    if (obsPtr->statRemovals >= obsPtr->capacity)
+    {
+        RecomputeStats(obsPtr);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Adds a sample, given as its timestamp and value, to the buffer of a given Observation.  If the
+ * ring buffer is full, the oldest sample is dropped to make room.
+ *
+ * This saves creating a Data Sample for each numerical sample when loading a lot of them at once.
+ *
+ * @return
+ *      - LE_OK If the sample was added to observation buffer successfully.
+ *      - LE_NO_MEMORY If failed to allocate memory for the buffer.
+ *      - LE_BAD_PARAMETER If dropped sample because its timestamp was older than the sample already
+ *           in buffer.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t AddEntryToBuffer
+(
+    Observation_t* obsPtr,
+    double newEntryTimestamp,
+    double number,              ///< Value of a numeric or Boolean (1.0 or 0.0) sample.
+    dataSample_Ref_t sampleRef  ///< The sample, if string or JSON (else ignored).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    // If the new sample is timestamped older than the newest sample already in the buffer,
+    // then we have a serious problem, because buffer traversal operations could get stuck in loops.
+    if (obsPtr->count > 0)
+    {
+        double oldEntryTimestamp = GetBufferedTimestamp(obsPtr, obsPtr->count - 1);
+
+        if (oldEntryTimestamp > newEntryTimestamp)
+        {
+            LE_ERROR("New sample has older timestamp than (older) sample already in the buffer!");
+            LE_ERROR("Dropping new sample timestamped %lf (< %lf in buffer)!",
+                     newEntryTimestamp,
+                     oldEntryTimestamp);
+            return LE_BAD_PARAMETER;
+        }
+    }
+    else if (obsPtr->isCompressed != (obsPtr->compress && IsNumerical(obsPtr->bufferedType)))
+    {
+        // An empty buffer switches between the ring and compressed blocks, depending on the type
+        // of the samples it is about to get.
+        if (obsPtr->isCompressed)
+        {
+            (void)ResizeBlockRing(obsPtr, 0);
+        }
+        else
+        {
+            (void)ResizeRing(obsPtr, 0);
+        }
+
+        obsPtr->isCompressed = !obsPtr->isCompressed;
+    }
+
+    // Numerical samples can be compressed, in which case the maximum count is enforced by the
+    // caller, as there is no ring to fill up.
+    if (obsPtr->isCompressed)
+    {
+        le_result_t result = AppendToBlocks(obsPtr,
+                                            obsPtr->headSeq + obsPtr->count,
+                                            newEntryTimestamp,
+                                            number);
+        if (result == LE_OK)
+        {
+            obsPtr->count++;
+        }
+
+        return result;
+    }
+
+    // Grow the ring if it is full and the maximum count allows more slots.  A buffer may never
+    // hold as many samples as its maximum count allows, so the ring is only doubled as it fills
+    // up, which keeps memory in line with the samples actually buffered.  If that fails, carry on
+    // with the ring we have (if any), dropping older samples sooner than we'd like.
+    size_t capacity = GetRingCapacity(obsPtr->maxCount);
+    if (obsPtr->capacity < capacity)
+    {
+        if (obsPtr->count < obsPtr->capacity)
+        {
+            capacity = obsPtr->capacity;
+        }
+        else if (   (obsPtr->capacity > 0)
+                 && (obsPtr->maxBytes > 0)
+                 && ((obsPtr->bytes + (obsPtr->capacity * RING_SLOT_BYTES)) > obsPtr->maxBytes)  )
+        {
+            // Doubling the ring would take the buffer over its maximum number of bytes, so drop
+            // the oldest sample to make room instead.
+            capacity = obsPtr->capacity;
+        }
+        else if (obsPtr->capacity > 0)
+        {
+            capacity = obsPtr->capacity * 2;
+        }
+        else
+        {
+            capacity = GetRingCapacity(0);
+        }
+
+        if (   (capacity > obsPtr->capacity)
+            && (ResizeRing(obsPtr, capacity) != LE_OK)
+            && (obsPtr->capacity == 0)  )
+        {
+            return LE_NO_MEMORY;
+        }
+    }
+
+    if (obsPtr->count == obsPtr->capacity)
+    {
+        DropOldestFromBuffer(obsPtr);
+    }
+
+    size_t slot = BufferSlot(obsPtr, obsPtr->count);
+    BufferValue_t* valuePtr = &obsPtr->values[slot];
+
+    obsPtr->timestamps[slot] = newEntryTimestamp;
+
+    switch (obsPtr->bufferedType)
+    {
+        case IO_DATA_TYPE_TRIGGER:
+
+            valuePtr->number = 0;
+            break;
+
+        case IO_DATA_TYPE_BOOLEAN:
+        case IO_DATA_TYPE_NUMERIC:
+
+            valuePtr->number = number;
+            AddToStats(obsPtr, slot);
+            break;
+
+        case IO_DATA_TYPE_STRING:
+        case IO_DATA_TYPE_JSON:
+
+            le_mem_AddRef(sampleRef);
+            valuePtr->sampleRef = sampleRef;
+            break;
+    }
+
+    if ((obsPtr->index != NULL) && IsNumerical(obsPtr->bufferedType))
+    {
+        UpdateIndex(obsPtr, slot, true);
+    }
+
+    (obsPtr->count)++;
+    ChargeBufferMemory(obsPtr, GetStringBytes(obsPtr, slot));
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Adds a given data sample to the buffer of a given Observation.  If the ring buffer is full,
+ * the oldest sample is dropped to make room.
+ *
+ * @return
+ *      - LE_OK If datasample was added to observation buffer successfully.
+ *      - LE_NO_MEMORY If failed to allocate memory for the buffer.
+ *      - LE_BAD_PARAMETER If dropped sample because its timestamp was older than the sample already
+ *           in buffer.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t AddToBuffer
+(
+    Observation_t* obsPtr,
+    dataSample_Ref_t sampleRef
+)
+//--------------------------------------------------------------------------------------------------
+{
+    double number = 0;
+
+    switch (obsPtr->bufferedType)
+    {
+        case IO_DATA_TYPE_BOOLEAN:
+
+            number = (dataSample_GetBoolean(sampleRef) ? 1.0 : 0.0);
+            break;
+
+        case IO_DATA_TYPE_NUMERIC:
+
+            number = dataSample_GetNumeric(sampleRef);
+            break;
+
+        default:
+
+            break;
+    }
+
+    return AddEntryToBuffer(obsPtr, dataSample_GetTimestamp(sampleRef), number, sampleRef);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * If the number of entries in a given Observation's buffer is larger than the number given,
+ * discard enough of the oldest entries to correct that condition.  If that empties the buffer, its
+ * ring (or ring of compressed blocks) is released too.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TruncateBuffer
+(
+    Observation_t* obsPtr,
+    size_t count
+)
+//--------------------------------------------------------------------------------------------------
+{
+    while (obsPtr->count > count)
+    {
+        DropOldestFromBuffer(obsPtr);
+    }
+
+    if (obsPtr->count == 0)
+    {
+        (void)ResizeRing(obsPtr, 0);
+        (void)ResizeBlockRing(obsPtr, 0);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Halve (at least) the ring of a given Observation's buffer if it is no more than a quarter full,
+ * so that the memory freed by dropping samples early is given back without reallocating on every
+ * push.  Likewise for the ring of compressed blocks, whose blocks are released as they empty.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ShrinkRing
+(
+    Observation_t* obsPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (   (obsPtr->blockCapacity > ((size_t)1 << MIN_RING_CAPACITY_BITS))
+        && (obsPtr->blockCount <= (obsPtr->blockCapacity / 4))  )
+    {
+        (void)ResizeBlockRing(obsPtr, GetRingCapacity(obsPtr->blockCount * 2));
+    }
+
+    if (   (obsPtr->capacity > ((size_t)1 << MIN_RING_CAPACITY_BITS))
+        && (obsPtr->count <= (obsPtr->capacity / 4))  )
+    {
+        (void)ResizeRing(obsPtr, GetRingCapacity(obsPtr->count * 2));
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Give back the memory freed by dropping a sample from a given Observation's buffer to stay within
+ * a memory limit, which is otherwise still allocated to the ring.  The ring (or ring of compressed
+ * blocks) is halved as soon as no more than half of it is in use, and released if the buffer is
+ * empty.  Halving only happens once per halving of the samples, so this is amortized O(1) per
+ * sample dropped.
+ */
+//--------------------------------------------------------------------------------------------------
+static void FitRingToSamples
+(
+    Observation_t* obsPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (obsPtr->count == 0)
+    {
+        (void)ResizeRing(obsPtr, 0);
+        (void)ResizeBlockRing(obsPtr, 0);
+        return;
+    }
+
+    if (   (obsPtr->blockCapacity > ((size_t)1 << MIN_RING_CAPACITY_BITS))
+        && (obsPtr->blockCount <= (obsPtr->blockCapacity / 2))  )
+    {
+        (void)ResizeBlockRing(obsPtr, obsPtr->blockCapacity / 2);
+    }
+
+    if (   (obsPtr->capacity > ((size_t)1 << MIN_RING_CAPACITY_BITS))
+        && (obsPtr->count <= (obsPtr->capacity / 2))  )
+    {
+        (void)ResizeRing(obsPtr, obsPtr->capacity / 2);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Discard the oldest samples from a given Observation's buffer while they are older than its
+ * maximum age or use more than its maximum number of bytes.  Each sample is only ever looked at
+ * once on its way out, so this is amortized O(1) per sample added.  If the buffer is left using
+ * only a small part of its ring, the ring is shrunk.
+ *
+ * Also starts the retention timer if there are samples that will need to be dropped as they age.
+ */
+//--------------------------------------------------------------------------------------------------
+static void EnforceRetention
+(
+    Observation_t* obsPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (!HasRetentionLimit(obsPtr))
+    {
+        return;
+    }
+
+    if ((obsPtr->maxBytes > 0) && (obsPtr->bytes > obsPtr->maxBytes))
+    {
+        // The index only speeds up queries, so it goes before any samples do.
+        DiscardIndex(obsPtr);
+
+        while ((obsPtr->count > 0) && (obsPtr->bytes > obsPtr->maxBytes))
+        {
+            DropOldestFromBuffer(obsPtr);
+            FitRingToSamples(obsPtr);
+        }
+    }
+
+    double now = 0;
+    if (!isnan(obsPtr->maxAge))
+    {
+        le_clk_Time_t clk = le_clk_GetAbsoluteTime();
+        now = (((double)(clk.usec)) / 1000000) + clk.sec;
+
+        while ((obsPtr->count > 0) && (GetBufferedTimestamp(obsPtr, 0) < (now - obsPtr->maxAge)))
+        {
+            DropOldestFromBuffer(obsPtr);
+        }
+    }
+
+    ShrinkRing(obsPtr);
+
+    // The retention timer exists whenever a maximum age is set.
+    if (obsPtr->retentionTimer == NULL)
+    {
+        return;
+    }
+
+    if (obsPtr->count == 0)
+    {
+        le_timer_Stop(obsPtr->retentionTimer);
+        return;
+    }
+
+    // If the timer is already running, it will expire no later than the oldest sample does.
+    if (le_timer_IsRunning(obsPtr->retentionTimer))
+    {
+        return;
+    }
+
+    // Wake up when the oldest sample gets too old, but not so often that the timer costs more
+    // than checking on every push would.
+    double expiry = GetBufferedTimestamp(obsPtr, 0) + obsPtr->maxAge - now;
+    uint32_t timerInterval = RETENTION_TIMER_MIN_MS;
+    if (expiry > (RETENTION_TIMER_MIN_MS / 1000.0))
+    {
+        timerInterval = (expiry < (UINT32_MAX / 1000)) ? (uint32_t)(ceil(expiry) * 1000)
+                                                       : UINT32_MAX;
+    }
+
+    LE_ASSERT(le_timer_SetMsInterval(obsPtr->retentionTimer, timerInterval) == LE_OK);
+    LE_ASSERT(le_timer_Start(obsPtr->retentionTimer) == LE_OK);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether one buffer eviction candidate's oldest sample goes before another's: lowest
+ * priority first, then oldest sample first.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsEvictedBefore
+(
+    const EvictionCandidate_t* aPtr,
+    const EvictionCandidate_t* bPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return (   (aPtr->obsPtr->priority < bPtr->obsPtr->priority)
+            || (   (aPtr->obsPtr->priority == bPtr->obsPtr->priority)
+                && (aPtr->oldest < bPtr->oldest)  )  );
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Move a buffer eviction candidate down a heap of candidates until neither of its children goes
+ * before it.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SiftDownCandidate
+(
+    EvictionCandidate_t* heapPtr,
+    size_t count,   ///< Number of candidates in the heap.
+    size_t index    ///< Position of the candidate to move down.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    for (;;)
+    {
+        size_t first = index;
+        size_t left = (2 * index) + 1;
+        size_t right = left + 1;
+
+        if ((left < count) && IsEvictedBefore(&heapPtr[left], &heapPtr[first]))
+        {
+            first = left;
+        }
+        if ((right < count) && IsEvictedBefore(&heapPtr[right], &heapPtr[first]))
+        {
+            first = right;
+        }
+        if (first == index)
+        {
+            return;
+        }
+
+        EvictionCandidate_t candidate = heapPtr[index];
+        heapPtr[index] = heapPtr[first];
+        heapPtr[first] = candidate;
+        index = first;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * When the samples buffered in all Observations use more memory than the hub's buffer memory
+ * budget, evict the oldest samples from the buffers of the lowest priority Observations.  Among
+ * Observations of the same priority, the oldest samples go first.
+ *
+ * The buffers are put in a heap ordered by (priority, oldest sample) once, and samples are then
+ * evicted until the buffers are back down to a low-water mark below the budget, so that the
+ * Observations aren't all looked through again on every push while the hub is at its budget.
+ */
+//--------------------------------------------------------------------------------------------------
+static void EnforceBudget
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if ((BufferBudget == 0) || (BufferedBytes <= BufferBudget))
+    {
+        return;
+    }
+
+    // The heap is allocated from a size class pool, so once the pool has a block for this many
+    // Observations, being over budget again doesn't need any more memory.
+    le_mem_PoolRef_t pool = GetSizeClassPool(EvictionPools,
+                                             "ObsEvict",
+                                             GetRingCapacity(ObservationCount),
+                                             sizeof(EvictionCandidate_t));
+    EvictionCandidate_t* heapPtr = AllocSizeClassBlock(pool);
+    if (heapPtr == NULL)
+    {
+        LE_CRIT("Out of memory. Samples not evicted from buffers.");
+        return;
+    }
+
+    size_t count = 0;
+
+    le_dls_Link_t* linkPtr = le_dls_Peek(&ObservationList);
+    while (linkPtr != NULL)
+    {
+        Observation_t* obsPtr = CONTAINER_OF(linkPtr, Observation_t, link);
+        linkPtr = le_dls_PeekNext(&ObservationList, linkPtr);
+
+        // Indexes only speed up queries, so they all go before any samples do.  So does any
+        // memory still allocated to empty buffers.
+        DiscardIndex(obsPtr);
+
+        if (obsPtr->count > 0)
+        {
+            heapPtr[count].obsPtr = obsPtr;
+            heapPtr[count].oldest = GetBufferedTimestamp(obsPtr, 0);
+            count++;
+        }
+        else
+        {
+            FitRingToSamples(obsPtr);
+        }
+    }
+
+    for (size_t i = count / 2; i > 0; i--)
+    {
+        SiftDownCandidate(heapPtr, count, i - 1);
+    }
+
+    size_t lowWater = BufferBudget - (BufferBudget / BUFFER_BUDGET_LOW_WATER_DIVISOR);
+
+    while (BufferedBytes > lowWater)
+    {
+        // Emptying every buffer should release all their memory, so there should be one to evict.
+        if (count == 0)
+        {
+            LE_CRIT("Buffers still use %zu bytes with no samples left to evict.", BufferedBytes);
+            break;
+        }
+
+        Observation_t* victimPtr = heapPtr[0].obsPtr;
+
+        DropOldestFromBuffer(victimPtr);
+        FitRingToSamples(victimPtr);
+        victimPtr->evictionCount++;
+        EvictionCount++;
+
+        if (victimPtr->count > 0)
+        {
+            heapPtr[0].oldest = GetBufferedTimestamp(victimPtr, 0);
+        }
+        else
+        {
+            count--;
+            heapPtr[0] = heapPtr[count];
+        }
+
+        SiftDownCandidate(heapPtr, count, 0);
+    }
+
+    // Give back the memory of the rings that were left partly empty.
+    for (size_t i = 0; i < count; i++)
+    {
+        ShrinkRing(heapPtr[i].obsPtr);
+    }
+
+    le_mem_Release(heapPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a Data Sample holding a copy of the sample at a given position in an Observation's
+ * buffer.
+ *
+ * @return Reference to the Data Sample (the caller must release it), or NULL if allocation failed.
+ */
+//--------------------------------------------------------------------------------------------------
+static dataSample_Ref_t CreateSampleFromBuffer
+(
+    Observation_t* obsPtr,
+    size_t index    ///< Position in the buffer (0 = oldest, count - 1 = newest).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    double timestamp = GetBufferedTimestamp(obsPtr, index);
+
+    switch (obsPtr->bufferedType)
+    {
+        case IO_DATA_TYPE_TRIGGER:
+
+            return dataSample_CreateTrigger(timestamp);
+
+        case IO_DATA_TYPE_BOOLEAN:
+
+            return dataSample_CreateBoolean(timestamp, (GetBufferedNumber(obsPtr, index) != 0));
+
+        case IO_DATA_TYPE_NUMERIC:
+
+            return dataSample_CreateNumeric(timestamp, GetBufferedNumber(obsPtr, index));
+
+        case IO_DATA_TYPE_STRING:
+        case IO_DATA_TYPE_JSON:
+        {
+            dataSample_Ref_t sampleRef = obsPtr->values[BufferSlot(obsPtr, index)].sampleRef;
+
+            le_mem_AddRef(sampleRef);
+            return sampleRef;
+        }
+    }
+
+    LE_FATAL("Invalid data type %d.", obsPtr->bufferedType);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the data type code byte to be written into a backup file or at the start of a binary read.
+ *
+ * @return the data type code byte.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint8_t GetDataTypeCode
+(
+    io_DataType_t dataType
+)
+//--------------------------------------------------------------------------------------------------
+{
+    switch (dataType)
+    {
+        case IO_DATA_TYPE_TRIGGER:  return 't';
+        case IO_DATA_TYPE_BOOLEAN:  return 'b';
+        case IO_DATA_TYPE_NUMERIC:  return 'n';
+        case IO_DATA_TYPE_STRING:   return 's';
+        case IO_DATA_TYPE_JSON:     return 'j';
+    }
+
+    LE_FATAL("Invalid data type %d.", dataType);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Encode the fixed-size part of the record for the sample at a given position in an Observation's
+ * buffer, as stored in backup files and written by binary read operations.  A record is
+ *
+ *  - the timestamp (double), followed by
+ *  - nothing for a trigger,
+ *  - one byte (0 or 1) for a Boolean,
+ *  - the value (double) for a numeric, or
+ *  - the length (uint32_t) of the value for a string or JSON, followed by the value itself
+ *    (without null terminator).
+ *
+ * The variable-length tail of a string or JSON record is not copied; a pointer to it is returned
+ * instead.
+ *
+ * @return The number of bytes written into the head buffer.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t EncodeRecordHead
+(
+    Observation_t* obsPtr,
+    size_t index,                   ///< Position in the buffer (0 = oldest, count - 1 = newest).
+    uint8_t* headPtr,               ///< [OUT] Buffer of at least RECORD_HEAD_MAX_BYTES bytes.
+    const char** tailPtrPtr,        ///< [OUT] Ptr to the tail of the record (NULL if none).
+    uint32_t* tailLenPtr            ///< [OUT] Number of bytes in the tail of the record.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    double timestamp = GetBufferedTimestamp(obsPtr, index);
+    double number;
+    dataSample_Ref_t sampleRef;
+    size_t len = sizeof(double);
+
+    memcpy(headPtr, &timestamp, sizeof(double));
+
+    *tailPtrPtr = NULL;
+    *tailLenPtr = 0;
+
+    switch (obsPtr->bufferedType)
+    {
+        case IO_DATA_TYPE_TRIGGER:
+
+            // No Value.
+            break;
+
+        case IO_DATA_TYPE_BOOLEAN:
+
+            headPtr[len] = (GetBufferedNumber(obsPtr, index) != 0);
+            len += 1;
+            break;
+
+        case IO_DATA_TYPE_NUMERIC:
+
+            number = GetBufferedNumber(obsPtr, index);
+            memcpy(headPtr + len, &number, sizeof(double));
+            len += sizeof(double);
+            break;
+
+        case IO_DATA_TYPE_STRING:
+        case IO_DATA_TYPE_JSON:
+
+            sampleRef = obsPtr->values[BufferSlot(obsPtr, index)].sampleRef;
+            *tailPtrPtr = dataSample_GetString(sampleRef);
+            *tailLenPtr = strlen(*tailPtrPtr);
+            memcpy(headPtr + len, tailLenPtr, sizeof(uint32_t));
+            len += sizeof(uint32_t);
+            break;
+    }
+
+    return len;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Convert a multi-byte field that was copied into a buffer in host byte order to little-endian
+ * byte order, in place.
+ */
+//--------------------------------------------------------------------------------------------------
+static void HostToLittleEndian
+(
+    uint8_t* fieldPtr,
+    size_t size             ///< Size of the field (sizeof(uint32_t) or sizeof(uint64_t)).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    uint64_t value;
+
+    if (size == sizeof(uint32_t))
+    {
+        uint32_t value32;
+        memcpy(&value32, fieldPtr, sizeof(value32));
+        value = value32;
+    }
+    else
+    {
+        memcpy(&value, fieldPtr, sizeof(value));
+    }
+
+    for (size_t i = 0; i < size; i++)
+    {
+        fieldPtr[i] = (uint8_t)(value >> (8 * i));
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write the JSON representation of the value of the sample at a given position in an Observation's
+ * buffer into a string buffer.
+ *
+ * @return
+ *  - LE_OK if successful,
+ *  - LE_OVERFLOW if the buffer provided is too small to hold the value.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ConvertBufferedValueToJson
+(
+    Observation_t* obsPtr,
+    size_t index,           ///< Position in the buffer (0 = oldest, count - 1 = newest).
+    char* valueBuffPtr,     ///< [OUT] Ptr to buffer where value will be stored.
+    size_t valueBuffSize    ///< [IN] Size of value buffer, in bytes.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    int len;
+
+    switch (obsPtr->bufferedType)
+    {
+        case IO_DATA_TYPE_TRIGGER:
+
+            len = snprintf(valueBuffPtr, valueBuffSize, "null");
+            break;
+
+        case IO_DATA_TYPE_BOOLEAN:
+
+            len = snprintf(valueBuffPtr,
+                           valueBuffSize,
+                           (GetBufferedNumber(obsPtr, index) != 0) ? "true" : "false");
+            break;
+
+        case IO_DATA_TYPE_NUMERIC:
+
+            len = snprintf(valueBuffPtr, valueBuffSize, "%lf", GetBufferedNumber(obsPtr, index));
+            break;
+
+        case IO_DATA_TYPE_STRING:
+        case IO_DATA_TYPE_JSON:
+
+            return dataSample_ConvertToJson(obsPtr->values[BufferSlot(obsPtr, index)].sampleRef,
+                                            obsPtr->bufferedType,
+                                            valueBuffPtr,
+                                            valueBuffSize);
+
+        default:
+
+            LE_FATAL("Invalid data type %d.", obsPtr->bufferedType);
+    }
+
+    if (len >= (int)valueBuffSize)
+    {
+        return LE_OVERFLOW;
+    }
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Terminate a read operation.
+ */
+//--------------------------------------------------------------------------------------------------
+static void EndRead
+(
+    ReadOperation_t* opPtr,
+    le_result_t result
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_fdMonitor_Delete(opPtr->fdMonitor);
+
+    close(opPtr->fd);
+
+    opPtr->handlerPtr(result, opPtr->contextPtr);
+
+    le_dls_Remove(&opPtr->obsPtr->readOpList, &opPtr->link);
+
+    if (opPtr->selectedSeqs != NULL)
+    {
+        le_mem_Release(opPtr->selectedSeqs);
+    }
+
+    le_mem_Release(opPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Observation destructor.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ObservationDestructor
+(
+    void* objectPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Observation_t* obsPtr = objectPtr;
+
+    // Delete all the buffered data samples and release the ring buffer (or ring of blocks).
+    TruncateBuffer(obsPtr, 0);
+    (void)ResizeRing(obsPtr, 0);
+    (void)ResizeBlockRing(obsPtr, 0);
+
+    obsPtr->maxCount = 0;
+
+    if (obsPtr->retentionTimer != NULL)
+    {
+        le_timer_Delete(obsPtr->retentionTimer);
+        obsPtr->retentionTimer = NULL;
+    }
+
+    le_dls_Remove(&ObservationList, &obsPtr->link);
+    ObservationCount--;
+
+    // If the observation had backups enabled, delete the backup file.
+    if (obsPtr->backupPeriod > 0)
+    {
+        DeleteBackup(obsPtr);
+    }
+    else
+    {
+        DetachBackupJob(obsPtr);
+    }
+
+    // If there are read operations in progress, end them.
+    while (le_dls_IsEmpty(&obsPtr->readOpList) == false)
+    {
+        EndRead(CONTAINER_OF(le_dls_Peek(&obsPtr->readOpList), ReadOperation_t, link),
+                LE_COMM_ERROR);
+    }
+
+    res_Destruct(&obsPtr->resource);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Find the next sample to be read, without moving past it.
+ *
+ * @return true if found, false if there are no more samples.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool PeekReadOpSample
+(
+    ReadOperation_t* opPtr,
+    size_t* indexPtr    ///< [OUT] Position of the sample in the Observation's buffer.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Observation_t* obsPtr = opPtr->obsPtr;
+
+    // The header of a binary read promised a number of records of one type, so fail the read if
+    // the buffer's type has changed or any of those samples have fallen off the end of the buffer
+    // before they could be read.
+    if (   opPtr->isBinary
+        && (opPtr->nextSeq < opPtr->endSeq)
+        && (   (obsPtr->bufferedType != opPtr->dataType)
+            || (opPtr->nextSeq < obsPtr->headSeq)  )  )
+    {
+        opPtr->result = LE_OUT_OF_RANGE;
+        return false;
+    }
+
+    if (opPtr->selectedSeqs != NULL)
+    {
+        // Skip any selected samples that have fallen off the end of the observation's buffer
+        // since they were selected.
+        while (   (opPtr->nextSelected < opPtr->selectedCount)
+               && (opPtr->selectedSeqs[opPtr->nextSelected] < obsPtr->headSeq)  )
+        {
+            opPtr->nextSelected++;
+        }
+
+        if (opPtr->nextSelected >= opPtr->selectedCount)
+        {
+            return false;
+        }
+
+        opPtr->nextSeq = opPtr->selectedSeqs[opPtr->nextSelected];
+    }
+
+    // If the next sample has fallen off the end of the observation's buffer, then we know
+    // that all entries in the observation's buffer are now newer than it, so start from
+    // the oldest.
+    if (opPtr->nextSeq < obsPtr->headSeq)
+    {
+        opPtr->nextSeq = obsPtr->headSeq;
+    }
+
+    if (   (opPtr->nextSeq >= (obsPtr->headSeq + obsPtr->count))
+        || (opPtr->nextSeq >= opPtr->endSeq)  )
+    {
+        return false;
+    }
+
+    *indexPtr = opPtr->nextSeq - obsPtr->headSeq;
+
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Move past the sample last found by PeekReadOpSample().
+ */
+//--------------------------------------------------------------------------------------------------
+static void SkipReadOpSample
+(
+    ReadOperation_t* opPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (opPtr->selectedSeqs != NULL)
+    {
+        opPtr->nextSelected++;
+    }
+
+    opPtr->nextSeq++;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Encode the sample at a given position in an Observation's buffer for a read operation, as
+ * either a JSON object (preceded by a comma separator, if it isn't the first sample) or a binary
+ * record.
+ *
+ * @return The number of bytes written, or 0 if the sample doesn't fit in the space provided.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t EncodeReadOpSample
+(
+    ReadOperation_t* opPtr,
+    size_t index,           ///< Position in the buffer (0 = oldest, count - 1 = newest).
+    char* buffPtr,          ///< [OUT] Where to write the sample.
+    size_t buffSize         ///< Number of bytes available at buffPtr.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Observation_t* obsPtr = opPtr->obsPtr;
+
+    if (opPtr->isBinary)
+    {
+        uint8_t head[RECORD_HEAD_MAX_BYTES];
+        const char* tailPtr;
+        uint32_t tailLen;
+
+        size_t headLen = EncodeRecordHead(obsPtr, index, head, &tailPtr, &tailLen);
+        if (headLen + tailLen > buffSize)
+        {
+            return 0;
+        }
+
+        // The timestamp, then a numeric value or a string length, are written little-endian.
+        HostToLittleEndian(head, sizeof(double));
+        if (headLen > sizeof(double) + 1)
+        {
+            HostToLittleEndian(head + sizeof(double), headLen - sizeof(double));
+        }
+
+        memcpy(buffPtr, head, headLen);
+        if (tailLen > 0)
+        {
+            memcpy(buffPtr + headLen, tailPtr, tailLen);
+        }
+
+        return headLen + tailLen;
+    }
+
+    int len = snprintf(buffPtr,
+                       buffSize,
+                       "%s{\"t\":%lf,\"v\":",
+                       opPtr->isFirstSample ? "" : ",",
+                       GetBufferedTimestamp(obsPtr, index));
+    if (len >= ((int)buffSize - 1))
+    {
+        return 0;
+    }
+
+    // Copy the JSON version of the buffered sample's value into the write buffer,
+    // if there's space (leaving room for an additional '}' at the end).
+    if (ConvertBufferedValueToJson(obsPtr, index, buffPtr + len, buffSize - len - 1) != LE_OK)
+    {
+        return 0;
+    }
+
+    len += strlen(buffPtr + len);
+    buffPtr[len] = '}';
+
+    return len + 1;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Stage as much of a read operation's output as fits into its (empty) write buffer, so that it can
+ * all be written with a single write().
+ */
+//--------------------------------------------------------------------------------------------------
+static void FillReadOpBuffer
+(
+    ReadOperation_t* opPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    char* buffPtr = opPtr->writeBuffer;
+    size_t len = 0;
+
+    if (opPtr->state == START)
+    {
+        if (opPtr->isBinary)
+        {
+            // Same header as a buffer exported to shared memory, with the number of records.
+            uint64_t firstSeq = opPtr->nextSeq;
+            if (firstSeq < opPtr->obsPtr->headSeq)
+            {
+                firstSeq = opPtr->obsPtr->headSeq;
+            }
+            uint32_t count = (opPtr->endSeq > firstSeq ? opPtr->endSeq - firstSeq : 0);
+
+            buffPtr[len++] = 0;   // Version
+            buffPtr[len++] = GetDataTypeCode(opPtr->dataType);
+            buffPtr[len++] = 0;
+            buffPtr[len++] = 0;
+            memcpy(buffPtr + len, &count, sizeof(count));
+            HostToLittleEndian((uint8_t*)buffPtr + len, sizeof(count));
+            len += sizeof(count);
+        }
+        else
+        {
+            buffPtr[len++] = '[';
+        }
+
+        opPtr->state = SAMPLE;
+    }
+
+    while (opPtr->state == SAMPLE)
+    {
+        size_t index;
+
+        if (!PeekReadOpSample(opPtr, &index))
+        {
+            if (opPtr->isBinary)
+            {
+                // Binary records are not wrapped in anything, so there's nothing to close.
+                opPtr->state = END;
+            }
+            else if (len < sizeof(opPtr->writeBuffer))
+            {
+                buffPtr[len++] = ']';
+                opPtr->state = END;
+            }
+            break;
+        }
+
+        size_t sampleLen = EncodeReadOpSample(opPtr,
+                                              index,
+                                              buffPtr + len,
+                                              sizeof(opPtr->writeBuffer) - len);
+        if (sampleLen == 0)
+        {
+            // If other things are staged, write them out and try again with an empty buffer.
+            if (len > 0)
+            {
+                break;
+            }
+
+            LE_CRIT("Sample doesn't fit in write buffer. Skipping.");
+        }
+        else
+        {
+            opPtr->isFirstSample = false;
+            len += sampleLen;
+        }
+
+        SkipReadOpSample(opPtr);
+    }
+
+    opPtr->writeLen = len;
+    opPtr->writeOffset = 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write to an unbuffered file descriptor.
+ *
+ * @return The number of bytes written.  -1 on error (errno is set).
+ */
+//--------------------------------------------------------------------------------------------------
+static ssize_t WriteToFd
+(
+    int fd,
+    const void* buffPtr,
+    size_t byteCount
+)
+//--------------------------------------------------------------------------------------------------
+{
+    ssize_t result;
+
+    LE_ASSERT(buffPtr != NULL);
+
+    do
+    {
+        result = write(fd, buffPtr, byteCount);
+
+    } while ((result == -1) && (errno == EINTR));
+
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Continue a read operation.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ContinueReadOp
+(
+    ReadOperation_t* opPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    for (;;)
+    {
+        // If everything staged has been written, stage some more (or finish).
+        if (opPtr->writeOffset >= opPtr->writeLen)
+        {
+            if (opPtr->state == END)
+            {
+                EndRead(opPtr, opPtr->result);
+
+                return;
+            }
+
+            FillReadOpBuffer(opPtr);
+
+            continue;
+        }
+
+        // Write and check for errors.
+        ssize_t result = WriteToFd(opPtr->fd,
+                                   opPtr->writeBuffer + opPtr->writeOffset,
+                                   opPtr->writeLen - opPtr->writeOffset);
+        if (result == -1)
+        {
+            if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+            {
+                // Return and wait for this function to be called again by the FD Monitor.
+                return;
+            }
+
+            LE_ERROR("Error writing (%m).");
+            EndRead(opPtr, LE_COMM_ERROR);
+
+            return;
+        }
+
+        // Update the write offset.  If the staged data has not been written entirely, loop back
+        // around to write more.
+        opPtr->writeOffset += result;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Event handler call-back for events on a read operation's write file descriptor.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReadOpFdEventHandler
+(
+    int fd,
+    short events
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LE_UNUSED(fd);
+
+    ReadOperation_t* opPtr = le_fdMonitor_GetContextPtr();
+
+    // Check for error or hang-up.
+    if ((events & POLLERR) || (events & POLLHUP) || (events & POLLRDHUP))
+    {
+        LE_ERROR("Error or hang-up on output stream.");
+        EndRead(opPtr, LE_COMM_ERROR);
+    }
+    // Note: The only other reason for this function to be called is POLLOUT (writeable).
+    else
+    {
+        ContinueReadOp(opPtr);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Start a read operation on a given Observation's buffer.
+ */
+//--------------------------------------------------------------------------------------------------
+static void StartRead
+(
+    Observation_t* obsPtr,
+    uint64_t startSeq, ///< Sequence number of the buffered sample to start at.
+    uint64_t* selectedSeqs, ///< Sequence numbers of the only samples to read, or NULL to read all
+                            ///< from startSeq on.  The read operation takes ownership of these.
+    size_t selectedCount,   ///< Number of entries in selectedSeqs.
+    bool isBinary,  ///< true = write packed binary records, false = write JSON.
+    int outputFile, ///< File descriptor to write the data to.
+    query_ReadCompletionFunc_t handlerPtr, ///< Completion callback.
+    void* contextPtr    ///< Value to be passed to completion callback.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    ReadOperation_t* opPtr = NULL;
+
+    // Set the fd non-blocking
+    if (0 != fcntl(outputFile, F_SETFL, O_NONBLOCK))
+    {
+        LE_ERROR("Failed to activate non-blocking mode (%m).");
+        handlerPtr(LE_COMM_ERROR, contextPtr);
+    }
+    else if ((opPtr = hub_MemAlloc(ReadOperationPool)) == NULL)
+    {
+        LE_ERROR("Failed to allocate a read operation");
+        handlerPtr(LE_NO_MEMORY, contextPtr);
+    }
+
+    if (opPtr == NULL)
+    {
+        if (selectedSeqs != NULL)
+        {
+            le_mem_Release(selectedSeqs);
+        }
+        return;
+    }
+    opPtr->link = LE_DLS_LINK_INIT;
+    le_dls_Queue(&obsPtr->readOpList, &opPtr->link);
+
+    opPtr->obsPtr = obsPtr;
+
+    opPtr->fdMonitor = le_fdMonitor_Create("Read", outputFile, ReadOpFdEventHandler, POLLOUT);
+    le_fdMonitor_SetContextPtr(opPtr->fdMonitor, opPtr);
+    opPtr->fd = outputFile;
+    opPtr->nextSeq = startSeq;
+    // A binary read's header gives the number of records, so it doesn't follow new samples.
+    opPtr->endSeq = (isBinary ? obsPtr->headSeq + obsPtr->count : UINT64_MAX);
+    opPtr->selectedSeqs = selectedSeqs;
+    opPtr->selectedCount = selectedCount;
+    opPtr->nextSelected = 0;
+    opPtr->isBinary = isBinary;
+    opPtr->dataType = obsPtr->bufferedType;
+    opPtr->handlerPtr = handlerPtr;
+    opPtr->contextPtr = contextPtr;
+
+    opPtr->state = START;
+    opPtr->result = LE_OK;
+    opPtr->isFirstSample = true;
+    opPtr->writeLen = 0;
+    opPtr->writeOffset = 0;
+
+    ContinueReadOp(opPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Update the value of a data sample by replacing it, if necessary
+ *
+ * Note: Even though this function uses dataSample_CreateBoolean and dataSample-CreateNumberic which
+ * may return NULL if dataSample pool is exhusted, because the previous sample is always released
+ * first before calling the createSample function, it is expected that creating sample is always
+ * successful.
+ *
+ * @return
+ *      Pointer to the updated sample.
+ */
+//--------------------------------------------------------------------------------------------------
+static dataSample_Ref_t UpdateSample
+(
+    dataSample_Ref_t sampleRef,
+    io_DataType_t dataType,
+    void *valuePtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    dataSample_Ref_t sample = sampleRef;
+    double timestamp = dataSample_GetTimestamp(sampleRef);
+
+
+    switch (dataType)
+    {
+        case IO_DATA_TYPE_BOOLEAN:
+        {
+            bool value = *((double *)valuePtr) > 0.0 ? true : false;
+            if (dataSample_GetBoolean(sampleRef) != value)
+            {
+                le_mem_Release(sampleRef);
+                sample = dataSample_CreateBoolean(timestamp, value);
+            }
+            break;
+        }
+
+        case IO_DATA_TYPE_NUMERIC:
+        {
+            double value = *((double *)valuePtr);
+            if (dataSample_GetNumeric(sampleRef) != value)
+            {
+                le_mem_Release(sampleRef);
+                sample = dataSample_CreateNumeric(timestamp, value);
+            }
+        }
+
+        default:
+            break;
+    }
+
+    if (!sample)
+    {
+        LE_FATAL("UpdateSample Failed to allocate a new sample");
+    }
+    return sample;
+}
+
+
+#if LE_CONFIG_FILESYSTEM
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the data type represented by the code byte read from a backup.
+ *
+ * @return true if successful, false on error.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool GetDataTypeFromCode
+(
+    io_DataType_t* dataTypePtr, ///< [OUT] Ptr to where the result will be put on success.
+    uint8_t code
+)
+//--------------------------------------------------------------------------------------------------
+{
+    switch (code)
+    {
+        case 't': *dataTypePtr = IO_DATA_TYPE_TRIGGER; return true;
+        case 'b': *dataTypePtr = IO_DATA_TYPE_BOOLEAN; return true;
+        case 'n': *dataTypePtr = IO_DATA_TYPE_NUMERIC; return true;
+        case 's': *dataTypePtr = IO_DATA_TYPE_STRING;  return true;
+        case 'j': *dataTypePtr = IO_DATA_TYPE_JSON;    return true;
+    }
+
+    LE_CRIT("Invalid data type code %d.", (int)code);
+
+    return false;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Appends the records of a given Observation's buffered data samples, from a given one on (up to
+ * the newest), to a backup image.
+ *
+ * @return true if successful, false if out of memory.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool AppendRecordsToImage
+(
+    backupWriter_ImageRef_t imageRef,
+    Observation_t* obsPtr,
+    size_t firstIndex,  ///< Position in the buffer of the first sample (0 = oldest).
+    uint32_t* crcPtr    ///< [IN/OUT] CRC-32 to update with the records, or NULL.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    for (size_t i = firstIndex; i < obsPtr->count; i++)
+    {
+        uint8_t head[RECORD_HEAD_MAX_BYTES];
+        const char* tailPtr;
+        uint32_t tailLen;
+
+        size_t headLen = EncodeRecordHead(obsPtr, i, head, &tailPtr, &tailLen);
+
+        if (   !backupWriter_Append(imageRef, head, headLen)
+            || ((tailLen > 0) && !backupWriter_Append(imageRef, tailPtr, tailLen))  )
+        {
+            return false;
+        }
+
+        if (crcPtr != NULL)
+        {
+            *crcPtr = le_crc_Crc32(head, headLen, *crcPtr);
+            if (tailLen > 0)
+            {
+                *crcPtr = le_crc_Crc32((const uint8_t*)tailPtr, tailLen, *crcPtr);
+            }
+        }
+    }
+
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Appends a backup of all of a given Observation's buffered data samples to a backup image, in the
+ * current backup file format.
+ *
+ * @return true if successful, false if out of memory.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool AppendBackupToImage
+(
+    backupWriter_ImageRef_t imageRef,
+    Observation_t* obsPtr,
+    uint8_t typeCode    ///< Data type code (see GetDataTypeCode()).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    static const uint8_t padding[BACKUP_RECORD_ALIGN] = { 0 };
+
+    uint8_t header[BACKUP_FILE_HEADER_BYTES] = { BACKUP_FILE_VERSION, typeCode };
+    uint32_t count = obsPtr->count;
+    uint32_t blockRecords = BACKUP_BLOCK_RECORDS;
+    memcpy(header + 4, &count, 4);
+    memcpy(header + 8, &blockRecords, 4);
+    uint32_t headerCrc = le_crc_Crc32(header, 12, LE_CRC_START_CRC32);
+    memcpy(header + 12, &headerCrc, 4);
+
+    if (!backupWriter_Append(imageRef, header, sizeof(header)))
+    {
+        return false;
+    }
+
+    for (size_t first = 0; first < obsPtr->count; first += BACKUP_BLOCK_RECORDS)
+    {
+        // The block's header is filled in once all its records have been appended.
+        uint8_t* blockHeadPtr = backupWriter_Reserve(imageRef, BACKUP_BLOCK_HEADER_BYTES);
+        if (blockHeadPtr == NULL)
+        {
+            return false;
+        }
+
+        size_t end = first + BACKUP_BLOCK_RECORDS;
+        if (end > obsPtr->count)
+        {
+            end = obsPtr->count;
+        }
+
+        uint32_t blockBytes = 0;
+        uint32_t crc = LE_CRC_START_CRC32;
+        for (size_t i = first; i < end; i++)
+        {
+            uint8_t head[RECORD_HEAD_MAX_BYTES];
+            const char* tailPtr;
+            uint32_t tailLen;
+
+            size_t headLen = EncodeRecordHead(obsPtr, i, head, &tailPtr, &tailLen);
+            size_t padLen = GetBackupPadding(headLen + tailLen);
+
+            if (   !backupWriter_Append(imageRef, head, headLen)
+                || ((tailLen > 0) && !backupWriter_Append(imageRef, tailPtr, tailLen))
+                || ((padLen > 0) && !backupWriter_Append(imageRef, padding, padLen))  )
+            {
+                return false;
+            }
+
+            crc = le_crc_Crc32(head, headLen, crc);
+            if (tailLen > 0)
+            {
+                crc = le_crc_Crc32((const uint8_t*)tailPtr, tailLen, crc);
+            }
+            if (padLen > 0)
+            {
+                crc = le_crc_Crc32(padding, padLen, crc);
+            }
+            blockBytes += headLen + tailLen + padLen;
+        }
+
+        memcpy(blockHeadPtr, &blockBytes, 4);
+        memcpy(blockHeadPtr + 4, &crc, 4);
+    }
+
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decodes a record of a given data type from a backup in memory.  The value of a string or JSON
+ * record is not copied; a pointer to it is returned instead.
+ *
+ * @return The number of bytes in the record (not counting padding), or 0 if it doesn't fit in the
+ *         bytes available.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t DecodeRecord
+(
+    io_DataType_t dataType,
+    const uint8_t* recordPtr,
+    size_t maxBytes,            ///< Number of bytes available from the start of the record.
+    double* timestampPtr,       ///< [OUT] Timestamp.
+    double* numberPtr,          ///< [OUT] Value of a numeric or Boolean (1.0 or 0.0) record.
+    const char** stringPtrPtr,  ///< [OUT] Value of a string or JSON record (not null-terminated).
+    uint32_t* stringLenPtr      ///< [OUT] Length of the value of a string or JSON record.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    size_t len = sizeof(double);
+    if (maxBytes < len)
+    {
+        return 0;
+    }
+    memcpy(timestampPtr, recordPtr, sizeof(double));
+
+    *numberPtr = 0;
+    *stringPtrPtr = NULL;
+    *stringLenPtr = 0;
+
+    switch (dataType)
+    {
+        case IO_DATA_TYPE_TRIGGER:
+
+            // No Value.
+            break;
+
+        case IO_DATA_TYPE_BOOLEAN:
+
+            if (maxBytes < len + 1)
+            {
+                return 0;
+            }
+            *numberPtr = ((recordPtr[len] != 0) ? 1.0 : 0.0);
+            len += 1;
+            break;
+
+        case IO_DATA_TYPE_NUMERIC:
+
+            if (maxBytes < len + sizeof(double))
+            {
+                return 0;
+            }
+            memcpy(numberPtr, recordPtr + len, sizeof(double));
+            len += sizeof(double);
+            break;
+
+        case IO_DATA_TYPE_STRING:
+        case IO_DATA_TYPE_JSON:
+
+            if (maxBytes < len + sizeof(uint32_t))
+            {
+                return 0;
+            }
+            memcpy(stringLenPtr, recordPtr + len, sizeof(uint32_t));
+            len += sizeof(uint32_t);
+            if (maxBytes - len < *stringLenPtr)
+            {
+                return 0;
+            }
+            *stringPtrPtr = (const char*)(recordPtr + len);
+            len += *stringLenPtr;
+            break;
+    }
+
+    return len;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Creates a Data Sample from a record decoded from a backup.
+ *
+ * @return The new Data Sample, or NULL if failed.
+ */
+//--------------------------------------------------------------------------------------------------
+static dataSample_Ref_t CreateSampleFromRecord
+(
+    io_DataType_t dataType,
+    double timestamp,
+    double number,          ///< Value of a numeric or Boolean (1.0 or 0.0) record.
+    const char* stringPtr,  ///< Value of a string or JSON record (not null-terminated).
+    uint32_t stringLen      ///< Length of the value of a string or JSON record.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    switch (dataType)
+    {
+        case IO_DATA_TYPE_TRIGGER:
+
+            return dataSample_CreateTrigger(timestamp);
+
+        case IO_DATA_TYPE_BOOLEAN:
+
+            return dataSample_CreateBoolean(timestamp, (number != 0));
+
+        case IO_DATA_TYPE_NUMERIC:
+
+            return dataSample_CreateNumeric(timestamp, number);
+
+        case IO_DATA_TYPE_STRING:
+        case IO_DATA_TYPE_JSON:
+        {
+            char value[HUB_MAX_STRING_BYTES];
+
+            if (stringLen > (sizeof(value) - 1))
+            {
+                LE_CRIT("String length (%zu) is larger than permitted (%zu).",
+                        (size_t)stringLen,
+                        sizeof(value) - 1);
+                return NULL;
+            }
+            memcpy(value, stringPtr, stringLen);
+            value[stringLen] = '\0';
+
+            if (dataType == IO_DATA_TYPE_STRING)
+            {
+                return dataSample_CreateString(timestamp, value);
+            }
+            return dataSample_CreateJson(timestamp, value);
+        }
+    }
+
+    return NULL;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Restores an Observation's data buffer from a backup in memory (such as a memory-mapped backup
+ * file), in either version of the backup file format.
+ *
+ * The header and each block of records are checked before any of their records are used.  The
+ * records are added straight to the buffer, without creating a Data Sample for each one, except
+ * for the newest, which is pushed to the Observation so it becomes the current value (unless it
+ * already is).
+ */
+//--------------------------------------------------------------------------------------------------
+static void RestoreFromImage
+(
+    Observation_t* obsPtr,
+    const uint8_t* imagePtr,
+    size_t imageSize,
+    const char* name,       ///< Name of the backup, for log messages.
+    bool isDeferred         ///< true = the newest sample is already the current value.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (imageSize < BACKUP_FILE_V0_HEADER_BYTES)
+    {
+        LE_CRIT("Backup '%s' was truncated.", name);
+        return;
+    }
+
+    uint8_t version = imagePtr[0];
+    uint32_t count;
+    uint32_t blockRecords;
+    size_t pos;
+
+    if (version == 0)
+    {
+        // All the records of a version 0 backup are in one block, with no header, CRC or padding.
+        memcpy(&count, imagePtr + 2, 4);
+        blockRecords = count;
+        pos = BACKUP_FILE_V0_HEADER_BYTES;
+    }
+    else if (version == BACKUP_FILE_VERSION)
+    {
+        uint32_t headerCrc;
+        if (imageSize < BACKUP_FILE_HEADER_BYTES)
+        {
+            LE_CRIT("Backup '%s' was truncated.", name);
+            return;
+        }
+        memcpy(&count, imagePtr + 4, 4);
+        memcpy(&blockRecords, imagePtr + 8, 4);
+        memcpy(&headerCrc, imagePtr + 12, 4);
+        if (   (headerCrc != le_crc_Crc32(imagePtr, 12, LE_CRC_START_CRC32))
+            || (blockRecords == 0)  )
+        {
+            LE_CRIT("Backup '%s' has a damaged header.", name);
+            return;
+        }
+        pos = BACKUP_FILE_HEADER_BYTES;
+    }
+    else
+    {
+        LE_CRIT("Backup file format version %d unrecognized.", (int)version);
+        return;
+    }
+
+    io_DataType_t dataType;
+    if (!GetDataTypeFromCode(&dataType, imagePtr[1]))
+    {
+        return;
+    }
+    obsPtr->bufferedType = dataType;
+
+    // The maximum count must be at least the number we read.
+    if (obsPtr->maxCount == 0)
+    {
+        obsPtr->maxCount = count;
+    }
+    // NOTE: Don't enable backups, though, because we don't know the frequency to choose
+    //       and flash wear can permanently damage a device.
+
+    dataSample_Ref_t newestRef = NULL;
+    uint32_t remaining = count;
+
+    while (remaining > 0)
+    {
+        size_t blockEnd = imageSize;
+
+        if (version != 0)
+        {
+            uint32_t blockBytes;
+            uint32_t blockCrc;
+            if (imageSize - pos < BACKUP_BLOCK_HEADER_BYTES)
+            {
+                goto truncated;
+            }
+            memcpy(&blockBytes, imagePtr + pos, 4);
+            memcpy(&blockCrc, imagePtr + pos + 4, 4);
+            pos += BACKUP_BLOCK_HEADER_BYTES;
+            if (imageSize - pos < blockBytes)
+            {
+                goto truncated;
+            }
+            if (blockCrc != le_crc_Crc32(imagePtr + pos, blockBytes, LE_CRC_START_CRC32))
+            {
+                LE_CRIT("Backup '%s' has a damaged block.", name);
+                goto error;
+            }
+            blockEnd = pos + blockBytes;
+        }
+
+        uint32_t blockCount = ((remaining < blockRecords) ? remaining : blockRecords);
+        for (uint32_t i = 0; i < blockCount; i++)
+        {
+            double timestamp;
+            double number;
+            const char* stringPtr;
+            uint32_t stringLen;
+            size_t len = DecodeRecord(dataType,
+                                      imagePtr + pos,
+                                      blockEnd - pos,
+                                      &timestamp,
+                                      &number,
+                                      &stringPtr,
+                                      &stringLen);
+            if (len == 0)
+            {
+                goto truncated;
+            }
+            if (version != 0)
+            {
+                len += GetBackupPadding(len);
+                if (len > blockEnd - pos)
+                {
+                    goto truncated;
+                }
+            }
+            pos += len;
+            remaining--;
+
+            // The newest sample is held back, to be pushed to the Observation once the backup
+            // has been found to contain no more than expected (which would mean that all these
+            // samples are probably corrupt and need to be discarded).
+            if ((remaining == 0) && !isDeferred)
+            {
+                newestRef = CreateSampleFromRecord(dataType,
+                                                   timestamp,
+                                                   number,
+                                                   stringPtr,
+                                                   stringLen);
+                if (newestRef == NULL)
+                {
+                    goto error;
+                }
+                break;
+            }
+
+            le_result_t result;
+            if (stringPtr != NULL)
+            {
+                dataSample_Ref_t sampleRef = CreateSampleFromRecord(dataType,
+                                                                    timestamp,
+                                                                    number,
+                                                                    stringPtr,
+                                                                    stringLen);
+                if (sampleRef == NULL)
+                {
+                    goto error;
+                }
+
+                // The buffer keeps its own reference.
+                result = AddEntryToBuffer(obsPtr, timestamp, number, sampleRef);
+                le_mem_Release(sampleRef);
+            }
+            else
+            {
+                result = AddEntryToBuffer(obsPtr, timestamp, number, NULL);
+            }
+
+            if (result != LE_OK)
+            {
+                goto error;
+            }
+        }
+
+        if (pos != blockEnd)
+        {
+            LE_CRIT("Backup '%s' contains extra samples.", name);
+            goto error;
+        }
+    }
+
+    if (pos != imageSize)
+    {
+        LE_CRIT("Backup '%s' contains extra samples.", name);
+        goto error;
+    }
+
+    if (newestRef != NULL)
+    {
+        res_Push(&obsPtr->resource, dataType, "", newestRef);
+    }
+    return;
+
+truncated:
+
+    LE_CRIT("Backup '%s' was truncated. Expected %u more samples.", name, (unsigned)remaining);
+
+error:
+
+    if (newestRef != NULL)
+    {
+        le_mem_Release(newestRef);
+    }
+
+    // On error, dump the buffer contents in case we read some corrupted samples from the backup.
+    TruncateBuffer(obsPtr, 0);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Restores only the newest sample from a backup in memory, pushing it to an Observation so it
+ * becomes the current value, and leaves the rest of the samples to be loaded when first needed
+ * (see FinishRestore()).  Only version 1 backups can be restored this way; their header and last
+ * block are checked, but none of the other blocks are read.
+ *
+ * @return true if successful, false if the backup must be restored in full instead.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool RestoreNewestFromImage
+(
+    Observation_t* obsPtr,
+    const uint8_t* imagePtr,
+    size_t imageSize
+)
+//--------------------------------------------------------------------------------------------------
+{
+    uint32_t count;
+    uint32_t blockRecords;
+    uint32_t headerCrc;
+    if ((imageSize < BACKUP_FILE_HEADER_BYTES) || (imagePtr[0] != BACKUP_FILE_VERSION))
+    {
+        return false;
+    }
+    memcpy(&count, imagePtr + 4, 4);
+    memcpy(&blockRecords, imagePtr + 8, 4);
+    memcpy(&headerCrc, imagePtr + 12, 4);
+    if (   (headerCrc != le_crc_Crc32(imagePtr, 12, LE_CRC_START_CRC32))
+        || (blockRecords == 0)
+        || (count == 0)  )
+    {
+        return false;
+    }
+
+    io_DataType_t dataType;
+    if (!GetDataTypeFromCode(&dataType, imagePtr[1]))
+    {
+        return false;
+    }
+
+    // Trigger, Boolean and numeric records are all the same size, so the position of the last
+    // block follows from the number of records in it.  Otherwise, the blocks before it are skipped
+    // over one by one.
+    uint32_t lastCount = ((count - 1) % blockRecords) + 1;
+    size_t recordBytes = 0;
+    switch (dataType)
+    {
+        case IO_DATA_TYPE_TRIGGER: recordBytes = sizeof(double);      break;
+        case IO_DATA_TYPE_BOOLEAN: recordBytes = sizeof(double) + 1;  break;
+        case IO_DATA_TYPE_NUMERIC: recordBytes = sizeof(double) * 2;  break;
+        default:                                                      break;
+    }
+
+    size_t pos = BACKUP_FILE_HEADER_BYTES;
+    if (recordBytes > 0)
+    {
+        size_t blockBytes = (recordBytes + GetBackupPadding(recordBytes)) * lastCount;
+        if (imageSize - pos < BACKUP_BLOCK_HEADER_BYTES + blockBytes)
+        {
+            return false;
+        }
+        pos = imageSize - blockBytes - BACKUP_BLOCK_HEADER_BYTES;
+    }
+    else
+    {
+        for (uint32_t skipped = 0; skipped < count - lastCount; skipped += blockRecords)
+        {
+            uint32_t blockBytes;
+            if (imageSize - pos < BACKUP_BLOCK_HEADER_BYTES)
+            {
+                return false;
+            }
+            memcpy(&blockBytes, imagePtr + pos, 4);
+            pos += BACKUP_BLOCK_HEADER_BYTES;
+            if (imageSize - pos < blockBytes)
+            {
+                return false;
+            }
+            pos += blockBytes;
+        }
+    }
+
+    uint32_t blockBytes;
+    uint32_t blockCrc;
+    if (imageSize - pos < BACKUP_BLOCK_HEADER_BYTES)
+    {
+        return false;
+    }
+    memcpy(&blockBytes, imagePtr + pos, 4);
+    memcpy(&blockCrc, imagePtr + pos + 4, 4);
+    pos += BACKUP_BLOCK_HEADER_BYTES;
+    if (   (imageSize - pos != blockBytes)
+        || (blockCrc != le_crc_Crc32(imagePtr + pos, blockBytes, LE_CRC_START_CRC32))  )
+    {
+        return false;
+    }
+
+    double timestamp = 0;
+    double number = 0;
+    const char* stringPtr = NULL;
+    uint32_t stringLen = 0;
+    for (uint32_t i = 0; i < lastCount; i++)
+    {
+        size_t len = DecodeRecord(dataType,
+                                  imagePtr + pos,
+                                  imageSize - pos,
+                                  &timestamp,
+                                  &number,
+                                  &stringPtr,
+                                  &stringLen);
+        if (len == 0)
+        {
+            return false;
+        }
+        len += GetBackupPadding(len);
+        if (len > imageSize - pos)
+        {
+            return false;
+        }
+        pos += len;
+    }
+    if (pos != imageSize)
+    {
+        return false;
+    }
+
+    dataSample_Ref_t sampleRef = CreateSampleFromRecord(dataType,
+                                                        timestamp,
+                                                        number,
+                                                        stringPtr,
+                                                        stringLen);
+    if (sampleRef == NULL)
+    {
+        return false;
+    }
+
+    obsPtr->bufferedType = dataType;
+
+    // The maximum count must be at least the number of samples to be loaded.
+    if (obsPtr->maxCount == 0)
+    {
+        obsPtr->maxCount = count;
+    }
+
+    // Until the rest are loaded, the newest sample is the only one in the buffer.
+    res_Push(&obsPtr->resource, dataType, "", sampleRef);
+    obsPtr->restorePending = true;
+
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Encode the header of a backup log segment file.
+ */
+//--------------------------------------------------------------------------------------------------
+static void EncodeLogHeader
+(
+    uint8_t* headerPtr,     ///< [OUT] Buffer of BACKUP_LOG_HEADER_BYTES bytes.
+    uint32_t generation,    ///< Generation number of the log's base.
+    uint32_t segment        ///< Segment number.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    memcpy(headerPtr, BACKUP_LOG_MAGIC, 4);
+    memcpy(headerPtr + 4, &generation, 4);
+    memcpy(headerPtr + 8, &segment, 4);
+
+    uint32_t crc = le_crc_Crc32(headerPtr, 12, LE_CRC_START_CRC32);
+    memcpy(headerPtr + 12, &crc, 4);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Appends a frame holding the data samples of a given Observation from a given one on (up to the
+ * newest) to a backup log image.
+ *
+ * @return true if successful, false if out of memory.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool AppendLogFrameToImage
+(
+    backupWriter_ImageRef_t imageRef,
+    Observation_t* obsPtr,
+    uint64_t firstSeq       ///< Sequence number of the first sample to write (must be buffered).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    size_t firstIndex = firstSeq - obsPtr->headSeq;
+    uint32_t count = obsPtr->count - firstIndex;
+
+    // The payload's length and CRC come before the payload, so leave room for them and fill them
+    // in once the records have been appended.
+    uint8_t* prefixPtr = backupWriter_Reserve(imageRef, BACKUP_LOG_FRAME_PREFIX_BYTES);
+    if (prefixPtr == NULL)
+    {
+        return false;
+    }
+    size_t payloadStart = backupWriter_GetSize(imageRef);
+
+    uint8_t payloadHead[BACKUP_LOG_FRAME_HEAD_BYTES];
+    memcpy(payloadHead, &obsPtr->headSeq, 8);
+    memcpy(payloadHead + 8, &firstSeq, 8);
+    memcpy(payloadHead + 16, &count, 4);
+    payloadHead[20] = GetDataTypeCode(obsPtr->bufferedType);
+
+    uint32_t crc = le_crc_Crc32(payloadHead, sizeof(payloadHead), LE_CRC_START_CRC32);
+
+    if (   !backupWriter_Append(imageRef, payloadHead, sizeof(payloadHead))
+        || !AppendRecordsToImage(imageRef, obsPtr, firstIndex, &crc)  )
+    {
+        return false;
+    }
+
+    uint32_t payloadLen = backupWriter_GetSize(imageRef) - payloadStart;
+    memcpy(prefixPtr, &payloadLen, 4);
+    memcpy(prefixPtr + 4, &crc, 4);
+
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Back up an Observation's data sample buffer to its backup log, appending only the samples added
+ * since the previous backup, or compacting the log if it has grown too big.
+ *
+ * The log's state is updated as though the write will succeed.  If it doesn't, the log is started
+ * over with a new base (see BackupJobDone()).
+ *
+ * @return The number of bytes to be written.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t BackupToLog
+(
+    Observation_t* obsPtr,
+    const char* backupPath  ///< Path of the Observation's backup file (see GetBackupFilePath()).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    BackupJobType_t type;
+    uint32_t segment;
+    uint64_t firstSeq;
+
+    // Once the samples appended to the log outgrow its base, replaying the log means reading
+    // (and dropping) more samples than the buffer holds, so it's time to compact it.  This keeps
+    // the amount written to flash for each sample to at most about twice the size of its record.
+    if (   obsPtr->logNeedsBase
+        || (   (obsPtr->logAppendedBytes > obsPtr->logBaseBytes)
+            && (obsPtr->logAppendedBytes > BACKUP_LOG_SEGMENT_BYTES)  )
+        || (   (obsPtr->logSegmentBytes >= BACKUP_LOG_SEGMENT_BYTES)
+            && (obsPtr->logSegment + 1 >= BACKUP_LOG_MAX_SEGMENTS)  )  )
+    {
+        type = BACKUP_JOB_LOG_BASE;
+        segment = 0;
+        firstSeq = obsPtr->headSeq;
+    }
+    else
+    {
+        // Samples that were dropped from the buffer before they could be backed up are skipped.
+        firstSeq = obsPtr->logNextSeq;
+        if (firstSeq < obsPtr->headSeq)
+        {
+            firstSeq = obsPtr->headSeq;
+        }
+        if (firstSeq == (obsPtr->headSeq + obsPtr->count))
+        {
+            return 0;
+        }
+
+        // The base is never appended to, so that it stays a single frame written atomically.
+        if ((obsPtr->logSegment == 0) || (obsPtr->logSegmentBytes >= BACKUP_LOG_SEGMENT_BYTES))
+        {
+            type = BACKUP_JOB_LOG_SEGMENT;
+            segment = obsPtr->logSegment + 1;
+        }
+        else
+        {
+            type = BACKUP_JOB_LOG_APPEND;
+            segment = obsPtr->logSegment;
+        }
+    }
+
+    // The new generation number tells the segments that follow a new base apart from any the
+    // old base left behind.
+    uint32_t generation = obsPtr->logGeneration + (type == BACKUP_JOB_LOG_BASE);
+
+    backupWriter_ImageRef_t imageRef = backupWriter_CreateImage();
+    if (imageRef == NULL)
+    {
+        return 0;
+    }
+
+    bool isOk = true;
+    if (type != BACKUP_JOB_LOG_APPEND)
+    {
+        uint8_t header[BACKUP_LOG_HEADER_BYTES];
+        EncodeLogHeader(header, generation, segment);
+        isOk = backupWriter_Append(imageRef, header, sizeof(header));
+    }
+    if (!isOk || !AppendLogFrameToImage(imageRef, obsPtr, firstSeq))
+    {
+        LE_CRIT("Out of memory for backup of '%s'.", backupPath);
+        backupWriter_DeleteImage(imageRef);
+        return 0;
+    }
+
+    size_t bytes = backupWriter_GetSize(imageRef);
+
+    switch (type)
+    {
+        case BACKUP_JOB_LOG_BASE:
+
+            obsPtr->logGeneration = generation;
+            obsPtr->hasLog = true;
+            obsPtr->logNeedsBase = false;
+            obsPtr->logSegment = 0;
+            obsPtr->logSegmentBytes = bytes;
+            obsPtr->logBaseBytes = bytes;
+            obsPtr->logAppendedBytes = 0;
+            break;
+
+        case BACKUP_JOB_LOG_SEGMENT:
+
+            obsPtr->logSegment = segment;
+            obsPtr->logSegmentBytes = bytes;
+            obsPtr->logAppendedBytes += bytes;
+            break;
+
+        default:
+
+            obsPtr->logSegmentBytes += bytes;
+            obsPtr->logAppendedBytes += bytes;
+            break;
+    }
+
+    obsPtr->logNextSeq = obsPtr->headSeq + obsPtr->count;
+
+    SubmitBackupJob(obsPtr, type, backupPath, imageRef, segment);
+
+    return bytes;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reads the header of a backup log segment file and checks that it is intact and belongs to the
+ * log being replayed.
+ *
+ * @return true if the header is good.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool ReadLogHeader
+(
+    FILE* file,
+    uint32_t segment,           ///< Expected segment number.
+    uint32_t* generationPtr     ///< [IN/OUT] Generation number of the log's base (IN unless
+                                ///<          segment is 0).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    uint8_t header[BACKUP_LOG_HEADER_BYTES];
+    if (fread(header, sizeof(header), 1, file) != 1)
+    {
+        return false;
+    }
+
+    uint32_t generation;
+    memcpy(&generation, header + 4, 4);
+    if ((segment > 0) && (generation != *generationPtr))
+    {
+        return false;
+    }
+
+    uint8_t expected[BACKUP_LOG_HEADER_BYTES];
+    EncodeLogHeader(expected, generation, segment);
+    if (memcmp(header, expected, sizeof(header)) != 0)
+    {
+        return false;
+    }
+
+    *generationPtr = generation;
+
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Checks the CRC of a given number of bytes from a file, leaving the file positioned at the start
+ * of those bytes.
+ *
+ * @return true if the bytes could be read and their CRC is as expected.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool CheckFileCrc
+(
+    FILE* file,
+    size_t byteCount,
+    uint32_t expectedCrc
+)
+//--------------------------------------------------------------------------------------------------
+{
+    uint32_t crc = LE_CRC_START_CRC32;
+    size_t remaining = byteCount;
+    while (remaining > 0)
+    {
+        uint8_t chunk[512];
+        size_t chunkLen = ((remaining < sizeof(chunk)) ? remaining : sizeof(chunk));
+
+        if (fread(chunk, 1, chunkLen, file) != chunkLen)
+        {
+            return false;
+        }
+        crc = le_crc_Crc32(chunk, chunkLen, crc);
+        remaining -= chunkLen;
+    }
+
+    return ((crc == expectedCrc) && (fseek(file, -(long)byteCount, SEEK_CUR) == 0));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Checks the CRC of the next frame in a backup log segment file, leaving the file positioned at
+ * the start of the frame's payload.
+ *
+ * @return
+ *      - LE_OK if the frame is intact.
+ *      - LE_UNDERFLOW if there are no more frames in the file.
+ *      - LE_FAULT if the frame is incomplete or damaged.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t CheckLogFrame
+(
+    FILE* file
+)
+//--------------------------------------------------------------------------------------------------
+{
+    uint8_t prefix[BACKUP_LOG_FRAME_PREFIX_BYTES];
+    size_t bytesRead = fread(prefix, 1, sizeof(prefix), file);
+    if ((bytesRead == 0) && feof(file))
+    {
+        return LE_UNDERFLOW;
+    }
+    if (bytesRead < sizeof(prefix))
+    {
+        return LE_FAULT;
+    }
+
+    uint32_t payloadLen;
+    uint32_t crc;
+    memcpy(&payloadLen, prefix, 4);
+    memcpy(&crc, prefix + 4, 4);
+    if (payloadLen < BACKUP_LOG_FRAME_HEAD_BYTES)
+    {
+        return LE_FAULT;
+    }
+
+    // Check the whole payload before any of it is used.
+    if (!CheckFileCrc(file, payloadLen, crc))
+    {
+        return LE_FAULT;
+    }
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reads a record of a given data type from a backup log segment file.
+ *
+ * @return A new Data Sample, or NULL if failed.
+ */
+//--------------------------------------------------------------------------------------------------
+static dataSample_Ref_t ReadLogRecord
+(
+    FILE* file,
+    io_DataType_t dataType
+)
+//--------------------------------------------------------------------------------------------------
+{
+    double timestamp;
+    if (fread(&timestamp, sizeof(timestamp), 1, file) != 1)
+    {
+        return NULL;
+    }
+
+    switch (dataType)
+    {
+        case IO_DATA_TYPE_TRIGGER:
+
+            return dataSample_CreateTrigger(timestamp);
+
+        case IO_DATA_TYPE_BOOLEAN:
+        {
+            uint8_t value;
+            if (fread(&value, 1, 1, file) != 1)
+            {
+                return NULL;
+            }
+            return dataSample_CreateBoolean(timestamp, (value != 0));
+        }
+        case IO_DATA_TYPE_NUMERIC:
+        {
+            double value;
+            if (fread(&value, sizeof(value), 1, file) != 1)
+            {
+                return NULL;
+            }
+            return dataSample_CreateNumeric(timestamp, value);
+        }
+        case IO_DATA_TYPE_STRING:
+        case IO_DATA_TYPE_JSON:
+        {
+            char value[HUB_MAX_STRING_BYTES];
+
+            uint32_t stringLen;
+            if (   (fread(&stringLen, 4, 1, file) != 1)
+                || (stringLen > (sizeof(value) - 1))
+                || (fread(value, 1, stringLen, file) != stringLen)  )
+            {
+                return NULL;
+            }
+            value[stringLen] = '\0';
+
+            if (dataType == IO_DATA_TYPE_STRING)
+            {
+                return dataSample_CreateString(timestamp, value);
+            }
+            return dataSample_CreateJson(timestamp, value);
+        }
+    }
+
+    return NULL;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Discard a given number of the oldest samples replayed so far from a backup log.
+ */
+//--------------------------------------------------------------------------------------------------
+static void DropReplayedSamples
+(
+    Observation_t* obsPtr,
+    LogReplay_t* replayPtr,
+    uint64_t dropCount
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (dropCount < obsPtr->count)
+    {
+        TruncateBuffer(obsPtr, obsPtr->count - dropCount);
+        return;
+    }
+
+    TruncateBuffer(obsPtr, 0);
+
+    if ((dropCount > obsPtr->count) && (replayPtr->newestRef != NULL))
+    {
+        le_mem_Release(replayPtr->newestRef);
+        replayPtr->newestRef = NULL;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Replays a frame from a backup log segment file into a given Observation's buffer.  The file must
+ * be positioned at the start of the frame's payload, which must have passed its CRC check.
+ *
+ * @return true if successful, false if the frame doesn't follow on from the previous frames or
+ *         failed to replay.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool ReplayLogFrame
+(
+    Observation_t* obsPtr,
+    FILE* file,
+    LogReplay_t* replayPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    uint8_t head[BACKUP_LOG_FRAME_HEAD_BYTES];
+    if (fread(head, sizeof(head), 1, file) != 1)
+    {
+        return false;
+    }
+
+    uint64_t oldestSeq;
+    uint64_t firstSeq;
+    uint32_t count;
+    io_DataType_t dataType;
+    memcpy(&oldestSeq, head, 8);
+    memcpy(&firstSeq, head + 8, 8);
+    memcpy(&count, head + 16, 4);
+    if (!GetDataTypeFromCode(&dataType, head[20]) || (firstSeq < oldestSeq))
+    {
+        return false;
+    }
+
+    size_t replayedCount = obsPtr->count + (replayPtr->newestRef != NULL);
+
+    if (replayPtr->started)
+    {
+        // Drop the samples that had been dropped from the buffer by the time the frame was
+        // written.  The samples replayed so far are the newest ones before nextSeq.
+        uint64_t replayedSeq = replayPtr->nextSeq - replayedCount;
+        if (oldestSeq > replayedSeq)
+        {
+            DropReplayedSamples(obsPtr, replayPtr, oldestSeq - replayedSeq);
+            replayedCount = obsPtr->count + (replayPtr->newestRef != NULL);
+        }
+
+        // The frame must start right after the previous one, unless the samples in between
+        // were dropped from the buffer before they could be backed up.
+        if (   (firstSeq < replayPtr->nextSeq)
+            || ((firstSeq > replayPtr->nextSeq) && (replayedCount > 0))  )
+        {
+            LE_CRIT("Backup log frame out of sequence.");
+            return false;
+        }
+    }
+
+    // A change of data type empties the buffer.
+    if (dataType != obsPtr->bufferedType)
+    {
+        DropReplayedSamples(obsPtr, replayPtr, UINT64_MAX);
+        replayedCount = 0;
+        obsPtr->bufferedType = dataType;
+    }
+
+    replayPtr->started = true;
+    replayPtr->nextSeq = firstSeq;
+
+    if (replayPtr->ownsMaxCount && ((replayedCount + count) > obsPtr->maxCount))
+    {
+        obsPtr->maxCount = replayedCount + count;
+    }
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        dataSample_Ref_t sampleRef = ReadLogRecord(file, dataType);
+        if (sampleRef == NULL)
+        {
+            LE_CRIT("Failed to read sample from backup log.");
+            return false;
+        }
+
+        // The newest sample is held back to be pushed to the Observation when the replay is done.
+        if (replayPtr->newestRef != NULL)
+        {
+            le_result_t result = AddToBuffer(obsPtr, replayPtr->newestRef);
+            le_mem_Release(replayPtr->newestRef);
+            replayPtr->newestRef = NULL;
+
+            if (result != LE_OK)
+            {
+                le_mem_Release(sampleRef);
+                return false;
+            }
+        }
+
+        replayPtr->newestRef = sampleRef;
+        replayPtr->nextSeq++;
+    }
+
+    // Compressed buffers leave the maximum count to be enforced by the caller.
+    TruncateBuffer(obsPtr, obsPtr->maxCount);
+
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Finds out whether an Observation has a backup log and, if so, the generation number of its base,
+ * without replaying it.  The next backup to the log starts it over with a new base.
+ */
+//--------------------------------------------------------------------------------------------------
+static void FindLog
+(
+    Observation_t* obsPtr,
+    const char* backupPath  ///< Path of the Observation's backup file (see GetBackupFilePath()).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    char path[MAX_BACKUP_LOG_FILE_PATH_BYTES];
+    if (GetBackupLogFilePath(path, sizeof(path), backupPath, 0) != LE_OK)
+    {
+        return;
+    }
+
+    FILE* file = fopen(path, "rb");
+    if (file == NULL)
+    {
+        return;
+    }
+
+    // Segments left behind by the old base must not be taken for ones following the new base, so
+    // the new base's generation number must follow the old one's.
+    uint32_t generation = 0;
+    if (ReadLogHeader(file, 0, &generation))
+    {
+        obsPtr->logGeneration = generation;
+    }
+    obsPtr->hasLog = true;
+    obsPtr->logNeedsBase = true;
+
+    fclose(file);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Restores an Observation's data buffer from its backup log, if it has one.
+ *
+ * @return true if the Observation has a backup log (even if it could not all be replayed), false
+ *         if not.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool RestoreFromLog
+(
+    Observation_t* obsPtr,
+    const char* backupPath  ///< Path of the Observation's backup file (see GetBackupFilePath()).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LogReplay_t replay = { .started = false,
+                           .ownsMaxCount = (obsPtr->maxCount == 0),
+                           .nextSeq = 0,
+                           .newestRef = NULL };
+    uint32_t generation = 0;
+
+    for (uint32_t segment = 0; segment < BACKUP_LOG_MAX_SEGMENTS; segment++)
+    {
+        char path[MAX_BACKUP_LOG_FILE_PATH_BYTES];
+        if (GetBackupLogFilePath(path, sizeof(path), backupPath, segment) != LE_OK)
+        {
+            return false;
+        }
+
+        FILE* file = fopen(path, "rb");
+        if (file == NULL)
+        {
+            if (segment == 0)
+            {
+                return false;
+            }
+            break;
+        }
+
+        if (segment == 0)
+        {
+            LE_INFO("Loading observation buffer from log '%s'.", path);
+            obsPtr->hasLog = true;
+        }
+
+        bool isComplete = ReadLogHeader(file, segment, &generation);
+
+        while (isComplete)
+        {
+            le_result_t result = CheckLogFrame(file);
+            if (result == LE_UNDERFLOW)
+            {
+                break;
+            }
+
+            isComplete = ((result == LE_OK) && ReplayLogFrame(obsPtr, file, &replay));
+        }
+
+        fclose(file);
+
+        if (!isComplete)
+        {
+            // The rest of the log can't be trusted.  Its next backup will start it over.
+            LE_WARN("Backup log replay stopped at damaged or stale segment '%s'.", path);
+            break;
+        }
+    }
+
+    obsPtr->logGeneration = generation;
+
+    // The newest sample is pushed to the Observation so it becomes the current value.
+    if (replay.newestRef != NULL)
+    {
+        res_Push(&obsPtr->resource, obsPtr->bufferedType, "", replay.newestRef);
+    }
+
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Restores an Observation's data buffer from its backup file, if it has one.
+ *
+ * @return true if the Observation has a backup file (even if it could not all be read), false if
+ *         not.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool RestoreFromFile
+(
+    Observation_t* obsPtr,
+    const char* path,   ///< Path of the Observation's backup file (see GetBackupFilePath()).
+    RestoreMode_t mode
+)
+//--------------------------------------------------------------------------------------------------
+{
+    // Open the file for reading.
+    le_result_t result;
+    FILE* file = le_atomFile_OpenStream(path, LE_FLOCK_READ, &result);
+    if (result != LE_OK)
+    {
+        LE_DEBUG("Unable to open '%s' for reading (%s).", path, LE_RESULT_TXT(result));
+        return false;
+    }
+
+    LE_INFO("Loading observation buffer from file '%s'.", path);
+
+    // The file stays locked until it has been read from its mapping.
+    size_t size;
+    const uint8_t* imagePtr = MapFile(file, &size);
+    if (imagePtr == NULL)
+    {
+        LE_CRIT("Failed to read backup file '%s'.", path);
+    }
+    else
+    {
+        if ((mode != RESTORE_LAZY) || !RestoreNewestFromImage(obsPtr, imagePtr, size))
+        {
+            RestoreFromImage(obsPtr, imagePtr, size, path, (mode == RESTORE_DEFERRED));
+        }
+        UnmapFile(imagePtr, size);
+    }
+
+    le_atomFile_CancelStream(file);
+
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get a backup in the backup pack.  The whole pack file is mapped into memory the first time a
+ * backup is read from it, and stays mapped until the pack file is closed.
+ *
+ * @return Pointer to the backup (entryPtr->length bytes), or NULL if it can't be read.
+ */
+//--------------------------------------------------------------------------------------------------
+static const uint8_t* GetPackedBackup
+(
+    const PackEntry_t* entryPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (PackMapPtr == NULL)
+    {
+        FILE* file = OpenPackFile();
+        if (file != NULL)
+        {
+            PackMapPtr = MapFile(file, &PackMapSize);
+        }
+    }
+
+    if (   (PackMapPtr == NULL)
+        || (entryPtr->offset > PackMapSize)
+        || (entryPtr->length > PackMapSize - entryPtr->offset)  )
+    {
+        LE_CRIT("Backup of '%s' in pack is damaged.", entryPtr->path);
+        return NULL;
+    }
+
+    return PackMapPtr + entryPtr->offset;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Restores an Observation's data buffer from its backup in the backup pack, if the pack holds
+ * one.  The pack is locked meanwhile, as the Backup Writer's thread may be writing it.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RestoreFromPack
+(
+    Observation_t* obsPtr,
+    const char* backupPath, ///< Path of the Observation's backup file (see GetBackupFilePath()).
+    RestoreMode_t mode
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_mutex_Lock(PackMutex);
+
+    const PackEntry_t* entryPtr = FindPackEntry(backupPath);
+    if (entryPtr == NULL)
+    {
+        le_mutex_Unlock(PackMutex);
+        return;
+    }
+
+    LE_INFO("Loading observation buffer '%s' from pack '" BACKUP_PACK_PATH "'.", entryPtr->path);
+
+    const uint8_t* imagePtr = GetPackedBackup(entryPtr);
+    if (   (imagePtr != NULL)
+        && ((mode != RESTORE_LAZY) || !RestoreNewestFromImage(obsPtr, imagePtr, entryPtr->length)))
+    {
+        // The backup is checked before any of it is used.
+        if (le_crc_Crc32(imagePtr, entryPtr->length, LE_CRC_START_CRC32) != entryPtr->crc)
+        {
+            LE_CRIT("Backup of '%s' in pack is damaged.", entryPtr->path);
+        }
+        else
+        {
+            RestoreFromImage(obsPtr,
+                             imagePtr,
+                             entryPtr->length,
+                             entryPtr->path,
+                             (mode == RESTORE_DEFERRED));
+        }
+    }
+
+    le_mutex_Unlock(PackMutex);
+}
+#endif /* end LE_CONFIG_FILESYSTEM */
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Load the rest of an Observation's buffer from its backup, if only its newest sample has been
+ * restored so far (see obs_SetBackupLazyRestore()).  Must be done before anything uses or changes
+ * the buffer, or writes or deletes its backup.
+ */
+//--------------------------------------------------------------------------------------------------
+static void FinishRestore
+(
+    Observation_t* obsPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (!obsPtr->restorePending)
+    {
+        return;
+    }
+    obsPtr->restorePending = false;
+
+#if LE_CONFIG_FILESYSTEM
+    char path[MAX_BACKUP_FILE_PATH_BYTES];
+    if (GetBackupFilePath(path, sizeof(path), obsPtr) != LE_OK)
+    {
+        return;
+    }
+
+    // Make sure the backup isn't about to be changed by backups still being written.
+    WaitForBackupWrites(path);
+
+    // The newest sample is loaded again, along with the rest.
+    TruncateBuffer(obsPtr, 0);
+
+    if (!RestoreFromFile(obsPtr, path, RESTORE_DEFERRED))
+    {
+        RestoreFromPack(obsPtr, path, RESTORE_DEFERRED);
+    }
+
+    TruncateBuffer(obsPtr, obsPtr->maxCount);
+    EnforceRetention(obsPtr);
+    EnforceBudget();
+#endif /* end LE_CONFIG_FILESYSTEM */
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Perform a backup to non-volatile storage of an observation's data sample buffer.  The backup is
+ * written when the batch of backup jobs being built is submitted (see SubmitBackupBatch()).
+ *
+ * @return The number of bytes to be written.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t Backup
+(
+    Observation_t* obsPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    UnscheduleBackup(obsPtr);
+
+    // A backup of only part of the buffer would lose the rest.
+    FinishRestore(obsPtr);
+
+    // Update the time of last backup.
+    le_clk_Time_t now = le_clk_GetRelativeTime();
+    obsPtr->lastBackupTime = now.sec;
+
+    // If a backup is still being written, do this one when it's done.  By then, more samples may
+    // have arrived, which this backup will include too.
+    if (obsPtr->backupJobPtr != NULL)
+    {
+        obsPtr->backupPending = true;
+        return 0;
+    }
+
+#if LE_CONFIG_FILESYSTEM
+    // Get the backup file path.
+    char path[MAX_BACKUP_FILE_PATH_BYTES];
+    if (GetBackupFilePath(path, sizeof(path), obsPtr) != LE_OK)
+    {
+        return 0;
+    }
+
+    LE_DEBUG("Backing up to '%s'...", path);
+
+    // Create the backup directory, if it doesn't exist already.
+    struct stat st = {0};
+    if (stat(BACKUP_DIR, &st) == -1)
+    {
+        LE_DEBUG("Creating directory '" BACKUP_DIR "'.");
+
+        if (mkdir(BACKUP_DIR, 0700) == -1)
+        {
+            LE_CRIT("Unable to create directory '" BACKUP_DIR "' (%m).");
+            return 0;
+        }
+    }
+
+    if (obsPtr->backupLog)
+    {
+        return BackupToLog(obsPtr, path);
+    }
+
+    // Get the data type code.
+    uint8_t typeCode = GetDataTypeCode(res_GetDataType(&obsPtr->resource));
+    if (typeCode == 0)
+    {
+        return 0;
+    }
+
+    backupWriter_ImageRef_t imageRef = backupWriter_CreateImage();
+    if (imageRef == NULL)
+    {
+        return 0;
+    }
+
+    if (!AppendBackupToImage(imageRef, obsPtr, typeCode))
+    {
+        LE_CRIT("Out of memory for backup of '%s'.", path);
+        backupWriter_DeleteImage(imageRef);
+        return 0;
+    }
+
+    size_t bytes = backupWriter_GetSize(imageRef);
+
+    // The backup file (or the backup in the pack) replaces the backup log, if there is one.
+    // Backups in the pack are also checked against a CRC of the whole backup when restored.
+    BackupJobType_t type = (BackupPacked ? BACKUP_JOB_PACK : BACKUP_JOB_FILE);
+    BackupJob_t* jobPtr = SubmitBackupJob(obsPtr, type, path, imageRef, 0);
+    if (type == BACKUP_JOB_PACK)
+    {
+        jobPtr->crc = backupWriter_ComputeCrc32(imageRef);
+    }
+
+    return bytes;
+#else /* !LE_CONFIG_FILESYSTEM */
+    // TODO: implement non-volatile storage without a filesystem.
+    return 0;
+#endif /* end !LE_CONFIG_FILESYSTEM */
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Disable backups of a given Observation's data sample buffer.
+ */
+//--------------------------------------------------------------------------------------------------
+static void DisableBackups
+(
+    Observation_t* obsPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    obsPtr->lastBackupTime = 0;
+
+    // This also takes the Observation's next backup off the schedule.
+    DeleteBackup(obsPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Timer expiry handler function for the backup wheel's tick timer.
+ *
+ * Backs up the data sample buffers of all the Observations whose backups are due, as far as the
+ * flash write budget allows, and submits them to the Backup Writer as one batch.
+ */
+//--------------------------------------------------------------------------------------------------
+static void BackupTickExpired
+(
+    le_timer_Ref_t timer
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_clk_Time_t now = le_clk_GetRelativeTime();
+    uint32_t elapsed = now.sec - LastBackupTick;
+
+    TopUpBackupWriteAllowance(elapsed);
+
+    // Move the Observations whose backups have come due from the slots passed since the last tick
+    // to the due list.  Slots can hold backups due on later turns of the wheel, which stay put.
+    uint32_t slotCount = (elapsed < BACKUP_WHEEL_SLOTS) ? elapsed : BACKUP_WHEEL_SLOTS;
+    for (uint32_t i = 0; i < slotCount; i++)
+    {
+        le_dls_List_t* slotPtr = &BackupWheel[(now.sec - i) % BACKUP_WHEEL_SLOTS];
+
+        le_dls_Link_t* linkPtr = le_dls_Peek(slotPtr);
+        while (linkPtr != NULL)
+        {
+            le_dls_Link_t* nextLinkPtr = le_dls_PeekNext(slotPtr, linkPtr);
+            Observation_t* obsPtr = CONTAINER_OF(linkPtr, Observation_t, backupLink);
+
+            if (obsPtr->backupDueTime <= now.sec)
+            {
+                le_dls_Remove(slotPtr, linkPtr);
+                le_dls_Queue(&DueBackupList, linkPtr);
+                obsPtr->backupListPtr = &DueBackupList;
+            }
+
+            linkPtr = nextLinkPtr;
+        }
+    }
+
+    LastBackupTick = now.sec;
+
+    // Do the due backups.  Backing up takes the Observation off the due list.  Once the allowance
+    // runs out, the rest wait for it to be topped up at later ticks.
+    le_dls_Link_t* linkPtr;
+    while (   ((BackupWriteBudget == 0) || (BackupWriteAllowance > 0))
+           && ((linkPtr = le_dls_Peek(&DueBackupList)) != NULL)  )
+    {
+        size_t bytes = Backup(CONTAINER_OF(linkPtr, Observation_t, backupLink));
+
+        if (BackupWriteBudget > 0)
+        {
+            BackupWriteAllowance -= bytes;
+        }
+    }
+
+    SubmitBackupBatch();
+
+    if (ScheduledBackupCount == 0)
+    {
+        le_timer_Stop(timer);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize the Observation module.
+ *
+ * @warning This must be called before any other function in this module is called.
+ */
+//--------------------------------------------------------------------------------------------------
+void obs_Init
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    ObservationPool = le_mem_InitStaticPool(ObservationPool, DEFAULT_OBSERVATION_POOL_SIZE,
+                        sizeof(Observation_t));
+    le_mem_SetDestructor(ObservationPool, ObservationDestructor);
+
+    ReadOperationPool = le_mem_InitStaticPool(ReadOperationPool,
+                                              DEFAULT_READ_OPERATION_POOL_SIZE,
+                                              sizeof(ReadOperation_t));
+
+    BackupJobPool = le_mem_CreatePool("ObsBackupJob", sizeof(BackupJob_t));
+    BackupBatchPool = le_mem_CreatePool("ObsBackupBatch", sizeof(BackupBatch_t));
+    PackEntryPool = le_mem_CreatePool("ObsBackupPackEntry", sizeof(PackEntry_t));
+    PackMutex = le_mutex_CreateRecursive("ObsBackupPack");
+
+    for (size_t i = 0; i < BACKUP_WHEEL_SLOTS; i++)
+    {
+        BackupWheel[i] = LE_DLS_LIST_INIT;
+    }
+
+    BackupTickTimer = le_timer_Create("ObsBackupTick");
+    LE_ASSERT(le_timer_SetMsInterval(BackupTickTimer, 1000) == LE_OK);
+    LE_ASSERT(le_timer_SetRepeat(BackupTickTimer, 0) == LE_OK);
+    LE_ASSERT(le_timer_SetHandler(BackupTickTimer, BackupTickExpired) == LE_OK);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create an Observation object.  This allocates the object and initializes the class members,
+ * but not the parent class members.
+ *
+ * @return Pointer to the new object or NULL if failed to allocate an observation.
+ */
+//--------------------------------------------------------------------------------------------------
+res_Resource_t* obs_Create
+(
+    resTree_EntryRef_t entryRef ///< The resource tree entry to attach this Resource to.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Observation_t* obsPtr = hub_MemAlloc(ObservationPool);
+
+    if (obsPtr == NULL)
+    {
+        LE_ERROR("Failed to allocate observation");
+        return NULL;
+    }
+    res_Construct(&obsPtr->resource, entryRef);
+
+    obsPtr->lowLimit = NAN;
+    obsPtr->highLimit = NAN;
+    obsPtr->changeBy = NAN;
+    obsPtr->minPeriod = NAN;
+
+    obsPtr->maxCount = 0;
+    obsPtr->count = 0;
+
+    obsPtr->maxAge = NAN;
+    obsPtr->maxBytes = 0;
+    obsPtr->bytes = 0;
+    obsPtr->retentionTimer = NULL;
+
+    obsPtr->priority = 0;
+    obsPtr->evictionCount = 0;
+    obsPtr->link = LE_DLS_LINK_INIT;
+    le_dls_Queue(&ObservationList, &obsPtr->link);
+    ObservationCount++;
+
+    obsPtr->transformType = OBS_TRANSFORM_TYPE_NONE;
+
+    obsPtr->bufferedType = IO_DATA_TYPE_TRIGGER;
+
+    obsPtr->backupPeriod = 0;
+    obsPtr->lastBackupTime = 0;
+    obsPtr->backupLink = LE_DLS_LINK_INIT;
+    obsPtr->backupListPtr = NULL;
+    obsPtr->backupDueTime = 0;
+
+    obsPtr->backupLog = false;
+    obsPtr->hasLog = false;
+    obsPtr->logNeedsBase = true;
+    obsPtr->logGeneration = 0;
+    obsPtr->logSegment = 0;
+    obsPtr->logSegmentBytes = 0;
+    obsPtr->logBaseBytes = 0;
+    obsPtr->logAppendedBytes = 0;
+    obsPtr->logNextSeq = 0;
+    obsPtr->backupJobPtr = NULL;
+    obsPtr->backupPending = false;
+    obsPtr->isPacked = false;
+    obsPtr->restorePending = false;
+    obsPtr->stateImage = 0;
+
+    obsPtr->capacity = 0;
+    obsPtr->head = 0;
+    obsPtr->headSeq = 0;
+    obsPtr->timestamps = NULL;
+    obsPtr->values = NULL;
+
+    obsPtr->statCount = 0;
+    obsPtr->statMean = 0;
+    obsPtr->statM2 = 0;
+    obsPtr->statRemovals = 0;
+    obsPtr->minDeque = (SlotDeque_t){ NULL, 0, 0 };
+    obsPtr->maxDeque = (SlotDeque_t){ NULL, 0, 0 };
+    obsPtr->index = NULL;
+
+    obsPtr->compress = false;
+    obsPtr->isCompressed = false;
+    obsPtr->blocks = NULL;
+    obsPtr->blockCapacity = 0;
+    obsPtr->blockHead = 0;
+    obsPtr->blockCount = 0;
+    obsPtr->blockMinDeque = (SlotDeque_t){ NULL, 0, 0 };
+    obsPtr->blockMaxDeque = (SlotDeque_t){ NULL, 0, 0 };
+    obsPtr->headBlockMin = NAN;
+    obsPtr->headBlockMax = NAN;
+    obsPtr->headBlockStale = false;
+    obsPtr->cacheBlockPtr = NULL;
+
+    obsPtr->readOpList = LE_DLS_LIST_INIT;
+
+    obsPtr->jsonExtraction[0] = '\0';
+
+    obsPtr->destination[0] = '\0';
+
+    return &obsPtr->resource;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Restore an Observation's data buffer from non-volatile backup, if one exists.
+ */
+//--------------------------------------------------------------------------------------------------
+void obs_RestoreBackup
+(
+    res_Resource_t* resPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+#if LE_CONFIG_FILESYSTEM
+    Observation_t* obsPtr = CONTAINER_OF(resPtr, Observation_t, resource);
+
+    char path[MAX_BACKUP_FILE_PATH_BYTES];
+    if (GetBackupFilePath(path, sizeof(path), obsPtr) != LE_OK)
+    {
+        return;
+    }
+
+    // Make sure the files aren't about to be changed (or deleted) by backups still being written.
+    WaitForBackupWrites(path);
+
+    // The backup pack may hold a backup too, but a backup log or backup file is newer.
+    le_mutex_Lock(PackMutex);
+    obsPtr->isPacked = (FindPackEntry(path) != NULL);
+    le_mutex_Unlock(PackMutex);
+
+    // If a newer copy of the buffer is about to be restored from memory, only the backup log needs
+    // to be looked at, so it can be started over properly.  Backup files and backups in the pack
+    // are simply replaced by the next backup.
+    if (BackupRestoreSkipped)
+    {
+        FindLog(obsPtr, path);
+        return;
+    }
+
+    RestoreMode_t mode = (BackupLazyRestore ? RESTORE_LAZY : RESTORE_EAGER);
+
+    // If there's no backup directory yet, then we know there are no backup files, so don't
+    // try opening one (which would result in an error message in the logs because the lock file
+    // can't be created).
+    struct stat st = {0};
+    if (stat(BACKUP_DIR, &st) == -1)
+    {
+        LE_DEBUG("Backup directory '" BACKUP_DIR "' not found. (%m)");
+    }
+    else if (RestoreFromLog(obsPtr, path) || RestoreFromFile(obsPtr, path, mode))
+    {
+        return;
+    }
+
+    if (obsPtr->isPacked)
+    {
+        RestoreFromPack(obsPtr, path, mode);
+    }
+#else /* !LE_CONFIG_FILESYSTEM */
+    // TODO: read from non-volatile storage without a filesystem.
+    LE_UNUSED(resPtr);
+#endif /* end !LE_CONFIG_FILESYSTEM */
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set whether Observations being created skip restoring their buffers from their backups.  This
+ * is for when newer copies of the buffers are about to be restored from memory instead (see
+ * obs_RestoreBufferFromImage()).
+ */
+//--------------------------------------------------------------------------------------------------
+void obs_SkipBackupRestore
+(
+    bool isSkipped  ///< true = skip restoring from backups.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    BackupRestoreSkipped = isSkipped;
+}
+
+
+#if LE_CONFIG_FILESYSTEM
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append a copy of the backup of an Observation whose buffer hasn't been fully restored yet (see
+ * FinishRestore()) to an image, as it is.  The backup holds the whole buffer, so this saves
+ * loading the rest of the buffer just to copy it.
+ *
+ * @return
+ *  - LE_OK if successful.
+ *  - LE_NO_MEMORY if out of memory.
+ *  - LE_FAULT if the backup can't be read, in which case nothing is appended.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t AppendPendingBackupToImage
+(
+    Observation_t* obsPtr,
+    backupWriter_ImageRef_t imageRef
+)
+//--------------------------------------------------------------------------------------------------
+{
+    char path[MAX_BACKUP_FILE_PATH_BYTES];
+    if (GetBackupFilePath(path, sizeof(path), obsPtr) != LE_OK)
+    {
+        return LE_FAULT;
+    }
+
+    // Make sure the backup isn't about to be changed by backups still being written.
+    WaitForBackupWrites(path);
+
+    le_result_t result;
+    FILE* file = le_atomFile_OpenStream(path, LE_FLOCK_READ, &result);
+    if (result == LE_OK)
+    {
+        // The file stays locked until it has been copied from its mapping.
+        size_t size;
+        const uint8_t* imagePtr = MapFile(file, &size);
+        if (imagePtr == NULL)
+        {
+            result = LE_FAULT;
+        }
+        else
+        {
+            result = (backupWriter_Append(imageRef, imagePtr, size) ? LE_OK : LE_NO_MEMORY);
+            UnmapFile(imagePtr, size);
+        }
+
+        le_atomFile_CancelStream(file);
+        return result;
+    }
+
+    // The pack may still be being written for other Observations' backups.
+    le_mutex_Lock(PackMutex);
+
+    result = LE_FAULT;
+    const PackEntry_t* entryPtr = FindPackEntry(path);
+    if (entryPtr != NULL)
+    {
+        const uint8_t* imagePtr = GetPackedBackup(entryPtr);
+        if (   (imagePtr != NULL)
+            && (le_crc_Crc32(imagePtr, entryPtr->length, LE_CRC_START_CRC32) == entryPtr->crc)  )
+        {
+            result = (backupWriter_Append(imageRef, imagePtr, entryPtr->length) ? LE_OK
+                                                                                : LE_NO_MEMORY);
+        }
+    }
+
+    le_mutex_Unlock(PackMutex);
+
+    return result;
+}
+#endif /* end LE_CONFIG_FILESYSTEM */
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append a copy of an Observation's whole data buffer to an image, in the backup file format.
+ * If the buffer hasn't changed since its copy was appended to the image before (the last one
+ * stored in the State Segment), that copy is reused.
+ *
+ * @return true if successful, false if out of memory.
+ */
+//--------------------------------------------------------------------------------------------------
+bool obs_AppendBufferToImage
+(
+    res_Resource_t* resPtr,
+    backupWriter_ImageRef_t imageRef,
+    uint32_t imageNumber,           ///< Number of the image (one more than the image before).
+    const uint8_t* lastImagePtr     ///< The image before, or NULL if it isn't available.
+)
+//--------------------------------------------------------------------------------------------------
+{
+#if LE_CONFIG_FILESYSTEM
+    Observation_t* obsPtr = CONTAINER_OF(resPtr, Observation_t, resource);
+    uint8_t typeCode = GetDataTypeCode(res_GetDataType(&obsPtr->resource));
+    size_t offset = backupWriter_GetSize(imageRef);
+    bool isOk;
+
+    if (   (lastImagePtr != NULL)
+        && (obsPtr->stateImage != 0)
+        && (obsPtr->stateImage == imageNumber - 1)
+        && (obsPtr->stateHeadSeq == obsPtr->headSeq)
+        && (obsPtr->stateSampleCount == obsPtr->count)
+        && (obsPtr->stateTypeCode == typeCode)  )
+    {
+        // Nothing has been added or dropped since the last image, so its copy is still good.
+        isOk = backupWriter_Append(imageRef,
+                                   lastImagePtr + obsPtr->stateOffset,
+                                   obsPtr->stateBytes);
+    }
+    else
+    {
+        le_result_t result = LE_FAULT;
+        if (obsPtr->restorePending)
+        {
+            // The rest of the buffer is still only in the backup, so copy that rather than load
+            // it.  A copy of only part of the buffer would lose the rest, though.
+            result = AppendPendingBackupToImage(obsPtr, imageRef);
+            if (result == LE_FAULT)
+            {
+                FinishRestore(obsPtr);
+            }
+        }
+
+        isOk = (result == LE_FAULT) ? AppendBackupToImage(imageRef, obsPtr, typeCode)
+                                    : (result == LE_OK);
+    }
+
+    if (!isOk)
+    {
+        obsPtr->stateImage = 0;
+        return false;
+    }
+
+    obsPtr->stateImage = imageNumber;
+    obsPtr->stateOffset = offset;
+    obsPtr->stateBytes = backupWriter_GetSize(imageRef) - offset;
+    obsPtr->stateHeadSeq = obsPtr->headSeq;
+    obsPtr->stateSampleCount = obsPtr->count;
+    obsPtr->stateTypeCode = typeCode;
+    return true;
+#else /* !LE_CONFIG_FILESYSTEM */
+    LE_UNUSED(resPtr);
+    LE_UNUSED(imageRef);
+    LE_UNUSED(imageNumber);
+    LE_UNUSED(lastImagePtr);
+    return true;
+#endif /* end !LE_CONFIG_FILESYSTEM */
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Replace an Observation's data buffer with a copy in memory (see obs_AppendBufferToImage()).
+ * None of the samples are pushed to the Observation, so its current value is left as it is.
+ */
+//--------------------------------------------------------------------------------------------------
+void obs_RestoreBufferFromImage
+(
+    res_Resource_t* resPtr,
+    const uint8_t* imagePtr,
+    size_t imageSize,
+    const char* name        ///< Name of the copy, for log messages.
+)
+//--------------------------------------------------------------------------------------------------
+{
+#if LE_CONFIG_FILESYSTEM
+    Observation_t* obsPtr = CONTAINER_OF(resPtr, Observation_t, resource);
+
+    obsPtr->restorePending = false;
+    TruncateBuffer(obsPtr, 0);
+
+    RestoreFromImage(obsPtr, imagePtr, imageSize, name, true);
+
+    TruncateBuffer(obsPtr, obsPtr->maxCount);
+    EnforceRetention(obsPtr);
+    EnforceBudget();
+#else /* !LE_CONFIG_FILESYSTEM */
+    LE_UNUSED(resPtr);
+    LE_UNUSED(imagePtr);
+    LE_UNUSED(imageSize);
+    LE_UNUSED(name);
+#endif /* end !LE_CONFIG_FILESYSTEM */
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Perform JSON extraction.  If the data type is not JSON, does nothing.
+ *
+ * @return LE_OK if successful.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t obs_DoJsonExtraction
+(
+    res_Resource_t* resPtr,
+    io_DataType_t* dataTypePtr,     ///< [INOUT] the data type, may be changed by JSON extraction
+    dataSample_Ref_t* valueRefPtr   ///< [INOUT] the data sample, may be replaced by JSON extraction
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Observation_t* obsPtr = CONTAINER_OF(resPtr, Observation_t, resource);
+
+    // If JSON extraction is enabled,
+    if (obsPtr->jsonExtraction[0] != '\0')
+    {
+        if (*dataTypePtr != IO_DATA_TYPE_JSON)
+        {
+            LE_WARN("Ignoring non-JSON value pushed to observation configured to extract JSON.");
+            return LE_FAULT;
+        }
+
+        // Extract the appropriate JSON data element from the value.
+        io_DataType_t extractedType;
+        dataSample_Ref_t extractedValue = dataSample_ExtractJson(*valueRefPtr,
+                                                                 obsPtr->jsonExtraction,
+                                                                 &extractedType);
+        if (extractedValue == NULL)
+        {
+            // Extraction failed.
+            return LE_FAULT;
+        }
+
+        // Extraction succeeded, so replace value data sample with extracted one.
+        le_mem_Release(*valueRefPtr);
+        *valueRefPtr = extractedValue;
+        *dataTypePtr = extractedType;
+    }
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Determine whether the value should be accepted by a given Observation.
+ *
+ * @warning JSON extraction should be performed first if the data type is JSON.
+ *
+ * @return true if the value should be accepted.
+ */
+//--------------------------------------------------------------------------------------------------
+bool obs_ShouldAccept
+(
+    res_Resource_t* resPtr,
+    io_DataType_t dataType,     ///< [IN] the data type
+    dataSample_Ref_t valueRef   ///< [IN] the data sample
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Observation_t* obsPtr = CONTAINER_OF(resPtr, Observation_t, resource);
+
+    // Check the high limit and low limit before other limits.
+    if (dataType == IO_DATA_TYPE_NUMERIC)
+    {
+        double numericValue = dataSample_GetNumeric(valueRef);
+
+        // If both limits are enabled and the low limit is higher than the high limit, then
+        // this is the "deadband" case. ( - <------HxxxxxxxxxL------> + )
+        if (   (!isnan(obsPtr->highLimit))
+            && (!isnan(obsPtr->lowLimit))
+            && (obsPtr->lowLimit > obsPtr->highLimit)  )
+        {
+            if ((numericValue < obsPtr->lowLimit) && (numericValue > obsPtr->highLimit))
+            {
+                return false;
+            }
+        }
+        // In all other cases, reject if lower than non-NAN low limit or higher than non-NAN high.
+        else
+        {
+            if ((!isnan(obsPtr->lowLimit)) && (numericValue < obsPtr->lowLimit))
+            {
+                return false;
+            }
+
+            if ((!isnan(obsPtr->highLimit)) && (numericValue > obsPtr->highLimit))
+            {
+                return false;
+            }
+        }
+    }
+
+    // The current time in ms since some unspecified start time.
+    uint32_t now = 0;
+
+    // If we have received a push before (giving us something to compare against),
+    // Check the minPeriod and changeBy,
+    dataSample_Ref_t previousValue = res_GetCurrentValue(resPtr);
+    if (previousValue != NULL)
+    {
+        // If there is a changedBy filter in effect,
+        if ((obsPtr->changeBy != 0) && (!isnan(obsPtr->changeBy)))
+        {
+            // If overridden, reject everything because the value won't change.
+            if (res_IsOverridden(resPtr))
+            {
+                return false;
+            }
+
+            // If the data type has changed, we can't do a comparison, so only check the changeBy
+            // filter if the new data sample's type is the same as the previous current value's
+            // type.
+            if (dataType == res_GetDataType(resPtr))
+            {
+                // If this is a numeric value and the last value was numeric too,
+                if (dataType == IO_DATA_TYPE_NUMERIC)
+                {
+                    // Reject changes in the current value smaller than the changeBy setting.
+                    double previousNumber = dataSample_GetNumeric(previousValue);
+                    if (  fabs(dataSample_GetNumeric(valueRef) - previousNumber)
+                        < obsPtr->changeBy)
+                    {
+                        return false;
+                    }
+                }
+                // For Boolean, a non-zero changeBy means filter out if unchanged.
+                else if (dataType == IO_DATA_TYPE_BOOLEAN)
+                {
+                    if (dataSample_GetBoolean(valueRef) == dataSample_GetBoolean(previousValue))
+                    {
+                        return false;
+                    }
+                }
+                // For string or JSON, a non-zero changeBy means filter out if unchanged.
+                else if (   (dataType == IO_DATA_TYPE_STRING)
+                         || (dataType == IO_DATA_TYPE_JSON))
+                {
+                    if (0 == strcmp(dataSample_GetString(valueRef),
+                                    dataSample_GetString(previousValue)))
+                    {
+                        return false;
+                    }
+                }
+            }
+        }
+
+        // All of the above can be done without a system call, so that's why we do the
+        // minPeriod check last.
+        if ((obsPtr->minPeriod != 0) && (!isnan(obsPtr->minPeriod)))
+        {
+            now = GetRelativeTimeMs();  // system call
+
+            if ((now - obsPtr->lastPushTime) < (obsPtr->minPeriod * 1000))
             {
                 return false;
             }
+        }
+    }
+
+    // Update the time of last update.
+    if (now == 0)
+    {
+        now = GetRelativeTimeMs(); // system call
+    }
+    obsPtr->lastPushTime = now;
+
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Perform processing of an accepted pushed data sample that is specific to an Observation
+ * resource.
+ */
+//--------------------------------------------------------------------------------------------------
+void obs_ProcessAccepted
+(
+    res_Resource_t* resPtr,
+    io_DataType_t dataType,     ///< Data type of the data sample.
+    dataSample_Ref_t sampleRef  ///< Data sample.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Observation_t* obsPtr = CONTAINER_OF(resPtr, Observation_t, resource);
+    FinishRestore(obsPtr);
+
+    if (obsPtr->maxCount > 0)
+    {
+        // If the data type has changed, we have to dump the current set of buffered samples.
+        if (obsPtr->bufferedType != dataType)
+        {
+            TruncateBuffer(obsPtr, 0);
+            DiscardIndex(obsPtr);
+
+            obsPtr->bufferedType = dataType;
+        }
+
+        if (AddToBuffer(obsPtr, sampleRef) != LE_OK)
+        {
+            LE_ERROR("Failed to an accepted sample to buffer");
+            return;
+        }
+
+        TruncateBuffer(obsPtr, obsPtr->maxCount);
+        EnforceRetention(obsPtr);
+        EnforceBudget();
+
+        // If the buffer backup period is non-zero, then back-ups are enabled.  If there isn't
+        // already a backup scheduled, schedule one for when the backup period will have passed
+        // since the last backup (or for the next tick of the backup wheel, if it already has).
+        if ((obsPtr->backupPeriod > 0) && (obsPtr->backupListPtr == NULL))
+        {
+            ScheduleBackup(obsPtr, obsPtr->lastBackupTime + obsPtr->backupPeriod);
+        }
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Perform any post-filtering on a given Observation.
+ */
+//--------------------------------------------------------------------------------------------------
+dataSample_Ref_t obs_ApplyTransform
+(
+    res_Resource_t* resPtr,
+    io_DataType_t dataType,     ///< Data type of the data sample.
+    dataSample_Ref_t sampleRef  ///< Data sample.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Observation_t* obsPtr = CONTAINER_OF(resPtr, Observation_t, resource);
+    dataSample_Ref_t sample = sampleRef;
+    double transformVal;
+
+
+    switch (obsPtr->transformType)
+    {
+        case OBS_TRANSFORM_TYPE_NONE:
+            break;
+
+        case OBS_TRANSFORM_TYPE_MEAN:
+            transformVal = obs_QueryMean(resPtr, NAN, NAN);
+            break;
+
+        case OBS_TRANSFORM_TYPE_STDDEV:
+            transformVal = obs_QueryStdDev(resPtr, NAN, NAN);
+            break;
+
+        case OBS_TRANSFORM_TYPE_MAX:
+            transformVal = obs_QueryMax(resPtr, NAN, NAN);
+            break;
+
+        case OBS_TRANSFORM_TYPE_MIN:
+            transformVal = obs_QueryMin(resPtr, NAN, NAN);
+            break;
+
+        default:
+            LE_FATAL("Invalid transform type %d", obsPtr->transformType);
+            break;
+    }
+
+    // If transformed value differs from the input sample, update the sample
+    if (OBS_TRANSFORM_TYPE_NONE != obsPtr->transformType)
+    {
+        sample = UpdateSample(sampleRef, dataType, (void *)&transformVal);
+    }
+
+    return sample;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the minimum period between data samples accepted by a given Observation.
+ *
+ * This is used to throttle the rate of data passing into and through an Observation.
+ */
+//--------------------------------------------------------------------------------------------------
+void obs_SetMinPeriod
+(
+    res_Resource_t* resPtr,
+    double minPeriod
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Observation_t* obsPtr = CONTAINER_OF(resPtr, Observation_t, resource);
+
+    obsPtr->minPeriod = minPeriod;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the minimum period between data samples accepted by a given Observation.
+ *
+ * @return The value, or 0 if not set.
+ */
+//--------------------------------------------------------------------------------------------------
+double obs_GetMinPeriod
+(
+    res_Resource_t* resPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Observation_t* obsPtr = CONTAINER_OF(resPtr, Observation_t, resource);
+
+    return obsPtr->minPeriod;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the highest value in a range that will be accepted by a given Observation.
+ *
+ * Ignored for all non-numeric types except Boolean for which non-zero = true and zero = false.
+ */
+//--------------------------------------------------------------------------------------------------
+void obs_SetHighLimit
+(
+    res_Resource_t* resPtr,
+    double highLimit
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Observation_t* obsPtr = CONTAINER_OF(resPtr, Observation_t, resource);
+
+    obsPtr->highLimit = highLimit;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the highest value in a range that will be accepted by a given Observation.
+ *
+ * @return The value, or NAN (not a number) if not set.
+ */
+//--------------------------------------------------------------------------------------------------
+double obs_GetHighLimit
+(
+    res_Resource_t* resPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Observation_t* obsPtr = CONTAINER_OF(resPtr, Observation_t, resource);
+
+    return obsPtr->highLimit;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the lowest value in a range that will be accepted by a given Observation.
+ *
+ * Ignored for all non-numeric types except Boolean for which non-zero = true and zero = false.
+ */
+//--------------------------------------------------------------------------------------------------
+void obs_SetLowLimit
+(
+    res_Resource_t* resPtr,
+    double lowLimit
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Observation_t* obsPtr = CONTAINER_OF(resPtr, Observation_t, resource);
+
+    obsPtr->lowLimit = lowLimit;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the lowest value in a range that will be accepted by a given Observation.
+ *
+ * @return The value, or NAN (not a number) if not set.
+ */
+//--------------------------------------------------------------------------------------------------
+double obs_GetLowLimit
+(
+    res_Resource_t* resPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Observation_t* obsPtr = CONTAINER_OF(resPtr, Observation_t, resource);
+
+    return obsPtr->lowLimit;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the magnitude that a new value must vary from the current value to be accepted by
+ * a given Observation.
+ *
+ * Ignored for trigger types.
+ *
+ * For all other types, any non-zero value means accept any change, but drop if the same as current.
+ */
+//--------------------------------------------------------------------------------------------------
+void obs_SetChangeBy
+(
+    res_Resource_t* resPtr,
+    double change
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Observation_t* obsPtr = CONTAINER_OF(resPtr, Observation_t, resource);
+
+    obsPtr->changeBy = change;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the magnitude that a new value must vary from the current value to be accepted by
+ * a given Observation.
+ *
+ * @return The value, or 0 if not set.
+ */
+//--------------------------------------------------------------------------------------------------
+double obs_GetChangeBy
+(
+    res_Resource_t* resPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Observation_t* obsPtr = CONTAINER_OF(resPtr, Observation_t, resource);
+
+    return obsPtr->changeBy;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Perform a transform on buffered data. Value of the observation will be the output of the
+ * transform
+ *
+ * Ignored for all non-numeric types except Boolean for which non-zero = true and zero = false.
+ */
+//--------------------------------------------------------------------------------------------------
+void obs_SetTransform
+(
+    res_Resource_t* resPtr,
+    obs_TransformType_t transformType,
+    const double* paramsPtr,
+    size_t paramsSize
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Observation_t* obsPtr = CONTAINER_OF(resPtr, Observation_t, resource);
 
-            if ((!isnan(obsPtr->highLimit)) && (numericValue > obsPtr->highLimit))
-            {
-                return false;
-            }
-        }
+    obsPtr->transformType = transformType;
+
+    // The buffer is about to be cleared, so there's no need to finish restoring it.
+    obsPtr->restorePending = false;
+
+    // If the transform is being set to anything other than NONE, ensure there is at least one
+    // data sample buffered in order to allow transforms to behave properly
+    if (   (OBS_TRANSFORM_TYPE_NONE != obsPtr->transformType)
+        && (0 == obsPtr->maxCount))
+    {
+        obsPtr->maxCount = 1;
     }
 
-    // The current time in ms since some unspecified start time.
-    uint32_t now = 0;
+    // Clear the buffer and current value of the observation.  Do this even if the same transform
+    // is being re-applied.  This allows any cumulative behavior to be cleared
+    TruncateBuffer(obsPtr, 0);
+    if (resPtr->pushedValue != NULL)
+    {
+        le_mem_Release(resPtr->pushedValue);
+        resPtr->pushedValue = NULL;
+    }
 
-    // If we have received a push before (giving us something to compare against),
-    // Check the minPeriod and changeBy,
-    dataSample_Ref_t previousValue = res_GetCurrentValue(resPtr);
-    if (previousValue != NULL)
+    (void)paramsPtr;
+    (void)paramsSize;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the type of transform currently applied to an Observation.
+ *
+ * @return The TransformType
+ */
+//--------------------------------------------------------------------------------------------------
+obs_TransformType_t obs_GetTransform
+(
+    res_Resource_t* resPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Observation_t* obsPtr = CONTAINER_OF(resPtr, Observation_t, resource);
+
+    return obsPtr->transformType;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the maximum number of data samples to buffer in a given Observation.  Buffers are FIFO
+ * circular buffers. When full, the buffer drops the oldest value to make room for a new addition.
+ */
+//--------------------------------------------------------------------------------------------------
+void obs_SetBufferMaxCount
+(
+    res_Resource_t* resPtr,
+    uint32_t count
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Observation_t* obsPtr = CONTAINER_OF(resPtr, Observation_t, resource);
+
+    // The ring can't hold any more than this, so larger sizes are clamped rather than accepted
+    // and silently not honoured.
+    if (count > ((uint32_t)1 << MAX_RING_CAPACITY_BITS))
     {
-        // If there is a changedBy filter in effect,
-        if ((obsPtr->changeBy != 0) && (!isnan(obsPtr->changeBy)))
+        LE_WARN("Buffer size of %" PRIu32 " samples is too large. Using %" PRIu32 ".",
+                count,
+                (uint32_t)1 << MAX_RING_CAPACITY_BITS);
+        count = (uint32_t)1 << MAX_RING_CAPACITY_BITS;
+    }
+
+    // While a lazy restore is pending, a new size is applied when the rest of the buffer is loaded,
+    // so resizing doesn't force the load.  If buffering is being disabled, the buffer is about to
+    // be emptied, so there's no need to finish restoring it.
+    if (count == 0)
+    {
+        obsPtr->restorePending = false;
+    }
+
+    // If the buffer size is being changed,
+    if (obsPtr->maxCount != count)
+    {
+        // If the size is now zero and backups were enabled, disable backups.
+        if ((count == 0) && (obsPtr->backupPeriod > 0))
         {
-            // If overridden, reject everything because the value won't change.
-            if (res_IsOverridden(resPtr))
-            {
-                return false;
-            }
+            DisableBackups(obsPtr);
+        }
 
-            // If the data type has changed, we can't do a comparison, so only check the changeBy
-            // filter if the new data sample's type is the same as the previous current value's
-            // type.
-            if (dataType == res_GetDataType(resPtr))
-            {
-                // If this is a numeric value and the last value was numeric too,
-                if (dataType == IO_DATA_TYPE_NUMERIC)
-                {
-                    // Reject changes in the current value smaller than the changeBy setting.
-                    double previousNumber = dataSample_GetNumeric(previousValue);
-                    if (  fabs(dataSample_GetNumeric(valueRef) - previousNumber)
-                        < obsPtr->changeBy)
-                    {
-                        return false;
-                    }
-                }
-                // For Boolean, a non-zero changeBy means filter out if unchanged.
-                else if (dataType == IO_DATA_TYPE_BOOLEAN)
-                {
-                    if (dataSample_GetBoolean(valueRef) == dataSample_GetBoolean(previousValue))
-                    {
-                        return false;
-                    }
-                }
-                // For string or JSON, a non-zero changeBy means filter out if unchanged.
-                else if (   (dataType == IO_DATA_TYPE_STRING)
-                         || (dataType == IO_DATA_TYPE_JSON))
-                {
-                    if (0 == strcmp(dataSample_GetString(valueRef),
-                                    dataSample_GetString(previousValue)))
-                    {
-                        return false;
-                    }
-                }
-            }
+        // Update the size.
+        obsPtr->maxCount = count;
+
+        // Discard extra samples if the size has shrunk.
+        TruncateBuffer(obsPtr, count);
+
+        // Release the ring buffer if buffering is now disabled, or move the samples to a smaller
+        // one if the size has shrunk.  If it has grown, the ring is grown on the next push.
+        size_t capacity = (count == 0) ? 0 : GetRingCapacity(count);
+        if (capacity < obsPtr->capacity)
+        {
+            (void)ResizeRing(obsPtr, capacity);
+        }
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the buffer size setting for a given Observation.
+ *
+ * @return The buffer size (in number of samples) or 0 if not set.
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t obs_GetBufferMaxCount
+(
+    res_Resource_t* resPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Observation_t* obsPtr = CONTAINER_OF(resPtr, Observation_t, resource);
+
+    return obsPtr->maxCount;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Timer expiry handler function that drops samples from an Observation's buffer as they get older
+ * than its maximum age.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RetentionTimerExpired
+(
+    le_timer_Ref_t timer
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Observation_t* obsPtr = le_timer_GetContextPtr(timer);
+
+    EnforceRetention(obsPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the maximum age of the data samples buffered in a given Observation.  Samples timestamped
+ * longer ago than this are dropped from the buffer, as well as any dropped to respect its maximum
+ * count.
+ */
+//--------------------------------------------------------------------------------------------------
+void obs_SetBufferMaxAge
+(
+    res_Resource_t* resPtr,
+    double seconds  ///< Maximum age (NAN or 0 = no limit).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Observation_t* obsPtr = CONTAINER_OF(resPtr, Observation_t, resource);
+
+    // While a lazy restore is pending, the limit is enforced again once the rest of the buffer has
+    // been loaded (see FinishRestore()), so there's no need to load it now.
+    if (!(seconds > 0))
+    {
+        seconds = NAN;
+    }
+
+    obsPtr->maxAge = seconds;
+
+    if (isnan(seconds))
+    {
+        if (obsPtr->retentionTimer != NULL)
+        {
+            le_timer_Delete(obsPtr->retentionTimer);
+            obsPtr->retentionTimer = NULL;
+        }
+    }
+    else
+    {
+        if (obsPtr->retentionTimer == NULL)
+        {
+            obsPtr->retentionTimer = le_timer_Create("retention");
+            LE_ASSERT(le_timer_SetHandler(obsPtr->retentionTimer, RetentionTimerExpired) == LE_OK);
+            LE_ASSERT(le_timer_SetContextPtr(obsPtr->retentionTimer, obsPtr) == LE_OK);
+        }
+        else
+        {
+            // The timer may have been started for a longer maximum age.
+            le_timer_Stop(obsPtr->retentionTimer);
         }
+    }
+
+    EnforceRetention(obsPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the maximum age of the data samples buffered in a given Observation.
+ *
+ * @return The maximum age (in seconds) or NAN if not set.
+ */
+//--------------------------------------------------------------------------------------------------
+double obs_GetBufferMaxAge
+(
+    res_Resource_t* resPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Observation_t* obsPtr = CONTAINER_OF(resPtr, Observation_t, resource);
+
+    return obsPtr->maxAge;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the maximum number of bytes of memory that the data samples buffered in a given Observation
+ * can use.  This counts all the memory allocated for the buffer: the ring of samples (including
+ * any slots not yet filled), its statistics index, the compressed blocks, and the contents of
+ * strings.  When the limit is exceeded, the oldest samples are dropped (shrinking the ring) until
+ * it isn't, as well as any dropped to respect the maximum count.
+ */
+//--------------------------------------------------------------------------------------------------
+void obs_SetBufferMaxBytes
+(
+    res_Resource_t* resPtr,
+    uint32_t bytes  ///< Maximum number of bytes (0 = no limit).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Observation_t* obsPtr = CONTAINER_OF(resPtr, Observation_t, resource);
+
+    // As for the maximum age, a pending restore enforces this once the buffer has been loaded.
+    obsPtr->maxBytes = bytes;
+
+    EnforceRetention(obsPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the maximum number of bytes of memory that the data samples buffered in a given Observation
+ * can use.
+ *
+ * @return The maximum number of bytes or 0 if not set.
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t obs_GetBufferMaxBytes
+(
+    res_Resource_t* resPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Observation_t* obsPtr = CONTAINER_OF(resPtr, Observation_t, resource);
+
+    return obsPtr->maxBytes;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the priority of the data samples buffered in a given Observation.  When the samples buffered
+ * in all Observations use more memory than the hub's buffer memory budget, samples are evicted
+ * from the lowest priority buffers first.
+ */
+//--------------------------------------------------------------------------------------------------
+void obs_SetBufferPriority
+(
+    res_Resource_t* resPtr,
+    int32_t priority ///< Higher = samples kept longer (default 0).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Observation_t* obsPtr = CONTAINER_OF(resPtr, Observation_t, resource);
 
-        // All of the above can be done without a system call, so that's why we do the
-        // minPeriod check last.
-        if ((obsPtr->minPeriod != 0) && (!isnan(obsPtr->minPeriod)))
-        {
-            now = GetRelativeTimeMs();  // system call
+    obsPtr->priority = priority;
+}
 
-            if ((now - obsPtr->lastPushTime) < (obsPtr->minPeriod * 1000))
-            {
-                return false;
-            }
-        }
-    }
 
-    // Update the time of last update.
-    if (now == 0)
-    {
-        now = GetRelativeTimeMs(); // system call
-    }
-    obsPtr->lastPushTime = now;
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the priority of the data samples buffered in a given Observation.
+ *
+ * @return The priority.
+ */
+//--------------------------------------------------------------------------------------------------
+int32_t obs_GetBufferPriority
+(
+    res_Resource_t* resPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Observation_t* obsPtr = CONTAINER_OF(resPtr, Observation_t, resource);
 
-    return true;
+    return obsPtr->priority;
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Perform processing of an accepted pushed data sample that is specific to an Observation
- * resource.
+ * Enable or disable compression of the numeric and Boolean data samples buffered in a given
+ * Observation.  Compressed samples take much less memory, but are slower to read at random.
+ * Samples already in the buffer are compressed (or decompressed) right away.
  */
 //--------------------------------------------------------------------------------------------------
-void obs_ProcessAccepted
+void obs_SetBufferCompression
 (
     res_Resource_t* resPtr,
-    io_DataType_t dataType,     ///< Data type of the data sample.
-    dataSample_Ref_t sampleRef  ///< Data sample.
+    bool compress   ///< true = compress numerical samples (default false).
 )
 //--------------------------------------------------------------------------------------------------
 {
     Observation_t* obsPtr = CONTAINER_OF(resPtr, Observation_t, resource);
 
-    if (obsPtr->maxCount > 0)
-    {
-        // If the data type has changed, we have to dump the current set of buffered samples.
-        if (obsPtr->bufferedType != dataType)
-        {
-            TruncateBuffer(obsPtr, 0);
+    obsPtr->compress = compress;
 
-            obsPtr->bufferedType = dataType;
-        }
+    // While a lazy restore is pending, the rest of the buffer is loaded into an empty buffer,
+    // which takes on the new setting then, so changing it doesn't force the load.
+    if (obsPtr->restorePending)
+    {
+        return;
+    }
 
-        if (AddToBuffer(obsPtr, sampleRef) != LE_OK)
+    if (   (obsPtr->count > 0)
+        && IsNumerical(obsPtr->bufferedType)
+        && (obsPtr->isCompressed != compress)  )
+    {
+        le_result_t result = (compress ? MoveRingToBlocks(obsPtr) : MoveBlocksToRing(obsPtr));
+        if (result != LE_OK)
         {
-            LE_ERROR("Failed to an accepted sample to buffer");
-            return;
+            LE_ERROR("Failed to %s buffered samples (%s).",
+                     compress ? "compress" : "decompress",
+                     LE_RESULT_TXT(result));
         }
 
-        TruncateBuffer(obsPtr, obsPtr->maxCount);
+        // Decompressing takes more memory.
+        EnforceRetention(obsPtr);
+        EnforceBudget();
+    }
+}
 
-        // If the buffer backup period is non-zero, then back-ups are enabled.
-        if (obsPtr->backupPeriod > 0)
-        {
-            // If more than the backup period has passed since the time of last backup, do a backup.
-            uint32_t nextBackupTime = obsPtr->lastBackupTime + obsPtr->backupPeriod;
-            le_clk_Time_t now = le_clk_GetRelativeTime();
-            if (nextBackupTime <= now.sec)
-            {
-                Backup(obsPtr);
-            }
-            // If the backup period hasn't passed yet, and there isn't already a timer running,
-            // then start a timer to expire when it's time to do a backup.
-            else if (obsPtr->backupTimer == NULL)
-            {
-                uint32_t timerInterval = (nextBackupTime - now.sec) * 1000;
 
-                obsPtr->backupTimer = le_timer_Create("backup");
-                LE_ASSERT(le_timer_SetMsInterval(obsPtr->backupTimer, timerInterval) == LE_OK);
-                LE_ASSERT(le_timer_SetHandler(obsPtr->backupTimer, BackupTimerExpired) == LE_OK);
-                LE_ASSERT(le_timer_SetContextPtr(obsPtr->backupTimer, obsPtr) == LE_OK);
-                LE_ASSERT(le_timer_Start(obsPtr->backupTimer) == LE_OK);
-            }
-        }
-    }
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether compression of the numerical data samples buffered in a given Observation is
+ * enabled.
+ *
+ * @return true if enabled.
+ */
+//--------------------------------------------------------------------------------------------------
+bool obs_GetBufferCompression
+(
+    res_Resource_t* resPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Observation_t* obsPtr = CONTAINER_OF(resPtr, Observation_t, resource);
+
+    return obsPtr->compress;
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Perform any post-filtering on a given Observation.
+ * Get the number of bytes of memory allocated for the samples buffered in a given Observation, and
+ * the number of samples that have been evicted from its buffer to stay within the hub's buffer
+ * memory budget.
  */
 //--------------------------------------------------------------------------------------------------
-dataSample_Ref_t obs_ApplyTransform
+void obs_GetBufferMemoryUsage
 (
     res_Resource_t* resPtr,
-    io_DataType_t dataType,     ///< Data type of the data sample.
-    dataSample_Ref_t sampleRef  ///< Data sample.
+    uint64_t* bytesPtr, ///< [OUT] Bytes allocated for the buffer.
+    uint64_t* evictionCountPtr ///< [OUT] Samples evicted to stay within the budget.
 )
 //--------------------------------------------------------------------------------------------------
 {
     Observation_t* obsPtr = CONTAINER_OF(resPtr, Observation_t, resource);
-    dataSample_Ref_t sample = sampleRef;
-    double transformVal;
 
+    *bytesPtr = obsPtr->bytes;
+    *evictionCountPtr = obsPtr->evictionCount;
+}
 
-    switch (obsPtr->transformType)
-    {
-        case OBS_TRANSFORM_TYPE_NONE:
-            break;
 
-        case OBS_TRANSFORM_TYPE_MEAN:
-            transformVal = obs_QueryMean(resPtr, NAN);
-            break;
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the maximum number of bytes of memory that the data samples buffered in all Observations can
+ * use (counted the same way as an Observation's maximum number of bytes).  When the budget is
+ * exceeded, the oldest samples are evicted from the buffers of the lowest priority Observations.
+ */
+//--------------------------------------------------------------------------------------------------
+void obs_SetBufferBudget
+(
+    uint32_t bytes  ///< Maximum number of bytes (0 = no limit).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    BufferBudget = bytes;
 
-        case OBS_TRANSFORM_TYPE_STDDEV:
-            transformVal = obs_QueryStdDev(resPtr, NAN);
-            break;
+    EnforceBudget();
+}
 
-        case OBS_TRANSFORM_TYPE_MAX:
-            transformVal = obs_QueryMax(resPtr, NAN);
-            break;
 
-        case OBS_TRANSFORM_TYPE_MIN:
-            transformVal = obs_QueryMin(resPtr, NAN);
-            break;
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the maximum number of bytes of memory that the data samples buffered in all Observations can
+ * use.
+ *
+ * @return The maximum number of bytes or 0 if not set.
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t obs_GetBufferBudget
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return BufferBudget;
+}
 
-        default:
-            LE_FATAL("Invalid transform type %d", obsPtr->transformType);
-            break;
-    }
 
-    // If transformed value differs from the input sample, update the sample
-    if (OBS_TRANSFORM_TYPE_NONE != obsPtr->transformType)
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of bytes of memory allocated for the samples buffered in all Observations, and
+ * the number of samples that have been evicted from their buffers to stay within the hub's buffer
+ * memory budget.
+ */
+//--------------------------------------------------------------------------------------------------
+void obs_GetTotalBufferMemoryUsage
+(
+    uint64_t* bytesPtr,         ///< [OUT] Bytes allocated for all buffers.
+    uint64_t* evictionCountPtr  ///< [OUT] Samples evicted to stay within the budget.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    *bytesPtr = BufferedBytes;
+    *evictionCountPtr = EvictionCount;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the minimum time between backups of an Observation's buffer to non-volatile storage.
+ * If the buffer's size is non-zero and the backup period is non-zero, then the buffer will be
+ * backed-up to non-volatile storage when it changes, but never more often than this period setting
+ * specifies.
+ */
+//--------------------------------------------------------------------------------------------------
+void obs_SetBufferBackupPeriod
+(
+    res_Resource_t* resPtr,
+    uint32_t seconds
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Observation_t* obsPtr = CONTAINER_OF(resPtr, Observation_t, resource);
+
+    // Disabling backups deletes the backup, so the rest of the buffer must be loaded from it first.
+    // Otherwise, the next backup finishes any pending restore before writing.
+    if (seconds == 0)
     {
-        sample = UpdateSample(sampleRef, dataType, (void *)&transformVal);
+        FinishRestore(obsPtr);
     }
 
-    return sample;
+    uint32_t oldPeriod = obsPtr->backupPeriod;
+
+    // If the period is being changed,
+    if (oldPeriod != seconds)
+    {
+        obsPtr->backupPeriod = seconds;
+
+        // If the buffer size is zero, then backups aren't done, so we can skip the rest.
+        if (obsPtr->maxCount > 0)
+        {
+            // If the period is now zero, disable backups.
+            if (seconds == 0)
+            {
+                DisableBackups(obsPtr);
+            }
+            // If there's nothing in the buffer, we can skip the rest and just wait for something
+            // to be added to the buffer.
+            else if (obsPtr->count > 0)
+            {
+                // If backups were already enabled and the period has just changed,
+                if (oldPeriod != 0)
+                {
+                    // If a backup is scheduled, then we know there's something waiting to be
+                    // backed up, so move it to when the new period will have passed since the
+                    // last backup.  Otherwise, we wait for something to be added to the buffer.
+                    if (obsPtr->backupListPtr != NULL)
+                    {
+                        ScheduleBackup(obsPtr, obsPtr->lastBackupTime + seconds);
+                    }
+                }
+            }
+        }
+    }
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Set the minimum period between data samples accepted by a given Observation.
+ * Get the minimum time between backups of an Observation's buffer to non-volatile storage.
+ * See admin_SetBufferBackupPeriod() for more information.
  *
- * This is used to throttle the rate of data passing into and through an Observation.
+ * @return The buffer backup period (in seconds) or 0 if backups are disabled or the Observation
+ *         does not exist.
  */
 //--------------------------------------------------------------------------------------------------
-void obs_SetMinPeriod
+uint32_t obs_GetBufferBackupPeriod
+(
+    res_Resource_t* resPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Observation_t* obsPtr = CONTAINER_OF(resPtr, Observation_t, resource);
+
+    return obsPtr->backupPeriod;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set whether an Observation's buffer is backed up by appending the samples added since the
+ * previous backup to a log, rather than by rewriting the whole buffer to its backup file.
+ * The log is compacted every so often, by writing the whole buffer again.
+ */
+//--------------------------------------------------------------------------------------------------
+void obs_SetBufferBackupLog
 (
     res_Resource_t* resPtr,
-    double minPeriod
+    bool useLog  ///< true = append to a log, false = rewrite the backup file (default).
 )
 //--------------------------------------------------------------------------------------------------
 {
     Observation_t* obsPtr = CONTAINER_OF(resPtr, Observation_t, resource);
 
-    obsPtr->minPeriod = minPeriod;
+    // No need to finish any pending restore here, as the next backup does so before writing.
+    if (obsPtr->backupLog != useLog)
+    {
+        obsPtr->backupLog = useLog;
+
+        // Switching to a log starts it with a new base.  Switching back replaces any existing log
+        // with the backup file at the next backup.
+        obsPtr->logNeedsBase = true;
+    }
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Get the minimum period between data samples accepted by a given Observation.
+ * Check whether an Observation's buffer is backed up by appending to a log.
  *
- * @return The value, or 0 if not set.
+ * @return true if backed up to a log.
  */
 //--------------------------------------------------------------------------------------------------
-double obs_GetMinPeriod
+bool obs_GetBufferBackupLog
 (
     res_Resource_t* resPtr
 )
@@ -1889,542 +8140,900 @@ double obs_GetMinPeriod
 {
     Observation_t* obsPtr = CONTAINER_OF(resPtr, Observation_t, resource);
 
-    return obsPtr->minPeriod;
+    return obsPtr->backupLog;
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Set the highest value in a range that will be accepted by a given Observation.
+ * Set the maximum number of bytes that backups of all Observations' buffers can write to
+ * non-volatile storage per hour.  Backups that would exceed it are put off until enough time has
+ * passed, oldest due first.
+ */
+//--------------------------------------------------------------------------------------------------
+void obs_SetBackupWriteBudget
+(
+    uint32_t bytesPerHour   ///< Maximum number of bytes per hour (0 = no limit).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    // Start with a full hour's allowance.
+    BackupWriteBudget = bytesPerHour;
+    BackupWriteAllowance = bytesPerHour;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the maximum number of bytes that backups of all Observations' buffers can write to
+ * non-volatile storage per hour.
  *
- * Ignored for all non-numeric types except Boolean for which non-zero = true and zero = false.
+ * @return The maximum number of bytes per hour, or 0 if not set.
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t obs_GetBackupWriteBudget
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return BackupWriteBudget;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set whether the buffers of all Observations (other than those backed up to a log) are backed up
+ * together into a single pack file, instead of each into its own backup file.  Each buffer's backup
+ * moves at its next backup.
+ */
+//--------------------------------------------------------------------------------------------------
+void obs_SetBackupPacked
+(
+    bool isPacked   ///< true = back up into the pack file.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    BackupPacked = isPacked;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether the buffers of all Observations (other than those backed up to a log) are backed
+ * up together into a single pack file.
+ *
+ * @return true if backed up into the pack file.
+ */
+//--------------------------------------------------------------------------------------------------
+bool obs_GetBackupPacked
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return BackupPacked;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set whether buffers are restored lazily from their backups: when an Observation is created, only
+ * the newest sample is restored (as the current value), and the rest are loaded when the buffer is
+ * first needed.  Only affects Observations created afterwards.
  */
 //--------------------------------------------------------------------------------------------------
-void obs_SetHighLimit
+void obs_SetBackupLazyRestore
 (
-    res_Resource_t* resPtr,
-    double highLimit
+    bool isLazy     ///< true = restore lazily.
 )
 //--------------------------------------------------------------------------------------------------
 {
-    Observation_t* obsPtr = CONTAINER_OF(resPtr, Observation_t, resource);
-
-    obsPtr->highLimit = highLimit;
+    BackupLazyRestore = isLazy;
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Get the highest value in a range that will be accepted by a given Observation.
+ * Check whether buffers are restored lazily from their backups.
  *
- * @return The value, or NAN (not a number) if not set.
+ * @return true if restored lazily.
  */
 //--------------------------------------------------------------------------------------------------
-double obs_GetHighLimit
+bool obs_GetBackupLazyRestore
 (
-    res_Resource_t* resPtr
+    void
 )
 //--------------------------------------------------------------------------------------------------
 {
-    Observation_t* obsPtr = CONTAINER_OF(resPtr, Observation_t, resource);
-
-    return obsPtr->highLimit;
+    return BackupLazyRestore;
 }
 
 
+#if LE_CONFIG_LINUX
 //--------------------------------------------------------------------------------------------------
 /**
- * Set the lowest value in a range that will be accepted by a given Observation.
+ * Check whether a backup is still wanted, i.e., its Observation exists and has backups enabled.
  *
- * Ignored for all non-numeric types except Boolean for which non-zero = true and zero = false.
+ * @return true if wanted (or if the Observation's path is too long to check), false if not.
  */
 //--------------------------------------------------------------------------------------------------
-void obs_SetLowLimit
+static bool IsBackupInUse
 (
-    res_Resource_t* resPtr,
-    double lowLimit
+    const char* relPath,    ///< Path of the backup file relative to BACKUP_DIR.
+    size_t obsPathLen       ///< Length of the part of relPath that is the Observation's path
+                            ///< relative to the /obs/ namespace.
 )
 //--------------------------------------------------------------------------------------------------
 {
-    Observation_t* obsPtr = CONTAINER_OF(resPtr, Observation_t, resource);
+    // Copy all but the suffix into the observation path.
+    size_t obsPathBytes = obsPathLen + sizeof("/obs/");
+    char obsPath[HUB_MAX_RESOURCE_PATH_BYTES];
+    if (obsPathBytes >= sizeof(obsPath))
+    {
+        LE_ERROR("Length of path too long. Skipping '%s'.", relPath);
+        return true;
+    }
+    (void)snprintf(obsPath, obsPathBytes, "/obs/%s", relPath);
 
-    obsPtr->lowLimit = lowLimit;
+    resTree_EntryRef_t entryRef = resTree_FindEntry(resTree_GetRoot(), obsPath);
+
+    return (   (entryRef != NULL)
+            && (resTree_GetEntryType(entryRef) == ADMIN_ENTRY_TYPE_OBSERVATION)
+            && (resTree_GetBufferBackupPeriod(entryRef) != 0)  );
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Get the lowest value in a range that will be accepted by a given Observation.
+ * Function that gets called for each file system object (file, directory, symlink, etc.) found
+ * under the backup directory.
  *
- * @return The value, or NAN (not a number) if not set.
+ * @return 0 to continue the file system tree walk, non-zero to stop.
  */
 //--------------------------------------------------------------------------------------------------
-double obs_GetLowLimit
+static int BackupDirTreeWalkCallback
 (
-    res_Resource_t* resPtr
+    const char *fpath,      ///< File system path of the object.
+    const struct stat *sb,  ///< Ptr to the stat() info for the object.
+    int typeflag,           ///< What type of file system object we're looking at.
+    struct FTW *ftwbuf      ///< Ptr to buffer containing the basename and the nesting level.
 )
 //--------------------------------------------------------------------------------------------------
 {
-    Observation_t* obsPtr = CONTAINER_OF(resPtr, Observation_t, resource);
+    switch (typeflag)
+    {
+        case FTW_F:  // regular file
+        {
+            // Compute the resource tree entry path of the associated Observation.
+            const char* relPath = fpath + BACKUP_DIR_PATH_LEN;
+            const char* suffixPtr = strstr(relPath, BACKUP_SUFFIX);
+            if (suffixPtr == NULL)
+            {
+                suffixPtr = strstr(relPath, BACKUP_LOG_SUFFIX);
+            }
+            if (suffixPtr == NULL)
+            {
+                LE_WARN("Unexpected file in backup directory. Skipping '%s'.", fpath);
+                return 0;
+            }
 
-    return obsPtr->lowLimit;
+            // If that Observation doesn't exist, or its backup period is 0, delete the file.
+            if (!IsBackupInUse(relPath, suffixPtr - relPath))
+            {
+                if (unlink(fpath) != 0)
+                {
+                    LE_CRIT("Failed to delete '%s' (%m).", fpath);
+                }
+            }
+
+            return 0;
+        }
+        case FTW_D:  // directory and FTW_DEPTH was NOT specified
+
+            // This should never happen, because we specified FTW_DEPTH.
+            LE_CRIT("Received FTW_D flag for '%s'!", fpath);
+            return 0;
+
+        case FTW_DNR:   // directory that can't be read
+
+            LE_ERROR("Can't read directory '%s'", fpath);
+            return 0;
+
+        case FTW_DP:    // directory and FTW_DEPTH was specified
+        {
+            // If the directory is empty, delete it.
+            int result = rmdir(fpath);
+            if ((result == -1) && (errno != ENOTEMPTY) && (errno != EEXIST))
+            {
+                LE_CRIT("Failed to remove directory '%s' (%m).", fpath);
+            }
+            return 0;
+        }
+        case FTW_NS:     // stat() call failed on fpath
+
+            LE_CRIT("Failed to stat '%s'", fpath);
+            return 0;
+
+        case FTW_SL:     // symbolic link and FTW_PHYS specified
+
+            // This should never happen, because we didn't specify FTW_PHYS.
+            LE_CRIT("Received FTW_SL flag for '%s'!", fpath);
+            return 0;
+
+        case FTW_SLN:    // symbolic link pointing to a nonexistent file
+
+            LE_CRIT("Broken symlink found at '%s'", fpath);
+            return 0;
+    }
+
+    LE_CRIT("Unexpected type flag %d.", typeflag);
+
+    return -1;
 }
+#endif /* end LE_CONFIG_LINUX */
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Set the magnitude that a new value must vary from the current value to be accepted by
- * a given Observation.
- *
- * Ignored for trigger types.
- *
- * For all other types, any non-zero value means accept any change, but drop if the same as current.
+ * Delete buffer backup files that aren't being used.
  */
 //--------------------------------------------------------------------------------------------------
-void obs_SetChangeBy
+void obs_DeleteUnusedBackupFiles
 (
-    res_Resource_t* resPtr,
-    double change
+    void
 )
 //--------------------------------------------------------------------------------------------------
 {
-    Observation_t* obsPtr = CONTAINER_OF(resPtr, Observation_t, resource);
+#if LE_CONFIG_LINUX
+    LE_DEBUG("Cleaning up unused buffer backup files.");
 
-    obsPtr->changeBy = change;
+    // Make sure no backups are still being written to the files being examined.
+    backupWriter_Flush();
+
+    // Walk the directory tree under the backup directory.
+    // For each file, compute the resource tree entry path of the associated Observation.
+    // If that Observation doesn't exist, delete the file.
+    // If the directory is empty (after examining all files in it), delete the directory.
+    // Note: The number of file descriptors allowed to be used is selected to prevent
+    // running into the app's open file descriptor limit, while avoiding a lot of opening
+    // and closing of directories.  Normally we don't expect a lot of depth in the Observation
+    // resource naming heirarchy, so there shouldn't be a lot of depth in the backup directory.
+    int result = nftw(BACKUP_DIR,
+                      BackupDirTreeWalkCallback,
+                      4 /* max fds */,
+                      FTW_DEPTH /* depth-first traversal */);
+    if (result != 0)
+    {
+        if (errno == ENOENT)
+        {
+            LE_DEBUG("No backup directory. Skipping backup file clean-up.");
+        }
+        else
+        {
+            LE_CRIT("Failed to traverse backup directory '%s' (%m)", BACKUP_DIR);
+        }
+    }
+
+    // Drop the backups in the backup pack whose Observations don't exist (or have backups
+    // disabled), too.  Start-up restores are done with the pack file by now, so close it.
+    le_mutex_Lock(PackMutex);
+    LoadPackIndex();
+    ClosePackFile();
+
+    for (le_dls_Link_t* linkPtr = le_dls_Peek(&PackEntryList);
+         linkPtr != NULL;
+         linkPtr = le_dls_PeekNext(&PackEntryList, linkPtr))
+    {
+        PackEntry_t* entryPtr = CONTAINER_OF(linkPtr, PackEntry_t, link);
+        const char* relPath = entryPtr->path + BACKUP_DIR_PATH_LEN;
+        size_t relPathLen = strlen(relPath);
+
+        if (   (relPathLen > BACKUP_SUFFIX_LEN)
+            && !IsBackupInUse(relPath, relPathLen - BACKUP_SUFFIX_LEN)  )
+        {
+            SubmitBackupJob(NULL, BACKUP_JOB_DELETE, entryPtr->path, NULL, 0);
+        }
+    }
+    le_mutex_Unlock(PackMutex);
+    SubmitBackupBatch();
+#endif /* end LE_CONFIG_LINUX */
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Get the magnitude that a new value must vary from the current value to be accepted by
- * a given Observation.
+ * Convert a time given as either seconds before now or seconds since the Epoch into seconds
+ * since the Epoch.
  *
- * @return The value, or 0 if not set.
+ * @return The absolute time.
  */
 //--------------------------------------------------------------------------------------------------
-double obs_GetChangeBy
+static double GetAbsoluteTime
 (
-    res_Resource_t* resPtr
+    double time     ///< If < 30 years, count back from now; else absolute time.
 )
 //--------------------------------------------------------------------------------------------------
 {
-    Observation_t* obsPtr = CONTAINER_OF(resPtr, Observation_t, resource);
+    // If the time is less than or equal to 30 years, then convert to an
+    // absolute timestamp by subtracting it from the current time.
+    if (time <= THIRTY_YEARS)
+    {
+        le_clk_Time_t now = le_clk_GetAbsoluteTime();
+        time = ((((double)(now.usec)) / 1000000) + now.sec) - time;
+    }
 
-    return obsPtr->changeBy;
+    return time;
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Perform a transform on buffered data. Value of the observation will be the output of the
- * transform
+ * Binary search part of a given Observation's buffer for the oldest sample that is newer than
+ * (or, if requested, the same age as) a given time.  This is O(log N) in the number of buffered
+ * samples.  In a compressed buffer, the blocks are binary searched by the timestamps of their
+ * newest samples, then the block found is scanned.
  *
- * Ignored for all non-numeric types except Boolean for which non-zero = true and zero = false.
+ * @return the position of the sample in the buffer (0 = oldest), or the buffer's count if not
+ *         found.
  */
 //--------------------------------------------------------------------------------------------------
-void obs_SetTransform
+static size_t SearchBuffer
 (
-    res_Resource_t* resPtr,
-    obs_TransformType_t transformType,
-    const double* paramsPtr,
-    size_t paramsSize
+    Observation_t* obsPtr,
+    size_t index,       ///< Position to start searching from (0 = oldest).
+    double time,        ///< Absolute time (seconds since the Epoch).
+    bool includeEqual   ///< true to stop at a sample timestamped exactly at the given time.
 )
 //--------------------------------------------------------------------------------------------------
 {
-    Observation_t* obsPtr = CONTAINER_OF(resPtr, Observation_t, resource);
-
-    obsPtr->transformType = transformType;
+    // Buffered timestamps never decrease from oldest to newest (AddToBuffer() makes sure of
+    // that), so the samples that are too old to qualify are all at the oldest end.
+    size_t end = obsPtr->count;
 
-    // If the transform is being set to anything other than NONE, ensure there is at least one
-    // data sample buffered in order to allow transforms to behave properly
-    if (   (OBS_TRANSFORM_TYPE_NONE != obsPtr->transformType)
-        && (0 == obsPtr->maxCount))
+    if (obsPtr->isCompressed && (index < end))
     {
-        obsPtr->maxCount = 1;
+        size_t first = FindBlock(obsPtr, obsPtr->headSeq + index);
+        size_t blockEnd = obsPtr->blockCount;
+
+        while (first < blockEnd)
+        {
+            size_t middle = first + ((blockEnd - first) / 2);
+            double timestamp = GetBlock(obsPtr, middle)->lastTimestamp;
+
+            if (includeEqual ? (timestamp < time) : (timestamp <= time))
+            {
+                first = middle + 1;
+            }
+            else
+            {
+                blockEnd = middle;
+            }
+        }
+
+        if (first == obsPtr->blockCount)
+        {
+            return end;
+        }
+
+        // The sample is in this block, no older than the position searching started from.
+        CompressedBlock_t* blockPtr = GetBlock(obsPtr, first);
+        if (blockPtr->firstSeq > (obsPtr->headSeq + index))
+        {
+            index = blockPtr->firstSeq - obsPtr->headSeq;
+        }
+
+        for (;;)
+        {
+            double timestamp = GetBufferedTimestamp(obsPtr, index);
+
+            if (includeEqual ? (timestamp >= time) : (timestamp > time))
+            {
+                return index;
+            }
+
+            index++;
+        }
     }
 
-    // Clear the buffer and current value of the observation.  Do this even if the same transform
-    // is being re-applied.  This allows any cumulative behavior to be cleared
-    TruncateBuffer(obsPtr, 0);
-    if (resPtr->pushedValue != NULL)
+    while (index < end)
     {
-        le_mem_Release(resPtr->pushedValue);
-        resPtr->pushedValue = NULL;
+        size_t middle = index + ((end - index) / 2);
+        double timestamp = GetBufferedTimestamp(obsPtr, middle);
+
+        if (includeEqual ? (timestamp < time) : (timestamp <= time))
+        {
+            index = middle + 1;
+        }
+        else
+        {
+            end = middle;
+        }
     }
 
-    (void)paramsPtr;
-    (void)paramsSize;
+    return index;
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Get the type of transform currently applied to an Observation.
+ * Find the data sample at or after a given timestamp in a given Observation's buffer.
+ * This is O(log N) in the number of buffered samples.
  *
- * @return The TransformType
+ * @return the position of the sample in the buffer (0 = oldest), or the buffer's count if not
+ *         found.
  */
 //--------------------------------------------------------------------------------------------------
-obs_TransformType_t obs_GetTransform
+static size_t FindBufferIndex
 (
-    res_Resource_t* resPtr
+    Observation_t* obsPtr,
+    double startTime   ///< NAN for oldest; if < 30 years, count back from now; else absolute time.
 )
 //--------------------------------------------------------------------------------------------------
 {
-    Observation_t* obsPtr = CONTAINER_OF(resPtr, Observation_t, resource);
+    if ((obsPtr->count == 0) || isnan(startTime))
+    {
+        return 0;
+    }
 
-    return obsPtr->transformType;
+    return SearchBuffer(obsPtr, 0, GetAbsoluteTime(startTime), true);
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Set the maximum number of data samples to buffer in a given Observation.  Buffers are FIFO
- * circular buffers. When full, the buffer drops the oldest value to make room for a new addition.
+ * Find the end of the time span ending at a given timestamp in a given Observation's buffer.
+ * This is O(log N) in the number of buffered samples.
+ *
+ * @return the position in the buffer (0 = oldest) of the oldest sample newer than the end time,
+ *         or the buffer's count if there is none.
  */
 //--------------------------------------------------------------------------------------------------
-void obs_SetBufferMaxCount
+static size_t FindBufferEnd
 (
-    res_Resource_t* resPtr,
-    uint32_t count
+    Observation_t* obsPtr,
+    double endTime   ///< NAN for newest; if < 30 years, count back from now; else absolute time.
 )
 //--------------------------------------------------------------------------------------------------
 {
-    Observation_t* obsPtr = CONTAINER_OF(resPtr, Observation_t, resource);
-
-    // If the buffer size is being changed,
-    if (obsPtr->maxCount != count)
+    if ((obsPtr->count == 0) || isnan(endTime))
     {
-        // If the size is now zero and backups were enabled, disable backups.
-        if ((count == 0) && (obsPtr->backupPeriod > 0))
-        {
-            DisableBackups(obsPtr);
-        }
-
-        // Update the size.
-        obsPtr->maxCount = count;
-
-        // Discard extra samples if the size has shrunk.
-        TruncateBuffer(obsPtr, count);
+        return obsPtr->count;
     }
+
+    return SearchBuffer(obsPtr, 0, GetAbsoluteTime(endTime), false);
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Get the buffer size setting for a given Observation.
+ * Find the oldest data sample in a given Observation's buffer that is newer than a given
+ * timestamp.  A sample exactly matching the startAfter time is skipped.
  *
- * @return The buffer size (in number of samples) or 0 if not set.
+ * @return the position of the sample in the buffer (0 = oldest), or the buffer's count if not
+ *         found.
  */
 //--------------------------------------------------------------------------------------------------
-uint32_t obs_GetBufferMaxCount
+static size_t FindBufferIndexAfter
 (
-    res_Resource_t* resPtr
+    Observation_t* obsPtr,
+    double startAfter   ///< NAN for oldest; if < 30 years, count back from now; else absolute time.
 )
 //--------------------------------------------------------------------------------------------------
 {
-    Observation_t* obsPtr = CONTAINER_OF(resPtr, Observation_t, resource);
+    size_t index = FindBufferIndex(obsPtr, startAfter);
 
-    return obsPtr->maxCount;
+    // If the data sample found is an exact match for the startAfter time, then skip to the
+    // sample after that.
+    if ((index < obsPtr->count) && (GetBufferedTimestamp(obsPtr, index) == startAfter))
+    {
+        index++;
+    }
+
+    return index;
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Set the minimum time between backups of an Observation's buffer to non-volatile storage.
- * If the buffer's size is non-zero and the backup period is non-zero, then the buffer will be
- * backed-up to non-volatile storage when it changes, but never more often than this period setting
- * specifies.
+ * Read data out of a buffer.  Data is written to a given file descriptor in JSON-encoded format
+ * as an array of objects containing a timestamp and a value (or just a timestamp for triggers).
+ * E.g.,
+ *
+ * @code
+ * [{"t":1537483647.125,"v":true},{"t":1537483657.128,"v":true}]
+ * @endcode
  */
 //--------------------------------------------------------------------------------------------------
-void obs_SetBufferBackupPeriod
+void obs_ReadBufferJson
 (
-    res_Resource_t* resPtr,
-    uint32_t seconds
+    res_Resource_t* resPtr, ///< Ptr to the resource object for the Observation.
+    double startAfter,  ///< Start after this many seconds ago, or after an absolute number of
+                        ///< seconds since the Epoch (if startafter > 30 years).
+                        ///< Use NAN (not a number) to read the whole buffer.
+    int outputFile, ///< File descriptor to write the data to.
+    query_ReadCompletionFunc_t handlerPtr, ///< Completion callback.
+    void* contextPtr    ///< Value to be passed to completion callback.
 )
 //--------------------------------------------------------------------------------------------------
 {
     Observation_t* obsPtr = CONTAINER_OF(resPtr, Observation_t, resource);
+    FinishRestore(obsPtr);
 
-    uint32_t oldPeriod = obsPtr->backupPeriod;
-
-    // If the period is being changed,
-    if (oldPeriod != seconds)
-    {
-        obsPtr->backupPeriod = seconds;
+    size_t index = FindBufferIndexAfter(obsPtr, startAfter);
 
-        // If the buffer size is zero, then backups aren't done, so we can skip the rest.
-        if (obsPtr->maxCount > 0)
-        {
-            // If the period is now zero, disable backups.
-            if (seconds == 0)
-            {
-                DisableBackups(obsPtr);
-            }
-            // If there's nothing in the buffer, we can skip the rest and just wait for something
-            // to be added to the buffer.
-            else if (!le_sls_IsEmpty(&obsPtr->sampleList))
-            {
-                // If backups were already enabled and the period has just changed,
-                if (oldPeriod != 0)
-                {
-                    // If the timer is running, then we know there's something waiting to be
-                    // backed up.  Otherwise, we wait for something to be added to the buffer.
-                    if (obsPtr->backupTimer != NULL)
-                    {
-                        // Stop the old timer, because we know it has the wrong interval.
-                        le_timer_Stop(obsPtr->backupTimer);
-
-                        // If the backup period has passed since the last backup,
-                        // release the timer and do a backup now.
-                        uint32_t nextBackupTime = obsPtr->lastBackupTime + seconds;
-                        le_clk_Time_t now = le_clk_GetRelativeTime();
-                        if (nextBackupTime < now.sec)
-                        {
-                            le_timer_Delete(obsPtr->backupTimer);
-                            obsPtr->backupTimer = NULL;
-
-                            Backup(obsPtr);
-                        }
-                        else // If the backup period has not yet passed, correct the timer's
-                             // interval and restart it.
-                        {
-                            uint32_t timerInterval = (nextBackupTime - now.sec) * 1000;
-                            LE_ASSERT(le_timer_SetMsInterval(obsPtr->backupTimer, timerInterval)
-                                      == LE_OK);
-                            LE_ASSERT(le_timer_Start(obsPtr->backupTimer) == LE_OK);
-                        }
-                    }
-                }
-            }
-        }
-    }
+    StartRead(obsPtr, obsPtr->headSeq + index, NULL, 0, false, outputFile, handlerPtr, contextPtr);
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Get the minimum time between backups of an Observation's buffer to non-volatile storage.
- * See admin_SetBufferBackupPeriod() for more information.
+ * Read data out of a buffer in binary form, so that the samples can be copied straight into
+ * arrays.  The same eight-byte header as a buffer exported by obs_ExportBuffer() is written to a
+ * given file descriptor (format version 0, a data type code: 't' = trigger, 'b' = Boolean,
+ * 'n' = numeric, 's' = string, 'j' = JSON, two zero bytes, then the number of records as a 4-byte
+ * unsigned integer), followed by that many packed records, in the layout used by backup files:
  *
- * @return The buffer backup period (in seconds) or 0 if backups are disabled or the Observation
- *         does not exist.
+ *  - timestamp (8-byte double), followed by
+ *  - nothing for a trigger,
+ *  - one byte (0 or 1) for a Boolean,
+ *  - the value (8-byte double) for a numeric, or
+ *  - the length (4-byte unsigned) of the value for a string or JSON, then the value itself
+ *    (without null terminator).
+ *
+ * Multi-byte fields are little-endian.  Only the samples buffered when the read starts are read.
+ * If any of them are dropped from the buffer before they are written, or the type of data in the
+ * buffer changes, the read ends early and LE_OUT_OF_RANGE is passed to the completion callback.
  */
 //--------------------------------------------------------------------------------------------------
-uint32_t obs_GetBufferBackupPeriod
+void obs_ReadBufferBinary
 (
-    res_Resource_t* resPtr
+    res_Resource_t* resPtr, ///< Ptr to the resource object for the Observation.
+    double startAfter,  ///< Start after this many seconds ago, or after an absolute number of
+                        ///< seconds since the Epoch (if startafter > 30 years).
+                        ///< Use NAN (not a number) to read the whole buffer.
+    int outputFile, ///< File descriptor to write the data to.
+    query_ReadCompletionFunc_t handlerPtr, ///< Completion callback.
+    void* contextPtr    ///< Value to be passed to completion callback.
 )
 //--------------------------------------------------------------------------------------------------
 {
     Observation_t* obsPtr = CONTAINER_OF(resPtr, Observation_t, resource);
+    FinishRestore(obsPtr);
 
-    return obsPtr->backupPeriod;
+    size_t index = FindBufferIndexAfter(obsPtr, startAfter);
+
+    StartRead(obsPtr, obsPtr->headSeq + index, NULL, 0, true, outputFile, handlerPtr, contextPtr);
 }
 
 
-#if LE_CONFIG_LINUX
 //--------------------------------------------------------------------------------------------------
 /**
- * Function that gets called for each file system object (file, directory, symlink, etc.) found
- * under the backup directory.
+ * Export a read-only copy of the data in a buffer through a sealed shared memory file, which the
+ * caller can mmap() instead of having the samples streamed to it.  The file contains
  *
- * @return 0 to continue the file system tree walk, non-zero to stop.
+ *  - format version (1 byte, 0),
+ *  - data type code used in backup files (1 byte: 't', 'b' or 'n'),
+ *  - two zero bytes,
+ *  - the number of samples, N (uint32_t),
+ *  - N timestamps (doubles, oldest first), then
+ *  - N values (doubles; 0 or 1 for Booleans), unless the samples are triggers.
+ *
+ * @return
+ *  - LE_OK if successful (the caller must close the file descriptor).
+ *  - LE_UNSUPPORTED if the buffer holds strings or JSON, or shared memory is not available.
+ *  - LE_FAULT if the shared memory file could not be created.
  */
 //--------------------------------------------------------------------------------------------------
-static int BackupDirTreeWalkCallback
+le_result_t obs_ExportBuffer
 (
-    const char *fpath,      ///< File system path of the object.
-    const struct stat *sb,  ///< Ptr to the stat() info for the object.
-    int typeflag,           ///< What type of file system object we're looking at.
-    struct FTW *ftwbuf      ///< Ptr to buffer containing the basename and the nesting level.
+    res_Resource_t* resPtr, ///< Ptr to the resource object for the Observation.
+    double startAfter,  ///< Start after this many seconds ago, or after an absolute number of
+                        ///< seconds since the Epoch (if startafter > 30 years).
+                        ///< Use NAN (not a number) to export the whole buffer.
+    int* fdPtr  ///< [OUT] File descriptor of the shared memory file.
 )
 //--------------------------------------------------------------------------------------------------
 {
-    switch (typeflag)
+    Observation_t* obsPtr = CONTAINER_OF(resPtr, Observation_t, resource);
+    FinishRestore(obsPtr);
+
+    *fdPtr = -1;
+
+    if (   (obsPtr->bufferedType != IO_DATA_TYPE_TRIGGER)
+        && !IsNumerical(obsPtr->bufferedType))
     {
-        case FTW_F:  // regular file
-        {
-            // Compute the resource tree entry path of the associated Observation.
-            const char* relPath = fpath + BACKUP_DIR_PATH_LEN;
-            const char* suffixPtr = strstr(relPath, BACKUP_SUFFIX);
-            if (suffixPtr == NULL)
-            {
-                LE_WARN("Unexpected file in backup directory. Skipping '%s'.", fpath);
-                return 0;
-            }
-            // Copy all but the suffix into the observation path.
-            size_t obsPathBytes = (suffixPtr - relPath) + sizeof("/obs/");
-            char obsPath[HUB_MAX_RESOURCE_PATH_BYTES];
-            if (obsPathBytes >= sizeof(obsPath))
-            {
-                LE_ERROR("Length of path too long. Skipping '%s'.", fpath);
-                return 0;
-            }
-            (void)snprintf(obsPath, obsPathBytes, "/obs/%s", relPath);
+        return LE_UNSUPPORTED;
+    }
 
-            // If that Observation doesn't exist, or its backup period is 0, delete the file.
-            resTree_EntryRef_t entryRef = resTree_FindEntry(resTree_GetRoot(), obsPath);
-            if (   (entryRef == NULL)
-                || (resTree_GetEntryType(entryRef) != ADMIN_ENTRY_TYPE_OBSERVATION)
-                || (resTree_GetBufferBackupPeriod(entryRef) == 0)  )
-            {
-                if (unlink(fpath) != 0)
-                {
-                    LE_CRIT("Failed to delete '%s' (%m).", fpath);
-                }
-            }
+#if LE_CONFIG_LINUX
+    size_t index = FindBufferIndexAfter(obsPtr, startAfter);
+    uint32_t count = obsPtr->count - index;
+    size_t arrayCount = (obsPtr->bufferedType == IO_DATA_TYPE_TRIGGER ? 1 : 2);
+    size_t size = EXPORT_HEADER_BYTES + (arrayCount * count * sizeof(double));
 
-            return 0;
-        }
-        case FTW_D:  // directory and FTW_DEPTH was NOT specified
+    int fd = memfd_create("dataHubExport", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (fd == -1)
+    {
+        LE_ERROR("Failed to create shared memory file (%m).");
+        return LE_FAULT;
+    }
 
-            // This should never happen, because we specified FTW_DEPTH.
-            LE_CRIT("Received FTW_D flag for '%s'!", fpath);
-            return 0;
+    if (ftruncate(fd, size) != 0)
+    {
+        LE_ERROR("Failed to size shared memory file to %zu bytes (%m).", size);
+        close(fd);
+        return LE_FAULT;
+    }
 
-        case FTW_DNR:   // directory that can't be read
+    uint8_t* basePtr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (basePtr == MAP_FAILED)
+    {
+        LE_ERROR("Failed to map shared memory file (%m).");
+        close(fd);
+        return LE_FAULT;
+    }
 
-            LE_ERROR("Can't read directory '%s'", fpath);
-            return 0;
+    basePtr[0] = 0;     // Version
+    basePtr[1] = GetDataTypeCode(obsPtr->bufferedType);
+    basePtr[2] = 0;
+    basePtr[3] = 0;
+    memcpy(basePtr + 4, &count, sizeof(count));
 
-        case FTW_DP:    // directory and FTW_DEPTH was specified
+    // The samples may wrap around the end of the ring, in which case they are copied in two
+    // chunks.  Compressed samples are decoded in order.
+    double* timestampsPtr = (double*)(basePtr + EXPORT_HEADER_BYTES);
+    double* valuesPtr = timestampsPtr + count;
+    size_t copied = 0;
+
+    if (obsPtr->isCompressed)
+    {
+        for (; copied < count; copied++)
         {
-            // If the directory is empty, delete it.
-            int result = rmdir(fpath);
-            if ((result == -1) && (errno != ENOTEMPTY) && (errno != EEXIST))
-            {
-                LE_CRIT("Failed to remove directory '%s' (%m).", fpath);
-            }
-            return 0;
+            DecodeBufferedSample(obsPtr,
+                                 index + copied,
+                                 &timestampsPtr[copied],
+                                 &valuesPtr[copied]);
         }
-        case FTW_NS:     // stat() call failed on fpath
+    }
 
-            LE_CRIT("Failed to stat '%s'", fpath);
-            return 0;
+    while (copied < count)
+    {
+        size_t slot = BufferSlot(obsPtr, index + copied);
+        size_t chunk = obsPtr->capacity - slot;
+        if (chunk > count - copied)
+        {
+            chunk = count - copied;
+        }
 
-        case FTW_SL:     // symbolic link and FTW_PHYS specified
+        memcpy(timestampsPtr + copied, &obsPtr->timestamps[slot], chunk * sizeof(double));
 
-            // This should never happen, because we didn't specify FTW_PHYS.
-            LE_CRIT("Received FTW_SL flag for '%s'!", fpath);
-            return 0;
+        if (arrayCount > 1)
+        {
+            for (size_t i = 0; i < chunk; i++)
+            {
+                valuesPtr[copied + i] = obsPtr->values[slot + i].number;
+            }
+        }
 
-        case FTW_SLN:    // symbolic link pointing to a nonexistent file
+        copied += chunk;
+    }
 
-            LE_CRIT("Broken symlink found at '%s'", fpath);
-            return 0;
+    munmap(basePtr, size);
+
+    // Seal the file so that the client gets a read-only copy that can't change under it.
+    if (fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL) != 0)
+    {
+        LE_ERROR("Failed to seal shared memory file (%m).");
+        close(fd);
+        return LE_FAULT;
     }
 
-    LE_CRIT("Unexpected type flag %d.", typeflag);
+    *fdPtr = fd;
 
-    return -1;
+    return LE_OK;
+#else
+    LE_UNUSED(startAfter);
+
+    return LE_UNSUPPORTED;
+#endif
 }
-#endif /* end LE_CONFIG_LINUX */
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Delete buffer backup files that aren't being used.
+ * Select the samples to keep when downsampling part of an Observation's buffer using the
+ * Largest-Triangle-Three-Buckets algorithm.  The first and last samples are always kept.  The
+ * samples in between are divided into buckets of (nearly) equal size, and the sample that forms
+ * the largest triangle with the sample kept from the previous bucket and the average of the next
+ * bucket is kept from each.
+ *
+ * @return The number of samples selected.
  */
 //--------------------------------------------------------------------------------------------------
-void obs_DeleteUnusedBackupFiles
+static size_t SelectLttb
 (
-    void
+    Observation_t* obsPtr,
+    size_t startIndex,      ///< Position of the oldest sample to consider (0 = oldest).
+    size_t endIndex,        ///< Position after the newest sample to consider.
+    size_t maxPoints,       ///< Number of samples to select (at least 3, less than the span).
+    uint64_t* selectedSeqs  ///< [OUT] Sequence numbers of the selected samples, oldest first.
 )
 //--------------------------------------------------------------------------------------------------
 {
-#if LE_CONFIG_LINUX
-    LE_DEBUG("Cleaning up unused buffer backup files.");
+    size_t selectedCount = 0;
 
-    // Walk the directory tree under the backup directory.
-    // For each file, compute the resource tree entry path of the associated Observation.
-    // If that Observation doesn't exist, delete the file.
-    // If the directory is empty (after examining all files in it), delete the directory.
-    // Note: The number of file descriptors allowed to be used is selected to prevent
-    // running into the app's open file descriptor limit, while avoiding a lot of opening
-    // and closing of directories.  Normally we don't expect a lot of depth in the Observation
-    // resource naming heirarchy, so there shouldn't be a lot of depth in the backup directory.
-    int result = nftw(BACKUP_DIR,
-                      BackupDirTreeWalkCallback,
-                      4 /* max fds */,
-                      FTW_DEPTH /* depth-first traversal */);
-    if (result != 0)
+    // Timestamps are taken relative to the first sample's, to keep precision in the areas.
+    double timeBase = GetBufferedTimestamp(obsPtr, startIndex);
+    double bucketSize = (double)(endIndex - startIndex - 2) / (maxPoints - 2);
+
+    size_t keptIndex = startIndex;
+    selectedSeqs[selectedCount++] = obsPtr->headSeq + keptIndex;
+
+    for (size_t bucket = 0; bucket < (maxPoints - 2); bucket++)
     {
-        if (errno == ENOENT)
+        // Average the next bucket (or the last sample, for the last bucket).
+        size_t nextStart = startIndex + 1 + (size_t)((bucket + 1) * bucketSize);
+        size_t nextEnd = startIndex + 1 + (size_t)((bucket + 2) * bucketSize);
+        if (nextEnd > endIndex)
         {
-            LE_DEBUG("No backup directory. Skipping backup file clean-up.");
+            nextEnd = endIndex;
+        }
+
+        double avgTime = 0;
+        double avgValue = 0;
+        size_t avgCount = 0;
+
+        for (size_t i = nextStart; i < nextEnd; i++)
+        {
+            double value = GetBufferedNumber(obsPtr, i);
+
+            if (!isnan(value))
+            {
+                avgTime += GetBufferedTimestamp(obsPtr, i) - timeBase;
+                avgValue += value;
+                avgCount++;
+            }
+        }
+        if (avgCount > 0)
+        {
+            avgTime /= avgCount;
+            avgValue /= avgCount;
         }
         else
         {
-            LE_CRIT("Failed to traverse backup directory '%s' (%m)", BACKUP_DIR);
+            avgTime = GetBufferedTimestamp(obsPtr, endIndex - 1) - timeBase;
+            avgValue = GetBufferedNumber(obsPtr, endIndex - 1);
+        }
+
+        // Keep the sample in this bucket that forms the largest triangle.
+        size_t bucketStart = startIndex + 1 + (size_t)(bucket * bucketSize);
+        size_t bucketEnd = nextStart;
+
+        double keptTime = GetBufferedTimestamp(obsPtr, keptIndex) - timeBase;
+        double keptValue = GetBufferedNumber(obsPtr, keptIndex);
+        double maxArea = -1;
+        size_t maxIndex = bucketStart;
+
+        for (size_t i = bucketStart; i < bucketEnd; i++)
+        {
+            // Twice the area, which is just as good for comparison.
+            double area = fabs(  ((keptTime - avgTime) * (GetBufferedNumber(obsPtr, i) - keptValue))
+                               - ((keptTime - (GetBufferedTimestamp(obsPtr, i) - timeBase))
+                                  * (avgValue - keptValue)));
+            if (area > maxArea)
+            {
+                maxArea = area;
+                maxIndex = i;
+            }
         }
+
+        keptIndex = maxIndex;
+        selectedSeqs[selectedCount++] = obsPtr->headSeq + keptIndex;
     }
-#endif /* end LE_CONFIG_LINUX */
+
+    selectedSeqs[selectedCount++] = obsPtr->headSeq + endIndex - 1;
+
+    return selectedCount;
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Find the data sample at or after a given timestamp in a given Observation's buffer.
+ * Select the samples to keep when downsampling part of an Observation's buffer by min/max
+ * decimation.  The samples are divided into buckets of (nearly) equal size, and the samples
+ * holding the minimum and maximum values are kept from each, in the order they were received.
  *
- * @return a pointer to the buffer entry, or NULL if not found.
+ * @return The number of samples selected.
  */
 //--------------------------------------------------------------------------------------------------
-static BufferEntry_t* FindBufferEntry
+static size_t SelectMinMax
 (
     Observation_t* obsPtr,
-    double startTime   ///< NAN for oldest; if < 30 years, count back from now; else absolute time.
+    size_t startIndex,      ///< Position of the oldest sample to consider (0 = oldest).
+    size_t endIndex,        ///< Position after the newest sample to consider.
+    size_t maxPoints,       ///< Maximum number of samples to select (at least 2).
+    uint64_t* selectedSeqs  ///< [OUT] Sequence numbers of the selected samples, oldest first.
 )
 //--------------------------------------------------------------------------------------------------
 {
-    // Start at the oldest end and search forward.
-    BufferEntry_t* buffEntryPtr = GetOldestBufferEntry(obsPtr);
+    size_t selectedCount = 0;
+    size_t bucketCount = maxPoints / 2;
+    double bucketSize = (double)(endIndex - startIndex) / bucketCount;
 
-    // If the buffer isn't empty and the startTime was specified,
-    if ((buffEntryPtr != NULL) && (!isnan(startTime)))
+    for (size_t bucket = 0; bucket < bucketCount; bucket++)
     {
-        // If the start time is less than or equal to 30 years, then convert to an
-        // absolute timestamp by subtracting it from the current time.
-        if (startTime <= THIRTY_YEARS)
+        size_t bucketStart = startIndex + (size_t)(bucket * bucketSize);
+        size_t bucketEnd = startIndex + (size_t)((bucket + 1) * bucketSize);
+        if ((bucketEnd > endIndex) || ((bucket + 1) == bucketCount))
         {
-            le_clk_Time_t now = le_clk_GetAbsoluteTime();
-            startTime = ((((double)(now.usec)) / 1000000) + now.sec) - startTime;
+            bucketEnd = endIndex;
         }
 
-        // Walk up the buffer looking for an entry that is the same age or newer than the
-        // specified start time.
-        do
+        size_t minIndex = bucketEnd;
+        size_t maxIndex = bucketEnd;
+
+        for (size_t i = bucketStart; i < bucketEnd; i++)
         {
-            if (dataSample_GetTimestamp(buffEntryPtr->sampleRef) >= startTime)
+            double value = GetBufferedNumber(obsPtr, i);
+
+            if (!isnan(value))
             {
-                break;
+                if ((minIndex == bucketEnd) || (value < GetBufferedNumber(obsPtr, minIndex)))
+                {
+                    minIndex = i;
+                }
+                if ((maxIndex == bucketEnd) || (value > GetBufferedNumber(obsPtr, maxIndex)))
+                {
+                    maxIndex = i;
+                }
             }
+        }
+
+        // Skip buckets with no numbers in them.
+        if (minIndex == bucketEnd)
+        {
+            continue;
+        }
 
-            buffEntryPtr = GetNextBufferEntry(obsPtr, buffEntryPtr);
+        if (minIndex > maxIndex)
+        {
+            size_t temp = minIndex;
+            minIndex = maxIndex;
+            maxIndex = temp;
+        }
 
-        } while (buffEntryPtr != NULL);
+        selectedSeqs[selectedCount++] = obsPtr->headSeq + minIndex;
+        if (maxIndex != minIndex)
+        {
+            selectedSeqs[selectedCount++] = obsPtr->headSeq + maxIndex;
+        }
     }
 
-    return buffEntryPtr;
+    return selectedCount;
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Read data out of a buffer.  Data is written to a given file descriptor in JSON-encoded format
- * as an array of objects containing a timestamp and a value (or just a timestamp for triggers).
- * E.g.,
+ * Read a downsampled view of the data in a buffer.  At most a given number of samples, chosen to
+ * preserve the shape of the data when plotted, are written to a given file descriptor in the same
+ * JSON format as obs_ReadBufferJson().
  *
- * @code
- * [{"t":1537483647.125,"v":true},{"t":1537483657.128,"v":true}]
- * @endcode
+ * @return
+ *  - LE_OK if the read operation started (the completion callback will be called).
+ *  - LE_UNSUPPORTED if the buffer holds data of a non-numerical type.
+ *  - LE_BAD_PARAMETER if maxPoints is too small for the downsampling method.
  */
 //--------------------------------------------------------------------------------------------------
-void obs_ReadBufferJson
+le_result_t obs_ReadBufferDownsampledJson
 (
     res_Resource_t* resPtr, ///< Ptr to the resource object for the Observation.
     double startAfter,  ///< Start after this many seconds ago, or after an absolute number of
                         ///< seconds since the Epoch (if startafter > 30 years).
                         ///< Use NAN (not a number) to read the whole buffer.
+    uint32_t maxPoints, ///< Maximum number of samples to read.
+    query_DownsampleMethod_t method, ///< How to choose the samples.
     int outputFile, ///< File descriptor to write the data to.
     query_ReadCompletionFunc_t handlerPtr, ///< Completion callback.
     void* contextPtr    ///< Value to be passed to completion callback.
@@ -2432,17 +9041,60 @@ void obs_ReadBufferJson
 //--------------------------------------------------------------------------------------------------
 {
     Observation_t* obsPtr = CONTAINER_OF(resPtr, Observation_t, resource);
+    FinishRestore(obsPtr);
 
-    BufferEntry_t* startPtr = FindBufferEntry(obsPtr, startAfter);
+    if (maxPoints < ((method == QUERY_DOWNSAMPLE_METHOD_LTTB) ? 3 : 2))
+    {
+        return LE_BAD_PARAMETER;
+    }
 
-    // If the data sample found is an exact match for the startAfter time, then skip to the
-    // sample after that.
-    if ((startPtr != NULL) && (dataSample_GetTimestamp(startPtr->sampleRef) == startAfter))
+    if (!IsNumerical(obsPtr->bufferedType))
+    {
+        return LE_UNSUPPORTED;
+    }
+
+    size_t index = FindBufferIndexAfter(obsPtr, startAfter);
+
+    // If there's nothing to drop, just read everything.
+    if ((obsPtr->count - index) <= maxPoints)
+    {
+        StartRead(obsPtr,
+                  obsPtr->headSeq + index,
+                  NULL,
+                  0,
+                  false,
+                  outputFile,
+                  handlerPtr,
+                  contextPtr);
+        return LE_OK;
+    }
+
+    size_t capacity = GetRingCapacity(maxPoints);
+    uint64_t* selectedSeqs = AllocSizeClassBlock(GetSizeClassPool(SelectionPools,
+                                                                   "ObsReadSel",
+                                                                   capacity,
+                                                                   sizeof(uint64_t)));
+    if (selectedSeqs == NULL)
+    {
+        LE_ERROR("Failed to allocate a selection of %zu samples", capacity);
+        handlerPtr(LE_NO_MEMORY, contextPtr);
+        return LE_OK;
+    }
+
+    size_t selectedCount;
+
+    if (method == QUERY_DOWNSAMPLE_METHOD_LTTB)
+    {
+        selectedCount = SelectLttb(obsPtr, index, obsPtr->count, maxPoints, selectedSeqs);
+    }
+    else
     {
-        startPtr = GetNextBufferEntry(obsPtr, startPtr);
+        selectedCount = SelectMinMax(obsPtr, index, obsPtr->count, maxPoints, selectedSeqs);
     }
 
-    StartRead(obsPtr, startPtr, outputFile, handlerPtr, contextPtr);
+    StartRead(obsPtr, 0, selectedSeqs, selectedCount, false, outputFile, handlerPtr, contextPtr);
+
+    return LE_OK;
 }
 
 
@@ -2450,7 +9102,8 @@ void obs_ReadBufferJson
 /**
  * Find the oldest data sample in a given Observation's buffer that is newer than a given timestamp.
  *
- * @return Reference to the sample, or NULL if not found in buffer.
+ * @return Reference to a copy of the sample (which the caller must release), or NULL if not found
+ *         in buffer.
  */
 //--------------------------------------------------------------------------------------------------
 dataSample_Ref_t obs_FindBufferedSampleAfter
@@ -2463,19 +9116,13 @@ dataSample_Ref_t obs_FindBufferedSampleAfter
 //--------------------------------------------------------------------------------------------------
 {
     Observation_t* obsPtr = CONTAINER_OF(resPtr, Observation_t, resource);
+    FinishRestore(obsPtr);
 
-    BufferEntry_t* startPtr = FindBufferEntry(obsPtr, startAfter);
+    size_t index = FindBufferIndexAfter(obsPtr, startAfter);
 
-    // If the data sample found is an exact match for the startAfter time, then skip to the
-    // sample after that.
-    if ((startPtr != NULL) && (dataSample_GetTimestamp(startPtr->sampleRef) == startAfter))
-    {
-        startPtr = GetNextBufferEntry(obsPtr, startPtr);
-    }
-
-    if (startPtr != NULL)
+    if (index < obsPtr->count)
     {
-        return startPtr->sampleRef;
+        return CreateSampleFromBuffer(obsPtr, index);
     }
 
     return NULL;
@@ -2529,86 +9176,225 @@ const char* obs_GetJsonExtraction
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Get buffer entry numerical value.  This works for numeric or Boolean types only.
+ * Get the buffered value at the front of a minimum or maximum slot deque.
  *
- * @return The value.
+ * @return The minimum (or maximum) value in the buffer, or NAN if there are no numerical values.
  */
 //--------------------------------------------------------------------------------------------------
-static double GetBufferedNumber
+static double GetBufferedExtreme
 (
-    BufferEntry_t* buffEntryPtr,
-    io_DataType_t dataType
+    Observation_t* obsPtr,
+    const SlotDeque_t* dequePtr
 )
 //--------------------------------------------------------------------------------------------------
 {
-    if (dataType == IO_DATA_TYPE_NUMERIC)
+    if (dequePtr->len == 0)
     {
-        return dataSample_GetNumeric(buffEntryPtr->sampleRef);
+        return NAN;
     }
-    else if (dataType == IO_DATA_TYPE_BOOLEAN)
+
+    return obsPtr->values[dequePtr->slots[dequePtr->head]].number;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compute statistics over the numerical values found within a given span of positions in an
+ * Observation's compressed buffer.  The statistics kept for blocks that lie entirely within the
+ * span are merged, so only the blocks at either end of the span need to be decoded.
+ */
+//--------------------------------------------------------------------------------------------------
+static void GetBlockRangeStats
+(
+    Observation_t* obsPtr,
+    size_t startIndex,      ///< Position of the oldest sample in the span (0 = oldest).
+    size_t endIndex,        ///< Position after the newest sample in the span (at most the count).
+    RangeStats_t* statsPtr  ///< [IN/OUT] Statistics to merge into.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    uint64_t startSeq = obsPtr->headSeq + startIndex;
+    uint64_t endSeq = obsPtr->headSeq + endIndex;
+
+    for (size_t i = FindBlock(obsPtr, startSeq); i < obsPtr->blockCount; i++)
     {
-        if (dataSample_GetBoolean(buffEntryPtr->sampleRef))
+        CompressedBlock_t* blockPtr = GetBlock(obsPtr, i);
+        uint64_t blockEndSeq = blockPtr->firstSeq + sampleBlock_GetCount(&blockPtr->data);
+
+        if (blockPtr->firstSeq >= endSeq)
         {
-            return 1.0;
+            break;
         }
-        else
+
+        if ((blockPtr->firstSeq >= startSeq) && (blockEndSeq <= endSeq))
         {
-            return 0.0;
+            MergeRangeStats(statsPtr, &blockPtr->stats);
+            continue;
+        }
+
+        sampleBlock_Cursor_t cursor;
+        sampleBlock_StartRead(&cursor);
+
+        for (uint64_t seq = blockPtr->firstSeq; (seq < blockEndSeq) && (seq < endSeq); seq++)
+        {
+            double timestamp;
+            double value;
+
+            sampleBlock_ReadNext(&blockPtr->data, &cursor, &timestamp, &value);
+
+            if ((seq >= startSeq) && !isnan(value))
+            {
+                RangeStats_t valueStats = { 1, value, 0, value, value };
+
+                MergeRangeStats(statsPtr, &valueStats);
+            }
         }
-    }
-    else
-    {
-        LE_CRIT("Non-numerical data type %d.", dataType);
-        return NAN;
     }
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Get the minimum value found in an Observation's data set within a given time span.
+ * Compute statistics over the numerical values found within a given span of positions in an
+ * Observation's buffer.  The buffer must hold numeric or Boolean type data.
  *
- * @return The value, or NAN (not-a-number) if there's no numerical data in the Observation's
- *         buffer (if the buffer size is zero, the buffer is empty, or the buffer contains data
- *         of a non-numerical type).
+ * If the span covers the whole buffer, the running statistics have the answer in O(1).
+ * Otherwise, the answer comes from the range statistics index in O(log N), building the index
+ * first if necessary (or from a scan of the samples if the span is short).  Compressed buffers
+ * have no index, so they merge the statistics of their blocks instead.
  */
 //--------------------------------------------------------------------------------------------------
-double obs_QueryMin
+static void GetRangeStats
 (
-    res_Resource_t* resPtr,    ///< Ptr to Observation resource.
-    double startTime    ///< If < 30 years then seconds before now; else seconds since the Epoch.
+    Observation_t* obsPtr,
+    size_t startIndex,      ///< Position of the oldest sample in the span (0 = oldest).
+    size_t endIndex,        ///< Position after the newest sample in the span (at most the count).
+    RangeStats_t* statsPtr  ///< [OUT] Statistics (count is 0 if there are no numerical values).
 )
 //--------------------------------------------------------------------------------------------------
 {
-    Observation_t* obsPtr = CONTAINER_OF(resPtr, Observation_t, resource);
+    statsPtr->count = 0;
 
-    // This only works for numeric or Boolean type data.
-    if (   (obsPtr->bufferedType != IO_DATA_TYPE_NUMERIC)
-        && (obsPtr->bufferedType != IO_DATA_TYPE_BOOLEAN)  )
+    if (startIndex >= endIndex)
     {
-        return NAN;
+        return;
+    }
+
+    if ((startIndex == 0) && (endIndex == obsPtr->count))
+    {
+        if (obsPtr->statCount > 0)
+        {
+            statsPtr->count = obsPtr->statCount;
+            statsPtr->mean = obsPtr->statMean;
+            statsPtr->m2 = obsPtr->statM2;
+
+            if (obsPtr->isCompressed)
+            {
+                GetBlockBufferExtremes(obsPtr, &statsPtr->min, &statsPtr->max);
+            }
+            else
+            {
+                statsPtr->min = GetBufferedExtreme(obsPtr, &obsPtr->minDeque);
+                statsPtr->max = GetBufferedExtreme(obsPtr, &obsPtr->maxDeque);
+            }
+        }
+        return;
     }
 
-    BufferEntry_t* buffEntryPtr = FindBufferEntry(obsPtr, startTime);
+    if (obsPtr->isCompressed)
+    {
+        GetBlockRangeStats(obsPtr, startIndex, endIndex, statsPtr);
+        return;
+    }
+
+    if (   ((endIndex - startIndex) > INDEX_SCAN_THRESHOLD)
+        && ((obsPtr->index != NULL) || (BuildIndex(obsPtr) == LE_OK))  )
+    {
+        // The span occupies at most two runs of slots, because the ring may wrap around.
+        size_t firstSlot = BufferSlot(obsPtr, startIndex);
+        size_t lastSlot = BufferSlot(obsPtr, endIndex - 1);
 
-    double result = NAN;
+        if (firstSlot <= lastSlot)
+        {
+            QueryIndex(obsPtr, firstSlot, lastSlot + 1, statsPtr);
+        }
+        else
+        {
+            QueryIndex(obsPtr, firstSlot, obsPtr->capacity, statsPtr);
+            QueryIndex(obsPtr, 0, lastSlot + 1, statsPtr);
+        }
+        return;
+    }
 
-    while (buffEntryPtr != NULL)
+    for (size_t index = startIndex; index < endIndex; index++)
     {
-        double value = GetBufferedNumber(buffEntryPtr, obsPtr->bufferedType);
+        double value = GetBufferedNumber(obsPtr, index);
 
         if (!isnan(value))
         {
-            if (isnan(result) || (result > value))
-            {
-                result = value;
-            }
+            RangeStats_t valueStats = { 1, value, 0, value, value };
+
+            MergeRangeStats(statsPtr, &valueStats);
         }
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compute statistics over the numerical values found within a given time span in an
+ * Observation's buffer.
+ */
+//--------------------------------------------------------------------------------------------------
+static void GetTimeSpanStats
+(
+    Observation_t* obsPtr,
+    double startTime,       ///< If < 30 years then seconds before now; else seconds since the
+                            ///< Epoch.  NAN = from the oldest sample.
+    double endTime,         ///< If < 30 years then seconds before now; else seconds since the
+                            ///< Epoch.  NAN = to the newest sample.
+    RangeStats_t* statsPtr  ///< [OUT] Statistics (count is 0 if there are no numerical values).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    statsPtr->count = 0;
 
-        buffEntryPtr = GetNextBufferEntry(obsPtr, buffEntryPtr);
+    // This only works for numeric or Boolean type data.
+    if (IsNumerical(obsPtr->bufferedType))
+    {
+        GetRangeStats(obsPtr,
+                      FindBufferIndex(obsPtr, startTime),
+                      FindBufferEnd(obsPtr, endTime),
+                      statsPtr);
     }
+}
 
-    return result;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the minimum value found in an Observation's data set within a given time span.
+ *
+ * @return The value, or NAN (not-a-number) if there's no numerical data in the Observation's
+ *         buffer (if the buffer size is zero, the buffer is empty, or the buffer contains data
+ *         of a non-numerical type).
+ */
+//--------------------------------------------------------------------------------------------------
+double obs_QueryMin
+(
+    res_Resource_t* resPtr,    ///< Ptr to Observation resource.
+    double startTime,   ///< If < 30 years then seconds before now; else seconds since the Epoch.
+    double endTime      ///< If < 30 years then seconds before now; else seconds since the Epoch.
+                        ///< NAN = up to the newest sample.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Observation_t* obsPtr = CONTAINER_OF(resPtr, Observation_t, resource);
+    RangeStats_t stats;
+
+    FinishRestore(obsPtr);
+    GetTimeSpanStats(obsPtr, startTime, endTime, &stats);
+
+    return (stats.count > 0) ? stats.min : NAN;
 }
 
 
@@ -2624,168 +9410,293 @@ double obs_QueryMin
 double obs_QueryMax
 (
     res_Resource_t* resPtr,    ///< Ptr to Observation resource.
-    double startTime    ///< If < 30 years then seconds before now; else seconds since the Epoch.
+    double startTime,   ///< If < 30 years then seconds before now; else seconds since the Epoch.
+    double endTime      ///< If < 30 years then seconds before now; else seconds since the Epoch.
+                        ///< NAN = up to the newest sample.
 )
 //--------------------------------------------------------------------------------------------------
 {
     Observation_t* obsPtr = CONTAINER_OF(resPtr, Observation_t, resource);
+    RangeStats_t stats;
 
-    // This only works for numeric or Boolean type data.
-    if (   (obsPtr->bufferedType != IO_DATA_TYPE_NUMERIC)
-        && (obsPtr->bufferedType != IO_DATA_TYPE_BOOLEAN)  )
-    {
-        return NAN;
-    }
-
-    BufferEntry_t* buffEntryPtr = FindBufferEntry(obsPtr, startTime);
+    FinishRestore(obsPtr);
+    GetTimeSpanStats(obsPtr, startTime, endTime, &stats);
 
-    double result = NAN;
+    return (stats.count > 0) ? stats.max : NAN;
+}
 
-    while (buffEntryPtr != NULL)
-    {
-        double value = GetBufferedNumber(buffEntryPtr, obsPtr->bufferedType);
 
-        if (!isnan(value))
-        {
-            if (isnan(result) || (result < value))
-            {
-                result = value;
-            }
-        }
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the mean (average) of all values found within a given time span in an Observation's buffer.
+ *
+ * @return The value, or NAN (not-a-number) if there's no numerical data in the Observation's
+ *         buffer (if the buffer size is zero, the buffer is empty, or the buffer contains data
+ *         of a non-numerical type).
+ */
+//--------------------------------------------------------------------------------------------------
+double obs_QueryMean
+(
+    res_Resource_t* resPtr,    ///< Ptr to Observation resource.
+    double startTime,   ///< If < 30 years then seconds before now; else seconds since the Epoch.
+    double endTime      ///< If < 30 years then seconds before now; else seconds since the Epoch.
+                        ///< NAN = up to the newest sample.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Observation_t* obsPtr = CONTAINER_OF(resPtr, Observation_t, resource);
+    RangeStats_t stats;
 
-        buffEntryPtr = GetNextBufferEntry(obsPtr, buffEntryPtr);
-    }
+    FinishRestore(obsPtr);
+    GetTimeSpanStats(obsPtr, startTime, endTime, &stats);
 
-    return result;
+    return (stats.count > 0) ? stats.mean : NAN;
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Get the mean (average) of all values found within a given time span in an Observation's buffer.
+ * Get the standard deviation of all values found within a given time span in an
+ * Observation's buffer.
  *
  * @return The value, or NAN (not-a-number) if there's no numerical data in the Observation's
  *         buffer (if the buffer size is zero, the buffer is empty, or the buffer contains data
  *         of a non-numerical type).
  */
 //--------------------------------------------------------------------------------------------------
-double obs_QueryMean
+double obs_QueryStdDev
 (
     res_Resource_t* resPtr,    ///< Ptr to Observation resource.
-    double startTime    ///< If < 30 years then seconds before now; else seconds since the Epoch.
+    double startTime,   ///< If < 30 years then seconds before now; else seconds since the Epoch.
+    double endTime      ///< If < 30 years then seconds before now; else seconds since the Epoch.
+                        ///< NAN = up to the newest sample.
 )
 //--------------------------------------------------------------------------------------------------
 {
     Observation_t* obsPtr = CONTAINER_OF(resPtr, Observation_t, resource);
+    RangeStats_t stats;
 
-    // This only works for numeric or Boolean type data.
-    if (   (obsPtr->bufferedType != IO_DATA_TYPE_NUMERIC)
-        && (obsPtr->bufferedType != IO_DATA_TYPE_BOOLEAN)  )
-    {
-        return NAN;
-    }
+    FinishRestore(obsPtr);
+    GetTimeSpanStats(obsPtr, startTime, endTime, &stats);
 
-    BufferEntry_t* buffEntryPtr = FindBufferEntry(obsPtr, startTime);
+    return (stats.count > 0) ? sqrt(stats.m2 / stats.count) : NAN;
+}
 
-    double sum = 0;
-    size_t count = 0;
 
-    while (buffEntryPtr != NULL)
-    {
-        double value = GetBufferedNumber(buffEntryPtr, obsPtr->bufferedType);
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the count, minimum, maximum, mean and standard deviation of the numerical values found
+ * within a given time span in an Observation's buffer, along with the timestamps of the oldest and
+ * newest samples in the time span, all at once.
+ *
+ * The statistics are NAN (and the count is 0) if there's no numerical data in the time span.
+ * The timestamps are NAN if there are no samples in the time span.
+ */
+//--------------------------------------------------------------------------------------------------
+void obs_QueryStats
+(
+    res_Resource_t* resPtr,    ///< Ptr to Observation resource.
+    double startTime,   ///< If < 30 years then seconds before now; else seconds since the Epoch.
+                        ///< NAN = from the oldest sample.
+    double endTime,     ///< If < 30 years then seconds before now; else seconds since the Epoch.
+                        ///< NAN = up to the newest sample.
+    hub_BufferStats_t* statsPtr ///< [OUT] Statistics.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Observation_t* obsPtr = CONTAINER_OF(resPtr, Observation_t, resource);
+    FinishRestore(obsPtr);
 
-        if (!isnan(value))
-        {
-            sum += value;
-            count++;
-        }
+    size_t startIndex = FindBufferIndex(obsPtr, startTime);
+    size_t endIndex = FindBufferEnd(obsPtr, endTime);
+    RangeStats_t stats = { 0 };
 
-        buffEntryPtr = GetNextBufferEntry(obsPtr, buffEntryPtr);
+    if (IsNumerical(obsPtr->bufferedType))
+    {
+        GetRangeStats(obsPtr, startIndex, endIndex, &stats);
     }
 
-    if (count == 0)
+    statsPtr->count = stats.count;
+
+    if (stats.count > 0)
     {
-        return NAN;
+        statsPtr->min = stats.min;
+        statsPtr->max = stats.max;
+        statsPtr->mean = stats.mean;
+        statsPtr->stdDev = sqrt(stats.m2 / stats.count);
+    }
+    else
+    {
+        statsPtr->min = NAN;
+        statsPtr->max = NAN;
+        statsPtr->mean = NAN;
+        statsPtr->stdDev = NAN;
     }
 
-    return (sum / count);
+    if (startIndex < endIndex)
+    {
+        statsPtr->firstTimestamp = GetBufferedTimestamp(obsPtr, startIndex);
+        statsPtr->lastTimestamp = GetBufferedTimestamp(obsPtr, endIndex - 1);
+    }
+    else
+    {
+        statsPtr->firstTimestamp = NAN;
+        statsPtr->lastTimestamp = NAN;
+    }
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Get the standard deviation of all values found within a given time span in an
- * Observation's buffer.
+ * Divide a time span of an Observation's buffer into buckets of a given width and compute an
+ * aggregate of the samples in each bucket.
  *
- * @return The value, or NAN (not-a-number) if there's no numerical data in the Observation's
- *         buffer (if the buffer size is zero, the buffer is empty, or the buffer contains data
- *         of a non-numerical type).
+ * The first bucket starts at the start time, and the last one ends at the end time (inclusive).
+ * Buckets that hold no samples get NAN (or 0 for QUERY_AGGREGATE_TYPE_COUNT).
+ *
+ * @return
+ *  - LE_OK if successful.
+ *  - LE_NOT_FOUND if there are no samples in the time span.
+ *  - LE_UNSUPPORTED if the aggregate type needs numerical data and the buffer holds another type.
+ *  - LE_BAD_PARAMETER if the bucket width isn't positive or the time span ends before it starts.
+ *  - LE_OVERFLOW if the time span holds more buckets than fit in the values array (the array is
+ *                filled with the first buckets' values).
  */
 //--------------------------------------------------------------------------------------------------
-double obs_QueryStdDev
+le_result_t obs_QueryBuckets
 (
     res_Resource_t* resPtr,    ///< Ptr to Observation resource.
-    double startTime    ///< If < 30 years then seconds before now; else seconds since the Epoch.
+    double startTime,   ///< If < 30 years then seconds before now; else seconds since the Epoch.
+                        ///< NAN = from the oldest sample.
+    double endTime,     ///< If < 30 years then seconds before now; else seconds since the Epoch.
+                        ///< NAN = up to the newest sample.
+    double bucketWidth, ///< Width of each bucket (seconds).
+    query_AggregateType_t aggregateType, ///< Aggregate to compute over each bucket's samples.
+    double* valuesPtr,  ///< [OUT] Array to put the value of each bucket in.
+    size_t* numBucketsPtr   ///< [IN/OUT] Size of the values array / number of buckets filled.
 )
 //--------------------------------------------------------------------------------------------------
 {
     Observation_t* obsPtr = CONTAINER_OF(resPtr, Observation_t, resource);
+    FinishRestore(obsPtr);
 
-    // This only works for numeric or Boolean type data.
-    if (   (obsPtr->bufferedType != IO_DATA_TYPE_NUMERIC)
-        && (obsPtr->bufferedType != IO_DATA_TYPE_BOOLEAN)  )
+    size_t maxBuckets = *numBucketsPtr;
+    *numBucketsPtr = 0;
+
+    if (!(bucketWidth > 0))
     {
-        return NAN;
+        return LE_BAD_PARAMETER;
     }
 
-    BufferEntry_t* startEntryPtr = FindBufferEntry(obsPtr, startTime);
+    if (   (aggregateType != QUERY_AGGREGATE_TYPE_COUNT)
+        && (!IsNumerical(obsPtr->bufferedType))  )
+    {
+        return LE_UNSUPPORTED;
+    }
 
-    if (startEntryPtr == NULL)
+    if (obsPtr->count == 0)
     {
-        return NAN;
+        return LE_NOT_FOUND;
     }
 
-    double sum = 0;
-    size_t count = 0;
+    double spanStart = isnan(startTime) ? GetBufferedTimestamp(obsPtr, 0)
+                                        : GetAbsoluteTime(startTime);
+    double spanEnd = isnan(endTime) ? GetBufferedTimestamp(obsPtr, obsPtr->count - 1)
+                                    : GetAbsoluteTime(endTime);
 
-    BufferEntry_t* buffEntryPtr = startEntryPtr;
-    while (buffEntryPtr != NULL)
+    if (spanEnd < spanStart)
     {
-        double value = GetBufferedNumber(buffEntryPtr, obsPtr->bufferedType);
+        return LE_BAD_PARAMETER;
+    }
 
-        if (!isnan(value))
-        {
-            sum += value;
-            count++;
-        }
+    size_t startIndex = SearchBuffer(obsPtr, 0, spanStart, true);
+    size_t endIndex = SearchBuffer(obsPtr, startIndex, spanEnd, false);
 
-        buffEntryPtr = GetNextBufferEntry(obsPtr, buffEntryPtr);
+    if (startIndex >= endIndex)
+    {
+        return LE_NOT_FOUND;
     }
 
-    if (count == 0)
+    // The last bucket is closed at the end of the time span, so a span that is an exact multiple
+    // of the bucket width doesn't get an extra bucket just for samples at the very end.
+    double bucketCount = ceil((spanEnd - spanStart) / bucketWidth);
+    if (bucketCount < 1)
     {
-        return NAN;
+        bucketCount = 1;
     }
 
-    const double mean = (sum / count);
+    size_t numBuckets = maxBuckets;
+    le_result_t result = LE_OVERFLOW;
+
+    if (bucketCount <= (double)maxBuckets)
+    {
+        numBuckets = (size_t)bucketCount;
+        result = LE_OK;
+    }
 
-    double sumOfSquaredDifferences = 0;
+    // Each bucket boundary is found by binary search, starting from the previous boundary, and
+    // the aggregates come from the range statistics index, so the cost depends on the number of
+    // buckets rather than the number of samples in them.
+    size_t bucketStart = startIndex;
 
-    buffEntryPtr = startEntryPtr;
-    while (buffEntryPtr != NULL)
+    for (size_t i = 0; i < numBuckets; i++)
     {
-        double value = GetBufferedNumber(buffEntryPtr, obsPtr->bufferedType);
+        size_t bucketEnd = endIndex;
 
-        if (!isnan(value))
+        if ((i + 1) < bucketCount)
+        {
+            bucketEnd = SearchBuffer(obsPtr, bucketStart, spanStart + ((i + 1) * bucketWidth), true);
+            if (bucketEnd > endIndex)
+            {
+                bucketEnd = endIndex;
+            }
+        }
+
+        double value = NAN;
+
+        if (aggregateType == QUERY_AGGREGATE_TYPE_COUNT)
+        {
+            value = bucketEnd - bucketStart;
+        }
+        else if (aggregateType == QUERY_AGGREGATE_TYPE_LAST)
+        {
+            if (bucketEnd > bucketStart)
+            {
+                value = GetBufferedNumber(obsPtr, bucketEnd - 1);
+            }
+        }
+        else
         {
-            double diff = value - mean;
-            sumOfSquaredDifferences += (diff * diff);
+            RangeStats_t stats;
+
+            GetRangeStats(obsPtr, bucketStart, bucketEnd, &stats);
+
+            if (stats.count > 0)
+            {
+                switch (aggregateType)
+                {
+                    case QUERY_AGGREGATE_TYPE_MIN:
+                        value = stats.min;
+                        break;
+
+                    case QUERY_AGGREGATE_TYPE_MAX:
+                        value = stats.max;
+                        break;
+
+                    default:
+                        value = stats.mean;
+                        break;
+                }
+            }
         }
 
-        buffEntryPtr = GetNextBufferEntry(obsPtr, buffEntryPtr);
+        valuesPtr[i] = value;
+        bucketStart = bucketEnd;
     }
 
-    return sqrt(sumOfSquaredDifferences / count);
+    *numBucketsPtr = numBuckets;
+
+    return result;
 }
 
 
@@ -2926,3 +9837,22 @@ void obs_SetDestination
     // Set the desination string
     strncpy(obsPtr->destination, destination, CONFIG_MAX_DESTINATION_NAME_BYTES);
 }
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the destination string of a given Observation.
+ *
+ * @return Ptr to the destination string.  "" if not set.
+ */
+//--------------------------------------------------------------------------------------------------
+const char* obs_GetDestination
+(
+    res_Resource_t* resPtr       ///< Ptr to Observation resource
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Observation_t* obsPtr = CONTAINER_OF(resPtr, Observation_t, resource);
+
+    return obsPtr->destination;
+}
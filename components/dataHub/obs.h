@@ -66,6 +66,52 @@ void obs_RestoreBackup
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set whether Observations being created skip restoring their buffers from their backups.  This
+ * is for when newer copies of the buffers are about to be restored from memory instead (see
+ * obs_RestoreBufferFromImage()).
+ */
+//--------------------------------------------------------------------------------------------------
+void obs_SkipBackupRestore
+(
+    bool isSkipped  ///< true = skip restoring from backups.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append a copy of an Observation's whole data buffer to an image, in the backup file format.
+ * If the buffer hasn't changed since its copy was appended to the image before (the last one
+ * stored in the State Segment), that copy is reused.
+ *
+ * @return true if successful, false if out of memory.
+ */
+//--------------------------------------------------------------------------------------------------
+bool obs_AppendBufferToImage
+(
+    res_Resource_t* resPtr,
+    backupWriter_ImageRef_t imageRef,
+    uint32_t imageNumber,           ///< Number of the image (one more than the image before).
+    const uint8_t* lastImagePtr     ///< The image before, or NULL if it isn't available.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Replace an Observation's data buffer with a copy in memory (see obs_AppendBufferToImage()).
+ * None of the samples are pushed to the Observation, so its current value is left as it is.
+ */
+//--------------------------------------------------------------------------------------------------
+void obs_RestoreBufferFromImage
+(
+    res_Resource_t* resPtr,
+    const uint8_t* imagePtr,
+    size_t imageSize,
+    const char* name        ///< Name of the copy, for log messages.
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Perform JSON extraction.  If the data type is not JSON, does nothing.
@@ -273,6 +319,7 @@ obs_TransformType_t obs_GetTransform
 /**
  * Set the maximum number of data samples to buffer in a given Observation.  Buffers are FIFO
  * circular buffers. When full, the buffer drops the oldest value to make room for a new addition.
+ * Counts larger than the biggest ring are clamped to it.
  */
 //--------------------------------------------------------------------------------------------------
 void obs_SetBufferMaxCount
@@ -295,6 +342,174 @@ uint32_t obs_GetBufferMaxCount
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the maximum age of the data samples buffered in a given Observation.  Samples timestamped
+ * longer ago than this are dropped from the buffer, as well as any dropped to respect its maximum
+ * count.
+ */
+//--------------------------------------------------------------------------------------------------
+void obs_SetBufferMaxAge
+(
+    res_Resource_t* resPtr,
+    double seconds  ///< Maximum age (NAN or 0 = no limit).
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the maximum age of the data samples buffered in a given Observation.
+ *
+ * @return The maximum age (in seconds) or NAN if not set.
+ */
+//--------------------------------------------------------------------------------------------------
+double obs_GetBufferMaxAge
+(
+    res_Resource_t* resPtr
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the maximum number of bytes of memory that the data samples buffered in a given Observation
+ * can use.  This counts all the memory allocated for the buffer: the ring of samples (including
+ * any slots not yet filled), its statistics index, the compressed blocks, and the contents of
+ * strings.  When the limit is exceeded, the oldest samples are dropped (shrinking the ring) until
+ * it isn't, as well as any dropped to respect the maximum count.
+ */
+//--------------------------------------------------------------------------------------------------
+void obs_SetBufferMaxBytes
+(
+    res_Resource_t* resPtr,
+    uint32_t bytes  ///< Maximum number of bytes (0 = no limit).
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the maximum number of bytes of memory that the data samples buffered in a given Observation
+ * can use.
+ *
+ * @return The maximum number of bytes or 0 if not set.
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t obs_GetBufferMaxBytes
+(
+    res_Resource_t* resPtr
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the priority of the data samples buffered in a given Observation.  When the samples buffered
+ * in all Observations use more memory than the hub's buffer memory budget, samples are evicted
+ * from the lowest priority buffers first.
+ */
+//--------------------------------------------------------------------------------------------------
+void obs_SetBufferPriority
+(
+    res_Resource_t* resPtr,
+    int32_t priority ///< Higher = samples kept longer (default 0).
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the priority of the data samples buffered in a given Observation.
+ *
+ * @return The priority.
+ */
+//--------------------------------------------------------------------------------------------------
+int32_t obs_GetBufferPriority
+(
+    res_Resource_t* resPtr
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Enable or disable compression of the numeric and Boolean data samples buffered in a given
+ * Observation.  Compressed samples take much less memory, but are slower to read at random.
+ * Samples already in the buffer are compressed (or decompressed) right away.
+ */
+//--------------------------------------------------------------------------------------------------
+void obs_SetBufferCompression
+(
+    res_Resource_t* resPtr,
+    bool compress   ///< true = compress numerical samples (default false).
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether compression of the numerical data samples buffered in a given Observation is
+ * enabled.
+ *
+ * @return true if enabled.
+ */
+//--------------------------------------------------------------------------------------------------
+bool obs_GetBufferCompression
+(
+    res_Resource_t* resPtr
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of bytes of memory allocated for the samples buffered in a given Observation, and
+ * the number of samples that have been evicted from its buffer to stay within the hub's buffer
+ * memory budget.
+ */
+//--------------------------------------------------------------------------------------------------
+void obs_GetBufferMemoryUsage
+(
+    res_Resource_t* resPtr,
+    uint64_t* bytesPtr, ///< [OUT] Bytes allocated for the buffer.
+    uint64_t* evictionCountPtr ///< [OUT] Samples evicted to stay within the budget.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the maximum number of bytes of memory that the data samples buffered in all Observations can
+ * use (counted the same way as an Observation's maximum number of bytes).  When the budget is
+ * exceeded, the oldest samples are evicted from the buffers of the lowest priority Observations.
+ */
+//--------------------------------------------------------------------------------------------------
+void obs_SetBufferBudget
+(
+    uint32_t bytes  ///< Maximum number of bytes (0 = no limit).
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the maximum number of bytes of memory that the data samples buffered in all Observations can
+ * use.
+ *
+ * @return The maximum number of bytes or 0 if not set.
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t obs_GetBufferBudget
+(
+    void
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of bytes of memory allocated for the samples buffered in all Observations, and
+ * the number of samples that have been evicted from their buffers to stay within the hub's buffer
+ * memory budget.
+ */
+//--------------------------------------------------------------------------------------------------
+void obs_GetTotalBufferMemoryUsage
+(
+    uint64_t* bytesPtr,         ///< [OUT] Bytes allocated for all buffers.
+    uint64_t* evictionCountPtr  ///< [OUT] Samples evicted to stay within the budget.
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Set the minimum time between backups of an Observation's buffer to non-volatile storage.
@@ -325,6 +540,113 @@ uint32_t obs_GetBufferBackupPeriod
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set whether an Observation's buffer is backed up by appending the samples added since the
+ * previous backup to a log, rather than by rewriting the whole buffer to its backup file.
+ * The log is compacted every so often, by writing the whole buffer again.
+ */
+//--------------------------------------------------------------------------------------------------
+void obs_SetBufferBackupLog
+(
+    res_Resource_t* resPtr,
+    bool useLog  ///< true = append to a log, false = rewrite the backup file (default).
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether an Observation's buffer is backed up by appending to a log.
+ *
+ * @return true if backed up to a log.
+ */
+//--------------------------------------------------------------------------------------------------
+bool obs_GetBufferBackupLog
+(
+    res_Resource_t* resPtr
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the maximum number of bytes that backups of all Observations' buffers can write to
+ * non-volatile storage per hour.  Backups that would exceed it are put off until enough time has
+ * passed, oldest due first.
+ */
+//--------------------------------------------------------------------------------------------------
+void obs_SetBackupWriteBudget
+(
+    uint32_t bytesPerHour   ///< Maximum number of bytes per hour (0 = no limit).
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the maximum number of bytes that backups of all Observations' buffers can write to
+ * non-volatile storage per hour.
+ *
+ * @return The maximum number of bytes per hour, or 0 if not set.
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t obs_GetBackupWriteBudget
+(
+    void
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set whether the buffers of all Observations (other than those backed up to a log) are backed up
+ * together into a single pack file, instead of each into its own backup file.  Each buffer's backup
+ * moves at its next backup.
+ */
+//--------------------------------------------------------------------------------------------------
+void obs_SetBackupPacked
+(
+    bool isPacked   ///< true = back up into the pack file.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether the buffers of all Observations (other than those backed up to a log) are backed
+ * up together into a single pack file.
+ *
+ * @return true if backed up into the pack file.
+ */
+//--------------------------------------------------------------------------------------------------
+bool obs_GetBackupPacked
+(
+    void
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set whether buffers are restored lazily from their backups: when an Observation is created, only
+ * the newest sample is restored (as the current value), and the rest are loaded when the buffer is
+ * first needed.  Only affects Observations created afterwards.
+ */
+//--------------------------------------------------------------------------------------------------
+void obs_SetBackupLazyRestore
+(
+    bool isLazy     ///< true = restore lazily.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether buffers are restored lazily from their backups.
+ *
+ * @return true if restored lazily.
+ */
+//--------------------------------------------------------------------------------------------------
+bool obs_GetBackupLazyRestore
+(
+    void
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Delete buffer backup files that aren't being used.
@@ -359,11 +681,98 @@ void obs_ReadBufferJson
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read data out of a buffer in binary form, so that the samples can be copied straight into
+ * arrays.  The same eight-byte header as a buffer exported by obs_ExportBuffer() is written to a
+ * given file descriptor (format version 0, a data type code: 't' = trigger, 'b' = Boolean,
+ * 'n' = numeric, 's' = string, 'j' = JSON, two zero bytes, then the number of records as a 4-byte
+ * unsigned integer), followed by that many packed records, in the layout used by backup files:
+ *
+ *  - timestamp (8-byte double), followed by
+ *  - nothing for a trigger,
+ *  - one byte (0 or 1) for a Boolean,
+ *  - the value (8-byte double) for a numeric, or
+ *  - the length (4-byte unsigned) of the value for a string or JSON, then the value itself
+ *    (without null terminator).
+ *
+ * Multi-byte fields are little-endian.  Only the samples buffered when the read starts are read.
+ * If any of them are dropped from the buffer before they are written, or the type of data in the
+ * buffer changes, the read ends early and LE_OUT_OF_RANGE is passed to the completion callback.
+ */
+//--------------------------------------------------------------------------------------------------
+void obs_ReadBufferBinary
+(
+    res_Resource_t* resPtr, ///< Ptr to the resource object for the Observation.
+    double startAfter,  ///< Start after this many seconds ago, or after an absolute number of
+                        ///< seconds since the Epoch (if startafter > 30 years).
+                        ///< Use NAN (not a number) to read the whole buffer.
+    int outputFile, ///< File descriptor to write the data to.
+    query_ReadCompletionFunc_t handlerPtr, ///< Completion callback.
+    void* contextPtr    ///< Value to be passed to completion callback.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Export a read-only copy of the data in a buffer through a sealed shared memory file, which the
+ * caller can mmap() instead of having the samples streamed to it.  The file contains
+ *
+ *  - format version (1 byte, 0),
+ *  - data type code used in backup files (1 byte: 't', 'b' or 'n'),
+ *  - two zero bytes,
+ *  - the number of samples, N (uint32_t),
+ *  - N timestamps (doubles, oldest first), then
+ *  - N values (doubles; 0 or 1 for Booleans), unless the samples are triggers.
+ *
+ * @return
+ *  - LE_OK if successful (the caller must close the file descriptor).
+ *  - LE_UNSUPPORTED if the buffer holds strings or JSON, or shared memory is not available.
+ *  - LE_FAULT if the shared memory file could not be created.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t obs_ExportBuffer
+(
+    res_Resource_t* resPtr, ///< Ptr to the resource object for the Observation.
+    double startAfter,  ///< Start after this many seconds ago, or after an absolute number of
+                        ///< seconds since the Epoch (if startafter > 30 years).
+                        ///< Use NAN (not a number) to export the whole buffer.
+    int* fdPtr  ///< [OUT] File descriptor of the shared memory file.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read a downsampled view of the data in a buffer.  At most a given number of samples, chosen to
+ * preserve the shape of the data when plotted, are written to a given file descriptor in the same
+ * JSON format as obs_ReadBufferJson().
+ *
+ * @return
+ *  - LE_OK if the read operation started (the completion callback will be called).
+ *  - LE_UNSUPPORTED if the buffer holds data of a non-numerical type.
+ *  - LE_BAD_PARAMETER if maxPoints is too small for the downsampling method.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t obs_ReadBufferDownsampledJson
+(
+    res_Resource_t* resPtr, ///< Ptr to the resource object for the Observation.
+    double startAfter,  ///< Start after this many seconds ago, or after an absolute number of
+                        ///< seconds since the Epoch (if startafter > 30 years).
+                        ///< Use NAN (not a number) to read the whole buffer.
+    uint32_t maxPoints, ///< Maximum number of samples to read.
+    query_DownsampleMethod_t method, ///< How to choose the samples.
+    int outputFile, ///< File descriptor to write the data to.
+    query_ReadCompletionFunc_t handlerPtr, ///< Completion callback.
+    void* contextPtr    ///< Value to be passed to completion callback.
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Find the oldest data sample in a given Observation's buffer that is newer than a given timestamp.
  *
- * @return Reference to the sample, or NULL if not found in buffer.
+ * @return Reference to a copy of the sample (which the caller must release), or NULL if not found
+ *         in buffer.
  */
 //--------------------------------------------------------------------------------------------------
 dataSample_Ref_t obs_FindBufferedSampleAfter
@@ -417,7 +826,9 @@ const char* obs_GetJsonExtraction
 double obs_QueryMin
 (
     res_Resource_t* resPtr,    ///< Ptr to Observation resource.
-    double startTime    ///< If < 30 years then seconds before now; else seconds since the Epoch.
+    double startTime,   ///< If < 30 years then seconds before now; else seconds since the Epoch.
+    double endTime      ///< If < 30 years then seconds before now; else seconds since the Epoch.
+                        ///< NAN = up to the newest sample.
 );
 
 
@@ -433,7 +844,9 @@ double obs_QueryMin
 double obs_QueryMax
 (
     res_Resource_t* resPtr,    ///< Ptr to Observation resource.
-    double startTime    ///< If < 30 years then seconds before now; else seconds since the Epoch.
+    double startTime,   ///< If < 30 years then seconds before now; else seconds since the Epoch.
+    double endTime      ///< If < 30 years then seconds before now; else seconds since the Epoch.
+                        ///< NAN = up to the newest sample.
 );
 
 
@@ -449,7 +862,9 @@ double obs_QueryMax
 double obs_QueryMean
 (
     res_Resource_t* resPtr,    ///< Ptr to Observation resource.
-    double startTime    ///< If < 30 years then seconds before now; else seconds since the Epoch.
+    double startTime,   ///< If < 30 years then seconds before now; else seconds since the Epoch.
+    double endTime      ///< If < 30 years then seconds before now; else seconds since the Epoch.
+                        ///< NAN = up to the newest sample.
 );
 
 
@@ -466,7 +881,61 @@ double obs_QueryMean
 double obs_QueryStdDev
 (
     res_Resource_t* resPtr,    ///< Ptr to Observation resource.
-    double startTime    ///< If < 30 years then seconds before now; else seconds since the Epoch.
+    double startTime,   ///< If < 30 years then seconds before now; else seconds since the Epoch.
+    double endTime      ///< If < 30 years then seconds before now; else seconds since the Epoch.
+                        ///< NAN = up to the newest sample.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the count, minimum, maximum, mean and standard deviation of the numerical values found
+ * within a given time span in an Observation's buffer, along with the timestamps of the oldest and
+ * newest samples in the time span, all at once.
+ *
+ * The statistics are NAN (and the count is 0) if there's no numerical data in the time span.
+ * The timestamps are NAN if there are no samples in the time span.
+ */
+//--------------------------------------------------------------------------------------------------
+void obs_QueryStats
+(
+    res_Resource_t* resPtr,    ///< Ptr to Observation resource.
+    double startTime,   ///< If < 30 years then seconds before now; else seconds since the Epoch.
+                        ///< NAN = from the oldest sample.
+    double endTime,     ///< If < 30 years then seconds before now; else seconds since the Epoch.
+                        ///< NAN = up to the newest sample.
+    hub_BufferStats_t* statsPtr ///< [OUT] Statistics.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Divide a time span of an Observation's buffer into buckets of a given width and compute an
+ * aggregate of the samples in each bucket.
+ *
+ * The first bucket starts at the start time, and the last one ends at the end time (inclusive).
+ * Buckets that hold no samples get NAN (or 0 for QUERY_AGGREGATE_TYPE_COUNT).
+ *
+ * @return
+ *  - LE_OK if successful.
+ *  - LE_NOT_FOUND if there are no samples in the time span.
+ *  - LE_UNSUPPORTED if the aggregate type needs numerical data and the buffer holds another type.
+ *  - LE_BAD_PARAMETER if the bucket width isn't positive or the time span ends before it starts.
+ *  - LE_OVERFLOW if the time span holds more buckets than fit in the values array (the array is
+ *                filled with the first buckets' values).
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t obs_QueryBuckets
+(
+    res_Resource_t* resPtr,    ///< Ptr to Observation resource.
+    double startTime,   ///< If < 30 years then seconds before now; else seconds since the Epoch.
+                        ///< NAN = from the oldest sample.
+    double endTime,     ///< If < 30 years then seconds before now; else seconds since the Epoch.
+                        ///< NAN = up to the newest sample.
+    double bucketWidth, ///< Width of each bucket (seconds).
+    query_AggregateType_t aggregateType, ///< Aggregate to compute over each bucket's samples.
+    double* valuesPtr,  ///< [OUT] Array to put the value of each bucket in.
+    size_t* numBucketsPtr   ///< [IN/OUT] Size of the values array / number of buckets filled.
 );
 
 
@@ -498,4 +967,17 @@ void obs_SetDestination
     const char* destination      ///< Destination string
 );
 
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the destination string of a given Observation.
+ *
+ * @return Ptr to the destination string.  "" if not set.
+ */
+//--------------------------------------------------------------------------------------------------
+const char* obs_GetDestination
+(
+    res_Resource_t* resPtr       ///< Ptr to Observation resource
+);
+
 #endif // OBS_H_INCLUDE_GUARD
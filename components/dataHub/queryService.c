@@ -8,6 +8,8 @@
 
 #include "dataHub.h"
 #include "handler.h"
+#include "resHandle.h"
+#include "obs.h"
 
 
 //--------------------------------------------------------------------------------------------------
@@ -119,6 +121,174 @@ le_result_t query_ReadBufferJson
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read data out of a buffer in binary form, so that the samples can be copied straight into
+ * arrays.  A two-byte header (format version 0 and data type code) is written to a given file
+ * descriptor, followed by one packed record per sample until end of file.  See query.api for the
+ * record layout.
+ *
+ * @return
+ *  - LE_OK if the read operation started successfully.
+ *  - LE_NOT_FOUND if the Observation doesn't exist.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t query_ReadBufferBinary
+(
+    const char* obsPath,
+        ///< [IN] Observation path. Can be absolute
+        ///< (beginning with a '/') or relative to /obs/.
+    double startAfter,
+        ///< [IN] Start after this many seconds ago,
+        ///< or after an absolute number of seconds since the Epoch
+        ///< (if startafter > 30 years).
+        ///< Use NAN (not a number) to read the whole buffer.
+    int outputFile,
+        ///< [IN] File descriptor to write the data to.
+    query_ReadCompletionFunc_t completionFuncPtr,
+        ///< [IN] Completion callback to be called when operation finishes.
+    void* contextPtr
+        ///< [IN]
+)
+//--------------------------------------------------------------------------------------------------
+{
+    resTree_EntryRef_t entryRef = FindObservation(obsPath);
+
+    if (entryRef == NULL)
+    {
+        close(outputFile);
+        return LE_NOT_FOUND;
+    }
+
+    if (startAfter < 0)
+    {
+        LE_KILL_CLIENT("Negative startAfter time provided (%lf).", startAfter);
+        close(outputFile);
+        return LE_OK;   // Doesn't matter what we return.
+    }
+
+    resTree_ReadBufferBinary(entryRef, startAfter, outputFile, completionFuncPtr, contextPtr);
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Export a read-only copy of the data in a buffer through a sealed shared memory file, which can be
+ * mapped into memory with mmap() instead of having the samples streamed.  See query.api for the
+ * layout.
+ *
+ * @return
+ *  - LE_OK if successful.
+ *  - LE_NOT_FOUND if the Observation doesn't exist.
+ *  - LE_UNSUPPORTED if the buffer holds strings or JSON, or shared memory is not available.
+ *  - LE_FAULT if the shared memory file could not be created.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t query_ExportBuffer
+(
+    const char* obsPath,
+        ///< [IN] Observation path. Can be absolute
+        ///< (beginning with a '/') or relative to /obs/.
+    double startAfter,
+        ///< [IN] Start after this many seconds ago,
+        ///< or after an absolute number of seconds since the Epoch
+        ///< (if startafter > 30 years).
+        ///< Use NAN (not a number) to export the whole buffer.
+    int* regionFilePtr
+        ///< [OUT] Shared memory file holding the copy of the buffer.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    *regionFilePtr = -1;
+
+    resTree_EntryRef_t entryRef = FindObservation(obsPath);
+
+    if (entryRef == NULL)
+    {
+        return LE_NOT_FOUND;
+    }
+
+    if (startAfter < 0)
+    {
+        LE_KILL_CLIENT("Negative startAfter time provided (%lf).", startAfter);
+        return LE_OK;   // Doesn't matter what we return.
+    }
+
+    return resTree_ExportBuffer(entryRef, startAfter, regionFilePtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read a downsampled view of the data in a buffer, for plotting.  At most maxPoints samples,
+ * chosen to preserve the shape of the data, are written to a given file descriptor in the same
+ * JSON format as query_ReadBufferJson().
+ *
+ * @return
+ *  - LE_OK if the read operation started successfully.
+ *  - LE_NOT_FOUND if the Observation doesn't exist.
+ *  - LE_UNSUPPORTED if the Observation's buffer holds data of a non-numerical type.
+ *  - LE_BAD_PARAMETER if maxPoints is less than 3 (LTTB) or 2 (min/max).
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t query_ReadBufferDownsampledJson
+(
+    const char* obsPath,
+        ///< [IN] Observation path. Can be absolute
+        ///< (beginning with a '/') or relative to /obs/.
+    double startAfter,
+        ///< [IN] Start after this many seconds ago,
+        ///< or after an absolute number of seconds since the Epoch
+        ///< (if startafter > 30 years).
+        ///< Use NAN (not a number) to read the whole buffer.
+    uint32_t maxPoints,
+        ///< [IN] Maximum number of samples to read.
+    query_DownsampleMethod_t method,
+        ///< [IN] How to choose the samples.
+    int outputFile,
+        ///< [IN] File descriptor to write the data to.
+    query_ReadCompletionFunc_t completionFuncPtr,
+        ///< [IN] Completion callback to be called when operation finishes.
+    void* contextPtr
+        ///< [IN]
+)
+//--------------------------------------------------------------------------------------------------
+{
+    resTree_EntryRef_t entryRef = FindObservation(obsPath);
+
+    if (entryRef == NULL)
+    {
+        close(outputFile);
+        return LE_NOT_FOUND;
+    }
+
+    if ((startAfter < 0) || (method > QUERY_DOWNSAMPLE_METHOD_MIN_MAX))
+    {
+        LE_KILL_CLIENT("Invalid downsampled read (startAfter %lf, method %d).",
+                       startAfter,
+                       (int)method);
+        close(outputFile);
+        return LE_OK;   // Doesn't matter what we return.
+    }
+
+    le_result_t result = resTree_ReadBufferDownsampledJson(entryRef,
+                                                           startAfter,
+                                                           maxPoints,
+                                                           method,
+                                                           outputFile,
+                                                           completionFuncPtr,
+                                                           contextPtr);
+    if (result != LE_OK)
+    {
+        close(outputFile);
+    }
+
+    return result;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Read the timestamp of a single sample from a buffer.
@@ -168,6 +338,8 @@ le_result_t query_ReadBufferSampleTimestamp
 
     *timestampPtr = dataSample_GetTimestamp(sample);
 
+    le_mem_Release(sample);
+
     return LE_OK;
 }
 
@@ -229,6 +401,8 @@ le_result_t query_ReadBufferSampleBoolean
     *timestampPtr = dataSample_GetTimestamp(sample);
     *valuePtr = dataSample_GetBoolean(sample);
 
+    le_mem_Release(sample);
+
     return LE_OK;
 }
 
@@ -290,6 +464,8 @@ le_result_t query_ReadBufferSampleNumeric
     *timestampPtr = dataSample_GetTimestamp(sample);
     *valuePtr = dataSample_GetNumeric(sample);
 
+    le_mem_Release(sample);
+
     return LE_OK;
 }
 
@@ -348,7 +524,13 @@ le_result_t query_ReadBufferSampleString
 
     *timestampPtr = dataSample_GetTimestamp(sample);
 
-    return dataSample_ConvertToString(sample, resTree_GetDataType(entryRef), value, valueSize);
+    le_result_t result = dataSample_ConvertToString(sample,
+                                                    resTree_GetDataType(entryRef),
+                                                    value,
+                                                    valueSize);
+    le_mem_Release(sample);
+
+    return result;
 }
 
 
@@ -407,7 +589,13 @@ le_result_t query_ReadBufferSampleJson
 
     *timestampPtr = dataSample_GetTimestamp(sample);
 
-    return dataSample_ConvertToJson(sample, resTree_GetDataType(entryRef), value, valueSize);
+    le_result_t result = dataSample_ConvertToJson(sample,
+                                                  resTree_GetDataType(entryRef),
+                                                  value,
+                                                  valueSize);
+    le_mem_Release(sample);
+
+    return result;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -460,7 +648,7 @@ double query_GetMin
         return NAN;
     }
 
-    return resTree_QueryMin(entryRef, startTime);
+    return resTree_QueryMin(entryRef, startTime, NAN);
 }
 
 
@@ -490,7 +678,7 @@ double query_GetMax
         return NAN;
     }
 
-    return resTree_QueryMax(entryRef, startTime);
+    return resTree_QueryMax(entryRef, startTime, NAN);
 }
 
 
@@ -520,7 +708,7 @@ double query_GetMean
         return NAN;
     }
 
-    return resTree_QueryMean(entryRef, startTime);
+    return resTree_QueryMean(entryRef, startTime, NAN);
 }
 
 
@@ -551,165 +739,552 @@ double query_GetStdDev
         return NAN;
     }
 
-    return resTree_QueryStdDev(entryRef, startTime);
+    return resTree_QueryStdDev(entryRef, startTime, NAN);
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Find a resource at a given path.  The path can be absolute (beginning with a '/'), or relative
- * to the calling app's namespace.
+ * Get the minimum value found in an Observation's data set within a given time span.
+ * Unlike query_GetMin(), the time span can end before the newest sample.
  *
- * @return Reference to the resource or NULL if not found.
+ * @return The value, or NAN (not-a-number) if there's no numerical data in the time span of the
+ *         Observation's buffer (if the buffer size is zero, no samples fall within the time span,
+ *         or the buffer contains data of a non-numerical type).
  */
 //--------------------------------------------------------------------------------------------------
-static resTree_EntryRef_t FindResource
+double query_GetMinInRange
 (
-    const char* path
+    const char* obsPath,
+        ///< [IN] Observation path. Can be absolute
+        ///< (beginning with a '/') or relative to /obs/.
+    double startTime,
+        ///< [IN] If < 30 years then seconds before now; else seconds since the Epoch.
+        ///< NAN = from the oldest sample.
+    double endTime
+        ///< [IN] If < 30 years then seconds before now; else seconds since the Epoch.
+        ///< NAN = up to the newest sample.
 )
 //--------------------------------------------------------------------------------------------------
 {
-    resTree_EntryRef_t entryRef;
+    resTree_EntryRef_t entryRef = FindObservation(obsPath);
 
-    if (path[0] == '/')
-    {
-        entryRef = resTree_FindEntryAtAbsolutePath(path);
-    }
-    else
+    if (entryRef == NULL)
     {
-        entryRef = hub_GetClientNamespace(query_GetClientSessionRef());
-
-        if (entryRef != NULL)
-        {
-            entryRef = resTree_FindEntry(entryRef, path);
-
-            if ((entryRef != NULL) && (!resTree_IsResource(entryRef)))
-            {
-                LE_DEBUG("Entry '%s' is not a resource (it's a %s).",
-                         path,
-                         hub_GetEntryTypeName(resTree_GetEntryType(entryRef)));
-                entryRef = NULL;
-            }
-        }
+        return NAN;
     }
 
-    return entryRef;
+    return resTree_QueryMin(entryRef, startTime, endTime);
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Get the current data type of a resource.
- *
- * @note Observations and Placeholders will default to IO_DATA_TYPE_TRIGGER, but will change
- *       types as other types of data are pushed to them.  The data types of Inputs and Outputs
- *       are decided by the apps that create them.
+ * Get the maximum value found within a given time span in an Observation's buffer.
+ * Unlike query_GetMax(), the time span can end before the newest sample.
  *
- * @return
- *  - LE_OK if successful.
- *  - LE_NOT_FOUND if the resource was not found.
- *  - LE_UNSUPPORTED if the path refers to a namespace (which can't have a data type).
+ * @return The value, or NAN (not-a-number) if there's no numerical data in the time span of the
+ *         Observation's buffer (if the buffer size is zero, no samples fall within the time span,
+ *         or the buffer contains data of a non-numerical type).
  */
 //--------------------------------------------------------------------------------------------------
-le_result_t query_GetDataType
+double query_GetMaxInRange
 (
-    const char* path,
-        ///< [IN] Resource path. Can be absolute (beginning
-        ///< with a '/') or relative to the namespace of
-        ///< the calling app (/app/<app-name>/).
-    io_DataType_t* dataTypePtr
-        ///< [OUT] The fetched data type, if LE_OK is returned.
+    const char* obsPath,
+        ///< [IN] Observation path. Can be absolute
+        ///< (beginning with a '/') or relative to /obs/.
+    double startTime,
+        ///< [IN] If < 30 years then seconds before now; else seconds since the Epoch.
+        ///< NAN = from the oldest sample.
+    double endTime
+        ///< [IN] If < 30 years then seconds before now; else seconds since the Epoch.
+        ///< NAN = up to the newest sample.
 )
 //--------------------------------------------------------------------------------------------------
 {
-    resTree_EntryRef_t entryRef = FindResource(path);
+    resTree_EntryRef_t entryRef = FindObservation(obsPath);
 
     if (entryRef == NULL)
     {
-        return LE_NOT_FOUND;
-    }
-    else if (!resTree_IsResource(entryRef))
-    {
-        return LE_UNSUPPORTED;
-    }
-    else
-    {
-        *dataTypePtr = resTree_GetDataType(entryRef);
-        return LE_OK;
+        return NAN;
     }
-}
 
+    return resTree_QueryMax(entryRef, startTime, endTime);
+}
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Get the current units of a resource.
- *
- * @note Observations and Placeholders will default to "", but will change units as data is
- *       pushed to them.  The units of Inputs and Outputs are decided by the apps that create them.
+ * Get the mean (average) of all values found within a given time span in an Observation's buffer.
+ * Unlike query_GetMean(), the time span can end before the newest sample.
  *
- * @return
- *  - LE_OK if successful.
- *  - LE_NOT_FOUND if the resource was not found.
- *  - LE_UNSUPPORTED if the path refers to a namespace (which can't have a data type).
- *  - LE_OVERFLOW if the units string was truncated because it is larger than the buffer provided.
+ * @return The value, or NAN (not-a-number) if there's no numerical data in the time span of the
+ *         Observation's buffer (if the buffer size is zero, no samples fall within the time span,
+ *         or the buffer contains data of a non-numerical type).
  */
 //--------------------------------------------------------------------------------------------------
-le_result_t query_GetUnits
+double query_GetMeanInRange
 (
-    const char* path,
-        ///< [IN] Resource path. Can be absolute (beginning
-        ///< with a '/') or relative to the namespace of
-        ///< the calling app (/app/<app-name>/).
-    char* units,
-        ///< [OUT] The fetched units, if LE_OK is returned.
-    size_t unitsSize
-        ///< [IN]
+    const char* obsPath,
+        ///< [IN] Observation path. Can be absolute
+        ///< (beginning with a '/') or relative to /obs/.
+    double startTime,
+        ///< [IN] If < 30 years then seconds before now; else seconds since the Epoch.
+        ///< NAN = from the oldest sample.
+    double endTime
+        ///< [IN] If < 30 years then seconds before now; else seconds since the Epoch.
+        ///< NAN = up to the newest sample.
 )
 //--------------------------------------------------------------------------------------------------
 {
-    resTree_EntryRef_t entryRef = FindResource(path);
+    resTree_EntryRef_t entryRef = FindObservation(obsPath);
 
     if (entryRef == NULL)
     {
-        return LE_NOT_FOUND;
-    }
-    else if (!resTree_IsResource(entryRef))
-    {
-        return LE_UNSUPPORTED;
-    }
-    else
-    {
-        return le_utf8_Copy(units, resTree_GetUnits(entryRef), unitsSize, NULL);
+        return NAN;
     }
-}
 
+    return resTree_QueryMean(entryRef, startTime, endTime);
+}
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Get the timestamp of the current value of a resource.
+ * Get the standard deviation of all values found within a given time span in an
+ * Observation's buffer.
+ * Unlike query_GetStdDev(), the time span can end before the newest sample.
  *
- * @return
- *  - LE_OK if successful.
- *  - LE_NOT_FOUND if the resource was not found.
- *  - LE_UNSUPPORTED if the path refers to a namespace (which can't have a data type).
- *  - LE_UNAVAILABLE if the resource doesn't have a current value (yet).
+ * @return The value, or NAN (not-a-number) if there's no numerical data in the time span of the
+ *         Observation's buffer (if the buffer size is zero, no samples fall within the time span,
+ *         or the buffer contains data of a non-numerical type).
  */
 //--------------------------------------------------------------------------------------------------
-le_result_t query_GetTimestamp
+double query_GetStdDevInRange
 (
-    const char* path,
-        ///< [IN] Resource path. Can be absolute (beginning
-        ///< with a '/') or relative to the namespace of
-        ///< the calling app (/app/<app-name>/).
-    double* timestampPtr
-        ///< [OUT] The fetched timestamp (in seconds since the Epoch), if LE_OK returned.
-)
-//--------------------------------------------------------------------------------------------------
-{
+    const char* obsPath,
+        ///< [IN] Observation path. Can be absolute
+        ///< (beginning with a '/') or relative to /obs/.
+    double startTime,
+        ///< [IN] If < 30 years then seconds before now; else seconds since the Epoch.
+        ///< NAN = from the oldest sample.
+    double endTime
+        ///< [IN] If < 30 years then seconds before now; else seconds since the Epoch.
+        ///< NAN = up to the newest sample.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    resTree_EntryRef_t entryRef = FindObservation(obsPath);
+
+    if (entryRef == NULL)
+    {
+        return NAN;
+    }
+
+    return resTree_QueryStdDev(entryRef, startTime, endTime);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the count, minimum, maximum, mean and standard deviation of the numerical values found
+ * within a given time span in an Observation's buffer, along with the timestamps of the oldest and
+ * newest samples in the time span, all in one call.
+ *
+ * @return
+ *  - LE_OK if successful.
+ *  - LE_NOT_FOUND if the Observation doesn't exist or has no numerical data in the time span
+ *                 (if the buffer size is zero, no samples fall within the time span, or the
+ *                 buffer contains data of a non-numerical type).
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t query_GetStats
+(
+    const char* obsPath,
+        ///< [IN] Observation path. Can be absolute
+        ///< (beginning with a '/') or relative to /obs/.
+    double startTime,
+        ///< [IN] If < 30 years then seconds before now; else seconds since the Epoch.
+        ///< NAN = from the oldest sample.
+    double endTime,
+        ///< [IN] If < 30 years then seconds before now; else seconds since the Epoch.
+        ///< NAN = up to the newest sample.
+    uint32_t* countPtr,
+        ///< [OUT] Number of numerical values in the time span.
+    double* minPtr,
+        ///< [OUT] Minimum value, if LE_OK returned.
+    double* maxPtr,
+        ///< [OUT] Maximum value, if LE_OK returned.
+    double* meanPtr,
+        ///< [OUT] Mean value, if LE_OK returned.
+    double* stdDevPtr,
+        ///< [OUT] Standard deviation, if LE_OK returned.
+    double* firstTimestampPtr,
+        ///< [OUT] Timestamp of the oldest sample in the time span.
+    double* lastTimestampPtr
+        ///< [OUT] Timestamp of the newest sample in the time span.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    hub_BufferStats_t stats = { 0, NAN, NAN, NAN, NAN, NAN, NAN };
+
+    resTree_EntryRef_t entryRef = FindObservation(obsPath);
+
+    if (entryRef != NULL)
+    {
+        (void)resTree_QueryStats(entryRef, startTime, endTime, &stats);
+    }
+
+    *countPtr = stats.count;
+    *minPtr = stats.min;
+    *maxPtr = stats.max;
+    *meanPtr = stats.mean;
+    *stdDevPtr = stats.stdDev;
+    *firstTimestampPtr = stats.firstTimestamp;
+    *lastTimestampPtr = stats.lastTimestamp;
+
+    return (stats.count > 0) ? LE_OK : LE_NOT_FOUND;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Divide a time span of an Observation's buffer into buckets of a given width and compute an
+ * aggregate of the samples in each bucket, to fetch a downsampled view of the buffer.
+ *
+ * @return
+ *  - LE_OK if successful.
+ *  - LE_NOT_FOUND if the Observation doesn't exist or there are no samples in the time span.
+ *  - LE_UNSUPPORTED if the aggregate type needs numerical data and the buffer holds another type.
+ *  - LE_BAD_PARAMETER if the bucket width isn't positive or the time span ends before it starts.
+ *  - LE_OVERFLOW if the time span holds more buckets than fit in the values array (the array is
+ *                filled with the first buckets' values).
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t query_GetBuckets
+(
+    const char* obsPath,
+        ///< [IN] Observation path. Can be absolute
+        ///< (beginning with a '/') or relative to /obs/.
+    double startTime,
+        ///< [IN] If < 30 years then seconds before now; else seconds since the Epoch.
+        ///< NAN = from the oldest sample.
+    double endTime,
+        ///< [IN] If < 30 years then seconds before now; else seconds since the Epoch.
+        ///< NAN = up to the newest sample.
+    double bucketWidth,
+        ///< [IN] Width of each bucket (seconds).
+    query_AggregateType_t aggregateType,
+        ///< [IN] Aggregate to compute over each bucket's samples.
+    double* valuesPtr,
+        ///< [OUT] Value of each bucket, oldest first.
+    size_t* valuesSizePtr
+        ///< [INOUT]
+)
+//--------------------------------------------------------------------------------------------------
+{
+    resTree_EntryRef_t entryRef = FindObservation(obsPath);
+
+    if (entryRef == NULL)
+    {
+        *valuesSizePtr = 0;
+        return LE_NOT_FOUND;
+    }
+
+    if (   (startTime < 0)
+        || (endTime < 0)
+        || (aggregateType > QUERY_AGGREGATE_TYPE_COUNT)  )
+    {
+        LE_KILL_CLIENT("Invalid bucket query (start %lf, end %lf, aggregate type %d).",
+                       startTime,
+                       endTime,
+                       (int)aggregateType);
+        *valuesSizePtr = 0;
+        return LE_BAD_PARAMETER;   // Doesn't matter what we return.
+    }
+
+    return resTree_QueryBuckets(entryRef,
+                                startTime,
+                                endTime,
+                                bucketWidth,
+                                aggregateType,
+                                valuesPtr,
+                                valuesSizePtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of bytes of memory allocated for the samples buffered in an Observation, and the
+ * number of samples that have been evicted from its buffer to keep the samples buffered in all
+ * Observations within the hub's buffer memory budget.
+ *
+ * @return
+ *  - LE_OK if successful.
+ *  - LE_NOT_FOUND if the Observation doesn't exist.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t query_GetObsBufferMemoryUsage
+(
+    const char* obsPath,
+        ///< [IN] Observation path. Can be absolute
+        ///< (beginning with a '/') or relative to /obs/.
+    uint64_t* bytesPtr,
+        ///< [OUT] Bytes allocated for the buffer.
+    uint64_t* evictionCountPtr
+        ///< [OUT] Number of samples evicted from the buffer.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    resTree_EntryRef_t entryRef = FindObservation(obsPath);
+
+    if (entryRef == NULL)
+    {
+        return LE_NOT_FOUND;
+    }
+
+    resTree_GetBufferMemoryUsage(entryRef, bytesPtr, evictionCountPtr);
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of bytes of memory allocated for the samples buffered in all Observations, and
+ * the number of samples that have been evicted from their buffers to stay within the hub's buffer
+ * memory budget.
+ */
+//--------------------------------------------------------------------------------------------------
+void query_GetBufferMemoryUsage
+(
+    uint64_t* bytesPtr,
+        ///< [OUT] Bytes allocated for all buffers.
+    uint64_t* evictionCountPtr
+        ///< [OUT] Number of samples evicted from all buffers.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    obs_GetTotalBufferMemoryUsage(bytesPtr, evictionCountPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Find a resource at a given path.  The path can be absolute (beginning with a '/'), or relative
+ * to the calling app's namespace.
+ *
+ * @return Reference to the resource or NULL if not found.
+ */
+//--------------------------------------------------------------------------------------------------
+static resTree_EntryRef_t FindResource
+(
+    const char* path
+)
+//--------------------------------------------------------------------------------------------------
+{
+    resTree_EntryRef_t entryRef;
+
+    if (path[0] == '/')
+    {
+        entryRef = resTree_FindEntryAtAbsolutePath(path);
+    }
+    else
+    {
+        entryRef = hub_GetClientNamespace(query_GetClientSessionRef());
+
+        if (entryRef != NULL)
+        {
+            entryRef = resTree_FindEntry(entryRef, path);
+
+            if ((entryRef != NULL) && (!resTree_IsResource(entryRef)))
+            {
+                LE_DEBUG("Entry '%s' is not a resource (it's a %s).",
+                         path,
+                         hub_GetEntryTypeName(resTree_GetEntryType(entryRef)));
+                entryRef = NULL;
+            }
+        }
+    }
+
+    return entryRef;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the resource a client's resource reference (from query_OpenResource()) refers to.
+ *
+ * @return Reference to the resource, or NULL if the reference isn't valid.
+ */
+//--------------------------------------------------------------------------------------------------
+static resTree_EntryRef_t FindResourceByHandle
+(
+    query_ResourceRef_t resourceRef
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return resHandle_Lookup(query_GetClientSessionRef(), resourceRef);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the current data type of a resource.
+ *
+ * @note Observations and Placeholders will default to IO_DATA_TYPE_TRIGGER, but will change
+ *       types as other types of data are pushed to them.  The data types of Inputs and Outputs
+ *       are decided by the apps that create them.
+ *
+ * @return
+ *  - LE_OK if successful.
+ *  - LE_NOT_FOUND if the resource was not found.
+ *  - LE_UNSUPPORTED if the path refers to a namespace (which can't have a data type).
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t query_GetDataType
+(
+    const char* path,
+        ///< [IN] Resource path. Can be absolute (beginning
+        ///< with a '/') or relative to the namespace of
+        ///< the calling app (/app/<app-name>/).
+    io_DataType_t* dataTypePtr
+        ///< [OUT] The fetched data type, if LE_OK is returned.
+)
+//--------------------------------------------------------------------------------------------------
+{
     resTree_EntryRef_t entryRef = FindResource(path);
 
+    if (entryRef == NULL)
+    {
+        return LE_NOT_FOUND;
+    }
+    else if (!resTree_IsResource(entryRef))
+    {
+        return LE_UNSUPPORTED;
+    }
+    else
+    {
+        *dataTypePtr = resTree_GetDataType(entryRef);
+        return LE_OK;
+    }
+}
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the current units of a resource.
+ *
+ * @note Observations and Placeholders will default to "", but will change units as data is
+ *       pushed to them.  The units of Inputs and Outputs are decided by the apps that create them.
+ *
+ * @return
+ *  - LE_OK if successful.
+ *  - LE_NOT_FOUND if the resource was not found.
+ *  - LE_UNSUPPORTED if the path refers to a namespace (which can't have a data type).
+ *  - LE_OVERFLOW if the units string was truncated because it is larger than the buffer provided.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t query_GetUnits
+(
+    const char* path,
+        ///< [IN] Resource path. Can be absolute (beginning
+        ///< with a '/') or relative to the namespace of
+        ///< the calling app (/app/<app-name>/).
+    char* units,
+        ///< [OUT] The fetched units, if LE_OK is returned.
+    size_t unitsSize
+        ///< [IN]
+)
+//--------------------------------------------------------------------------------------------------
+{
+    resTree_EntryRef_t entryRef = FindResource(path);
+
+    if (entryRef == NULL)
+    {
+        return LE_NOT_FOUND;
+    }
+    else if (!resTree_IsResource(entryRef))
+    {
+        return LE_UNSUPPORTED;
+    }
+    else
+    {
+        return le_utf8_Copy(units, resTree_GetUnits(entryRef), unitsSize, NULL);
+    }
+}
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the timestamp of the current value of a given resource.
+ *
+ * @return
+ *  - LE_OK if successful.
+ *  - LE_NOT_FOUND if the resource was not found.
+ *  - LE_UNSUPPORTED if the resource is a namespace (which can't have a data type).
+ *  - LE_UNAVAILABLE if the resource doesn't have a current value (yet).
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t GetTimestamp
+(
+    resTree_EntryRef_t entryRef,
+        ///< [IN] The resource (NULL if not found).
+    double* timestampPtr
+        ///< [OUT] The fetched timestamp (in seconds since the Epoch), if LE_OK returned.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (entryRef == NULL)
+    {
+        return LE_NOT_FOUND;
+    }
+    else if (!resTree_IsResource(entryRef))
+    {
+        return LE_UNSUPPORTED;
+    }
+    else
+    {
+        dataSample_Ref_t sampleRef = resTree_GetCurrentValue(entryRef);
+
+        if (sampleRef == NULL)
+        {
+            return LE_UNAVAILABLE;
+        }
+        else
+        {
+            *timestampPtr = dataSample_GetTimestamp(sampleRef);
+
+            return LE_OK;
+        }
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the current value of a given resource, if it's Boolean type.
+ *
+ * @return
+ *  - LE_OK if successful.
+ *  - LE_NOT_FOUND if the resource was not found.
+ *  - LE_UNSUPPORTED if the resource is a namespace (which can't have a data type).
+ *  - LE_UNAVAILABLE if the resource doesn't have a current value (yet).
+ *  - LE_FORMAT_ERROR if the resource has another data type.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t GetBoolean
+(
+    resTree_EntryRef_t entryRef,
+        ///< [IN] The resource (NULL if not found).
+    double* timestampPtr,
+        ///< [OUT] Fetched timestamp (in seconds since the Epoch), if LE_OK returned.
+    bool* valuePtr
+        ///< [OUT] Fetched value, if LE_OK returned.
+)
+//--------------------------------------------------------------------------------------------------
+{
     if (entryRef == NULL)
     {
         return LE_NOT_FOUND;
@@ -726,16 +1301,219 @@ le_result_t query_GetTimestamp
         {
             return LE_UNAVAILABLE;
         }
+        else if (resTree_GetDataType(entryRef) != IO_DATA_TYPE_BOOLEAN)
+        {
+            return LE_FORMAT_ERROR;
+        }
         else
         {
             *timestampPtr = dataSample_GetTimestamp(sampleRef);
 
+            *valuePtr = dataSample_GetBoolean(sampleRef);
+
+            return LE_OK;
+        }
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the current value of a given resource, if it's numeric type.
+ *
+ * @return
+ *  - LE_OK if successful.
+ *  - LE_NOT_FOUND if the resource was not found.
+ *  - LE_UNSUPPORTED if the resource is a namespace (which can't have a data type).
+ *  - LE_UNAVAILABLE if the resource doesn't have a current value (yet).
+ *  - LE_FORMAT_ERROR if the resource has another data type.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t GetNumeric
+(
+    resTree_EntryRef_t entryRef,
+        ///< [IN] The resource (NULL if not found).
+    double* timestampPtr,
+        ///< [OUT] Fetched timestamp (in seconds since the Epoch), if LE_OK returned.
+    double* valuePtr
+        ///< [OUT] Fetched value, if LE_OK returned.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (entryRef == NULL)
+    {
+        return LE_NOT_FOUND;
+    }
+    else if (!resTree_IsResource(entryRef))
+    {
+        return LE_UNSUPPORTED;
+    }
+    else
+    {
+        dataSample_Ref_t sampleRef = resTree_GetCurrentValue(entryRef);
+
+        if (sampleRef == NULL)
+        {
+            return LE_UNAVAILABLE;
+        }
+        else if (resTree_GetDataType(entryRef) != IO_DATA_TYPE_NUMERIC)
+        {
+            return LE_FORMAT_ERROR;
+        }
+        else
+        {
+            *timestampPtr = dataSample_GetTimestamp(sampleRef);
+
+            *valuePtr = dataSample_GetNumeric(sampleRef);
+
             return LE_OK;
         }
     }
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the current value of a given resource, if it's a string type.
+ *
+ * @return
+ *  - LE_OK if successful.
+ *  - LE_NOT_FOUND if the resource was not found.
+ *  - LE_UNSUPPORTED if the resource is a namespace (which can't have a data type).
+ *  - LE_UNAVAILABLE if the resource doesn't have a current value (yet).
+ *  - LE_FORMAT_ERROR if the resource has another data type.
+ *  - LE_OVERFLOW if the value was truncated because it is larger than the buffer provided.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t GetString
+(
+    resTree_EntryRef_t entryRef,
+        ///< [IN] The resource (NULL if not found).
+    double* timestampPtr,
+        ///< [OUT] Fetched timestamp (in seconds since the Epoch), if LE_OK returned.
+    char* value,
+        ///< [OUT] Fetched value, if LE_OK returned.
+    size_t valueSize
+        ///< [IN]
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (entryRef == NULL)
+    {
+        return LE_NOT_FOUND;
+    }
+    else if (!resTree_IsResource(entryRef))
+    {
+        return LE_UNSUPPORTED;
+    }
+    else
+    {
+        dataSample_Ref_t sampleRef = resTree_GetCurrentValue(entryRef);
+
+        if (sampleRef == NULL)
+        {
+            return LE_UNAVAILABLE;
+        }
+        else if (resTree_GetDataType(entryRef) != IO_DATA_TYPE_STRING)
+        {
+            return LE_FORMAT_ERROR;
+        }
+        else
+        {
+            *timestampPtr = dataSample_GetTimestamp(sampleRef);
+
+            return le_utf8_Copy(value, dataSample_GetString(sampleRef), valueSize, NULL);
+        }
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the current value of a given resource of any type, in JSON format.
+ *
+ * @return
+ *  - LE_OK if successful.
+ *  - LE_NOT_FOUND if the resource was not found.
+ *  - LE_UNSUPPORTED if the resource is a namespace (which can't have a data type).
+ *  - LE_UNAVAILABLE if the resource doesn't have a current value (yet).
+ *  - LE_OVERFLOW if the value was truncated because it is larger than the buffer provided.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t GetJson
+(
+    resTree_EntryRef_t entryRef,
+        ///< [IN] The resource (NULL if not found).
+    double* timestampPtr,
+        ///< [OUT] Fetched timestamp (in seconds since the Epoch), if LE_OK returned.
+    char* value,
+        ///< [OUT] Fetched value, if LE_OK returned.
+    size_t valueSize
+        ///< [IN]
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (entryRef == NULL)
+    {
+        return LE_NOT_FOUND;
+    }
+    else if (!resTree_IsResource(entryRef))
+    {
+        return LE_UNSUPPORTED;
+    }
+    else
+    {
+        dataSample_Ref_t sampleRef = resTree_GetCurrentValue(entryRef);
+
+        if (sampleRef == NULL)
+        {
+            return LE_UNAVAILABLE;
+        }
+        else
+        {
+            *timestampPtr = dataSample_GetTimestamp(sampleRef);
+
+            io_DataType_t dataType = resTree_GetDataType(entryRef);
+
+            if (dataType == IO_DATA_TYPE_JSON)
+            {
+                return le_utf8_Copy(value, dataSample_GetJson(sampleRef), valueSize, NULL);
+            }
+            else
+            {
+                return dataSample_ConvertToJson(sampleRef, dataType, value, valueSize);
+            }
+        }
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the timestamp of the current value of a resource.
+ *
+ * @return
+ *  - LE_OK if successful.
+ *  - LE_NOT_FOUND if the resource was not found.
+ *  - LE_UNSUPPORTED if the path refers to a namespace (which can't have a data type).
+ *  - LE_UNAVAILABLE if the resource doesn't have a current value (yet).
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t query_GetTimestamp
+(
+    const char* path,
+        ///< [IN] Resource path. Can be absolute (beginning
+        ///< with a '/') or relative to the namespace of
+        ///< the calling app (/app/<app-name>/).
+    double* timestampPtr
+        ///< [OUT] The fetched timestamp (in seconds since the Epoch), if LE_OK returned.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return GetTimestamp(FindResource(path), timestampPtr);
+}
+
+
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -762,37 +1540,7 @@ le_result_t query_GetBoolean
 )
 //--------------------------------------------------------------------------------------------------
 {
-    resTree_EntryRef_t entryRef = FindResource(path);
-
-    if (entryRef == NULL)
-    {
-        return LE_NOT_FOUND;
-    }
-    else if (!resTree_IsResource(entryRef))
-    {
-        return LE_UNSUPPORTED;
-    }
-    else
-    {
-        dataSample_Ref_t sampleRef = resTree_GetCurrentValue(entryRef);
-
-        if (sampleRef == NULL)
-        {
-            return LE_UNAVAILABLE;
-        }
-        else if (resTree_GetDataType(entryRef) != IO_DATA_TYPE_BOOLEAN)
-        {
-            return LE_FORMAT_ERROR;
-        }
-        else
-        {
-            *timestampPtr = dataSample_GetTimestamp(sampleRef);
-
-            *valuePtr = dataSample_GetBoolean(sampleRef);
-
-            return LE_OK;
-        }
-    }
+    return GetBoolean(FindResource(path), timestampPtr, valuePtr);
 }
 
 
@@ -822,37 +1570,7 @@ le_result_t query_GetNumeric
 )
 //--------------------------------------------------------------------------------------------------
 {
-    resTree_EntryRef_t entryRef = FindResource(path);
-
-    if (entryRef == NULL)
-    {
-        return LE_NOT_FOUND;
-    }
-    else if (!resTree_IsResource(entryRef))
-    {
-        return LE_UNSUPPORTED;
-    }
-    else
-    {
-        dataSample_Ref_t sampleRef = resTree_GetCurrentValue(entryRef);
-
-        if (sampleRef == NULL)
-        {
-            return LE_UNAVAILABLE;
-        }
-        else if (resTree_GetDataType(entryRef) != IO_DATA_TYPE_NUMERIC)
-        {
-            return LE_FORMAT_ERROR;
-        }
-        else
-        {
-            *timestampPtr = dataSample_GetTimestamp(sampleRef);
-
-            *valuePtr = dataSample_GetNumeric(sampleRef);
-
-            return LE_OK;
-        }
-    }
+    return GetNumeric(FindResource(path), timestampPtr, valuePtr);
 }
 
 
@@ -885,35 +1603,7 @@ le_result_t query_GetString
 )
 //--------------------------------------------------------------------------------------------------
 {
-    resTree_EntryRef_t entryRef = FindResource(path);
-
-    if (entryRef == NULL)
-    {
-        return LE_NOT_FOUND;
-    }
-    else if (!resTree_IsResource(entryRef))
-    {
-        return LE_UNSUPPORTED;
-    }
-    else
-    {
-        dataSample_Ref_t sampleRef = resTree_GetCurrentValue(entryRef);
-
-        if (sampleRef == NULL)
-        {
-            return LE_UNAVAILABLE;
-        }
-        else if (resTree_GetDataType(entryRef) != IO_DATA_TYPE_STRING)
-        {
-            return LE_FORMAT_ERROR;
-        }
-        else
-        {
-            *timestampPtr = dataSample_GetTimestamp(sampleRef);
-
-            return le_utf8_Copy(value, dataSample_GetString(sampleRef), valueSize, NULL);
-        }
-    }
+    return GetString(FindResource(path), timestampPtr, value, valueSize);
 }
 
 
@@ -944,41 +1634,192 @@ le_result_t query_GetJson
         ///< [IN]
 )
 //--------------------------------------------------------------------------------------------------
+{
+    return GetJson(FindResource(path), timestampPtr, value, valueSize);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get a reference to a resource, for use with the ByHandle functions.  The reference is only
+ * valid for this client, and only until the resource is deleted.
+ *
+ * If the client already has a reference to the resource, the same reference is returned.
+ *
+ * @return The reference, or NULL if the path doesn't refer to a resource (or out of memory).
+ */
+//--------------------------------------------------------------------------------------------------
+query_ResourceRef_t query_OpenResource
+(
+    const char* path
+        ///< [IN] Resource path. Can be absolute (beginning
+        ///< with a '/') or relative to the namespace of
+        ///< the calling app (/app/<app-name>/).
+)
+//--------------------------------------------------------------------------------------------------
 {
     resTree_EntryRef_t entryRef = FindResource(path);
 
-    if (entryRef == NULL)
-    {
-        return LE_NOT_FOUND;
-    }
-    else if (!resTree_IsResource(entryRef))
+    if ((entryRef == NULL) || !resTree_IsResource(entryRef))
     {
-        return LE_UNSUPPORTED;
+        LE_DEBUG("No resource at '%s'.", path);
+        return NULL;
     }
-    else
-    {
-        dataSample_Ref_t sampleRef = resTree_GetCurrentValue(entryRef);
 
-        if (sampleRef == NULL)
-        {
-            return LE_UNAVAILABLE;
-        }
-        else
-        {
-            *timestampPtr = dataSample_GetTimestamp(sampleRef);
+    return resHandle_Open(query_GetClientSessionRef(), entryRef);
+}
 
-            io_DataType_t dataType = resTree_GetDataType(entryRef);
 
-            if (dataType == IO_DATA_TYPE_JSON)
-            {
-                return le_utf8_Copy(value, dataSample_GetJson(sampleRef), valueSize, NULL);
-            }
-            else
-            {
-                return dataSample_ConvertToJson(sampleRef, dataType, value, valueSize);
-            }
-        }
-    }
+//--------------------------------------------------------------------------------------------------
+/**
+ * Release a reference obtained from query_OpenResource().  Does nothing if it isn't valid.
+ */
+//--------------------------------------------------------------------------------------------------
+void query_CloseResource
+(
+    query_ResourceRef_t resourceRef
+        ///< [IN] Reference to the resource.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    resHandle_Close(query_GetClientSessionRef(), resourceRef);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the timestamp of the current value of a resource,
+ * given a reference to it from query_OpenResource().
+ *
+ * @return
+ *  - LE_OK if successful.
+ *  - LE_NOT_FOUND if the resource reference is not valid.
+ *  - LE_UNAVAILABLE if the resource doesn't have a current value (yet).
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t query_GetTimestampByHandle
+(
+    query_ResourceRef_t resourceRef,
+        ///< [IN] Reference to the resource.
+    double* timestampPtr
+        ///< [OUT] The fetched timestamp (in seconds since the Epoch), if LE_OK returned.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return GetTimestamp(FindResourceByHandle(resourceRef), timestampPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the current value of a resource, if it's Boolean type,
+ * given a reference to it from query_OpenResource().
+ *
+ * @return
+ *  - LE_OK if successful.
+ *  - LE_NOT_FOUND if the resource reference is not valid.
+ *  - LE_UNAVAILABLE if the resource doesn't have a current value (yet).
+ *  - LE_FORMAT_ERROR if the resource has another data type.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t query_GetBooleanByHandle
+(
+    query_ResourceRef_t resourceRef,
+        ///< [IN] Reference to the resource.
+    double* timestampPtr,
+        ///< [OUT] Fetched timestamp (in seconds since the Epoch), if LE_OK returned.
+    bool* valuePtr
+        ///< [OUT] Fetched value, if LE_OK returned.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return GetBoolean(FindResourceByHandle(resourceRef), timestampPtr, valuePtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the current value of a resource, if it's numeric type,
+ * given a reference to it from query_OpenResource().
+ *
+ * @return
+ *  - LE_OK if successful.
+ *  - LE_NOT_FOUND if the resource reference is not valid.
+ *  - LE_UNAVAILABLE if the resource doesn't have a current value (yet).
+ *  - LE_FORMAT_ERROR if the resource has another data type.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t query_GetNumericByHandle
+(
+    query_ResourceRef_t resourceRef,
+        ///< [IN] Reference to the resource.
+    double* timestampPtr,
+        ///< [OUT] Fetched timestamp (in seconds since the Epoch), if LE_OK returned.
+    double* valuePtr
+        ///< [OUT] Fetched value, if LE_OK returned.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return GetNumeric(FindResourceByHandle(resourceRef), timestampPtr, valuePtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the current value of a resource, if it's a string type,
+ * given a reference to it from query_OpenResource().
+ *
+ * @return
+ *  - LE_OK if successful.
+ *  - LE_NOT_FOUND if the resource reference is not valid.
+ *  - LE_UNAVAILABLE if the resource doesn't have a current value (yet).
+ *  - LE_FORMAT_ERROR if the resource has another data type.
+ *  - LE_OVERFLOW if the value was truncated because it is larger than the buffer provided.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t query_GetStringByHandle
+(
+    query_ResourceRef_t resourceRef,
+        ///< [IN] Reference to the resource.
+    double* timestampPtr,
+        ///< [OUT] Fetched timestamp (in seconds since the Epoch), if LE_OK returned.
+    char* value,
+        ///< [OUT] Fetched value, if LE_OK returned.
+    size_t valueSize
+        ///< [IN]
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return GetString(FindResourceByHandle(resourceRef), timestampPtr, value, valueSize);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the current value of a resource of any type, in JSON format,
+ * given a reference to it from query_OpenResource().
+ *
+ * @return
+ *  - LE_OK if successful.
+ *  - LE_NOT_FOUND if the resource reference is not valid.
+ *  - LE_UNAVAILABLE if the resource doesn't have a current value (yet).
+ *  - LE_OVERFLOW if the value was truncated because it is larger than the buffer provided.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t query_GetJsonByHandle
+(
+    query_ResourceRef_t resourceRef,
+        ///< [IN] Reference to the resource.
+    double* timestampPtr,
+        ///< [OUT] Fetched timestamp (in seconds since the Epoch), if LE_OK returned.
+    char* value,
+        ///< [OUT] Fetched value, if LE_OK returned.
+    size_t valueSize
+        ///< [IN]
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return GetJson(FindResourceByHandle(resourceRef), timestampPtr, value, valueSize);
 }
 
 
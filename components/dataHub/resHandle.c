@@ -0,0 +1,377 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * @file resHandle.c
+ *
+ * Implementation of resource handles, used by the I/O and Query APIs to refer to resources by
+ * safe reference rather than by path.
+ *
+ * Each handle holds a reference to the resource tree entry it refers to, so the entry can't be
+ * freed while the handle is open.  Handles are dropped when the resource is deleted (see
+ * resTree_DeleteIO() and resTree_DeleteObservation()), and when the client session they belong to
+ * closes.
+ *
+ * Every handle is on two lists: the list of handles open to its entry (kept in the entry, see
+ * resTree_GetHandleList()), and the list of handles open in its session (kept in a Session record
+ * that exists while the session has any handles open).  So dropping the handles of a resource or
+ * of a session only visits those handles, however many others are open.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#include "dataHub.h"
+#include "resHandle.h"
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * A client session that has resource handles open.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_dls_Link_t link;             ///< Used to link into the SessionList.
+    le_msg_SessionRef_t sessionRef; ///< The client session.
+    le_dls_List_t handleList;       ///< Handles open in the session.
+}
+Session_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * A client session's handle to a resource.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_dls_Link_t sessionLink;      ///< Used to link into the session's list of handles.
+    le_dls_Link_t entryLink;        ///< Used to link into the resource's list of handles.
+    void* safeRef;                  ///< Safe reference passed to the client.
+    Session_t* sessionPtr;          ///< Client session the handle belongs to.
+    resTree_EntryRef_t entryRef;    ///< The resource (holds a reference to it).
+}
+Handle_t;
+
+/// Default number of resource handles.  This can be overridden in the .cdef.
+#define DEFAULT_RESOURCE_HANDLE_POOL_SIZE 10
+
+/// Default number of client sessions with resource handles open.  This can be overridden in the
+/// .cdef.
+#define DEFAULT_HANDLE_SESSION_POOL_SIZE 4
+
+/// Size of the resource handle reference map.
+#define RESOURCE_HANDLE_MAP_SIZE LE_MEM_BLOCKS(HandlePool, DEFAULT_RESOURCE_HANDLE_POOL_SIZE)
+
+/// Pool from which Handle objects are allocated.
+static le_mem_PoolRef_t HandlePool = NULL;
+LE_MEM_DEFINE_STATIC_POOL(HandlePool, DEFAULT_RESOURCE_HANDLE_POOL_SIZE, sizeof(Handle_t));
+
+/// Pool from which Session objects are allocated.
+static le_mem_PoolRef_t HandleSessionPool = NULL;
+LE_MEM_DEFINE_STATIC_POOL(HandleSessionPool, DEFAULT_HANDLE_SESSION_POOL_SIZE, sizeof(Session_t));
+
+/// Safe reference map for Handle objects.
+static le_ref_MapRef_t HandleRefMap = NULL;
+LE_REF_DEFINE_STATIC_MAP(HandleRefMap, RESOURCE_HANDLE_MAP_SIZE);
+
+/// List of client sessions that have handles open.
+static le_dls_List_t SessionList = LE_DLS_LIST_INIT;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Find the record of a client session that has handles open.
+ *
+ * @return Pointer to the record, or NULL if the session has no handles open.
+ */
+//--------------------------------------------------------------------------------------------------
+static Session_t* FindSession
+(
+    le_msg_SessionRef_t sessionRef
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_dls_Link_t* linkPtr = le_dls_Peek(&SessionList);
+
+    while (linkPtr != NULL)
+    {
+        Session_t* sessionPtr = CONTAINER_OF(linkPtr, Session_t, link);
+
+        if (sessionPtr->sessionRef == sessionRef)
+        {
+            return sessionPtr;
+        }
+
+        linkPtr = le_dls_PeekNext(&SessionList, linkPtr);
+    }
+
+    return NULL;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Delete a handle, releasing its reference to the resource.  The session record is deleted too
+ * when this was the last handle open in the session.
+ */
+//--------------------------------------------------------------------------------------------------
+static void DeleteHandle
+(
+    Handle_t* handlePtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Session_t* sessionPtr = handlePtr->sessionPtr;
+
+    le_dls_Remove(&sessionPtr->handleList, &handlePtr->sessionLink);
+    le_dls_Remove(resTree_GetHandleList(handlePtr->entryRef), &handlePtr->entryLink);
+    le_ref_DeleteRef(HandleRefMap, handlePtr->safeRef);
+    le_mem_Release(handlePtr->entryRef);
+    le_mem_Release(handlePtr);
+
+    if (le_dls_IsEmpty(&sessionPtr->handleList))
+    {
+        le_dls_Remove(&SessionList, &sessionPtr->link);
+        le_mem_Release(sessionPtr);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Close all handles belonging to a client session that has closed.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SessionCloseHandler
+(
+    le_msg_SessionRef_t sessionRef,
+    void* contextPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LE_UNUSED(contextPtr);
+
+    resHandle_CloseSession(sessionRef);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize the Resource Handle module.
+ *
+ * @warning This function must be called before any others in this module.
+ */
+//--------------------------------------------------------------------------------------------------
+void resHandle_Init
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    HandlePool = le_mem_InitStaticPool(HandlePool, DEFAULT_RESOURCE_HANDLE_POOL_SIZE,
+                    sizeof(Handle_t));
+
+    HandleSessionPool = le_mem_InitStaticPool(HandleSessionPool, DEFAULT_HANDLE_SESSION_POOL_SIZE,
+                    sizeof(Session_t));
+
+    HandleRefMap = le_ref_InitStaticMap(HandleRefMap, RESOURCE_HANDLE_MAP_SIZE);
+
+    le_msg_AddServiceCloseHandler(io_GetServiceRef(), SessionCloseHandler, NULL);
+    le_msg_AddServiceCloseHandler(query_GetServiceRef(), SessionCloseHandler, NULL);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Open a handle to a resource for a given client session.  If the session already has a handle
+ * to the resource, that handle is returned.
+ *
+ * @return Safe reference to the handle, or NULL if out of memory.
+ */
+//--------------------------------------------------------------------------------------------------
+void* resHandle_Open
+(
+    le_msg_SessionRef_t sessionRef, ///< Client session the handle is for.
+    resTree_EntryRef_t entryRef     ///< The resource.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_dls_List_t* entryHandleListPtr = resTree_GetHandleList(entryRef);
+    le_dls_Link_t* linkPtr = le_dls_Peek(entryHandleListPtr);
+
+    while (linkPtr != NULL)
+    {
+        Handle_t* handlePtr = CONTAINER_OF(linkPtr, Handle_t, entryLink);
+
+        if (handlePtr->sessionPtr->sessionRef == sessionRef)
+        {
+            return handlePtr->safeRef;
+        }
+
+        linkPtr = le_dls_PeekNext(entryHandleListPtr, linkPtr);
+    }
+
+    Session_t* sessionPtr = FindSession(sessionRef);
+
+    if (sessionPtr == NULL)
+    {
+        sessionPtr = hub_MemAlloc(HandleSessionPool);
+
+        if (sessionPtr == NULL)
+        {
+            LE_WARN("Failed to allocate a resource handle session.");
+            return NULL;
+        }
+
+        sessionPtr->link = LE_DLS_LINK_INIT;
+        sessionPtr->sessionRef = sessionRef;
+        sessionPtr->handleList = LE_DLS_LIST_INIT;
+        le_dls_Queue(&SessionList, &sessionPtr->link);
+    }
+
+    Handle_t* handlePtr = hub_MemAlloc(HandlePool);
+
+    if (handlePtr == NULL)
+    {
+        LE_WARN("Failed to allocate a resource handle.");
+
+        if (le_dls_IsEmpty(&sessionPtr->handleList))
+        {
+            le_dls_Remove(&SessionList, &sessionPtr->link);
+            le_mem_Release(sessionPtr);
+        }
+        return NULL;
+    }
+
+    handlePtr->sessionLink = LE_DLS_LINK_INIT;
+    handlePtr->entryLink = LE_DLS_LINK_INIT;
+    handlePtr->safeRef = le_ref_CreateRef(HandleRefMap, handlePtr);
+    handlePtr->sessionPtr = sessionPtr;
+    handlePtr->entryRef = entryRef;
+    le_mem_AddRef(entryRef);
+
+    le_dls_Queue(&sessionPtr->handleList, &handlePtr->sessionLink);
+    le_dls_Queue(entryHandleListPtr, &handlePtr->entryLink);
+
+    return handlePtr->safeRef;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Look up a handle belonging to a given client session.
+ *
+ * @return Pointer to the handle, or NULL if not valid.
+ */
+//--------------------------------------------------------------------------------------------------
+static Handle_t* LookupHandle
+(
+    le_msg_SessionRef_t sessionRef, ///< Client session the handle is for.
+    void* handleRef                 ///< Safe reference to the handle.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Handle_t* handlePtr = le_ref_Lookup(HandleRefMap, handleRef);
+
+    if ((handlePtr == NULL) || (handlePtr->sessionPtr->sessionRef != sessionRef))
+    {
+        return NULL;
+    }
+
+    return handlePtr;
+}
+//--------------------------------------------------------------------------------------------------
+/**
+ * Close a client session's handle to a resource.  Does nothing if the handle isn't valid.
+ */
+//--------------------------------------------------------------------------------------------------
+void resHandle_Close
+(
+    le_msg_SessionRef_t sessionRef, ///< Client session the handle is for.
+    void* handleRef                 ///< Safe reference to the handle.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Handle_t* handlePtr = LookupHandle(sessionRef, handleRef);
+
+    if (handlePtr == NULL)
+    {
+        LE_DEBUG("Invalid resource handle %p. Cannot close.", handleRef);
+        return;
+    }
+
+    DeleteHandle(handlePtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the resource a client session's handle refers to.
+ *
+ * @return The resource, or NULL if the handle isn't valid (or belongs to another session).
+ */
+//--------------------------------------------------------------------------------------------------
+resTree_EntryRef_t resHandle_Lookup
+(
+    le_msg_SessionRef_t sessionRef, ///< Client session the handle is for.
+    void* handleRef                 ///< Safe reference to the handle.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Handle_t* handlePtr = LookupHandle(sessionRef, handleRef);
+
+    return ((handlePtr != NULL) ? handlePtr->entryRef : NULL);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Drop all handles to a resource that is being deleted, so they don't refer to whatever may be
+ * created in its place.
+ */
+//--------------------------------------------------------------------------------------------------
+void resHandle_DropAll
+(
+    resTree_EntryRef_t entryRef
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_dls_List_t* handleListPtr = resTree_GetHandleList(entryRef);
+    le_dls_Link_t* linkPtr;
+
+    while ((linkPtr = le_dls_Peek(handleListPtr)) != NULL)
+    {
+        DeleteHandle(CONTAINER_OF(linkPtr, Handle_t, entryLink));
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Close all handles belonging to a client session, as when the session closes.
+ */
+//--------------------------------------------------------------------------------------------------
+void resHandle_CloseSession
+(
+    le_msg_SessionRef_t sessionRef  ///< The client session.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Session_t* sessionPtr = FindSession(sessionRef);
+
+    if (sessionPtr == NULL)
+    {
+        return;
+    }
+
+    le_dls_Link_t* linkPtr = le_dls_Peek(&sessionPtr->handleList);
+
+    while (linkPtr != NULL)
+    {
+        Handle_t* handlePtr = CONTAINER_OF(linkPtr, Handle_t, sessionLink);
+
+        // The session record is deleted with its last handle, so step past the handle first.
+        linkPtr = le_dls_PeekNext(&sessionPtr->handleList, linkPtr);
+
+        DeleteHandle(handlePtr);
+    }
+}
@@ -0,0 +1,97 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * @file resHandle.h
+ *
+ * Resource handles, which let client apps resolve a resource path once and then refer to the
+ * resource by a safe reference, rather than passing the path (and having it looked up) every
+ * time.
+ *
+ * A handle belongs to the IPC session it was opened in, and can't be used from any other.  It is
+ * dropped when the resource is deleted, or when the session closes.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#ifndef RES_HANDLE_H_INCLUDE_GUARD
+#define RES_HANDLE_H_INCLUDE_GUARD
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize the Resource Handle module.
+ *
+ * @warning This function must be called before any others in this module.
+ */
+//--------------------------------------------------------------------------------------------------
+void resHandle_Init
+(
+    void
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Open a handle to a resource for a given client session.  If the session already has a handle
+ * to the resource, that handle is returned.
+ *
+ * @return Safe reference to the handle, or NULL if out of memory.
+ */
+//--------------------------------------------------------------------------------------------------
+void* resHandle_Open
+(
+    le_msg_SessionRef_t sessionRef, ///< Client session the handle is for.
+    resTree_EntryRef_t entryRef     ///< The resource.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Close a client session's handle to a resource.  Does nothing if the handle isn't valid.
+ */
+//--------------------------------------------------------------------------------------------------
+void resHandle_Close
+(
+    le_msg_SessionRef_t sessionRef, ///< Client session the handle is for.
+    void* handleRef                 ///< Safe reference to the handle.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the resource a client session's handle refers to.
+ *
+ * @return The resource, or NULL if the handle isn't valid (or belongs to another session).
+ */
+//--------------------------------------------------------------------------------------------------
+resTree_EntryRef_t resHandle_Lookup
+(
+    le_msg_SessionRef_t sessionRef, ///< Client session the handle is for.
+    void* handleRef                 ///< Safe reference to the handle.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Drop all handles to a resource that is being deleted, so they don't refer to whatever may be
+ * created in its place.
+ */
+//--------------------------------------------------------------------------------------------------
+void resHandle_DropAll
+(
+    resTree_EntryRef_t entryRef
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Close all handles belonging to a client session, as when the session closes.
+ */
+//--------------------------------------------------------------------------------------------------
+void resHandle_CloseSession
+(
+    le_msg_SessionRef_t sessionRef  ///< The client session.
+);
+
+
+#endif // RES_HANDLE_H_INCLUDE_GUARD
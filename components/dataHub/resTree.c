@@ -11,6 +11,8 @@
 #include "dataSample.h"
 #include "resource.h"
 #include "resTree.h"
+#include "resHandle.h"
+#include "strIntern.h"
 #include "adminService.h"
 #include "snapshot.h"
 
@@ -25,9 +27,15 @@ typedef struct resTree_Entry
 {
     le_dls_Link_t link;  ///< Used to link into parent's list of children.
     struct resTree_Entry* parentPtr; ///< Ptr to the parent entry (NULL if the root entry).
-    char name[HUB_MAX_ENTRY_NAME_BYTES]; ///< Name of the entry.
+    const char* name; ///< Name of the entry (interned, see strIntern.h).
     le_dls_List_t childList;  ///< List of child entries.
+    struct resTree_Entry* nextInBucketPtr; ///< Next entry in the same bucket of the child index.
+    struct resTree_Entry** childIndex; ///< Hash index of the children (NULL if not indexed).
+    uint32_t nameHash; ///< Hash of the name, for looking the entry up in its parent's child index.
+    uint32_t childCount; ///< Number of entries in the list of children.
+    le_dls_List_t handleList; ///< Handles client sessions have open to the entry (see resHandle.c).
     admin_EntryType_t type; ///< The type of entry.
+    uint8_t childIndexBits; ///< log2 of the number of buckets in the child index.
 
     union
     {
@@ -47,6 +55,403 @@ static Entry_t* RootPtr;
 static le_mem_PoolRef_t EntryPool = NULL;
 LE_MEM_DEFINE_STATIC_POOL(EntryPool, DEFAULT_RESOURCE_TREE_ENTRY_POOL_SIZE, sizeof(Entry_t));
 
+/// Number of children a namespace must have before its children are indexed by name.  Below this,
+/// a scan of the list of children is as quick as a hash lookup.
+#define CHILD_INDEX_MIN_CHILDREN 8
+
+/// log2 of the smallest and largest number of buckets in a child index.
+#define MIN_CHILD_INDEX_BITS 4
+#define MAX_CHILD_INDEX_BITS 20
+
+/// Number of child index sizes (and pools).
+#define CHILD_INDEX_POOL_COUNT (MAX_CHILD_INDEX_BITS - MIN_CHILD_INDEX_BITS + 1)
+
+/// Pools of child index bucket arrays, one per power-of-2 size.  Created when first needed.
+static le_mem_PoolRef_t ChildIndexPools[CHILD_INDEX_POOL_COUNT];
+
+/// Number of slots in the path lookup cache (must be a power of 2).
+#define PATH_CACHE_SIZE 256
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Slot in the path lookup cache, which remembers the entry a path was last found to lead to.
+ *
+ * The path itself isn't stored.  Instead, a hit is confirmed by checking that the names of the
+ * entry and its ancestors match the path, which is cheaper than looking the path up again.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t hash;              ///< Hash of the base entry and the path.
+    Entry_t* basePtr;           ///< Entry the path is relative to (NULL if the slot is empty).
+    Entry_t* entryPtr;          ///< Entry the path leads to.
+}
+PathCacheSlot_t;
+
+/// The path lookup cache, indexed by hash.
+static PathCacheSlot_t PathCache[PATH_CACHE_SIZE];
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compute the hash of an entry name (32-bit FNV-1a).
+ *
+ * @return The hash.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t HashName
+(
+    const char* name
+)
+//--------------------------------------------------------------------------------------------------
+{
+    uint32_t hash = 2166136261u;
+
+    for (size_t i = 0; (i < HUB_MAX_ENTRY_NAME_BYTES) && (name[i] != '\0'); i++)
+    {
+        hash = (hash ^ (uint8_t)name[i]) * 16777619u;
+    }
+
+    return hash;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the pool that child indexes with a given number of buckets are allocated from, creating it
+ * if necessary.
+ *
+ * @return The pool.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t GetChildIndexPool
+(
+    uint8_t bits    ///< log2 of the number of buckets.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LE_ASSERT((bits >= MIN_CHILD_INDEX_BITS) && (bits <= MAX_CHILD_INDEX_BITS));
+
+    le_mem_PoolRef_t* poolRefPtr = &ChildIndexPools[bits - MIN_CHILD_INDEX_BITS];
+
+    if (*poolRefPtr == NULL)
+    {
+        char name[32];
+        (void)snprintf(name, sizeof(name), "ChildIndex%zu", (size_t)1 << bits);
+
+        *poolRefPtr = le_mem_CreatePool(name, ((size_t)1 << bits) * sizeof(Entry_t*));
+    }
+
+    return *poolRefPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add an entry to the bucket its name hashes to in a child index.
+ */
+//--------------------------------------------------------------------------------------------------
+static void InsertIntoChildIndex
+(
+    Entry_t** index,    ///< The child index.
+    uint8_t bits,       ///< log2 of the number of buckets in the index.
+    Entry_t* childPtr   ///< The entry to add.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Entry_t** bucketPtr = &index[childPtr->nameHash & (((uint32_t)1 << bits) - 1)];
+
+    childPtr->nextInBucketPtr = *bucketPtr;
+    *bucketPtr = childPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Replace a namespace's child index (if it has one) with a new one with a given number of buckets,
+ * holding all the entries in its list of children.
+ *
+ * @return true if successful, false if out of memory (in which case the old index is kept).
+ */
+//--------------------------------------------------------------------------------------------------
+static bool RebuildChildIndex
+(
+    Entry_t* nsPtr,     ///< The namespace.
+    uint8_t bits        ///< log2 of the number of buckets in the new index.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_mem_PoolRef_t pool = GetChildIndexPool(bits);
+    Entry_t** index = hub_MemAlloc(pool);
+
+#if !LE_CONFIG_LINUX
+    // Child index pools are created empty, so grow them on demand.
+    if (index == NULL)
+    {
+        le_mem_ExpandPool(pool, 1);
+        index = le_mem_TryAlloc(pool);
+    }
+#endif
+
+    if (index == NULL)
+    {
+        LE_WARN("Out of memory for the index of a namespace with %" PRIu32 " children.",
+                nsPtr->childCount);
+        return false;
+    }
+
+    memset(index, 0, ((size_t)1 << bits) * sizeof(Entry_t*));
+
+    le_dls_Link_t* linkPtr = le_dls_Peek(&nsPtr->childList);
+    while (linkPtr != NULL)
+    {
+        InsertIntoChildIndex(index, bits, CONTAINER_OF(linkPtr, Entry_t, link));
+        linkPtr = le_dls_PeekNext(&nsPtr->childList, linkPtr);
+    }
+
+    if (nsPtr->childIndex != NULL)
+    {
+        le_mem_Release(nsPtr->childIndex);
+    }
+    nsPtr->childIndex = index;
+    nsPtr->childIndexBits = bits;
+
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Account for an entry having been added to a namespace's list of children, indexing it if the
+ * namespace's children are indexed.  The index is created once the namespace has enough children
+ * and doubled in size whenever there are more children than buckets, so chains stay short.
+ */
+//--------------------------------------------------------------------------------------------------
+static void IndexChild
+(
+    Entry_t* nsPtr,     ///< The namespace.
+    Entry_t* childPtr   ///< The entry that was added to its list of children.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    nsPtr->childCount++;
+
+    if (nsPtr->childIndex == NULL)
+    {
+        if (nsPtr->childCount >= CHILD_INDEX_MIN_CHILDREN)
+        {
+            // If this fails, lookups just carry on scanning the list.
+            (void)RebuildChildIndex(nsPtr, MIN_CHILD_INDEX_BITS);
+        }
+    }
+    else if (   (nsPtr->childCount <= ((uint32_t)1 << nsPtr->childIndexBits))
+             || (nsPtr->childIndexBits >= MAX_CHILD_INDEX_BITS)
+             || !RebuildChildIndex(nsPtr, nsPtr->childIndexBits + 1)  )
+    {
+        InsertIntoChildIndex(nsPtr->childIndex, nsPtr->childIndexBits, childPtr);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Account for an entry being removed from a namespace's list of children, removing it from the
+ * namespace's child index, if it has one.  The index is discarded once the namespace has no
+ * children left.
+ */
+//--------------------------------------------------------------------------------------------------
+static void UnindexChild
+(
+    Entry_t* nsPtr,     ///< The namespace.
+    Entry_t* childPtr   ///< The entry being removed from its list of children.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LE_ASSERT(nsPtr->childCount > 0);
+    nsPtr->childCount--;
+
+    if (nsPtr->childIndex == NULL)
+    {
+        return;
+    }
+
+    if (nsPtr->childCount == 0)
+    {
+        le_mem_Release(nsPtr->childIndex);
+        nsPtr->childIndex = NULL;
+        nsPtr->childIndexBits = 0;
+        return;
+    }
+
+    Entry_t** linkPtrPtr =
+        &nsPtr->childIndex[childPtr->nameHash & (((uint32_t)1 << nsPtr->childIndexBits) - 1)];
+
+    while (*linkPtrPtr != childPtr)
+    {
+        LE_ASSERT(*linkPtrPtr != NULL);
+        linkPtrPtr = &(*linkPtrPtr)->nextInBucketPtr;
+    }
+
+    *linkPtrPtr = childPtr->nextInBucketPtr;
+    childPtr->nextInBucketPtr = NULL;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compute the hash of a path relative to a given entry (32-bit FNV-1a).
+ *
+ * @return The hash.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t HashPath
+(
+    const Entry_t* basePtr, ///< Entry the path is relative to.
+    const char* path,       ///< Path.
+    size_t* lenPtr          ///< [OUT] Length of the path.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    uint32_t hash = 2166136261u ^ (uint32_t)((uintptr_t)basePtr / sizeof(void*));
+    size_t i;
+
+    for (i = 0; path[i] != '\0'; i++)
+    {
+        hash = (hash ^ (uint8_t)path[i]) * 16777619u;
+    }
+
+    *lenPtr = i;
+    return hash;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether a path relative to a given entry leads to another given entry, by matching the
+ * path's elements against the names of the entry and its ancestors, from the end.  Deleted
+ * entries don't match, just as FindEntry() doesn't find them.
+ *
+ * @return true if it does.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsPathTo
+(
+    const Entry_t* basePtr,     ///< Entry the path is relative to.
+    const char* path,           ///< Path.
+    size_t len,                 ///< Length of the path.
+    Entry_t* entryPtr           ///< Entry the path is expected to lead to.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    while (len > 0)
+    {
+        if ((entryPtr == basePtr) || (entryPtr == NULL) || resTree_IsDeleted(entryPtr))
+        {
+            return false;
+        }
+
+        size_t start = len;
+        while ((start > 0) && (path[start - 1] != '/'))
+        {
+            start--;
+        }
+
+        size_t nameLen = len - start;
+        if (   (nameLen >= HUB_MAX_ENTRY_NAME_BYTES)
+            || (strncmp(entryPtr->name, path + start, nameLen) != 0)
+            || (entryPtr->name[nameLen] != '\0')  )
+        {
+            return false;
+        }
+
+        entryPtr = entryPtr->parentPtr;
+
+        // Step back over the separator, if there is one.
+        len = ((start > 0) ? (start - 1) : 0);
+    }
+
+    return (entryPtr == basePtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Look up a path in the path lookup cache.
+ *
+ * A hit is only possible for a well-formed path, so the path needn't be checked beforehand.
+ *
+ * @return The entry the path leads to, or NULL if not in the cache.
+ */
+//--------------------------------------------------------------------------------------------------
+static Entry_t* FindCachedEntry
+(
+    Entry_t* basePtr,   ///< Entry the path is relative to.
+    const char* path,   ///< Path.
+    uint32_t* hashPtr   ///< [OUT] Hash of the base entry and path, for CacheEntry().
+)
+//--------------------------------------------------------------------------------------------------
+{
+    size_t len;
+    uint32_t hash = HashPath(basePtr, path, &len);
+    const PathCacheSlot_t* slotPtr = &PathCache[hash & (PATH_CACHE_SIZE - 1)];
+
+    *hashPtr = hash;
+
+    if (   (slotPtr->hash == hash)
+        && (slotPtr->basePtr == basePtr)
+        && IsPathTo(basePtr, path, len, slotPtr->entryPtr)  )
+    {
+        return slotPtr->entryPtr;
+    }
+
+    return NULL;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Remember the entry a path was found to lead to in the path lookup cache, replacing whatever
+ * was in its slot.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CacheEntry
+(
+    uint32_t hash,      ///< Hash of the base entry and path, from FindCachedEntry().
+    Entry_t* basePtr,   ///< Entry the path is relative to.
+    Entry_t* entryPtr   ///< Entry the path leads to.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    PathCacheSlot_t* slotPtr = &PathCache[hash & (PATH_CACHE_SIZE - 1)];
+
+    slotPtr->hash = hash;
+    slotPtr->basePtr = basePtr;
+    slotPtr->entryPtr = entryPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Drop any paths to or from a given entry from the path lookup cache.  Must be called when the
+ * entry is deleted and before it is freed, so the cache never refers to an entry that is gone.
+ */
+//--------------------------------------------------------------------------------------------------
+static void UncacheEntry
+(
+    const Entry_t* entryPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    for (size_t i = 0; i < PATH_CACHE_SIZE; i++)
+    {
+        if ((PathCache[i].entryPtr == entryPtr) || (PathCache[i].basePtr == entryPtr))
+        {
+            PathCache[i].basePtr = NULL;
+            PathCache[i].entryPtr = NULL;
+        }
+    }
+}
+
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -66,14 +471,21 @@ static Entry_t* AddChild
 {
     if (entryPtr == NULL)
     {
-        entryPtr = hub_MemAlloc(EntryPool);
+        const char* internedName = strIntern_Get(name);
+
+        entryPtr = ((internedName != NULL) ? hub_MemAlloc(EntryPool) : NULL);
 
         if (entryPtr)
         {
-            LE_ASSERT_OK(le_utf8_Copy(entryPtr->name, name, sizeof(entryPtr->name), NULL));
-
+            entryPtr->name = internedName;
             entryPtr->link = LE_DLS_LINK_INIT;
             entryPtr->childList = LE_DLS_LIST_INIT;
+            entryPtr->nameHash = HashName(entryPtr->name);
+            entryPtr->nextInBucketPtr = NULL;
+            entryPtr->childIndex = NULL;
+            entryPtr->childCount = 0;
+            entryPtr->handleList = LE_DLS_LIST_INIT;
+            entryPtr->childIndexBits = 0;
             entryPtr->type = ADMIN_ENTRY_TYPE_NAMESPACE;
 
             if (parentPtr != NULL)
@@ -86,10 +498,15 @@ static Entry_t* AddChild
                 // Link to the parent entry.
                 entryPtr->parentPtr = parentPtr;
                 le_dls_Queue(&parentPtr->childList, &entryPtr->link);
+                IndexChild(parentPtr, entryPtr);
             }
         }
         else
         {
+            if (internedName != NULL)
+            {
+                strIntern_Release(internedName);
+            }
             LE_ERROR("Failed to allocate memory in AddChild");
         }
     }
@@ -124,11 +541,16 @@ static void EntryDestructor
     LE_ASSERT(entryPtr->parentPtr != NULL);
     LE_ASSERT(le_dls_IsEmpty(&entryPtr->childList));
 
+    UncacheEntry(entryPtr);
+
     // Remove from parent's list of children.
+    UnindexChild(entryPtr->parentPtr, entryPtr);
     le_dls_Remove(&entryPtr->parentPtr->childList, &entryPtr->link);
 
     // Release the reference to the parent.
     le_mem_Release(entryPtr->parentPtr);
+
+    strIntern_Release(entryPtr->name);
 }
 
 
@@ -212,21 +634,43 @@ resTree_EntryRef_t resTree_FindChildEx
                                         ///< return it.
 )
 {
-    le_dls_Link_t* linkPtr = le_dls_Peek(&nsRef->childList);
+    // Names are unique among siblings (including zombies), so there is at most one match.
+    uint32_t hash = HashName(name);
+    Entry_t* childPtr = NULL;
 
-    while (linkPtr != NULL)
+    if (nsRef->childIndex != NULL)
     {
-        Entry_t* childPtr = CONTAINER_OF(linkPtr, Entry_t, link);
+        childPtr = nsRef->childIndex[hash & (((uint32_t)1 << nsRef->childIndexBits) - 1)];
 
-        if (withZombies || !resTree_IsDeleted(childPtr))
+        while (   (childPtr != NULL)
+               && (   (childPtr->nameHash != hash)
+                   || (strcmp(name, childPtr->name) != 0)  )  )
+        {
+            childPtr = childPtr->nextInBucketPtr;
+        }
+    }
+    else
+    {
+        le_dls_Link_t* linkPtr = le_dls_Peek(&nsRef->childList);
+
+        while (linkPtr != NULL)
         {
-            if (strncmp(name, childPtr->name, sizeof(childPtr->name)) == 0)
+            Entry_t* entryPtr = CONTAINER_OF(linkPtr, Entry_t, link);
+
+            if (   (entryPtr->nameHash == hash)
+                && (strcmp(name, entryPtr->name) == 0)  )
             {
-                return childPtr;
+                childPtr = entryPtr;
+                break;
             }
+
+            linkPtr = le_dls_PeekNext(&nsRef->childList, linkPtr);
         }
+    }
 
-        linkPtr = le_dls_PeekNext(&nsRef->childList, linkPtr);
+    if ((childPtr != NULL) && (withZombies || !resTree_IsDeleted(childPtr)))
+    {
+        return childPtr;
     }
 
     return NULL;
@@ -252,7 +696,8 @@ resTree_EntryRef_t resTree_FindChild
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Go to the entry at a given resource path.
+ * Go to the entry at a given resource path.  Paths that were found before are usually found in
+ * the path lookup cache, without walking the tree.
  *
  * Assumes path is valid.
  *
@@ -265,7 +710,15 @@ static resTree_EntryRef_t FindEntry
     const char* path   ///< Path.
 )
 {
-    resTree_EntryRef_t currentEntry = baseNamespace;
+    uint32_t hash;
+    resTree_EntryRef_t currentEntry = FindCachedEntry(baseNamespace, path, &hash);
+
+    if (currentEntry != NULL)
+    {
+        return currentEntry;
+    }
+
+    currentEntry = baseNamespace;
 
     size_t i = 0;   // Index into path.
 
@@ -307,6 +760,8 @@ static resTree_EntryRef_t FindEntry
         i += nameLen;
     }
 
+    CacheEntry(hash, baseNamespace, currentEntry);
+
     return currentEntry;
 }
 
@@ -532,8 +987,12 @@ resTree_EntryRef_t resTree_FindEntry
 )
 //--------------------------------------------------------------------------------------------------
 {
-    resTree_EntryRef_t entryRef = NULL;
-    if (!hub_IsResourcePathMalformed(path))
+    uint32_t hash;
+
+    // Paths in the cache are known to be well-formed, so don't bother checking them.
+    resTree_EntryRef_t entryRef = FindCachedEntry(baseNamespace, path, &hash);
+
+    if ((entryRef == NULL) && !hub_IsResourcePathMalformed(path))
     {
         entryRef = FindEntry(baseNamespace, path);
     }
@@ -583,6 +1042,24 @@ const char* resTree_GetEntryName
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the list of handles client sessions have open to an entry.  Only the Resource Handle module
+ * (resHandle.c) uses this.
+ *
+ * @return Ptr to the list. Only valid while the entry exists.
+ */
+//--------------------------------------------------------------------------------------------------
+le_dls_List_t* resTree_GetHandleList
+(
+    resTree_EntryRef_t entryRef
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return &entryRef->handleList;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Get the type of an entry.
@@ -1226,6 +1703,52 @@ dataSample_Ref_t resTree_GetCurrentValue
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the values held by a resource.  The references filled in are not counted, so they are only
+ * valid until the resource is next changed.
+ *
+ * @return LE_OK if successful, LE_BAD_PARAMETER if the entry is not a resource.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t resTree_GetState
+(
+    resTree_EntryRef_t resRef,
+    res_State_t* statePtr   ///< [OUT] The values.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (!resTree_IsResource(resRef))
+    {
+        return LE_BAD_PARAMETER;
+    }
+
+    res_GetState(resRef->u.resourcePtr, statePtr);
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Put back values held by a resource before the Data Hub restarted, without passing them on to
+ * routes, handlers or buffers.
+ *
+ * @note Takes ownership of the data sample references in the state.
+ */
+//--------------------------------------------------------------------------------------------------
+void resTree_RestoreState
+(
+    resTree_EntryRef_t resRef,
+    const res_State_t* statePtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LE_ASSERT(resTree_IsResource(resRef));
+
+    res_RestoreState(resRef->u.resourcePtr, statePtr);
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Creates a data flow route from one resource to another by setting the data source for the
@@ -1290,6 +1813,9 @@ void resTree_DeleteIO
 {
     res_Resource_t* ioPtr = entryRef->u.resourcePtr;
 
+    // Clients' handles to the resource don't carry over to anything created in its place.
+    resHandle_DropAll(entryRef);
+
     // Call handlers before we release the Resource memory, or re-assign it to
     // become a placeholder. Replacing with a placeholder is still considered a "remove"
     // operation; the placeholder merely preserves any admin settings until the Resource
@@ -1333,6 +1859,8 @@ void resTree_DeleteObservation
 )
 //--------------------------------------------------------------------------------------------------
 {
+    resHandle_DropAll(obsEntry);
+
     CallResourceTreeChangeHandlers(obsEntry, ADMIN_ENTRY_TYPE_OBSERVATION, ADMIN_RESOURCE_REMOVED);
 
     // Delete the Observation resource object.
@@ -1392,177 +1920,340 @@ double resTree_GetMinPeriod
  * Ignored for all non-numeric types except Boolean for which non-zero = true and zero = false.
  */
 //--------------------------------------------------------------------------------------------------
-void resTree_SetHighLimit
+void resTree_SetHighLimit
+(
+    resTree_EntryRef_t obsEntry,
+    double highLimit
+)
+//--------------------------------------------------------------------------------------------------
+{
+    res_SetHighLimit(obsEntry->u.resourcePtr, highLimit);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the highest value in a range that will be accepted by a given Observation.
+ *
+ * @return The value, or NAN (not a number) if not set.
+ */
+//--------------------------------------------------------------------------------------------------
+double resTree_GetHighLimit
+(
+    resTree_EntryRef_t obsEntry
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return res_GetHighLimit(obsEntry->u.resourcePtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the lowest value in a range that will be accepted by a given Observation.
+ *
+ * Ignored for all non-numeric types except Boolean for which non-zero = true and zero = false.
+ */
+//--------------------------------------------------------------------------------------------------
+void resTree_SetLowLimit
+(
+    resTree_EntryRef_t obsEntry,
+    double lowLimit
+)
+//--------------------------------------------------------------------------------------------------
+{
+    res_SetLowLimit(obsEntry->u.resourcePtr, lowLimit);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the lowest value in a range that will be accepted by a given Observation.
+ *
+ * @return The value, or NAN (not a number) if not set.
+ */
+//--------------------------------------------------------------------------------------------------
+double resTree_GetLowLimit
+(
+    resTree_EntryRef_t obsEntry
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return res_GetLowLimit(obsEntry->u.resourcePtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the magnitude that a new value must vary from the current value to be accepted by
+ * a given Observation.
+ *
+ * Ignored for trigger types.
+ *
+ * For all other types, any non-zero value means accept any change, but drop if the same as current.
+ */
+//--------------------------------------------------------------------------------------------------
+void resTree_SetChangeBy
+(
+    resTree_EntryRef_t obsEntry,
+    double change
+)
+//--------------------------------------------------------------------------------------------------
+{
+    res_SetChangeBy(obsEntry->u.resourcePtr, change);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the magnitude that a new value must vary from the current value to be accepted by
+ * a given Observation.
+ *
+ * @return The value, or 0 if not set.
+ */
+//--------------------------------------------------------------------------------------------------
+double resTree_GetChangeBy
+(
+    resTree_EntryRef_t obsEntry
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return res_GetChangeBy(obsEntry->u.resourcePtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Perform a transform on buffered data. Value of the observation will be the output of the
+ * transform
+ *
+ * Ignored for all non-numeric types except Boolean for which non-zero = true and zero = false.
+ */
+//--------------------------------------------------------------------------------------------------
+void resTree_SetTransform
+(
+    resTree_EntryRef_t obsEntry,
+    admin_TransformType_t transformType,
+    const double* paramsPtr,
+    size_t paramsSize
+)
+//--------------------------------------------------------------------------------------------------
+{
+    res_SetTransform(obsEntry->u.resourcePtr, transformType, paramsPtr, paramsSize);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the type of transform currently applied to an Observation.
+ *
+ * @return The TransformType
+ */
+//--------------------------------------------------------------------------------------------------
+admin_TransformType_t resTree_GetTransform
+(
+    resTree_EntryRef_t obsEntry
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return res_GetTransform(obsEntry->u.resourcePtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the maximum number of data samples to buffer in a given Observation.  Buffers are FIFO
+ * circular buffers. When full, the buffer drops the oldest value to make room for a new addition.
+ */
+//--------------------------------------------------------------------------------------------------
+void resTree_SetBufferMaxCount
 (
     resTree_EntryRef_t obsEntry,
-    double highLimit
+    uint32_t count
 )
 //--------------------------------------------------------------------------------------------------
 {
-    res_SetHighLimit(obsEntry->u.resourcePtr, highLimit);
+    res_SetBufferMaxCount(obsEntry->u.resourcePtr, count);
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Get the highest value in a range that will be accepted by a given Observation.
+ * Get the buffer size setting for a given Observation.
  *
- * @return The value, or NAN (not a number) if not set.
+ * @return The buffer size (in number of samples) or 0 if not set.
  */
 //--------------------------------------------------------------------------------------------------
-double resTree_GetHighLimit
+uint32_t resTree_GetBufferMaxCount
 (
     resTree_EntryRef_t obsEntry
 )
 //--------------------------------------------------------------------------------------------------
 {
-    return res_GetHighLimit(obsEntry->u.resourcePtr);
+    return res_GetBufferMaxCount(obsEntry->u.resourcePtr);
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Set the lowest value in a range that will be accepted by a given Observation.
- *
- * Ignored for all non-numeric types except Boolean for which non-zero = true and zero = false.
+ * Set the maximum age of the data samples buffered in a given Observation.  Samples timestamped
+ * longer ago than this are dropped from the buffer, as well as any dropped to respect its maximum
+ * count.
  */
 //--------------------------------------------------------------------------------------------------
-void resTree_SetLowLimit
+void resTree_SetBufferMaxAge
 (
     resTree_EntryRef_t obsEntry,
-    double lowLimit
+    double seconds  ///< Maximum age (NAN or 0 = no limit).
 )
 //--------------------------------------------------------------------------------------------------
 {
-    res_SetLowLimit(obsEntry->u.resourcePtr, lowLimit);
+    res_SetBufferMaxAge(obsEntry->u.resourcePtr, seconds);
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Get the lowest value in a range that will be accepted by a given Observation.
+ * Get the maximum age of the data samples buffered in a given Observation.
  *
- * @return The value, or NAN (not a number) if not set.
+ * @return The maximum age (in seconds) or NAN if not set.
  */
 //--------------------------------------------------------------------------------------------------
-double resTree_GetLowLimit
+double resTree_GetBufferMaxAge
 (
     resTree_EntryRef_t obsEntry
 )
 //--------------------------------------------------------------------------------------------------
 {
-    return res_GetLowLimit(obsEntry->u.resourcePtr);
+    return res_GetBufferMaxAge(obsEntry->u.resourcePtr);
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Set the magnitude that a new value must vary from the current value to be accepted by
- * a given Observation.
- *
- * Ignored for trigger types.
- *
- * For all other types, any non-zero value means accept any change, but drop if the same as current.
+ * Set the maximum number of bytes of memory that the data samples buffered in a given Observation
+ * can use.  This counts all the memory allocated for the buffer: the ring of samples (including
+ * any slots not yet filled), its statistics index, the compressed blocks, and the contents of
+ * strings.  When the limit is exceeded, the oldest samples are dropped (shrinking the ring) until
+ * it isn't, as well as any dropped to respect the maximum count.
  */
 //--------------------------------------------------------------------------------------------------
-void resTree_SetChangeBy
+void resTree_SetBufferMaxBytes
 (
     resTree_EntryRef_t obsEntry,
-    double change
+    uint32_t bytes  ///< Maximum number of bytes (0 = no limit).
 )
 //--------------------------------------------------------------------------------------------------
 {
-    res_SetChangeBy(obsEntry->u.resourcePtr, change);
+    res_SetBufferMaxBytes(obsEntry->u.resourcePtr, bytes);
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Get the magnitude that a new value must vary from the current value to be accepted by
- * a given Observation.
+ * Get the maximum number of bytes of memory that the data samples buffered in a given Observation
+ * can use.
  *
- * @return The value, or 0 if not set.
+ * @return The maximum number of bytes or 0 if not set.
  */
 //--------------------------------------------------------------------------------------------------
-double resTree_GetChangeBy
+uint32_t resTree_GetBufferMaxBytes
 (
     resTree_EntryRef_t obsEntry
 )
 //--------------------------------------------------------------------------------------------------
 {
-    return res_GetChangeBy(obsEntry->u.resourcePtr);
+    return res_GetBufferMaxBytes(obsEntry->u.resourcePtr);
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Perform a transform on buffered data. Value of the observation will be the output of the
- * transform
- *
- * Ignored for all non-numeric types except Boolean for which non-zero = true and zero = false.
+ * Set the priority of the data samples buffered in a given Observation.  When the samples buffered
+ * in all Observations use more memory than the hub's buffer memory budget, samples are evicted
+ * from the lowest priority buffers first.
  */
 //--------------------------------------------------------------------------------------------------
-void resTree_SetTransform
+void resTree_SetBufferPriority
 (
     resTree_EntryRef_t obsEntry,
-    admin_TransformType_t transformType,
-    const double* paramsPtr,
-    size_t paramsSize
+    int32_t priority ///< Higher = samples kept longer (default 0).
 )
 //--------------------------------------------------------------------------------------------------
 {
-    res_SetTransform(obsEntry->u.resourcePtr, transformType, paramsPtr, paramsSize);
+    res_SetBufferPriority(obsEntry->u.resourcePtr, priority);
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Get the type of transform currently applied to an Observation.
+ * Get the priority of the data samples buffered in a given Observation.
  *
- * @return The TransformType
+ * @return The priority.
  */
 //--------------------------------------------------------------------------------------------------
-admin_TransformType_t resTree_GetTransform
+int32_t resTree_GetBufferPriority
 (
     resTree_EntryRef_t obsEntry
 )
 //--------------------------------------------------------------------------------------------------
 {
-    return res_GetTransform(obsEntry->u.resourcePtr);
+    return res_GetBufferPriority(obsEntry->u.resourcePtr);
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Set the maximum number of data samples to buffer in a given Observation.  Buffers are FIFO
- * circular buffers. When full, the buffer drops the oldest value to make room for a new addition.
+ * Enable or disable compression of the numeric and Boolean data samples buffered in a given
+ * Observation.  Compressed samples take much less memory, but are slower to read at random.
+ * Samples already in the buffer are compressed (or decompressed) right away.
  */
 //--------------------------------------------------------------------------------------------------
-void resTree_SetBufferMaxCount
+void resTree_SetBufferCompression
 (
     resTree_EntryRef_t obsEntry,
-    uint32_t count
+    bool compress   ///< true = compress numerical samples (default false).
 )
 //--------------------------------------------------------------------------------------------------
 {
-    res_SetBufferMaxCount(obsEntry->u.resourcePtr, count);
+    res_SetBufferCompression(obsEntry->u.resourcePtr, compress);
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Get the buffer size setting for a given Observation.
+ * Check whether compression of the numerical data samples buffered in a given Observation is
+ * enabled.
  *
- * @return The buffer size (in number of samples) or 0 if not set.
+ * @return true if enabled.
  */
 //--------------------------------------------------------------------------------------------------
-uint32_t resTree_GetBufferMaxCount
+bool resTree_GetBufferCompression
 (
     resTree_EntryRef_t obsEntry
 )
 //--------------------------------------------------------------------------------------------------
 {
-    return res_GetBufferMaxCount(obsEntry->u.resourcePtr);
+    return res_GetBufferCompression(obsEntry->u.resourcePtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of bytes of memory allocated for the samples buffered in a given Observation, and
+ * the number of samples that have been evicted from its buffer to stay within the hub's buffer
+ * memory budget.
+ */
+//--------------------------------------------------------------------------------------------------
+void resTree_GetBufferMemoryUsage
+(
+    resTree_EntryRef_t obsEntry,
+    uint64_t* bytesPtr, ///< [OUT] Bytes allocated for the buffer.
+    uint64_t* evictionCountPtr ///< [OUT] Samples evicted to stay within the budget.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    res_GetBufferMemoryUsage(obsEntry->u.resourcePtr, bytesPtr, evictionCountPtr);
 }
 
 
@@ -1604,6 +2295,41 @@ uint32_t resTree_GetBufferBackupPeriod
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set whether an Observation's buffer is backed up by appending the samples added since the
+ * previous backup to a log, rather than by rewriting the whole buffer to its backup file.
+ * The log is compacted every so often, by writing the whole buffer again.
+ */
+//--------------------------------------------------------------------------------------------------
+void resTree_SetBufferBackupLog
+(
+    resTree_EntryRef_t obsEntry,
+    bool useLog  ///< true = append to a log, false = rewrite the backup file (default).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    res_SetBufferBackupLog(obsEntry->u.resourcePtr, useLog);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether an Observation's buffer is backed up by appending to a log.
+ *
+ * @return true if backed up to a log.
+ */
+//--------------------------------------------------------------------------------------------------
+bool resTree_GetBufferBackupLog
+(
+    resTree_EntryRef_t obsEntry
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return res_GetBufferBackupLog(obsEntry->u.resourcePtr);
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Mark an Output resource "optional".  (By default, they are marked "mandatory".)
@@ -2002,6 +2728,8 @@ void resTree_SetDeleted
     LE_ASSERT((resEntry->u.flags & RES_FLAG_NEW) == 0);
 
     resEntry->u.flags |= RES_FLAG_DELETED;
+
+    UncacheEntry(resEntry);
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -2140,12 +2868,153 @@ void resTree_ReadBufferJson
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read data out of a buffer in binary form.  A two-byte header (format version 0 and data type
+ * code) is written to a given file descriptor, followed by one packed record per sample, in the
+ * layout used by backup files, until end of file.  See obs_ReadBufferBinary() for details.
+ */
+//--------------------------------------------------------------------------------------------------
+void resTree_ReadBufferBinary
+(
+    resTree_EntryRef_t obsEntry, ///< Observation entry.
+    double startAfter,  ///< Start after this many seconds ago, or after an absolute number of
+                        ///< seconds since the Epoch (if startafter > 30 years).
+                        ///< Use NAN (not a number) to read the whole buffer.
+    int outputFile, ///< File descriptor to write the data to.
+    query_ReadCompletionFunc_t handlerPtr, ///< Completion callback.
+    void* contextPtr    ///< Value to be passed to completion callback.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LE_ASSERT(obsEntry->type == ADMIN_ENTRY_TYPE_OBSERVATION);
+    LE_ASSERT(obsEntry->u.resourcePtr != NULL);
+
+    res_ReadBufferBinary(obsEntry->u.resourcePtr, startAfter, outputFile, handlerPtr, contextPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Export a read-only copy of the data in a buffer through a sealed shared memory file, which the
+ * caller can mmap() instead of having the samples streamed to it.  See obs_ExportBuffer() for
+ * the layout.
+ *
+ * @return
+ *  - LE_OK if successful (the caller must close the file descriptor).
+ *  - LE_UNSUPPORTED if the buffer holds strings or JSON, or shared memory is not available.
+ *  - LE_FAULT if the shared memory file could not be created.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t resTree_ExportBuffer
+(
+    resTree_EntryRef_t obsEntry, ///< Observation entry.
+    double startAfter,  ///< Start after this many seconds ago, or after an absolute number of
+                        ///< seconds since the Epoch (if startafter > 30 years).
+                        ///< Use NAN (not a number) to export the whole buffer.
+    int* fdPtr  ///< [OUT] File descriptor of the shared memory file.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LE_ASSERT(obsEntry->type == ADMIN_ENTRY_TYPE_OBSERVATION);
+    LE_ASSERT(obsEntry->u.resourcePtr != NULL);
+
+    return res_ExportBuffer(obsEntry->u.resourcePtr, startAfter, fdPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append a copy of an Observation's whole data buffer to an image, in the backup file format.
+ * If the buffer hasn't changed since its copy was appended to the image before (the last one
+ * stored in the State Segment), that copy is reused.
+ *
+ * @return true if successful, false if out of memory.
+ */
+//--------------------------------------------------------------------------------------------------
+bool resTree_AppendBufferToImage
+(
+    resTree_EntryRef_t obsEntry, ///< Observation entry.
+    backupWriter_ImageRef_t imageRef,
+    uint32_t imageNumber,           ///< Number of the image (one more than the image before).
+    const uint8_t* lastImagePtr     ///< The image before, or NULL if it isn't available.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LE_ASSERT(obsEntry->type == ADMIN_ENTRY_TYPE_OBSERVATION);
+    LE_ASSERT(obsEntry->u.resourcePtr != NULL);
+
+    return res_AppendBufferToImage(obsEntry->u.resourcePtr, imageRef, imageNumber, lastImagePtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Replace an Observation's data buffer with a copy in memory (see resTree_AppendBufferToImage()).
+ * None of the samples are pushed to the Observation, so its current value is left as it is.
+ */
+//--------------------------------------------------------------------------------------------------
+void resTree_RestoreBufferFromImage
+(
+    resTree_EntryRef_t obsEntry, ///< Observation entry.
+    const uint8_t* imagePtr,
+    size_t imageSize,
+    const char* name        ///< Name of the copy, for log messages.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LE_ASSERT(obsEntry->type == ADMIN_ENTRY_TYPE_OBSERVATION);
+    LE_ASSERT(obsEntry->u.resourcePtr != NULL);
+
+    res_RestoreBufferFromImage(obsEntry->u.resourcePtr, imagePtr, imageSize, name);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read a downsampled view of the data in a buffer.  At most a given number of samples, chosen to
+ * preserve the shape of the data when plotted, are written to a given file descriptor in the same
+ * JSON format as resTree_ReadBufferJson().
+ *
+ * @return
+ *  - LE_OK if the read operation started (the completion callback will be called).
+ *  - LE_UNSUPPORTED if the buffer holds data of a non-numerical type.
+ *  - LE_BAD_PARAMETER if maxPoints is too small for the downsampling method.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t resTree_ReadBufferDownsampledJson
+(
+    resTree_EntryRef_t obsEntry, ///< Observation entry.
+    double startAfter,  ///< Start after this many seconds ago, or after an absolute number of
+                        ///< seconds since the Epoch (if startafter > 30 years).
+                        ///< Use NAN (not a number) to read the whole buffer.
+    uint32_t maxPoints, ///< Maximum number of samples to read.
+    query_DownsampleMethod_t method, ///< How to choose the samples.
+    int outputFile, ///< File descriptor to write the data to.
+    query_ReadCompletionFunc_t handlerPtr, ///< Completion callback.
+    void* contextPtr    ///< Value to be passed to completion callback.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LE_ASSERT(obsEntry->type == ADMIN_ENTRY_TYPE_OBSERVATION);
+    LE_ASSERT(obsEntry->u.resourcePtr != NULL);
+
+    return res_ReadBufferDownsampledJson(obsEntry->u.resourcePtr,
+                                         startAfter,
+                                         maxPoints,
+                                         method,
+                                         outputFile,
+                                         handlerPtr,
+                                         contextPtr);
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Find the oldest data sample held in a given Observation's buffer that is newer than a
  * given timestamp.
  *
- * @return Reference to the sample, or NULL if not found.
+ * @return Reference to a copy of the sample (which the caller must release), or NULL if not found.
  */
 //--------------------------------------------------------------------------------------------------
 dataSample_Ref_t resTree_FindBufferedSampleAfter
@@ -2305,7 +3174,9 @@ const char* resTree_GetJsonExtraction
 double resTree_QueryMin
 (
     resTree_EntryRef_t obsEntry,    ///< Observation entry.
-    double startTime    ///< If < 30 years then seconds before now; else seconds since the Epoch.
+    double startTime,   ///< If < 30 years then seconds before now; else seconds since the Epoch.
+    double endTime      ///< If < 30 years then seconds before now; else seconds since the Epoch.
+                        ///< NAN = up to the newest sample.
 )
 //--------------------------------------------------------------------------------------------------
 {
@@ -2315,7 +3186,7 @@ double resTree_QueryMin
     }
 
     LE_ASSERT(obsEntry->u.resourcePtr != NULL);
-    return res_QueryMin(obsEntry->u.resourcePtr, startTime);
+    return res_QueryMin(obsEntry->u.resourcePtr, startTime, endTime);
 }
 
 
@@ -2331,7 +3202,9 @@ double resTree_QueryMin
 double resTree_QueryMax
 (
     resTree_EntryRef_t obsEntry,    ///< Observation entry.
-    double startTime    ///< If < 30 years then seconds before now; else seconds since the Epoch.
+    double startTime,   ///< If < 30 years then seconds before now; else seconds since the Epoch.
+    double endTime      ///< If < 30 years then seconds before now; else seconds since the Epoch.
+                        ///< NAN = up to the newest sample.
 )
 //--------------------------------------------------------------------------------------------------
 {
@@ -2341,7 +3214,7 @@ double resTree_QueryMax
     }
 
     LE_ASSERT(obsEntry->u.resourcePtr != NULL);
-    return res_QueryMax(obsEntry->u.resourcePtr, startTime);
+    return res_QueryMax(obsEntry->u.resourcePtr, startTime, endTime);
 }
 
 
@@ -2357,7 +3230,9 @@ double resTree_QueryMax
 double resTree_QueryMean
 (
     resTree_EntryRef_t obsEntry,    ///< Observation entry.
-    double startTime    ///< If < 30 years then seconds before now; else seconds since the Epoch.
+    double startTime,   ///< If < 30 years then seconds before now; else seconds since the Epoch.
+    double endTime      ///< If < 30 years then seconds before now; else seconds since the Epoch.
+                        ///< NAN = up to the newest sample.
 )
 //--------------------------------------------------------------------------------------------------
 {
@@ -2367,7 +3242,7 @@ double resTree_QueryMean
     }
 
     LE_ASSERT(obsEntry->u.resourcePtr != NULL);
-    return res_QueryMean(obsEntry->u.resourcePtr, startTime);
+    return res_QueryMean(obsEntry->u.resourcePtr, startTime, endTime);
 }
 
 
@@ -2384,7 +3259,9 @@ double resTree_QueryMean
 double resTree_QueryStdDev
 (
     resTree_EntryRef_t obsEntry,    ///< Observation entry.
-    double startTime    ///< If < 30 years then seconds before now; else seconds since the Epoch.
+    double startTime,   ///< If < 30 years then seconds before now; else seconds since the Epoch.
+    double endTime      ///< If < 30 years then seconds before now; else seconds since the Epoch.
+                        ///< NAN = up to the newest sample.
 )
 //--------------------------------------------------------------------------------------------------
 {
@@ -2394,7 +3271,92 @@ double resTree_QueryStdDev
     }
 
     LE_ASSERT(obsEntry->u.resourcePtr != NULL);
-    return res_QueryStdDev(obsEntry->u.resourcePtr, startTime);
+    return res_QueryStdDev(obsEntry->u.resourcePtr, startTime, endTime);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the count, minimum, maximum, mean and standard deviation of the numerical values found
+ * within a given time span in an Observation's buffer, along with the timestamps of the oldest and
+ * newest samples in the time span, all at once.
+ *
+ * The statistics are NAN (and the count is 0) if there's no numerical data in the time span.
+ * The timestamps are NAN if there are no samples in the time span.
+ *
+ * @return
+ *  - LE_OK if successful.
+ *  - LE_NOT_FOUND if the entry is not an Observation.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t resTree_QueryStats
+(
+    resTree_EntryRef_t obsEntry,    ///< Observation entry.
+    double startTime,   ///< If < 30 years then seconds before now; else seconds since the Epoch.
+                        ///< NAN = from the oldest sample.
+    double endTime,     ///< If < 30 years then seconds before now; else seconds since the Epoch.
+                        ///< NAN = up to the newest sample.
+    hub_BufferStats_t* statsPtr ///< [OUT] Statistics.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (obsEntry->type != ADMIN_ENTRY_TYPE_OBSERVATION)
+    {
+        return LE_NOT_FOUND;
+    }
+
+    LE_ASSERT(obsEntry->u.resourcePtr != NULL);
+    res_QueryStats(obsEntry->u.resourcePtr, startTime, endTime, statsPtr);
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Divide a time span of an Observation's buffer into buckets of a given width and compute an
+ * aggregate of the samples in each bucket.
+ *
+ * The first bucket starts at the start time, and the last one ends at the end time (inclusive).
+ * Buckets that hold no samples get NAN (or 0 for QUERY_AGGREGATE_TYPE_COUNT).
+ *
+ * @return
+ *  - LE_OK if successful.
+ *  - LE_NOT_FOUND if the entry is not an Observation or there are no samples in the time span.
+ *  - LE_UNSUPPORTED if the aggregate type needs numerical data and the buffer holds another type.
+ *  - LE_BAD_PARAMETER if the bucket width isn't positive or the time span ends before it starts.
+ *  - LE_OVERFLOW if the time span holds more buckets than fit in the values array (the array is
+ *                filled with the first buckets' values).
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t resTree_QueryBuckets
+(
+    resTree_EntryRef_t obsEntry,    ///< Observation entry.
+    double startTime,   ///< If < 30 years then seconds before now; else seconds since the Epoch.
+                        ///< NAN = from the oldest sample.
+    double endTime,     ///< If < 30 years then seconds before now; else seconds since the Epoch.
+                        ///< NAN = up to the newest sample.
+    double bucketWidth, ///< Width of each bucket (seconds).
+    query_AggregateType_t aggregateType, ///< Aggregate to compute over each bucket's samples.
+    double* valuesPtr,  ///< [OUT] Array to put the value of each bucket in.
+    size_t* numBucketsPtr   ///< [IN/OUT] Size of the values array / number of buckets filled.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (obsEntry->type != ADMIN_ENTRY_TYPE_OBSERVATION)
+    {
+        *numBucketsPtr = 0;
+        return LE_NOT_FOUND;
+    }
+
+    LE_ASSERT(obsEntry->u.resourcePtr != NULL);
+    return res_QueryBuckets(obsEntry->u.resourcePtr,
+                            startTime,
+                            endTime,
+                            bucketWidth,
+                            aggregateType,
+                            valuesPtr,
+                            numBucketsPtr);
 }
 
 
@@ -2469,3 +3431,25 @@ void resTree_SetDestination
     LE_ASSERT(obsEntry->u.resourcePtr != NULL);
     res_SetDestination(obsEntry->u.resourcePtr, destination);
 }
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the destination string of a given Observation.
+ *
+ * @return Ptr to the destination string.  "" if not set or not an Observation.
+ */
+//--------------------------------------------------------------------------------------------------
+const char* resTree_GetDestination
+(
+    resTree_EntryRef_t obsEntry   ///< Observation entry
+)
+{
+    if (obsEntry->type != ADMIN_ENTRY_TYPE_OBSERVATION)
+    {
+        return "";
+    }
+
+    LE_ASSERT(obsEntry->u.resourcePtr != NULL);
+    return res_GetDestination(obsEntry->u.resourcePtr);
+}
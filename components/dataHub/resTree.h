@@ -26,6 +26,7 @@
 #define NAMESPACE_H_INCLUDE_GUARD
 
 
+#include "backupWriter.h"
 #include "resource.h"
 
 //--------------------------------------------------------------------------------------------------
@@ -144,6 +145,20 @@ LE_SHARED const char *resTree_GetEntryName
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the list of handles client sessions have open to an entry.  Only the Resource Handle module
+ * (resHandle.c) uses this.
+ *
+ * @return Ptr to the list. Only valid while the entry exists.
+ */
+//--------------------------------------------------------------------------------------------------
+le_dls_List_t* resTree_GetHandleList
+(
+    resTree_EntryRef_t entryRef
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Get the type of an entry.
@@ -453,6 +468,36 @@ LE_SHARED dataSample_Ref_t resTree_GetCurrentValue
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the values held by a resource.  The references filled in are not counted, so they are only
+ * valid until the resource is next changed.
+ *
+ * @return LE_OK if successful, LE_BAD_PARAMETER if the entry is not a resource.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t resTree_GetState
+(
+    resTree_EntryRef_t resRef,
+    res_State_t* statePtr   ///< [OUT] The values.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Put back values held by a resource before the Data Hub restarted, without passing them on to
+ * routes, handlers or buffers.
+ *
+ * @note Takes ownership of the data sample references in the state.
+ */
+//--------------------------------------------------------------------------------------------------
+void resTree_RestoreState
+(
+    resTree_EntryRef_t resRef,
+    const res_State_t* statePtr
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Creates a data flow route from one resource to another by setting the data source for the
@@ -683,6 +728,133 @@ uint32_t resTree_GetBufferMaxCount
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the maximum age of the data samples buffered in a given Observation.  Samples timestamped
+ * longer ago than this are dropped from the buffer, as well as any dropped to respect its maximum
+ * count.
+ */
+//--------------------------------------------------------------------------------------------------
+void resTree_SetBufferMaxAge
+(
+    resTree_EntryRef_t obsEntry,
+    double seconds  ///< Maximum age (NAN or 0 = no limit).
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the maximum age of the data samples buffered in a given Observation.
+ *
+ * @return The maximum age (in seconds) or NAN if not set.
+ */
+//--------------------------------------------------------------------------------------------------
+double resTree_GetBufferMaxAge
+(
+    resTree_EntryRef_t obsEntry
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the maximum number of bytes of memory that the data samples buffered in a given Observation
+ * can use.  This counts all the memory allocated for the buffer: the ring of samples (including
+ * any slots not yet filled), its statistics index, the compressed blocks, and the contents of
+ * strings.  When the limit is exceeded, the oldest samples are dropped (shrinking the ring) until
+ * it isn't, as well as any dropped to respect the maximum count.
+ */
+//--------------------------------------------------------------------------------------------------
+void resTree_SetBufferMaxBytes
+(
+    resTree_EntryRef_t obsEntry,
+    uint32_t bytes  ///< Maximum number of bytes (0 = no limit).
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the maximum number of bytes of memory that the data samples buffered in a given Observation
+ * can use.
+ *
+ * @return The maximum number of bytes or 0 if not set.
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t resTree_GetBufferMaxBytes
+(
+    resTree_EntryRef_t obsEntry
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the priority of the data samples buffered in a given Observation.  When the samples buffered
+ * in all Observations use more memory than the hub's buffer memory budget, samples are evicted
+ * from the lowest priority buffers first.
+ */
+//--------------------------------------------------------------------------------------------------
+void resTree_SetBufferPriority
+(
+    resTree_EntryRef_t obsEntry,
+    int32_t priority ///< Higher = samples kept longer (default 0).
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the priority of the data samples buffered in a given Observation.
+ *
+ * @return The priority.
+ */
+//--------------------------------------------------------------------------------------------------
+int32_t resTree_GetBufferPriority
+(
+    resTree_EntryRef_t obsEntry
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Enable or disable compression of the numeric and Boolean data samples buffered in a given
+ * Observation.  Compressed samples take much less memory, but are slower to read at random.
+ * Samples already in the buffer are compressed (or decompressed) right away.
+ */
+//--------------------------------------------------------------------------------------------------
+void resTree_SetBufferCompression
+(
+    resTree_EntryRef_t obsEntry,
+    bool compress   ///< true = compress numerical samples (default false).
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether compression of the numerical data samples buffered in a given Observation is
+ * enabled.
+ *
+ * @return true if enabled.
+ */
+//--------------------------------------------------------------------------------------------------
+bool resTree_GetBufferCompression
+(
+    resTree_EntryRef_t obsEntry
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of bytes of memory allocated for the samples buffered in a given Observation, and
+ * the number of samples that have been evicted from its buffer to stay within the hub's buffer
+ * memory budget.
+ */
+//--------------------------------------------------------------------------------------------------
+void resTree_GetBufferMemoryUsage
+(
+    resTree_EntryRef_t obsEntry,
+    uint64_t* bytesPtr, ///< [OUT] Bytes allocated for the buffer.
+    uint64_t* evictionCountPtr ///< [OUT] Samples evicted to stay within the budget.
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Set the minimum time between backups of an Observation's buffer to non-volatile storage.
@@ -713,6 +885,33 @@ uint32_t resTree_GetBufferBackupPeriod
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set whether an Observation's buffer is backed up by appending the samples added since the
+ * previous backup to a log, rather than by rewriting the whole buffer to its backup file.
+ * The log is compacted every so often, by writing the whole buffer again.
+ */
+//--------------------------------------------------------------------------------------------------
+void resTree_SetBufferBackupLog
+(
+    resTree_EntryRef_t obsEntry,
+    bool useLog  ///< true = append to a log, false = rewrite the backup file (default).
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether an Observation's buffer is backed up by appending to a log.
+ *
+ * @return true if backed up to a log.
+ */
+//--------------------------------------------------------------------------------------------------
+bool resTree_GetBufferBackupLog
+(
+    resTree_EntryRef_t obsEntry
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Mark an Output resource "optional".  (By default, they are marked "mandatory".)
@@ -1039,12 +1238,112 @@ void resTree_ReadBufferJson
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read data out of a buffer in binary form.  A two-byte header (format version 0 and data type
+ * code) is written to a given file descriptor, followed by one packed record per sample, in the
+ * layout used by backup files, until end of file.  See obs_ReadBufferBinary() for details.
+ */
+//--------------------------------------------------------------------------------------------------
+void resTree_ReadBufferBinary
+(
+    resTree_EntryRef_t obsEntry, ///< Observation entry.
+    double startAfter,  ///< Start after this many seconds ago, or after an absolute number of
+                        ///< seconds since the Epoch (if startafter > 30 years).
+                        ///< Use NAN (not a number) to read the whole buffer.
+    int outputFile, ///< File descriptor to write the data to.
+    query_ReadCompletionFunc_t handlerPtr, ///< Completion callback.
+    void* contextPtr    ///< Value to be passed to completion callback.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Export a read-only copy of the data in a buffer through a sealed shared memory file, which the
+ * caller can mmap() instead of having the samples streamed to it.  See obs_ExportBuffer() for
+ * the layout.
+ *
+ * @return
+ *  - LE_OK if successful (the caller must close the file descriptor).
+ *  - LE_UNSUPPORTED if the buffer holds strings or JSON, or shared memory is not available.
+ *  - LE_FAULT if the shared memory file could not be created.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t resTree_ExportBuffer
+(
+    resTree_EntryRef_t obsEntry, ///< Observation entry.
+    double startAfter,  ///< Start after this many seconds ago, or after an absolute number of
+                        ///< seconds since the Epoch (if startafter > 30 years).
+                        ///< Use NAN (not a number) to export the whole buffer.
+    int* fdPtr  ///< [OUT] File descriptor of the shared memory file.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append a copy of an Observation's whole data buffer to an image, in the backup file format.
+ * If the buffer hasn't changed since its copy was appended to the image before (the last one
+ * stored in the State Segment), that copy is reused.
+ *
+ * @return true if successful, false if out of memory.
+ */
+//--------------------------------------------------------------------------------------------------
+bool resTree_AppendBufferToImage
+(
+    resTree_EntryRef_t obsEntry, ///< Observation entry.
+    backupWriter_ImageRef_t imageRef,
+    uint32_t imageNumber,           ///< Number of the image (one more than the image before).
+    const uint8_t* lastImagePtr     ///< The image before, or NULL if it isn't available.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Replace an Observation's data buffer with a copy in memory (see resTree_AppendBufferToImage()).
+ * None of the samples are pushed to the Observation, so its current value is left as it is.
+ */
+//--------------------------------------------------------------------------------------------------
+void resTree_RestoreBufferFromImage
+(
+    resTree_EntryRef_t obsEntry, ///< Observation entry.
+    const uint8_t* imagePtr,
+    size_t imageSize,
+    const char* name        ///< Name of the copy, for log messages.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read a downsampled view of the data in a buffer.  At most a given number of samples, chosen to
+ * preserve the shape of the data when plotted, are written to a given file descriptor in the same
+ * JSON format as resTree_ReadBufferJson().
+ *
+ * @return
+ *  - LE_OK if the read operation started (the completion callback will be called).
+ *  - LE_UNSUPPORTED if the buffer holds data of a non-numerical type.
+ *  - LE_BAD_PARAMETER if maxPoints is too small for the downsampling method.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t resTree_ReadBufferDownsampledJson
+(
+    resTree_EntryRef_t obsEntry, ///< Observation entry.
+    double startAfter,  ///< Start after this many seconds ago, or after an absolute number of
+                        ///< seconds since the Epoch (if startafter > 30 years).
+                        ///< Use NAN (not a number) to read the whole buffer.
+    uint32_t maxPoints, ///< Maximum number of samples to read.
+    query_DownsampleMethod_t method, ///< How to choose the samples.
+    int outputFile, ///< File descriptor to write the data to.
+    query_ReadCompletionFunc_t handlerPtr, ///< Completion callback.
+    void* contextPtr    ///< Value to be passed to completion callback.
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Find the oldest data sample held in a given Observation's buffer that is newer than a
  * given timestamp.
  *
- * @return Reference to the sample, or NULL if not found.
+ * @return Reference to a copy of the sample (which the caller must release), or NULL if not found.
  */
 //--------------------------------------------------------------------------------------------------
 dataSample_Ref_t resTree_FindBufferedSampleAfter
@@ -1147,7 +1446,9 @@ const char* resTree_GetJsonExtraction
 double resTree_QueryMin
 (
     resTree_EntryRef_t obsEntry,    ///< Observation entry.
-    double startTime    ///< If < 30 years then seconds before now; else seconds since the Epoch.
+    double startTime,   ///< If < 30 years then seconds before now; else seconds since the Epoch.
+    double endTime      ///< If < 30 years then seconds before now; else seconds since the Epoch.
+                        ///< NAN = up to the newest sample.
 );
 
 
@@ -1163,7 +1464,9 @@ double resTree_QueryMin
 double resTree_QueryMax
 (
     resTree_EntryRef_t obsEntry,    ///< Observation entry.
-    double startTime    ///< If < 30 years then seconds before now; else seconds since the Epoch.
+    double startTime,   ///< If < 30 years then seconds before now; else seconds since the Epoch.
+    double endTime      ///< If < 30 years then seconds before now; else seconds since the Epoch.
+                        ///< NAN = up to the newest sample.
 );
 
 
@@ -1179,7 +1482,9 @@ double resTree_QueryMax
 double resTree_QueryMean
 (
     resTree_EntryRef_t obsEntry,    ///< Observation entry.
-    double startTime    ///< If < 30 years then seconds before now; else seconds since the Epoch.
+    double startTime,   ///< If < 30 years then seconds before now; else seconds since the Epoch.
+    double endTime      ///< If < 30 years then seconds before now; else seconds since the Epoch.
+                        ///< NAN = up to the newest sample.
 );
 
 
@@ -1196,7 +1501,65 @@ double resTree_QueryMean
 double resTree_QueryStdDev
 (
     resTree_EntryRef_t obsEntry,    ///< Observation entry.
-    double startTime    ///< If < 30 years then seconds before now; else seconds since the Epoch.
+    double startTime,   ///< If < 30 years then seconds before now; else seconds since the Epoch.
+    double endTime      ///< If < 30 years then seconds before now; else seconds since the Epoch.
+                        ///< NAN = up to the newest sample.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the count, minimum, maximum, mean and standard deviation of the numerical values found
+ * within a given time span in an Observation's buffer, along with the timestamps of the oldest and
+ * newest samples in the time span, all at once.
+ *
+ * The statistics are NAN (and the count is 0) if there's no numerical data in the time span.
+ * The timestamps are NAN if there are no samples in the time span.
+ *
+ * @return
+ *  - LE_OK if successful.
+ *  - LE_NOT_FOUND if the entry is not an Observation.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t resTree_QueryStats
+(
+    resTree_EntryRef_t obsEntry,    ///< Observation entry.
+    double startTime,   ///< If < 30 years then seconds before now; else seconds since the Epoch.
+                        ///< NAN = from the oldest sample.
+    double endTime,     ///< If < 30 years then seconds before now; else seconds since the Epoch.
+                        ///< NAN = up to the newest sample.
+    hub_BufferStats_t* statsPtr ///< [OUT] Statistics.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Divide a time span of an Observation's buffer into buckets of a given width and compute an
+ * aggregate of the samples in each bucket.
+ *
+ * The first bucket starts at the start time, and the last one ends at the end time (inclusive).
+ * Buckets that hold no samples get NAN (or 0 for QUERY_AGGREGATE_TYPE_COUNT).
+ *
+ * @return
+ *  - LE_OK if successful.
+ *  - LE_NOT_FOUND if the entry is not an Observation or there are no samples in the time span.
+ *  - LE_UNSUPPORTED if the aggregate type needs numerical data and the buffer holds another type.
+ *  - LE_BAD_PARAMETER if the bucket width isn't positive or the time span ends before it starts.
+ *  - LE_OVERFLOW if the time span holds more buckets than fit in the values array (the array is
+ *                filled with the first buckets' values).
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t resTree_QueryBuckets
+(
+    resTree_EntryRef_t obsEntry,    ///< Observation entry.
+    double startTime,   ///< If < 30 years then seconds before now; else seconds since the Epoch.
+                        ///< NAN = from the oldest sample.
+    double endTime,     ///< If < 30 years then seconds before now; else seconds since the Epoch.
+                        ///< NAN = up to the newest sample.
+    double bucketWidth, ///< Width of each bucket (seconds).
+    query_AggregateType_t aggregateType, ///< Aggregate to compute over each bucket's samples.
+    double* valuesPtr,  ///< [OUT] Array to put the value of each bucket in.
+    size_t* numBucketsPtr   ///< [IN/OUT] Size of the values array / number of buckets filled.
 );
 
 
@@ -1237,4 +1600,17 @@ void resTree_SetDestination
     const char* destination       ///< Destination string
 );
 
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the destination string of a given Observation.
+ *
+ * @return Ptr to the destination string.  "" if not set or not an Observation.
+ */
+//--------------------------------------------------------------------------------------------------
+const char* resTree_GetDestination
+(
+    resTree_EntryRef_t obsEntry   ///< Observation entry
+);
+
 #endif // NAMESPACE_H_INCLUDE_GUARD
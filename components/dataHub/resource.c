@@ -11,6 +11,7 @@
 #include "ioPoint.h"
 #include "obs.h"
 #include "handler.h"
+#include "strIntern.h"
 
 /// true if an extended configuration update is in progress, false if in normal operating mode.
 static bool IsUpdateInProgress = false;
@@ -111,7 +112,7 @@ void res_Construct
 //--------------------------------------------------------------------------------------------------
 {
     resPtr->entryRef = entryRef;
-    resPtr->units[0] = '\0';
+    resPtr->units = strIntern_Get("");
     resPtr->currentValue = NULL;
     resPtr->currentType = IO_DATA_TYPE_TRIGGER;
     resPtr->pushedValue = NULL;
@@ -141,10 +142,28 @@ static void SetUnits
 )
 //--------------------------------------------------------------------------------------------------
 {
-    if (le_utf8_Copy(resPtr->units, units, sizeof(resPtr->units), NULL) != LE_OK)
+    if (units == resPtr->units)
+    {
+        return;
+    }
+
+    char buff[HUB_MAX_UNITS_BYTES];
+
+    if (le_utf8_Copy(buff, units, sizeof(buff), NULL) != LE_OK)
     {
         LE_CRIT("Units string too long!");
     }
+
+    const char* internedUnits = strIntern_Get(buff);
+
+    if (internedUnits == NULL)
+    {
+        LE_CRIT("Failed to store units '%s'.", buff);
+        return;
+    }
+
+    strIntern_Release(resPtr->units);
+    resPtr->units = internedUnits;
 }
 
 
@@ -354,7 +373,7 @@ void res_ConvertIoToPlaceholder
         resPtr->jsonExample = NULL;
     }
 
-    memset(resPtr->units, 0, HUB_MAX_UNITS_BYTES);
+    SetUnits(resPtr, "");
 }
 
 
@@ -427,6 +446,9 @@ void res_Destruct
         le_mem_Release(resPtr->jsonExample);
         resPtr->jsonExample = NULL;
     }
+
+    strIntern_Release(resPtr->units);
+    resPtr->units = NULL;
 }
 
 
@@ -484,6 +506,128 @@ dataSample_Ref_t res_GetCurrentValue
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the values held by a resource.  The references filled in are not counted, so they are only
+ * valid until the resource is next changed.
+ */
+//--------------------------------------------------------------------------------------------------
+void res_GetState
+(
+    res_Resource_t* resPtr,
+    res_State_t* statePtr   ///< [OUT] The values.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    statePtr->units = resPtr->units;
+    statePtr->currentType = resPtr->currentType;
+    statePtr->currentValue = resPtr->currentValue;
+    statePtr->pushedType = resPtr->pushedType;
+    statePtr->pushedValue = resPtr->pushedValue;
+    statePtr->defaultType = resPtr->defaultType;
+    statePtr->defaultValue = resPtr->defaultValue;
+    statePtr->overrideType = resPtr->overrideType;
+    statePtr->overrideValue = resPtr->overrideValue;
+    statePtr->jsonExample = resPtr->jsonExample;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Replace one of a resource's values with a restored one, if the resource would accept it.
+ *
+ * @note Takes ownership of the new value.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RestoreValue
+(
+    res_Resource_t* resPtr,
+    io_DataType_t* typePtr,         ///< [INOUT] Data type of the resource's value.
+    dataSample_Ref_t* valuePtr,     ///< [INOUT] The resource's value.
+    io_DataType_t newType,
+    dataSample_Ref_t newValue       ///< Restored value, or NULL if none.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (newValue == NULL)
+    {
+        return;
+    }
+
+    if (!IsAcceptable(resPtr, newType))
+    {
+        LE_WARN("Dropping restored %s value of '%s'.",
+                hub_GetDataTypeName(newType),
+                resTree_GetEntryName(resPtr->entryRef));
+        le_mem_Release(newValue);
+        return;
+    }
+
+    if (*valuePtr != NULL)
+    {
+        le_mem_Release(*valuePtr);
+    }
+    *typePtr = newType;
+    *valuePtr = newValue;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Put back values held by a resource before the Data Hub restarted.  Unlike pushing them, this
+ * doesn't pass them on to routes, handlers or buffers.  Values the resource wouldn't accept are
+ * dropped.
+ *
+ * @note Takes ownership of the data sample references in the state.
+ */
+//--------------------------------------------------------------------------------------------------
+void res_RestoreState
+(
+    res_Resource_t* resPtr,
+    const res_State_t* statePtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    SetUnits(resPtr, statePtr->units);
+
+    RestoreValue(resPtr,
+                 &resPtr->currentType,
+                 &resPtr->currentValue,
+                 statePtr->currentType,
+                 statePtr->currentValue);
+    RestoreValue(resPtr,
+                 &resPtr->pushedType,
+                 &resPtr->pushedValue,
+                 statePtr->pushedType,
+                 statePtr->pushedValue);
+    RestoreValue(resPtr,
+                 &resPtr->defaultType,
+                 &resPtr->defaultValue,
+                 statePtr->defaultType,
+                 statePtr->defaultValue);
+
+    // Overrides of the wrong type are kept, as they are when set (see res_SetOverride()).
+    if (statePtr->overrideValue != NULL)
+    {
+        if (resPtr->overrideValue != NULL)
+        {
+            le_mem_Release(resPtr->overrideValue);
+        }
+        resPtr->overrideType = statePtr->overrideType;
+        resPtr->overrideValue = statePtr->overrideValue;
+    }
+
+    if (statePtr->jsonExample != NULL)
+    {
+        if (resPtr->jsonExample != NULL)
+        {
+            le_mem_Release(resPtr->jsonExample);
+        }
+        resPtr->jsonExample = statePtr->jsonExample;
+    }
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Set the source resource of a given resource.
@@ -782,7 +926,9 @@ le_result_t res_Push
             // Check for units mismatches.
             // But, ignore the units if the units are supposed to be obtained from the resource,
             // or if the receiving resource doesn't have units.
+            // Units are interned, so matching units are normally the same pointer.
             if (   (units != NULL)
+                && (units != resPtr->units)
                 && (resPtr->units[0] != '\0')
                 && (strcmp(units, resPtr->units) != 0)  )
             {
@@ -1199,6 +1345,169 @@ uint32_t res_GetBufferMaxCount
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the maximum age of the data samples buffered in a given Observation.  Samples timestamped
+ * longer ago than this are dropped from the buffer, as well as any dropped to respect its maximum
+ * count.
+ */
+//--------------------------------------------------------------------------------------------------
+void res_SetBufferMaxAge
+(
+    res_Resource_t* resPtr,
+    double seconds  ///< Maximum age (NAN or 0 = no limit).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    obs_SetBufferMaxAge(resPtr, seconds);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the maximum age of the data samples buffered in a given Observation.
+ *
+ * @return The maximum age (in seconds) or NAN if not set.
+ */
+//--------------------------------------------------------------------------------------------------
+double res_GetBufferMaxAge
+(
+    res_Resource_t* resPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return obs_GetBufferMaxAge(resPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the maximum number of bytes of memory that the data samples buffered in a given Observation
+ * can use.  This counts all the memory allocated for the buffer: the ring of samples (including
+ * any slots not yet filled), its statistics index, the compressed blocks, and the contents of
+ * strings.  When the limit is exceeded, the oldest samples are dropped (shrinking the ring) until
+ * it isn't, as well as any dropped to respect the maximum count.
+ */
+//--------------------------------------------------------------------------------------------------
+void res_SetBufferMaxBytes
+(
+    res_Resource_t* resPtr,
+    uint32_t bytes  ///< Maximum number of bytes (0 = no limit).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    obs_SetBufferMaxBytes(resPtr, bytes);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the maximum number of bytes of memory that the data samples buffered in a given Observation
+ * can use.
+ *
+ * @return The maximum number of bytes or 0 if not set.
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t res_GetBufferMaxBytes
+(
+    res_Resource_t* resPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return obs_GetBufferMaxBytes(resPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the priority of the data samples buffered in a given Observation.  When the samples buffered
+ * in all Observations use more memory than the hub's buffer memory budget, samples are evicted
+ * from the lowest priority buffers first.
+ */
+//--------------------------------------------------------------------------------------------------
+void res_SetBufferPriority
+(
+    res_Resource_t* resPtr,
+    int32_t priority ///< Higher = samples kept longer (default 0).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    obs_SetBufferPriority(resPtr, priority);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the priority of the data samples buffered in a given Observation.
+ *
+ * @return The priority.
+ */
+//--------------------------------------------------------------------------------------------------
+int32_t res_GetBufferPriority
+(
+    res_Resource_t* resPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return obs_GetBufferPriority(resPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Enable or disable compression of the numeric and Boolean data samples buffered in a given
+ * Observation.  Compressed samples take much less memory, but are slower to read at random.
+ * Samples already in the buffer are compressed (or decompressed) right away.
+ */
+//--------------------------------------------------------------------------------------------------
+void res_SetBufferCompression
+(
+    res_Resource_t* resPtr,
+    bool compress   ///< true = compress numerical samples (default false).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    obs_SetBufferCompression(resPtr, compress);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether compression of the numerical data samples buffered in a given Observation is
+ * enabled.
+ *
+ * @return true if enabled.
+ */
+//--------------------------------------------------------------------------------------------------
+bool res_GetBufferCompression
+(
+    res_Resource_t* resPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return obs_GetBufferCompression(resPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of bytes of memory allocated for the samples buffered in a given Observation, and
+ * the number of samples that have been evicted from its buffer to stay within the hub's buffer
+ * memory budget.
+ */
+//--------------------------------------------------------------------------------------------------
+void res_GetBufferMemoryUsage
+(
+    res_Resource_t* resPtr,
+    uint64_t* bytesPtr, ///< [OUT] Bytes allocated for the buffer.
+    uint64_t* evictionCountPtr ///< [OUT] Samples evicted to stay within the budget.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    obs_GetBufferMemoryUsage(resPtr, bytesPtr, evictionCountPtr);
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Set the minimum time between backups of an Observation's buffer to non-volatile storage.
@@ -1237,6 +1546,41 @@ uint32_t res_GetBufferBackupPeriod
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set whether an Observation's buffer is backed up by appending the samples added since the
+ * previous backup to a log, rather than by rewriting the whole buffer to its backup file.
+ * The log is compacted every so often, by writing the whole buffer again.
+ */
+//--------------------------------------------------------------------------------------------------
+void res_SetBufferBackupLog
+(
+    res_Resource_t* resPtr,
+    bool useLog  ///< true = append to a log, false = rewrite the backup file (default).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    obs_SetBufferBackupLog(resPtr, useLog);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether an Observation's buffer is backed up by appending to a log.
+ *
+ * @return true if backed up to a log.
+ */
+//--------------------------------------------------------------------------------------------------
+bool res_GetBufferBackupLog
+(
+    res_Resource_t* resPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return obs_GetBufferBackupLog(resPtr);
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Mark an Output resource "optional".  (By default, they are marked "mandatory".)
@@ -1741,12 +2085,138 @@ void res_ReadBufferJson
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read data out of a buffer in binary form.  A two-byte header (format version 0 and data type
+ * code) is written to a given file descriptor, followed by one packed record per sample, in the
+ * layout used by backup files, until end of file.  See obs_ReadBufferBinary() for details.
+ */
+//--------------------------------------------------------------------------------------------------
+void res_ReadBufferBinary
+(
+    res_Resource_t* resPtr, ///< Ptr to the resource object for the Observation.
+    double startAfter,  ///< Start after this many seconds ago, or after an absolute number of
+                        ///< seconds since the Epoch (if startafter > 30 years).
+                        ///< Use NAN (not a number) to read the whole buffer.
+    int outputFile, ///< File descriptor to write the data to.
+    query_ReadCompletionFunc_t handlerPtr, ///< Completion callback.
+    void* contextPtr    ///< Value to be passed to completion callback.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    obs_ReadBufferBinary(resPtr, startAfter, outputFile, handlerPtr, contextPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Export a read-only copy of the data in a buffer through a sealed shared memory file, which the
+ * caller can mmap() instead of having the samples streamed to it.  See obs_ExportBuffer() for
+ * the layout.
+ *
+ * @return
+ *  - LE_OK if successful (the caller must close the file descriptor).
+ *  - LE_UNSUPPORTED if the buffer holds strings or JSON, or shared memory is not available.
+ *  - LE_FAULT if the shared memory file could not be created.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t res_ExportBuffer
+(
+    res_Resource_t* resPtr, ///< Ptr to the resource object for the Observation.
+    double startAfter,  ///< Start after this many seconds ago, or after an absolute number of
+                        ///< seconds since the Epoch (if startafter > 30 years).
+                        ///< Use NAN (not a number) to export the whole buffer.
+    int* fdPtr  ///< [OUT] File descriptor of the shared memory file.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return obs_ExportBuffer(resPtr, startAfter, fdPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append a copy of an Observation's whole data buffer to an image, in the backup file format.
+ * If the buffer hasn't changed since its copy was appended to the image before (the last one
+ * stored in the State Segment), that copy is reused.
+ *
+ * @return true if successful, false if out of memory.
+ */
+//--------------------------------------------------------------------------------------------------
+bool res_AppendBufferToImage
+(
+    res_Resource_t* resPtr, ///< Ptr to the resource object for the Observation.
+    backupWriter_ImageRef_t imageRef,
+    uint32_t imageNumber,           ///< Number of the image (one more than the image before).
+    const uint8_t* lastImagePtr     ///< The image before, or NULL if it isn't available.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return obs_AppendBufferToImage(resPtr, imageRef, imageNumber, lastImagePtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Replace an Observation's data buffer with a copy in memory (see res_AppendBufferToImage()).
+ * None of the samples are pushed to the Observation, so its current value is left as it is.
+ */
+//--------------------------------------------------------------------------------------------------
+void res_RestoreBufferFromImage
+(
+    res_Resource_t* resPtr, ///< Ptr to the resource object for the Observation.
+    const uint8_t* imagePtr,
+    size_t imageSize,
+    const char* name        ///< Name of the copy, for log messages.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    obs_RestoreBufferFromImage(resPtr, imagePtr, imageSize, name);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read a downsampled view of the data in a buffer.  At most a given number of samples, chosen to
+ * preserve the shape of the data when plotted, are written to a given file descriptor in the same
+ * JSON format as res_ReadBufferJson().
+ *
+ * @return
+ *  - LE_OK if the read operation started (the completion callback will be called).
+ *  - LE_UNSUPPORTED if the buffer holds data of a non-numerical type.
+ *  - LE_BAD_PARAMETER if maxPoints is too small for the downsampling method.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t res_ReadBufferDownsampledJson
+(
+    res_Resource_t* resPtr, ///< Ptr to the resource object for the Observation.
+    double startAfter,  ///< Start after this many seconds ago, or after an absolute number of
+                        ///< seconds since the Epoch (if startafter > 30 years).
+                        ///< Use NAN (not a number) to read the whole buffer.
+    uint32_t maxPoints, ///< Maximum number of samples to read.
+    query_DownsampleMethod_t method, ///< How to choose the samples.
+    int outputFile, ///< File descriptor to write the data to.
+    query_ReadCompletionFunc_t handlerPtr, ///< Completion callback.
+    void* contextPtr    ///< Value to be passed to completion callback.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return obs_ReadBufferDownsampledJson(resPtr,
+                                         startAfter,
+                                         maxPoints,
+                                         method,
+                                         outputFile,
+                                         handlerPtr,
+                                         contextPtr);
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Find the oldest data sample held in a given Observation's buffer that is newer than a
  * given timestamp.
  *
- * @return Reference to the sample, or NULL if not found.
+ * @return Reference to a copy of the sample (which the caller must release), or NULL if not found.
  */
 //--------------------------------------------------------------------------------------------------
 dataSample_Ref_t res_FindBufferedSampleAfter
@@ -1896,11 +2366,13 @@ const char* res_GetJsonExtraction
 double res_QueryMin
 (
     res_Resource_t* resPtr,    ///< Ptr to Observation resource.
-    double startTime    ///< If < 30 years then seconds before now; else seconds since the Epoch.
+    double startTime,   ///< If < 30 years then seconds before now; else seconds since the Epoch.
+    double endTime      ///< If < 30 years then seconds before now; else seconds since the Epoch.
+                        ///< NAN = up to the newest sample.
 )
 //--------------------------------------------------------------------------------------------------
 {
-    return obs_QueryMin(resPtr, startTime);
+    return obs_QueryMin(resPtr, startTime, endTime);
 }
 
 
@@ -1916,11 +2388,13 @@ double res_QueryMin
 double res_QueryMax
 (
     res_Resource_t* resPtr,    ///< Ptr to Observation resource.
-    double startTime    ///< If < 30 years then seconds before now; else seconds since the Epoch.
+    double startTime,   ///< If < 30 years then seconds before now; else seconds since the Epoch.
+    double endTime      ///< If < 30 years then seconds before now; else seconds since the Epoch.
+                        ///< NAN = up to the newest sample.
 )
 //--------------------------------------------------------------------------------------------------
 {
-    return obs_QueryMax(resPtr, startTime);
+    return obs_QueryMax(resPtr, startTime, endTime);
 }
 
 
@@ -1936,11 +2410,13 @@ double res_QueryMax
 double res_QueryMean
 (
     res_Resource_t* resPtr,    ///< Ptr to Observation resource.
-    double startTime    ///< If < 30 years then seconds before now; else seconds since the Epoch.
+    double startTime,   ///< If < 30 years then seconds before now; else seconds since the Epoch.
+    double endTime      ///< If < 30 years then seconds before now; else seconds since the Epoch.
+                        ///< NAN = up to the newest sample.
 )
 //--------------------------------------------------------------------------------------------------
 {
-    return obs_QueryMean(resPtr, startTime);
+    return obs_QueryMean(resPtr, startTime, endTime);
 }
 
 
@@ -1957,11 +2433,79 @@ double res_QueryMean
 double res_QueryStdDev
 (
     res_Resource_t* resPtr,    ///< Ptr to Observation resource.
-    double startTime    ///< If < 30 years then seconds before now; else seconds since the Epoch.
+    double startTime,   ///< If < 30 years then seconds before now; else seconds since the Epoch.
+    double endTime      ///< If < 30 years then seconds before now; else seconds since the Epoch.
+                        ///< NAN = up to the newest sample.
 )
 //--------------------------------------------------------------------------------------------------
 {
-    return obs_QueryStdDev(resPtr, startTime);
+    return obs_QueryStdDev(resPtr, startTime, endTime);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the count, minimum, maximum, mean and standard deviation of the numerical values found
+ * within a given time span in an Observation's buffer, along with the timestamps of the oldest and
+ * newest samples in the time span, all at once.
+ *
+ * The statistics are NAN (and the count is 0) if there's no numerical data in the time span.
+ * The timestamps are NAN if there are no samples in the time span.
+ */
+//--------------------------------------------------------------------------------------------------
+void res_QueryStats
+(
+    res_Resource_t* resPtr,    ///< Ptr to Observation resource.
+    double startTime,   ///< If < 30 years then seconds before now; else seconds since the Epoch.
+                        ///< NAN = from the oldest sample.
+    double endTime,     ///< If < 30 years then seconds before now; else seconds since the Epoch.
+                        ///< NAN = up to the newest sample.
+    hub_BufferStats_t* statsPtr ///< [OUT] Statistics.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    obs_QueryStats(resPtr, startTime, endTime, statsPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Divide a time span of an Observation's buffer into buckets of a given width and compute an
+ * aggregate of the samples in each bucket.
+ *
+ * The first bucket starts at the start time, and the last one ends at the end time (inclusive).
+ * Buckets that hold no samples get NAN (or 0 for QUERY_AGGREGATE_TYPE_COUNT).
+ *
+ * @return
+ *  - LE_OK if successful.
+ *  - LE_NOT_FOUND if there are no samples in the time span.
+ *  - LE_UNSUPPORTED if the aggregate type needs numerical data and the buffer holds another type.
+ *  - LE_BAD_PARAMETER if the bucket width isn't positive or the time span ends before it starts.
+ *  - LE_OVERFLOW if the time span holds more buckets than fit in the values array (the array is
+ *                filled with the first buckets' values).
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t res_QueryBuckets
+(
+    res_Resource_t* resPtr,    ///< Ptr to Observation resource.
+    double startTime,   ///< If < 30 years then seconds before now; else seconds since the Epoch.
+                        ///< NAN = from the oldest sample.
+    double endTime,     ///< If < 30 years then seconds before now; else seconds since the Epoch.
+                        ///< NAN = up to the newest sample.
+    double bucketWidth, ///< Width of each bucket (seconds).
+    query_AggregateType_t aggregateType, ///< Aggregate to compute over each bucket's samples.
+    double* valuesPtr,  ///< [OUT] Array to put the value of each bucket in.
+    size_t* numBucketsPtr   ///< [IN/OUT] Size of the values array / number of buckets filled.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return obs_QueryBuckets(resPtr,
+                            startTime,
+                            endTime,
+                            bucketWidth,
+                            aggregateType,
+                            valuesPtr,
+                            numBucketsPtr);
 }
 
 
@@ -2014,3 +2558,20 @@ void res_SetDestination
 {
     obs_SetDestination(resPtr, destination);
 }
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the destination string of a given Observation.
+ *
+ * @return Ptr to the destination string.  "" if not set.
+ */
+//--------------------------------------------------------------------------------------------------
+const char* res_GetDestination
+(
+    res_Resource_t* resPtr       ///< Ptr to Observation resource
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return obs_GetDestination(resPtr);
+}
@@ -38,7 +38,7 @@ typedef struct resTree_Entry* resTree_EntryRef_t;
 typedef struct res_Resource
 {
     resTree_EntryRef_t entryRef;  ///< Reference to the resource tree entry this is attached to.
-    char units[HUB_MAX_UNITS_BYTES]; ///< String describing the units, or "" if unspecified.
+    const char* units; ///< Units string (interned, see strIntern.h), or "" if unspecified.
     io_DataType_t currentType;  ///< Data type of the current value of this resource.
     dataSample_Ref_t currentValue; ///< The current value of this resource; NULL if none yet.
     io_DataType_t pushedType;  ///< Data type of last value pushed to this resource.
@@ -57,6 +57,28 @@ typedef struct res_Resource
 res_Resource_t;
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * The values held by a resource, as saved in and restored from a checkpoint (see checkpoint.h).
+ * Each data sample reference is NULL if the resource doesn't have that value.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct res_State
+{
+    const char* units;              ///< Units string, or "" if unspecified.
+    io_DataType_t currentType;      ///< Data type of the current value.
+    dataSample_Ref_t currentValue;  ///< Current value.
+    io_DataType_t pushedType;       ///< Data type of the last value pushed.
+    dataSample_Ref_t pushedValue;   ///< Last value pushed.
+    io_DataType_t defaultType;      ///< Data type of the default value.
+    dataSample_Ref_t defaultValue;  ///< Default value.
+    io_DataType_t overrideType;     ///< Data type of the override.
+    dataSample_Ref_t overrideValue; ///< Override.
+    dataSample_Ref_t jsonExample;   ///< JSON example value.
+}
+res_State_t;
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Initialize the Resource module.
@@ -299,6 +321,35 @@ dataSample_Ref_t res_GetCurrentValue
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the values held by a resource.  The references filled in are not counted, so they are only
+ * valid until the resource is next changed.
+ */
+//--------------------------------------------------------------------------------------------------
+void res_GetState
+(
+    res_Resource_t* resPtr,
+    res_State_t* statePtr   ///< [OUT] The values.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Put back values held by a resource before the Data Hub restarted.  Unlike pushing them, this
+ * doesn't pass them on to routes, handlers or buffers.  Values the resource wouldn't accept are
+ * dropped.
+ *
+ * @note Takes ownership of the data sample references in the state.
+ */
+//--------------------------------------------------------------------------------------------------
+void res_RestoreState
+(
+    res_Resource_t* resPtr,
+    const res_State_t* statePtr
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Set the source resource of a given resource.
@@ -567,6 +618,133 @@ uint32_t res_GetBufferMaxCount
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the maximum age of the data samples buffered in a given Observation.  Samples timestamped
+ * longer ago than this are dropped from the buffer, as well as any dropped to respect its maximum
+ * count.
+ */
+//--------------------------------------------------------------------------------------------------
+void res_SetBufferMaxAge
+(
+    res_Resource_t* resPtr,
+    double seconds  ///< Maximum age (NAN or 0 = no limit).
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the maximum age of the data samples buffered in a given Observation.
+ *
+ * @return The maximum age (in seconds) or NAN if not set.
+ */
+//--------------------------------------------------------------------------------------------------
+double res_GetBufferMaxAge
+(
+    res_Resource_t* resPtr
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the maximum number of bytes of memory that the data samples buffered in a given Observation
+ * can use.  This counts all the memory allocated for the buffer: the ring of samples (including
+ * any slots not yet filled), its statistics index, the compressed blocks, and the contents of
+ * strings.  When the limit is exceeded, the oldest samples are dropped (shrinking the ring) until
+ * it isn't, as well as any dropped to respect the maximum count.
+ */
+//--------------------------------------------------------------------------------------------------
+void res_SetBufferMaxBytes
+(
+    res_Resource_t* resPtr,
+    uint32_t bytes  ///< Maximum number of bytes (0 = no limit).
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the maximum number of bytes of memory that the data samples buffered in a given Observation
+ * can use.
+ *
+ * @return The maximum number of bytes or 0 if not set.
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t res_GetBufferMaxBytes
+(
+    res_Resource_t* resPtr
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the priority of the data samples buffered in a given Observation.  When the samples buffered
+ * in all Observations use more memory than the hub's buffer memory budget, samples are evicted
+ * from the lowest priority buffers first.
+ */
+//--------------------------------------------------------------------------------------------------
+void res_SetBufferPriority
+(
+    res_Resource_t* resPtr,
+    int32_t priority ///< Higher = samples kept longer (default 0).
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the priority of the data samples buffered in a given Observation.
+ *
+ * @return The priority.
+ */
+//--------------------------------------------------------------------------------------------------
+int32_t res_GetBufferPriority
+(
+    res_Resource_t* resPtr
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Enable or disable compression of the numeric and Boolean data samples buffered in a given
+ * Observation.  Compressed samples take much less memory, but are slower to read at random.
+ * Samples already in the buffer are compressed (or decompressed) right away.
+ */
+//--------------------------------------------------------------------------------------------------
+void res_SetBufferCompression
+(
+    res_Resource_t* resPtr,
+    bool compress   ///< true = compress numerical samples (default false).
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether compression of the numerical data samples buffered in a given Observation is
+ * enabled.
+ *
+ * @return true if enabled.
+ */
+//--------------------------------------------------------------------------------------------------
+bool res_GetBufferCompression
+(
+    res_Resource_t* resPtr
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of bytes of memory allocated for the samples buffered in a given Observation, and
+ * the number of samples that have been evicted from its buffer to stay within the hub's buffer
+ * memory budget.
+ */
+//--------------------------------------------------------------------------------------------------
+void res_GetBufferMemoryUsage
+(
+    res_Resource_t* resPtr,
+    uint64_t* bytesPtr, ///< [OUT] Bytes allocated for the buffer.
+    uint64_t* evictionCountPtr ///< [OUT] Samples evicted to stay within the budget.
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Set the minimum time between backups of an Observation's buffer to non-volatile storage.
@@ -597,6 +775,33 @@ uint32_t res_GetBufferBackupPeriod
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set whether an Observation's buffer is backed up by appending the samples added since the
+ * previous backup to a log, rather than by rewriting the whole buffer to its backup file.
+ * The log is compacted every so often, by writing the whole buffer again.
+ */
+//--------------------------------------------------------------------------------------------------
+void res_SetBufferBackupLog
+(
+    res_Resource_t* resPtr,
+    bool useLog  ///< true = append to a log, false = rewrite the backup file (default).
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether an Observation's buffer is backed up by appending to a log.
+ *
+ * @return true if backed up to a log.
+ */
+//--------------------------------------------------------------------------------------------------
+bool res_GetBufferBackupLog
+(
+    res_Resource_t* resPtr
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Mark an Output resource "optional".  (By default, they are marked "mandatory".)
@@ -900,12 +1105,112 @@ void res_ReadBufferJson
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read data out of a buffer in binary form.  A two-byte header (format version 0 and data type
+ * code) is written to a given file descriptor, followed by one packed record per sample, in the
+ * layout used by backup files, until end of file.  See obs_ReadBufferBinary() for details.
+ */
+//--------------------------------------------------------------------------------------------------
+void res_ReadBufferBinary
+(
+    res_Resource_t* resPtr, ///< Ptr to the resource object for the Observation.
+    double startAfter,  ///< Start after this many seconds ago, or after an absolute number of
+                        ///< seconds since the Epoch (if startafter > 30 years).
+                        ///< Use NAN (not a number) to read the whole buffer.
+    int outputFile, ///< File descriptor to write the data to.
+    query_ReadCompletionFunc_t handlerPtr, ///< Completion callback.
+    void* contextPtr    ///< Value to be passed to completion callback.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Export a read-only copy of the data in a buffer through a sealed shared memory file, which the
+ * caller can mmap() instead of having the samples streamed to it.  See obs_ExportBuffer() for
+ * the layout.
+ *
+ * @return
+ *  - LE_OK if successful (the caller must close the file descriptor).
+ *  - LE_UNSUPPORTED if the buffer holds strings or JSON, or shared memory is not available.
+ *  - LE_FAULT if the shared memory file could not be created.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t res_ExportBuffer
+(
+    res_Resource_t* resPtr, ///< Ptr to the resource object for the Observation.
+    double startAfter,  ///< Start after this many seconds ago, or after an absolute number of
+                        ///< seconds since the Epoch (if startafter > 30 years).
+                        ///< Use NAN (not a number) to export the whole buffer.
+    int* fdPtr  ///< [OUT] File descriptor of the shared memory file.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append a copy of an Observation's whole data buffer to an image, in the backup file format.
+ * If the buffer hasn't changed since its copy was appended to the image before (the last one
+ * stored in the State Segment), that copy is reused.
+ *
+ * @return true if successful, false if out of memory.
+ */
+//--------------------------------------------------------------------------------------------------
+bool res_AppendBufferToImage
+(
+    res_Resource_t* resPtr, ///< Ptr to the resource object for the Observation.
+    backupWriter_ImageRef_t imageRef,
+    uint32_t imageNumber,           ///< Number of the image (one more than the image before).
+    const uint8_t* lastImagePtr     ///< The image before, or NULL if it isn't available.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Replace an Observation's data buffer with a copy in memory (see res_AppendBufferToImage()).
+ * None of the samples are pushed to the Observation, so its current value is left as it is.
+ */
+//--------------------------------------------------------------------------------------------------
+void res_RestoreBufferFromImage
+(
+    res_Resource_t* resPtr, ///< Ptr to the resource object for the Observation.
+    const uint8_t* imagePtr,
+    size_t imageSize,
+    const char* name        ///< Name of the copy, for log messages.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read a downsampled view of the data in a buffer.  At most a given number of samples, chosen to
+ * preserve the shape of the data when plotted, are written to a given file descriptor in the same
+ * JSON format as res_ReadBufferJson().
+ *
+ * @return
+ *  - LE_OK if the read operation started (the completion callback will be called).
+ *  - LE_UNSUPPORTED if the buffer holds data of a non-numerical type.
+ *  - LE_BAD_PARAMETER if maxPoints is too small for the downsampling method.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t res_ReadBufferDownsampledJson
+(
+    res_Resource_t* resPtr, ///< Ptr to the resource object for the Observation.
+    double startAfter,  ///< Start after this many seconds ago, or after an absolute number of
+                        ///< seconds since the Epoch (if startafter > 30 years).
+                        ///< Use NAN (not a number) to read the whole buffer.
+    uint32_t maxPoints, ///< Maximum number of samples to read.
+    query_DownsampleMethod_t method, ///< How to choose the samples.
+    int outputFile, ///< File descriptor to write the data to.
+    query_ReadCompletionFunc_t handlerPtr, ///< Completion callback.
+    void* contextPtr    ///< Value to be passed to completion callback.
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Find the oldest data sample held in a given Observation's buffer that is newer than a
  * given timestamp.
  *
- * @return Reference to the sample, or NULL if not found.
+ * @return Reference to a copy of the sample (which the caller must release), or NULL if not found.
  */
 //--------------------------------------------------------------------------------------------------
 dataSample_Ref_t res_FindBufferedSampleAfter
@@ -1008,7 +1313,9 @@ const char* res_GetJsonExtraction
 double res_QueryMin
 (
     res_Resource_t* resPtr,    ///< Ptr to Observation resource.
-    double startTime    ///< If < 30 years then seconds before now; else seconds since the Epoch.
+    double startTime,   ///< If < 30 years then seconds before now; else seconds since the Epoch.
+    double endTime      ///< If < 30 years then seconds before now; else seconds since the Epoch.
+                        ///< NAN = up to the newest sample.
 );
 
 
@@ -1024,7 +1331,9 @@ double res_QueryMin
 double res_QueryMax
 (
     res_Resource_t* resPtr,    ///< Ptr to Observation resource.
-    double startTime    ///< If < 30 years then seconds before now; else seconds since the Epoch.
+    double startTime,   ///< If < 30 years then seconds before now; else seconds since the Epoch.
+    double endTime      ///< If < 30 years then seconds before now; else seconds since the Epoch.
+                        ///< NAN = up to the newest sample.
 );
 
 
@@ -1040,7 +1349,9 @@ double res_QueryMax
 double res_QueryMean
 (
     res_Resource_t* resPtr,    ///< Ptr to Observation resource.
-    double startTime    ///< If < 30 years then seconds before now; else seconds since the Epoch.
+    double startTime,   ///< If < 30 years then seconds before now; else seconds since the Epoch.
+    double endTime      ///< If < 30 years then seconds before now; else seconds since the Epoch.
+                        ///< NAN = up to the newest sample.
 );
 
 
@@ -1057,7 +1368,61 @@ double res_QueryMean
 double res_QueryStdDev
 (
     res_Resource_t* resPtr,    ///< Ptr to Observation resource.
-    double startTime    ///< If < 30 years then seconds before now; else seconds since the Epoch.
+    double startTime,   ///< If < 30 years then seconds before now; else seconds since the Epoch.
+    double endTime      ///< If < 30 years then seconds before now; else seconds since the Epoch.
+                        ///< NAN = up to the newest sample.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the count, minimum, maximum, mean and standard deviation of the numerical values found
+ * within a given time span in an Observation's buffer, along with the timestamps of the oldest and
+ * newest samples in the time span, all at once.
+ *
+ * The statistics are NAN (and the count is 0) if there's no numerical data in the time span.
+ * The timestamps are NAN if there are no samples in the time span.
+ */
+//--------------------------------------------------------------------------------------------------
+void res_QueryStats
+(
+    res_Resource_t* resPtr,    ///< Ptr to Observation resource.
+    double startTime,   ///< If < 30 years then seconds before now; else seconds since the Epoch.
+                        ///< NAN = from the oldest sample.
+    double endTime,     ///< If < 30 years then seconds before now; else seconds since the Epoch.
+                        ///< NAN = up to the newest sample.
+    hub_BufferStats_t* statsPtr ///< [OUT] Statistics.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Divide a time span of an Observation's buffer into buckets of a given width and compute an
+ * aggregate of the samples in each bucket.
+ *
+ * The first bucket starts at the start time, and the last one ends at the end time (inclusive).
+ * Buckets that hold no samples get NAN (or 0 for QUERY_AGGREGATE_TYPE_COUNT).
+ *
+ * @return
+ *  - LE_OK if successful.
+ *  - LE_NOT_FOUND if there are no samples in the time span.
+ *  - LE_UNSUPPORTED if the aggregate type needs numerical data and the buffer holds another type.
+ *  - LE_BAD_PARAMETER if the bucket width isn't positive or the time span ends before it starts.
+ *  - LE_OVERFLOW if the time span holds more buckets than fit in the values array (the array is
+ *                filled with the first buckets' values).
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t res_QueryBuckets
+(
+    res_Resource_t* resPtr,    ///< Ptr to Observation resource.
+    double startTime,   ///< If < 30 years then seconds before now; else seconds since the Epoch.
+                        ///< NAN = from the oldest sample.
+    double endTime,     ///< If < 30 years then seconds before now; else seconds since the Epoch.
+                        ///< NAN = up to the newest sample.
+    double bucketWidth, ///< Width of each bucket (seconds).
+    query_AggregateType_t aggregateType, ///< Aggregate to compute over each bucket's samples.
+    double* valuesPtr,  ///< [OUT] Array to put the value of each bucket in.
+    size_t* numBucketsPtr   ///< [IN/OUT] Size of the values array / number of buckets filled.
 );
 
 
@@ -1099,4 +1464,17 @@ void res_SetDestination
     const char* destination      ///< Destination string
 );
 
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the destination string of a given Observation.
+ *
+ * @return Ptr to the destination string.  "" if not set.
+ */
+//--------------------------------------------------------------------------------------------------
+const char* res_GetDestination
+(
+    res_Resource_t* resPtr       ///< Ptr to Observation resource
+);
+
 #endif // RESOURCE_H_INCLUDE_GUARD
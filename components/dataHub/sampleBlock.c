@@ -0,0 +1,446 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * Implementation of the Sample Block module, which compresses timestamped numerical samples
+ * into fixed-size blocks using delta-of-delta timestamps and XOR-encoded values.
+ *
+ * Timestamps are first encoded as 64-bit integers: whole microseconds, or the bit pattern of the
+ * double, depending on the block (see sampleBlock.h).
+ *
+ * Bits are packed into the data bytes most significant bit first.  Each sample is encoded as
+ * follows (the first sample in a block just has its 64-bit encoded timestamp and raw value):
+ *
+ * Timestamp delta-of-delta (D):
+ *  - '0' if D is 0,
+ *  - '10' followed by 7 bits if D fits in 7 bits (two's complement),
+ *  - '110' followed by 9 bits if D fits in 9 bits,
+ *  - '1110' followed by 12 bits if D fits in 12 bits,
+ *  - '11110' followed by 32 bits if D fits in 32 bits,
+ *  - '11111' followed by 64 bits otherwise.
+ *
+ * Value XOR with the previous value (X):
+ *  - '0' if X is 0,
+ *  - '10' followed by the meaningful bits of X if they fit in the previous sample's window,
+ *  - '11' followed by 5 bits of leading zero count, 6 bits of meaningful bit count (minus 1) and
+ *    the meaningful bits of X otherwise.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#include "interfaces.h"
+#include "sampleBlock.h"
+
+
+/// Largest number of bits a sample can take up in a block after the first (69 for the timestamp
+/// plus 77 for the value).  A sample is only appended if this many bits are left.
+#define MAX_SAMPLE_BITS 146
+
+/// Number of bits of data in a block.
+#define BLOCK_DATA_BITS (SAMPLE_BLOCK_DATA_BYTES * 8)
+
+/// Largest leading zero count that can be encoded for a value XOR window.
+#define MAX_LEADING_ZEROS 31
+
+/// Timestamps must be smaller than this many microseconds to be encoded in microseconds (2^53, so
+/// that every whole number of microseconds up to it can be represented exactly by a double).
+#define MAX_MICROSECONDS 9007199254740992.0
+
+
+/// Encodings of timestamp delta-of-deltas, from shortest to longest.
+static const struct
+{
+    uint8_t prefix;     ///< Prefix bits.
+    uint8_t prefixLen;  ///< Number of prefix bits.
+    uint8_t valueLen;   ///< Number of bits of delta-of-delta that follow the prefix.
+}
+DodEncodings[] =
+{
+    { 0x2,  2, 7  },
+    { 0x6,  3, 9  },
+    { 0xE,  4, 12 },
+    { 0x1E, 5, 32 },
+    { 0x1F, 5, 64 },
+};
+
+/// Number of entries in DodEncodings.
+#define DOD_ENCODING_COUNT (sizeof(DodEncodings) / sizeof(DodEncodings[0]))
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write the least significant bits of a value into a block's data at a given bit offset, and
+ * advance the offset.
+ */
+//--------------------------------------------------------------------------------------------------
+static void WriteBits
+(
+    uint8_t* dataPtr,
+    uint32_t* bitOffsetPtr,     ///< [IN/OUT] Bit offset to write at.
+    uint64_t bits,              ///< Value whose least significant bits are to be written.
+    unsigned int count          ///< Number of bits to write (up to 64).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    while (count > 0)
+    {
+        uint32_t offset = *bitOffsetPtr;
+        unsigned int room = 8 - (offset & 7);
+        unsigned int len = (count < room) ? count : room;
+        unsigned int chunk = (unsigned int)(bits >> (count - len)) & ((1u << len) - 1);
+
+        dataPtr[offset >> 3] |= (uint8_t)(chunk << (room - len));
+
+        *bitOffsetPtr += len;
+        count -= len;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read bits from a block's data at a given bit offset, and advance the offset.
+ *
+ * @return The bits read, in the least significant bits.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t ReadBits
+(
+    const uint8_t* dataPtr,
+    uint32_t* bitOffsetPtr,     ///< [IN/OUT] Bit offset to read at.
+    unsigned int count          ///< Number of bits to read (up to 64).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    uint64_t bits = 0;
+
+    while (count > 0)
+    {
+        uint32_t offset = *bitOffsetPtr;
+        unsigned int room = 8 - (offset & 7);
+        unsigned int len = (count < room) ? count : room;
+        unsigned int chunk = (dataPtr[offset >> 3] >> (room - len)) & ((1u << len) - 1);
+
+        bits = (bits << len) | chunk;
+
+        *bitOffsetPtr += len;
+        count -= len;
+    }
+
+    return bits;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the bit pattern of a double.
+ *
+ * @return The bits.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline uint64_t DoubleToBits
+(
+    double value
+)
+//--------------------------------------------------------------------------------------------------
+{
+    uint64_t bits;
+
+    memcpy(&bits, &value, sizeof(bits));
+
+    return bits;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the double with a given bit pattern.
+ *
+ * @return The double.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline double BitsToDouble
+(
+    uint64_t bits
+)
+//--------------------------------------------------------------------------------------------------
+{
+    double value;
+
+    memcpy(&value, &bits, sizeof(value));
+
+    return value;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether a timestamp is a whole number of microseconds, that can be encoded in microseconds
+ * and decoded back to exactly the same double.
+ *
+ * @return true if so.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsWholeMicroseconds
+(
+    double timestamp
+)
+//--------------------------------------------------------------------------------------------------
+{
+    double usec = timestamp * 1000000;
+
+    if (!(fabs(usec) < MAX_MICROSECONDS))
+    {
+        return false;
+    }
+
+    return ((((double)llround(usec)) / 1000000) == timestamp);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize a Sample Block, making it empty.
+ */
+//--------------------------------------------------------------------------------------------------
+void sampleBlock_Init
+(
+    sampleBlock_Block_t* blockPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    sampleBlock_StartRead(&blockPtr->end);
+
+    // Bits are ORed into place, so the data must start out zeroed.
+    memset(blockPtr->data, 0, sizeof(blockPtr->data));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append a sample to the end of a Sample Block.
+ *
+ * @return true if appended, false if the block is full.
+ */
+//--------------------------------------------------------------------------------------------------
+bool sampleBlock_Append
+(
+    sampleBlock_Block_t* blockPtr,
+    double timestamp,
+    double value
+)
+//--------------------------------------------------------------------------------------------------
+{
+    sampleBlock_Cursor_t* endPtr = &blockPtr->end;
+    uint64_t valueBits = DoubleToBits(value);
+
+    if ((endPtr->bitOffset + MAX_SAMPLE_BITS) > BLOCK_DATA_BITS)
+    {
+        return false;
+    }
+
+    // The first sample decides how the block's timestamps are encoded.  A timestamp that can't be
+    // encoded the same way has to go in another block.
+    if (endPtr->count == 0)
+    {
+        blockPtr->isMicroseconds = IsWholeMicroseconds(timestamp);
+    }
+    else if (blockPtr->isMicroseconds && !IsWholeMicroseconds(timestamp))
+    {
+        return false;
+    }
+
+    uint64_t timestampCode = blockPtr->isMicroseconds ? (uint64_t)llround(timestamp * 1000000)
+                                                      : DoubleToBits(timestamp);
+
+    if (endPtr->count == 0)
+    {
+        WriteBits(blockPtr->data, &endPtr->bitOffset, timestampCode, 64);
+        WriteBits(blockPtr->data, &endPtr->bitOffset, valueBits, 64);
+
+        endPtr->timestampCode = timestampCode;
+        endPtr->timestampDelta = 0;
+        endPtr->valueBits = valueBits;
+        endPtr->meaningfulBits = 0;
+        endPtr->count = 1;
+
+        return true;
+    }
+
+    // Timestamp.  The arithmetic is done on unsigned integers, where it wraps around without
+    // losing anything, so the decoder gets back exactly the same bits.
+    uint64_t delta = timestampCode - endPtr->timestampCode;
+    int64_t dod = (int64_t)(delta - endPtr->timestampDelta);
+
+    if (dod == 0)
+    {
+        WriteBits(blockPtr->data, &endPtr->bitOffset, 0, 1);
+    }
+    else
+    {
+        size_t i = 0;
+
+        while (i < (DOD_ENCODING_COUNT - 1))
+        {
+            int64_t limit = (int64_t)1 << (DodEncodings[i].valueLen - 1);
+
+            if ((dod >= -limit) && (dod < limit))
+            {
+                break;
+            }
+            i++;
+        }
+
+        WriteBits(blockPtr->data, &endPtr->bitOffset, DodEncodings[i].prefix,
+                  DodEncodings[i].prefixLen);
+        WriteBits(blockPtr->data, &endPtr->bitOffset, (uint64_t)dod, DodEncodings[i].valueLen);
+    }
+
+    endPtr->timestampCode = timestampCode;
+    endPtr->timestampDelta = delta;
+
+    // Value.
+    uint64_t xor = valueBits ^ endPtr->valueBits;
+
+    if (xor == 0)
+    {
+        WriteBits(blockPtr->data, &endPtr->bitOffset, 0, 1);
+    }
+    else
+    {
+        unsigned int leadingZeros = __builtin_clzll(xor);
+        unsigned int trailingZeros = __builtin_ctzll(xor);
+
+        if (leadingZeros > MAX_LEADING_ZEROS)
+        {
+            leadingZeros = MAX_LEADING_ZEROS;
+        }
+
+        if (   (endPtr->meaningfulBits > 0)
+            && (leadingZeros >= endPtr->leadingZeros)
+            && (trailingZeros >= (64u - endPtr->leadingZeros - endPtr->meaningfulBits))  )
+        {
+            // Fits in the previous value's window.
+            unsigned int shift = 64 - endPtr->leadingZeros - endPtr->meaningfulBits;
+
+            WriteBits(blockPtr->data, &endPtr->bitOffset, 0x2, 2);
+            WriteBits(blockPtr->data, &endPtr->bitOffset, xor >> shift, endPtr->meaningfulBits);
+        }
+        else
+        {
+            unsigned int meaningfulBits = 64 - leadingZeros - trailingZeros;
+
+            WriteBits(blockPtr->data, &endPtr->bitOffset, 0x3, 2);
+            WriteBits(blockPtr->data, &endPtr->bitOffset, leadingZeros, 5);
+            WriteBits(blockPtr->data, &endPtr->bitOffset, meaningfulBits - 1, 6);
+            WriteBits(blockPtr->data, &endPtr->bitOffset, xor >> trailingZeros, meaningfulBits);
+
+            endPtr->leadingZeros = leadingZeros;
+            endPtr->meaningfulBits = meaningfulBits;
+        }
+    }
+
+    endPtr->valueBits = valueBits;
+    endPtr->count++;
+
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Position a cursor at the oldest sample in a Sample Block.
+ */
+//--------------------------------------------------------------------------------------------------
+void sampleBlock_StartRead
+(
+    sampleBlock_Cursor_t* cursorPtr     ///< [OUT] Cursor to position.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    memset(cursorPtr, 0, sizeof(*cursorPtr));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decode the sample at a cursor's position in a Sample Block and move the cursor past it.
+ * There must be a sample at the cursor's position (its count must be less than the block's).
+ */
+//--------------------------------------------------------------------------------------------------
+void sampleBlock_ReadNext
+(
+    const sampleBlock_Block_t* blockPtr,
+    sampleBlock_Cursor_t* cursorPtr,    ///< [IN/OUT] Cursor to read at and move.
+    double* timestampPtr,               ///< [OUT] Timestamp of the sample.
+    double* valuePtr                    ///< [OUT] Value of the sample.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    const uint8_t* dataPtr = blockPtr->data;
+
+    LE_ASSERT(cursorPtr->count < blockPtr->end.count);
+
+    if (cursorPtr->count == 0)
+    {
+        cursorPtr->timestampCode = ReadBits(dataPtr, &cursorPtr->bitOffset, 64);
+        cursorPtr->timestampDelta = 0;
+        cursorPtr->valueBits = ReadBits(dataPtr, &cursorPtr->bitOffset, 64);
+        cursorPtr->meaningfulBits = 0;
+    }
+    else
+    {
+        // Timestamp.  Count the 1 bits of the prefix to find out how it was encoded.
+        size_t ones = 0;
+
+        while (   (ones < DodEncodings[DOD_ENCODING_COUNT - 1].prefixLen)
+               && (ReadBits(dataPtr, &cursorPtr->bitOffset, 1) != 0)  )
+        {
+            ones++;
+        }
+
+        if (ones > 0)
+        {
+            // The last two encodings have the same number of prefix bits.
+            size_t i = (ones < DOD_ENCODING_COUNT) ? (ones - 1) : (DOD_ENCODING_COUNT - 1);
+            unsigned int len = DodEncodings[i].valueLen;
+            uint64_t bits = ReadBits(dataPtr, &cursorPtr->bitOffset, len);
+
+            // Sign-extend.
+            if ((len < 64) && (bits & ((uint64_t)1 << (len - 1))))
+            {
+                bits |= ~(uint64_t)0 << len;
+            }
+
+            cursorPtr->timestampDelta += bits;
+        }
+
+        cursorPtr->timestampCode += cursorPtr->timestampDelta;
+
+        // Value.
+        if (ReadBits(dataPtr, &cursorPtr->bitOffset, 1) != 0)
+        {
+            if (ReadBits(dataPtr, &cursorPtr->bitOffset, 1) != 0)
+            {
+                cursorPtr->leadingZeros = ReadBits(dataPtr, &cursorPtr->bitOffset, 5);
+                cursorPtr->meaningfulBits = ReadBits(dataPtr, &cursorPtr->bitOffset, 6) + 1;
+            }
+
+            unsigned int shift = 64 - cursorPtr->leadingZeros - cursorPtr->meaningfulBits;
+            uint64_t xor = ReadBits(dataPtr, &cursorPtr->bitOffset, cursorPtr->meaningfulBits);
+
+            cursorPtr->valueBits ^= xor << shift;
+        }
+    }
+
+    cursorPtr->count++;
+
+    if (blockPtr->isMicroseconds)
+    {
+        *timestampPtr = ((double)(int64_t)cursorPtr->timestampCode) / 1000000;
+    }
+    else
+    {
+        *timestampPtr = BitsToDouble(cursorPtr->timestampCode);
+    }
+    *valuePtr = BitsToDouble(cursorPtr->valueBits);
+}
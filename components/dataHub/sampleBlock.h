@@ -0,0 +1,136 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * @file sampleBlock.h
+ *
+ * Interface to the Sample Block module.
+ *
+ * A Sample Block is a fixed-size block of memory holding a sequence of timestamped numerical
+ * values in compressed form, using the scheme from Facebook's Gorilla time series database:
+ *
+ *  - Each timestamp is stored as the difference between its own delta from the previous
+ *    timestamp and the previous timestamp's delta (delta-of-delta), which is zero or very small
+ *    for samples taken at a regular interval.  The deltas are taken in whole microseconds if all
+ *    the block's timestamps are exactly that (as the ones from le_clk_GetAbsoluteTime() are), or
+ *    else between the timestamps' IEEE 754 bit patterns, which are proportional to the time for
+ *    timestamps in the same power of 2 (e.g., 2004 to 2038).  Either way, nothing is lost.
+ *  - Each value is stored as the XOR of its bit pattern with the previous value's, which is zero
+ *    for a repeated value and has only a few meaningful bits for a value that changes slowly.
+ *
+ * Samples can only be appended to the end of a block and read back in order, starting from the
+ * beginning of the block or from any position previously reached by a reader.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#ifndef SAMPLE_BLOCK_H_INCLUDE_GUARD
+#define SAMPLE_BLOCK_H_INCLUDE_GUARD
+
+
+/// Number of bytes of compressed sample data a Sample Block can hold.
+#define SAMPLE_BLOCK_DATA_BYTES 1024
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Position in a Sample Block's sequence of samples, along with what is needed to decode (or
+ * encode) the sample that follows.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t count;         ///< Number of samples before this position.
+    uint32_t bitOffset;     ///< Offset (in bits) into the data of the sample at this position.
+    uint64_t timestampCode; ///< Encoded timestamp of the sample before this position.
+    uint64_t timestampDelta;///< Difference between the last two encoded timestamps.
+    uint64_t valueBits;     ///< Bit pattern of the value of the sample before this position.
+    uint8_t leadingZeros;   ///< Leading zeros in the last value XOR window (if meaningfulBits > 0).
+    uint8_t meaningfulBits; ///< Width of the last value XOR window (0 = no window yet).
+}
+sampleBlock_Cursor_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * A block of compressed samples.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    sampleBlock_Cursor_t end;               ///< Position after the newest sample in the block.
+    bool isMicroseconds;    ///< true = timestamps encoded in microseconds, false = as bit patterns.
+    uint8_t data[SAMPLE_BLOCK_DATA_BYTES];  ///< Compressed sample data.
+}
+sampleBlock_Block_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize a Sample Block, making it empty.
+ */
+//--------------------------------------------------------------------------------------------------
+void sampleBlock_Init
+(
+    sampleBlock_Block_t* blockPtr
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append a sample to the end of a Sample Block.
+ *
+ * @return true if appended, false if the block is full.
+ */
+//--------------------------------------------------------------------------------------------------
+bool sampleBlock_Append
+(
+    sampleBlock_Block_t* blockPtr,
+    double timestamp,
+    double value
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of samples in a Sample Block.
+ *
+ * @return The number of samples.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline uint32_t sampleBlock_GetCount
+(
+    const sampleBlock_Block_t* blockPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return blockPtr->end.count;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Position a cursor at the oldest sample in a Sample Block.
+ */
+//--------------------------------------------------------------------------------------------------
+void sampleBlock_StartRead
+(
+    sampleBlock_Cursor_t* cursorPtr     ///< [OUT] Cursor to position.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decode the sample at a cursor's position in a Sample Block and move the cursor past it.
+ * There must be a sample at the cursor's position (its count must be less than the block's).
+ */
+//--------------------------------------------------------------------------------------------------
+void sampleBlock_ReadNext
+(
+    const sampleBlock_Block_t* blockPtr,
+    sampleBlock_Cursor_t* cursorPtr,    ///< [IN/OUT] Cursor to read at and move.
+    double* timestampPtr,               ///< [OUT] Timestamp of the sample.
+    double* valuePtr                    ///< [OUT] Value of the sample.
+);
+
+
+#endif // SAMPLE_BLOCK_H_INCLUDE_GUARD
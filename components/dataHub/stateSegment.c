@@ -0,0 +1,384 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * Implementation of the State Segment module, which keeps an image of the Data Hub's state in a
+ * named shared memory segment that survives the Data Hub process being restarted.
+ *
+ * The segment starts with a header (Header_t), followed by two slots of STATE_SEGMENT_SLOT_BYTES
+ * each.  A new image is always stored in the slot that isn't active, and the header is only
+ * switched over to it once the image and its CRC are complete.  Pages of the segment are only
+ * allocated once they are written to, so the slots cost no more memory than the images in them.
+ *
+ * The layout of the header and slots is versioned (STATE_SEGMENT_VERSION), and a segment with
+ * any other layout (such as one left by a different version of the Data Hub) is deleted rather
+ * than used.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#include "interfaces.h"
+#include "dataHub.h"
+#include "stateSegment.h"
+
+#if LE_CONFIG_LINUX
+#   include <sys/mman.h>
+#endif
+
+/// Name of the shared memory segment.
+#define STATE_SEGMENT_NAME "/dataHub.state"
+
+/// Magic number at the start of the segment.
+#define STATE_SEGMENT_MAGIC "DHSS"
+
+/// Version of the layout of the segment.  Must be changed whenever the layout is.
+#define STATE_SEGMENT_VERSION 1
+
+/// Capacity of each of the segment's two slots, in bytes.
+#define STATE_SEGMENT_SLOT_BYTES (16 * 1024 * 1024)
+
+/// Value of the header's activeSlot when no slot holds an image.
+#define NO_SLOT UINT32_MAX
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Description of the image stored in a slot.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t size;          ///< Number of bytes in the image.
+    uint32_t crc;           ///< CRC-32 of the image.
+    double storedTime;      ///< Time the image was stored (seconds since the Epoch).
+}
+Slot_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Header at the start of the segment.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    char magic[4];          ///< STATE_SEGMENT_MAGIC.
+    uint16_t version;       ///< STATE_SEGMENT_VERSION.
+    uint16_t headerBytes;   ///< Size of the header, as a check that the layout is the same.
+    uint32_t slotBytes;     ///< Capacity of each slot, in bytes.
+    uint32_t activeSlot;    ///< Index of the slot holding the latest image, or NO_SLOT.
+    Slot_t slots[2];        ///< Descriptions of the images in the slots.
+}
+Header_t;
+
+
+#if LE_CONFIG_LINUX
+/// The segment's header, where the segment is mapped into memory, or NULL if not mapped.
+static Header_t* HeaderPtr = NULL;
+
+/// true if the active slot holds an image stored by this process.
+static bool IsImageStored = false;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of bytes in the segment.
+ *
+ * @return The number of bytes.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t GetSegmentBytes
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return sizeof(Header_t) + (2 * (size_t)STATE_SEGMENT_SLOT_BYTES);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get a pointer to the contents of one of the segment's slots.
+ *
+ * @return The pointer.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint8_t* GetSlotData
+(
+    uint32_t slot
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return (uint8_t*)(HeaderPtr + 1) + (slot * (size_t)STATE_SEGMENT_SLOT_BYTES);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Map the segment into memory.
+ *
+ * @return Pointer to the segment's header, or NULL if failed.
+ */
+//--------------------------------------------------------------------------------------------------
+static Header_t* MapSegment
+(
+    int fd
+)
+//--------------------------------------------------------------------------------------------------
+{
+    void* mapPtr = mmap(NULL, GetSegmentBytes(), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapPtr == MAP_FAILED)
+    {
+        LE_CRIT("Failed to map shared memory segment '" STATE_SEGMENT_NAME "' (%m).");
+        return NULL;
+    }
+
+    return mapPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create the segment, holding no image.
+ *
+ * @return LE_OK if successful, LE_FAULT if failed.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t CreateSegment
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    int fd = shm_open(STATE_SEGMENT_NAME, O_RDWR | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+    if (fd < 0)
+    {
+        LE_CRIT("Unable to create shared memory segment '" STATE_SEGMENT_NAME "' (%m).");
+        return LE_FAULT;
+    }
+
+    if (ftruncate(fd, GetSegmentBytes()) != 0)
+    {
+        LE_CRIT("Unable to size shared memory segment '" STATE_SEGMENT_NAME "' (%m).");
+        close(fd);
+        (void)shm_unlink(STATE_SEGMENT_NAME);
+        return LE_FAULT;
+    }
+
+    HeaderPtr = MapSegment(fd);
+    close(fd);
+    if (HeaderPtr == NULL)
+    {
+        (void)shm_unlink(STATE_SEGMENT_NAME);
+        return LE_FAULT;
+    }
+
+    // The segment starts out zeroed, so until the magic number is written, it isn't recognized.
+    HeaderPtr->version = STATE_SEGMENT_VERSION;
+    HeaderPtr->headerBytes = sizeof(Header_t);
+    HeaderPtr->slotBytes = STATE_SEGMENT_SLOT_BYTES;
+    HeaderPtr->activeSlot = NO_SLOT;
+    memcpy(HeaderPtr->magic, STATE_SEGMENT_MAGIC, sizeof(HeaderPtr->magic));
+
+    return LE_OK;
+}
+#endif /* end LE_CONFIG_LINUX */
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize the State Segment module, attaching to the segment left by a previous run of the
+ * Data Hub, if there is one and its layout is the one expected.
+ */
+//--------------------------------------------------------------------------------------------------
+void stateSegment_Init
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+#if LE_CONFIG_LINUX
+    int fd = shm_open(STATE_SEGMENT_NAME, O_RDWR, 0);
+    if (fd < 0)
+    {
+        if (errno != ENOENT)
+        {
+            LE_ERROR("Unable to open shared memory segment '" STATE_SEGMENT_NAME "' (%m).");
+        }
+        return;
+    }
+
+    struct stat st;
+    if ((fstat(fd, &st) == 0) && (st.st_size == (off_t)GetSegmentBytes()))
+    {
+        HeaderPtr = MapSegment(fd);
+    }
+    close(fd);
+
+    if (   (HeaderPtr == NULL)
+        || (memcmp(HeaderPtr->magic, STATE_SEGMENT_MAGIC, sizeof(HeaderPtr->magic)) != 0)
+        || (HeaderPtr->version != STATE_SEGMENT_VERSION)
+        || (HeaderPtr->headerBytes != sizeof(Header_t))
+        || (HeaderPtr->slotBytes != STATE_SEGMENT_SLOT_BYTES)  )
+    {
+        LE_WARN("Shared memory segment '" STATE_SEGMENT_NAME "' has an unknown layout."
+                " Deleting it.");
+        stateSegment_Delete();
+    }
+#endif /* end LE_CONFIG_LINUX */
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the image last stored in the segment, after checking that it is intact.
+ *
+ * @return Pointer to the image (valid until the next image is stored or the segment is deleted),
+ *         or NULL if there is none.
+ */
+//--------------------------------------------------------------------------------------------------
+const uint8_t* stateSegment_GetImage
+(
+    size_t* sizePtr,        ///< [OUT] Number of bytes in the image.
+    double* storedTimePtr   ///< [OUT] Time the image was stored (seconds since the Epoch).
+)
+//--------------------------------------------------------------------------------------------------
+{
+#if LE_CONFIG_LINUX
+    if ((HeaderPtr == NULL) || (HeaderPtr->activeSlot >= NUM_ARRAY_MEMBERS(HeaderPtr->slots)))
+    {
+        return NULL;
+    }
+
+    uint32_t slot = HeaderPtr->activeSlot;
+    const Slot_t* slotPtr = &HeaderPtr->slots[slot];
+    const uint8_t* dataPtr = GetSlotData(slot);
+
+    if (   (slotPtr->size > STATE_SEGMENT_SLOT_BYTES)
+        || (slotPtr->crc != le_crc_Crc32(dataPtr, slotPtr->size, LE_CRC_START_CRC32))  )
+    {
+        LE_CRIT("Shared memory segment '" STATE_SEGMENT_NAME "' is damaged. Ignoring it.");
+        return NULL;
+    }
+
+    *sizePtr = slotPtr->size;
+    *storedTimePtr = slotPtr->storedTime;
+    return dataPtr;
+#else /* !LE_CONFIG_LINUX */
+    LE_UNUSED(sizePtr);
+    LE_UNUSED(storedTimePtr);
+    return NULL;
+#endif /* end !LE_CONFIG_LINUX */
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the image that this process last stored in the segment, without checking it.  Parts of it
+ * can be copied into the next image, rather than being built again.
+ *
+ * @return Pointer to the image (valid until the next image is stored or the segment is deleted),
+ *         or NULL if none has been stored since the Data Hub started (or the last one didn't fit).
+ */
+//--------------------------------------------------------------------------------------------------
+const uint8_t* stateSegment_GetStoredImage
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+#if LE_CONFIG_LINUX
+    if (!IsImageStored)
+    {
+        return NULL;
+    }
+
+    return GetSlotData(HeaderPtr->activeSlot);
+#else /* !LE_CONFIG_LINUX */
+    return NULL;
+#endif /* end !LE_CONFIG_LINUX */
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Store an image in the segment, replacing the one stored before it.  The segment is created if
+ * it doesn't exist.  Images are limited to STATE_SEGMENT_SLOT_BYTES (16 MB).
+ *
+ * @return
+ *  - LE_OK if successful.
+ *  - LE_OVERFLOW if the image is too big for the segment (in which case the segment is left
+ *    holding no image, so an out-of-date one isn't used).
+ *  - LE_FAULT if the segment could not be created.
+ *  - LE_NOT_IMPLEMENTED if shared memory isn't supported on this platform.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t stateSegment_Store
+(
+    backupWriter_ImageRef_t imageRef    ///< Complete image (with any reserved bytes filled in).
+)
+//--------------------------------------------------------------------------------------------------
+{
+#if LE_CONFIG_LINUX
+    if ((HeaderPtr == NULL) && (CreateSegment() != LE_OK))
+    {
+        return LE_FAULT;
+    }
+
+    size_t size = backupWriter_GetSize(imageRef);
+    if (size > STATE_SEGMENT_SLOT_BYTES)
+    {
+        HeaderPtr->activeSlot = NO_SLOT;
+        IsImageStored = false;
+        return LE_OVERFLOW;
+    }
+
+    uint32_t slot = ((HeaderPtr->activeSlot == 0) ? 1 : 0);
+    Slot_t* slotPtr = &HeaderPtr->slots[slot];
+    uint8_t* dataPtr = GetSlotData(slot);
+    le_clk_Time_t now = le_clk_GetAbsoluteTime();
+
+    backupWriter_CopyToBuffer(imageRef, dataPtr);
+    slotPtr->size = size;
+    slotPtr->crc = le_crc_Crc32(dataPtr, size, LE_CRC_START_CRC32);
+    slotPtr->storedTime = now.sec + ((double)now.usec / 1000000);
+
+    // The new image only takes over once it is complete, so if the Data Hub fails while storing
+    // it, the previous one is used instead.
+    __atomic_store_n(&HeaderPtr->activeSlot, slot, __ATOMIC_RELEASE);
+    IsImageStored = true;
+
+    return LE_OK;
+#else /* !LE_CONFIG_LINUX */
+    LE_UNUSED(imageRef);
+    return LE_NOT_IMPLEMENTED;
+#endif /* end !LE_CONFIG_LINUX */
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Delete the segment, if there is one, so that the image in it isn't used when the Data Hub
+ * next starts.
+ */
+//--------------------------------------------------------------------------------------------------
+void stateSegment_Delete
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+#if LE_CONFIG_LINUX
+    if (HeaderPtr != NULL)
+    {
+        (void)munmap(HeaderPtr, GetSegmentBytes());
+        HeaderPtr = NULL;
+    }
+    IsImageStored = false;
+
+    if ((shm_unlink(STATE_SEGMENT_NAME) != 0) && (errno != ENOENT))
+    {
+        LE_ERROR("Unable to delete shared memory segment '" STATE_SEGMENT_NAME "' (%m).");
+    }
+#endif /* end LE_CONFIG_LINUX */
+}
@@ -0,0 +1,96 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * @file stateSegment.h
+ *
+ * Interface to the State Segment module.
+ *
+ * The State Segment is a named shared memory segment that outlives the Data Hub process, so that
+ * if the Data Hub fails and is restarted, it can pick up its state from memory rather than reading
+ * it back from flash.  It holds one image of the state at a time (see checkpoint.c for what is
+ * in it), and is double-buffered, so if the Data Hub fails while storing a new image, the previous
+ * one is still intact.  The segment does not survive a reboot.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#ifndef STATE_SEGMENT_H_INCLUDE_GUARD
+#define STATE_SEGMENT_H_INCLUDE_GUARD
+
+#include "backupWriter.h"
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize the State Segment module, attaching to the segment left by a previous run of the
+ * Data Hub, if there is one and its layout is the one expected.
+ */
+//--------------------------------------------------------------------------------------------------
+void stateSegment_Init
+(
+    void
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the image last stored in the segment, after checking that it is intact.
+ *
+ * @return Pointer to the image (valid until the next image is stored or the segment is deleted),
+ *         or NULL if there is none.
+ */
+//--------------------------------------------------------------------------------------------------
+const uint8_t* stateSegment_GetImage
+(
+    size_t* sizePtr,        ///< [OUT] Number of bytes in the image.
+    double* storedTimePtr   ///< [OUT] Time the image was stored (seconds since the Epoch).
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the image that this process last stored in the segment, without checking it.  Parts of it
+ * can be copied into the next image, rather than being built again.
+ *
+ * @return Pointer to the image (valid until the next image is stored or the segment is deleted),
+ *         or NULL if none has been stored since the Data Hub started (or the last one didn't fit).
+ */
+//--------------------------------------------------------------------------------------------------
+const uint8_t* stateSegment_GetStoredImage
+(
+    void
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Store an image in the segment, replacing the one stored before it.  The segment is created if
+ * it doesn't exist.  Images are limited to STATE_SEGMENT_SLOT_BYTES (16 MB).
+ *
+ * @return
+ *  - LE_OK if successful.
+ *  - LE_OVERFLOW if the image is too big for the segment (in which case the segment is left
+ *    holding no image, so an out-of-date one isn't used).
+ *  - LE_FAULT if the segment could not be created.
+ *  - LE_NOT_IMPLEMENTED if shared memory isn't supported on this platform.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t stateSegment_Store
+(
+    backupWriter_ImageRef_t imageRef    ///< Complete image (with any reserved bytes filled in).
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Delete the segment, if there is one, so that the image in it isn't used when the Data Hub
+ * next starts.
+ */
+//--------------------------------------------------------------------------------------------------
+void stateSegment_Delete
+(
+    void
+);
+
+
+#endif // STATE_SEGMENT_H_INCLUDE_GUARD
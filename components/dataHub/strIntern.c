@@ -0,0 +1,329 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * @file strIntern.c
+ *
+ * Implementation of interned strings.
+ *
+ * Each interned string is a reference-counted block holding the text, found through a hash table
+ * of all interned strings.  The blocks come from a small, a medium and a large pool, so a short
+ * string doesn't take up as much space as the longest string allowed.  The hash table is doubled
+ * in size whenever there are more strings than buckets.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#include "dataHub.h"
+#include "strIntern.h"
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * An interned string.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct InternedStr
+{
+    struct InternedStr* nextPtr;    ///< Next string in the same bucket of the hash table.
+    uint32_t hash;                  ///< Hash of the text.
+    char text[];                    ///< The text (null-terminated).
+}
+InternedStr_t;
+
+/// Size of the largest interned string blocks.
+#define STR_LARGE_BYTES (offsetof(InternedStr_t, text) + STR_INTERN_MAX_BYTES)
+/// Size of medium sized interned string blocks.
+#define STR_MED_BYTES   (offsetof(InternedStr_t, text) + (STR_INTERN_MAX_BYTES / 2))
+/// Size of small interned string blocks.
+#define STR_SMALL_BYTES (offsetof(InternedStr_t, text) + (STR_INTERN_MAX_BYTES / 4))
+
+/// Default number of large interned string blocks.  This may be overridden in the .cdef.
+#define DEFAULT_INTERNED_STRING_POOL_SIZE 10
+
+/// Number of medium interned string blocks.
+#define MED_STR_POOL_SIZE                                                                   \
+    (((LE_MEM_BLOCKS(InternedStrPool, DEFAULT_INTERNED_STRING_POOL_SIZE) / 2) * STR_LARGE_BYTES) \
+        / STR_MED_BYTES)
+
+/// Number of small interned string blocks.
+#define SMALL_STR_POOL_SIZE (((MED_STR_POOL_SIZE / 2) * STR_MED_BYTES) / STR_SMALL_BYTES)
+
+/// Pool of interned strings (the smallest of the layered pools, once initialized).
+static le_mem_PoolRef_t InternedStrPool = NULL;
+LE_MEM_DEFINE_STATIC_POOL(InternedStrPool, DEFAULT_INTERNED_STRING_POOL_SIZE, STR_LARGE_BYTES);
+
+/// log2 of the smallest and largest number of buckets in the hash table.
+#define MIN_TABLE_BITS 6
+#define MAX_TABLE_BITS 20
+
+/// Number of hash table sizes (and pools).
+#define TABLE_POOL_COUNT (MAX_TABLE_BITS - MIN_TABLE_BITS + 1)
+
+/// Pools of hash table bucket arrays, one per power-of-2 size.  Created when first needed.
+static le_mem_PoolRef_t TablePools[TABLE_POOL_COUNT];
+
+/// Hash table of all interned strings.
+static InternedStr_t** Table = NULL;
+
+/// log2 of the number of buckets in the hash table.
+static uint8_t TableBits = 0;
+
+/// Number of strings in the hash table.
+static size_t StrCount = 0;
+
+/// The empty string, which is never allocated.
+static const char EmptyStr[] = "";
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compute the hash of a string (32-bit FNV-1a).
+ *
+ * @return The hash.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t HashStr
+(
+    const char* str
+)
+//--------------------------------------------------------------------------------------------------
+{
+    uint32_t hash = 2166136261u;
+
+    for (; *str != '\0'; str++)
+    {
+        hash = (hash ^ (uint8_t)*str) * 16777619u;
+    }
+
+    return hash;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the bucket of the hash table a given hash falls in.
+ *
+ * @return Pointer to the bucket.
+ */
+//--------------------------------------------------------------------------------------------------
+static InternedStr_t** GetBucket
+(
+    uint32_t hash
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return &Table[hash & (((uint32_t)1 << TableBits) - 1)];
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Replace the hash table (if there is one) with a new one with a given number of buckets, holding
+ * all the strings in the old one.
+ *
+ * @return true if successful, false if out of memory (in which case the old table is kept).
+ */
+//--------------------------------------------------------------------------------------------------
+static bool RebuildTable
+(
+    uint8_t bits    ///< log2 of the number of buckets in the new table.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LE_ASSERT((bits >= MIN_TABLE_BITS) && (bits <= MAX_TABLE_BITS));
+
+    le_mem_PoolRef_t* poolRefPtr = &TablePools[bits - MIN_TABLE_BITS];
+
+    if (*poolRefPtr == NULL)
+    {
+        char name[32];
+        (void)snprintf(name, sizeof(name), "StrTable%zu", (size_t)1 << bits);
+
+        *poolRefPtr = le_mem_CreatePool(name, ((size_t)1 << bits) * sizeof(InternedStr_t*));
+    }
+
+    InternedStr_t** newTable = hub_MemAlloc(*poolRefPtr);
+
+#if !LE_CONFIG_LINUX
+    // Table pools are created empty, so grow them on demand.
+    if (newTable == NULL)
+    {
+        le_mem_ExpandPool(*poolRefPtr, 1);
+        newTable = le_mem_TryAlloc(*poolRefPtr);
+    }
+#endif
+
+    if (newTable == NULL)
+    {
+        LE_WARN("Out of memory for the table of %zu interned strings.", StrCount);
+        return false;
+    }
+
+    memset(newTable, 0, ((size_t)1 << bits) * sizeof(InternedStr_t*));
+
+    InternedStr_t** oldTable = Table;
+    size_t oldBuckets = ((oldTable != NULL) ? ((size_t)1 << TableBits) : 0);
+
+    Table = newTable;
+    TableBits = bits;
+
+    for (size_t i = 0; i < oldBuckets; i++)
+    {
+        InternedStr_t* strPtr = oldTable[i];
+
+        while (strPtr != NULL)
+        {
+            InternedStr_t* nextPtr = strPtr->nextPtr;
+            InternedStr_t** bucketPtr = GetBucket(strPtr->hash);
+
+            strPtr->nextPtr = *bucketPtr;
+            *bucketPtr = strPtr;
+
+            strPtr = nextPtr;
+        }
+    }
+
+    if (oldTable != NULL)
+    {
+        le_mem_Release(oldTable);
+    }
+
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Destructor for interned strings.  Removes the string from the hash table.
+ */
+//--------------------------------------------------------------------------------------------------
+static void InternedStrDestructor
+(
+    void* objPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    InternedStr_t* strPtr = objPtr;
+    InternedStr_t** linkPtrPtr = GetBucket(strPtr->hash);
+
+    while (*linkPtrPtr != strPtr)
+    {
+        LE_ASSERT(*linkPtrPtr != NULL);
+        linkPtrPtr = &(*linkPtrPtr)->nextPtr;
+    }
+
+    *linkPtrPtr = strPtr->nextPtr;
+    StrCount--;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize the String Interning module.
+ *
+ * @warning This function must be called before any others in this module.
+ */
+//--------------------------------------------------------------------------------------------------
+void strIntern_Init
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_mem_PoolRef_t largePool = le_mem_InitStaticPool(InternedStrPool,
+                                    DEFAULT_INTERNED_STRING_POOL_SIZE, STR_LARGE_BYTES);
+    le_mem_PoolRef_t medPool = le_mem_CreateReducedPool(largePool, "MedInternedStrPool",
+                                  MED_STR_POOL_SIZE, STR_MED_BYTES);
+    InternedStrPool = le_mem_CreateReducedPool(medPool, "SmallInternedStrPool",
+                        SMALL_STR_POOL_SIZE, STR_SMALL_BYTES);
+
+    le_mem_SetDestructor(largePool, InternedStrDestructor);
+    le_mem_SetDestructor(medPool, InternedStrDestructor);
+    le_mem_SetDestructor(InternedStrPool, InternedStrDestructor);
+
+    LE_ASSERT(RebuildTable(MIN_TABLE_BITS));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the interned copy of a string, adding it if it isn't interned already.  The caller gets a
+ * reference to it, which must be released using strIntern_Release() when no longer needed.
+ *
+ * @return Pointer to the interned string, or NULL if out of memory.
+ */
+//--------------------------------------------------------------------------------------------------
+const char* strIntern_Get
+(
+    const char* str ///< The string (must be shorter than STR_INTERN_MAX_BYTES).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (str[0] == '\0')
+    {
+        return EmptyStr;
+    }
+
+    uint32_t hash = HashStr(str);
+    InternedStr_t* strPtr = *GetBucket(hash);
+
+    while (strPtr != NULL)
+    {
+        if ((strPtr->hash == hash) && (strcmp(strPtr->text, str) == 0))
+        {
+            le_mem_AddRef(strPtr);
+            return strPtr->text;
+        }
+
+        strPtr = strPtr->nextPtr;
+    }
+
+    size_t len = strlen(str);
+    LE_ASSERT(len < STR_INTERN_MAX_BYTES);
+
+#if LE_CONFIG_LINUX
+    strPtr = le_mem_VarAlloc(InternedStrPool, offsetof(InternedStr_t, text) + len + 1);
+#else
+    strPtr = le_mem_TryVarAlloc(InternedStrPool, offsetof(InternedStr_t, text) + len + 1);
+#endif
+
+    if (strPtr == NULL)
+    {
+        LE_WARN("Failed to allocate an interned string.");
+        return NULL;
+    }
+
+    strPtr->hash = hash;
+    memcpy(strPtr->text, str, len + 1);
+
+    InternedStr_t** bucketPtr = GetBucket(hash);
+    strPtr->nextPtr = *bucketPtr;
+    *bucketPtr = strPtr;
+    StrCount++;
+
+    // If this fails, chains just get longer.
+    if ((StrCount > ((size_t)1 << TableBits)) && (TableBits < MAX_TABLE_BITS))
+    {
+        (void)RebuildTable(TableBits + 1);
+    }
+
+    return strPtr->text;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Release a reference to an interned string.  The string is deleted once it has no references.
+ */
+//--------------------------------------------------------------------------------------------------
+void strIntern_Release
+(
+    const char* str ///< The interned string.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (str != EmptyStr)
+    {
+        le_mem_Release(CONTAINER_OF(str, InternedStr_t, text));
+    }
+}
@@ -0,0 +1,62 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * @file strIntern.h
+ *
+ * Interned strings, used for the names of resource tree entries and the units of resources.
+ *
+ * Each distinct string is stored only once, in a block just big enough for it, and shared by all
+ * its users.  So, two interned strings are equal if, and only if, they are the same pointer.
+ * Interned strings are reference counted, and must not be modified.
+ *
+ * The empty string ("") is never allocated, so interning it can't fail.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#ifndef STR_INTERN_H_INCLUDE_GUARD
+#define STR_INTERN_H_INCLUDE_GUARD
+
+/// Size of the largest string that can be interned, including its null terminator.
+#define STR_INTERN_MAX_BYTES HUB_MAX_ENTRY_NAME_BYTES
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize the String Interning module.
+ *
+ * @warning This function must be called before any others in this module.
+ */
+//--------------------------------------------------------------------------------------------------
+void strIntern_Init
+(
+    void
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the interned copy of a string, adding it if it isn't interned already.  The caller gets a
+ * reference to it, which must be released using strIntern_Release() when no longer needed.
+ *
+ * @return Pointer to the interned string, or NULL if out of memory.
+ */
+//--------------------------------------------------------------------------------------------------
+const char* strIntern_Get
+(
+    const char* str ///< The string (must be shorter than STR_INTERN_MAX_BYTES).
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Release a reference to an interned string.  The string is deleted once it has no references.
+ */
+//--------------------------------------------------------------------------------------------------
+void strIntern_Release
+(
+    const char* str ///< The interned string.
+);
+
+
+#endif // STR_INTERN_H_INCLUDE_GUARD
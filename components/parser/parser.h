@@ -53,6 +53,12 @@
 #define PARSER_OBS_TRANSFORM_MASK               (0x80)
 #define PARSER_OBS_JSON_EXT_POS                 (8)
 #define PARSER_OBS_JSON_EXT_MASK                (0x100)
+#define PARSER_OBS_BUFFER_MAX_AGE_POS           (9)
+#define PARSER_OBS_BUFFER_MAX_AGE_MASK          (0x200)
+#define PARSER_OBS_BUFFER_MAX_BYTES_POS         (10)
+#define PARSER_OBS_BUFFER_MAX_BYTES_MASK        (0x400)
+#define PARSER_OBS_BUFFER_COMPRESSION_POS       (11)
+#define PARSER_OBS_BUFFER_COMPRESSION_MASK      (0x800)
 
 
 //--------------------------------------------------------------------------------------------------
@@ -81,6 +87,9 @@ typedef struct ParseEnv* Parser_ParseSessionRef_t;
  * default value:
  * minPeriod, changeBy, lowerThan, and greaterThan: NAN
  * bufferMaxCount: 0
+ * bufferMaxAge: NAN
+ * bufferMaxBytes: 0
+ * bufferCompression: false
  * transform: ADMIN_OBS_TRANSFORM_TYPE_NONE
  * jsonExtraction: '/0'
  */
@@ -97,6 +106,9 @@ typedef struct parser_ObsData
     double lowerThan;                                   ///< Value of "lt"
     double greaterThan;                                 ///< Value of "gt"
     uint32_t bufferMaxCount;                            ///< Value of "b"
+    double bufferMaxAge;                                ///< Value of "ba"
+    uint32_t bufferMaxBytes;                            ///< Value of "bb"
+    bool bufferCompression;                             ///< Value of "bc"
     admin_TransformType_t transform;                    ///< Value of "f"
     char jsonExtraction[PARSER_OBS_JSON_EX_MAX_BYTES];  ///< Value of "s"
 } parser_ObsData_t;
@@ -68,6 +68,9 @@ static void ExpectObsChangeBy         (le_json_Event_t event);
 static void ExpectObsLowerThan        (le_json_Event_t event);
 static void ExpectObsGreaterThan      (le_json_Event_t event);
 static void ExpectObsMaxBuffer        (le_json_Event_t event);
+static void ExpectObsBufferMaxAge     (le_json_Event_t event);
+static void ExpectObsBufferMaxBytes   (le_json_Event_t event);
+static void ExpectObsBufferCompression(le_json_Event_t event);
 static void ExpectObsTransformFunction(le_json_Event_t event);
 static void ExpectObsJsonExtraction   (le_json_Event_t event);
 static void ExpectObsMember           (le_json_Event_t event);
@@ -413,6 +416,87 @@ static void ExpectObsMaxBuffer
     }
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ *  le_json event handler that expects the "ba" member of an observation.
+ * This field holds the maximum buffer age (in seconds) of an observation.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ExpectObsBufferMaxAge
+(
+    le_json_Event_t event                          ///< [IN] The le_json event.
+)
+{
+    ParseEnv_t* parseEnvPtr = le_json_GetOpaquePtr();
+    if (event == LE_JSON_NUMBER)
+    {
+        // set the bitmask to we know we've received this field:
+        parseEnvPtr->tempStorage.o.bitmask |= PARSER_OBS_BUFFER_MAX_AGE_MASK;
+        // cache the value in temp storage:
+        parseEnvPtr->tempStorage.o.bufferMaxAge = le_json_GetNumber();
+
+        GoToNextState(ExpectObsMember);
+    }
+    else
+    {
+        HandleError(LE_FORMAT_ERROR, "Unexpected JSON element found");
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  le_json event handler that expects the "bb" member of an observation.
+ * This field holds the maximum buffer size (in bytes) of an observation.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ExpectObsBufferMaxBytes
+(
+    le_json_Event_t event                          ///< [IN] The le_json event.
+)
+{
+    ParseEnv_t* parseEnvPtr = le_json_GetOpaquePtr();
+    if (event == LE_JSON_NUMBER)
+    {
+        // set the bitmask to we know we've received this field:
+        parseEnvPtr->tempStorage.o.bitmask |= PARSER_OBS_BUFFER_MAX_BYTES_MASK;
+        // cache the value in temp storage:
+        parseEnvPtr->tempStorage.o.bufferMaxBytes = le_json_GetNumber();
+
+        GoToNextState(ExpectObsMember);
+    }
+    else
+    {
+        HandleError(LE_FORMAT_ERROR, "Unexpected JSON element found");
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  le_json event handler that expects the "bc" member of an observation.
+ * This field holds whether the buffer of an observation is compressed.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ExpectObsBufferCompression
+(
+    le_json_Event_t event                          ///< [IN] The le_json event.
+)
+{
+    ParseEnv_t* parseEnvPtr = le_json_GetOpaquePtr();
+    if ((event == LE_JSON_TRUE) || (event == LE_JSON_FALSE))
+    {
+        // set the bitmask to we know we've received this field:
+        parseEnvPtr->tempStorage.o.bitmask |= PARSER_OBS_BUFFER_COMPRESSION_MASK;
+        // cache the value in temp storage:
+        parseEnvPtr->tempStorage.o.bufferCompression = (event == LE_JSON_TRUE);
+
+        GoToNextState(ExpectObsMember);
+    }
+    else
+    {
+        HandleError(LE_FORMAT_ERROR, "Unexpected JSON element found");
+    }
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Convert function text to transform type:
@@ -558,6 +642,18 @@ static void ObsMemberHelper
     {
         GoToNextState(ExpectObsMaxBuffer);
     }
+    else if (strcmp(memberName, "ba") == 0)
+    {
+        GoToNextState(ExpectObsBufferMaxAge);
+    }
+    else if (strcmp(memberName, "bb") == 0)
+    {
+        GoToNextState(ExpectObsBufferMaxBytes);
+    }
+    else if (strcmp(memberName, "bc") == 0)
+    {
+        GoToNextState(ExpectObsBufferCompression);
+    }
     else if (strcmp(memberName, "f") == 0)
     {
         GoToNextState(ExpectObsTransformFunction);
@@ -618,6 +714,18 @@ static void ExpectObsMember
             {
                 parseEnvPtr->tempStorage.o.bufferMaxCount = 0;
             }
+            if (!(parseEnvPtr->tempStorage.o.bitmask & PARSER_OBS_BUFFER_MAX_AGE_MASK))
+            {
+                parseEnvPtr->tempStorage.o.bufferMaxAge = NAN;
+            }
+            if (!(parseEnvPtr->tempStorage.o.bitmask & PARSER_OBS_BUFFER_MAX_BYTES_MASK))
+            {
+                parseEnvPtr->tempStorage.o.bufferMaxBytes = 0;
+            }
+            if (!(parseEnvPtr->tempStorage.o.bitmask & PARSER_OBS_BUFFER_COMPRESSION_MASK))
+            {
+                parseEnvPtr->tempStorage.o.bufferCompression = false;
+            }
             if (!(parseEnvPtr->tempStorage.o.bitmask & PARSER_OBS_TRANSFORM_MASK))
             {
                 parseEnvPtr->tempStorage.o.transform = ADMIN_OBS_TRANSFORM_TYPE_NONE;
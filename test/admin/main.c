@@ -2,7 +2,12 @@
  * @file main.c
  *
  * unit test admin API functions:
- *  CreateInput, CreateOutput, DeleteResource, SetJsonExample and MarkOptional
+ *  CreateInput, CreateOutput, DeleteResource, SetJsonExample and MarkOptional,
+ *  including in a namespace with thousands of children, and through the path lookup cache
+ *
+ * the resource handles behind query_OpenResource() and the ByHandle query API functions,
+ *
+ * and the Observation buffers behind the query API functions.
  *
  * Copyright (C) Sierra Wireless, Inc. Use of this work is subject to license.
  */
@@ -13,9 +18,16 @@
 #include <stdlib.h>
 #include <cmocka.h>
 #include <limits.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include "legato.h"
 #include "interfaces.h"
+#include "dataHub.h"
+#include "resHandle.h"
 
 extern void initDataHub(void);
+extern int hub_MemAllocFailCountdown;
 
 static int setup(void **state) {
     // Init Data Hub component
@@ -246,6 +258,1032 @@ static void test_admin_set_json_example
     }
 }
 
+/* Namespaces with many children */
+
+// Enough children for the namespace's index of them to be grown many times over.
+#define SIBLING_COUNT 3000
+
+// Get the path of one of the siblings.
+static void GetSiblingPath
+(
+    char* path,
+    size_t size,
+    uint32_t i
+)
+{
+    snprintf(path, size, "/app/siblings/value%" PRIu32, i);
+}
+
+// Check that every sibling is found as the expected type of entry, or not found if deleted.
+static void CheckSiblings
+(
+    const admin_EntryType_t* types
+)
+{
+    char path[IO_MAX_RESOURCE_PATH_LEN + 1];
+
+    for (uint32_t i = 0; i < SIBLING_COUNT; i++)
+    {
+        GetSiblingPath(path, sizeof(path), i);
+        assert_int_equal(admin_GetEntryType(path), types[i]);
+    }
+    GetSiblingPath(path, sizeof(path), SIBLING_COUNT);
+    assert_int_equal(admin_GetEntryType(path), ADMIN_ENTRY_TYPE_NONE);
+}
+
+static void test_admin_many_siblings
+(
+    void** state
+)
+{
+    (void)state;
+    char path[IO_MAX_RESOURCE_PATH_LEN + 1];
+    static admin_EntryType_t types[SIBLING_COUNT];
+
+    for (uint32_t i = 0; i < SIBLING_COUNT; i++)
+    {
+        GetSiblingPath(path, sizeof(path), i);
+        assert_int_equal(admin_CreateInput(path, IO_DATA_TYPE_NUMERIC, ""), LE_OK);
+        types[i] = ADMIN_ENTRY_TYPE_INPUT;
+    }
+    CheckSiblings(types);
+
+    // Delete two out of every three, in an order unrelated to the order they were created in.
+    for (uint32_t j = 0; j < SIBLING_COUNT; j++)
+    {
+        uint32_t i = (j * 7919) % SIBLING_COUNT;
+        if ((i % 3) != 0)
+        {
+            GetSiblingPath(path, sizeof(path), i);
+            admin_DeleteResource(path);
+            types[i] = ADMIN_ENTRY_TYPE_NONE;
+        }
+    }
+    CheckSiblings(types);
+
+    // The rest are still listed in the order they were created.
+    char childPath[IO_MAX_RESOURCE_PATH_LEN + 1];
+    le_result_t result = admin_GetFirstChild("/app/siblings", childPath, sizeof(childPath));
+    for (uint32_t i = 0; i < SIBLING_COUNT; i += 3)
+    {
+        assert_int_equal(result, LE_OK);
+        GetSiblingPath(path, sizeof(path), i);
+        assert_string_equal(childPath, path);
+        result = admin_GetNextSibling(path, childPath, sizeof(childPath));
+    }
+    assert_int_equal(result, LE_NOT_FOUND);
+
+    // Deleted names can be used again, for a different type of entry.
+    for (uint32_t i = 1; i < SIBLING_COUNT; i += 3)
+    {
+        GetSiblingPath(path, sizeof(path), i);
+        assert_int_equal(admin_CreateOutput(path, IO_DATA_TYPE_NUMERIC, ""), LE_OK);
+        types[i] = ADMIN_ENTRY_TYPE_OUTPUT;
+    }
+    CheckSiblings(types);
+
+    // Deleting them all empties the namespace, which can then be filled again.
+    for (uint32_t i = 0; i < SIBLING_COUNT; i++)
+    {
+        if (types[i] != ADMIN_ENTRY_TYPE_NONE)
+        {
+            GetSiblingPath(path, sizeof(path), i);
+            admin_DeleteResource(path);
+            types[i] = ADMIN_ENTRY_TYPE_NONE;
+        }
+    }
+    CheckSiblings(types);
+
+    for (uint32_t i = 0; i < SIBLING_COUNT; i += 100)
+    {
+        GetSiblingPath(path, sizeof(path), i);
+        assert_int_equal(admin_CreateInput(path, IO_DATA_TYPE_NUMERIC, ""), LE_OK);
+        types[i] = ADMIN_ENTRY_TYPE_INPUT;
+    }
+    CheckSiblings(types);
+
+    for (uint32_t i = 0; i < SIBLING_COUNT; i += 100)
+    {
+        GetSiblingPath(path, sizeof(path), i);
+        admin_DeleteResource(path);
+    }
+}
+
+/* Observation buffers */
+
+// Timestamp of the first sample pushed to a buffer (2020-09-13).
+#define START_TIME 1600000000.0
+
+// Create an Observation with a buffer of a given size, and push numbers 0, 1, 2... to it, one
+// second apart.
+static void CreateBufferedObs
+(
+    const char* obsPath,
+    uint32_t maxCount,
+    uint32_t sampleCount
+)
+{
+    assert_int_equal(admin_CreateObs(obsPath), LE_OK);
+    assert_int_equal(admin_SetBufferMaxCount(obsPath, maxCount), LE_OK);
+
+    for (uint32_t i = 0; i < sampleCount; i++)
+    {
+        assert_int_equal(admin_PushNumeric(obsPath, START_TIME + i, i), LE_OK);
+    }
+}
+
+// Check that a buffer holds exactly the numbers first..last, in order, with their timestamps.
+static void CheckBufferedSamples
+(
+    const char* obsPath,
+    uint32_t first,
+    uint32_t last
+)
+{
+    uint32_t count;
+    double min, max, mean, stdDev, firstTimestamp, lastTimestamp;
+
+    assert_int_equal(query_GetStats(obsPath, NAN, NAN, &count, &min, &max, &mean, &stdDev,
+                                    &firstTimestamp, &lastTimestamp), LE_OK);
+    assert_int_equal(count, last - first + 1);
+    assert_true(min == first);
+    assert_true(max == last);
+    assert_true(firstTimestamp == START_TIME + first);
+    assert_true(lastTimestamp == START_TIME + last);
+
+    double timestamp = START_TIME + first - 1;
+    for (uint32_t i = first; i <= last; i++)
+    {
+        double value;
+
+        assert_int_equal(query_ReadBufferSampleNumeric(obsPath, timestamp, &timestamp, &value),
+                         LE_OK);
+        assert_true(timestamp == START_TIME + i);
+        assert_true(value == i);
+    }
+    assert_int_equal(query_ReadBufferSampleNumeric(obsPath, timestamp, &timestamp, &min),
+                     LE_NOT_FOUND);
+}
+
+static void test_obs_ring_wrap_around
+(
+    void** state
+)
+{
+    (void)state;
+
+    // Fill a buffer a few times over, so the ring wraps around more than once.
+    CreateBufferedObs("/obs/ring", 8, 21);
+    CheckBufferedSamples("/obs/ring", 13, 20);
+
+    // Growing the buffer once it has wrapped around must keep the samples in order.
+    assert_int_equal(admin_SetBufferMaxCount("/obs/ring", 12), LE_OK);
+    for (uint32_t i = 21; i < 30; i++)
+    {
+        assert_int_equal(admin_PushNumeric("/obs/ring", START_TIME + i, i), LE_OK);
+    }
+    CheckBufferedSamples("/obs/ring", 18, 29);
+
+    // And so must shrinking it.
+    assert_int_equal(admin_SetBufferMaxCount("/obs/ring", 5), LE_OK);
+    CheckBufferedSamples("/obs/ring", 25, 29);
+
+    // A buffer can't be made bigger than the largest ring.
+    assert_int_equal(admin_SetBufferMaxCount("/obs/ring", UINT32_MAX), LE_OK);
+    assert_int_equal(admin_GetBufferMaxCount("/obs/ring"), 1 << 24);
+    CheckBufferedSamples("/obs/ring", 25, 29);
+
+    admin_DeleteObs("ring");
+}
+
+// Pseudo-random values pushed to buffers, the same on every run.
+static double RandomValue
+(
+    uint32_t i
+)
+{
+    return (double)((i * 2654435761u) % 1000) - 500.0;
+}
+
+// Check the statistics of a buffer holding RandomValue(i) pushed at START_TIME + i, over the
+// samples first..last, against ones computed here.
+static void CheckRangeStats
+(
+    const char* obsPath,
+    uint32_t first,
+    uint32_t last
+)
+{
+    uint32_t count;
+    double min, max, mean, stdDev, firstTimestamp, lastTimestamp;
+    double expectedMin = INFINITY;
+    double expectedMax = -INFINITY;
+    double sum = 0;
+
+    for (uint32_t i = first; i <= last; i++)
+    {
+        expectedMin = fmin(expectedMin, RandomValue(i));
+        expectedMax = fmax(expectedMax, RandomValue(i));
+        sum += RandomValue(i);
+    }
+    double expectedMean = sum / (last - first + 1);
+    double squares = 0;
+    for (uint32_t i = first; i <= last; i++)
+    {
+        squares += (RandomValue(i) - expectedMean) * (RandomValue(i) - expectedMean);
+    }
+    double expectedStdDev = sqrt(squares / (last - first + 1));
+
+    assert_int_equal(query_GetStats(obsPath, START_TIME + first, START_TIME + last, &count, &min,
+                                    &max, &mean, &stdDev, &firstTimestamp, &lastTimestamp), LE_OK);
+    assert_int_equal(count, last - first + 1);
+    assert_true(min == expectedMin);
+    assert_true(max == expectedMax);
+    assert_true(fabs(mean - expectedMean) < 1e-9);
+    assert_true(fabs(stdDev - expectedStdDev) < 1e-9);
+    assert_true(firstTimestamp == START_TIME + first);
+    assert_true(lastTimestamp == START_TIME + last);
+}
+
+static void test_obs_range_stats
+(
+    void** state
+)
+{
+    (void)state;
+
+    // Spans either side of the length below which buffers are scanned rather than indexed, and
+    // up to the whole buffer.
+    static const uint32_t lengths[] = { 1, 2, 31, 32, 33, 34, 63, 64, 65, 100, 199, 200 };
+
+    // Wrap the ring around, so some spans are split between its end and its start.
+    assert_int_equal(admin_CreateObs("/obs/range"), LE_OK);
+    assert_int_equal(admin_SetBufferMaxCount("/obs/range", 200), LE_OK);
+    for (uint32_t i = 0; i < 300; i++)
+    {
+        assert_int_equal(admin_PushNumeric("/obs/range", START_TIME + i, RandomValue(i)), LE_OK);
+    }
+
+    // Keep pushing between checks, so the index is updated as samples are added and dropped.
+    for (uint32_t i = 300; i < 340; i++)
+    {
+        for (size_t j = 0; j < NUM_ARRAY_MEMBERS(lengths); j++)
+        {
+            uint32_t oldest = i - 200;
+
+            for (uint32_t first = oldest; first + lengths[j] <= i; first += 37)
+            {
+                CheckRangeStats("/obs/range", first, first + lengths[j] - 1);
+            }
+            CheckRangeStats("/obs/range", i - lengths[j], i - 1);
+        }
+
+        assert_int_equal(admin_PushNumeric("/obs/range", START_TIME + i, RandomValue(i)), LE_OK);
+    }
+
+    admin_DeleteObs("range");
+}
+
+static void test_obs_compressed_stats
+(
+    void** state
+)
+{
+    (void)state;
+
+    // Push the same values to a compressed buffer and an uncompressed one: falling, then random,
+    // then rising, so that the minimum and maximum are dropped from the oldest block over and over.
+    assert_int_equal(admin_CreateObs("/obs/plain"), LE_OK);
+    assert_int_equal(admin_SetBufferMaxCount("/obs/plain", 1500), LE_OK);
+    assert_int_equal(admin_CreateObs("/obs/packed"), LE_OK);
+    assert_int_equal(admin_SetBufferMaxCount("/obs/packed", 1500), LE_OK);
+    assert_int_equal(admin_SetBufferCompression("/obs/packed", true), LE_OK);
+
+    for (uint32_t i = 0; i < 6000; i++)
+    {
+        double value = (i < 2000) ? -(double)i : ((i < 4000) ? RandomValue(i) : (double)i);
+
+        assert_int_equal(admin_PushNumeric("/obs/plain", START_TIME + i, value), LE_OK);
+        assert_int_equal(admin_PushNumeric("/obs/packed", START_TIME + i, value), LE_OK);
+
+        uint32_t count, packedCount;
+        double min, max, mean, stdDev, firstTimestamp, lastTimestamp;
+        double packedMin, packedMax, packedMean, packedStdDev;
+
+        assert_int_equal(query_GetStats("/obs/plain", NAN, NAN, &count, &min, &max, &mean,
+                                        &stdDev, &firstTimestamp, &lastTimestamp), LE_OK);
+        assert_int_equal(query_GetStats("/obs/packed", NAN, NAN, &packedCount, &packedMin,
+                                        &packedMax, &packedMean, &packedStdDev, &firstTimestamp,
+                                        &lastTimestamp), LE_OK);
+        assert_int_equal(packedCount, count);
+        assert_true(packedMin == min);
+        assert_true(packedMax == max);
+        assert_true(fabs(packedMean - mean) <= 1e-9 * (fabs(mean) + 1));
+        assert_true(fabs(packedStdDev - stdDev) <= 1e-9 * (stdDev + 1));
+    }
+
+    admin_DeleteObs("plain");
+    admin_DeleteObs("packed");
+}
+
+// Result of the last buffer read, set by its completion callback.
+static le_result_t ReadResult;
+static bool ReadDone;
+
+static void ReadCompletion
+(
+    le_result_t result,
+    void* contextPtr
+)
+{
+    (void)contextPtr;
+
+    ReadResult = result;
+    ReadDone = true;
+}
+
+// Read everything a buffer read writes to a pipe, running the event loop until the Data Hub closes
+// its end of the pipe, which it does when the read is done.
+static size_t DrainRead
+(
+    int fd,
+    char* buff,
+    size_t buffSize
+)
+{
+    size_t buffLen = 0;
+
+    for (;;)
+    {
+        ssize_t len = read(fd, buff + buffLen, buffSize - buffLen);
+
+        if (len == 0)
+        {
+            break;
+        }
+        if (len > 0)
+        {
+            buffLen += len;
+            assert_true(buffLen < buffSize);
+        }
+        else
+        {
+            assert_int_equal(errno, EAGAIN);
+            struct pollfd pollFd = { .fd = le_event_GetFd(), .events = POLLIN };
+            poll(&pollFd, 1, 10);
+            while (le_event_ServiceLoop() == LE_OK)
+            {
+            }
+        }
+    }
+    close(fd);
+
+    assert_true(ReadDone);
+    return buffLen;
+}
+
+// Read a downsampled view of a buffer, and get the timestamps of the samples read.
+static size_t ReadDownsampled
+(
+    const char* obsPath,
+    double startAfter,
+    uint32_t maxPoints,
+    query_DownsampleMethod_t method,
+    double* timestamps,
+    size_t maxTimestamps
+)
+{
+    static char json[16384];
+    int fds[2];
+
+    assert_int_equal(pipe(fds), 0);
+    assert_int_equal(fcntl(fds[0], F_SETFL, O_NONBLOCK), 0);
+
+    ReadDone = false;
+    assert_int_equal(query_ReadBufferDownsampledJson(obsPath, startAfter, maxPoints, method, fds[1],
+                                                     ReadCompletion, NULL), LE_OK);
+
+    json[DrainRead(fds[0], json, sizeof(json) - 1)] = '\0';
+    assert_int_equal(ReadResult, LE_OK);
+
+    size_t count = 0;
+    for (const char* tPtr = strstr(json, "\"t\":"); tPtr != NULL; tPtr = strstr(tPtr + 1, "\"t\":"))
+    {
+        assert_true(count < maxTimestamps);
+        timestamps[count++] = strtod(tPtr + 4, NULL);
+    }
+    return count;
+}
+
+static void test_obs_lttb_endpoints
+(
+    void** state
+)
+{
+    (void)state;
+
+    double timestamps[128];
+
+    // The first and last samples must always be kept, and the samples must come out in order.
+    assert_int_equal(admin_CreateObs("/obs/lttb"), LE_OK);
+    assert_int_equal(admin_SetBufferMaxCount("/obs/lttb", 100), LE_OK);
+    for (uint32_t i = 0; i < 100; i++)
+    {
+        assert_int_equal(admin_PushNumeric("/obs/lttb", START_TIME + i, RandomValue(i)), LE_OK);
+    }
+
+    static const uint32_t maxPoints[] = { 3, 4, 10, 50, 98, 99 };
+    for (size_t i = 0; i < NUM_ARRAY_MEMBERS(maxPoints); i++)
+    {
+        size_t count = ReadDownsampled("/obs/lttb", NAN, maxPoints[i], QUERY_DOWNSAMPLE_METHOD_LTTB,
+                                       timestamps, NUM_ARRAY_MEMBERS(timestamps));
+        assert_int_equal(count, maxPoints[i]);
+        assert_true(timestamps[0] == START_TIME);
+        assert_true(timestamps[count - 1] == START_TIME + 99);
+        for (size_t j = 1; j < count; j++)
+        {
+            assert_true(timestamps[j] > timestamps[j - 1]);
+        }
+    }
+
+    // Starting part way through the buffer, the first sample after the start is the first kept.
+    assert_int_equal(ReadDownsampled("/obs/lttb", START_TIME + 49, 5,
+                                     QUERY_DOWNSAMPLE_METHOD_LTTB, timestamps,
+                                     NUM_ARRAY_MEMBERS(timestamps)), 5);
+    assert_true(timestamps[0] == START_TIME + 50);
+    assert_true(timestamps[4] == START_TIME + 99);
+
+    // If no samples need to be dropped, they are all read.
+    assert_int_equal(ReadDownsampled("/obs/lttb", NAN, 100, QUERY_DOWNSAMPLE_METHOD_LTTB,
+                                     timestamps, NUM_ARRAY_MEMBERS(timestamps)), 100);
+    assert_int_equal(query_ReadBufferDownsampledJson("/obs/lttb", NAN, 2,
+                                                     QUERY_DOWNSAMPLE_METHOD_LTTB, -1,
+                                                     ReadCompletion, NULL), LE_BAD_PARAMETER);
+
+    // With one bucket between the endpoints, the sample furthest from the line between them is
+    // kept.  The ring wraps around, so the endpoints aren't at the ends of the ring.
+    assert_int_equal(admin_SetBufferMaxCount("/obs/lttb", 64), LE_OK);
+    for (uint32_t i = 100; i < 150; i++)
+    {
+        assert_int_equal(admin_PushNumeric("/obs/lttb", START_TIME + i, (i == 117) ? 10 : 1),
+                         LE_OK);
+    }
+    assert_int_equal(ReadDownsampled("/obs/lttb", START_TIME + 99, 3,
+                                     QUERY_DOWNSAMPLE_METHOD_LTTB, timestamps,
+                                     NUM_ARRAY_MEMBERS(timestamps)), 3);
+    assert_true(timestamps[0] == START_TIME + 100);
+    assert_true(timestamps[1] == START_TIME + 117);
+    assert_true(timestamps[2] == START_TIME + 149);
+
+    admin_DeleteObs("lttb");
+}
+
+// Decode a little-endian field of a binary read.
+static uint64_t GetLittleEndian
+(
+    const char* fieldPtr,
+    size_t size
+)
+{
+    uint64_t value = 0;
+
+    for (size_t i = 0; i < size; i++)
+    {
+        value |= (uint64_t)(uint8_t)fieldPtr[i] << (8 * i);
+    }
+    return value;
+}
+
+static double GetLittleEndianDouble
+(
+    const char* fieldPtr
+)
+{
+    uint64_t bits = GetLittleEndian(fieldPtr, sizeof(double));
+    double value;
+
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// Start a binary read of a buffer into a pipe, returning the pipe's read end.  If asked to, fill
+// the pipe first, so that nothing more is read until the pipe is drained, and return the number of
+// bytes to skip before the read's output starts.
+static int StartBinaryRead
+(
+    const char* obsPath,
+    double startAfter,
+    size_t* fillLenPtr
+)
+{
+    static const char fill[1024];
+    int fds[2];
+
+    assert_int_equal(pipe(fds), 0);
+    assert_int_equal(fcntl(fds[0], F_SETFL, O_NONBLOCK), 0);
+
+    if (fillLenPtr != NULL)
+    {
+        assert_int_equal(fcntl(fds[1], F_SETFL, O_NONBLOCK), 0);
+        *fillLenPtr = 0;
+        for (;;)
+        {
+            ssize_t len = write(fds[1], fill, sizeof(fill));
+            if (len < 0)
+            {
+                assert_int_equal(errno, EAGAIN);
+                break;
+            }
+            *fillLenPtr += len;
+        }
+    }
+
+    ReadDone = false;
+    assert_int_equal(query_ReadBufferBinary(obsPath, startAfter, fds[1], ReadCompletion, NULL),
+                     LE_OK);
+    return fds[0];
+}
+
+static void test_obs_read_binary
+(
+    void** state
+)
+{
+    (void)state;
+
+    static char data[2 * 1024 * 1024];
+
+    // The header is the same as an exported buffer's, with the number of records in it, and the
+    // records are little-endian.
+    assert_int_equal(admin_CreateObs("/obs/binary"), LE_OK);
+    assert_int_equal(admin_SetBufferMaxCount("/obs/binary", 100), LE_OK);
+    for (uint32_t i = 0; i < 150; i++)
+    {
+        assert_int_equal(admin_PushNumeric("/obs/binary", START_TIME + i, RandomValue(i)), LE_OK);
+    }
+
+    size_t len = DrainRead(StartBinaryRead("/obs/binary", START_TIME + 79, NULL), data, sizeof(data));
+    assert_int_equal(ReadResult, LE_OK);
+    assert_int_equal(len, 8 + (70 * 16));
+    assert_int_equal(data[0], 0);
+    assert_int_equal(data[1], 'n');
+    assert_int_equal(data[2], 0);
+    assert_int_equal(data[3], 0);
+    assert_int_equal(GetLittleEndian(data + 4, 4), 70);
+    for (uint32_t i = 0; i < 70; i++)
+    {
+        assert_true(GetLittleEndianDouble(data + 8 + (i * 16)) == START_TIME + 80 + i);
+        assert_true(GetLittleEndianDouble(data + 16 + (i * 16)) == RandomValue(80 + i));
+    }
+
+    // String records have a little-endian length.
+    assert_int_equal(admin_PushString("/obs/binary", START_TIME + 150, "hello"), LE_OK);
+    len = DrainRead(StartBinaryRead("/obs/binary", NAN, NULL), data, sizeof(data));
+    assert_int_equal(ReadResult, LE_OK);
+    assert_int_equal(len, 8 + 8 + 4 + 5);
+    assert_int_equal(data[1], 's');
+    assert_int_equal(GetLittleEndian(data + 4, 4), 1);
+    assert_true(GetLittleEndianDouble(data + 8) == START_TIME + 150);
+    assert_int_equal(GetLittleEndian(data + 16, 4), 5);
+    assert_memory_equal(data + 20, "hello", 5);
+
+    // Samples added after the read starts are not read, but if samples that the header counted
+    // are dropped before they are written, the read fails.
+    assert_int_equal(admin_SetBufferMaxCount("/obs/binary", 10000), LE_OK);
+    for (uint32_t i = 0; i < 10000; i++)
+    {
+        assert_int_equal(admin_PushNumeric("/obs/binary", START_TIME + 200 + i, RandomValue(i)),
+                         LE_OK);
+    }
+    size_t fillLen;
+    int fd = StartBinaryRead("/obs/binary", NAN, &fillLen);
+    assert_int_equal(admin_PushNumeric("/obs/binary", START_TIME + 10200, 0), LE_OK);
+    len = DrainRead(fd, data, sizeof(data)) - fillLen;
+    assert_int_equal(ReadResult, LE_OK);
+    assert_int_equal(len, 8 + (10000 * 16));
+    assert_int_equal(GetLittleEndian(data + fillLen + 4, 4), 10000);
+    assert_true(GetLittleEndianDouble(data + fillLen + 8) == START_TIME + 200);
+    assert_true(GetLittleEndianDouble(data + fillLen + 8 + (9999 * 16)) == START_TIME + 10199);
+
+    fd = StartBinaryRead("/obs/binary", NAN, &fillLen);
+    for (uint32_t i = 10201; i < 15200; i++)
+    {
+        assert_int_equal(admin_PushNumeric("/obs/binary", START_TIME + i, 0), LE_OK);
+    }
+    len = DrainRead(fd, data, sizeof(data)) - fillLen;
+    assert_int_equal(ReadResult, LE_OUT_OF_RANGE);
+    assert_true(len < 8 + (5000 * 16));
+    assert_int_equal(GetLittleEndian(data + fillLen + 4, 4), 10000);
+
+    admin_DeleteObs("binary");
+}
+
+// Get the number of bytes of memory allocated for an Observation's buffer.
+static uint64_t GetBufferBytes
+(
+    const char* obsPath
+)
+{
+    uint64_t bytes;
+    uint64_t evictionCount;
+
+    assert_int_equal(query_GetObsBufferMemoryUsage(obsPath, &bytes, &evictionCount), LE_OK);
+    return bytes;
+}
+
+static void test_obs_memory_accounting
+(
+    void** state
+)
+{
+    (void)state;
+
+    uint64_t totalBytes;
+    uint64_t evictionCount;
+
+    // The whole ring is counted as it is allocated, including slots not yet filled, so the memory
+    // used only changes as the ring doubles.
+    CreateBufferedObs("/obs/memory", 1000, 512);
+    uint64_t halfRingBytes = GetBufferBytes("/obs/memory");
+    assert_int_equal(admin_PushNumeric("/obs/memory", START_TIME + 512, 512), LE_OK);
+    uint64_t ringBytes = GetBufferBytes("/obs/memory");
+    assert_true(ringBytes == 2 * halfRingBytes);
+    for (uint32_t i = 513; i < 1000; i++)
+    {
+        assert_int_equal(admin_PushNumeric("/obs/memory", START_TIME + i, i), LE_OK);
+    }
+    assert_true(GetBufferBytes("/obs/memory") == ringBytes);
+
+    // So is the index built by a query over part of the buffer.
+    uint32_t count;
+    double min, max, mean, stdDev, firstTimestamp, lastTimestamp;
+    assert_int_equal(query_GetStats("/obs/memory", START_TIME + 100, START_TIME + 899, &count, &min,
+                                    &max, &mean, &stdDev, &firstTimestamp, &lastTimestamp), LE_OK);
+    assert_int_equal(count, 800);
+    uint64_t indexedBytes = GetBufferBytes("/obs/memory");
+    assert_true(indexedBytes > ringBytes);
+
+    // Strings are counted as they are buffered, on top of their ring.
+    CreateBufferedObs("/obs/memoryNumbers", 4, 1);
+    assert_int_equal(admin_CreateObs("/obs/memoryStrings"), LE_OK);
+    assert_int_equal(admin_SetBufferMaxCount("/obs/memoryStrings", 4), LE_OK);
+    assert_int_equal(admin_PushString("/obs/memoryStrings", START_TIME, "abc"), LE_OK);
+    assert_true(   GetBufferBytes("/obs/memoryStrings")
+                == GetBufferBytes("/obs/memoryNumbers") + sizeof("abc"));
+
+    query_GetBufferMemoryUsage(&totalBytes, &evictionCount);
+    assert_true(totalBytes ==   indexedBytes + GetBufferBytes("/obs/memoryNumbers")
+                              + GetBufferBytes("/obs/memoryStrings"));
+
+    // With a maximum number of bytes, the index goes first, then samples are dropped and the ring
+    // shrunk until the buffer fits.  The ring then doesn't grow past it.
+    assert_int_equal(admin_SetBufferMaxBytes("/obs/memory", (ringBytes * 3) / 4), LE_OK);
+    assert_true(GetBufferBytes("/obs/memory") == halfRingBytes);
+    CheckBufferedSamples("/obs/memory", 488, 999);
+    for (uint32_t i = 1000; i < 1100; i++)
+    {
+        assert_int_equal(admin_PushNumeric("/obs/memory", START_TIME + i, i), LE_OK);
+        assert_true(GetBufferBytes("/obs/memory") <= (ringBytes * 3) / 4);
+    }
+    CheckBufferedSamples("/obs/memory", 588, 1099);
+
+    admin_DeleteObs("memory");
+    admin_DeleteObs("memoryNumbers");
+    admin_DeleteObs("memoryStrings");
+    query_GetBufferMemoryUsage(&totalBytes, &evictionCount);
+    assert_true(totalBytes == 0);
+}
+
+static void test_obs_budget_eviction
+(
+    void** state
+)
+{
+    (void)state;
+
+    uint64_t totalBytes;
+    uint64_t evictionCount;
+    uint64_t bytes;
+
+    CreateBufferedObs("/obs/evictLow", 1000, 1000);
+    CreateBufferedObs("/obs/evictHigh", 1000, 1000);
+    assert_int_equal(admin_SetBufferPriority("/obs/evictHigh", 1), LE_OK);
+    uint64_t ringBytes = GetBufferBytes("/obs/evictLow");
+    query_GetBufferMemoryUsage(&totalBytes, &evictionCount);
+    assert_true(totalBytes == 2 * ringBytes);
+    uint64_t firstEvictionCount = evictionCount;
+
+    // Without the memory to sort the buffers by priority, nothing is evicted.
+    uint32_t budget = (uint32_t)((totalBytes * 7) / 8);
+    hub_MemAllocFailCountdown = 0;
+    admin_SetBufferBudget(budget);
+    hub_MemAllocFailCountdown = -1;
+    query_GetBufferMemoryUsage(&totalBytes, &evictionCount);
+    assert_true(totalBytes == 2 * ringBytes);
+    assert_true(evictionCount == firstEvictionCount);
+
+    // Otherwise, the oldest samples of the lowest priority buffer are evicted until the buffers
+    // use no more than 15/16 of the budget, which here is once the ring has halved.
+    admin_SetBufferBudget(budget);
+    query_GetBufferMemoryUsage(&totalBytes, &evictionCount);
+    assert_true(totalBytes <= budget - (budget / 16));
+    assert_true(evictionCount == firstEvictionCount + 488);
+    CheckBufferedSamples("/obs/evictLow", 488, 999);
+    CheckBufferedSamples("/obs/evictHigh", 0, 999);
+    assert_int_equal(query_GetObsBufferMemoryUsage("/obs/evictLow", &bytes, &evictionCount),
+                     LE_OK);
+    assert_true(bytes == ringBytes / 2);
+    assert_true(evictionCount == 488);
+    assert_int_equal(query_GetObsBufferMemoryUsage("/obs/evictHigh", &bytes, &evictionCount),
+                     LE_OK);
+    assert_true(bytes == ringBytes);
+    assert_true(evictionCount == 0);
+
+    admin_SetBufferBudget(0);
+    admin_DeleteObs("evictLow");
+    admin_DeleteObs("evictHigh");
+}
+
+/* Path lookup cache */
+
+static void test_admin_cache_recreate
+(
+    void** state
+)
+{
+    (void)state;
+    const char* path = "/app/cache/value";
+    io_DataType_t dataType;
+    uint32_t count;
+    double min, max, mean, stdDev, firstTimestamp, lastTimestamp;
+
+    // Found paths are cached, but an entry deleted since isn't found through the cache...
+    assert_int_equal(admin_CreateInput(path, IO_DATA_TYPE_NUMERIC, ""), LE_OK);
+    assert_int_equal(admin_GetEntryType(path), ADMIN_ENTRY_TYPE_INPUT);
+    assert_int_equal(admin_GetEntryType(path), ADMIN_ENTRY_TYPE_INPUT);
+    admin_DeleteResource(path);
+    assert_int_equal(admin_GetEntryType(path), ADMIN_ENTRY_TYPE_NONE);
+    assert_int_equal(query_GetDataType(path, &dataType), LE_NOT_FOUND);
+
+    // ...and the entry created in its place is found instead.
+    assert_int_equal(admin_CreateOutput(path, IO_DATA_TYPE_STRING, ""), LE_OK);
+    assert_int_equal(admin_GetEntryType(path), ADMIN_ENTRY_TYPE_OUTPUT);
+    assert_int_equal(query_GetDataType(path, &dataType), LE_OK);
+    assert_int_equal(dataType, IO_DATA_TYPE_STRING);
+    admin_DeleteResource(path);
+    assert_int_equal(admin_GetEntryType(path), ADMIN_ENTRY_TYPE_NONE);
+
+    // The same goes for Observations, whose buffers start out empty again.
+    CreateBufferedObs("/obs/cached", 10, 1);
+    admin_DeleteObs("cached");
+    assert_int_equal(admin_GetEntryType("/obs/cached"), ADMIN_ENTRY_TYPE_NONE);
+    assert_int_equal(admin_CreateObs("/obs/cached"), LE_OK);
+    assert_int_equal(admin_GetEntryType("/obs/cached"), ADMIN_ENTRY_TYPE_OBSERVATION);
+    assert_int_equal(admin_SetBufferMaxCount("/obs/cached", 10), LE_OK);
+    assert_int_equal(query_GetStats("/obs/cached", NAN, NAN, &count, &min, &max, &mean, &stdDev,
+                                    &firstTimestamp, &lastTimestamp), LE_NOT_FOUND);
+    admin_DeleteObs("cached");
+}
+
+static void test_admin_cache_placeholder
+(
+    void** state
+)
+{
+    (void)state;
+    const char* path = "/app/cache/placeholder";
+
+    // Setting a default on a path with nothing there leaves a Placeholder to hold it...
+    assert_int_equal(admin_SetNumericDefault(path, 21.5), LE_OK);
+    assert_int_equal(admin_GetEntryType(path), ADMIN_ENTRY_TYPE_PLACEHOLDER);
+    assert_int_equal(admin_GetEntryType(path), ADMIN_ENTRY_TYPE_PLACEHOLDER);
+
+    // ...which becomes an Input or Output when one is created there, and a Placeholder again when
+    // that is deleted.
+    assert_int_equal(admin_CreateInput(path, IO_DATA_TYPE_NUMERIC, ""), LE_OK);
+    assert_int_equal(admin_GetEntryType(path), ADMIN_ENTRY_TYPE_INPUT);
+    assert_true(admin_GetNumericDefault(path) == 21.5);
+    admin_DeleteResource(path);
+    assert_int_equal(admin_GetEntryType(path), ADMIN_ENTRY_TYPE_PLACEHOLDER);
+
+    assert_int_equal(admin_CreateOutput(path, IO_DATA_TYPE_NUMERIC, ""), LE_OK);
+    assert_int_equal(admin_GetEntryType(path), ADMIN_ENTRY_TYPE_OUTPUT);
+    admin_DeleteResource(path);
+    assert_int_equal(admin_GetEntryType(path), ADMIN_ENTRY_TYPE_PLACEHOLDER);
+
+    admin_RemoveDefault(path);
+
+    // A Placeholder is replaced by an Observation created at its path.
+    assert_int_equal(admin_SetNumericDefault("/obs/placeholder", 21.5), LE_OK);
+    assert_int_equal(admin_GetEntryType("/obs/placeholder"), ADMIN_ENTRY_TYPE_PLACEHOLDER);
+    CreateBufferedObs("/obs/placeholder", 10, 2);
+    assert_int_equal(admin_GetEntryType("/obs/placeholder"), ADMIN_ENTRY_TYPE_OBSERVATION);
+    CheckBufferedSamples("/obs/placeholder", 0, 1);
+    admin_DeleteObs("placeholder");
+}
+
+// More than twice as many paths as the path lookup cache has slots (256), so that whatever they
+// hash to, many of them share a slot with another.
+#define CACHE_TEST_PATHS 600
+
+// Check that every one of a set of paths that share cache slots leads to its own entry: Inputs
+// at even numbers and Outputs at odd ones, with those deleted from every deletedStep'th number.
+static void CheckCollidingPaths
+(
+    uint32_t deletedStep    ///< 0 = none deleted.
+)
+{
+    char path[IO_MAX_RESOURCE_PATH_LEN + 1];
+
+    // Paths are looked up forwards, then backwards, so each evicts others from their slots.
+    for (uint32_t pass = 0; pass < 2; pass++)
+    {
+        for (uint32_t j = 0; j < CACHE_TEST_PATHS; j++)
+        {
+            uint32_t i = ((pass == 0) ? j : (CACHE_TEST_PATHS - 1 - j));
+            io_DataType_t dataType;
+
+            snprintf(path, sizeof(path), "/app/cache/path%" PRIu32, i);
+            if ((deletedStep != 0) && ((i % deletedStep) == 0))
+            {
+                assert_int_equal(admin_GetEntryType(path), ADMIN_ENTRY_TYPE_NONE);
+                assert_int_equal(query_GetDataType(path, &dataType), LE_NOT_FOUND);
+            }
+            else
+            {
+                assert_int_equal(admin_GetEntryType(path),
+                                 ((i % 2) == 0) ? ADMIN_ENTRY_TYPE_INPUT : ADMIN_ENTRY_TYPE_OUTPUT);
+                assert_int_equal(query_GetDataType(path, &dataType), LE_OK);
+                assert_int_equal(dataType,
+                                 ((i % 2) == 0) ? IO_DATA_TYPE_NUMERIC : IO_DATA_TYPE_STRING);
+            }
+        }
+    }
+}
+
+static void test_admin_cache_collisions
+(
+    void** state
+)
+{
+    (void)state;
+    char path[IO_MAX_RESOURCE_PATH_LEN + 1];
+
+    for (uint32_t i = 0; i < CACHE_TEST_PATHS; i++)
+    {
+        snprintf(path, sizeof(path), "/app/cache/path%" PRIu32, i);
+        if ((i % 2) == 0)
+        {
+            assert_int_equal(admin_CreateInput(path, IO_DATA_TYPE_NUMERIC, ""), LE_OK);
+        }
+        else
+        {
+            assert_int_equal(admin_CreateOutput(path, IO_DATA_TYPE_STRING, ""), LE_OK);
+        }
+    }
+    CheckCollidingPaths(0);
+
+    for (uint32_t i = 0; i < CACHE_TEST_PATHS; i += 3)
+    {
+        snprintf(path, sizeof(path), "/app/cache/path%" PRIu32, i);
+        admin_DeleteResource(path);
+    }
+    CheckCollidingPaths(3);
+
+    for (uint32_t i = 0; i < CACHE_TEST_PATHS; i++)
+    {
+        if ((i % 3) != 0)
+        {
+            snprintf(path, sizeof(path), "/app/cache/path%" PRIu32, i);
+            admin_DeleteResource(path);
+        }
+    }
+    CheckCollidingPaths(1);
+}
+
+/* Resource handles */
+
+// Stands in for the IPC session of another client, which has no session object.
+static int OtherClient;
+#define OTHER_SESSION ((le_msg_SessionRef_t)&OtherClient)
+
+// Check that a handle leads to a numeric resource with a given current value.
+static void CheckHandleValue
+(
+    query_ResourceRef_t handle,
+    double expected
+)
+{
+    double timestamp, value;
+
+    assert_int_equal(query_GetNumericByHandle(handle, &timestamp, &value), LE_OK);
+    assert_true(value == expected);
+}
+
+// Check that a handle is no longer valid.
+static void CheckHandleInvalid
+(
+    query_ResourceRef_t handle
+)
+{
+    double timestamp, value;
+
+    assert_int_equal(query_GetNumericByHandle(handle, &timestamp, &value), LE_NOT_FOUND);
+}
+
+static void test_handle_resource_deleted
+(
+    void** state
+)
+{
+    (void)state;
+    const char* path = "/app/handles/value";
+
+    assert_int_equal(admin_CreateInput(path, IO_DATA_TYPE_NUMERIC, ""), LE_OK);
+    assert_int_equal(admin_PushNumeric(path, START_TIME, 1.5), LE_OK);
+    resTree_EntryRef_t entryRef = resTree_FindEntryAtAbsolutePath(path);
+
+    // A session gets the same handle each time it opens the resource, and another session its
+    // own, which neither can use in place of the other's.
+    query_ResourceRef_t handle = query_OpenResource(path);
+    assert_non_null(handle);
+    assert_ptr_equal(query_OpenResource(path), handle);
+    CheckHandleValue(handle, 1.5);
+    void* otherHandle = resHandle_Open(OTHER_SESSION, entryRef);
+    assert_non_null(otherHandle);
+    assert_true(otherHandle != (void*)handle);
+    assert_ptr_equal(resHandle_Lookup(OTHER_SESSION, otherHandle), entryRef);
+    assert_null(resHandle_Lookup(OTHER_SESSION, handle));
+    CheckHandleInvalid(otherHandle);
+
+    // Deleting the resource drops every session's handles to it...
+    admin_DeleteResource(path);
+    CheckHandleInvalid(handle);
+    assert_null(resHandle_Lookup(OTHER_SESSION, otherHandle));
+
+    // ...so they don't lead to a resource created in its place.
+    assert_int_equal(admin_CreateInput(path, IO_DATA_TYPE_NUMERIC, ""), LE_OK);
+    assert_int_equal(admin_PushNumeric(path, START_TIME + 1, 2.5), LE_OK);
+    CheckHandleInvalid(handle);
+    query_ResourceRef_t newHandle = query_OpenResource(path);
+    assert_non_null(newHandle);
+    CheckHandleValue(newHandle, 2.5);
+
+    // Closing a stale handle does nothing, and a closed handle is stale.
+    query_CloseResource(handle);
+    CheckHandleValue(newHandle, 2.5);
+    query_CloseResource(newHandle);
+    CheckHandleInvalid(newHandle);
+
+    admin_DeleteResource(path);
+}
+
+static void test_handle_session_closed
+(
+    void** state
+)
+{
+    (void)state;
+    const char* pathA = "/app/handles/a";
+    const char* pathB = "/app/handles/b";
+    le_msg_SessionRef_t sessionRef = query_GetClientSessionRef();
+
+    assert_int_equal(admin_CreateInput(pathA, IO_DATA_TYPE_NUMERIC, ""), LE_OK);
+    assert_int_equal(admin_CreateInput(pathB, IO_DATA_TYPE_NUMERIC, ""), LE_OK);
+    assert_int_equal(admin_PushNumeric(pathA, START_TIME, 1), LE_OK);
+    assert_int_equal(admin_PushNumeric(pathB, START_TIME, 2), LE_OK);
+    resTree_EntryRef_t entryRefA = resTree_FindEntryAtAbsolutePath(pathA);
+
+    query_ResourceRef_t handleA = query_OpenResource(pathA);
+    query_ResourceRef_t handleB = query_OpenResource(pathB);
+    void* otherHandle = resHandle_Open(OTHER_SESSION, entryRefA);
+    CheckHandleValue(handleA, 1);
+    CheckHandleValue(handleB, 2);
+
+    // Closing a session drops all its handles, but not other sessions' handles.
+    resHandle_CloseSession(sessionRef);
+    CheckHandleInvalid(handleA);
+    CheckHandleInvalid(handleB);
+    assert_ptr_equal(resHandle_Lookup(OTHER_SESSION, otherHandle), entryRefA);
+    resHandle_CloseSession(sessionRef);
+
+    // Handles can be opened in the session again.
+    query_ResourceRef_t newHandle = query_OpenResource(pathA);
+    assert_non_null(newHandle);
+    CheckHandleValue(newHandle, 1);
+    CheckHandleInvalid(handleA);
+
+    resHandle_CloseSession(OTHER_SESSION);
+    assert_null(resHandle_Lookup(OTHER_SESSION, otherHandle));
+    CheckHandleValue(newHandle, 1);
+
+    // The resources can still be deleted, taking the remaining handle with them.
+    admin_DeleteResource(pathA);
+    admin_DeleteResource(pathB);
+    CheckHandleInvalid(newHandle);
+    assert_int_equal(admin_GetEntryType(pathA), ADMIN_ENTRY_TYPE_NONE);
+}
+
 int main(int argc, char **argv)
 {
     (void)argc;
@@ -259,7 +1297,20 @@ int main(int argc, char **argv)
         cmocka_unit_test(test_admin_create_output_bad_path),
         cmocka_unit_test(test_admin_create_output_duplicate),
         cmocka_unit_test(test_admin_mark_optional),
-        cmocka_unit_test(test_admin_set_json_example)
+        cmocka_unit_test(test_admin_set_json_example),
+        cmocka_unit_test(test_admin_many_siblings),
+        cmocka_unit_test(test_admin_cache_recreate),
+        cmocka_unit_test(test_admin_cache_placeholder),
+        cmocka_unit_test(test_admin_cache_collisions),
+        cmocka_unit_test(test_handle_resource_deleted),
+        cmocka_unit_test(test_handle_session_closed),
+        cmocka_unit_test(test_obs_ring_wrap_around),
+        cmocka_unit_test(test_obs_range_stats),
+        cmocka_unit_test(test_obs_compressed_stats),
+        cmocka_unit_test(test_obs_lttb_endpoints),
+        cmocka_unit_test(test_obs_read_binary),
+        cmocka_unit_test(test_obs_memory_accounting),
+        cmocka_unit_test(test_obs_budget_eviction)
     };
     return cmocka_run_group_tests(tests, setup, teardown);
 }
@@ -0,0 +1,12 @@
+#ifndef __INTERFACE_H__
+#define __INTERFACE_H__
+
+// Generated by the Makefile from the .api files.
+#include "le_limit_interface.h"
+#include "le_appInfo_interface.h"
+#include "io_server.h"
+#include "admin_server.h"
+#include "query_server.h"
+#include "config_server.h"
+
+#endif
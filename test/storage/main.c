@@ -0,0 +1,1237 @@
+/**
+ * @file main.c
+ *
+ * unit test the Data Hub's storage:
+ *  - compression of numerical samples into Sample Blocks
+ *  - restoring Observation buffers from damaged backup files, backup logs and backup packs
+ *  - restoring Observation buffers lazily from their backups
+ *  - restoring the resource tree from a damaged checkpoint
+ *  - restoring buffers from the state kept in shared memory, including lazily restored ones
+ *  - interning of resource tree entry names and units
+ *
+ * Each test runs in a temporary directory, where the Data Hub keeps its backups.  The Data Hub is
+ * only ever started in child processes, so each one is like the Data Hub after a restart.
+ *
+ * Copyright (C) Sierra Wireless, Inc. Use of this work is subject to license.
+ */
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <cmocka.h>
+#include <float.h>
+#include <poll.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include "legato.h"
+#include "interfaces.h"
+#include "dataHub.h"
+#include "sampleBlock.h"
+#include "backupWriter.h"
+#include "stateSegment.h"
+#include "strIntern.h"
+
+extern void initDataHub(void);
+
+// Timestamp of the first sample in the sample sets (2020-09-13).
+#define START_TIME 1600000000.0
+
+static char TestDir[] = "/tmp/storageTest.XXXXXX";
+
+static int setup(void **state) {
+    assert_non_null(mkdtemp(TestDir));
+    assert_int_equal(chdir(TestDir), 0);
+
+    return 0;
+}
+static int teardown(void **state) {
+    char command[sizeof(TestDir) + 16];
+
+    // The state kept in shared memory would outlive the test, like the backups.
+    stateSegment_Delete();
+
+    assert_int_equal(chdir("/"), 0);
+    snprintf(command, sizeof(command), "rm -rf %s", TestDir);
+    assert_int_equal(system(command), 0);
+    strcpy(TestDir + sizeof(TestDir) - 7, "XXXXXX");
+
+    return 0;
+}
+
+/* Restarts */
+
+// Failures can't be reported to cmocka from a child process, so the child exits with status 1.
+#define CHILD_CHECK(condition) \
+    do { \
+        if (!(condition)) \
+        { \
+            fprintf(stderr, "%s:%d: Check failed: %s\n", __FILE__, __LINE__, #condition); \
+            _exit(1); \
+        } \
+    } while (0)
+
+// Start the Data Hub in a child process, run a function there and check that it passed.
+static void RunDataHub
+(
+    void (*func)(void)
+)
+{
+    fflush(NULL);
+    pid_t pid = fork();
+    assert_int_not_equal(pid, -1);
+
+    if (pid == 0)
+    {
+        initDataHub();
+        func();
+
+        // Don't leave backups half written.
+        backupWriter_Flush();
+        _exit(0);
+    }
+
+    int status;
+    assert_int_equal(waitpid(pid, &status, 0), pid);
+    assert_true(WIFEXITED(status));
+    assert_int_equal(WEXITSTATUS(status), 0);
+}
+
+// Run the event loop for a while, so timers can expire.
+static void RunEventLoop
+(
+    uint32_t ms
+)
+{
+    struct pollfd pollFd = { .fd = le_event_GetFd(), .events = POLLIN };
+
+    for (uint32_t i = 0; i < ms; i += 10)
+    {
+        poll(&pollFd, 1, 10);
+        while (le_event_ServiceLoop() == LE_OK)
+        {
+        }
+    }
+}
+
+// Get the size of a file, or -1 if it doesn't exist.
+static off_t GetFileSize
+(
+    const char* path
+)
+{
+    struct stat st;
+
+    if (stat(path, &st) != 0)
+    {
+        return -1;
+    }
+    return st.st_size;
+}
+
+// Run the event loop until a file grows bigger than a given size (or 5 seconds have gone by),
+// then wait for the backups being written to be finished.
+static bool WaitForFileSize
+(
+    const char* path,
+    off_t size
+)
+{
+    for (int i = 0; i < 50; i++)
+    {
+        if (GetFileSize(path) > size)
+        {
+            backupWriter_Flush();
+            return true;
+        }
+        RunEventLoop(100);
+    }
+    return false;
+}
+
+// Run the event loop until a file exists (or 5 seconds have gone by).
+static bool WaitForFile
+(
+    const char* path
+)
+{
+    return WaitForFileSize(path, -1);
+}
+
+// Read a whole file.  The caller frees the buffer.
+static uint8_t* ReadFile
+(
+    const char* path,
+    size_t* sizePtr
+)
+{
+    FILE* file = fopen(path, "rb");
+    assert_non_null(file);
+    assert_int_equal(fseek(file, 0, SEEK_END), 0);
+    long size = ftell(file);
+    assert_true(size > 0);
+    rewind(file);
+
+    uint8_t* buffPtr = malloc(size);
+    assert_non_null(buffPtr);
+    assert_int_equal(fread(buffPtr, 1, size, file), size);
+    fclose(file);
+
+    *sizePtr = size;
+    return buffPtr;
+}
+
+static void WriteFile
+(
+    const char* path,
+    const uint8_t* buffPtr,
+    size_t size
+)
+{
+    FILE* file = fopen(path, "wb");
+    assert_non_null(file);
+    assert_int_equal(fwrite(buffPtr, 1, size, file), size);
+    assert_int_equal(fclose(file), 0);
+}
+
+// Write a copy of a file with one byte changed.
+static void WriteDamagedFile
+(
+    const char* path,
+    const uint8_t* buffPtr,
+    size_t size,
+    size_t offset
+)
+{
+    uint8_t* copyPtr = malloc(size);
+    assert_non_null(copyPtr);
+    memcpy(copyPtr, buffPtr, size);
+    copyPtr[offset] ^= 0x5a;
+    WriteFile(path, copyPtr, size);
+    free(copyPtr);
+}
+
+// Get the number of samples in an Observation's buffer.
+static uint32_t GetSampleCount
+(
+    const char* obsPath
+)
+{
+    uint32_t count;
+    double min, max, mean, stdDev, firstTimestamp, lastTimestamp;
+
+    if (query_GetStats(obsPath, NAN, NAN, &count, &min, &max, &mean, &stdDev,
+                       &firstTimestamp, &lastTimestamp) != LE_OK)
+    {
+        return 0;
+    }
+    return count;
+}
+
+// Create an Observation that is backed up every second, and push numbers to it.
+static void CreateBackedUpObs
+(
+    const char* obsPath,
+    uint32_t sampleCount
+)
+{
+    CHILD_CHECK(admin_CreateObs(obsPath) == LE_OK);
+    CHILD_CHECK(admin_SetBufferMaxCount(obsPath, 1000) == LE_OK);
+    CHILD_CHECK(admin_SetBufferBackupPeriod(obsPath, 1) == LE_OK);
+
+    for (uint32_t i = 0; i < sampleCount; i++)
+    {
+        CHILD_CHECK(admin_PushNumeric(obsPath, START_TIME + i, i) == LE_OK);
+    }
+}
+
+/* Sample Blocks */
+typedef struct
+{
+    double timestamp;
+    double value;
+}
+Sample_t;
+
+// Max. number of samples that fit in a Sample Block (two bits each, at best).
+#define MAX_BLOCK_SAMPLES (SAMPLE_BLOCK_DATA_BYTES * 4)
+
+static Sample_t Samples[MAX_BLOCK_SAMPLES];
+
+// Pseudo-random numbers, the same on every run.
+static uint32_t RandomSeed;
+
+static uint32_t Random(void)
+{
+    RandomSeed = (RandomSeed * 1103515245) + 12345;
+    return (RandomSeed >> 16) & 0x7fff;
+}
+
+// Append samples to an empty block until it's full or the samples run out.
+// Returns the number of samples appended.
+static size_t FillBlock
+(
+    sampleBlock_Block_t* blockPtr,
+    const Sample_t* samples,
+    size_t count
+)
+{
+    sampleBlock_Init(blockPtr);
+
+    size_t i;
+    for (i = 0; i < count; i++)
+    {
+        if (!sampleBlock_Append(blockPtr, samples[i].timestamp, samples[i].value))
+        {
+            break;
+        }
+    }
+    assert_int_equal(sampleBlock_GetCount(blockPtr), i);
+    return i;
+}
+
+// Read a block back and check that every timestamp and value has the same bit pattern as the one
+// appended (so NAN compares equal to NAN, and -0.0 doesn't compare equal to 0.0).
+static void CheckBlock
+(
+    const sampleBlock_Block_t* blockPtr,
+    const Sample_t* samples,
+    size_t count
+)
+{
+    sampleBlock_Cursor_t cursor;
+    sampleBlock_StartRead(&cursor);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        double timestamp;
+        double value;
+        sampleBlock_ReadNext(blockPtr, &cursor, &timestamp, &value);
+        assert_memory_equal(&timestamp, &samples[i].timestamp, sizeof(double));
+        assert_memory_equal(&value, &samples[i].value, sizeof(double));
+    }
+    assert_int_equal(cursor.count, sampleBlock_GetCount(blockPtr));
+}
+
+// Round-trip a set of samples that all fit in one block.
+static void CheckRoundTrip
+(
+    const Sample_t* samples,
+    size_t count
+)
+{
+    static sampleBlock_Block_t block;
+
+    assert_int_equal(FillBlock(&block, samples, count), count);
+    CheckBlock(&block, samples, count);
+}
+
+static double BitsToDouble
+(
+    uint64_t bits
+)
+{
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static void test_block_special_values
+(
+    void** state
+)
+{
+    const double values[] =
+    {
+        0.0, -0.0, NAN, -NAN, BitsToDouble(0x7ff8000000000123), INFINITY, -INFINITY, INFINITY,
+        DBL_MAX, -DBL_MAX, DBL_MIN, DBL_TRUE_MIN, -DBL_TRUE_MIN, 1.0 / 3, -1.0 / 3, 1e300, 1e-300,
+        NAN, 21.5, NAN, 21.5, INFINITY, 0.0, -INFINITY, -0.0, 0.0
+    };
+    const size_t count = NUM_ARRAY_MEMBERS(values);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        Samples[i].timestamp = START_TIME + i;
+        Samples[i].value = values[i];
+    }
+    CheckRoundTrip(Samples, count);
+
+    // The same values again, starting with each one in turn, as the first sample is stored whole.
+    for (size_t first = 1; first < count; first++)
+    {
+        CheckRoundTrip(Samples + first, count - first);
+    }
+}
+
+static void test_block_repeated_values
+(
+    void** state
+)
+{
+    static sampleBlock_Block_t block;
+
+    // Repeated values at a regular interval take two bits each.
+    for (size_t i = 0; i < MAX_BLOCK_SAMPLES; i++)
+    {
+        Samples[i].timestamp = START_TIME + (i * 0.5);
+        Samples[i].value = 42.25;
+    }
+    size_t count = FillBlock(&block, Samples, MAX_BLOCK_SAMPLES);
+    assert_true(count > (MAX_BLOCK_SAMPLES * 3 / 4));
+    CheckBlock(&block, Samples, count);
+
+    // Runs of repeated values between changes, including repeated NANs.
+    for (size_t i = 0; i < MAX_BLOCK_SAMPLES; i++)
+    {
+        Samples[i].timestamp = START_TIME + i;
+        switch ((i / 10) % 4)
+        {
+            case 0:  Samples[i].value = 1.0;       break;
+            case 1:  Samples[i].value = NAN;       break;
+            case 2:  Samples[i].value = -1.0;      break;
+            default: Samples[i].value = INFINITY;  break;
+        }
+    }
+    count = FillBlock(&block, Samples, MAX_BLOCK_SAMPLES);
+    assert_true(count > (SAMPLE_BLOCK_DATA_BYTES / 8));
+    CheckBlock(&block, Samples, count);
+}
+
+static void test_block_timestamp_jitter
+(
+    void** state
+)
+{
+    static sampleBlock_Block_t block;
+
+    RandomSeed = 1;
+
+    // A one second interval, with up to +/- 5 ms of jitter in whole microseconds, a few repeated
+    // timestamps, gaps of up to a day and steps back in time.
+    double timestamp = START_TIME;
+    for (size_t i = 0; i < MAX_BLOCK_SAMPLES; i++)
+    {
+        uint32_t r = Random();
+
+        if ((r % 50) == 0)
+        {
+            timestamp += (Random() % 86400);
+        }
+        else if ((r % 50) == 1)
+        {
+            timestamp -= 3;
+        }
+        else if ((r % 50) != 2)
+        {
+            timestamp += 1;
+        }
+        Samples[i].timestamp = timestamp + (((int32_t)(Random() % 10001) - 5000) / 1000000.0);
+        Samples[i].value = 20.0 + ((Random() % 100) / 10.0);
+    }
+    size_t count = FillBlock(&block, Samples, MAX_BLOCK_SAMPLES);
+    assert_true(count > (SAMPLE_BLOCK_DATA_BYTES / 16));
+    assert_true(block.isMicroseconds);
+    CheckBlock(&block, Samples, count);
+
+    // Irregular timestamps that aren't whole microseconds are stored as bit patterns.
+    timestamp = START_TIME;
+    for (size_t i = 0; i < MAX_BLOCK_SAMPLES; i++)
+    {
+        timestamp += (Random() % 1000) / 3.0;
+        Samples[i].timestamp = timestamp + (1.0 / 3);
+        Samples[i].value = (double)Random();
+    }
+    count = FillBlock(&block, Samples, MAX_BLOCK_SAMPLES);
+    assert_true(count > (SAMPLE_BLOCK_DATA_BYTES / 16));
+    assert_false(block.isMicroseconds);
+    CheckBlock(&block, Samples, count);
+
+    // Once a block holds whole microseconds, other timestamps have to go in another block.
+    sampleBlock_Init(&block);
+    assert_true(sampleBlock_Append(&block, START_TIME, 1.0));
+    assert_false(sampleBlock_Append(&block, START_TIME + (1.0 / 3), 2.0));
+    assert_int_equal(sampleBlock_GetCount(&block), 1);
+    assert_true(sampleBlock_Append(&block, START_TIME + 1, 3.0));
+    Samples[0].timestamp = START_TIME;
+    Samples[0].value = 1.0;
+    Samples[1].timestamp = START_TIME + 1;
+    Samples[1].value = 3.0;
+    CheckBlock(&block, Samples, 2);
+}
+
+static void test_block_read_from_cursor
+(
+    void** state
+)
+{
+    static sampleBlock_Block_t block;
+
+    RandomSeed = 2;
+
+    for (size_t i = 0; i < MAX_BLOCK_SAMPLES; i++)
+    {
+        Samples[i].timestamp = START_TIME + i + ((Random() % 100) / 1000000.0);
+        Samples[i].value = ((Random() % 4) == 0) ? NAN : (double)(Random() % 1000);
+    }
+    size_t count = FillBlock(&block, Samples, MAX_BLOCK_SAMPLES);
+
+    // Reading can carry on from a copy of any cursor.
+    sampleBlock_Cursor_t cursor;
+    sampleBlock_StartRead(&cursor);
+    for (size_t i = 0; i < count; i++)
+    {
+        sampleBlock_Cursor_t copy = cursor;
+        double timestamp;
+        double value;
+        sampleBlock_ReadNext(&block, &copy, &timestamp, &value);
+        assert_memory_equal(&timestamp, &Samples[i].timestamp, sizeof(double));
+        assert_memory_equal(&value, &Samples[i].value, sizeof(double));
+        sampleBlock_ReadNext(&block, &cursor, &timestamp, &value);
+        assert_int_equal(copy.count, cursor.count);
+        assert_int_equal(copy.bitOffset, cursor.bitOffset);
+    }
+}
+
+/* Backup files */
+
+#define BACKUP_FILE_SAMPLES 600
+
+// A backup file starts with a header of 16 bytes: version, data type, 2 spare bytes, sample count,
+// number of samples per block and a CRC.
+#define BACKUP_FILE_HEADER_BYTES 16
+
+static void WriteBackupFile(void)
+{
+    CreateBackedUpObs("/obs/source", BACKUP_FILE_SAMPLES);
+    CHILD_CHECK(WaitForFile("backup/source.bak"));
+}
+
+static void RestoreBackupFiles(void)
+{
+    static const struct
+    {
+        const char* obsPath;
+        uint32_t count;
+    }
+    expected[] =
+    {
+        { "/obs/intact", BACKUP_FILE_SAMPLES },
+        { "/obs/badVersion", 0 },
+        { "/obs/badHeader", 0 },
+        { "/obs/badBlock", 0 },
+        { "/obs/badLastBlock", 0 },
+        { "/obs/truncated", 0 },
+        { "/obs/headerOnly", 0 },
+        { "/obs/short", 0 },
+    };
+
+    for (size_t i = 0; i < NUM_ARRAY_MEMBERS(expected); i++)
+    {
+        CHILD_CHECK(admin_CreateObs(expected[i].obsPath) == LE_OK);
+        CHILD_CHECK(GetSampleCount(expected[i].obsPath) == expected[i].count);
+    }
+}
+
+static void test_backup_file_damaged
+(
+    void** state
+)
+{
+    RunDataHub(WriteBackupFile);
+
+    size_t size;
+    uint8_t* backupPtr = ReadFile("backup/source.bak", &size);
+
+    // A damaged file is ignored rather than restoring a buffer with samples missing or wrong.
+    WriteFile("backup/intact.bak", backupPtr, size);
+    WriteDamagedFile("backup/badVersion.bak", backupPtr, size, 0);
+    WriteDamagedFile("backup/badHeader.bak", backupPtr, size, 9);
+    WriteDamagedFile("backup/badBlock.bak", backupPtr, size, size / 2);
+    WriteDamagedFile("backup/badLastBlock.bak", backupPtr, size, size - 5);
+    WriteFile("backup/truncated.bak", backupPtr, size - 8);
+    WriteFile("backup/headerOnly.bak", backupPtr, BACKUP_FILE_HEADER_BYTES);
+    WriteFile("backup/short.bak", backupPtr, 10);
+    free(backupPtr);
+
+    RunDataHub(RestoreBackupFiles);
+}
+
+/* Backup logs */
+
+#define LOG_BASE_SAMPLES 100
+#define LOG_FIRST_APPENDED_SAMPLES 50
+#define LOG_LAST_APPENDED_SAMPLES 30
+#define LOG_SAMPLES (LOG_BASE_SAMPLES + LOG_FIRST_APPENDED_SAMPLES + LOG_LAST_APPENDED_SAMPLES)
+
+// A backup log segment starts with a header of 16 bytes: magic number, generation number, segment
+// number and CRC.  Each frame after it starts with the length of its payload and a CRC, then the
+// sequence numbers of the oldest buffered sample and of the frame's first sample, and its sample
+// count.
+#define LOG_HEADER_BYTES 16
+#define LOG_FRAME_PREFIX_BYTES 8
+#define LOG_FRAME_COUNT_OFFSET 16
+
+// Number of samples in the base of the log written by WriteBackupLog().  Depending on when the
+// first backup is due, some of the samples pushed before the base was written may be appended to
+// the next segment instead.
+static uint32_t LogBaseSamples;
+
+static void PushNumbers
+(
+    const char* obsPath,
+    uint32_t first,
+    uint32_t count
+)
+{
+    for (uint32_t i = first; i < (first + count); i++)
+    {
+        CHILD_CHECK(admin_PushNumeric(obsPath, START_TIME + i, i) == LE_OK);
+    }
+}
+
+// Write a log whose base (segment 0) is followed by a segment holding two frames.
+static void WriteBackupLog(void)
+{
+    const char* obsPath = "/obs/source";
+
+    CHILD_CHECK(admin_CreateObs(obsPath) == LE_OK);
+    CHILD_CHECK(admin_SetBufferBackupLog(obsPath, true) == LE_OK);
+    CreateBackedUpObs(obsPath, LOG_BASE_SAMPLES);
+    CHILD_CHECK(WaitForFile("backup/source.log.0"));
+
+    PushNumbers(obsPath, LOG_BASE_SAMPLES, LOG_FIRST_APPENDED_SAMPLES);
+    CHILD_CHECK(WaitForFile("backup/source.log.1"));
+
+    off_t size = GetFileSize("backup/source.log.1");
+    PushNumbers(obsPath, LOG_BASE_SAMPLES + LOG_FIRST_APPENDED_SAMPLES, LOG_LAST_APPENDED_SAMPLES);
+    CHILD_CHECK(WaitForFileSize("backup/source.log.1", size));
+}
+
+static void RestoreBackupLogs(void)
+{
+    const struct
+    {
+        const char* obsPath;
+        uint32_t count;
+    }
+    expected[] =
+    {
+        { "/obs/intact", LOG_SAMPLES },
+        { "/obs/tornTail", LOG_BASE_SAMPLES + LOG_FIRST_APPENDED_SAMPLES },
+        { "/obs/zeroTail", LOG_SAMPLES },
+        { "/obs/badLastFrame", LOG_BASE_SAMPLES + LOG_FIRST_APPENDED_SAMPLES },
+        { "/obs/badLastPrefix", LOG_BASE_SAMPLES + LOG_FIRST_APPENDED_SAMPLES },
+        { "/obs/badFirstFrame", LogBaseSamples },
+        { "/obs/badSegmentHeader", LogBaseSamples },
+        { "/obs/strayed", LOG_SAMPLES },
+        { "/obs/badBase", 0 },
+        { "/obs/noBase", 0 },
+    };
+
+    for (size_t i = 0; i < NUM_ARRAY_MEMBERS(expected); i++)
+    {
+        CHILD_CHECK(admin_CreateObs(expected[i].obsPath) == LE_OK);
+        CHILD_CHECK(GetSampleCount(expected[i].obsPath) == expected[i].count);
+    }
+}
+
+static void test_backup_log_damaged
+(
+    void** state
+)
+{
+    RunDataHub(WriteBackupLog);
+
+    size_t baseSize;
+    uint8_t* basePtr = ReadFile("backup/source.log.0", &baseSize);
+    size_t size;
+    uint8_t* segmentPtr = ReadFile("backup/source.log.1", &size);
+
+    assert_true(LOG_HEADER_BYTES + LOG_FRAME_PREFIX_BYTES + LOG_FRAME_COUNT_OFFSET + 4 <= baseSize);
+    memcpy(&LogBaseSamples,
+           basePtr + LOG_HEADER_BYTES + LOG_FRAME_PREFIX_BYTES + LOG_FRAME_COUNT_OFFSET,
+           sizeof(LogBaseSamples));
+    assert_true((LogBaseSamples > 0) && (LogBaseSamples <= LOG_BASE_SAMPLES));
+
+    // Find the second frame of the segment.
+    uint32_t payloadBytes;
+    memcpy(&payloadBytes, segmentPtr + LOG_HEADER_BYTES, sizeof(payloadBytes));
+    size_t lastFrame = LOG_HEADER_BYTES + LOG_FRAME_PREFIX_BYTES + payloadBytes;
+    assert_true(lastFrame + LOG_FRAME_PREFIX_BYTES < size);
+
+    // A log is replayed up to the first frame that was cut short or damaged (as when power was
+    // lost while appending to it).  A zeroed tail after the last frame is just ignored.
+    static const char* const names[] =
+    {
+        "intact", "tornTail", "zeroTail", "badLastFrame", "badLastPrefix", "badFirstFrame",
+        "badSegmentHeader", "strayed", "badBase"
+    };
+    for (size_t i = 0; i < NUM_ARRAY_MEMBERS(names); i++)
+    {
+        char path[64];
+        snprintf(path, sizeof(path), "backup/%s.log.0", names[i]);
+        WriteFile(path, basePtr, baseSize);
+        snprintf(path, sizeof(path), "backup/%s.log.1", names[i]);
+        WriteFile(path, segmentPtr, size);
+    }
+    WriteFile("backup/tornTail.log.1", segmentPtr, size - 3);
+    WriteDamagedFile("backup/badLastFrame.log.1", segmentPtr, size, size - 5);
+    WriteDamagedFile("backup/badLastPrefix.log.1", segmentPtr, size, lastFrame);
+    WriteDamagedFile("backup/badFirstFrame.log.1", segmentPtr, size, lastFrame - 5);
+    WriteDamagedFile("backup/badSegmentHeader.log.1", segmentPtr, size, 0);
+    WriteDamagedFile("backup/badBase.log.0", basePtr, baseSize, baseSize / 2);
+    WriteFile("backup/noBase.log.1", segmentPtr, size);
+
+    uint8_t* zeroTailPtr = calloc(size + 64, 1);
+    assert_non_null(zeroTailPtr);
+    memcpy(zeroTailPtr, segmentPtr, size);
+    WriteFile("backup/zeroTail.log.1", zeroTailPtr, size + 64);
+    free(zeroTailPtr);
+
+    // A segment that doesn't follow on from the one before it is left over from an older log.
+    WriteFile("backup/strayed.log.2", segmentPtr, size);
+
+    free(basePtr);
+    free(segmentPtr);
+
+    RunDataHub(RestoreBackupLogs);
+}
+
+/* Backup packs */
+
+#define PACK_PATH "backup.pack"
+
+// The pack file starts with a header of 20 bytes: magic number, backup count, index size, index
+// CRC and header CRC.  Each entry of the index that follows holds the length of a path, the path,
+// and the offset, size and CRC of the backup.
+#define PACK_HEADER_BYTES 20
+
+static const char* const PackedObsPaths[] = { "/obs/first", "/obs/second" };
+static const uint32_t PackedSamples[] = { 600, 300 };
+
+// Number of samples each Observation is expected to restore from the pack after a restart.
+static uint32_t ExpectedPackedSamples[NUM_ARRAY_MEMBERS(PackedObsPaths)];
+
+static void WriteBackupPack(void)
+{
+    admin_SetBackupPacked(true);
+
+    for (size_t i = 0; i < NUM_ARRAY_MEMBERS(PackedObsPaths); i++)
+    {
+        CreateBackedUpObs(PackedObsPaths[i], PackedSamples[i]);
+    }
+    CHILD_CHECK(WaitForFile(PACK_PATH));
+}
+
+static void RestoreBackupPack(void)
+{
+    for (size_t i = 0; i < NUM_ARRAY_MEMBERS(PackedObsPaths); i++)
+    {
+        CHILD_CHECK(admin_CreateObs(PackedObsPaths[i]) == LE_OK);
+        CHILD_CHECK(GetSampleCount(PackedObsPaths[i]) == ExpectedPackedSamples[i]);
+    }
+}
+
+// Find where a backup is in the pack.
+static void FindPackedBackup
+(
+    const uint8_t* packPtr,
+    size_t size,
+    const char* backupPath,     ///< Path relative to the backup directory.
+    uint32_t* offsetPtr,
+    uint32_t* lengthPtr
+)
+{
+    uint32_t count;
+    memcpy(&count, packPtr + 4, sizeof(count));
+    assert_int_equal(count, NUM_ARRAY_MEMBERS(PackedObsPaths));
+
+    size_t pos = PACK_HEADER_BYTES;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        uint16_t pathLen;
+        memcpy(&pathLen, packPtr + pos, sizeof(pathLen));
+        assert_true(pos + 2 + pathLen + 12 <= size);
+
+        if (   (pathLen == strlen(backupPath))
+            && (memcmp(packPtr + pos + 2, backupPath, pathLen) == 0)  )
+        {
+            memcpy(offsetPtr, packPtr + pos + 2 + pathLen, sizeof(*offsetPtr));
+            memcpy(lengthPtr, packPtr + pos + 6 + pathLen, sizeof(*lengthPtr));
+            assert_true(*offsetPtr + *lengthPtr <= size);
+            return;
+        }
+        pos += 2 + pathLen + 12;
+    }
+    fail_msg("'%s' not found in the pack.", backupPath);
+}
+
+// Restart with a given pack file, and check what is restored and whether the pack is kept.
+static void CheckPackRestore
+(
+    const uint8_t* packPtr,
+    size_t size,
+    uint32_t firstCount,
+    uint32_t secondCount,
+    bool isKept
+)
+{
+    WriteFile(PACK_PATH, packPtr, size);
+    ExpectedPackedSamples[0] = firstCount;
+    ExpectedPackedSamples[1] = secondCount;
+
+    RunDataHub(RestoreBackupPack);
+
+    assert_int_equal(access(PACK_PATH, F_OK) == 0, isKept);
+}
+
+static void test_backup_pack_damaged
+(
+    void** state
+)
+{
+    RunDataHub(WriteBackupPack);
+
+    size_t size;
+    uint8_t* packPtr = ReadFile(PACK_PATH, &size);
+    uint32_t firstOffset, firstLength, secondOffset, secondLength;
+    FindPackedBackup(packPtr, size, "first.bak", &firstOffset, &firstLength);
+    FindPackedBackup(packPtr, size, "second.bak", &secondOffset, &secondLength);
+
+    CheckPackRestore(packPtr, size, PackedSamples[0], PackedSamples[1], true);
+
+    // A damaged backup only loses that backup.
+    packPtr[firstOffset + (firstLength / 2)] ^= 0x5a;
+    CheckPackRestore(packPtr, size, 0, PackedSamples[1], true);
+    packPtr[firstOffset + (firstLength / 2)] ^= 0x5a;
+
+    // So does one cut off by the end of the file.
+    size_t lastOffset = (firstOffset > secondOffset) ? firstOffset : secondOffset;
+    CheckPackRestore(packPtr, lastOffset + 8, (firstOffset > secondOffset) ? 0 : PackedSamples[0],
+                     (firstOffset > secondOffset) ? PackedSamples[1] : 0, true);
+
+    // A damaged header or index makes the whole pack useless, so it is deleted.
+    packPtr[5] ^= 0x5a;
+    CheckPackRestore(packPtr, size, 0, 0, false);
+    packPtr[5] ^= 0x5a;
+
+    packPtr[PACK_HEADER_BYTES + 3] ^= 0x5a;
+    CheckPackRestore(packPtr, size, 0, 0, false);
+    packPtr[PACK_HEADER_BYTES + 3] ^= 0x5a;
+
+    CheckPackRestore(packPtr, PACK_HEADER_BYTES + 5, 0, 0, false);
+    CheckPackRestore(packPtr, 10, 0, 0, false);
+
+    free(packPtr);
+}
+
+/* Lazy restore */
+
+#define LAZY_SAMPLES 600
+
+// Get the number of bytes used by an Observation's buffered samples.
+static uint64_t GetBufferBytes
+(
+    const char* obsPath
+)
+{
+    uint64_t bytes;
+    uint64_t evictionCount;
+
+    CHILD_CHECK(query_GetObsBufferMemoryUsage(obsPath, &bytes, &evictionCount) == LE_OK);
+    return bytes;
+}
+
+// Check that an Observation's current value is the newest sample of the backup.
+static void CheckNewestRestored
+(
+    const char* obsPath
+)
+{
+    double timestamp;
+    double value;
+
+    CHILD_CHECK(query_GetNumeric(obsPath, &timestamp, &value) == LE_OK);
+    CHILD_CHECK(timestamp == START_TIME + LAZY_SAMPLES - 1);
+    CHILD_CHECK(value == LAZY_SAMPLES - 1);
+}
+
+static void WriteLazyBackup(void)
+{
+    CreateBackedUpObs("/obs/source", LAZY_SAMPLES);
+    CHILD_CHECK(WaitForFile("backup/source.bak"));
+}
+
+static void RestoreLazily(void)
+{
+    static const char* const obsPaths[] = { "/obs/queried", "/obs/pushed", "/obs/badMiddle" };
+
+    admin_SetBackupLazyRestore(true);
+
+    // Only the newest sample is restored when the Observation is created, as its current value.
+    for (size_t i = 0; i < NUM_ARRAY_MEMBERS(obsPaths); i++)
+    {
+        CHILD_CHECK(admin_CreateObs(obsPaths[i]) == LE_OK);
+        CheckNewestRestored(obsPaths[i]);
+    }
+    uint64_t sampleBytes = GetBufferBytes("/obs/queried");
+    CHILD_CHECK(sampleBytes > 0);
+    CHILD_CHECK(GetBufferBytes("/obs/pushed") == sampleBytes);
+    CHILD_CHECK(GetBufferBytes("/obs/badMiddle") == sampleBytes);
+
+    // The rest of the buffer is loaded by the first query...
+    uint32_t count;
+    double min, max, mean, stdDev, firstTimestamp, lastTimestamp;
+    CHILD_CHECK(query_GetStats("/obs/queried", NAN, NAN, &count, &min, &max, &mean, &stdDev,
+                               &firstTimestamp, &lastTimestamp) == LE_OK);
+    CHILD_CHECK(count == LAZY_SAMPLES);
+    CHILD_CHECK(firstTimestamp == START_TIME);
+    uint64_t bufferBytes = GetBufferBytes("/obs/queried");
+    CHILD_CHECK(bufferBytes > sampleBytes);
+
+    // ...or by the first push, which then drops the oldest sample as the buffer is full.
+    CHILD_CHECK(admin_PushNumeric("/obs/pushed", START_TIME + LAZY_SAMPLES, LAZY_SAMPLES) == LE_OK);
+    CHILD_CHECK(GetBufferBytes("/obs/pushed") == bufferBytes);
+    CHILD_CHECK(query_GetStats("/obs/pushed", NAN, NAN, &count, &min, &max, &mean, &stdDev,
+                               &firstTimestamp, &lastTimestamp) == LE_OK);
+    CHILD_CHECK(count == LAZY_SAMPLES);
+    CHILD_CHECK(firstTimestamp == START_TIME + 1);
+    CHILD_CHECK(lastTimestamp == START_TIME + LAZY_SAMPLES);
+
+    // A damaged block that wasn't read at start-up is only found when the rest is loaded.  The
+    // buffer is discarded, but the current value is kept.
+    CHILD_CHECK(GetSampleCount("/obs/badMiddle") == 0);
+    CHILD_CHECK(GetBufferBytes("/obs/badMiddle") == 0);
+    CheckNewestRestored("/obs/badMiddle");
+}
+
+static void test_backup_lazy_restore
+(
+    void** state
+)
+{
+    RunDataHub(WriteLazyBackup);
+
+    size_t size;
+    uint8_t* backupPtr = ReadFile("backup/source.bak", &size);
+
+    // The middle one of the three blocks is damaged.
+    WriteFile("backup/queried.bak", backupPtr, size);
+    WriteFile("backup/pushed.bak", backupPtr, size);
+    WriteDamagedFile("backup/badMiddle.bak", backupPtr, size, size / 2);
+    free(backupPtr);
+
+    RunDataHub(RestoreLazily);
+}
+
+/* Checkpoints */
+
+#define CHECKPOINT_PATH "dataHub.ckpt"
+
+// true if the checkpoint is expected to be restored after a restart.
+static bool IsCheckpointIntact;
+
+static void WriteCheckpoint(void)
+{
+    admin_SetCheckpointPeriod(1);
+
+    CHILD_CHECK(admin_CreateInput("/app/test/temp", IO_DATA_TYPE_NUMERIC, "degC") == LE_OK);
+    CHILD_CHECK(admin_CreateObs("/obs/temp") == LE_OK);
+    CHILD_CHECK(admin_SetBufferMaxCount("/obs/temp", 10) == LE_OK);
+    CHILD_CHECK(admin_SetSource("/obs/temp", "/app/test/temp") == LE_OK);
+    CHILD_CHECK(admin_PushNumeric("/app/test/temp", START_TIME, 21.5) == LE_OK);
+
+    CHILD_CHECK(WaitForFile(CHECKPOINT_PATH));
+}
+
+static void RestoreCheckpoint(void)
+{
+    if (IsCheckpointIntact)
+    {
+        char srcPath[IO_MAX_RESOURCE_PATH_LEN + 1];
+
+        CHILD_CHECK(admin_GetCheckpointPeriod() == 1);
+        CHILD_CHECK(admin_GetEntryType("/app/test/temp") == ADMIN_ENTRY_TYPE_INPUT);
+        CHILD_CHECK(admin_GetEntryType("/obs/temp") == ADMIN_ENTRY_TYPE_OBSERVATION);
+        CHILD_CHECK(admin_GetBufferMaxCount("/obs/temp") == 10);
+        CHILD_CHECK(admin_GetSource("/obs/temp", srcPath, sizeof(srcPath)) == LE_OK);
+        CHILD_CHECK(strcmp(srcPath, "/app/test/temp") == 0);
+    }
+    else
+    {
+        // Nothing at all is restored from a damaged checkpoint, but the Data Hub works as usual.
+        CHILD_CHECK(admin_GetCheckpointPeriod() == 0);
+        CHILD_CHECK(admin_GetEntryType("/app/test/temp") == ADMIN_ENTRY_TYPE_NONE);
+        CHILD_CHECK(admin_GetEntryType("/obs/temp") == ADMIN_ENTRY_TYPE_NONE);
+        CHILD_CHECK(admin_CreateInput("/app/test/temp", IO_DATA_TYPE_NUMERIC, "degC") == LE_OK);
+        CHILD_CHECK(admin_PushNumeric("/app/test/temp", START_TIME, 21.5) == LE_OK);
+    }
+}
+
+// Restart with a given checkpoint file.
+static void CheckCheckpointRestore
+(
+    const uint8_t* checkpointPtr,
+    size_t size,
+    bool isIntact
+)
+{
+    WriteFile(CHECKPOINT_PATH, checkpointPtr, size);
+    IsCheckpointIntact = isIntact;
+
+    RunDataHub(RestoreCheckpoint);
+}
+
+static void test_checkpoint_damaged
+(
+    void** state
+)
+{
+    RunDataHub(WriteCheckpoint);
+
+    size_t size;
+    uint8_t* checkpointPtr = ReadFile(CHECKPOINT_PATH, &size);
+
+    CheckCheckpointRestore(checkpointPtr, size, true);
+
+    // Any damage to the file is caught by its CRC.
+    for (size_t offset = 0; offset < size; offset += 7)
+    {
+        checkpointPtr[offset] ^= 0x5a;
+        CheckCheckpointRestore(checkpointPtr, size, false);
+        checkpointPtr[offset] ^= 0x5a;
+    }
+
+    CheckCheckpointRestore(checkpointPtr, size - 1, false);
+    CheckCheckpointRestore(checkpointPtr, size / 2, false);
+    CheckCheckpointRestore(checkpointPtr, 0, false);
+
+    free(checkpointPtr);
+}
+
+/* State segment */
+
+static void WriteLazyPackedBackups(void)
+{
+    admin_SetBackupPacked(true);
+
+    CreateBackedUpObs("/obs/lazy", LAZY_SAMPLES);
+    CreateBackedUpObs("/obs/busy", 1);
+    CHILD_CHECK(WaitForFile(PACK_PATH));
+}
+
+static void KeepStateWhileBackingUp(void)
+{
+    admin_SetBackupPacked(true);
+    admin_SetBackupLazyRestore(true);
+
+    CHILD_CHECK(admin_CreateObs("/obs/lazy") == LE_OK);
+    CheckNewestRestored("/obs/lazy");
+    uint64_t sampleBytes = GetBufferBytes("/obs/lazy");
+    CreateBackedUpObs("/obs/busy", 1);
+
+    // The rest of the lazy buffer is copied from the pack into each state image, while the
+    // backups of the busy Observation keep rewriting the pack.
+    admin_SetStateSegmentPeriod(1000);
+    for (uint32_t i = 1; i < 25; i++)
+    {
+        CHILD_CHECK(admin_PushNumeric("/obs/busy", START_TIME + i, i) == LE_OK);
+        RunEventLoop(100);
+    }
+
+    // Building the images didn't load the buffer.
+    CHILD_CHECK(GetBufferBytes("/obs/lazy") == sampleBytes);
+}
+
+static void RestoreState(void)
+{
+    uint32_t count;
+    double min, max, mean, stdDev, firstTimestamp, lastTimestamp;
+
+    CHILD_CHECK(query_GetStats("/obs/lazy", NAN, NAN, &count, &min, &max, &mean, &stdDev,
+                               &firstTimestamp, &lastTimestamp) == LE_OK);
+    CHILD_CHECK(count == LAZY_SAMPLES);
+    CHILD_CHECK(firstTimestamp == START_TIME);
+    CHILD_CHECK(lastTimestamp == START_TIME + LAZY_SAMPLES - 1);
+    CHILD_CHECK(GetSampleCount("/obs/busy") > 1);
+}
+
+static void test_state_lazy_packed_backups
+(
+    void** state
+)
+{
+    RunDataHub(WriteLazyPackedBackups);
+    RunDataHub(KeepStateWhileBackingUp);
+
+    // Without the pack, the lazy buffer can only come back from the state segment.
+    assert_int_equal(unlink(PACK_PATH), 0);
+    RunDataHub(RestoreState);
+}
+
+#define STATE_SAMPLES 900
+
+static void KeepState(void)
+{
+    admin_SetStateSegmentPeriod(1000);
+
+    // The copy of the buffer that doesn't change moves along as the one before it grows.
+    static const char* const obsPaths[] = { "/obs/moving", "/obs/still" };
+    for (size_t i = 0; i < NUM_ARRAY_MEMBERS(obsPaths); i++)
+    {
+        CHILD_CHECK(admin_CreateObs(obsPaths[i]) == LE_OK);
+        CHILD_CHECK(admin_SetBufferMaxCount(obsPaths[i], 1000) == LE_OK);
+        PushNumbers(obsPaths[i], 0, STATE_SAMPLES);
+    }
+
+    // Each image after the first reuses the copy of the buffer that hasn't changed from the one
+    // before it, while the other buffer grows, then drops its oldest samples.
+    RunEventLoop(1100);
+    PushNumbers("/obs/moving", STATE_SAMPLES, 100);
+    RunEventLoop(1000);
+    PushNumbers("/obs/moving", STATE_SAMPLES + 100, 100);
+    RunEventLoop(1000);
+
+    // Then neither has changed.
+    RunEventLoop(1000);
+}
+
+static void CheckStateBuffer
+(
+    const char* obsPath,
+    uint32_t expectedCount,
+    uint32_t first
+)
+{
+    uint32_t count;
+    double min, max, mean, stdDev, firstTimestamp, lastTimestamp;
+
+    CHILD_CHECK(query_GetStats(obsPath, NAN, NAN, &count, &min, &max, &mean, &stdDev,
+                               &firstTimestamp, &lastTimestamp) == LE_OK);
+    CHILD_CHECK(count == expectedCount);
+    CHILD_CHECK(firstTimestamp == START_TIME + first);
+    CHILD_CHECK(lastTimestamp == START_TIME + first + expectedCount - 1);
+    CHILD_CHECK(min == first);
+    CHILD_CHECK(max == first + expectedCount - 1);
+}
+
+static void RestoreKeptState(void)
+{
+    CHILD_CHECK(admin_GetStateSegmentPeriod() == 1000);
+    CheckStateBuffer("/obs/still", STATE_SAMPLES, 0);
+    CheckStateBuffer("/obs/moving", 1000, STATE_SAMPLES + 200 - 1000);
+}
+
+static void test_state_unchanged_buffers
+(
+    void** state
+)
+{
+    RunDataHub(KeepState);
+
+    // Nothing was written to flash, so everything comes back from the state segment.
+    assert_int_equal(access(CHECKPOINT_PATH, F_OK), -1);
+    RunDataHub(RestoreKeptState);
+}
+
+/* Interned strings */
+
+#define INTERNED_STRINGS 5000
+
+static void InternStrings(void)
+{
+    // Equal strings are interned as the same copy, and different ones as different copies.
+    char text[STR_INTERN_MAX_BYTES] = "temperature";
+    const char* strPtr = strIntern_Get(text);
+    CHILD_CHECK((strPtr != NULL) && (strPtr != text) && (strcmp(strPtr, text) == 0));
+    CHILD_CHECK(strIntern_Get("temperature") == strPtr);
+    const char* otherPtr = strIntern_Get("temperatures");
+    CHILD_CHECK((otherPtr != NULL) && (otherPtr != strPtr));
+    CHILD_CHECK(strcmp(otherPtr, "temperatures") == 0);
+
+    // A string is kept until its last reference is released.
+    strIntern_Release(strPtr);
+    CHILD_CHECK(strcmp(strPtr, "temperature") == 0);
+    CHILD_CHECK(strIntern_Get("temperature") == strPtr);
+    strIntern_Release(strPtr);
+    strIntern_Release(strPtr);
+    strIntern_Release(otherPtr);
+
+    // The empty string is never allocated.
+    strPtr = strIntern_Get("");
+    CHILD_CHECK((strPtr != NULL) && (strPtr[0] == '\0'));
+    CHILD_CHECK(strIntern_Get("") == strPtr);
+    strIntern_Release(strPtr);
+    strIntern_Release(strPtr);
+
+    // Strings of every length, up to the longest allowed.
+    for (size_t len = 1; len < STR_INTERN_MAX_BYTES; len++)
+    {
+        memset(text, 'a' + (len % 26), len);
+        text[len] = '\0';
+        strPtr = strIntern_Get(text);
+        CHILD_CHECK((strPtr != NULL) && (strcmp(strPtr, text) == 0));
+        CHILD_CHECK(strIntern_Get(text) == strPtr);
+        strIntern_Release(strPtr);
+        strIntern_Release(strPtr);
+    }
+
+    // Enough strings for the hash table to grow a few times over.
+    static const char* strPtrs[INTERNED_STRINGS];
+    for (uint32_t i = 0; i < INTERNED_STRINGS; i++)
+    {
+        snprintf(text, sizeof(text), "name%" PRIu32, i);
+        strPtrs[i] = strIntern_Get(text);
+        CHILD_CHECK((strPtrs[i] != NULL) && (strcmp(strPtrs[i], text) == 0));
+    }
+    for (uint32_t i = 0; i < INTERNED_STRINGS; i++)
+    {
+        snprintf(text, sizeof(text), "name%" PRIu32, i);
+        CHILD_CHECK(strIntern_Get(text) == strPtrs[i]);
+        strIntern_Release(strPtrs[i]);
+    }
+
+    // Releasing every other one leaves the rest intact.
+    for (uint32_t i = 0; i < INTERNED_STRINGS; i += 2)
+    {
+        strIntern_Release(strPtrs[i]);
+    }
+    for (uint32_t i = 1; i < INTERNED_STRINGS; i += 2)
+    {
+        snprintf(text, sizeof(text), "name%" PRIu32, i);
+        CHILD_CHECK(strcmp(strPtrs[i], text) == 0);
+        CHILD_CHECK(strIntern_Get(text) == strPtrs[i]);
+        strIntern_Release(strPtrs[i]);
+        strIntern_Release(strPtrs[i]);
+    }
+}
+
+static void test_strings_interned
+(
+    void** state
+)
+{
+    RunDataHub(InternStrings);
+}
+
+int main(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+    const struct CMUnitTest tests[] =
+    {
+        cmocka_unit_test(test_block_special_values),
+        cmocka_unit_test(test_block_repeated_values),
+        cmocka_unit_test(test_block_timestamp_jitter),
+        cmocka_unit_test(test_block_read_from_cursor),
+        cmocka_unit_test_setup_teardown(test_backup_file_damaged, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_backup_log_damaged, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_backup_pack_damaged, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_backup_lazy_restore, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_checkpoint_damaged, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_state_lazy_packed_backups, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_state_unchanged_buffers, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_strings_interned, setup, teardown)
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
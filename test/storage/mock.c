@@ -0,0 +1,64 @@
+#include "legato.h"
+#include "interfaces.h"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the client session reference for the current message.
+ *
+ * The tests only use absolute paths, so there's never a client session to look up.
+ */
+//--------------------------------------------------------------------------------------------------
+le_msg_SessionRef_t io_GetClientSessionRef(void)
+{
+    return NULL;
+}
+
+le_msg_SessionRef_t query_GetClientSessionRef(void)
+{
+    return NULL;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get a service reference, so session close handlers can be added to it.
+ *
+ * The services are created but never advertised, so no client can ever connect to them.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_msg_ServiceRef_t GetService
+(
+    le_msg_ServiceRef_t* serviceRefPtr,
+    const char* name
+)
+{
+    if (*serviceRefPtr == NULL)
+    {
+        *serviceRefPtr = le_msg_CreateService(le_msg_GetProtocolRef(name, sizeof(uint32_t)), name);
+    }
+    return *serviceRefPtr;
+}
+
+le_msg_ServiceRef_t io_GetServiceRef(void)
+{
+    static le_msg_ServiceRef_t serviceRef;
+    return GetService(&serviceRef, "io");
+}
+
+le_msg_ServiceRef_t query_GetServiceRef(void)
+{
+    static le_msg_ServiceRef_t serviceRef;
+    return GetService(&serviceRef, "query");
+}
+
+le_result_t le_appInfo_GetName
+(
+    int32_t  pid,           ///< [IN]  PID of the process.
+    char    *appNameStr,    ///< [OUT] Application name buffer.
+    size_t   appNameSize    ///< [IN]  Buffer size.
+)
+{
+    (void)pid;
+    (void)appNameStr;
+    (void)appNameSize;
+    return LE_NOT_FOUND;
+}